@@ -34,6 +34,7 @@
 #include "gpio.h"
 #include "button.h"
 #include "sleep.h"
+#include "ieee11073.h"
 
 #if	 (FB_JOYSTICKS)
 #include "joysticks.h"
@@ -75,33 +76,37 @@ struct usr_env_tag usr_env = {LED_ON_DUR_IDLE, LED_OFF_DUR_IDLE};
 
 /**
  ****************************************************************************************
- * @brief   Led1 for BLE status
+ * @brief   Arm the led timer with the delay returned by the led pattern engine
  ****************************************************************************************
  */
-static void usr_led1_set(uint16_t timer_on, uint16_t timer_off)
+static void usr_led1_timer(uint16_t delay)
 {
-    usr_env.led1_on_dur = timer_on;
-    usr_env.led1_off_dur = timer_off;
-
-    if (timer_on == 0 || timer_off == 0)
+    if (delay != 0)
     {
-        if (timer_on == 0)
-        {
-            led_set(1, LED_OFF);
-        }
-        if (timer_off == 0)
-        {
-            led_set(1, LED_ON);
-        }
-        ke_timer_clear(APP_SYS_LED_1_TIMER, TASK_APP);
+        ke_timer_set(APP_SYS_LED_1_TIMER, TASK_APP, delay);
     }
     else
     {
-        led_set(1, LED_OFF);
-        ke_timer_set(APP_SYS_LED_1_TIMER, TASK_APP, timer_off);
+        ke_timer_clear(APP_SYS_LED_1_TIMER, TASK_APP);
     }
 }
 
+/**
+ ****************************************************************************************
+ * @brief   Led1 for BLE status
+ ****************************************************************************************
+ */
+static void usr_led1_set(uint16_t timer_on, uint16_t timer_off)
+{
+    static struct led_pattern pattern;
+
+    usr_env.led1_on_dur = timer_on;
+    usr_env.led1_off_dur = timer_off;
+
+    led_pattern_blink(&pattern, LED_MATRIX(1), timer_on, timer_off);
+    usr_led1_timer(led_pattern_start(0, &pattern));
+}
+
 /**
  ****************************************************************************************
  * @brief   Led 1 flash process
@@ -109,16 +114,18 @@ static void usr_led1_set(uint16_t timer_on, uint16_t timer_off)
  */
 static void usr_led1_process(void)
 {
-    if(led_get(1) == LED_ON)
-    {
-        led_set(1, LED_OFF);
-        ke_timer_set(APP_SYS_LED_1_TIMER, TASK_APP, usr_env.led1_off_dur);
-    }
-    else
-    {
-        led_set(1, LED_ON);
-        ke_timer_set(APP_SYS_LED_1_TIMER, TASK_APP, usr_env.led1_on_dur);
-    }
+    usr_led1_timer(led_pattern_process());
+}
+
+/**
+ ****************************************************************************************
+ * @brief   Led 1 steps played at a wakeup of the BLE stack instead of their own
+ ****************************************************************************************
+ */
+static void app_event_led_pattern_handler(void)
+{
+    ke_evt_clear(1UL << EVENT_LED_PATTERN_ID);
+    usr_led1_timer(led_pattern_process_early());
 }
 
 /**
@@ -149,20 +156,20 @@ static void app_blps_pressure_send(uint8_t flag_interm)
     {
         //        Exponent    Mantissa
         // Size    4 bits      12 bits
-        meas_val.systolic = 0xe63f;                 // 15.99 kpa equal to 120 mm Hg
-        meas_val.diastolic = 0xe42a;                // 10.66 kpa
-        meas_val.mean_arterial_pressure = 0xe3e7;   // 9.99
+        meas_val.systolic = ieee11073_sfloat_encode(1599, -2);                  // 15.99 kpa equal to 120 mm Hg
+        meas_val.diastolic = ieee11073_sfloat_encode(1066, -2);                 // 10.66 kpa
+        meas_val.mean_arterial_pressure = ieee11073_sfloat_encode(999, -2);     // 9.99
     }
     else                                            // pressure in millimetre of mercury
     {
-        meas_val.systolic = 120;
-        meas_val.diastolic = 80;
-        meas_val.mean_arterial_pressure = 75;
+        meas_val.systolic = ieee11073_sfloat_encode(120, 0);
+        meas_val.diastolic = ieee11073_sfloat_encode(80, 0);
+        meas_val.mean_arterial_pressure = ieee11073_sfloat_encode(75, 0);
     }
     
     if (flag & BPS_FLAG_PULSE_RATE_PRESENT)         // Pulse Rate
     {
-        meas_val.pulse_rate = 60;
+        meas_val.pulse_rate = ieee11073_sfloat_encode(60, 0);
     }
     
     if (flag & BPS_FLAG_MEAS_STATUS_PRESENT)        // Measurement Status
@@ -374,6 +381,12 @@ void usr_sleep_restore(void)
     uart_tx_enable(QN_DEBUG_UART, MASK_ENABLE);
     uart_rx_enable(QN_DEBUG_UART, MASK_ENABLE);
 #endif
+
+    // A led step due soon ends now rather than waking the chip up again
+    if (led_pattern_due())
+    {
+        ke_evt_set(1UL << EVENT_LED_PATTERN_ID);
+    }
 }
 
 /**
@@ -536,6 +549,12 @@ void gpio_interrupt_callback(enum gpio_pin pin)
  */
 void usr_init(void)
 {
+    if(KE_EVENT_OK != ke_evt_callback_set(EVENT_LED_PATTERN_ID,
+                                            app_event_led_pattern_handler))
+    {
+        ASSERT_ERR(0);
+    }
+
     if(KE_EVENT_OK != ke_evt_callback_set(EVENT_BUTTON1_PRESS_ID, 
                                             app_event_button1_press_handler))
     {
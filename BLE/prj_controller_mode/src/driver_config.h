@@ -101,9 +101,9 @@
 #define CONFIG_UART0_TX_ENABLE_INTERRUPT                TRUE        /*!< Enable/Disable(Polling) UART0 TX Interrupt */
 #define CONFIG_UART0_RX_ENABLE_INTERRUPT                TRUE        /*!< Enable/Disable(Polling) UART0 RX Interrupt */
 #define CONFIG_ENABLE_DRIVER_UART1                      TRUE        /*!< Enable/Disable UART Driver */
-#define CONFIG_UART1_TX_DEFAULT_IRQHANDLER              FALSE       /*!< Enable/Disable UART1 TX Default IRQ Handler */
+#define CONFIG_UART1_TX_DEFAULT_IRQHANDLER              TRUE        /*!< Enable/Disable UART1 TX Default IRQ Handler */
 #define CONFIG_UART1_RX_DEFAULT_IRQHANDLER              FALSE       /*!< Enable/Disable UART1 RX Default IRQ Handler */
-#define CONFIG_UART1_TX_ENABLE_INTERRUPT                FALSE       /*!< Enable/Disable(Polling) UART1 TX Interrupt */
+#define CONFIG_UART1_TX_ENABLE_INTERRUPT                TRUE        /*!< Enable/Disable(Polling) UART1 TX Interrupt */
 #define CONFIG_UART1_RX_ENABLE_INTERRUPT                FALSE       /*!< Enable/Disable(Polling) UART1 RX Interrupt */
 
 #define CONFIG_ENABLE_DRIVER_SERIAL_FLASH               TRUE        /*!< Enable/Disable Serial Flash Driver */
@@ -194,9 +194,11 @@
 #define TIMER1_CALLBACK_EN                              TRUE        /*!< Enable/Disable Timer1 Driver Callback */
 #define TIMER2_CALLBACK_EN                              TRUE        /*!< Enable/Disable Timer2 Driver Callback */
 #define TIMER3_CALLBACK_EN                              TRUE        /*!< Enable/Disable Timer3 Driver Callback */
+#define TIMER_CAP_EN                                    FALSE       /*!< Enable/Disable input capture engine */
 
 #define RTC_CALLBACK_EN                                 TRUE        /*!< Enable/Disable RTC Driver Callback */
 #define RTC_CAP_CALLBACK_EN                             TRUE        /*!< Enable/Disable RTC Capture Driver Callback */
+#define RTC_EPOCH_EN                                    FALSE       /*!< Enable/Disable epoch clock with drift correction and alarm on the RTC */
 #define USE_STD_C_LIB_TIME                              TRUE        /*!< Enable/Disable Standard C library function to parse date and time */
 
 #define DMA_CALLBACK_EN                                 TRUE        /*!< Enable/Disable DMA Driver Callback */
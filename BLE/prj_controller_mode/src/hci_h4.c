@@ -0,0 +1,577 @@
+/**
+ ****************************************************************************************
+ *
+ * @file hci_h4.c
+ *
+ * @brief Buffered H4 transport between the BLE stack and the HCI UART (controller mode).
+ *
+ * The stack reads and writes HCI packets piece by piece through the hci_api pair given
+ * to ble_init(). Here the UART receives into a ring whatever the host sends, and the
+ * stack reads are served from the ring in the background. The stack writes are queued
+ * in a second ring and completed at once, so the stack prepares its next packet while
+ * the UART is still sending. The host is stopped by RTS before the RX ring overflows.
+ *
+ * With QN_HCI_SNOOP every packet is also sent as a btsnoop record (datalink H4) on a
+ * second UART, a capture host only needs to write the stream to a file.
+ *
+ * Copyright(C) 2015 NXP Semiconductors N.V.
+ * All rights reserved.
+ *
+ * $Rev: 1.0 $
+ *
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @addtogroup HCI_H4
+ * @{
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+#include <string.h>
+#include "hci_h4.h"
+#include "compiler.h"
+#if (QN_HCI_H4)
+#include "lib.h"
+#include "intc.h"
+#include "uart.h"
+#endif
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+#if (QN_HCI_SNOOP)
+/// btsnoop file header and record header lengths
+#define HCI_SNOOP_HDR_LEN           16
+#define HCI_SNOOP_REC_LEN           24
+/// btsnoop datalink type: UART (H4)
+#define HCI_SNOOP_DATALINK_H4       1002
+/// btsnoop record flags
+#define HCI_SNOOP_FLAG_RECV         0x01
+#define HCI_SNOOP_FLAG_CMD_EVT      0x02
+/// Microseconds from year 0 to 1970-01-01, uptime is captured as time since 1970
+#define HCI_SNOOP_EPOCH_DELTA       0x00dcddb30f2f8000ULL
+#endif
+
+/*
+ * TYPE DEFINITIONS
+ ****************************************************************************************
+ */
+
+#if (QN_HCI_H4)
+/// H4 transport environment
+struct hci_h4_env_tag
+{
+    /// HCI UART
+    void *port;
+
+    /// Bytes received from the host
+    struct ring rx;
+    uint8_t rx_buf[HCI_H4_RX_RING_SIZE];
+    /// Byte being received
+    uint8_t rx_byte;
+    /// The host is stopped by RTS
+    bool throttled;
+
+    /// Pending stack read
+    uint8_t *rd_buf;
+    uint32_t rd_size;
+    void (*volatile rd_cb)(void);
+
+    /// Bytes to the host
+    struct ring tx;
+    uint8_t tx_buf[HCI_H4_TX_RING_SIZE];
+    /// Bytes handed to the UART
+    volatile uint16_t tx_len;
+
+    /// Pending stack write, the part not queued yet
+    uint8_t *wr_buf;
+    uint32_t wr_size;
+    void (*volatile wr_cb)(void);
+
+    /// Framing of both directions
+    struct hci_h4_frame rx_frame;
+    struct hci_h4_frame tx_frame;
+
+    uint32_t rx_overflow;
+    uint32_t throttle;
+
+#if (QN_HCI_SNOOP)
+    /// btsnoop stream to the capture UART
+    struct ring snoop;
+    uint8_t snoop_buf[HCI_H4_SNOOP_RING_SIZE];
+    volatile uint16_t snoop_len;
+    /// Packets being captured
+    uint8_t rx_pkt[HCI_H4_FRAME_MAX];
+    uint8_t tx_pkt[HCI_H4_FRAME_MAX];
+    /// Packets missing from the capture
+    uint32_t snoop_drop;
+    /// ke_time() extension
+    uint32_t time_last;
+    uint32_t time_wrap;
+#endif
+};
+#endif
+
+/*
+ * LOCAL VARIABLE DEFINITIONS
+ ****************************************************************************************
+ */
+
+#if (QN_HCI_H4)
+static struct hci_h4_env_tag hci_h4_env;
+#endif
+
+/*
+ * LOCAL FUNCTION DECLARATIONS
+ ****************************************************************************************
+ */
+
+#if (QN_HCI_H4)
+static void hci_h4_tx_kick(void);
+#if (QN_HCI_SNOOP)
+static void hci_h4_snoop_kick(void);
+#endif
+#endif
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @brief Header length following an H4 packet type, 0 for an unknown type
+ ****************************************************************************************
+ */
+static uint8_t hci_h4_hdr_len(uint8_t type)
+{
+    switch (type)
+    {
+        case HCI_H4_CMD:
+            return 3;
+        case HCI_H4_ACL:
+            return 4;
+        case HCI_H4_SCO:
+            return 3;
+        case HCI_H4_EVT:
+            return 2;
+        default:
+            return 0;
+    }
+}
+
+/**
+ ****************************************************************************************
+ * @brief Initialize the framing of one direction
+ * @param[in] frame     Framing state
+ * @param[in] buf       Packet storage, NULL to count packets only
+ * @param[in] size      Storage size
+ ****************************************************************************************
+ */
+void hci_h4_frame_init(struct hci_h4_frame *frame, uint8_t *buf, uint16_t size)
+{
+    memset(frame, 0, sizeof(struct hci_h4_frame));
+    frame->buf = buf;
+    frame->size = buf ? size : 0;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Split a byte stream into H4 packets
+ * @param[in] frame     Framing state
+ * @param[in] data      Bytes, in any pieces
+ * @param[in] len       Number of bytes
+ * @param[in] done      Called for every complete packet, frame->len is its length
+ * @description
+ *  Bytes which do not start a known packet type are dropped and counted in frame->err,
+ *  the framing resynchronizes on the next valid type.
+ ****************************************************************************************
+ */
+void hci_h4_frame_feed(struct hci_h4_frame *frame, uint8_t const *data, uint32_t len,
+                       void (*done)(struct hci_h4_frame *frame))
+{
+    uint8_t c, hdr_len;
+
+    while (len--)
+    {
+        c = *data++;
+
+        if (frame->len == 0 && hci_h4_hdr_len(c) == 0)
+        {
+            frame->err++;
+            continue;
+        }
+
+        if (frame->len < sizeof(frame->hdr))
+            frame->hdr[frame->len] = c;
+        if (frame->len < frame->size)
+            frame->buf[frame->len] = c;
+        frame->len++;
+
+        hdr_len = hci_h4_hdr_len(frame->hdr[0]);
+        if (frame->total == 0 && frame->len == 1 + hdr_len)
+        {
+            // Parameter length is the last header field, 16 bits for ACL data
+            frame->total = frame->len + frame->hdr[hdr_len];
+            if (frame->hdr[0] == HCI_H4_ACL)
+                frame->total = frame->len + (frame->hdr[3] | (frame->hdr[4] << 8));
+        }
+
+        if (frame->total != 0 && frame->len == frame->total)
+        {
+            frame->pkt++;
+            if (done != NULL)
+                done(frame);
+            frame->len = 0;
+            frame->total = 0;
+        }
+    }
+}
+
+#if (QN_HCI_H4)
+#if (QN_HCI_SNOOP)
+/**
+ ****************************************************************************************
+ * @brief Write a big endian 32 bits value
+ ****************************************************************************************
+ */
+static void hci_h4_wr32be(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Capture UART has sent a part of the btsnoop stream
+ ****************************************************************************************
+ */
+static void hci_h4_snoop_done(void)
+{
+    ring_skip(&hci_h4_env.snoop, hci_h4_env.snoop_len);
+    hci_h4_env.snoop_len = 0;
+    hci_h4_snoop_kick();
+}
+
+/**
+ ****************************************************************************************
+ * @brief Send the queued btsnoop stream, called with interrupts disabled or from the
+ * capture UART callback
+ ****************************************************************************************
+ */
+static void hci_h4_snoop_kick(void)
+{
+    uint16_t len;
+    uint8_t *p;
+
+    if (hci_h4_env.snoop_len != 0)
+        return;
+
+    p = ring_peek_ptr(&hci_h4_env.snoop, &len);
+    if (len != 0)
+    {
+        hci_h4_env.snoop_len = len;
+        uart_write(QN_HCI_SNOOP_PORT, p, len, hci_h4_snoop_done);
+    }
+}
+
+/**
+ ****************************************************************************************
+ * @brief Queue a btsnoop record for a complete packet
+ ****************************************************************************************
+ */
+static void hci_h4_snoop_put(struct hci_h4_frame *frame)
+{
+    uint8_t rec[HCI_SNOOP_REC_LEN];
+    uint16_t incl = (frame->len < frame->size) ? frame->len : frame->size;
+    uint32_t flags = 0, now = ke_time();
+    uint64_t ts;
+
+    if (ring_space(&hci_h4_env.snoop) < HCI_SNOOP_REC_LEN + incl)
+    {
+        hci_h4_env.snoop_drop++;
+        return;
+    }
+
+    // ke_time() is a 23 bits counter of 10ms
+    if (now < hci_h4_env.time_last)
+        hci_h4_env.time_wrap++;
+    hci_h4_env.time_last = now;
+    ts = HCI_SNOOP_EPOCH_DELTA + (((uint64_t)hci_h4_env.time_wrap << 23) + now) * 10000;
+
+    // Direction is seen from the host
+    if (frame == &hci_h4_env.tx_frame)
+        flags |= HCI_SNOOP_FLAG_RECV;
+    if (frame->hdr[0] == HCI_H4_CMD || frame->hdr[0] == HCI_H4_EVT)
+        flags |= HCI_SNOOP_FLAG_CMD_EVT;
+
+    hci_h4_wr32be(&rec[0], frame->len);
+    hci_h4_wr32be(&rec[4], incl);
+    hci_h4_wr32be(&rec[8], flags);
+    hci_h4_wr32be(&rec[12], hci_h4_env.snoop_drop);
+    hci_h4_wr32be(&rec[16], (uint32_t)(ts >> 32));
+    hci_h4_wr32be(&rec[20], (uint32_t)ts);
+
+    ring_fill(&hci_h4_env.snoop, 0, rec, HCI_SNOOP_REC_LEN);
+    ring_fill(&hci_h4_env.snoop, HCI_SNOOP_REC_LEN, frame->buf, incl);
+    ring_commit(&hci_h4_env.snoop, HCI_SNOOP_REC_LEN + incl);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Start the btsnoop stream with the file header
+ ****************************************************************************************
+ */
+static void hci_h4_snoop_init(void)
+{
+    uint8_t hdr[HCI_SNOOP_HDR_LEN] = {'b', 't', 's', 'n', 'o', 'o', 'p', 0};
+
+    ring_init(&hci_h4_env.snoop, hci_h4_env.snoop_buf, HCI_H4_SNOOP_RING_SIZE);
+    hci_h4_wr32be(&hdr[8], 1);
+    hci_h4_wr32be(&hdr[12], HCI_SNOOP_DATALINK_H4);
+    ring_write(&hci_h4_env.snoop, hdr, HCI_SNOOP_HDR_LEN);
+}
+#endif
+
+/**
+ ****************************************************************************************
+ * @brief UART has sent a part of the TX ring
+ ****************************************************************************************
+ */
+static void hci_h4_tx_done(void)
+{
+    ring_skip(&hci_h4_env.tx, hci_h4_env.tx_len);
+    hci_h4_env.tx_len = 0;
+    hci_h4_tx_kick();
+
+    // Room for the rest of a pending stack write
+    if (hci_h4_env.wr_cb != NULL)
+        ke_evt_set(1UL << EVENT_HCI_H4_ID);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Send the queued bytes, called with interrupts disabled or from the UART callback
+ ****************************************************************************************
+ */
+static void hci_h4_tx_kick(void)
+{
+    uint16_t len;
+    uint8_t *p;
+
+    if (hci_h4_env.tx_len != 0)
+        return;
+
+    p = ring_peek_ptr(&hci_h4_env.tx, &len);
+    if (len != 0)
+    {
+        hci_h4_env.tx_len = len;
+        uart_write(hci_h4_env.port, p, len, hci_h4_tx_done);
+    }
+}
+
+/**
+ ****************************************************************************************
+ * @brief UART has received a byte, hands it to the background
+ ****************************************************************************************
+ */
+static void hci_h4_rx_done(void)
+{
+    if (!ring_write(&hci_h4_env.rx, &hci_h4_env.rx_byte, 1))
+        hci_h4_env.rx_overflow++;
+
+    if ((hci_h4_env.rd_cb != NULL && ring_count(&hci_h4_env.rx) >= hci_h4_env.rd_size)
+        || (!hci_h4_env.throttled && ring_space(&hci_h4_env.rx) < HCI_H4_RX_HIGH_WATER))
+    {
+        ke_evt_set(1UL << EVENT_HCI_H4_ID);
+    }
+
+    uart_read(hci_h4_env.port, &hci_h4_env.rx_byte, 1, hci_h4_rx_done);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Packet complete in one direction
+ ****************************************************************************************
+ */
+static void hci_h4_packet(struct hci_h4_frame *frame)
+{
+#if (QN_HCI_SNOOP)
+    hci_h4_snoop_put(frame);
+#endif
+}
+
+/**
+ ****************************************************************************************
+ * @brief Background event: serve the stack reads and writes, follow the RX ring level
+ ****************************************************************************************
+ */
+static void hci_h4_event(void)
+{
+    void (*cb)(void);
+    uint16_t len;
+
+    // Clear first, the callbacks below may set it again
+    ke_evt_clear(1UL << EVENT_HCI_H4_ID);
+
+    // The stack reads a packet piece by piece, type, header then parameters
+    while (hci_h4_env.rd_cb != NULL && ring_count(&hci_h4_env.rx) >= hci_h4_env.rd_size)
+    {
+        ring_read(&hci_h4_env.rx, hci_h4_env.rd_buf, hci_h4_env.rd_size);
+        hci_h4_frame_feed(&hci_h4_env.rx_frame, hci_h4_env.rd_buf, hci_h4_env.rd_size, hci_h4_packet);
+        cb = hci_h4_env.rd_cb;
+        hci_h4_env.rd_cb = NULL;
+        cb();
+    }
+
+#if (HCI_H4_FLOW_CTRL)
+    if (!hci_h4_env.throttled && ring_space(&hci_h4_env.rx) < HCI_H4_RX_HIGH_WATER)
+    {
+        // Fails while a byte is being sent, retried on the next received byte
+        if (uart_flow_off(hci_h4_env.port))
+        {
+            hci_h4_env.throttled = true;
+            hci_h4_env.throttle++;
+        }
+    }
+    else if (hci_h4_env.throttled && ring_space(&hci_h4_env.rx) >= HCI_H4_RX_LOW_WATER)
+    {
+        uart_flow_on(hci_h4_env.port);
+        hci_h4_env.throttled = false;
+    }
+#endif
+
+    // Queue the stack writes, the stack goes on while the UART drains the ring
+    while (hci_h4_env.wr_cb != NULL)
+    {
+        len = ring_space(&hci_h4_env.tx);
+        if (len > hci_h4_env.wr_size)
+            len = hci_h4_env.wr_size;
+        if (len == 0 && hci_h4_env.wr_size != 0)
+            break;
+
+        ring_write(&hci_h4_env.tx, hci_h4_env.wr_buf, len);
+        hci_h4_frame_feed(&hci_h4_env.tx_frame, hci_h4_env.wr_buf, len, hci_h4_packet);
+        hci_h4_env.wr_buf += len;
+        hci_h4_env.wr_size -= len;
+
+        GLOBAL_INT_DISABLE();
+        hci_h4_tx_kick();
+        GLOBAL_INT_RESTORE();
+
+        if (hci_h4_env.wr_size == 0)
+        {
+            cb = hci_h4_env.wr_cb;
+            hci_h4_env.wr_cb = NULL;
+            cb();
+        }
+    }
+
+#if (QN_HCI_SNOOP)
+    GLOBAL_INT_DISABLE();
+    hci_h4_snoop_kick();
+    GLOBAL_INT_RESTORE();
+#endif
+}
+
+/**
+ ****************************************************************************************
+ * @brief Start the H4 transport
+ * @param[in] port      HCI UART, initialized by SystemInit()
+ * @description
+ *  Called after ble_init(), the reads the stack issued before are served from here.
+ ****************************************************************************************
+ */
+void hci_h4_init(void *port)
+{
+    hci_h4_env.port = port;
+    ring_init(&hci_h4_env.rx, hci_h4_env.rx_buf, HCI_H4_RX_RING_SIZE);
+    ring_init(&hci_h4_env.tx, hci_h4_env.tx_buf, HCI_H4_TX_RING_SIZE);
+#if (QN_HCI_SNOOP)
+    hci_h4_frame_init(&hci_h4_env.rx_frame, hci_h4_env.rx_pkt, HCI_H4_FRAME_MAX);
+    hci_h4_frame_init(&hci_h4_env.tx_frame, hci_h4_env.tx_pkt, HCI_H4_FRAME_MAX);
+    hci_h4_snoop_init();
+#else
+    hci_h4_frame_init(&hci_h4_env.rx_frame, NULL, 0);
+    hci_h4_frame_init(&hci_h4_env.tx_frame, NULL, 0);
+#endif
+
+    if (KE_EVENT_OK != ke_evt_callback_set(EVENT_HCI_H4_ID, hci_h4_event))
+    {
+        ASSERT_ERR(0);
+    }
+
+#if (HCI_H4_FLOW_CTRL)
+    uart_uart_SetCRWithMask(port, UART_MASK_CTS_EN | UART_MASK_RTS_EN, MASK_ENABLE);
+    uart_flow_on(port);
+#endif
+
+    uart_read(port, &hci_h4_env.rx_byte, 1, hci_h4_rx_done);
+    ke_evt_set(1UL << EVENT_HCI_H4_ID);
+}
+
+/**
+ ****************************************************************************************
+ * @brief hci_api read given to ble_init()
+ * @description
+ *  The callback is called from the background once size bytes are received.
+ ****************************************************************************************
+ */
+void hci_h4_read(void *port, uint8_t *bufptr, uint32_t size, void (*callback)(void))
+{
+    hci_h4_env.rd_buf = bufptr;
+    hci_h4_env.rd_size = size;
+    hci_h4_env.rd_cb = callback;
+
+    if (hci_h4_env.port != NULL)
+        ke_evt_set(1UL << EVENT_HCI_H4_ID);
+}
+
+/**
+ ****************************************************************************************
+ * @brief hci_api write given to ble_init()
+ * @description
+ *  The callback is called from the background once the bytes are queued, not sent.
+ ****************************************************************************************
+ */
+void hci_h4_write(void *port, uint8_t *bufptr, uint32_t size, void (*callback)(void))
+{
+    hci_h4_env.wr_buf = bufptr;
+    hci_h4_env.wr_size = size;
+    hci_h4_env.wr_cb = callback;
+
+    if (hci_h4_env.port != NULL)
+        ke_evt_set(1UL << EVENT_HCI_H4_ID);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Get the transport statistics
+ ****************************************************************************************
+ */
+void hci_h4_stat_get(struct hci_h4_stat *stat)
+{
+    stat->rx_pkt = hci_h4_env.rx_frame.pkt;
+    stat->tx_pkt = hci_h4_env.tx_frame.pkt;
+    stat->framing_err = hci_h4_env.rx_frame.err + hci_h4_env.tx_frame.err;
+    stat->rx_overflow = hci_h4_env.rx_overflow;
+    stat->throttle = hci_h4_env.throttle;
+#if (QN_HCI_SNOOP)
+    stat->snoop_drop = hci_h4_env.snoop_drop;
+#else
+    stat->snoop_drop = 0;
+#endif
+}
+#endif
+
+/// @} HCI_H4
@@ -0,0 +1,127 @@
+/**
+ ****************************************************************************************
+ *
+ * @file hci_h4.h
+ *
+ * @brief Buffered H4 transport between the BLE stack and the HCI UART (controller mode).
+ *
+ * Copyright(C) 2015 NXP Semiconductors N.V.
+ * All rights reserved.
+ *
+ * $Rev: 1.0 $
+ *
+ ****************************************************************************************
+ */
+
+#ifndef HCI_H4_H_
+#define HCI_H4_H_
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include "app_config.h"
+#include "ring.h"
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// Received bytes waiting for the stack, power of 2 and larger than any HCI packet
+#ifndef HCI_H4_RX_RING_SIZE
+#define HCI_H4_RX_RING_SIZE         512
+#endif
+/// Bytes written by the stack waiting for the UART, power of 2
+#ifndef HCI_H4_TX_RING_SIZE
+#define HCI_H4_TX_RING_SIZE         512
+#endif
+/// The host is stopped (RTS deasserted) when less room is left in the RX ring
+#define HCI_H4_RX_HIGH_WATER        64
+/// The host is released again when this room is available
+#define HCI_H4_RX_LOW_WATER         256
+/// Hardware flow control, RTS/CTS pins are switched by uart_flow_on/off()
+#ifndef HCI_H4_FLOW_CTRL
+#define HCI_H4_FLOW_CTRL            1
+#endif
+
+/// btsnoop records waiting for the capture UART, power of 2
+#ifndef HCI_H4_SNOOP_RING_SIZE
+#define HCI_H4_SNOOP_RING_SIZE      1024
+#endif
+/// Longest packet kept in a capture, H4 type + ACL header + 251 bytes
+#define HCI_H4_FRAME_MAX            256
+
+#ifndef EVENT_HCI_H4_ID
+#define EVENT_HCI_H4_ID             12
+#endif
+
+/// H4 packet types
+enum hci_h4_type
+{
+    HCI_H4_CMD = 0x01,
+    HCI_H4_ACL = 0x02,
+    HCI_H4_SCO = 0x03,
+    HCI_H4_EVT = 0x04,
+};
+
+/*
+ * TYPE DEFINITIONS
+ ****************************************************************************************
+ */
+
+/// H4 framing of one direction
+struct hci_h4_frame
+{
+    /// Packet storage, NULL to count packets only
+    uint8_t *buf;
+    /// Storage size, longer packets are truncated
+    uint16_t size;
+    /// Bytes of the current packet, H4 type included
+    uint16_t len;
+    /// Length of the current packet once its header is complete, 0 before
+    uint16_t total;
+    /// H4 type and header of the current packet
+    uint8_t hdr[5];
+    /// Complete packets
+    uint32_t pkt;
+    /// Bytes dropped while looking for a packet type
+    uint32_t err;
+};
+
+/// Transport statistics
+struct hci_h4_stat
+{
+    /// Packets from the host
+    uint32_t rx_pkt;
+    /// Packets to the host
+    uint32_t tx_pkt;
+    /// Bytes dropped out of packet framing
+    uint32_t framing_err;
+    /// Bytes lost because the RX ring was full
+    uint32_t rx_overflow;
+    /// Times the host was stopped by flow control
+    uint32_t throttle;
+    /// Packets missing from the capture
+    uint32_t snoop_drop;
+};
+
+/*
+ * FUNCTION DECLARATIONS
+ ****************************************************************************************
+ */
+
+extern void hci_h4_frame_init(struct hci_h4_frame *frame, uint8_t *buf, uint16_t size);
+extern void hci_h4_frame_feed(struct hci_h4_frame *frame, uint8_t const *data, uint32_t len,
+                              void (*done)(struct hci_h4_frame *frame));
+
+#if (QN_HCI_H4)
+extern void hci_h4_init(void *port);
+extern void hci_h4_read(void *port, uint8_t *bufptr, uint32_t size, void (*callback)(void));
+extern void hci_h4_write(void *port, uint8_t *bufptr, uint32_t size, void (*callback)(void));
+extern void hci_h4_stat_get(struct hci_h4_stat *stat);
+#endif
+
+#endif // HCI_H4_H_
@@ -62,8 +62,14 @@ static void SystemIOCfg(void)
                              | P16_GPIO_14_PIN_CTRL
                              | P17_UART0_RXD_PIN_CTRL
                              );
-    syscon_SetPMCR1(QN_SYSCON, P20_GPIO_16_PIN_CTRL
+    syscon_SetPMCR1(QN_SYSCON,
+#if (QN_HCI_SNOOP)
+                               P20_UART1_RXD_PIN_CTRL
+                             | P21_UART1_TXD_PIN_CTRL       //P2.1 btsnoop capture
+#else
+                               P20_GPIO_16_PIN_CTRL
                              | P21_GPIO_17_PIN_CTRL
+#endif
                              | P22_GPIO_18_PIN_CTRL
                              | P23_GPIO_19_PIN_CTRL
                              | P24_GPIO_20_PIN_CTRL
@@ -195,6 +201,11 @@ void SystemInit(void)
     uart_init(QN_HCI_PORT, USARTx_CLK(0), UART_9600);
     uart_tx_enable(QN_HCI_PORT, MASK_ENABLE);
     uart_rx_enable(QN_HCI_PORT, MASK_ENABLE);
+#if (QN_HCI_SNOOP)
+    // Initialize btsnoop capture port
+    uart_init(QN_HCI_SNOOP_PORT, USARTx_CLK(0), UART_500000);
+    uart_tx_enable(QN_HCI_SNOOP_PORT, MASK_ENABLE);
+#endif
 #elif (defined(CFG_HCI_SPI))
     // Initialize HCI SPI port
     spi_init(QN_HCI_PORT, SPI_BITRATE(1000000), SPI_8BIT, SPI_SLAVE_MOD);
@@ -96,6 +96,12 @@
 
 /// Transport layer UART interface used in network processor mode and controller mode
 #define CFG_HCI_UART                    QN_UART0
+
+/// Buffered H4 transport with RX/TX rings and RTS/CTS flow control on the HCI UART
+#define CFG_HCI_H4
+
+/// btsnoop capture of the HCI packets on this UART (P2.1 TXD for QN_UART1)
+// #define CFG_HCI_SNOOP                   QN_UART1
 /// Transport layer SPI interface used in network processor mode and controller mode
 //#define CFG_HCI_SPI                     QN_SPI0
 /// SPI write ready, notify host to read from SPI, output
@@ -128,6 +134,27 @@
 /// Support service discovery
 // #define CFG_SVC_DISC
 
+/// Create server databases without kernel message round-trips at boot
+// #define CFG_SVC_DB_DIRECT
+
+/// BLE heap statistics: free bytes, largest block, peak usage
+// #define CFG_HEAP_STAT
+
+/// Sleep profile: power mode residency, blocking reasons, wakeup sources
+// #define CFG_SLEEP_STAT
+
+/// Handler profile: calls and processor cycles of event callbacks and message handlers
+// #define CFG_TASK_PROF
+
+/// BLE heap trace: application allocations by message, outstanding blocks, size advice (needs CFG_HEAP_STAT)
+// #define CFG_HEAP_TRACE
+
+/// Resolve private addresses against all bonded IRKs locally, with a cache of resolved addresses
+// #define CFG_RPA_RESOLVE
+
+/// Request fast or slow connection parameters following the link traffic (peripheral)
+// #define CFG_CONN_POLICY
+
 /// Profile Discoveried Service Content Used 
 // #define CFG_SVC_CONTENT
 
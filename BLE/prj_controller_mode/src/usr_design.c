@@ -57,7 +57,9 @@ void usr_sleep_restore(void)
  */
 void usr_init(void)
 {
-
+#if (QN_HCI_H4)
+    hci_h4_init(QN_HCI_PORT);
+#endif
 }
 
 /// @} USR
@@ -16,6 +16,8 @@
 #ifndef USR_DESIGN_H_
 #define USR_DESIGN_H_
 
+#include "hci_h4.h"
+
 /*
  * FUNCTION DECLARATIONS
  ****************************************************************************************
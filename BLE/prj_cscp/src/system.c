@@ -64,10 +64,18 @@ static void SystemIOCfg(void)
     syscon_SetPMCR1(QN_SYSCON, P20_GPIO_16_PIN_CTRL
                              | P21_GPIO_17_PIN_CTRL
                              | P22_GPIO_18_PIN_CTRL
+#if (TIMER_CAP_EN==TRUE)
+                             | P23_TIMER3_ICP0_PIN_CTRL     //P2.3 crank sensor
+#else
                              | P23_GPIO_19_PIN_CTRL
+#endif
                              | P24_GPIO_20_PIN_CTRL
                              | P25_GPIO_21_PIN_CTRL
+#if (TIMER_CAP_EN==TRUE)
+                             | P26_TIMER2_ICP0_PIN_CTRL     //P2.6 wheel sensor
+#else
                              | P26_GPIO_22_PIN_CTRL
+#endif
                              | P27_GPIO_23_PIN_CTRL
 
 #if	!(FB_JOYSTICKS)
@@ -34,6 +34,9 @@
 #include "gpio.h"
 #include "button.h"
 #include "sleep.h"
+#if (TIMER_CAP_EN==TRUE)
+#include "timer.h"
+#endif
 
 #if	 (FB_JOYSTICKS)
 #include "joysticks.h"
@@ -53,7 +56,22 @@
 #define LED_ON_DUR_IDLE         0
 #define LED_OFF_DUR_IDLE        0xffff
 
+// The sensor capture (TIMER_CAP_EN in driver_config.h, off by default) keeps Timer2/3
+// clocked, so the chip stays awake while notifications are enabled. Its measurements
+// are then sent every second like a real sensor instead of the 12s of the demo values.
+#if (TIMER_CAP_EN==TRUE)
+#define APP_CSCPS_MEAS_SEND_TO  100  // 1s
+#else
 #define APP_CSCPS_MEAS_SEND_TO  1200 // 12s is used for demo
+#endif
+
+#if (TIMER_CAP_EN==TRUE)
+/// Wheel sensor on the capture pin of Timer2 (P2.6), crank sensor on Timer3 (P2.3)
+#define USR_CSC_WHEEL_TIMER     QN_TIMER2
+#define USR_CSC_CRANK_TIMER     QN_TIMER3
+/// Capture prescaler, 8kHz ticks with the 8MHz timer clock
+#define USR_CSC_CAP_PSCAL       999
+#endif
 
 #define EVENT_BUTTON1_PRESS_ID  0
 
@@ -64,6 +82,14 @@
 
 struct usr_env_tag usr_env = {LED_ON_DUR_IDLE, LED_OFF_DUR_IDLE};
 
+#if (TIMER_CAP_EN==TRUE)
+/// Wheel and crank revolutions captured on the sensor edges
+static struct timer_cap usr_wheel_cap;
+static struct timer_cap usr_crank_cap;
+/// Wheel revolutions already reported to the profile
+static uint32_t usr_wheel_sent;
+#endif
+
 
 /*
  * FUNCTION DEFINITIONS
@@ -72,33 +98,37 @@ struct usr_env_tag usr_env = {LED_ON_DUR_IDLE, LED_OFF_DUR_IDLE};
 
 /**
  ****************************************************************************************
- * @brief   Led1 for BLE status
+ * @brief   Arm the led timer with the delay returned by the led pattern engine
  ****************************************************************************************
  */
-static void usr_led1_set(uint16_t timer_on, uint16_t timer_off)
+static void usr_led1_timer(uint16_t delay)
 {
-    usr_env.led1_on_dur = timer_on;
-    usr_env.led1_off_dur = timer_off;
-
-    if (timer_on == 0 || timer_off == 0)
+    if (delay != 0)
     {
-        if (timer_on == 0)
-        {
-            led_set(1, LED_OFF);
-        }
-        if (timer_off == 0)
-        {
-            led_set(1, LED_ON);
-        }
-        ke_timer_clear(APP_SYS_LED_1_TIMER, TASK_APP);
+        ke_timer_set(APP_SYS_LED_1_TIMER, TASK_APP, delay);
     }
     else
     {
-        led_set(1, LED_OFF);
-        ke_timer_set(APP_SYS_LED_1_TIMER, TASK_APP, timer_off);
+        ke_timer_clear(APP_SYS_LED_1_TIMER, TASK_APP);
     }
 }
 
+/**
+ ****************************************************************************************
+ * @brief   Led1 for BLE status
+ ****************************************************************************************
+ */
+static void usr_led1_set(uint16_t timer_on, uint16_t timer_off)
+{
+    static struct led_pattern pattern;
+
+    usr_env.led1_on_dur = timer_on;
+    usr_env.led1_off_dur = timer_off;
+
+    led_pattern_blink(&pattern, LED_MATRIX(1), timer_on, timer_off);
+    usr_led1_timer(led_pattern_start(0, &pattern));
+}
+
 /**
  ****************************************************************************************
  * @brief   Led 1 flash process
@@ -106,16 +136,18 @@ static void usr_led1_set(uint16_t timer_on, uint16_t timer_off)
  */
 static void usr_led1_process(void)
 {
-    if(led_get(1) == LED_ON)
-    {
-        led_set(1, LED_OFF);
-        ke_timer_set(APP_SYS_LED_1_TIMER, TASK_APP, usr_env.led1_off_dur);
-    }
-    else
-    {
-        led_set(1, LED_ON);
-        ke_timer_set(APP_SYS_LED_1_TIMER, TASK_APP, usr_env.led1_on_dur);
-    }
+    usr_led1_timer(led_pattern_process());
+}
+
+/**
+ ****************************************************************************************
+ * @brief   Led 1 steps played at a wakeup of the BLE stack instead of their own
+ ****************************************************************************************
+ */
+static void app_event_led_pattern_handler(void)
+{
+    ke_evt_clear(1UL << EVENT_LED_PATTERN_ID);
+    usr_led1_timer(led_pattern_process_early());
 }
 
 /**
@@ -183,6 +215,10 @@ void app_task_msg_hdl(ke_msg_id_t const msgid, void const *param)
 
         case CSCPS_DISABLE_IND:
             ke_timer_clear(APP_CSCPS_MEAS_SEND_TIMER, TASK_APP);
+#if (TIMER_CAP_EN==TRUE)
+            timer_cap_stop(&usr_wheel_cap);
+            timer_cap_stop(&usr_crank_cap);
+#endif
             break;
 
         case CSCPS_NTF_IND_CFG_IND:
@@ -194,10 +230,19 @@ void app_task_msg_hdl(ke_msg_id_t const msgid, void const *param)
                 {
                     app_cscps_env->ntf_sending = false;
                     ke_timer_set(APP_CSCPS_MEAS_SEND_TIMER, TASK_APP, APP_CSCPS_MEAS_SEND_TO);
+#if (TIMER_CAP_EN==TRUE)
+                    timer_cap_start(USR_CSC_WHEEL_TIMER, &usr_wheel_cap, USR_CSC_CAP_PSCAL, INCAP_EDGE_POS);
+                    timer_cap_start(USR_CSC_CRANK_TIMER, &usr_crank_cap, USR_CSC_CAP_PSCAL, INCAP_EDGE_POS);
+                    usr_wheel_sent = 0;
+#endif
                 }
                 else
                 {
                     ke_timer_clear(APP_CSCPS_MEAS_SEND_TIMER, TASK_APP);
+#if (TIMER_CAP_EN==TRUE)
+                    timer_cap_stop(&usr_wheel_cap);
+                    timer_cap_stop(&usr_crank_cap);
+#endif
                 }
             }
             else if (cfg->char_code == CSCP_CSCS_SC_CTNL_PT_CHAR)
@@ -313,6 +358,12 @@ int app_cscps_meas_send_timer_handler(ke_msg_id_t const msgid,
                                       ke_task_id_t const dest_id,
                                       ke_task_id_t const src_id)
 {
+#if (TIMER_CAP_EN==TRUE)
+    struct timer_cap_stat wheel;
+    struct timer_cap_stat crank;
+    uint32_t wheel_rev;
+#endif
+
     //DEVELOPER NOTE: SET REAL VALUE OF USER APPLICATION IN THIS FUNCTION
     if (app_cscps_env->enabled == true &&
         (app_cscps_env->app_cfg & CSCP_PRF_CFG_FLAG_CSC_MEAS_NTF))
@@ -320,8 +371,23 @@ int app_cscps_meas_send_timer_handler(ke_msg_id_t const msgid,
         if (app_cscps_env->ntf_sending == false)
         {
             app_cscps_env->ntf_sending = true;
+#if (TIMER_CAP_EN==TRUE)
+            timer_cap_stat_get(&usr_wheel_cap, &wheel);
+            timer_cap_stat_get(&usr_crank_cap, &crank);
+
+            // The profile accumulates the wheel revolutions since the last notification
+            wheel_rev = wheel.count - usr_wheel_sent;
+            if (wheel_rev > 0x7FFF)
+                wheel_rev = 0x7FFF;
+            usr_wheel_sent += wheel_rev;
+
+            app_cscps_ntf_csc_meas_req(app_cscps_env->conhdl, CSCP_MEAS_WHEEL_REV_DATA_PRESENT | CSCP_MEAS_CRANK_REV_DATA_PRESENT,
+                                   (uint16_t)crank.count, timer_cap_time_1024(&usr_crank_cap, crank.last),
+                                   timer_cap_time_1024(&usr_wheel_cap, wheel.last), (int16_t)wheel_rev);
+#else
             app_cscps_ntf_csc_meas_req(app_cscps_env->conhdl, CSCP_MEAS_WHEEL_REV_DATA_PRESENT | CSCP_MEAS_CRANK_REV_DATA_PRESENT,  
                                    1000, 50, 500, 60);
+#endif
         }
         ke_timer_set(APP_CSCPS_MEAS_SEND_TIMER, TASK_APP, APP_CSCPS_MEAS_SEND_TO);
     }
@@ -340,6 +406,12 @@ void usr_sleep_restore(void)
     uart_tx_enable(QN_DEBUG_UART, MASK_ENABLE);
     uart_rx_enable(QN_DEBUG_UART, MASK_ENABLE);
 #endif
+
+    // A led step due soon ends now rather than waking the chip up again
+    if (led_pattern_due())
+    {
+        ke_evt_set(1UL << EVENT_LED_PATTERN_ID);
+    }
 }
 
 /**
@@ -502,6 +574,12 @@ void gpio_interrupt_callback(enum gpio_pin pin)
  */
 void usr_init(void)
 {
+    if(KE_EVENT_OK != ke_evt_callback_set(EVENT_LED_PATTERN_ID,
+                                            app_event_led_pattern_handler))
+    {
+        ASSERT_ERR(0);
+    }
+
     if(KE_EVENT_OK != ke_evt_callback_set(EVENT_BUTTON1_PRESS_ID, 
                                             app_event_button1_press_handler))
     {
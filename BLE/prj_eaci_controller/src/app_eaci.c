@@ -61,11 +61,16 @@ void app_eaci_init(void)
 
     reg_eaci_tx_done(eaci_tx_done);
 
+    // init RX ring, drained in background
+    ring_init(&eaci_env.rx_ring, eaci_env.rx_buf, EACI_RX_RING_SIZE);
+    if(KE_EVENT_OK != ke_evt_callback_set(EVENT_EACI_RX_ID, eaci_trans_rx_evt_handler))
+    {
+        ASSERT_ERR(0);
+    }
+
     eaci_env.error = TRUE;
     // start rx
     eaci_trans_init();
-
-    eaci_env.param = NULL;
 }
 
 // Push msg into eaci tx queue
@@ -98,6 +103,26 @@ void eaci_pdu_send(uint8_t len, uint8_t *par)
     eaci_push(ke_param2msg(msg_param));
 }
 
+/**
+ ****************************************************************************************
+ * @brief Pack an EACI data indication with its schema layout and send it
+ *
+ ****************************************************************************************
+ */
+void app_eaci_data_ind_send(uint16_t uuid, uint8_t msg_id, ...)
+{
+    uint8_t pdu[EACI_PDU_HDR_LEN + EACI_DATA_UUID_LEN + EACI_DATA_FIX_MAX_LEN];
+    uint16_t len;
+    va_list ap;
+
+    va_start(ap, msg_id);
+    len = eaci_data_vpack(pdu, EACI_MSG_TYPE_DATA_IND, msg_id, uuid, eaci_data_ind_layout(uuid, msg_id), ap);
+    va_end(ap);
+
+    if (len != 0)
+        eaci_pdu_send(len, pdu);
+}
+
 /**
  ****************************************************************************************
  * @brief After-process when one PDU has been sent.
@@ -155,10 +180,15 @@ void app_eaci_msg_hdl(uint8_t msg_type, uint8_t msg_id, uint8_t param_len, uint8
 
 static void app_eaci_data_hdl(uint8_t msg_id, uint8_t param_len, uint8_t const *param)
 {
-    if (param_len < 2)
+    if (param_len < EACI_DATA_UUID_LEN)
         return;
 
     uint16_t uuid = param[1] << 8 | param[0];
+
+    // Parameters are checked against the schema once, handlers can trust the length
+    if (!eaci_layout_check(eaci_data_req_layout(uuid, msg_id), param_len - EACI_DATA_UUID_LEN))
+        return;
+
     switch (uuid)
     {
 #if (BLE_HR_COLLECTOR || BLE_HR_SENSOR)
@@ -184,14 +184,8 @@ void bp_app_task_msg_hdl(ke_msg_id_t const msgid, void const *param)
     {
 #if BLE_BP_COLLECTOR
         case BLPC_ENABLE_CFM:
-        {
-            uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 3, 0, 0, 0};
-            pdu[1] = EACI_MSG_DATA_IND_BP_ENABLE;
-            pdu[3] = (uint8_t)(ATT_SVC_BLOOD_PRESSURE);
-            pdu[4] = (uint8_t)(ATT_SVC_BLOOD_PRESSURE >> 8);
-            pdu[5] = ((struct blpc_enable_cfm *)param)->status;
-            eaci_pdu_send(sizeof(pdu), pdu);
-        }
+            app_eaci_data_ind_send(ATT_SVC_BLOOD_PRESSURE, EACI_MSG_DATA_IND_BP_ENABLE,
+                                   ((struct blpc_enable_cfm *)param)->status);
             break;
 
         case BLPC_RD_CHAR_RSP:
@@ -220,14 +214,8 @@ void bp_app_task_msg_hdl(ke_msg_id_t const msgid, void const *param)
             break;
 
         case BLPC_WR_CHAR_RSP:
-        {
-            uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 3, 0, 0, 0};
-            pdu[1] = EACI_MSG_DATA_IND_BP_WR_RSP;
-            pdu[3] = (uint8_t)(ATT_SVC_BLOOD_PRESSURE);
-            pdu[4] = (uint8_t)(ATT_SVC_BLOOD_PRESSURE >> 8);
-            pdu[5] = ((struct blpc_wr_char_rsp *)param)->status;
-            eaci_pdu_send(sizeof(pdu), pdu);
-        }
+            app_eaci_data_ind_send(ATT_SVC_BLOOD_PRESSURE, EACI_MSG_DATA_IND_BP_WR_RSP,
+                                   ((struct blpc_wr_char_rsp *)param)->status);
             break;
 
         case BLPC_BP_MEAS_IND:
@@ -246,11 +234,11 @@ void bp_app_task_msg_hdl(ke_msg_id_t const msgid, void const *param)
             
             if (flag & BPS_FLAG_KPA)                        // Pressure in pascal
             {
-                data_len += 4;
+                data_len += 6;
             }
             else                                            // pressure in millimetre of mercury
             {
-                data_len += 4;
+                data_len += 6;
             }
             
             if (flag & BPS_FLAG_PULSE_RATE_PRESENT)         // Pulse Rate
@@ -268,10 +256,11 @@ void bp_app_task_msg_hdl(ke_msg_id_t const msgid, void const *param)
                 data_len += 7;
             }
             
-            pdu = (uint8_t *)malloc(data_len + 7);
+            // header, service UUID, intermediate flag and measurement flags come first
+            pdu = (uint8_t *)malloc(data_len + 8);
             if (pdu != NULL)
             {
-                memset(pdu,0,data_len+7);
+                memset(pdu,0,data_len+8);
                 pdu[0] = EACI_MSG_TYPE_DATA_IND;
                 pdu[1] = EACI_MSG_DATA_IND_BP_MEAS;
                 //pdu[2] = data_len + 7;
@@ -354,27 +343,14 @@ void bp_app_task_msg_hdl(ke_msg_id_t const msgid, void const *param)
 
 #if BLE_BP_SENSOR
         case BLPS_CFG_INDNTF_IND:
-        {
-            uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 5, 0, 0, 0, 0, 0};
-            pdu[1] = EACI_MSG_DATA_IND_BPS_CFG;
-            pdu[3] = (uint8_t)(ATT_SVC_BLOOD_PRESSURE);
-            pdu[4] = (uint8_t)(ATT_SVC_BLOOD_PRESSURE >> 8);
-            pdu[5] = ((struct blps_cfg_indntf_ind *)param)->char_code;
-            pdu[6] = (uint8_t)(((struct blps_cfg_indntf_ind *)param)->cfg_val);
-            pdu[7] = (uint8_t)((((struct blps_cfg_indntf_ind *)param)->cfg_val) >> 8);
-            eaci_pdu_send(sizeof(pdu), pdu);
-        }
+            app_eaci_data_ind_send(ATT_SVC_BLOOD_PRESSURE, EACI_MSG_DATA_IND_BPS_CFG,
+                                   ((struct blps_cfg_indntf_ind *)param)->char_code,
+                                   ((struct blps_cfg_indntf_ind *)param)->cfg_val);
             break;
 
         case BLPS_MEAS_SEND_CFM:
-        {
-            uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 3, 0, 0, 0};
-            pdu[1] = EACI_MSG_DATA_IND_BPS_MEAS_SEND_CFM;
-            pdu[3] = (uint8_t)(ATT_SVC_BLOOD_PRESSURE);
-            pdu[4] = (uint8_t)(ATT_SVC_BLOOD_PRESSURE >> 8);
-            pdu[5] = ((struct blps_meas_send_cfm *)param)->status;
-            eaci_pdu_send(sizeof(pdu), pdu);
-        }
+            app_eaci_data_ind_send(ATT_SVC_BLOOD_PRESSURE, EACI_MSG_DATA_IND_BPS_MEAS_SEND_CFM,
+                                   ((struct blps_meas_send_cfm *)param)->status);
             break;
 #endif
         default:
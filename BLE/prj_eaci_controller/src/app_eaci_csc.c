@@ -193,48 +193,24 @@ void csc_app_task_msg_hdl(ke_msg_id_t const msgid, void const *param)
             switch (operation)
             {
                 case CSCPC_ENABLE_OP_CODE:
-                {
-                    uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 3, 0, 0, 0};
-                    pdu[1] =  EACI_MSG_DATA_IND_CSCPC_ENABLE;
-                    pdu[3] = (uint8_t)(ATT_SVC_CYCLING_SPEED_CADENCE);
-                    pdu[4] = (uint8_t)(ATT_SVC_CYCLING_SPEED_CADENCE >> 8);
-                    pdu[5] = ((struct cscpc_cmp_evt *)param)->status;
-                    eaci_pdu_send(sizeof(pdu), pdu);
+                    app_eaci_data_ind_send(ATT_SVC_CYCLING_SPEED_CADENCE, EACI_MSG_DATA_IND_CSCPC_ENABLE,
+                                           ((struct cscpc_cmp_evt *)param)->status);
                     break;
-                }
 
                 case CSCPC_READ_OP_CODE:
-                {
-                    uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 3, 0, 0, 0};
-                    pdu[1] =  EACI_MSG_DATA_IND_CSCPC_READ;
-                    pdu[3] = (uint8_t)(ATT_SVC_CYCLING_SPEED_CADENCE);
-                    pdu[4] = (uint8_t)(ATT_SVC_CYCLING_SPEED_CADENCE >> 8);
-                    pdu[5] = ((struct cscpc_cmp_evt *)param)->status;
-                    eaci_pdu_send(sizeof(pdu), pdu);
+                    app_eaci_data_ind_send(ATT_SVC_CYCLING_SPEED_CADENCE, EACI_MSG_DATA_IND_CSCPC_READ,
+                                           ((struct cscpc_cmp_evt *)param)->status);
                     break;
-                }
 
                 case CSCPC_CFG_NTF_IND_OP_CODE:
-                {
-                    uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 3, 0, 0, 0};
-                    pdu[1] =  EACI_MSG_DATA_IND_CSCPC_WR_CFG_STATUS;
-                    pdu[3] = (uint8_t)(ATT_SVC_CYCLING_SPEED_CADENCE);
-                    pdu[4] = (uint8_t)(ATT_SVC_CYCLING_SPEED_CADENCE >> 8);
-                    pdu[5] = ((struct cscpc_cmp_evt *)param)->status;
-                    eaci_pdu_send(sizeof(pdu), pdu);
+                    app_eaci_data_ind_send(ATT_SVC_CYCLING_SPEED_CADENCE, EACI_MSG_DATA_IND_CSCPC_WR_CFG_STATUS,
+                                           ((struct cscpc_cmp_evt *)param)->status);
                     break;
-                }
 
                 case CSCPC_CTNL_PT_CFG_WR_OP_CODE:
-                {
-                    uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 3, 0, 0, 0};
-                    pdu[1] =  EACI_MSG_DATA_IND_CSCPC_CFG_WR;
-                    pdu[3] = (uint8_t)(ATT_SVC_CYCLING_SPEED_CADENCE);
-                    pdu[4] = (uint8_t)(ATT_SVC_CYCLING_SPEED_CADENCE >> 8);
-                    pdu[5] = ((struct cscpc_cmp_evt *)param)->status;
-                    eaci_pdu_send(sizeof(pdu), pdu);
+                    app_eaci_data_ind_send(ATT_SVC_CYCLING_SPEED_CADENCE, EACI_MSG_DATA_IND_CSCPC_CFG_WR,
+                                           ((struct cscpc_cmp_evt *)param)->status);
                     break;
-                }
 
                 default:
                     break;
@@ -249,65 +225,31 @@ void csc_app_task_msg_hdl(ke_msg_id_t const msgid, void const *param)
             switch (att_code)
             {
                 case CSCPC_RD_CSC_FEAT:
-                {
-                    uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 4, 0, 0, 0, 0};
-                    pdu[1] =  EACI_MSG_DATA_IND_CSCPC_RD_CSC_FEAT;
-                    pdu[3] = (uint8_t)(ATT_SVC_CYCLING_SPEED_CADENCE);
-                    pdu[4] = (uint8_t)(ATT_SVC_CYCLING_SPEED_CADENCE >> 8);
-                    pdu[5] = (uint8_t)(((struct cscpc_value_ind *)param)->value.sensor_feat);
-                    pdu[6] = (uint8_t)(((struct cscpc_value_ind *)param)->value.sensor_feat >> 8);
-                    eaci_pdu_send(sizeof(pdu), pdu);
+                    app_eaci_data_ind_send(ATT_SVC_CYCLING_SPEED_CADENCE, EACI_MSG_DATA_IND_CSCPC_RD_CSC_FEAT,
+                                           ((struct cscpc_value_ind *)param)->value.sensor_feat);
                     break;
-                }
 
                 case CSCPC_RD_SENSOR_LOC:
-                {
-                    uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 3, 0, 0, 0};
-                    pdu[1] =  EACI_MSG_DATA_IND_CSCPC_RD_SENSOR_LOC;
-                    pdu[3] = (uint8_t)(ATT_SVC_CYCLING_SPEED_CADENCE);
-                    pdu[4] = (uint8_t)(ATT_SVC_CYCLING_SPEED_CADENCE >> 8);
-                    pdu[5] = (uint8_t)(((struct cscpc_value_ind *)param)->value.sensor_loc);
-                    eaci_pdu_send(sizeof(pdu), pdu);
+                    app_eaci_data_ind_send(ATT_SVC_CYCLING_SPEED_CADENCE, EACI_MSG_DATA_IND_CSCPC_RD_SENSOR_LOC,
+                                           (uint8_t)(((struct cscpc_value_ind *)param)->value.sensor_loc));
                     break;
-                }
 
                 case CSCPC_RD_WR_CSC_MEAS_CFG:
-                {
-                    uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 4, 0, 0, 0, 0};
-                    pdu[1] =  EACI_MSG_DATA_IND_CSCPC_READ_MEAS_CFG;
-                    pdu[3] = (uint8_t)(ATT_SVC_CYCLING_SPEED_CADENCE);
-                    pdu[4] = (uint8_t)(ATT_SVC_CYCLING_SPEED_CADENCE >> 8);
-                    pdu[5] = (uint8_t)(((struct cscpc_value_ind *)param)->value.ntf_cfg);
-                    pdu[6] = (uint8_t)(((struct cscpc_value_ind *)param)->value.ntf_cfg >> 8);
-                    eaci_pdu_send(sizeof(pdu), pdu);
+                    app_eaci_data_ind_send(ATT_SVC_CYCLING_SPEED_CADENCE, EACI_MSG_DATA_IND_CSCPC_READ_MEAS_CFG,
+                                           ((struct cscpc_value_ind *)param)->value.ntf_cfg);
                     break;
-                }
 
                 case CSCPC_RD_WR_SC_CTNL_PT_CFG:
-                {
-                    uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 4, 0, 0, 0, 0};
-                    pdu[1] =  EACI_MSG_DATA_IND_CSCPC_READ_CTNL_PT_CFG;
-                    pdu[3] = (uint8_t)(ATT_SVC_CYCLING_SPEED_CADENCE);
-                    pdu[4] = (uint8_t)(ATT_SVC_CYCLING_SPEED_CADENCE >> 8);
-                    pdu[5] = (uint8_t)(((struct cscpc_value_ind *)param)->value.ntf_cfg);
-                    pdu[6] = (uint8_t)(((struct cscpc_value_ind *)param)->value.ntf_cfg >> 8);
-                    eaci_pdu_send(sizeof(pdu), pdu);
+                    app_eaci_data_ind_send(ATT_SVC_CYCLING_SPEED_CADENCE, EACI_MSG_DATA_IND_CSCPC_READ_CTNL_PT_CFG,
+                                           ((struct cscpc_value_ind *)param)->value.ntf_cfg);
                     break;
-                }
 
                 case CSCPC_IND_SC_CTNL_PT:
-                {
-                    uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 6, 0, 0, 0, 0, 0, 0};
-                    pdu[1] =  EACI_MSG_DATA_IND_CSCPC_SC_CTNL_PT;
-                    pdu[3] = (uint8_t)(ATT_SVC_CYCLING_SPEED_CADENCE);
-                    pdu[4] = (uint8_t)(ATT_SVC_CYCLING_SPEED_CADENCE >> 8);
-                    pdu[5] = ((struct cscpc_value_ind *)param)->value.ctnl_pt_rsp.req_op_code;
-                    pdu[6] = ((struct cscpc_value_ind *)param)->value.ctnl_pt_rsp.resp_value;
-                    pdu[7] = (uint8_t)(((struct cscpc_value_ind *)param)->value.ctnl_pt_rsp.supp_loc);
-                    pdu[8] = (uint8_t)(((struct cscpc_value_ind *)param)->value.ctnl_pt_rsp.supp_loc >> 8);
-                    eaci_pdu_send(sizeof(pdu), pdu);
+                    app_eaci_data_ind_send(ATT_SVC_CYCLING_SPEED_CADENCE, EACI_MSG_DATA_IND_CSCPC_SC_CTNL_PT,
+                                           ((struct cscpc_value_ind *)param)->value.ctnl_pt_rsp.req_op_code,
+                                           ((struct cscpc_value_ind *)param)->value.ctnl_pt_rsp.resp_value,
+                                           ((struct cscpc_value_ind *)param)->value.ctnl_pt_rsp.supp_loc);
                     break;
-                }
 
                 case CSCPC_NTF_CSC_MEAS:
                 {
@@ -363,15 +305,9 @@ void csc_app_task_msg_hdl(ke_msg_id_t const msgid, void const *param)
             switch(operation)
             {
                 case CSCPS_SEND_CSC_MEAS_OP_CODE:
-                {
-                    uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 3, 0, 0, 0};
-                    pdu[1] =  EACI_MSG_DATA_IND_CSCPS_MEAS;
-                    pdu[3] = (uint8_t)(ATT_SVC_CYCLING_SPEED_CADENCE);
-                    pdu[4] = (uint8_t)(ATT_SVC_CYCLING_SPEED_CADENCE >> 8);
-                    pdu[5] = ((struct cscps_cmp_evt *)param)->status;
-                    eaci_pdu_send(sizeof(pdu), pdu);
+                    app_eaci_data_ind_send(ATT_SVC_CYCLING_SPEED_CADENCE, EACI_MSG_DATA_IND_CSCPS_MEAS,
+                                           ((struct cscps_cmp_evt *)param)->status);
                     break;
-                }
 
                 default:
                     break;
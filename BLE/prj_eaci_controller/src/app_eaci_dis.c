@@ -189,14 +189,8 @@ void dis_app_task_msg_hdl(ke_msg_id_t const msgid, void const *param)
     {
 #if BLE_DIS_CLIENT
         case DISC_ENABLE_CFM:
-            {
-                uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 3, 0, 0, 0};
-                pdu[1] =  EACI_MSG_DATA_IND_DISC_ENABLE;
-                pdu[3] = (uint8_t)(ATT_SVC_DEVICE_INFO);
-                pdu[4] = (uint8_t)(ATT_SVC_DEVICE_INFO >> 8);
-                pdu[5] = ((struct disc_enable_cfm *)param)->status;
-                eaci_pdu_send(sizeof(pdu), pdu);
-            }
+            app_eaci_data_ind_send(ATT_SVC_DEVICE_INFO, EACI_MSG_DATA_IND_DISC_ENABLE,
+                                   ((struct disc_enable_cfm *)param)->status);
             break;
 
         case DISC_RD_CHAR_RSP:
@@ -93,27 +93,15 @@ void findme_app_task_msg_hdl(ke_msg_id_t const msgid, void const *param)
     {
 #if BLE_FINDME_LOCATOR
         case FINDL_ENABLE_CFM:
-        {
-            uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 3, 0, 0, 0};
-            pdu[1] =  EACI_MSG_DATA_IND_FM_ENABLE;
-            pdu[3] = (uint8_t)(ATT_SVC_IMMEDIATE_ALERT);
-            pdu[4] = (uint8_t)(ATT_SVC_IMMEDIATE_ALERT >> 8);
-            pdu[5] = ((struct findl_enable_cfm *)param)->status;
-            eaci_pdu_send(sizeof(pdu), pdu);
-        }
+            app_eaci_data_ind_send(ATT_SVC_IMMEDIATE_ALERT, EACI_MSG_DATA_IND_FM_ENABLE,
+                                   ((struct findl_enable_cfm *)param)->status);
             break;
 #endif
 
 #if BLE_FINDME_TARGET
         case FINDT_ALERT_IND:
-        {
-            uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 3, 0, 0, 0};
-            pdu[1] =  EACI_MSG_DATA_IND_ALERT_LEV;
-            pdu[3] = (uint8_t)(ATT_SVC_IMMEDIATE_ALERT);
-            pdu[4] = (uint8_t)(ATT_SVC_IMMEDIATE_ALERT >> 8);
-            pdu[5] = ((struct findt_alert_ind *)param)->alert_lvl;
-            eaci_pdu_send(sizeof(pdu), pdu);
-        }
+            app_eaci_data_ind_send(ATT_SVC_IMMEDIATE_ALERT, EACI_MSG_DATA_IND_ALERT_LEV,
+                                   ((struct findt_alert_ind *)param)->alert_lvl);
             break;
 #endif
         default:
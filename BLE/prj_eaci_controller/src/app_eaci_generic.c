@@ -30,6 +30,9 @@
 #include "app_eaci_generic.h"
 #include "sleep.h"
 #include "usr_design.h"
+#if (QN_TASK_PROF)
+#include "task_prof.h"
+#endif
 
 #if (defined(CFG_EACI))
 struct device_name_set device_name = {8, "NXP_EACI"};
@@ -47,6 +50,48 @@ struct device_name_set device_name = {8, "NXP_EACI"};
  ****************************************************************************************
  */
 
+/// EACI command handlers, indexed by command id
+static void (* const app_eaci_cmd_tab[EACI_MSG_CMD_MAX])(uint8_t param_len, uint8_t const *param) =
+{
+    NULL,                                   // EACI_MSG_CMD_RSV
+    app_eaci_cmd_adv_hdl,                   // EACI_MSG_CMD_ADV
+    app_eaci_cmd_scan_hdl,                  // EACI_MSG_CMD_SCAN
+    app_eaci_cmd_conn_hdl,                  // EACI_MSG_CMD_CONN
+    app_eaci_cmd_disc_hdl,                  // EACI_MSG_CMD_DISC
+    app_eaci_cmd_per_set_devname_hdl,       // EACI_MSG_CMD_SET_DEVNAME
+    app_eaci_cmd_bond_hdl,                  // EACI_MSG_CMD_BOND
+#if (BLE_CENTRAL)
+    app_eaci_cmd_cen_update_param_hdl,      // EACI_MSG_CMD_CEN_UPDATE_PARAM
+#else
+    NULL,
+#endif
+#if (BLE_PERIPHERAL)
+    app_eaci_cmd_per_update_param_hdl,      // EACI_MSG_CMD_PER_UPDATE_PARAM
+#else
+    NULL,
+#endif
+#if (QN_HEAP_STAT)
+    app_eaci_cmd_heap_stat_hdl,             // EACI_MSG_CMD_HEAP_STAT
+#else
+    NULL,
+#endif
+#if (QN_SLEEP_STAT)
+    app_eaci_cmd_sleep_stat_hdl,            // EACI_MSG_CMD_SLEEP_STAT
+#else
+    NULL,
+#endif
+#if (QN_TASK_PROF)
+    app_eaci_cmd_task_prof_hdl,             // EACI_MSG_CMD_TASK_PROF
+#else
+    NULL,
+#endif
+#if (QN_HEAP_TRACE)
+    app_eaci_cmd_heap_trace_hdl,            // EACI_MSG_CMD_HEAP_TRACE
+#else
+    NULL,
+#endif
+};
+
 /**
  ****************************************************************************************
  * @brief EACI command handler
@@ -55,42 +100,12 @@ struct device_name_set device_name = {8, "NXP_EACI"};
  */
 void app_eaci_cmd_hdl(uint8_t msg_id, uint8_t param_len, uint8_t const *param)
 {
-    switch (msg_id)
+    // Parameters are checked against the schema once, handlers can trust the length
+    if (msg_id < EACI_MSG_CMD_MAX
+        && app_eaci_cmd_tab[msg_id] != NULL
+        && eaci_layout_check(eaci_cmd_layout[msg_id], param_len))
     {
-        case EACI_MSG_CMD_ADV:
-            app_eaci_cmd_adv_hdl(param_len, param);
-            break;
-
-        case EACI_MSG_CMD_SCAN:
-            app_eaci_cmd_scan_hdl(param_len, param);
-            break;
-
-        case EACI_MSG_CMD_CONN:
-            app_eaci_cmd_conn_hdl(param_len, param);
-            break;
-
-        case EACI_MSG_CMD_DISC:
-            app_eaci_cmd_disc_hdl(param_len, param);
-            break;
-
-        case EACI_MSG_CMD_SET_DEVNAME:
-            app_eaci_cmd_per_set_devname_hdl(param_len, param);
-            break;
-
-        case EACI_MSG_CMD_BOND:
-            app_eaci_cmd_bond_hdl(param_len, param);
-            break;
-
-        case EACI_MSG_CMD_CEN_UPDATE_PARAM:
-            app_eaci_cmd_cen_update_param_hdl(param_len, param);
-            break;
-
-        case EACI_MSG_CMD_PER_UPDATE_PARAM:
-            app_eaci_cmd_per_update_param_hdl(param_len, param);
-            break;
-
-        default:
-            break;
+        app_eaci_cmd_tab[msg_id](param_len, param);
     }
 }
 
@@ -102,7 +117,11 @@ void app_eaci_cmd_hdl(uint8_t msg_id, uint8_t param_len, uint8_t const *param)
  */
 void app_eaci_cmd_adv_hdl(uint8_t param_len, uint8_t const *param)
 {
-    if (param[0] == 0x0)
+    uint8_t start;
+    uint16_t intv_min, intv_max;
+
+    eaci_unpack(param, param_len, eaci_cmd_layout[EACI_MSG_CMD_ADV], &start, &intv_min, &intv_max);
+    if (start == 0x0)
     {
         ///stop Advertising
         app_gap_adv_stop_req();
@@ -117,8 +136,8 @@ void app_eaci_cmd_adv_hdl(uint8_t param_len, uint8_t const *param)
         app_gap_adv_start_req(GAP_GEN_DISCOVERABLE|GAP_UND_CONNECTABLE, 
             app_env.adv_data, app_set_adv_data(GAP_GEN_DISCOVERABLE), 
             app_env.scanrsp_data, app_set_scan_rsp_data(app_get_local_service_flag()),
-            (param[2] << 8 | param[1]), (param[4] << 8 | param[3]));
-        
+            intv_min, intv_max);
+
 #if (QN_DEEP_SLEEP_EN)
         // prevent entering into deep sleep mode
         sleep_set_pm(PM_SLEEP);
@@ -154,22 +173,20 @@ void app_eaci_cmd_scan_hdl(uint8_t param_len, uint8_t const *param)
  */
 void app_eaci_cmd_conn_hdl(uint8_t param_len, uint8_t const *param)
 {
-    if (param_len == BD_ADDR_LEN + 7)
+    uint8_t addr_type;
+    uint16_t intv_min, intv_max, time_out;
+    struct bd_addr addr;
+
+    eaci_unpack(param, param_len, eaci_cmd_layout[EACI_MSG_CMD_CONN],
+                &addr_type, &intv_min, &intv_max, &time_out, &addr);
+    if (app_get_link_nb() != BLE_CONNECTION_MAX)
     {
-        struct bd_addr addr;
-        app_eaci_get_bd_addr_by_param(&addr, param+7);
-        if (app_get_link_nb() != BLE_CONNECTION_MAX)
-        {
-            app_gap_le_create_conn_req(&addr, param[0], QN_ADDR_TYPE,
-                                    param[2] << 8 | param[1],
-                                    param[4] << 8 | param[3],
-                                    param[6] << 8 | param[5]);
-        }
+        app_gap_le_create_conn_req(&addr, addr_type, QN_ADDR_TYPE, intv_min, intv_max, time_out);
+    }
 #if (QN_DEEP_SLEEP_EN)
-        // prevent entering into deep sleep mode
-        sleep_set_pm(PM_SLEEP);
+    // prevent entering into deep sleep mode
+    sleep_set_pm(PM_SLEEP);
 #endif
-    }
 }
 
 /**
@@ -180,15 +197,13 @@ void app_eaci_cmd_conn_hdl(uint8_t param_len, uint8_t const *param)
  */
 void app_eaci_cmd_disc_hdl(uint8_t param_len, uint8_t const *param)
 {
-    if (param_len == BD_ADDR_LEN)
-    {
-        uint8_t idx;
-        struct bd_addr addr;
-        app_eaci_get_bd_addr_by_param(&addr, param);
-        uint16_t conhdl = app_get_conhdl_by_bdaddr(&addr, &idx);
-        if (conhdl != 0xFFFF)
-            app_gap_discon_req(conhdl);
-    }
+    uint8_t idx;
+    struct bd_addr addr;
+
+    eaci_unpack(param, param_len, eaci_cmd_layout[EACI_MSG_CMD_DISC], &addr);
+    uint16_t conhdl = app_get_conhdl_by_bdaddr(&addr, &idx);
+    if (conhdl != 0xFFFF)
+        app_gap_discon_req(conhdl);
 }
 
 /**
@@ -199,6 +214,9 @@ void app_eaci_cmd_disc_hdl(uint8_t param_len, uint8_t const *param)
  */
 void app_eaci_cmd_per_set_devname_hdl(uint8_t param_len, uint8_t const *param)
 {
+    // Keep the name within the local record
+    if (param_len > sizeof(device_name.name))
+        param_len = sizeof(device_name.name);
     app_gap_set_devname_req(param, param_len);
     device_name.namelen = param_len;
     memcpy(device_name.name, param, param_len);
@@ -212,12 +230,10 @@ void app_eaci_cmd_per_set_devname_hdl(uint8_t param_len, uint8_t const *param)
  */
 void app_eaci_cmd_bond_hdl(uint8_t param_len, uint8_t const *param)
 {
-    if (param_len == BD_ADDR_LEN)
-    {
-        struct bd_addr addr;
-        app_eaci_get_bd_addr_by_param(&addr, param);
-        app_gap_security_req(&addr);
-    }
+    struct bd_addr addr;
+
+    eaci_unpack(param, param_len, eaci_cmd_layout[EACI_MSG_CMD_BOND], &addr);
+    app_gap_security_req(&addr);
 }
 
 /**
@@ -229,16 +245,16 @@ void app_eaci_cmd_bond_hdl(uint8_t param_len, uint8_t const *param)
 #if (BLE_CENTRAL)
 void app_eaci_cmd_cen_update_param_hdl(uint8_t param_len, uint8_t const *param)
 {
-    uint16_t conhdl;
-    app_eaci_get_conhdl_by_param(&conhdl, param + 10);
+    uint8_t idx;
+    uint16_t conhdl, result;
+    struct bd_addr addr;
+    struct gap_conn_param_update conn_par;
+
+    eaci_unpack(param, param_len, eaci_cmd_layout[EACI_MSG_CMD_CEN_UPDATE_PARAM], &result,
+                &conn_par.intv_min, &conn_par.intv_max, &conn_par.latency, &conn_par.time_out, &addr);
+    conhdl = app_get_conhdl_by_bdaddr(&addr, &idx);
     if (conhdl != 0xFFFF)
     {
-        uint16_t result = param[1] << 8 | param[0];
-        struct gap_conn_param_update conn_par;
-        conn_par.intv_min = param[3] << 8 | param[2];
-        conn_par.intv_max = param[5] << 8 | param[4];
-        conn_par.latency  = param[7] << 8 | param[6];
-        conn_par.time_out = param[9] << 8 | param[8];
         app_gap_change_param_req(conhdl, result, &conn_par);
     }
 }
@@ -254,14 +270,197 @@ void app_eaci_cmd_cen_update_param_hdl(uint8_t param_len, uint8_t const *param)
 void app_eaci_cmd_per_update_param_hdl(uint8_t param_len, uint8_t const *param)
 {
     struct gap_conn_param_update conn_par;
-    conn_par.intv_min = param[1] << 8 | param[0];
-    conn_par.intv_max = param[3] << 8 | param[2];
-    conn_par.latency  = param[5] << 8 | param[4];
-    conn_par.time_out = param[7] << 8 | param[6];
+
+    eaci_unpack(param, param_len, eaci_cmd_layout[EACI_MSG_CMD_PER_UPDATE_PARAM],
+                &conn_par.intv_min, &conn_par.intv_max, &conn_par.latency, &conn_par.time_out);
     app_gap_param_update_req(app_env.dev_rec[0].conhdl, &conn_par);
 }
 #endif
 
+#if (QN_HEAP_STAT)
+/**
+ ****************************************************************************************
+ * @brief EACI BLE Heap Statistics Command handler
+ *
+ ****************************************************************************************
+ */
+void app_eaci_cmd_heap_stat_hdl(uint8_t param_len, uint8_t const *param)
+{
+    struct app_heap_stat stat;
+    uint8_t pdu[EACI_PDU_HDR_LEN + 9];
+
+    app_heap_stat_get(&stat);
+    eaci_pdu_send(eaci_pack(pdu, EACI_MSG_TYPE_EVT, EACI_MSG_EVT_HEAP_STAT,
+                            eaci_evt_layout[EACI_MSG_EVT_HEAP_STAT],
+                            stat.size, stat.free, stat.largest, stat.peak, stat.frag), pdu);
+}
+#endif
+
+#if (QN_SLEEP_STAT)
+/**
+ ****************************************************************************************
+ * @brief Send one row of the Sleep Profile
+ *
+ ****************************************************************************************
+ */
+static void app_eaci_sleep_stat_row(uint8_t table, uint8_t idx, uint32_t count, uint32_t time)
+{
+    uint8_t pdu[EACI_PDU_HDR_LEN + 10];
+
+    eaci_pdu_send(eaci_pack(pdu, EACI_MSG_TYPE_EVT, EACI_MSG_EVT_SLEEP_STAT,
+                            eaci_evt_layout[EACI_MSG_EVT_SLEEP_STAT],
+                            (unsigned int)table, (unsigned int)idx, count, time), pdu);
+}
+
+/**
+ ****************************************************************************************
+ * @brief EACI Sleep Profile Command handler
+ *
+ * Every power mode is reported, blocking reasons and wakeup sources only when they
+ * occurred.
+ *
+ ****************************************************************************************
+ */
+void app_eaci_cmd_sleep_stat_hdl(uint8_t param_len, uint8_t const *param)
+{
+    struct sleep_stat stat;
+    uint8_t reset;
+    uint8_t i;
+
+    eaci_unpack(param, param_len, eaci_cmd_layout[EACI_MSG_CMD_SLEEP_STAT], &reset);
+    sleep_stat_get(&stat);
+    if (reset)
+        sleep_stat_reset();
+
+    for (i = PM_ACTIVE; i <= PM_DEEP_SLEEP; i++)
+        app_eaci_sleep_stat_row(EACI_SLEEP_STAT_PM, i, stat.pm[i].count, stat.pm[i].time);
+    for (i = 0; i < SLEEP_BLOCK_NUM; i++)
+    {
+        if (stat.block[i].count != 0)
+            app_eaci_sleep_stat_row(EACI_SLEEP_STAT_BLOCK, i, stat.block[i].count, stat.block[i].time);
+    }
+    for (i = 0; i < SLEEP_STAT_IRQ_NUM; i++)
+    {
+        if (stat.wakeup[i] != 0)
+            app_eaci_sleep_stat_row(EACI_SLEEP_STAT_WAKEUP, i, stat.wakeup[i], 0);
+    }
+    app_eaci_sleep_stat_row(EACI_SLEEP_STAT_DEV, 0, stat.dev_bf, 0);
+}
+#endif
+
+#if (QN_TASK_PROF)
+/**
+ ****************************************************************************************
+ * @brief Send one row of the Handler Profile
+ *
+ ****************************************************************************************
+ */
+static void app_eaci_task_prof_row(uint8_t table, uint8_t task, uint16_t id,
+                                   uint32_t count, uint32_t max, uint32_t total)
+{
+    uint8_t pdu[EACI_PDU_HDR_LEN + 16];
+
+    eaci_pdu_send(eaci_pack(pdu, EACI_MSG_TYPE_EVT, EACI_MSG_EVT_TASK_PROF,
+                            eaci_evt_layout[EACI_MSG_EVT_TASK_PROF],
+                            (unsigned int)table, (unsigned int)task, (unsigned int)id,
+                            count, max, total), pdu);
+}
+
+/**
+ ****************************************************************************************
+ * @brief EACI Handler Profile Command handler
+ *
+ * The rows are built before the profile is cleared, the event callbacks only when they
+ * were called.
+ *
+ ****************************************************************************************
+ */
+void app_eaci_cmd_task_prof_hdl(uint8_t param_len, uint8_t const *param)
+{
+    struct task_prof const *prof = task_prof_get();
+    uint8_t reset;
+    uint8_t i;
+
+    eaci_unpack(param, param_len, eaci_cmd_layout[EACI_MSG_CMD_TASK_PROF], &reset);
+
+    app_eaci_task_prof_row(EACI_TASK_PROF_SCHED, 0, 0,
+                           prof->sched.count, prof->sched.max, prof->sched.total);
+    for (i = 0; i < TASK_PROF_EVT_NB; i++)
+    {
+        if (prof->evt[i].count != 0)
+            app_eaci_task_prof_row(EACI_TASK_PROF_EVT, 0, i,
+                                   prof->evt[i].count, prof->evt[i].max, prof->evt[i].total);
+    }
+    for (i = 0; i < prof->msg_nb; i++)
+    {
+        app_eaci_task_prof_row(EACI_TASK_PROF_MSG, prof->msg[i].task, prof->msg[i].id,
+                               prof->msg[i].item.count, prof->msg[i].item.max, prof->msg[i].item.total);
+    }
+    if (prof->msg_lost != 0)
+        app_eaci_task_prof_row(EACI_TASK_PROF_MSG, TASK_PROF_TASK_NONE, 0, prof->msg_lost, 0, 0);
+    app_eaci_task_prof_row(EACI_TASK_PROF_QUEUE, 0, 0,
+                           prof->queue_sent.count, prof->queue_sent.max, prof->queue_sent.total);
+    app_eaci_task_prof_row(EACI_TASK_PROF_QUEUE, 0, 1,
+                           prof->queue_saved.count, prof->queue_saved.max, prof->queue_saved.total);
+
+    if (reset)
+        task_prof_reset();
+}
+#endif
+
+#if (QN_HEAP_TRACE)
+/**
+ ****************************************************************************************
+ * @brief Send one row of the Heap Trace
+ *
+ ****************************************************************************************
+ */
+static void app_eaci_heap_trace_row(uint8_t table, uint16_t id, uint16_t size,
+                                    uint32_t count, uint32_t total)
+{
+    uint8_t pdu[EACI_PDU_HDR_LEN + 13];
+
+    eaci_pdu_send(eaci_pack(pdu, EACI_MSG_TYPE_EVT, EACI_MSG_EVT_HEAP_TRACE,
+                            eaci_evt_layout[EACI_MSG_EVT_HEAP_TRACE],
+                            (unsigned int)table, (unsigned int)id, (unsigned int)size,
+                            count, total), pdu);
+}
+
+/**
+ ****************************************************************************************
+ * @brief EACI BLE Heap Trace Command handler
+ *
+ * The blocks are sent only while the application holds them, the ones with a high age
+ * are the leak suspects.
+ *
+ ****************************************************************************************
+ */
+void app_eaci_cmd_heap_trace_hdl(uint8_t param_len, uint8_t const *param)
+{
+    struct app_heap_trace const *trace = app_heap_trace_get();
+    uint8_t i;
+
+    app_eaci_heap_trace_row(EACI_HEAP_TRACE_APP, trace->live, trace->live_peak,
+                            trace->alloc_cnt, trace->free_cnt);
+    app_eaci_heap_trace_row(EACI_HEAP_TRACE_ADVICE, app_heap_size_advice(), trace->req_max,
+                            trace->fail_cnt,
+                            (*(volatile uint32_t *)QN_DBG_INFO_REG & QN_DBG_INFO_BLE_HEAP_FULL) ? 1 : 0);
+    for (i = 0; i < trace->hist_nb; i++)
+    {
+        app_eaci_heap_trace_row(EACI_HEAP_TRACE_MSG, trace->hist[i].id, trace->hist[i].max,
+                                trace->hist[i].count, trace->hist[i].bytes);
+    }
+    for (i = 0; i < APP_HEAP_BLK_NB; i++)
+    {
+        if (trace->blk[i].ptr != NULL)
+            app_eaci_heap_trace_row(EACI_HEAP_TRACE_BLK, trace->blk[i].id, trace->blk[i].size,
+                                    trace->blk[i].caller, trace->blk[i].age);
+    }
+    if ((trace->hist_lost != 0) || (trace->blk_lost != 0))
+        app_eaci_heap_trace_row(EACI_HEAP_TRACE_LOST, 0, 0, trace->hist_lost, trace->blk_lost);
+}
+#endif
+
 void gap_app_task_msg_hdl(ke_msg_id_t const msgid, void const *param)
 {
     switch(msgid)
@@ -92,6 +92,42 @@ void app_eaci_cmd_cen_update_param_hdl(uint8_t param_len, uint8_t const *param);
 void app_eaci_cmd_per_update_param_hdl(uint8_t param_len, uint8_t const *param);
 #endif
 
+/**
+ ****************************************************************************************
+ * @brief EACI BLE Heap Statistics Command handler
+ ****************************************************************************************
+ */
+#if (QN_HEAP_STAT)
+void app_eaci_cmd_heap_stat_hdl(uint8_t param_len, uint8_t const *param);
+#endif
+
+/**
+ ****************************************************************************************
+ * @brief EACI Sleep Profile Command handler
+ ****************************************************************************************
+ */
+#if (QN_SLEEP_STAT)
+void app_eaci_cmd_sleep_stat_hdl(uint8_t param_len, uint8_t const *param);
+#endif
+
+/**
+ ****************************************************************************************
+ * @brief EACI Handler Profile Command handler
+ ****************************************************************************************
+ */
+#if (QN_TASK_PROF)
+void app_eaci_cmd_task_prof_hdl(uint8_t param_len, uint8_t const *param);
+#endif
+
+/**
+ ****************************************************************************************
+ * @brief EACI BLE Heap Trace Command handler
+ ****************************************************************************************
+ */
+#if (QN_HEAP_TRACE)
+void app_eaci_cmd_heap_trace_hdl(uint8_t param_len, uint8_t const *param);
+#endif
+
 void gap_app_task_msg_hdl(ke_msg_id_t const msgid, void const *param);
 
 #endif // APP_EACI_GENERIC_ACI
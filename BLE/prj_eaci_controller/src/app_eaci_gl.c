@@ -355,38 +355,19 @@ void gl_app_task_msg_hdl(ke_msg_id_t const msgid, void const *param)
     {
 #if BLE_GL_COLLECTOR
         case GLPC_ENABLE_CFM:
-        {
-            uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 3, 0, 0, 0};
-            pdu[1] = EACI_MSG_DATA_IND_GL_ENABLE;
-            pdu[3] = (uint8_t)(ATT_SVC_GLUCOSE);
-            pdu[4] = (uint8_t)(ATT_SVC_GLUCOSE >> 8);
-            pdu[5] = ((struct glpc_enable_cfm *)param)->status;
-            eaci_pdu_send(sizeof(pdu), pdu);
-        }
+            app_eaci_data_ind_send(ATT_SVC_GLUCOSE, EACI_MSG_DATA_IND_GL_ENABLE,
+                                   ((struct glpc_enable_cfm *)param)->status);
             break;
 
         case GLPC_REGISTER_CFM:
-        {
-            uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 3, 0, 0, 0};
-            pdu[1] = EACI_MSG_DATA_IND_GL_REGISTER;
-            pdu[3] = (uint8_t)(ATT_SVC_GLUCOSE);
-            pdu[4] = (uint8_t)(ATT_SVC_GLUCOSE >> 8);
-            pdu[5] = ((struct glpc_register_cfm *)param)->status;
-            eaci_pdu_send(sizeof(pdu), pdu);
-        }
+            app_eaci_data_ind_send(ATT_SVC_GLUCOSE, EACI_MSG_DATA_IND_GL_REGISTER,
+                                   ((struct glpc_register_cfm *)param)->status);
             break;
 
         case GLPC_READ_FEATURES_RSP:
-        {
-            uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 5, 0, 0, 0, 0, 0};
-            pdu[1] = EACI_MSG_DATA_IND_GL_FEATURES_RD;
-            pdu[3] = (uint8_t)(ATT_SVC_GLUCOSE);
-            pdu[4] = (uint8_t)(ATT_SVC_GLUCOSE >> 8);
-            pdu[5] = ((struct glpc_read_features_rsp *)param)->status;
-            pdu[6] = (uint8_t)(((struct glpc_read_features_rsp *)param)->features);
-            pdu[7] = (uint8_t)((((struct glpc_read_features_rsp *)param)->features) >> 8);
-            eaci_pdu_send(sizeof(pdu), pdu);
-        }
+            app_eaci_data_ind_send(ATT_SVC_GLUCOSE, EACI_MSG_DATA_IND_GL_FEATURES_RD,
+                                   ((struct glpc_read_features_rsp *)param)->status,
+                                   ((struct glpc_read_features_rsp *)param)->features);
             break;
 
         case GLPC_MEAS_IND:
@@ -616,14 +597,8 @@ void gl_app_task_msg_hdl(ke_msg_id_t const msgid, void const *param)
 
 #if BLE_GL_SENSOR
         case GLPS_CFG_INDNTF_IND:
-        {
-            uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 3, 0, 0, 0};
-            pdu[1] = EACI_MSG_DATA_IND_GLS_CFG;
-            pdu[3] = (uint8_t)(ATT_SVC_GLUCOSE);
-            pdu[4] = (uint8_t)(ATT_SVC_GLUCOSE >> 8);
-            pdu[5] = (uint8_t)(((struct glps_cfg_indntf_ind *)param)->evt_cfg);
-            eaci_pdu_send(sizeof(pdu), pdu);
-        }
+            app_eaci_data_ind_send(ATT_SVC_GLUCOSE, EACI_MSG_DATA_IND_GLS_CFG,
+                                   (uint8_t)(((struct glps_cfg_indntf_ind *)param)->evt_cfg));
             break;
         
         case GLPS_RACP_REQ_IND:
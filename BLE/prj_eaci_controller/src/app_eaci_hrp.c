@@ -140,62 +140,33 @@ void hr_app_task_msg_hdl(ke_msg_id_t const msgid, void const *param)
     {
 #if BLE_HR_COLLECTOR
         case HRPC_ENABLE_CFM:
-        {
             // Enable confirmation
-            uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, EACI_MSG_DATA_IND_HRPC_ENABLE, 3, 0x0D, 0x18, 0};
-            pdu[5] = ((struct hrpc_enable_cfm *)param)->status;
-            eaci_pdu_send(sizeof(pdu), pdu);
-        }
+            app_eaci_data_ind_send(ATT_SVC_HEART_RATE, EACI_MSG_DATA_IND_HRPC_ENABLE,
+                                   ((struct hrpc_enable_cfm *)param)->status);
             break;
 
         case HRPC_RD_CHAR_RSP:
-        {
-            uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 4, 0, 0, 0, 0};
-            pdu[1] =  EACI_MSG_DATA_IND_HRPC_READ_BSL_RSP;
-            pdu[3] = (uint8_t)(ATT_SVC_HEART_RATE & 0x00FF);
-            pdu[4] = (uint8_t)(ATT_SVC_HEART_RATE >> 8);
-            pdu[5] = ((struct hrpc_rd_char_rsp *)param)->status;
-            pdu[6] = ((struct hrpc_rd_char_rsp *)param)->data.data[0];
-            eaci_pdu_send(sizeof(pdu), pdu);
-        }
+            app_eaci_data_ind_send(ATT_SVC_HEART_RATE, EACI_MSG_DATA_IND_HRPC_READ_BSL_RSP,
+                                   ((struct hrpc_rd_char_rsp *)param)->status,
+                                   ((struct hrpc_rd_char_rsp *)param)->data.data[0]);
             break;
 
         case HRPC_WR_CHAR_RSP:
-        {
-            uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 3, 0, 0, 0};
-            pdu[1] =  EACI_MSG_DATA_IND_HRPC_WR_RSP;
-            pdu[3] = (uint8_t)(ATT_SVC_HEART_RATE & 0x00FF);
-            pdu[4] = (uint8_t)(ATT_SVC_HEART_RATE >> 8);
-            pdu[5] = ((struct hrpc_wr_char_rsp *)param)->status;
-            eaci_pdu_send(sizeof(pdu), pdu);
-        }
+            app_eaci_data_ind_send(ATT_SVC_HEART_RATE, EACI_MSG_DATA_IND_HRPC_WR_RSP,
+                                   ((struct hrpc_wr_char_rsp *)param)->status);
             break;
 
         case HRPC_HR_MEAS_IND:
-        {
-            uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 4, 0, 0, 0, 0};
-            pdu[1] =  EACI_MSG_DATA_IND_HRPC_MEAS;
-            pdu[3] = (uint8_t)(ATT_SVC_HEART_RATE & 0x00FF);
-            pdu[4] = (uint8_t)(ATT_SVC_HEART_RATE >> 8);
-            pdu[5] = ((((struct hrpc_meas_ind *)param)->meas_val.heart_rate) & 0x00FF);
-            pdu[6] = ((((struct hrpc_meas_ind *)param)->meas_val.heart_rate) >> 8);
-            eaci_pdu_send(sizeof(pdu), pdu);
-        }
+            app_eaci_data_ind_send(ATT_SVC_HEART_RATE, EACI_MSG_DATA_IND_HRPC_MEAS,
+                                   ((struct hrpc_meas_ind *)param)->meas_val.heart_rate);
             break;
 #endif
 
 #if BLE_HR_SENSOR
         // No data indication necessary here
         case HRPS_CFG_INDNTF_IND:
-        {
-            uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 4, 0, 0, 0, 0};
-            pdu[1] =  EACI_MSG_DATA_IND_HRPS_CFG;
-            pdu[3] = (uint8_t)(ATT_SVC_HEART_RATE & 0x00FF);
-            pdu[4] = (uint8_t)(ATT_SVC_HEART_RATE >> 8);
-            pdu[5] = ((((struct hrps_cfg_indntf_ind *)param)->cfg_val) & 0x00FF);
-            pdu[6] = ((((struct hrps_cfg_indntf_ind *)param)->cfg_val) >> 8);
-            eaci_pdu_send(sizeof(pdu), pdu);
-        }
+            app_eaci_data_ind_send(ATT_SVC_HEART_RATE, EACI_MSG_DATA_IND_HRPS_CFG,
+                                   ((struct hrps_cfg_indntf_ind *)param)->cfg_val);
             break;
 #endif
         default:
@@ -165,12 +165,9 @@ void ht_app_task_msg_hdl(ke_msg_id_t const msgid, void const *param)
     {
 #if BLE_HT_COLLECTOR
         case HTPC_ENABLE_CFM:
-        {
             // Enable confirmation
-            uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, EACI_MSG_DATA_IND_HT_ENABLE, 3, 0x09, 0x18, 0};
-            pdu[5] = ((struct htpc_enable_cfm *)param)->status;
-            eaci_pdu_send(sizeof(pdu), pdu);
-        }
+            app_eaci_data_ind_send(ATT_SVC_HEALTH_THERMOM, EACI_MSG_DATA_IND_HT_ENABLE,
+                                   ((struct htpc_enable_cfm *)param)->status);
             break;
 
         case HTPC_RD_CHAR_RSP:
@@ -189,58 +186,33 @@ void ht_app_task_msg_hdl(ke_msg_id_t const msgid, void const *param)
             break;
 
         case HTPC_WR_CHAR_RSP:
-        {
             // Write Status
-            uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, EACI_MSG_DATA_IND_HT_WR_RSP, 3, 0x09, 0x18, 0};
-            pdu[5] = ((struct htpc_wr_char_rsp *)param)->status;
-            eaci_pdu_send(sizeof(pdu), pdu);
-        }
+            app_eaci_data_ind_send(ATT_SVC_HEALTH_THERMOM, EACI_MSG_DATA_IND_HT_WR_RSP,
+                                   ((struct htpc_wr_char_rsp *)param)->status);
             break;
 
         case HTPC_TEMP_IND:
-        {
-            uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 0x08, 0x09, 0x18, 0, 0, 0, 0, 0, 0};
-            pdu[1] =  EACI_MSG_DATA_IND_HT_TEM_MEA;
-            pdu[5] = ((struct htpc_temp_ind *)param)->flag_stable_meas;
-            pdu[6] = (((struct htpc_temp_ind *)param)->temp_meas.flags) & 0x01;
-            pdu[7] = (uint8_t)((((struct htpc_temp_ind *)param)->temp_meas.temp));
-            pdu[8] = (uint8_t)((((struct htpc_temp_ind *)param)->temp_meas.temp) >> 8);
-            pdu[9] = (uint8_t)((((struct htpc_temp_ind *)param)->temp_meas.temp) >> 16);
-            pdu[10] = (uint8_t)((((struct htpc_temp_ind *)param)->temp_meas.temp) >> 24);
-            eaci_pdu_send(sizeof(pdu), pdu);
-        }
+            app_eaci_data_ind_send(ATT_SVC_HEALTH_THERMOM, EACI_MSG_DATA_IND_HT_TEM_MEA,
+                                   ((struct htpc_temp_ind *)param)->flag_stable_meas,
+                                   (((struct htpc_temp_ind *)param)->temp_meas.flags) & 0x01,
+                                   ((struct htpc_temp_ind *)param)->temp_meas.temp);
             break;
 
         case HTPC_MEAS_INTV_IND:
-        {
-            uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 4, 0x09, 0x18, 0, 0};
-            pdu[1] =  EACI_MSG_DATA_IND_HT_MEAS_INTE;
-            pdu[5] = (uint8_t)(((struct htpc_meas_intv_ind *)param)->intv);
-            pdu[6] = (uint8_t)((((struct htpc_meas_intv_ind *)param)->intv) >> 8);
-            eaci_pdu_send(sizeof(pdu), pdu);
-        }
+            app_eaci_data_ind_send(ATT_SVC_HEALTH_THERMOM, EACI_MSG_DATA_IND_HT_MEAS_INTE,
+                                   ((struct htpc_meas_intv_ind *)param)->intv);
             break;
 #endif
 
 #if BLE_HT_THERMOM
         case HTPT_MEAS_INTV_CHG_IND:
-        {
-            uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 4, 0x09, 0x18, 0, 0};
-            pdu[1] =  EACI_MSG_DATA_IND_HT_TH_TEM_MEA;
-            pdu[5] = (uint8_t)(((struct htpt_meas_intv_chg_ind *)param)->intv);
-            pdu[6] = (uint8_t)((((struct htpt_meas_intv_chg_ind *)param)->intv) >> 8);
-            eaci_pdu_send(sizeof(pdu), pdu);
-        }
+            app_eaci_data_ind_send(ATT_SVC_HEALTH_THERMOM, EACI_MSG_DATA_IND_HT_TH_TEM_MEA,
+                                   ((struct htpt_meas_intv_chg_ind *)param)->intv);
             break;
 
         case HTPT_CFG_INDNTF_IND:
-        {
-            uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 4, 0x09, 0x18, 0, 0};
-            pdu[1] =  EACI_MSG_DATA_IND_HT_TH_CFG_IND;
-            pdu[5] = (uint8_t)(((struct htpt_cfg_indntf_ind *)param)->cfg_val);
-            pdu[6] = (uint8_t)((((struct htpt_cfg_indntf_ind *)param)->cfg_val) >> 8);
-            eaci_pdu_send(sizeof(pdu), pdu);
-        }
+            app_eaci_data_ind_send(ATT_SVC_HEALTH_THERMOM, EACI_MSG_DATA_IND_HT_TH_CFG_IND,
+                                   ((struct htpt_cfg_indntf_ind *)param)->cfg_val);
             break;
 #endif
         default:
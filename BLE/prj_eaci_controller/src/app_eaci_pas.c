@@ -167,37 +167,19 @@ void pas_app_task_msg_hdl(ke_msg_id_t const msgid, void const *param)
             switch (operation)
             {
                 case PASPC_ENABLE_OP_CODE:
-                {
-                    uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 3, 0, 0, 0};
-                    pdu[1] =  EACI_MSG_DATA_IND_PASPC_ENABLE;
-                    pdu[3] = (uint8_t)(ATT_SVC_PHONE_ALERT_STATUS);
-                    pdu[4] = (uint8_t)(ATT_SVC_PHONE_ALERT_STATUS >> 8);
-                    pdu[5] = ((struct paspc_cmp_evt *)param)->status;
-                    eaci_pdu_send(sizeof(pdu), pdu);
+                    app_eaci_data_ind_send(ATT_SVC_PHONE_ALERT_STATUS, EACI_MSG_DATA_IND_PASPC_ENABLE,
+                                           ((struct paspc_cmp_evt *)param)->status);
                     break;
-                }
 
                 case PASPC_READ_OP_CODE:
-                {
-                    uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 3, 0, 0, 0};
-                    pdu[1] =  EACI_MSG_DATA_IND_PASPC_READ;
-                    pdu[3] = (uint8_t)(ATT_SVC_PHONE_ALERT_STATUS);
-                    pdu[4] = (uint8_t)(ATT_SVC_PHONE_ALERT_STATUS >> 8);
-                    pdu[5] = ((struct paspc_cmp_evt *)param)->status;
-                    eaci_pdu_send(sizeof(pdu), pdu);
+                    app_eaci_data_ind_send(ATT_SVC_PHONE_ALERT_STATUS, EACI_MSG_DATA_IND_PASPC_READ,
+                                           ((struct paspc_cmp_evt *)param)->status);
                     break;
-                }
 
                 case PASPC_WRITE_OP_CODE:
-                {
-                    uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 3, 0, 0, 0};
-                    pdu[1] =  EACI_MSG_DATA_IND_PASPC_WRITE;
-                    pdu[3] = (uint8_t)(ATT_SVC_PHONE_ALERT_STATUS);
-                    pdu[4] = (uint8_t)(ATT_SVC_PHONE_ALERT_STATUS >> 8);
-                    pdu[5] = ((struct paspc_cmp_evt *)param)->status;
-                    eaci_pdu_send(sizeof(pdu), pdu);
+                    app_eaci_data_ind_send(ATT_SVC_PHONE_ALERT_STATUS, EACI_MSG_DATA_IND_PASPC_WRITE,
+                                           ((struct paspc_cmp_evt *)param)->status);
                     break;
-                }
 
                 default:
                     break;
@@ -211,51 +193,24 @@ void pas_app_task_msg_hdl(ke_msg_id_t const msgid, void const *param)
             switch (att_code)
             {
                 case PASPC_RD_ALERT_STATUS:
-                {
-                    uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 3, 0, 0, 0};
-                    pdu[1] =  EACI_MSG_DATA_IND_PASPC_ALERT_STATUS;
-                    pdu[3] = (uint8_t)(ATT_SVC_PHONE_ALERT_STATUS);
-                    pdu[4] = (uint8_t)(ATT_SVC_PHONE_ALERT_STATUS >> 8);
-                    pdu[5] = ((struct paspc_value_ind *)param)->value.alert_status;
-                    eaci_pdu_send(sizeof(pdu), pdu);
+                    app_eaci_data_ind_send(ATT_SVC_PHONE_ALERT_STATUS, EACI_MSG_DATA_IND_PASPC_ALERT_STATUS,
+                                           ((struct paspc_value_ind *)param)->value.alert_status);
                     break;
-                }
 
                 case PASPC_RD_RINGER_SETTING:
-                {
-                    uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 4, 0, 0, 0, 0};
-                    pdu[1] =  EACI_MSG_DATA_IND_PASPC_RINGER_SETTING;
-                    pdu[3] = (uint8_t)(ATT_SVC_PHONE_ALERT_STATUS);
-                    pdu[4] = (uint8_t)(ATT_SVC_PHONE_ALERT_STATUS >> 8);
-                    pdu[5] = (uint8_t)(((struct paspc_value_ind *)param)->value.ringer_setting);
-                    pdu[6] = (uint8_t)(((struct paspc_value_ind *)param)->value.ringer_setting >> 8);
-                    eaci_pdu_send(sizeof(pdu), pdu);
+                    app_eaci_data_ind_send(ATT_SVC_PHONE_ALERT_STATUS, EACI_MSG_DATA_IND_PASPC_RINGER_SETTING,
+                                           ((struct paspc_value_ind *)param)->value.ringer_setting);
                     break;
-                }
 
                 case PASPC_RD_WR_ALERT_STATUS_CFG:
-                {
-                    uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 4, 0, 0, 0, 0};
-                    pdu[1] =  EACI_MSG_DATA_IND_PASPC_ALERT_STATUS_CFG;
-                    pdu[3] = (uint8_t)(ATT_SVC_PHONE_ALERT_STATUS);
-                    pdu[4] = (uint8_t)(ATT_SVC_PHONE_ALERT_STATUS >> 8);
-                    pdu[5] = (uint8_t)(((struct paspc_value_ind *)param)->value.alert_status_ntf_cfg);
-                    pdu[6] = (uint8_t)(((struct paspc_value_ind *)param)->value.alert_status_ntf_cfg >> 8);
-                    eaci_pdu_send(sizeof(pdu), pdu);
+                    app_eaci_data_ind_send(ATT_SVC_PHONE_ALERT_STATUS, EACI_MSG_DATA_IND_PASPC_ALERT_STATUS_CFG,
+                                           ((struct paspc_value_ind *)param)->value.alert_status_ntf_cfg);
                     break;
-                }
 
                 case PASPC_RD_WR_RINGER_SETTING_CFG:
-                {
-                    uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 4, 0, 0, 0, 0};
-                    pdu[1] =  EACI_MSG_DATA_IND_PASPC_RINGER_SETTING_CFG;
-                    pdu[3] = (uint8_t)(ATT_SVC_PHONE_ALERT_STATUS);
-                    pdu[4] = (uint8_t)(ATT_SVC_PHONE_ALERT_STATUS >> 8);
-                    pdu[5] = (uint8_t)(((struct paspc_value_ind *)param)->value.ringer_setting_ntf_cfg);
-                    pdu[6] = (uint8_t)(((struct paspc_value_ind *)param)->value.ringer_setting_ntf_cfg >> 8);
-                    eaci_pdu_send(sizeof(pdu), pdu);
+                    app_eaci_data_ind_send(ATT_SVC_PHONE_ALERT_STATUS, EACI_MSG_DATA_IND_PASPC_RINGER_SETTING_CFG,
+                                           ((struct paspc_value_ind *)param)->value.ringer_setting_ntf_cfg);
                     break;
-                }
 
                 default:
                     break;
@@ -271,26 +226,14 @@ void pas_app_task_msg_hdl(ke_msg_id_t const msgid, void const *param)
             switch (operation)
             {
                 case PASPS_UPD_ALERT_STATUS_OP_CODE:
-                {
-                    uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 3, 0, 0, 0};
-                    pdu[1] =  EACI_MSG_DATA_IND_PASPC_UPD_ALERT_STATUS;
-                    pdu[3] = (uint8_t)(ATT_SVC_PHONE_ALERT_STATUS);
-                    pdu[4] = (uint8_t)(ATT_SVC_PHONE_ALERT_STATUS >> 8);
-                    pdu[5] = ((struct pasps_cmp_evt *)param)->status;
-                    eaci_pdu_send(sizeof(pdu), pdu);
+                    app_eaci_data_ind_send(ATT_SVC_PHONE_ALERT_STATUS, EACI_MSG_DATA_IND_PASPC_UPD_ALERT_STATUS,
+                                           ((struct pasps_cmp_evt *)param)->status);
                     break;
-                }
 
                 case PASPS_UPD_RINGER_SETTING_OP_CODE:
-                {
-                    uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 3, 0, 0, 0};
-                    pdu[1] =  EACI_MSG_DATA_IND_PASPC_UPD_RINGER_SETTING;
-                    pdu[3] = (uint8_t)(ATT_SVC_PHONE_ALERT_STATUS);
-                    pdu[4] = (uint8_t)(ATT_SVC_PHONE_ALERT_STATUS >> 8);
-                    pdu[5] = ((struct pasps_cmp_evt *)param)->status;
-                    eaci_pdu_send(sizeof(pdu), pdu);
+                    app_eaci_data_ind_send(ATT_SVC_PHONE_ALERT_STATUS, EACI_MSG_DATA_IND_PASPC_UPD_RINGER_SETTING,
+                                           ((struct pasps_cmp_evt *)param)->status);
                     break;
-                }
             }
             break;
         }
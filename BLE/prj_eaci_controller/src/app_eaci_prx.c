@@ -111,46 +111,27 @@ void prox_app_task_msg_hdl(ke_msg_id_t const msgid, void const *param)
     {
 #if BLE_PROX_MONITOR
         case PROXM_ENABLE_CFM:
-        {
             // Enable confirmation
-            uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, EACI_MSG_DATA_IND_PROXM_ENABLE, 3, 0x03, 0x18, 0};
-            pdu[5] = ((struct proxm_enable_cfm *)param)->status;
-            eaci_pdu_send(sizeof(pdu), pdu);
-        }
+            app_eaci_data_ind_send(ATT_SVC_LINK_LOSS, EACI_MSG_DATA_IND_PROXM_ENABLE,
+                                   ((struct proxm_enable_cfm *)param)->status);
             break;
 
         case PROXM_RD_CHAR_RSP:
-        {
             /// read data rsp
-            uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 3, 0x04, 0x18, 0};
-            pdu[1] =  EACI_MSG_DATA_IND_PROXM_TX_POWER;
-            pdu[5] = ((struct proxm_rd_char_rsp *)param)->val;
-            eaci_pdu_send(sizeof(pdu), pdu);
-        }
+            app_eaci_data_ind_send(ATT_SVC_TX_POWER, EACI_MSG_DATA_IND_PROXM_TX_POWER,
+                                   ((struct proxm_rd_char_rsp *)param)->val);
             break;
 #endif
 
 #if BLE_PROX_REPORTER
         case PROXR_ALERT_IND:
-        {
-            // Alert Indication
-            uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 3, 0, 0, 0};
+            // Alert Indication, with the Alert Level
             if (((struct proxr_alert_ind *)param)->char_code == PROXR_IAS_CHAR)
-            {
-                pdu[1] =  EACI_MSG_DATA_IND_PROXR_ALERT;
-                pdu[3] = (uint8_t)(ATT_SVC_TX_POWER & 0x00FF);
-                pdu[4] = (uint8_t)(ATT_SVC_TX_POWER >> 8);
-            }
+                app_eaci_data_ind_send(ATT_SVC_TX_POWER, EACI_MSG_DATA_IND_PROXR_ALERT,
+                                       ((struct proxr_alert_ind *)param)->alert_lvl);
             else
-            {
-                pdu[1] =  EACI_MSG_DATA_IND_PROXR_LINK_LOST;
-                pdu[3] = (uint8_t)(ATT_SVC_LINK_LOSS & 0x00FF);
-                pdu[4] = (uint8_t)(ATT_SVC_LINK_LOSS >> 8);
-            }
-            // Alter Level
-            pdu[5] = ((struct proxr_alert_ind *)param)->alert_lvl;
-            eaci_pdu_send(sizeof(pdu), pdu);
-        }
+                app_eaci_data_ind_send(ATT_SVC_LINK_LOSS, EACI_MSG_DATA_IND_PROXR_LINK_LOST,
+                                       ((struct proxr_alert_ind *)param)->alert_lvl);
             break;
 #endif
         default:
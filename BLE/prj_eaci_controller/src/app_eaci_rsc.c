@@ -206,59 +206,29 @@ void rsc_app_task_msg_hdl(ke_msg_id_t const msgid, void const *param)
             switch (operation)
             {
                 case RSCPC_ENABLE_OP_CODE:
-                {
-                    uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 3, 0, 0, 0};
-                    pdu[1] =  EACI_MSG_DATA_IND_RSCPC_ENABLE;
-                    pdu[3] = (uint8_t)(ATT_SVC_RUNNING_SPEED_CADENCE);
-                    pdu[4] = (uint8_t)(ATT_SVC_RUNNING_SPEED_CADENCE >> 8);
-                    pdu[5] = ((struct rscpc_cmp_evt *)param)->status;
-                    eaci_pdu_send(sizeof(pdu), pdu);
+                    app_eaci_data_ind_send(ATT_SVC_RUNNING_SPEED_CADENCE, EACI_MSG_DATA_IND_RSCPC_ENABLE,
+                                           ((struct rscpc_cmp_evt *)param)->status);
                     break;
-                }
 
                 case RSCPC_READ_OP_CODE:
-                {
-                    uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 3, 0, 0, 0};
-                    pdu[1] =  EACI_MSG_DATA_IND_RSCPC_READ;
-                    pdu[3] = (uint8_t)(ATT_SVC_RUNNING_SPEED_CADENCE);
-                    pdu[4] = (uint8_t)(ATT_SVC_RUNNING_SPEED_CADENCE >> 8);
-                    pdu[5] = ((struct rscpc_cmp_evt *)param)->status;
-                    eaci_pdu_send(sizeof(pdu), pdu);
+                    app_eaci_data_ind_send(ATT_SVC_RUNNING_SPEED_CADENCE, EACI_MSG_DATA_IND_RSCPC_READ,
+                                           ((struct rscpc_cmp_evt *)param)->status);
                     break;
-                }
 
                 case RSCPC_CFG_NTF_IND_OP_CODE:
-                {
-                    uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 3, 0, 0, 0};
-                    pdu[1] =  EACI_MSG_DATA_IND_RSCPC_CFG_NTF_IND;
-                    pdu[3] = (uint8_t)(ATT_SVC_RUNNING_SPEED_CADENCE);
-                    pdu[4] = (uint8_t)(ATT_SVC_RUNNING_SPEED_CADENCE >> 8);
-                    pdu[5] = ((struct rscpc_cmp_evt *)param)->status;
-                    eaci_pdu_send(sizeof(pdu), pdu);
+                    app_eaci_data_ind_send(ATT_SVC_RUNNING_SPEED_CADENCE, EACI_MSG_DATA_IND_RSCPC_CFG_NTF_IND,
+                                           ((struct rscpc_cmp_evt *)param)->status);
                     break;
-                }
 
                 case RSCPC_CTNL_PT_CFG_WR_OP_CODE:
-                {
-                    uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 3, 0, 0, 0};
-                    pdu[1] =  EACI_MSG_DATA_IND_RSCPC_CTNL_PT_CFG_WR;
-                    pdu[3] = (uint8_t)(ATT_SVC_RUNNING_SPEED_CADENCE);
-                    pdu[4] = (uint8_t)(ATT_SVC_RUNNING_SPEED_CADENCE >> 8);
-                    pdu[5] = ((struct rscpc_cmp_evt *)param)->status;
-                    eaci_pdu_send(sizeof(pdu), pdu);
+                    app_eaci_data_ind_send(ATT_SVC_RUNNING_SPEED_CADENCE, EACI_MSG_DATA_IND_RSCPC_CTNL_PT_CFG_WR,
+                                           ((struct rscpc_cmp_evt *)param)->status);
                     break;
-                }
 
                 case RSCPC_CTNL_PT_CFG_IND_OP_CODE:
-                {
-                    uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 3, 0, 0, 0};
-                    pdu[1] =  EACI_MSG_DATA_IND_RSCPC_CTNL_PT_CFG_IND;
-                    pdu[3] = (uint8_t)(ATT_SVC_RUNNING_SPEED_CADENCE);
-                    pdu[4] = (uint8_t)(ATT_SVC_RUNNING_SPEED_CADENCE >> 8);
-                    pdu[5] = ((struct rscpc_cmp_evt *)param)->status;
-                    eaci_pdu_send(sizeof(pdu), pdu);
+                    app_eaci_data_ind_send(ATT_SVC_RUNNING_SPEED_CADENCE, EACI_MSG_DATA_IND_RSCPC_CTNL_PT_CFG_IND,
+                                           ((struct rscpc_cmp_evt *)param)->status);
                     break;
-                }
 
                 default:
                     break;
@@ -292,61 +262,27 @@ void rsc_app_task_msg_hdl(ke_msg_id_t const msgid, void const *param)
                     break;
                 }
                 case RSCPC_RD_RSC_FEAT:
-                {
-                    uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 4, 0, 0, 0, 0};
-                    pdu[1] =  EACI_MSG_DATA_IND_RSCPC_RSC_FEAT;
-                    pdu[3] = (uint8_t)(ATT_SVC_RUNNING_SPEED_CADENCE);
-                    pdu[4] = (uint8_t)(ATT_SVC_RUNNING_SPEED_CADENCE >> 8);
-                    pdu[5] = (uint8_t)(((struct rscpc_value_ind *)param)->value.sensor_feat);
-                    pdu[6] = (uint8_t)(((struct rscpc_value_ind *)param)->value.sensor_feat >> 8);
-                    eaci_pdu_send(sizeof(pdu), pdu);
+                    app_eaci_data_ind_send(ATT_SVC_RUNNING_SPEED_CADENCE, EACI_MSG_DATA_IND_RSCPC_RSC_FEAT,
+                                           ((struct rscpc_value_ind *)param)->value.sensor_feat);
                     break;
-                }
                 case RSCPC_RD_SENSOR_LOC:
-                {
-                    uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 3, 0, 0, 0};
-                    pdu[1] =  EACI_MSG_DATA_IND_RSCPC_SENSOR_LOC;
-                    pdu[3] = (uint8_t)(ATT_SVC_RUNNING_SPEED_CADENCE);
-                    pdu[4] = (uint8_t)(ATT_SVC_RUNNING_SPEED_CADENCE >> 8);
-                    pdu[5] = ((struct rscpc_value_ind *)param)->value.sensor_loc;
-                    eaci_pdu_send(sizeof(pdu), pdu);
+                    app_eaci_data_ind_send(ATT_SVC_RUNNING_SPEED_CADENCE, EACI_MSG_DATA_IND_RSCPC_SENSOR_LOC,
+                                           ((struct rscpc_value_ind *)param)->value.sensor_loc);
                     break;
-                }
                 case RSCPC_IND_SC_CTNL_PT:
-                {
-                    uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 6, 0, 0, 0, 0, 0, 0};
-                    pdu[1] =  EACI_MSG_DATA_IND_RSCPC_CTNL_PT;
-                    pdu[3] = (uint8_t)(ATT_SVC_RUNNING_SPEED_CADENCE);
-                    pdu[4] = (uint8_t)(ATT_SVC_RUNNING_SPEED_CADENCE >> 8);
-                    pdu[5] = ((struct rscpc_value_ind *)param)->value.ctnl_pt_rsp.req_op_code;
-                    pdu[6] = ((struct rscpc_value_ind *)param)->value.ctnl_pt_rsp.resp_value;
-                    pdu[7] = (uint8_t)(((struct rscpc_value_ind *)param)->value.ctnl_pt_rsp.supp_loc);
-                    pdu[8] = (uint8_t)(((struct rscpc_value_ind *)param)->value.ctnl_pt_rsp.supp_loc >> 8);
-                    eaci_pdu_send(sizeof(pdu), pdu);
+                    app_eaci_data_ind_send(ATT_SVC_RUNNING_SPEED_CADENCE, EACI_MSG_DATA_IND_RSCPC_CTNL_PT,
+                                           ((struct rscpc_value_ind *)param)->value.ctnl_pt_rsp.req_op_code,
+                                           ((struct rscpc_value_ind *)param)->value.ctnl_pt_rsp.resp_value,
+                                           ((struct rscpc_value_ind *)param)->value.ctnl_pt_rsp.supp_loc);
                     break;
-                }
                 case RSCPC_RD_WR_RSC_MEAS_CFG:
-                {
-                    uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 4, 0, 0, 0, 0};
-                    pdu[1] =  EACI_MSG_DATA_IND_RSCPC_RSC_MEAS_CFG;
-                    pdu[3] = (uint8_t)(ATT_SVC_RUNNING_SPEED_CADENCE);
-                    pdu[4] = (uint8_t)(ATT_SVC_RUNNING_SPEED_CADENCE >> 8);
-                    pdu[5] = (uint8_t)(((struct rscpc_value_ind *)param)->value.ntf_cfg);
-                    pdu[6] = (uint8_t)(((struct rscpc_value_ind *)param)->value.ntf_cfg >> 8);
-                    eaci_pdu_send(sizeof(pdu), pdu);
+                    app_eaci_data_ind_send(ATT_SVC_RUNNING_SPEED_CADENCE, EACI_MSG_DATA_IND_RSCPC_RSC_MEAS_CFG,
+                                           ((struct rscpc_value_ind *)param)->value.ntf_cfg);
                     break;
-                }
                 case RSCPC_RD_WR_SC_CTNL_PT_CFG:
-                {
-                    uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 4, 0, 0, 0, 0};
-                    pdu[1] =  EACI_MSG_DATA_IND_RSCPC_RSC_PT_CFG;
-                    pdu[3] = (uint8_t)(ATT_SVC_RUNNING_SPEED_CADENCE);
-                    pdu[4] = (uint8_t)(ATT_SVC_RUNNING_SPEED_CADENCE >> 8);
-                    pdu[5] = (uint8_t)(((struct rscpc_value_ind *)param)->value.ntf_cfg);
-                    pdu[6] = (uint8_t)(((struct rscpc_value_ind *)param)->value.ntf_cfg >> 8);
-                    eaci_pdu_send(sizeof(pdu), pdu);
+                    app_eaci_data_ind_send(ATT_SVC_RUNNING_SPEED_CADENCE, EACI_MSG_DATA_IND_RSCPC_RSC_PT_CFG,
+                                           ((struct rscpc_value_ind *)param)->value.ntf_cfg);
                     break;
-                }
                 default:
                     break;
             }
@@ -386,48 +322,24 @@ void rsc_app_task_msg_hdl(ke_msg_id_t const msgid, void const *param)
             switch (operation)
             {
                 case RSCPS_SEND_RSC_MEAS_OP_CODE:
-                {
-                    uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 3, 0, 0, 0};
-                    pdu[1] =  EACI_MSG_DATA_IND_PASPS_SEND_MEAS;
-                    pdu[3] = (uint8_t)(ATT_SVC_RUNNING_SPEED_CADENCE);
-                    pdu[4] = (uint8_t)(ATT_SVC_RUNNING_SPEED_CADENCE >> 8);
-                    pdu[5] = ((struct rscps_cmp_evt *)param)->status;
-                    eaci_pdu_send(sizeof(pdu), pdu);
+                    app_eaci_data_ind_send(ATT_SVC_RUNNING_SPEED_CADENCE, EACI_MSG_DATA_IND_PASPS_SEND_MEAS,
+                                           ((struct rscps_cmp_evt *)param)->status);
                     break;
-                }
 
                 case RSCPS_CTNL_PT_CUMUL_VAL_OP_CODE:
-                {
-                    uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 3, 0, 0, 0};
-                    pdu[1] =  EACI_MSG_DATA_IND_PASPS_CTNL_CUMUL;
-                    pdu[3] = (uint8_t)(ATT_SVC_RUNNING_SPEED_CADENCE);
-                    pdu[4] = (uint8_t)(ATT_SVC_RUNNING_SPEED_CADENCE >> 8);
-                    pdu[5] = ((struct rscps_cmp_evt *)param)->status;
-                    eaci_pdu_send(sizeof(pdu), pdu);
+                    app_eaci_data_ind_send(ATT_SVC_RUNNING_SPEED_CADENCE, EACI_MSG_DATA_IND_PASPS_CTNL_CUMUL,
+                                           ((struct rscps_cmp_evt *)param)->status);
                     break;
-                }
 
                 case RSCPS_CTNL_PT_UPD_LOC_OP_CODE:
-                {
-                    uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 3, 0, 0, 0};
-                    pdu[1] =  EACI_MSG_DATA_IND_PASPS_CTNL_UPD_LOC;
-                    pdu[3] = (uint8_t)(ATT_SVC_RUNNING_SPEED_CADENCE);
-                    pdu[4] = (uint8_t)(ATT_SVC_RUNNING_SPEED_CADENCE >> 8);
-                    pdu[5] = ((struct rscps_cmp_evt *)param)->status;
-                    eaci_pdu_send(sizeof(pdu), pdu);
+                    app_eaci_data_ind_send(ATT_SVC_RUNNING_SPEED_CADENCE, EACI_MSG_DATA_IND_PASPS_CTNL_UPD_LOC,
+                                           ((struct rscps_cmp_evt *)param)->status);
                     break;
-                }
 
                 case RSCPS_CTNL_PT_SUPP_LOC_OP_CODE:
-                {
-                    uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 3, 0, 0, 0};
-                    pdu[1] =  EACI_MSG_DATA_IND_PASPS_CTNL_SUPP_LOC;
-                    pdu[3] = (uint8_t)(ATT_SVC_RUNNING_SPEED_CADENCE);
-                    pdu[4] = (uint8_t)(ATT_SVC_RUNNING_SPEED_CADENCE >> 8);
-                    pdu[5] = ((struct rscps_cmp_evt *)param)->status;
-                    eaci_pdu_send(sizeof(pdu), pdu);
+                    app_eaci_data_ind_send(ATT_SVC_RUNNING_SPEED_CADENCE, EACI_MSG_DATA_IND_PASPS_CTNL_SUPP_LOC,
+                                           ((struct rscps_cmp_evt *)param)->status);
                     break;
-                }
 
             }
             break;
@@ -139,65 +139,31 @@ void sp_app_task_msg_hdl(ke_msg_id_t const msgid, void const *param)
     {
 #if BLE_SP_CLIENT
         case SCPPC_ENABLE_CFM:
-        {
-            uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 3, 0, 0, 0};
-            pdu[1] =  EACI_MSG_DATA_IND_SP_ENABLE;
-            pdu[3] = (uint8_t)(ATT_SVC_SCAN_PARAMETERS);
-            pdu[4] = (uint8_t)(ATT_SVC_SCAN_PARAMETERS >> 8);
-            pdu[5] = ((struct scppc_enable_cfm *)param)->status;
-            eaci_pdu_send(sizeof(pdu), pdu);
-        }
+            app_eaci_data_ind_send(ATT_SVC_SCAN_PARAMETERS, EACI_MSG_DATA_IND_SP_ENABLE,
+                                   ((struct scppc_enable_cfm *)param)->status);
             break;
 
         case SCPPC_WR_CHAR_RSP:
-        {
-            uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 3, 0, 0, 0};
-            pdu[1] =  EACI_MSG_DATA_IND_SP_WR_RSP;
-            pdu[3] = (uint8_t)(ATT_SVC_SCAN_PARAMETERS);
-            pdu[4] = (uint8_t)(ATT_SVC_SCAN_PARAMETERS >> 8);
-            pdu[5] = ((struct scppc_wr_char_rsp *)param)->status;
-            eaci_pdu_send(sizeof(pdu), pdu);
-        }
+            app_eaci_data_ind_send(ATT_SVC_SCAN_PARAMETERS, EACI_MSG_DATA_IND_SP_WR_RSP,
+                                   ((struct scppc_wr_char_rsp *)param)->status);
             break;
 
         case SCPPC_SCAN_REFRESH_NTF_CFG_RD_RSP:
-        {
-            uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 4, 0, 0, 0, 0};
-            pdu[1] =  EACI_MSG_DATA_IND_SP_RD_CFG;
-            pdu[3] = (uint8_t)(ATT_SVC_SCAN_PARAMETERS);
-            pdu[4] = (uint8_t)(ATT_SVC_SCAN_PARAMETERS >> 8);
-            pdu[5] = (uint8_t)(((struct scppc_scan_refresh_ntf_cfg_rd_rsp *)param)->ntf_cfg);
-            pdu[6] = (uint8_t)((((struct scppc_scan_refresh_ntf_cfg_rd_rsp *)param)->ntf_cfg) >> 8);
-            eaci_pdu_send(sizeof(pdu), pdu);
-        }
+            app_eaci_data_ind_send(ATT_SVC_SCAN_PARAMETERS, EACI_MSG_DATA_IND_SP_RD_CFG,
+                                   ((struct scppc_scan_refresh_ntf_cfg_rd_rsp *)param)->ntf_cfg);
             break;
 #endif
 
 #if BLE_SP_SERVER
         case SCPPS_SCAN_INTV_WD_IND:
-        {
-            uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 6, 0, 0, 0, 0, 0, 0};
-            pdu[1] =  EACI_MSG_DATA_IND_SP_INTV_WD;
-            pdu[3] = (uint8_t)(ATT_SVC_SCAN_PARAMETERS);
-            pdu[4] = (uint8_t)(ATT_SVC_SCAN_PARAMETERS >> 8);
-            pdu[5] = (uint8_t)(((struct scpps_scan_intv_wd_ind *)param)->scan_intv_wd.le_scan_intv);
-            pdu[6] = (uint8_t)((((struct scpps_scan_intv_wd_ind *)param)->scan_intv_wd.le_scan_intv) >> 8);
-            pdu[7] = (uint8_t)(((struct scpps_scan_intv_wd_ind *)param)->scan_intv_wd.le_scan_window);
-            pdu[8] = (uint8_t)((((struct scpps_scan_intv_wd_ind *)param)->scan_intv_wd.le_scan_window) >> 8);
-            eaci_pdu_send(sizeof(pdu), pdu);
-        }
+            app_eaci_data_ind_send(ATT_SVC_SCAN_PARAMETERS, EACI_MSG_DATA_IND_SP_INTV_WD,
+                                   ((struct scpps_scan_intv_wd_ind *)param)->scan_intv_wd.le_scan_intv,
+                                   ((struct scpps_scan_intv_wd_ind *)param)->scan_intv_wd.le_scan_window);
             break;
 
         case SCPPS_SCAN_REFRESH_NTF_CFG_IND:
-        {
-            uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 4, 0, 0, 0, 0};
-            pdu[1] =  EACI_MSG_DATA_IND_SP_REFRESH_NTF_CFG;
-            pdu[3] = (uint8_t)(ATT_SVC_SCAN_PARAMETERS);
-            pdu[4] = (uint8_t)(ATT_SVC_SCAN_PARAMETERS >> 8);
-            pdu[5] = (uint8_t)(((struct scpps_scan_refresh_ntf_cfg_ind *)param)->scan_refresh_ntf_en);
-            pdu[6] = (uint8_t)((((struct scpps_scan_refresh_ntf_cfg_ind *)param)->scan_refresh_ntf_en) >> 8);
-            eaci_pdu_send(sizeof(pdu), pdu);
-        }
+            app_eaci_data_ind_send(ATT_SVC_SCAN_PARAMETERS, EACI_MSG_DATA_IND_SP_REFRESH_NTF_CFG,
+                                   ((struct scpps_scan_refresh_ntf_cfg_ind *)param)->scan_refresh_ntf_en);
             break;
 #endif
         default:
@@ -148,129 +148,66 @@ void tip_app_task_msg_hdl(ke_msg_id_t const msgid, void const *param)
     {
 #if BLE_TIP_CLIENT
         case TIPC_ENABLE_CFM:
-        {
-            uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 3, 0, 0, 0};
-            pdu[1] =  EACI_MSG_DATA_IND_TIP_ENABLE;
-            pdu[3] = (uint8_t)(ATT_SVC_CURRENT_TIME);
-            pdu[4] = (uint8_t)(ATT_SVC_CURRENT_TIME >> 8);
-            pdu[5] = ((struct tipc_enable_cfm *)param)->status;
-            eaci_pdu_send(sizeof(pdu), pdu);
-        }
+            app_eaci_data_ind_send(ATT_SVC_CURRENT_TIME, EACI_MSG_DATA_IND_TIP_ENABLE,
+                                   ((struct tipc_enable_cfm *)param)->status);
             break;
 
         case TIPC_WR_CHAR_RSP:
-        {
-            uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 3, 0, 0, 0};
-            pdu[1] =  EACI_MSG_DATA_IND_TIP_WR_RSP;
-            pdu[3] = (uint8_t)(ATT_SVC_CURRENT_TIME);
-            pdu[4] = (uint8_t)(ATT_SVC_CURRENT_TIME >> 8);
-            pdu[5] = ((struct tipc_wr_char_rsp *)param)->status;
-            eaci_pdu_send(sizeof(pdu), pdu);
-        }
+            app_eaci_data_ind_send(ATT_SVC_CURRENT_TIME, EACI_MSG_DATA_IND_TIP_WR_RSP,
+                                   ((struct tipc_wr_char_rsp *)param)->status);
             break;
 
         case TIPC_CT_IND:
-        {
-            uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 10, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-            pdu[1] =  EACI_MSG_DATA_IND_TIP_CT;
-            pdu[3] = (uint8_t)(ATT_SVC_CURRENT_TIME);
-            pdu[4] = (uint8_t)(ATT_SVC_CURRENT_TIME >> 8);
-            pdu[5] = (uint8_t)(((struct tipc_ct_ind *)param)->ct_val.exact_time_256.day_date_time.date_time.year);
-            pdu[6] = (uint8_t)((((struct tipc_ct_ind *)param)->ct_val.exact_time_256.day_date_time.date_time.year) >> 8);
-            pdu[7] = ((struct tipc_ct_ind *)param)->ct_val.exact_time_256.day_date_time.date_time.month;
-            pdu[8] = ((struct tipc_ct_ind *)param)->ct_val.exact_time_256.day_date_time.date_time.day;
-            pdu[9] = ((struct tipc_ct_ind *)param)->ct_val.exact_time_256.day_date_time.date_time.hour;
-            pdu[10] = ((struct tipc_ct_ind *)param)->ct_val.exact_time_256.day_date_time.date_time.min;
-            pdu[11] = ((struct tipc_ct_ind *)param)->ct_val.exact_time_256.day_date_time.date_time.sec;
-            pdu[12] = ((struct tipc_ct_ind *)param)->ct_val.exact_time_256.day_date_time.day_of_week;
-            eaci_pdu_send(sizeof(pdu), pdu);
-        }
+            app_eaci_data_ind_send(ATT_SVC_CURRENT_TIME, EACI_MSG_DATA_IND_TIP_CT,
+                                   ((struct tipc_ct_ind *)param)->ct_val.exact_time_256.day_date_time.date_time.year,
+                                   ((struct tipc_ct_ind *)param)->ct_val.exact_time_256.day_date_time.date_time.month,
+                                   ((struct tipc_ct_ind *)param)->ct_val.exact_time_256.day_date_time.date_time.day,
+                                   ((struct tipc_ct_ind *)param)->ct_val.exact_time_256.day_date_time.date_time.hour,
+                                   ((struct tipc_ct_ind *)param)->ct_val.exact_time_256.day_date_time.date_time.min,
+                                   ((struct tipc_ct_ind *)param)->ct_val.exact_time_256.day_date_time.date_time.sec,
+                                   ((struct tipc_ct_ind *)param)->ct_val.exact_time_256.day_date_time.day_of_week);
             break;
 
         case TIPC_CT_NTF_CFG_RD_RSP:
-        {
-            uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 4, 0, 0, 0, 0};
-            pdu[1] =  EACI_MSG_DATA_IND_TIP_NTF_CFG_RD;
-            pdu[3] = (uint8_t)(ATT_SVC_CURRENT_TIME);
-            pdu[4] = (uint8_t)(ATT_SVC_CURRENT_TIME >> 8);
-            pdu[5] = (uint8_t)(((struct tipc_ct_ntf_cfg_rd_rsp *)param)->ntf_cfg);
-            pdu[6] = (uint8_t)((((struct tipc_ct_ntf_cfg_rd_rsp *)param)->ntf_cfg) >> 8);
-            eaci_pdu_send(sizeof(pdu), pdu);
-        }
+            app_eaci_data_ind_send(ATT_SVC_CURRENT_TIME, EACI_MSG_DATA_IND_TIP_NTF_CFG_RD,
+                                   ((struct tipc_ct_ntf_cfg_rd_rsp *)param)->ntf_cfg);
             break;
 
         case TIPC_LTI_RD_RSP:
-        {
-            uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 4, 0, 0, 0, 0};
-            pdu[1] =  EACI_MSG_DATA_IND_TIP_LTI_RD;
-            pdu[3] = (uint8_t)(ATT_SVC_CURRENT_TIME);
-            pdu[4] = (uint8_t)(ATT_SVC_CURRENT_TIME >> 8);
-            pdu[5] = ((struct tipc_lti_rd_rsp *)param)->lti_val.time_zone;
-            pdu[6] = ((struct tipc_lti_rd_rsp *)param)->lti_val.dst_offset;
-            eaci_pdu_send(sizeof(pdu), pdu);
-        }
+            app_eaci_data_ind_send(ATT_SVC_CURRENT_TIME, EACI_MSG_DATA_IND_TIP_LTI_RD,
+                                   ((struct tipc_lti_rd_rsp *)param)->lti_val.time_zone,
+                                   ((struct tipc_lti_rd_rsp *)param)->lti_val.dst_offset);
             break;
 
         case TIPC_RTI_RD_RSP:
-        {
-            uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 6, 0, 0, 0, 0, 0, 0};
-            pdu[1] =  EACI_MSG_DATA_IND_TIP_RTI_RD;
-            pdu[3] = (uint8_t)(ATT_SVC_CURRENT_TIME);
-            pdu[4] = (uint8_t)(ATT_SVC_CURRENT_TIME >> 8);
-            pdu[5] = ((struct tipc_rti_rd_rsp *)param)->rti_val.time_source;
-            pdu[6] = ((struct tipc_rti_rd_rsp *)param)->rti_val.time_accuracy;
-            pdu[7] = ((struct tipc_rti_rd_rsp *)param)->rti_val.days_update;
-            pdu[8] = ((struct tipc_rti_rd_rsp *)param)->rti_val.hours_update;
-            eaci_pdu_send(sizeof(pdu), pdu);
-        }
+            app_eaci_data_ind_send(ATT_SVC_CURRENT_TIME, EACI_MSG_DATA_IND_TIP_RTI_RD,
+                                   ((struct tipc_rti_rd_rsp *)param)->rti_val.time_source,
+                                   ((struct tipc_rti_rd_rsp *)param)->rti_val.time_accuracy,
+                                   ((struct tipc_rti_rd_rsp *)param)->rti_val.days_update,
+                                   ((struct tipc_rti_rd_rsp *)param)->rti_val.hours_update);
             break;
 
         case TIPC_TDST_RD_RSP:
-        {
-            uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 3, 0, 0, 0};
-            pdu[1] =  EACI_MSG_DATA_IND_TIP_TDST_RD;
-            pdu[3] = (uint8_t)(ATT_SVC_CURRENT_TIME);
-            pdu[4] = (uint8_t)(ATT_SVC_CURRENT_TIME >> 8);
-            pdu[5] = ((struct tipc_tdst_rd_rsp *)param)->tdst_val.dst_offset;
-            eaci_pdu_send(sizeof(pdu), pdu);
-        }
+            app_eaci_data_ind_send(ATT_SVC_CURRENT_TIME, EACI_MSG_DATA_IND_TIP_TDST_RD,
+                                   ((struct tipc_tdst_rd_rsp *)param)->tdst_val.dst_offset);
             break;
 
         case TIPC_TUS_RD_RSP:
-        {
-            uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 4, 0, 0, 0, 0};
-            pdu[1] =  EACI_MSG_DATA_IND_TIP_TUS_RD;
-            pdu[3] = (uint8_t)(ATT_SVC_CURRENT_TIME);
-            pdu[4] = (uint8_t)(ATT_SVC_CURRENT_TIME >> 8);
-            pdu[5] = ((struct tipc_tus_rd_rsp *)param)->tus_val.current_state;
-            pdu[6] = ((struct tipc_tus_rd_rsp *)param)->tus_val.result;
-            eaci_pdu_send(sizeof(pdu), pdu);
-        }
+            app_eaci_data_ind_send(ATT_SVC_CURRENT_TIME, EACI_MSG_DATA_IND_TIP_TUS_RD,
+                                   ((struct tipc_tus_rd_rsp *)param)->tus_val.current_state,
+                                   ((struct tipc_tus_rd_rsp *)param)->tus_val.result);
             break;
 #endif
 
 #if BLE_TIP_SERVER
         case TIPS_CURRENT_TIME_CCC_IND:
-        {
-            uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 4, 0, 0, 0, 0};
-            pdu[1] =  EACI_MSG_DATA_IND_TIP_CURRENT_CCC;
-            pdu[3] = (uint8_t)(ATT_SVC_CURRENT_TIME);
-            pdu[4] = (uint8_t)(ATT_SVC_CURRENT_TIME >> 8);
-            pdu[5] = (uint8_t)(((struct tips_current_time_ccc_ind *)param)->cfg_val);
-            pdu[6] = (uint8_t)((((struct tips_current_time_ccc_ind *)param)->cfg_val) >> 8);
-            eaci_pdu_send(sizeof(pdu), pdu);
-        }
+            app_eaci_data_ind_send(ATT_SVC_CURRENT_TIME, EACI_MSG_DATA_IND_TIP_CURRENT_CCC,
+                                   ((struct tips_current_time_ccc_ind *)param)->cfg_val);
             break;
 
         case TIPS_TIME_UPD_CTNL_PT_IND:
-        {
-            uint8_t pdu[] = {EACI_MSG_TYPE_DATA_IND, 0, 3, 0, 0, 0};
-            pdu[1] =  EACI_MSG_DATA_IND_TIP_UPD_CTNL_PT;
-            pdu[3] = (uint8_t)(ATT_SVC_CURRENT_TIME);
-            pdu[4] = (uint8_t)(ATT_SVC_CURRENT_TIME >> 8);
-            pdu[5] = ((struct tips_time_upd_ctnl_pt_ind *)param)->value;
-            eaci_pdu_send(sizeof(pdu), pdu);
-        }
+            app_eaci_data_ind_send(ATT_SVC_CURRENT_TIME, EACI_MSG_DATA_IND_TIP_UPD_CTNL_PT,
+                                   ((struct tips_time_upd_ctnl_pt_ind *)param)->value);
             break;
 #endif
         default:
@@ -29,12 +29,6 @@
 #include "uart.h"
 #include "spi.h"
 
-#if EACI_MSG_BUFFER_EN==TRUE
-static uint8_t eaci_msg_idx = 0;
-uint8_t eaci_msg_buf_used = 0;
-static struct eaci_msg eaci_msg_buf[EACI_BUF_DEEP];
-#endif
-
 volatile uint8_t eaci_tx_done_flag = 0;
 
 /*
@@ -52,61 +46,96 @@ void eaci_trans_send_error(uint8_t reason)
 #endif
 }
 
+static void eaci_trans_read(uint8_t *buf, uint8_t len)
+{
+#if (defined(CFG_HCI_UART))
+    uart_read(QN_HCI_PORT, buf, len, eaci_trans_rx_done);
+#elif (defined(CFG_HCI_SPI))
+    spi_read(QN_HCI_PORT, buf, len, eaci_trans_rx_done);
+    spi_int_enable(QN_HCI_PORT, SPI_RX_INT, MASK_ENABLE);
+#endif
+}
+
 static void eaci_trans_read_start(void)
 {
     // Initialize UART in reception mode state
     eaci_env.rx_state = EACI_STATE_RX_START;
     // Set the UART environment to message type 1 byte reception
-#if EACI_MSG_BUFFER_EN==TRUE
-    #if (defined(CFG_HCI_UART))
-    uart_read(QN_HCI_PORT, (uint8_t *)&eaci_env.msg_type, 1, eaci_trans_rx_done);
-    #elif (defined(CFG_HCI_SPI))
-    spi_read(QN_HCI_PORT, (uint8_t *)&eaci_env.msg_type, 1, eaci_trans_rx_done);
-    spi_int_enable(QN_HCI_PORT, SPI_RX_INT, MASK_ENABLE); 
-    #endif
-#else
-    #if (defined(CFG_HCI_UART))
-    uart_read(QN_HCI_PORT, &eaci_env.msg_type, 1, eaci_trans_rx_done);
-    #elif (defined(CFG_HCI_SPI))
-    spi_read(QN_HCI_PORT, &eaci_env.msg_type, 1, eaci_trans_rx_done);
-    spi_int_enable(QN_HCI_PORT, SPI_RX_INT, MASK_ENABLE);
-    #endif
-#endif
+    eaci_trans_read(&eaci_env.msg_type, 1);
 }
 
 static void eaci_trans_read_hdr(void)
 {
     // Change Rx state - wait for message id and parameter length
     eaci_env.rx_state = EACI_STATE_RX_HDR;
-#if (defined(CFG_HCI_UART)) 
     // Set UART environment to header reception of EACI_MSG_HDR_LEN bytes
-    uart_read(QN_HCI_PORT, (uint8_t *)&eaci_env.msg_id, EACI_MSG_HDR_LEN, eaci_trans_rx_done);
-#elif (defined(CFG_HCI_SPI))
-    spi_read(QN_HCI_PORT, (uint8_t *)&eaci_env.msg_id, EACI_MSG_HDR_LEN, eaci_trans_rx_done);
-    spi_int_enable(QN_HCI_PORT, SPI_RX_INT, MASK_ENABLE);
-#endif
+    eaci_trans_read(&eaci_env.msg_id, EACI_MSG_HDR_LEN);
 }
 
-static void eaci_trans_read_payl(uint8_t len)
+static void eaci_trans_read_payl(void)
 {
+    uint16_t len;
+    uint8_t *buf;
+
     // Change rx state to payload reception
     eaci_env.rx_state = EACI_STATE_RX_PAYL;
-#if EACI_MSG_BUFFER_EN==TRUE
-    #if (defined(CFG_HCI_UART))
-    // Set UART environment to payload reception of len bytes
-    uart_read(QN_HCI_PORT, (uint8_t *)&eaci_msg_buf[eaci_msg_idx].param[1], len, eaci_trans_rx_done);
-    #elif (defined(CFG_HCI_SPI))
-    spi_read(QN_HCI_PORT, (uint8_t *)&eaci_msg_buf[eaci_msg_idx].param[1], len, eaci_trans_rx_done);
-    spi_int_enable(QN_HCI_PORT, SPI_RX_INT, MASK_ENABLE);
-    #endif
-#else
-    #if (defined(CFG_HCI_UART))
-    uart_read(QN_HCI_PORT, eaci_env.param + 1, len, eaci_trans_rx_done);
-    #elif (defined(CFG_HCI_SPI))
-    spi_read(QN_HCI_PORT, eaci_env.param + 1, len, eaci_trans_rx_done);
-    spi_int_enable(QN_HCI_PORT, SPI_RX_INT, MASK_ENABLE);
-    #endif
-#endif
+
+    if (eaci_env.rx_drop)
+    {
+        // Drain the payload, msg_type is free until the next message
+        buf = &eaci_env.msg_type;
+        len = 1;
+    }
+    else
+    {
+        // Receive straight behind the header in the ring, up to the end of its storage
+        buf = ring_fill_ptr(&eaci_env.rx_ring, EACI_RX_HDR_LEN + eaci_env.rx_off, &len);
+        if (len > eaci_env.param_len - eaci_env.rx_off)
+            len = eaci_env.param_len - eaci_env.rx_off;
+    }
+
+    eaci_env.rx_chunk = len;
+    eaci_trans_read(buf, len);
+}
+
+static void eaci_trans_rx_commit(void)
+{
+    uint8_t hdr[EACI_RX_HDR_LEN];
+
+    if (eaci_env.rx_drop)
+        return;
+
+    hdr[0] = eaci_env.msg_type;
+    hdr[1] = eaci_env.msg_id;
+    hdr[2] = eaci_env.param_len;
+    ring_fill(&eaci_env.rx_ring, 0, hdr, EACI_RX_HDR_LEN);
+    ring_commit(&eaci_env.rx_ring, EACI_RX_HDR_LEN + eaci_env.param_len);
+
+    // Kernel messages are allocated in background
+    ke_evt_set(1UL << EVENT_EACI_RX_ID);
+}
+
+void eaci_trans_rx_evt_handler(void)
+{
+    uint8_t hdr[EACI_RX_HDR_LEN];
+    uint8_t *param;
+
+    // Clear first, a message committed while draining sets the event again
+    ke_evt_clear(1UL << EVENT_EACI_RX_ID);
+
+    while (ring_peek(&eaci_env.rx_ring, 0, hdr, EACI_RX_HDR_LEN))
+    {
+        // Encode msg_type and msg_id into src_id and allocate right length space for expected struct
+        param = (uint8_t *)ke_msg_alloc(APP_SYS_UART_DATA_IND,
+                                        TASK_APP,
+                                        (uint16_t)(hdr[0] << 8 | hdr[1]),
+                                        hdr[2] + 1);
+        param[0] = hdr[2];
+        ring_peek(&eaci_env.rx_ring, EACI_RX_HDR_LEN, param + 1, hdr[2]);
+        ring_skip(&eaci_env.rx_ring, EACI_RX_HDR_LEN + hdr[2]);
+
+        ke_msg_send(param);
+    }
 }
 
 void eaci_trans_init(void)
@@ -188,61 +217,37 @@ void eaci_trans_rx_done(void)
                 break;
             }
 
-#if EACI_MSG_BUFFER_EN==TRUE
-            eaci_msg_buf[eaci_msg_idx].id = APP_SYS_UART_DATA_IND;
-            eaci_msg_buf[eaci_msg_idx].dest_id = TASK_APP;
-            eaci_msg_buf[eaci_msg_idx].src_id = (uint16_t)(eaci_env.msg_type << 8 | eaci_env.msg_id);
-            eaci_msg_buf[eaci_msg_idx].param_len = eaci_env.param_len + 1;   
-            eaci_msg_buf[eaci_msg_idx].param[0] = eaci_env.param_len;
-            eaci_msg_buf_used++;
-#else 
-            // Encode msg_type and msg_id into src_id and allocate right length space for expected struct
-            eaci_env.param = (uint8_t *)ke_msg_alloc(APP_SYS_UART_DATA_IND,
-                                                     TASK_APP,
-                                                     (uint16_t)(eaci_env.msg_type << 8 | eaci_env.msg_id),
-                                                     eaci_env.param_len + 1);
-            eaci_env.param[0] = eaci_env.param_len;
-#endif
+            // The background is late, drop the message rather than block the link
+            eaci_env.rx_off = 0;
+            eaci_env.rx_drop = ring_space(&eaci_env.rx_ring) < EACI_RX_HDR_LEN + eaci_env.param_len;
+            if (eaci_env.rx_drop)
+                eaci_env.rx_drop_cnt++;
+
             // NO Parameters
             if (eaci_env.param_len == 0)
             {
-                // Send message directly
-#if EACI_MSG_BUFFER_EN==TRUE
-                ke_msg_send(eaci_msg_buf[eaci_msg_idx].param);
-                eaci_msg_idx++;
-                if (eaci_msg_idx >= EACI_BUF_DEEP) {
-                    eaci_msg_idx = 0;
-                }
-                if (eaci_msg_buf_used == EACI_BUF_DEEP) {
-                    break;
-                }
-#else
-                ke_msg_send(eaci_env.param);
-#endif
+                eaci_trans_rx_commit();
                 // Change eaci rx state to message header reception
                 eaci_trans_read_start();
             }
             else
             {
-                eaci_trans_read_payl(eaci_env.param_len);
+                eaci_trans_read_payl();
             }
             break;
 
         // Parameter received
         case EACI_STATE_RX_PAYL:
-            // Send received kernel message without other treatment
-#if EACI_MSG_BUFFER_EN==TRUE
-            ke_msg_send(eaci_msg_buf[eaci_msg_idx].param);
-            eaci_msg_idx++;
-            if (eaci_msg_idx >= EACI_BUF_DEEP) {
-                eaci_msg_idx = 0;
-            }
-            if (eaci_msg_buf_used == EACI_BUF_DEEP) {
+            eaci_env.rx_off += eaci_env.rx_chunk;
+            if (eaci_env.rx_off < eaci_env.param_len)
+            {
+                // Payload wraps at the end of the ring
+                eaci_trans_read_payl();
                 break;
             }
-#else
-            ke_msg_send(eaci_env.param);
-#endif
+
+            // Hand the message to the background without other treatment
+            eaci_trans_rx_commit();
             // Change eaci rx state to ke message header reception
             eaci_trans_read_start();
             break;
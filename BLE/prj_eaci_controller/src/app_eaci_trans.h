@@ -22,20 +22,6 @@
 // Field length of Message Type and Parameter Length
 #define EACI_MSG_HDR_LEN        2
 
-#if (defined(CFG_HCI_SPI))
-#define EACI_MSG_BUFFER_EN      TRUE
-#else
-#define EACI_MSG_BUFFER_EN      FALSE
-#endif
-
-#if EACI_MSG_BUFFER_EN==TRUE
-// Rx payload max size
-#define EACI_RX_MAX_SIZE        32
-// EACI message buffer deep
-#define EACI_BUF_DEEP           4
-extern uint8_t eaci_msg_buf_used;
-#endif
-
 /*
  * GLOBAL VARIABLE DECLARATIONS
  ****************************************************************************************
@@ -43,24 +29,6 @@ extern uint8_t eaci_msg_buf_used;
 
 extern struct eaci_env_tag eaci_env;
 
-#if EACI_MSG_BUFFER_EN==TRUE
-/// EACI Message structure.
-struct eaci_msg
-{
-    struct co_list_hdr hdr;     ///< List header for chaining
-    
-    uint8_t         hci_type;   ///< Type of HCI data (used by the HCI only)
-    int8_t          hci_off;    ///< Offset of the HCI data in the message (used by the HCI only)
-    uint16_t        hci_len;    ///< Length of the HCI traffic (used by the HCI only)
-    
-    ke_msg_id_t     id;         ///< Message id.
-    ke_task_id_t    dest_id;    ///< Destination kernel identifier.
-    ke_task_id_t    src_id;     ///< Source kernel identifier.
-    uint16_t        param_len;  ///< Parameter embedded struct length.
-    uint8_t         param[EACI_RX_MAX_SIZE];
-};
-#endif
-
 /*
  * FUNCTION DECLARATIONS
  ****************************************************************************************
@@ -98,5 +66,13 @@ void eaci_trans_write(struct ke_msg *msg);
  */
 void eaci_trans_rx_done(void);
 
+/*
+ ****************************************************************************************
+ * @brief EACI Function called in background to send the received messages to TASK_APP.
+ *
+ ****************************************************************************************
+ */
+void eaci_trans_rx_evt_handler(void);
+
 /// @} EACI_TRANS
 #endif // APP_EACI_TRANS_H_
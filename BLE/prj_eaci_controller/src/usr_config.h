@@ -128,6 +128,21 @@
 /// Support service discovery
 #define CFG_SVC_DISC
 
+/// BLE heap statistics, read with EACI_MSG_CMD_HEAP_STAT
+// #define CFG_HEAP_STAT
+
+/// Sleep profile, read with EACI_MSG_CMD_SLEEP_STAT
+// #define CFG_SLEEP_STAT
+
+/// Handler profile, read with EACI_MSG_CMD_TASK_PROF
+// #define CFG_TASK_PROF
+
+/// BLE heap trace, read with EACI_MSG_CMD_HEAP_TRACE
+// #define CFG_HEAP_TRACE
+
+/// Resolve private addresses against all bonded IRKs locally, with a cache of resolved addresses
+// #define CFG_RPA_RESOLVE
+
 /// ATT parts
 #define CFG_ATTC
 #define CFG_ATTS
@@ -0,0 +1,302 @@
+/**
+ ****************************************************************************************
+ *
+ * @file eaci_bench.c
+ *
+ * @brief Throughput and correlation check of the EACI host library on Linux.
+ *
+ * Up to EACI_REQ_MAX commands are kept outstanding against the emulator (eaci_emu.c, run
+ * on a pseudo terminal) or a real controller (-d). Every answer is checked to carry the
+ * address or echoed byte of its command, also while unsolicited events for other peers
+ * are mixed in (-u).
+ *
+ * Copyright(C) 2015 NXP Semiconductors N.V.
+ * All rights reserved.
+ *
+ * $Rev: $
+ *
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+#define _GNU_SOURCE
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "app_env.h"
+#include "eaci.h"
+#include "eaci_posix.h"
+#include "eaci_codec.h"
+#include "eaci_emu.h"
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+///Time without any answer before the run is failed
+#define EACI_BENCH_TIMEOUT_MS       2000
+
+/*
+ * TYPE DEFINITIONS
+ ****************************************************************************************
+ */
+
+///Outstanding command
+struct eaci_bench_req
+{
+    ///Command id
+    uint8_t cmd_id;
+    ///Address or echoed byte the answer must carry
+    uint8_t key_val[BD_ADDR_LEN];
+    ///Time the command was sent
+    uint64_t sent_ns;
+};
+
+/*
+ * GLOBAL VARIABLE DEFINITIONS
+ ****************************************************************************************
+ */
+struct app_env_tag app_env;
+
+static struct eaci_bench_req eaci_bench_req[EACI_REQ_MAX];
+static uint32_t eaci_bench_done;
+static uint32_t eaci_bench_error;
+static uint32_t eaci_bench_evt;
+static uint64_t eaci_bench_lat_total;
+static uint64_t eaci_bench_lat_max;
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+static uint64_t eaci_bench_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+// Host application hooks of the library
+void app_eaci_evt(uint8_t msg_id, uint8_t param_len, uint8_t const *param)
+{
+    eaci_bench_evt++;
+}
+
+void app_eaci_data_ind(uint8_t msg_id, uint8_t param_len, uint8_t const *param)
+{
+}
+
+void app_eaci_data_error_rsp(uint8_t msg_id, uint8_t param_len, uint8_t const *param)
+{
+}
+
+static void eaci_bench_cb(uint8_t token, uint8_t param_len, uint8_t const *param)
+{
+    struct eaci_bench_req *req = &eaci_bench_req[token];
+    uint8_t evt_id = eaci_cmd_evt[req->cmd_id];
+    uint8_t const *addr;
+    uint64_t lat = eaci_bench_now() - req->sent_ns;
+    bool ok = eaci_layout_check(eaci_evt_layout[evt_id], param_len);
+
+    switch (eaci_cmd_key[req->cmd_id])
+    {
+    case EACI_KEY_ADDR:
+        addr = eaci_layout_addr(eaci_evt_layout[evt_id], param, param_len);
+        ok = ok && addr != NULL && memcmp(addr, req->key_val, BD_ADDR_LEN) == 0;
+        break;
+    case EACI_KEY_ECHO:
+        ok = ok && param_len != 0 && param[0] == req->key_val[0];
+        break;
+    default:
+        break;
+    }
+
+    if (!ok)
+    {
+        fprintf(stderr, "mismatch: token %d command %d\n", token, req->cmd_id);
+        eaci_bench_error++;
+    }
+
+    eaci_bench_done++;
+    eaci_bench_lat_total += lat;
+    if (lat > eaci_bench_lat_max)
+        eaci_bench_lat_max = lat;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Send the n-th command of the run: connections, disconnections and bonds of
+ * distinct peers, advertising start and stop, heap statistics.
+ * @return false if no request slot is free.
+ ****************************************************************************************
+ */
+static bool eaci_bench_send(uint32_t n)
+{
+    uint8_t pdu[EACI_PDU_MAX_LEN];
+    struct bd_addr addr = {{0x01, 0x00, 0x00, 0xBE, 0x7C, 0x08}};
+    uint8_t cmd_id;
+    uint16_t len;
+    uint8_t token;
+
+    addr.addr[1] = (uint8_t)n;
+    addr.addr[2] = (uint8_t)(n >> 8);
+
+    switch (n % 5)
+    {
+    case 0:
+        cmd_id = EACI_MSG_CMD_CONN;
+        len = eaci_pack(pdu, EACI_MSG_TYPE_CMD, cmd_id, "BHHHA", 0, 0x0010, 0x0020, 0x01F4, &addr);
+        break;
+    case 1:
+        cmd_id = EACI_MSG_CMD_DISC;
+        len = eaci_pack(pdu, EACI_MSG_TYPE_CMD, cmd_id, "A", &addr);
+        break;
+    case 2:
+        cmd_id = EACI_MSG_CMD_BOND;
+        len = eaci_pack(pdu, EACI_MSG_TYPE_CMD, cmd_id, "A", &addr);
+        break;
+    case 3:
+        cmd_id = EACI_MSG_CMD_ADV;
+        len = eaci_pack(pdu, EACI_MSG_TYPE_CMD, cmd_id, "BHH", (n / 5) & 1, 0x0020, 0x0040);
+        break;
+    default:
+        cmd_id = EACI_MSG_CMD_HEAP_STAT;
+        len = eaci_pack(pdu, EACI_MSG_TYPE_CMD, cmd_id, "");
+        break;
+    }
+
+    token = eaci_cmd_send(len, pdu, eaci_bench_cb);
+    if (token == EACI_REQ_INVALID)
+        return false;
+
+    eaci_bench_req[token].cmd_id = cmd_id;
+    if (cmd_id == EACI_MSG_CMD_ADV)
+        eaci_bench_req[token].key_val[0] = pdu[EACI_PDU_HDR_LEN];
+    else
+        memcpy(eaci_bench_req[token].key_val, addr.addr, BD_ADDR_LEN);
+    eaci_bench_req[token].sent_ns = eaci_bench_now();
+
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    char slave[64];
+    char const *dev = NULL;
+    uint8_t pdu[EACI_PDU_MAX_LEN];
+    uint32_t count = 1000;
+    uint32_t unsol = 0;
+    uint32_t sent = 0;
+    uint32_t idle_ms = 0;
+    uint64_t start;
+    double elapsed;
+    pid_t emu = -1;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "d:n:u:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'd':
+            dev = optarg;
+            break;
+        case 'n':
+            count = strtoul(optarg, NULL, 0);
+            break;
+        case 'u':
+            unsol = strtoul(optarg, NULL, 0);
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-d dev] [-n count] [-u every]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    if (dev == NULL)
+    {
+        int fd = eaci_emu_open(slave, sizeof(slave));
+
+        if (fd < 0)
+        {
+            perror("eaci_emu_open");
+            return 1;
+        }
+        // Opened before the fork, the emulator never sees the terminal closed too early
+        if (eaci_posix_open(slave, 115200) < 0)
+        {
+            perror(slave);
+            return 1;
+        }
+        emu = fork();
+        if (emu == 0)
+        {
+            close(eaci_posix_fd());
+            eaci_emu_serve(fd, unsol);
+            _exit(0);
+        }
+        close(fd);
+        dev = slave;
+    }
+    else if (eaci_posix_open(dev, 115200) < 0)
+    {
+        perror(dev);
+        return 1;
+    }
+
+    memset(&app_env, 0, sizeof(app_env));
+    eaci_msg_que_init(&app_env.msg_que);
+    app_eaci_init();
+
+    start = eaci_bench_now();
+    while (eaci_bench_done < count && eaci_bench_error == 0)
+    {
+        uint32_t done = eaci_bench_done;
+
+        while (sent < count && eaci_bench_send(sent))
+            sent++;
+
+        if (eaci_posix_poll(10) < 0)
+        {
+            perror("eaci_posix_poll");
+            break;
+        }
+        while (eaci_msg_que_pop(&app_env.msg_que, pdu) != 0)
+            app_eaci_msg_hdl(pdu[0], pdu[1], pdu[2], pdu + EACI_PDU_HDR_LEN);
+
+        idle_ms = (eaci_bench_done == done) ? idle_ms + 10 : 0;
+        if (idle_ms >= EACI_BENCH_TIMEOUT_MS)
+        {
+            fprintf(stderr, "timeout: %u of %u answered\n", eaci_bench_done, count);
+            break;
+        }
+    }
+    elapsed = (eaci_bench_now() - start) / 1e9;
+
+    eaci_posix_close();
+    if (emu > 0)
+    {
+        kill(emu, SIGTERM);
+        waitpid(emu, NULL, 0);
+    }
+
+    printf("%s: %u commands, %u events, %u mismatches\n", dev, eaci_bench_done, eaci_bench_evt,
+           eaci_bench_error);
+    if (eaci_bench_done != 0)
+    {
+        printf("%.0f cmds/s, latency avg %.1f us, max %.1f us\n", eaci_bench_done / elapsed,
+               eaci_bench_lat_total / 1e3 / eaci_bench_done, eaci_bench_lat_max / 1e3);
+    }
+
+    return (eaci_bench_done == count && eaci_bench_error == 0) ? 0 : 1;
+}
@@ -0,0 +1,282 @@
+/**
+ ****************************************************************************************
+ *
+ * @file eaci_emu.c
+ *
+ * @brief EACI controller emulator on a pseudo terminal, for the Linux build of the host.
+ *
+ * The emulator answers every command with the event the schema names for it, so the host
+ * library can be exercised and benchmarked without a QN9020. Run alone, it prints the
+ * terminal to give to the host and serves it until the host closes it.
+ *
+ * Copyright(C) 2015 NXP Semiconductors N.V.
+ * All rights reserved.
+ *
+ * $Rev: $
+ *
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+#include "app_env.h"
+#include "eaci.h"
+#include "eaci_codec.h"
+#include "eaci_emu.h"
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @brief Length of the fixed fields of a layout.
+ ****************************************************************************************
+ */
+static uint8_t eaci_emu_layout_len(char const *layout)
+{
+    uint8_t len = 0;
+
+    for (; *layout != '\0'; layout++)
+    {
+        switch (*layout)
+        {
+        case 'B':
+            len += 1;
+            break;
+        case 'H':
+            len += 2;
+            break;
+        case 'W':
+            len += 4;
+            break;
+        case 'A':
+            len += BD_ADDR_LEN;
+            break;
+        default:
+            break;
+        }
+    }
+
+    return len;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Write a whole PDU.
+ ****************************************************************************************
+ */
+static int eaci_emu_write(int fd, uint8_t const *pdu, uint16_t len)
+{
+    while (len != 0)
+    {
+        ssize_t n = write(fd, pdu, len);
+
+        if (n < 0)
+        {
+            if (errno == EINTR || errno == EAGAIN)
+                continue;
+            return -1;
+        }
+        pdu += n;
+        len -= n;
+    }
+
+    return 0;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Read exactly len bytes.
+ * @return 0, or -1 when the host side is closed.
+ ****************************************************************************************
+ */
+static int eaci_emu_read(int fd, uint8_t *buf, uint16_t len)
+{
+    while (len != 0)
+    {
+        ssize_t n = read(fd, buf, len);
+
+        if (n < 0 && errno == EINTR)
+            continue;
+        // EIO once the last slave descriptor is closed
+        if (n <= 0)
+            return -1;
+        buf += n;
+        len -= n;
+    }
+
+    return 0;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Build the event answering a command.
+ * @param[in] other     Build it for another peer, as if it was sent unsolicited
+ * @return PDU length, 0 if the command has no answering event.
+ ****************************************************************************************
+ */
+static uint16_t eaci_emu_answer(uint8_t *evt, uint8_t const *cmd, bool other)
+{
+    uint8_t const *cmd_addr;
+    uint8_t *evt_addr;
+    uint8_t evt_id;
+    uint8_t len;
+
+    if (cmd[1] >= EACI_MSG_CMD_MAX || eaci_cmd_evt[cmd[1]] == EACI_MSG_EVT_RSV)
+        return 0;
+
+    evt_id = eaci_cmd_evt[cmd[1]];
+    len = eaci_emu_layout_len(eaci_evt_layout[evt_id]);
+
+    // Status OK and zero counters
+    evt[0] = EACI_MSG_TYPE_EVT;
+    evt[1] = evt_id;
+    evt[2] = len;
+    memset(evt + EACI_PDU_HDR_LEN, 0, len);
+
+    if (eaci_cmd_key[cmd[1]] == EACI_KEY_ECHO && cmd[2] != 0 && len != 0)
+    {
+        evt[EACI_PDU_HDR_LEN] = other ? !cmd[EACI_PDU_HDR_LEN] : cmd[EACI_PDU_HDR_LEN];
+    }
+
+    cmd_addr = eaci_layout_addr(eaci_cmd_layout[cmd[1]], cmd + EACI_PDU_HDR_LEN, cmd[2]);
+    evt_addr = (uint8_t *)eaci_layout_addr(eaci_evt_layout[evt_id], evt + EACI_PDU_HDR_LEN, len);
+    if (cmd_addr != NULL && evt_addr != NULL)
+    {
+        for (uint8_t i = 0; i < BD_ADDR_LEN; i++)
+            evt_addr[i] = other ? (uint8_t)~cmd_addr[i] : cmd_addr[i];
+    }
+
+    return EACI_PDU_HDR_LEN + len;
+}
+
+int eaci_emu_open(char *slave, size_t len)
+{
+    struct termios tio;
+    int fd;
+
+    fd = posix_openpt(O_RDWR | O_NOCTTY);
+    if (fd < 0)
+        return -1;
+
+    if (grantpt(fd) < 0 || unlockpt(fd) < 0 || ptsname_r(fd, slave, len) != 0)
+    {
+        close(fd);
+        return -1;
+    }
+
+    // Raw transfers from the start, nothing is echoed before the host configures its side
+    if (tcgetattr(fd, &tio) == 0)
+    {
+        cfmakeraw(&tio);
+        tcsetattr(fd, TCSANOW, &tio);
+    }
+
+    return fd;
+}
+
+uint32_t eaci_emu_serve(int fd, uint32_t unsol)
+{
+    uint8_t cmd[EACI_PDU_MAX_LEN];
+    uint8_t evt[EACI_PDU_MAX_LEN];
+    uint32_t count = 0;
+    uint16_t len;
+
+    while (eaci_emu_read(fd, cmd, EACI_PDU_HDR_LEN) == 0
+           && eaci_emu_read(fd, cmd + EACI_PDU_HDR_LEN, cmd[2]) == 0)
+    {
+        // Data requests are accepted silently
+        if (cmd[0] != EACI_MSG_TYPE_CMD)
+            continue;
+
+        count++;
+        if (unsol != 0 && (count % unsol) == 0)
+        {
+            if (eaci_cmd_key[cmd[1]] != EACI_KEY_NONE)
+            {
+                // The same event for another peer, it must not complete the request
+                len = eaci_emu_answer(evt, cmd, true);
+            }
+            else
+            {
+                // An event no command waits for
+                evt[0] = EACI_MSG_TYPE_EVT;
+                evt[1] = EACI_MSG_EVT_SMP_SEC;
+                evt[2] = 1;
+                evt[3] = 0;
+                len = 4;
+            }
+            if (len != 0 && eaci_emu_write(fd, evt, len) < 0)
+                break;
+        }
+
+        len = eaci_emu_answer(evt, cmd, false);
+        if (len != 0 && eaci_emu_write(fd, evt, len) < 0)
+            break;
+    }
+
+    return count;
+}
+
+#if (!defined(EACI_EMU_NO_MAIN))
+int main(int argc, char *argv[])
+{
+    char slave[64];
+    uint32_t unsol = 0;
+    int opt;
+    int fd;
+
+    while ((opt = getopt(argc, argv, "u:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'u':
+            unsol = strtoul(optarg, NULL, 0);
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-u every]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    fd = eaci_emu_open(slave, sizeof(slave));
+    if (fd < 0)
+    {
+        perror("eaci_emu");
+        return 1;
+    }
+
+    printf("%s\n", slave);
+    fflush(stdout);
+
+    // The master reads EIO until the host opens the slave
+    for (;;)
+    {
+        uint32_t count = eaci_emu_serve(fd, unsol);
+
+        if (count != 0)
+        {
+            printf("%u commands\n", count);
+            break;
+        }
+        usleep(100000);
+    }
+
+    close(fd);
+
+    return 0;
+}
+#endif
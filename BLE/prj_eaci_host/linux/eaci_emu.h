@@ -0,0 +1,59 @@
+/**
+ ****************************************************************************************
+ *
+ * @file eaci_emu.h
+ *
+ * @brief EACI controller emulator on a pseudo terminal, for the Linux build of the host.
+ *
+ * Copyright(C) 2015 NXP Semiconductors N.V.
+ * All rights reserved.
+ *
+ * $Rev: $
+ *
+ ****************************************************************************************
+ */
+
+#ifndef EACI_EMU_H_
+#define EACI_EMU_H_
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * FUNCTION DECLARATIONS
+ ****************************************************************************************
+ */
+
+/*
+ ****************************************************************************************
+ * @brief Create the pseudo terminal of the emulator.
+ *
+ * @param[out] slave    Path of the terminal the host opens with eaci_posix_open()
+ * @param[in]  len      Size of slave
+ *
+ * @return File descriptor of the controller side, -1 on error (errno is set).
+ ****************************************************************************************
+ */
+int eaci_emu_open(char *slave, size_t len);
+
+/*
+ ****************************************************************************************
+ * @brief Answer the EACI commands received on fd until the host side is closed.
+ *
+ * Each command gets its answering event from the schema, with a zero status, the
+ * address of the command and the echoed byte where the event carries them.
+ *
+ * @param[in] fd        File descriptor returned by eaci_emu_open()
+ * @param[in] unsol     Every unsol commands, the answer is preceded by the same event sent
+ *                      unsolicited for another peer, 0 for none
+ *
+ * @return Number of commands answered.
+ ****************************************************************************************
+ */
+uint32_t eaci_emu_serve(int fd, uint32_t unsol);
+
+#endif // EACI_EMU_H_
@@ -0,0 +1,31 @@
+/**
+ ****************************************************************************************
+ *
+ * @file intc.h
+ *
+ * @brief Interrupt masking of the Linux build of the EACI host.
+ *
+ * The POSIX port runs in the thread of its event loop, there is no interrupt to mask.
+ * The LPC17xx build gets these definitions from the CMSIS headers instead.
+ *
+ * Copyright(C) 2015 NXP Semiconductors N.V.
+ * All rights reserved.
+ *
+ * $Rev: $
+ *
+ ****************************************************************************************
+ */
+
+#ifndef _INTC_H_
+#define _INTC_H_
+
+#ifndef __STATIC_INLINE
+#define __STATIC_INLINE                 static inline
+#endif
+
+#define GLOBAL_INT_START()
+#define GLOBAL_INT_STOP()
+#define GLOBAL_INT_DISABLE()            do {
+#define GLOBAL_INT_RESTORE()            } while(0)
+
+#endif // _INTC_H_
@@ -39,12 +39,174 @@ struct eaci_env_tag eaci_env;
  */
 void app_eaci_init(void)
 {
-    LPC_PINCON->PINSEL3 &= ~(0x03 << 2);                                       /* P1.17ʼΪGPIO      */
-    LPC_GPIO1->FIODIR    |= (1 << 17);                                       /* P1.17Ϊ        */
-    LPC_GPIO1->FIOSET    |= (1 << 17);                                       /* P1.17ʼƽ*/
+#if (!defined(CFG_EACI_POSIX))
+    eaci_port_register(&eaci_lpc_port);
+#endif
+    eaci_msg_que_init(&eaci_env.tx_que);
+    if (eaci_env.port->init != NULL)
+    {
+        eaci_env.port->init();
+    }
     eaci_uart_init();
 }
 
+/**
+ ****************************************************************************************
+ * @brief Register the transport port used by EACI
+ *
+ ****************************************************************************************
+ */
+void eaci_port_register(const struct eaci_port *port)
+{
+    eaci_env.port = port;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Send an EACI command and track the event answering it.
+ *
+ ****************************************************************************************
+ */
+uint8_t eaci_cmd_send(uint16_t len, uint8_t const *pdu, eaci_req_cb callback)
+{
+    uint8_t token;
+    uint8_t evt_id = EACI_MSG_EVT_RSV;
+    uint8_t key = EACI_KEY_NONE;
+    uint8_t const *addr = NULL;
+
+    if (len >= EACI_PDU_HDR_LEN && pdu[0] == EACI_MSG_TYPE_CMD && pdu[1] < EACI_MSG_CMD_MAX
+        && len == EACI_PDU_HDR_LEN + pdu[2])
+    {
+        evt_id = eaci_cmd_evt[pdu[1]];
+        key = eaci_cmd_key[pdu[1]];
+    }
+    if (key == EACI_KEY_ADDR)
+    {
+        addr = eaci_layout_addr(eaci_cmd_layout[pdu[1]], pdu + EACI_PDU_HDR_LEN, pdu[2]);
+    }
+    if (evt_id == EACI_MSG_EVT_RSV
+        || (key == EACI_KEY_ADDR && addr == NULL)
+        || (key == EACI_KEY_ECHO && pdu[2] == 0))
+    {
+        return EACI_REQ_INVALID;
+    }
+
+    for (token = 0; token < EACI_REQ_MAX; token++)
+    {
+        if (eaci_env.req[token].state == EACI_REQ_FREE)
+            break;
+    }
+    if (token == EACI_REQ_MAX || !eaci_uart_write(len, pdu))
+    {
+        return EACI_REQ_INVALID;
+    }
+
+    eaci_env.req[token].state = EACI_REQ_PENDING;
+    eaci_env.req[token].evt_id = evt_id;
+    eaci_env.req[token].key = key;
+    if (key == EACI_KEY_ADDR)
+        memcpy(eaci_env.req[token].key_val, addr, BD_ADDR_LEN);
+    else if (key == EACI_KEY_ECHO)
+        eaci_env.req[token].key_val[0] = pdu[EACI_PDU_HDR_LEN];
+    eaci_env.req[token].seq = eaci_env.req_seq++;
+    eaci_env.req[token].result = 0;
+    eaci_env.req[token].callback = callback;
+
+    return token;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Poll an EACI request
+ *
+ ****************************************************************************************
+ */
+uint8_t eaci_req_poll(uint8_t token, uint8_t *result)
+{
+    uint8_t state;
+
+    if (token >= EACI_REQ_MAX)
+    {
+        return EACI_REQ_FREE;
+    }
+
+    state = eaci_env.req[token].state;
+    if (state == EACI_REQ_DONE)
+    {
+        *result = eaci_env.req[token].result;
+        eaci_env.req[token].state = EACI_REQ_FREE;
+    }
+
+    return state;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Check if a received event answers a pending request
+ *
+ ****************************************************************************************
+ */
+static bool eaci_req_match(struct eaci_req const *req, uint8_t evt_id, uint8_t param_len,
+                           uint8_t const *param)
+{
+    uint8_t const *addr;
+
+    if (req->state != EACI_REQ_PENDING || req->evt_id != evt_id)
+        return false;
+
+    switch (req->key)
+    {
+    case EACI_KEY_ADDR:
+        // The same event for another peer is not the answer
+        addr = eaci_layout_addr(eaci_evt_layout[evt_id], param, param_len);
+        return (addr != NULL) && (memcmp(addr, req->key_val, BD_ADDR_LEN) == 0);
+    case EACI_KEY_ECHO:
+        return (param_len != 0) && (param[0] == req->key_val[0]);
+    default:
+        return true;
+    }
+}
+
+/**
+ ****************************************************************************************
+ * @brief Complete the oldest pending request the received event answers
+ *
+ ****************************************************************************************
+ */
+static void eaci_req_complete(uint8_t evt_id, uint8_t param_len, uint8_t const *param)
+{
+    uint8_t token = EACI_REQ_INVALID;
+    uint8_t age = 0;
+
+    if (evt_id >= EACI_MSG_EVT_MAX)
+        return;
+
+    for (uint8_t i = 0; i < EACI_REQ_MAX; i++)
+    {
+        if (eaci_req_match(&eaci_env.req[i], evt_id, param_len, param)
+            && (token == EACI_REQ_INVALID || (uint8_t)(eaci_env.req_seq - eaci_env.req[i].seq) > age))
+        {
+            token = i;
+            age = eaci_env.req_seq - eaci_env.req[i].seq;
+        }
+    }
+
+    if (token != EACI_REQ_INVALID)
+    {
+        eaci_env.req[token].result = (param_len != 0) ? param[0] : 0;
+        if (eaci_env.req[token].callback != NULL)
+        {
+            eaci_env.req[token].state = EACI_REQ_FREE;
+            eaci_env.req[token].callback(token, param_len, param);
+        }
+        else
+        {
+            eaci_env.req[token].state = EACI_REQ_DONE;
+        }
+    }
+}
+
+
 /**
  ****************************************************************************************
  * @brief EACI application message handler
@@ -56,6 +218,7 @@ void app_eaci_msg_hdl(uint8_t msg_type, uint8_t msg_id, uint8_t param_len, uint8
     switch (msg_type)
     {
     case EACI_MSG_TYPE_EVT:
+        eaci_req_complete(msg_id, param_len, param);
         app_eaci_evt(msg_id, param_len, param);
         break;
     case EACI_MSG_TYPE_DATA_IND:
@@ -35,6 +35,7 @@
  * INCLUDE FILES
  ****************************************************************************************
  */
+#include "eaci_codec.h"
 
 /*
  * TYPE DEFINITIONS
@@ -75,33 +76,81 @@ enum
     EACI_STATE_MAX
 };
 
+/// Maximum number of outstanding EACI requests
+#define EACI_REQ_MAX            8
+/// Invalid EACI request token
+#define EACI_REQ_INVALID        0xFF
+
+///EACI request states
+enum
+{
+    ///Request slot is free
+    EACI_REQ_FREE,
+    ///Command sent, waiting for the answering event
+    EACI_REQ_PENDING,
+    ///Answering event received, result can be polled
+    EACI_REQ_DONE
+};
+
+/// Callback of a completed EACI request, param is the answering event payload
+typedef void (*eaci_req_cb)(uint8_t token, uint8_t param_len, uint8_t const *param);
+
+///EACI transport port, all transfers are asynchronous
+struct eaci_port
+{
+    ///Prepare the port before the first transfer, NULL if not needed
+    void (*init)(void);
+    ///Start to receive size bytes, rx_callback is called when all of them are received
+    void (*read)(uint8_t *bufptr, uint32_t size, void (*rx_callback)(void));
+    ///Start to send size bytes, tx_callback is called when all of them are sent
+    void (*write)(uint8_t *bufptr, uint32_t size, void (*tx_callback)(void));
+    ///Assert(true) or release(false) the controller wakeup line, NULL if not used
+    void (*wakeup)(bool on);
+};
+
+///EACI outstanding request
+struct eaci_req
+{
+    ///Request state
+    uint8_t state;
+    ///Event id answering the command
+    uint8_t evt_id;
+    ///How the answering event is matched, EACI_KEY_*
+    uint8_t key;
+    ///Value the answering event must carry: peer address or echoed byte
+    uint8_t key_val[BD_ADDR_LEN];
+    ///Order of the request, the oldest pending request gets the event
+    uint8_t seq;
+    ///First byte of the answering event, normally the status
+    uint8_t result;
+    ///Completion callback, may be NULL if the request is polled
+    eaci_req_cb callback;
+};
+
 ///EACI Environment context structure
 struct eaci_env_tag
 {
+    ///Transport port
+    const struct eaci_port *port;
+    ///Queue of PDUs waiting for transmission
+    struct eaci_msg_que tx_que;
+    ///PDU being sent by the port
+    uint8_t tx_pdu[EACI_PDU_MAX_LEN];
+    ///A PDU is being sent by the port
+    volatile bool tx_ongoing;
+    ///The controller wakeup line is asserted
+    bool tx_awake;
+    ///Outstanding requests
+    struct eaci_req req[EACI_REQ_MAX];
+    ///Sequence number of the next request
+    uint8_t req_seq;
+
     ///Rx state - can be receiving message type, header, payload or error
     uint8_t rx_state;
-    ///Message type 0x01,0x02,0x03,0x04
-    uint8_t msg_type;
-    ///Message id
-    uint8_t msg_id;
-    ///Message parameter length
-    uint8_t param_len;
-    ///Pointer to current message
-    struct eaci_msg *msg;
-};
-
-///EACI Message structure
-struct eaci_msg
-{
-    struct eaci_msg_que_elm elm;
-    ///Message type 0x01,0x02,0x03,0x04
-    uint8_t msg_type;
-    ///Message id
-    uint8_t msg_id;
-    ///Message parameter length
-    uint8_t param_len;
-    ///Message payload
-    uint8_t param[1];
+    ///Number of received messages dropped because app_env.msg_que was full
+    uint16_t rx_drop_cnt;
+    ///PDU being received: message type, message id, parameter length and payload
+    uint8_t rx_pdu[EACI_PDU_MAX_LEN];
 };
 
 /*
@@ -111,6 +160,11 @@ struct eaci_msg
 ///EACI environment structure external global variable declaration
 extern struct eaci_env_tag eaci_env;
 
+#if (!defined(CFG_EACI_POSIX))
+///EACI transport port of the LPC17xx board
+extern const struct eaci_port eaci_lpc_port;
+#endif
+
 /*
  * FUNCTION DECLARATIONS
  ****************************************************************************************
@@ -124,6 +178,56 @@ extern struct eaci_env_tag eaci_env;
  */
 void app_eaci_init(void);
 
+/*
+ ****************************************************************************************
+ * @brief Register the transport port used by EACI, must be called before app_eaci_init()
+ *
+ ****************************************************************************************
+ */
+void eaci_port_register(const struct eaci_port *port);
+
+/*
+ ****************************************************************************************
+ * @brief Send an EACI command and track the event answering it.
+ *
+ * The call does not wait, several commands may be outstanding at the same time. The
+ * answering event completes the oldest pending request waiting for the same event id
+ * and, as the schema tells (eaci_cmd_key), for the same peer address or echoed byte.
+ * Unsolicited events, a connection from a peer or a link loss for instance, do not
+ * complete a request for another peer.
+ *
+ * @param[in] len       PDU length
+ * @param[in] pdu       Command PDU, copied before return
+ * @param[in] callback  Completion callback, NULL to poll with eaci_req_poll()
+ *
+ * @return Request token, EACI_REQ_INVALID if the command has no answering event or
+ *         all the request slots are in use (nothing is sent then).
+ ****************************************************************************************
+ */
+uint8_t eaci_cmd_send(uint16_t len, uint8_t const *pdu, eaci_req_cb callback);
+
+/*
+ ****************************************************************************************
+ * @brief Poll an EACI request, the slot is released once the done state is returned
+ *
+ * @param[in]  token    Token returned by eaci_cmd_send()
+ * @param[out] result   First byte of the answering event, normally the status
+ *
+ * @return EACI_REQ_PENDING, EACI_REQ_DONE or EACI_REQ_FREE for an unknown token.
+ ****************************************************************************************
+ */
+uint8_t eaci_req_poll(uint8_t token, uint8_t *result);
+
+#if (!defined(CFG_EACI_POSIX) && defined(CFG_HCI_SPI))
+/*
+ ****************************************************************************************
+ * @brief Start to read the message type, called when the controller asks for a read.
+ *
+ ****************************************************************************************
+ */
+void eaci_lpc_spi_rx_req(void);
+#endif
+
 /*
  ****************************************************************************************
  * @brief EACI application message handler
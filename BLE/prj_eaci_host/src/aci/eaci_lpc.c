@@ -0,0 +1,126 @@
+/**
+ ****************************************************************************************
+ *
+ * @file eaci_lpc.c
+ *
+ * @brief LPC17xx UART/SPI port of the Easy Application Controller Interface.
+ *
+ * Copyright(C) 2015 NXP Semiconductors N.V.
+ * All rights reserved.
+ *
+ * $Rev: $
+ *
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+#include "app_env.h"
+#include "uart.h"
+#include "lpc17xx_spi.h"
+#include "lpc17xx_gpio.h"
+
+/*
+ * LOCAL VARIABLE DEFINITIONS
+ ****************************************************************************************
+ */
+static void (*eaci_lpc_rx_callback)(void);
+static void (*eaci_lpc_tx_callback)(void);
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+static void eaci_lpc_delay(uint32_t ulTime)
+{
+    uint32_t i;
+
+    i = 0;
+    while (ulTime--) {
+        for (i = 0; i < 5000; i++);
+    }
+}
+
+static void eaci_lpc_rx_done(void)
+{
+    rd_ongoing = 0;
+    eaci_lpc_rx_callback();
+}
+
+static void eaci_lpc_tx_done(void)
+{
+    wr_ongoing = 0;
+    eaci_lpc_tx_callback();
+}
+
+static void eaci_lpc_init(void)
+{
+    // P1.17 is the controller wakeup line, GPIO output high
+    LPC_PINCON->PINSEL3 &= ~(0x03 << 2);
+    LPC_GPIO1->FIODIR    |= (1 << 17);
+    LPC_GPIO1->FIOSET    |= (1 << 17);
+}
+
+static void eaci_lpc_read(uint8_t *bufptr, uint32_t size, void (*rx_callback)(void))
+{
+    eaci_lpc_rx_callback = rx_callback;
+    #if defined(CFG_HCI_UART)
+        uart_read(QN_HCI_UART, bufptr, size, eaci_lpc_rx_done);
+    #elif defined(CFG_HCI_SPI)
+        // The message type is read when the controller asks for it, see eaci_lpc_spi_rx_req()
+        if (eaci_env.rx_state != EACI_STATE_RX_START)
+            spi_read(QN_HCI_SPI, bufptr, size, eaci_lpc_rx_done);
+    #endif
+}
+
+static void eaci_lpc_write(uint8_t *bufptr, uint32_t size, void (*tx_callback)(void))
+{
+    eaci_lpc_tx_callback = tx_callback;
+    #if defined(CFG_HCI_UART)
+        uart_write(QN_HCI_UART, bufptr, size, eaci_lpc_tx_done);
+    #elif defined(CFG_HCI_SPI)
+        spi_write(QN_HCI_SPI, bufptr, size, eaci_lpc_tx_done);
+    #endif
+}
+
+static void eaci_lpc_wakeup(bool on)
+{
+    if (on)
+    {
+        LPC_GPIO1->FIOCLR    |= (1 << 17);
+        // Give the controller time to leave sleep mode
+        eaci_lpc_delay(4);
+    }
+    else
+    {
+        LPC_GPIO1->FIOSET    |= (1 << 17);
+    }
+}
+
+#if defined(CFG_HCI_SPI)
+/**
+ ****************************************************************************************
+ * @brief Start to read the message type, called when the controller asks for a read.
+ *
+ ****************************************************************************************
+ */
+void eaci_lpc_spi_rx_req(void)
+{
+    if (eaci_env.rx_state == EACI_STATE_RX_START)
+        spi_read(QN_HCI_SPI, &eaci_env.msg_type, 1, eaci_lpc_rx_done);
+}
+#endif
+
+/// EACI port of the LPC17xx board
+const struct eaci_port eaci_lpc_port =
+{
+    eaci_lpc_init,
+    eaci_lpc_read,
+    eaci_lpc_write,
+    eaci_lpc_wakeup,
+};
+
+/// @} EACI_LPC
@@ -0,0 +1,286 @@
+/**
+ ****************************************************************************************
+ *
+ * @file eaci_posix.c
+ *
+ * @brief POSIX port of the Easy Application Controller Interface.
+ *
+ * Copyright(C) 2015 NXP Semiconductors N.V.
+ * All rights reserved.
+ *
+ * $Rev: $
+ *
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+#include "app_env.h"
+
+#if (defined(CFG_EACI_POSIX))
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+/// Size of the chunk read from the port at once
+#define EACI_POSIX_RX_CHUNK     256
+
+/// POSIX port environment
+struct eaci_posix_env_tag
+{
+    /// File descriptor of the device or socket
+    int fd;
+    /// Pending read
+    uint8_t *rx_buf;
+    uint32_t rx_size;
+    void (*rx_callback)(void);
+    /// Pending write
+    uint8_t *tx_buf;
+    uint32_t tx_size;
+    void (*tx_callback)(void);
+    /// A write callback is running, the next write is sent by the running flush
+    bool tx_flushing;
+};
+
+/*
+ * LOCAL VARIABLE DEFINITIONS
+ ****************************************************************************************
+ */
+static struct eaci_posix_env_tag eaci_posix_env = {-1};
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+static int eaci_posix_flush(void)
+{
+    while (eaci_posix_env.tx_size != 0)
+    {
+        ssize_t n = write(eaci_posix_env.fd, eaci_posix_env.tx_buf, eaci_posix_env.tx_size);
+        if (n < 0)
+        {
+            // Wait for POLLOUT
+            return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ? 0 : -1;
+        }
+        eaci_posix_env.tx_buf += n;
+        eaci_posix_env.tx_size -= n;
+
+        if (eaci_posix_env.tx_size == 0 && eaci_posix_env.tx_callback != NULL)
+        {
+            void (*callback)(void) = eaci_posix_env.tx_callback;
+
+            // The callback queues the next PDU, which is sent by this loop
+            eaci_posix_env.tx_callback = NULL;
+            eaci_posix_env.tx_flushing = true;
+            callback();
+            eaci_posix_env.tx_flushing = false;
+        }
+    }
+
+    return 0;
+}
+
+static void eaci_posix_read(uint8_t *bufptr, uint32_t size, void (*rx_callback)(void))
+{
+    eaci_posix_env.rx_buf = bufptr;
+    eaci_posix_env.rx_size = size;
+    eaci_posix_env.rx_callback = rx_callback;
+}
+
+static void eaci_posix_write(uint8_t *bufptr, uint32_t size, void (*tx_callback)(void))
+{
+    eaci_posix_env.tx_buf = bufptr;
+    eaci_posix_env.tx_size = size;
+    eaci_posix_env.tx_callback = tx_callback;
+
+    if (!eaci_posix_env.tx_flushing)
+        eaci_posix_flush();
+}
+
+static void eaci_posix_rx_feed(uint8_t const *data, uint32_t len)
+{
+    while (len != 0 && eaci_posix_env.rx_size != 0)
+    {
+        uint32_t n = (len < eaci_posix_env.rx_size) ? len : eaci_posix_env.rx_size;
+
+        memcpy(eaci_posix_env.rx_buf, data, n);
+        eaci_posix_env.rx_buf += n;
+        eaci_posix_env.rx_size -= n;
+        data += n;
+        len -= n;
+
+        // The callback starts the next read
+        if (eaci_posix_env.rx_size == 0)
+            eaci_posix_env.rx_callback();
+    }
+}
+
+/// EACI port of a POSIX file descriptor
+static const struct eaci_port eaci_posix_port =
+{
+    NULL,
+    eaci_posix_read,
+    eaci_posix_write,
+    NULL,
+};
+
+static speed_t eaci_posix_speed(uint32_t baudrate)
+{
+    switch (baudrate)
+    {
+    case 9600:
+        return B9600;
+    case 19200:
+        return B19200;
+    case 38400:
+        return B38400;
+    case 57600:
+        return B57600;
+    case 115200:
+        return B115200;
+    case 230400:
+        return B230400;
+    default:
+        return B0;
+    }
+}
+
+int eaci_posix_open(const char *dev, uint32_t baudrate)
+{
+    struct termios tio;
+    int fd;
+
+    fd = open(dev, O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (fd < 0)
+        return -1;
+
+    if (isatty(fd))
+    {
+        speed_t speed = eaci_posix_speed(baudrate);
+
+        if (speed == B0 || tcgetattr(fd, &tio) < 0)
+        {
+            close(fd);
+            errno = (speed == B0) ? EINVAL : errno;
+            return -1;
+        }
+        cfmakeraw(&tio);
+        tio.c_cflag |= CLOCAL | CREAD;
+        cfsetispeed(&tio, speed);
+        cfsetospeed(&tio, speed);
+        if (tcsetattr(fd, TCSANOW, &tio) < 0)
+        {
+            close(fd);
+            return -1;
+        }
+        tcflush(fd, TCIOFLUSH);
+    }
+
+    eaci_posix_env.fd = fd;
+    eaci_port_register(&eaci_posix_port);
+
+    return 0;
+}
+
+int eaci_posix_connect(const char *host, const char *service)
+{
+    struct addrinfo hints, *res, *ai;
+    int fd = -1;
+    int on = 1;
+
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    if (getaddrinfo(host, service, &hints, &res) != 0)
+        return -1;
+
+    for (ai = res; ai != NULL; ai = ai->ai_next)
+    {
+        fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if (fd < 0)
+            continue;
+        if (connect(fd, ai->ai_addr, ai->ai_addrlen) == 0)
+            break;
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(res);
+
+    if (fd < 0)
+        return -1;
+
+    // EACI PDUs are small, send them without coalescing
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+    eaci_posix_env.fd = fd;
+    eaci_port_register(&eaci_posix_port);
+
+    return 0;
+}
+
+int eaci_posix_poll(int timeout_ms)
+{
+    uint8_t chunk[EACI_POSIX_RX_CHUNK];
+    struct pollfd pfd;
+    ssize_t n;
+
+    if (eaci_posix_env.fd < 0)
+        return -1;
+
+    pfd.fd = eaci_posix_env.fd;
+    pfd.events = POLLIN;
+    if (eaci_posix_env.tx_size != 0)
+        pfd.events |= POLLOUT;
+    pfd.revents = 0;
+
+    if (poll(&pfd, 1, timeout_ms) < 0)
+        return (errno == EINTR) ? 0 : -1;
+
+    if ((pfd.revents & POLLOUT) && eaci_posix_flush() < 0)
+        return -1;
+
+    if (pfd.revents & (POLLIN | POLLHUP | POLLERR))
+    {
+        n = read(eaci_posix_env.fd, chunk, sizeof(chunk));
+        if (n < 0)
+            return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ? 0 : -1;
+        // Peer closed
+        if (n == 0)
+            return -1;
+
+        eaci_posix_rx_feed(chunk, n);
+        return n;
+    }
+
+    return 0;
+}
+
+int eaci_posix_fd(void)
+{
+    return eaci_posix_env.fd;
+}
+
+void eaci_posix_close(void)
+{
+    if (eaci_posix_env.fd >= 0)
+    {
+        close(eaci_posix_env.fd);
+        eaci_posix_env.fd = -1;
+    }
+    eaci_posix_env.rx_size = 0;
+    eaci_posix_env.tx_size = 0;
+}
+
+#endif /* CFG_EACI_POSIX */
+
+/// @} EACI_POSIX
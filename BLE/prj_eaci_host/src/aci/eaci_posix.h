@@ -0,0 +1,91 @@
+/**
+ ****************************************************************************************
+ *
+ * @file eaci_posix.h
+ *
+ * @brief POSIX port of the Easy Application Controller Interface.
+ *
+ * Lets the EACI host run on a Linux gateway over a serial device, a pseudo terminal
+ * or a TCP socket. The application owns the loop:
+ *
+ *     eaci_posix_open("/dev/ttyUSB0", 115200);
+ *     app_init();
+ *     while (eaci_posix_poll(-1) >= 0)
+ *     {
+ *         uint8_t pdu[EACI_PDU_MAX_LEN];
+ *
+ *         while (eaci_msg_que_pop(&app_env.msg_que, pdu) != 0)
+ *             app_eaci_msg_hdl(pdu[0], pdu[1], pdu[2], pdu + EACI_PDU_HDR_LEN);
+ *     }
+ *
+ * Copyright(C) 2015 NXP Semiconductors N.V.
+ * All rights reserved.
+ *
+ * $Rev: $
+ *
+ ****************************************************************************************
+ */
+
+#ifndef EACI_POSIX_H_
+#define EACI_POSIX_H_
+
+/*
+ * FUNCTION DECLARATIONS
+ ****************************************************************************************
+ */
+
+/*
+ ****************************************************************************************
+ * @brief Open a serial device or a pseudo terminal and register it as EACI port.
+ *
+ * @param[in] dev       Device path
+ * @param[in] baudrate  Baud rate, ignored if the device is not a terminal
+ *
+ * @return 0 on success, -1 on error (errno is set)
+ ****************************************************************************************
+ */
+int eaci_posix_open(const char *dev, uint32_t baudrate);
+
+/*
+ ****************************************************************************************
+ * @brief Connect to a TCP server and register the socket as EACI port.
+ *
+ * @param[in] host      Host name or address
+ * @param[in] service   Port number or service name
+ *
+ * @return 0 on success, -1 on error
+ ****************************************************************************************
+ */
+int eaci_posix_connect(const char *host, const char *service);
+
+/*
+ ****************************************************************************************
+ * @brief Run the EACI port once, without blocking longer than timeout_ms.
+ *
+ * Pending data is sent and received bytes go through the EACI RX state machine, complete
+ * messages are pushed to app_env.msg_que.
+ *
+ * @param[in] timeout_ms    Maximum wait, -1 waits for the next transfer
+ *
+ * @return Number of bytes received, -1 if the port is closed or failed
+ ****************************************************************************************
+ */
+int eaci_posix_poll(int timeout_ms);
+
+/*
+ ****************************************************************************************
+ * @brief Get the file descriptor of the port, to be added to an external event loop.
+ *
+ ****************************************************************************************
+ */
+int eaci_posix_fd(void);
+
+/*
+ ****************************************************************************************
+ * @brief Close the EACI port.
+ *
+ ****************************************************************************************
+ */
+void eaci_posix_close(void);
+
+#endif // EACI_POSIX_H_
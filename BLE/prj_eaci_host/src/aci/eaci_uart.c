@@ -18,36 +18,16 @@
  ****************************************************************************************
  */
 #include "app_env.h"
-#include "uart.h"
-#include "lpc17xx_spi.h"
-#include "lpc17xx_gpio.h"
 
-extern void CS_Force(int32_t state);
-
-uint8_t payl_len =0 ;
-uint8_t* payl_para= NULL;
-uint8_t en_read_flag = 0;
-#if defined(CFG_HCI_SPI)
-static uint8_t wr_done = 0;
+#if (defined(CFG_EACI_POSIX))
+    // Single threaded event loop, nothing to protect
+    #define EACI_INT_DISABLE()
+    #define EACI_INT_RESTORE()
+#else
+    #define EACI_INT_DISABLE()      GLOBAL_INT_DISABLE()
+    #define EACI_INT_RESTORE()      GLOBAL_INT_RESTORE()
 #endif
 
-void tx_complete(void)
-{
-    wr_ongoing = 0;
-    LPC_GPIO1->FIOSET    |= (1 << 17);
-    #if defined(CFG_HCI_SPI)
-    wr_done = 1;
-    #endif
-}
-void myDelay (uint32_t ulTime)
-{
-    uint32_t i;
-
-    i = 0;
-    while (ulTime--) {
-        for (i = 0; i < 5000; i++);
-    }
-}
 /*
  * FUNCTION DEFINITIONS
  ****************************************************************************************
@@ -58,9 +38,7 @@ static void eaci_uart_read_start(void)
     // Initialize UART in reception mode state
     eaci_env.rx_state = EACI_STATE_RX_START;
     // Set the UART environment to message type 1 byte reception
-    #if defined(CFG_HCI_UART)
-        uart_read(QN_HCI_UART, &eaci_env.msg_type, 1, eaci_uart_rx_done);
-    #endif
+    eaci_env.port->read(&eaci_env.rx_pdu[0], 1, eaci_uart_rx_done);
 }
 
 static void eaci_uart_read_hdr(void)
@@ -68,23 +46,68 @@ static void eaci_uart_read_hdr(void)
     // Change Rx state - wait for message id and parameter length
     eaci_env.rx_state = EACI_STATE_RX_HDR;
     // Set UART environment to header reception of EACI_MSG_HDR_LEN bytes
-    #if defined(CFG_HCI_UART)
-        uart_read(QN_HCI_UART, (uint8_t *)&eaci_env.msg_id, EACI_MSG_HDR_LEN, eaci_uart_rx_done);
-    #elif defined(CFG_HCI_SPI) 
-        spi_read(QN_HCI_SPI,(uint8_t *)&eaci_env.msg_id, EACI_MSG_HDR_LEN, eaci_uart_rx_done);
-    #endif
+    eaci_env.port->read(&eaci_env.rx_pdu[1], EACI_MSG_HDR_LEN, eaci_uart_rx_done);
 }
 
-static void eaci_uart_read_payl(uint8_t len, uint8_t *par)
+static void eaci_uart_read_payl(uint8_t len)
 {
     // Change rx state to payload reception
-        eaci_env.rx_state = EACI_STATE_RX_PAYL;
+    eaci_env.rx_state = EACI_STATE_RX_PAYL;
     // Set UART environment to payload reception of len bytes
-    #if defined(CFG_HCI_UART)
-        uart_read(QN_HCI_UART, par, len, eaci_uart_rx_done);
-    #elif defined(CFG_HCI_SPI) 
-        spi_read(QN_HCI_SPI,par, len, eaci_uart_rx_done);   
-    #endif
+    eaci_env.port->read(&eaci_env.rx_pdu[EACI_PDU_HDR_LEN], len, eaci_uart_rx_done);
+}
+
+static void eaci_uart_rx_push(void)
+{
+    // Copied out, rx_pdu is free for the next message
+    if (!eaci_msg_que_push(&app_env.msg_que, EACI_PDU_HDR_LEN + eaci_env.rx_pdu[2], eaci_env.rx_pdu))
+        eaci_env.rx_drop_cnt++;
+}
+
+static void eaci_uart_tx_done(void);
+
+static void eaci_uart_tx_start(void)
+{
+    uint16_t len;
+    bool start;
+
+    EACI_INT_DISABLE();
+    start = !eaci_env.tx_ongoing && !eaci_msg_que_is_empty(&eaci_env.tx_que);
+    if (start)
+        eaci_env.tx_ongoing = true;
+    EACI_INT_RESTORE();
+
+    // Already sending, tx done picks up the queue
+    if (!start)
+        return;
+
+    // Only the owner of tx_ongoing gets here, the port sends from tx_pdu
+    len = eaci_msg_que_pop(&eaci_env.tx_que, eaci_env.tx_pdu);
+
+    // Wake up the controller once per burst, the line is held until the queue drains
+    if (!eaci_env.tx_awake)
+    {
+        eaci_env.tx_awake = true;
+        if (eaci_env.port->wakeup != NULL)
+            eaci_env.port->wakeup(true);
+    }
+    eaci_env.port->write(eaci_env.tx_pdu, len, eaci_uart_tx_done);
+}
+
+static void eaci_uart_tx_done(void)
+{
+    eaci_env.tx_ongoing = false;
+
+    if (eaci_msg_que_is_empty(&eaci_env.tx_que))
+    {
+        eaci_env.tx_awake = false;
+        if (eaci_env.port->wakeup != NULL)
+            eaci_env.port->wakeup(false);
+    }
+    else
+    {
+        eaci_uart_tx_start();
+    }
 }
 
 void eaci_uart_init(void)
@@ -93,33 +116,27 @@ void eaci_uart_init(void)
     eaci_uart_read_start();
 }
 
-void eaci_uart_write(uint8_t len, uint8_t *par)
+bool eaci_uart_write(uint16_t len, uint8_t const *par)
 {
-    LPC_GPIO1->FIOCLR    |= (1 << 17);
-    myDelay(4);
-    // Send out the parameter with length
-    #if defined(CFG_HCI_UART)    
-        uart_write(QN_HCI_UART, par, len, tx_complete);
-    #elif defined(CFG_HCI_SPI)
-        wr_done = 0;
-        spi_write(QN_HCI_SPI, par, len, tx_complete);
-        while(wr_done == 0);
-    #endif
-}
+    // The caller's buffer is released on return, keep a copy until it is sent
+    if (!eaci_msg_que_push(&eaci_env.tx_que, len, par))
+    {
+        QPRINTF("EACI TX queue full\r\n");
+        return false;
+    }
 
-#ifdef MSG_BUFFER_EN
-uint8_t msg_buffer[10][32];
-uint8_t msg_index = 0;
-#endif
+    eaci_uart_tx_start();
+
+    return true;
+}
 
 void eaci_uart_rx_done(void)
 {
-    rd_ongoing = 0;
     switch(eaci_env.rx_state)
     {
         // Message Type received
         case EACI_STATE_RX_START:
-            if (eaci_env.msg_type == EACI_MSG_TYPE_EVT || eaci_env.msg_type == EACI_MSG_TYPE_DATA_IND)
+            if (eaci_env.rx_pdu[0] == EACI_MSG_TYPE_EVT || eaci_env.rx_pdu[0] == EACI_MSG_TYPE_DATA_IND)
                 eaci_uart_read_hdr();
             else
             { 
@@ -128,42 +145,23 @@ void eaci_uart_rx_done(void)
             break;
         // Message ID and Parameter Length received
         case EACI_STATE_RX_HDR:
-            // Allocate right length space for expected payload
-        #ifndef MSG_BUFFER_EN
-            eaci_env.msg = MSG_MALLOC(sizeof(struct eaci_msg) + eaci_env.param_len - sizeof(uint8_t));
-        #else
-            eaci_env.msg = (struct eaci_msg *)(msg_buffer[msg_index]);
-            msg_index++;
-            if (msg_index == 10) {
-                msg_index = 0;
-            }
-        #endif
-            // List header for chaining
-            eaci_env.msg->elm.next  = NULL;
-            // Message type
-            eaci_env.msg->msg_type  = eaci_env.msg_type;
-            // Message ID
-            eaci_env.msg->msg_id    = eaci_env.msg_id;
-            // Parameter length
-            eaci_env.msg->param_len = eaci_env.param_len;
             // NO Parameters
-            if (eaci_env.param_len == 0)
-            {                   
+            if (eaci_env.rx_pdu[2] == 0)
+            {
                 // Add to message queue
-                eaci_msg_que_push(&app_env.msg_que, eaci_env.msg);
+                eaci_uart_rx_push();
                 // Change eaci rx state to message header reception
                 eaci_uart_read_start();
             }
             else
             {
-                eaci_uart_read_payl(eaci_env.param_len, eaci_env.msg->param);
+                eaci_uart_read_payl(eaci_env.rx_pdu[2]);
             }
-            
             break;
         // Parameter received
         case EACI_STATE_RX_PAYL:
             // Add to message queue with the received payload
-            eaci_msg_que_push(&app_env.msg_que, eaci_env.msg);
+            eaci_uart_rx_push();
             // Change eaci rx state to eaci message header reception
             eaci_uart_read_start();
             break;
@@ -37,9 +37,6 @@
  * FUNCTION DECLARATIONS
  ****************************************************************************************
  */
-extern uint8_t payl_len;
-extern uint8_t* payl_para;
-extern uint8_t en_read_flag;
 /*
  ****************************************************************************************
  * @brief EACI UART initialization function.
@@ -52,9 +49,13 @@ void eaci_uart_init(void);
  ****************************************************************************************
  * @brief EACI UART write function.
  *
+ * The PDU is copied and queued, the call returns without waiting for the transmission.
+ * Called from the application loop only, the queue has a single producer.
+ *
+ * @return false if the TX queue is full
  ****************************************************************************************
  */
-void eaci_uart_write(uint8_t len, uint8_t *par);
+bool eaci_uart_write(uint16_t len, uint8_t const *par);
 
 /*
  ****************************************************************************************
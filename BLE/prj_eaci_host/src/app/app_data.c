@@ -18,6 +18,7 @@
  ****************************************************************************************
  */
 #include "app_env.h"
+#include "ieee11073.h"
 
 // Manufacturing name
 #define DIS_MANU_NAME_VAL               "NXP"
@@ -43,6 +44,26 @@
  ****************************************************************************************
  */
 
+/**
+ ****************************************************************************************
+ * @brief Send a data request packed after the schema layout of the profile
+ *
+ ****************************************************************************************
+ */
+static void app_eaci_data_req_send(uint16_t uuid, uint8_t msg_id, ...)
+{
+    uint8_t pdu[EACI_PDU_MAX_LEN];
+    uint16_t len;
+    va_list ap;
+
+    va_start(ap, msg_id);
+    len = eaci_data_vpack(pdu, EACI_MSG_TYPE_DATA_REQ, msg_id, uuid, eaci_data_req_layout(uuid, msg_id), ap);
+    va_end(ap);
+
+    if (len != 0)
+        eaci_uart_write(len, pdu);
+}
+
 /**
 *************************************************************************************
 *** Alert Notification Profile
@@ -55,39 +76,19 @@ void app_eaci_data_req_anpc(uint8_t msg_id, uint8_t param_len, uint8_t const *pa
     {
         case EACI_MSG_DATA_REQ_ANPC_ENABLE:
             if (param_len == BD_ADDR_LEN)
-            {
-                uint8_t pdu[] = {EACI_MSG_TYPE_DATA_REQ, EACI_MSG_DATA_REQ_ANPC_ENABLE, 8, 0, 0, 0, 0, 0, 0, 0, 0};
-                pdu[3] = (uint8_t)(ATT_SVC_ALERT_NTF);
-                pdu[4] = (uint8_t)(ATT_SVC_ALERT_NTF >> 8);
-                app_eaci_set_bd_addr_by_param((pdu + 5), param);
-                eaci_uart_write(sizeof(pdu), pdu);
-            }
+                app_eaci_data_req_send(ATT_SVC_ALERT_NTF, msg_id, (struct bd_addr const *)param);
             break;
 
         case EACI_MSG_DATA_REQ_ANPC_RD_CFG:
             if (param_len == BD_ADDR_LEN + 1)
-            {
-                uint8_t pdu[] = {EACI_MSG_TYPE_DATA_REQ, EACI_MSG_DATA_REQ_ANPC_RD_CFG, 9, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-                pdu[3] = (uint8_t)(ATT_SVC_ALERT_NTF);
-                pdu[4] = (uint8_t)(ATT_SVC_ALERT_NTF >> 8);
-                pdu[5] = param[0];
-                app_eaci_set_bd_addr_by_param((pdu + 6), param + 1);
-                eaci_uart_write(sizeof(pdu), pdu);
-            }
+                app_eaci_data_req_send(ATT_SVC_ALERT_NTF, msg_id, param[0],
+                                       (struct bd_addr const *)(param + 1));
             break;
 
         case EACI_MSG_DATA_REQ_ANPC_WR_VAL:
             if (param_len == BD_ADDR_LEN + 3)
-            {
-                uint8_t pdu[] = {EACI_MSG_TYPE_DATA_REQ, EACI_MSG_DATA_REQ_ANPC_WR_VAL, 11, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-                pdu[3] = (uint8_t)(ATT_SVC_ALERT_NTF);
-                pdu[4] = (uint8_t)(ATT_SVC_ALERT_NTF >> 8);
-                pdu[5] = param[0];
-                pdu[6] = param[1];
-                pdu[7] = param[2];
-                app_eaci_set_bd_addr_by_param((pdu + 8), param + 3);
-                eaci_uart_write(sizeof(pdu), pdu);
-            }
+                app_eaci_data_req_send(ATT_SVC_ALERT_NTF, msg_id, param[0], param[2] << 8 | param[1],
+                                       (struct bd_addr const *)(param + 3));
             break;
 
         default:
@@ -96,52 +97,52 @@ void app_eaci_data_req_anpc(uint8_t msg_id, uint8_t param_len, uint8_t const *pa
 }
 static void app_eaci_data_ind_anpc(uint8_t msg_id, uint8_t param_len, uint8_t const *param)
 {
+    char const *layout = eaci_data_ind_layout(ATT_SVC_ALERT_NTF, msg_id);
+
     switch (msg_id)
     {
         case EACI_MSG_DATA_IND_ANPC_ENABLE:
-            if (param_len == 1)
-            {
-                QPRINTF("ANPC enable confirmation status: 0x%X.\r\n", param[0]);
-            }
+            QPRINTF("ANPC enable confirmation status: 0x%X.\r\n", param[0]);
             break;
 
         case EACI_MSG_DATA_IND_ANPC_WR_STATUS:
-            if (param_len == 1)
-            {
-                QPRINTF("ANPC Write confirmation status: 0x%X.\r\n", param[0]);
-            }
+            QPRINTF("ANPC Write confirmation status: 0x%X.\r\n", param[0]);
             break;
 
         case EACI_MSG_DATA_IND_ANPC_NEW_ALERT_CFG:
-            if (param_len == 2)
-            {
-                uint16_t cfg_val = param[1] << 8 | param[0];
-                QPRINTF("New Alert Client CFG.: 0x%04X.\r\n", cfg_val);
-            }
+        {
+            uint16_t cfg_val;
+
+            eaci_unpack(param, param_len, layout, &cfg_val);
+            QPRINTF("New Alert Client CFG.: 0x%04X.\r\n", cfg_val);
+        }
             break;
 
         case EACI_MSG_DATA_IND_ANPC_UNREAD_ALERT_CFG:
-            if (param_len == 2)
-            {
-                uint16_t cfg_val = param[1] << 8 | param[0];
-                QPRINTF("Unread Alert Status Client CFG.: 0x%04X.\r\n", cfg_val);
-            }
+        {
+            uint16_t cfg_val;
+
+            eaci_unpack(param, param_len, layout, &cfg_val);
+            QPRINTF("Unread Alert Status Client CFG.: 0x%04X.\r\n", cfg_val);
+        }
             break;
 
         case EACI_MSG_DATA_IND_ANPC_NEW_ALERT:
-            if (param_len == 2)
-            {
-                uint16_t new_alert = param[1] << 8 | param[0];
-                QPRINTF("New Alert Status Value: 0x%04X.\r\n", new_alert);
-            }
+        {
+            uint8_t cat_id, nb_new_alert;
+
+            eaci_unpack(param, param_len, layout, &cat_id, &nb_new_alert);
+            QPRINTF("New Alert Status Value: 0x%02X%02X.\r\n", nb_new_alert, cat_id);
+        }
             break;
 
         case EACI_MSG_DATA_IND_ANPC_UNREAD_ALERT_STATUS:
-            if (param_len == 2)
-            {
-                uint16_t unread_alert = param[1] << 8 | param[0];
-                QPRINTF("Unread Alert Status Value: 0x%04X.\r\n", unread_alert);
-            }
+        {
+            uint8_t cat_id, nb_unread_alert;
+
+            eaci_unpack(param, param_len, layout, &cat_id, &nb_unread_alert);
+            QPRINTF("Unread Alert Status Value: 0x%02X%02X.\r\n", nb_unread_alert, cat_id);
+        }
             break;
 
         default:
@@ -155,24 +156,10 @@ void app_eaci_data_req_anps(uint8_t msg_id, uint8_t param_len, uint8_t const *pa
 {
     switch (msg_id)
     {
-        case EACI_MSG_DATA_REQ_ANPS_NTF_ALERT:
-        {
-            uint8_t *pdu;
-            pdu = (uint8_t *)malloc(5 + param_len);
-            if (pdu != NULL)
-            {
-                memset(pdu,0,param_len+5);
-                pdu[0] = EACI_MSG_TYPE_DATA_REQ;
-                pdu[1] = EACI_MSG_DATA_REQ_ANPS_NTF_ALERT;
-                pdu[2] = 2 + param_len;
-                pdu[3] = (uint8_t)(ATT_SVC_ALERT_NTF);
-                pdu[4] = (uint8_t)(ATT_SVC_ALERT_NTF >> 8);
-                memcpy((pdu + 5), param, param_len);
-                eaci_uart_write((5 + param_len), pdu);
-                free(pdu);
-                pdu = NULL;
-            }
-        }
+        case EACI_MSG_DATA_REQ_ANPS_NTF_NEW_ALERT:
+            // operation, then the alert value
+            if (param_len >= 1)
+                app_eaci_data_req_send(ATT_SVC_ALERT_NTF, msg_id, param[0], param_len - 1, param + 1);
             break;
 
         default:
@@ -184,17 +171,11 @@ static void app_eaci_data_ind_anps(uint8_t msg_id, uint8_t param_len, uint8_t co
     switch (msg_id)
     {
         case EACI_MSG_DATA_IND_ANPS_UPD_NEW_ALERT:
-            if (param_len == 1)
-            {
-                QPRINTF("Update New Alert Status: 0x%02X.\r\n", param[0]);
-            }
+            QPRINTF("Update New Alert Status: 0x%02X.\r\n", param[0]);
             break;
 
         case EACI_MSG_DATA_IND_ANPS_UPD_UNREAD_ALERT:
-            if (param_len == 1)
-            {
-                QPRINTF("Update Unread Alert Status: 0x%02X.\r\n", param[0]);
-            }
+            QPRINTF("Update Unread Alert Status: 0x%02X.\r\n", param[0]);
             break;
 
         default:
@@ -216,33 +197,22 @@ void app_eaci_data_req_basc(uint8_t msg_id, uint8_t param_len, uint8_t const *pa
     {
         case EACI_MSG_DATA_REQ_BATT_ENABLE:
             if (param_len == BD_ADDR_LEN)
-            {
-                uint8_t pdu[] = {EACI_MSG_TYPE_DATA_REQ, EACI_MSG_DATA_REQ_BATT_ENABLE, 8, 0x0f, 0x18, 0, 0, 0, 0, 0, 0};
-                app_eaci_set_bd_addr_by_param((pdu + 5), param);
-                eaci_uart_write(sizeof(pdu), pdu);
-            }
+                app_eaci_data_req_send(ATT_SVC_BATTERY_SERVICE, msg_id, (struct bd_addr const *)param);
             break;
 
         case EACI_MSG_DATA_REQ_BATT_RD_CHAR_VAL:
             if (param_len == (BD_ADDR_LEN + 1))
             {
-                uint8_t pdu[] = {EACI_MSG_TYPE_DATA_REQ, EACI_MSG_DATA_REQ_BATT_RD_CHAR_VAL, 9, 0x0f, 0x18, 0, 0, 0, 0, 0, 0, 0};
-                pdu[5] = param[0];
                 rd_batc_char = param[0];
-                app_eaci_set_bd_addr_by_param((pdu + 6), (param +1));
-                eaci_uart_write(sizeof(pdu), pdu);
+                app_eaci_data_req_send(ATT_SVC_BATTERY_SERVICE, msg_id, param[0],
+                                       (struct bd_addr const *)(param + 1));
             }
             break;
 
         case EACI_MSG_DATA_REQ_BATT_CFG_NOTIFY:
             if (param_len == (BD_ADDR_LEN + 2))
-            {
-                uint8_t pdu[] = {EACI_MSG_TYPE_DATA_REQ, EACI_MSG_DATA_REQ_BATT_CFG_NOTIFY, 10, 0x0f, 0x18, 0, 0, 0, 0, 0, 0, 0, 0};
-                pdu[5] = param[0];
-                pdu[6] = param[1];
-                app_eaci_set_bd_addr_by_param((pdu + 7), (param + 2));
-                eaci_uart_write(sizeof(pdu), pdu);
-            }
+                app_eaci_data_req_send(ATT_SVC_BATTERY_SERVICE, msg_id, param[1] << 8 | param[0],
+                                       (struct bd_addr const *)(param + 2));
             break;
 
         default:
@@ -258,13 +228,8 @@ void app_eaci_data_req_bass(uint8_t msg_id, uint8_t param_len, uint8_t const *pa
     {
         case EACI_MSG_DATA_REQ_BASS_BATT_LEVEL_UPD:
             if (param_len == BD_ADDR_LEN + 2)
-            {
-                uint8_t pdu[] = {EACI_MSG_TYPE_DATA_REQ, EACI_MSG_DATA_REQ_BASS_BATT_LEVEL_UPD, 10, 0x0f, 0x18, 0, 0, 0, 0, 0, 0, 0, 0};
-                pdu[5] = param[0];
-                pdu[6] = param[1];
-                app_eaci_set_bd_addr_by_param((pdu + 7), (param + 2));
-                eaci_uart_write(sizeof(pdu), pdu);
-            }
+                app_eaci_data_req_send(ATT_SVC_BATTERY_SERVICE, msg_id, param[0], param[1],
+                                       (struct bd_addr const *)(param + 2));
             break;
 
         default:
@@ -279,31 +244,24 @@ static void app_eaci_data_ind_basc(uint8_t msg_id, uint8_t param_len, uint8_t co
     switch (msg_id)
     {
         case EACI_MSG_DATA_IND_BATT_ENABLE:
-            if (param_len == 1)
-            {
-                QPRINTF("Battery enable confirmation status: 0x%X.\r\n", param[0]);
-            }
+            QPRINTF("Battery enable confirmation status: 0x%X.\r\n", param[0]);
             break;
 
         case EACI_MSG_DATA_IND_BATT_LEVEL:
-            if (param_len == 1)
-            {
-                QPRINTF("Battery Level: 0x%X.\r\n", param[0]);
-            }
+            QPRINTF("Battery Level: 0x%X.\r\n", param[0]);
             break;
 
         case EACI_MSG_DATA_IND_BATT_RD_CFG:
-            if (param_len == 2)
-            {
-                QPRINTF("Battery cfg.: 0x%04X.\r\n", param[1] << 8 | param[0]);
-            }
+        {
+            uint16_t ntf_cfg;
+
+            eaci_unpack(param, param_len, eaci_data_ind_layout(ATT_SVC_BATTERY_SERVICE, msg_id), &ntf_cfg);
+            QPRINTF("Battery cfg.: 0x%04X.\r\n", ntf_cfg);
+        }
             break;
 
         case EACI_MSG_DATA_IND_BATT_WR_RSP:
-            if (param_len == 1)
-            {
-                QPRINTF("Write Status: 0x%02X.\r\n", param[0]);
-            }
+            QPRINTF("Write Status: 0x%02X.\r\n", param[0]);
             break;
 
         default:
@@ -317,10 +275,7 @@ static void app_eaci_data_ind_bass(uint8_t msg_id, uint8_t param_len, uint8_t co
     switch (msg_id)
     {
         case EACI_MSG_DATA_IND_BASS_BATT_UPD_CFM:
-            if (param_len == 1)
-            {
-                QPRINTF("Battery Update status: 0x%X.\r\n", param[0]);
-            }
+            QPRINTF("Battery Update status: 0x%X.\r\n", param[0]);
             break;
 
         default:
@@ -1865,23 +1820,17 @@ void app_eaci_data_req_htpt(uint8_t msg_id, uint8_t param_len, uint8_t const *pa
         case EACI_MSG_DATA_REQ_HT_SEND_TEMP_VALUE:
             if (param_len == 2)
             {
-                uint8_t pdu[] = {EACI_MSG_TYPE_DATA_REQ, EACI_MSG_DATA_REQ_HT_SEND_TEMP_VALUE, 0x0F, 0x09, 0x18, 
-                                 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-                pdu[5] = param[0]; //Stable(0x01) intermediary(0x00)
-                pdu[6] = param[1]; //Flags 0x06(celsius) 0x07(fahrenheit)
-                pdu[7] = 0x03; // Type (Ear)
-                pdu[8] = 0x01;
-                pdu[9] = 0x02;
-                pdu[10] = 0x03;
-                pdu[11] = 0x04; //Temperature Measurement Value
-                pdu[12] = 0xDD; 
-                pdu[13] = 0x07; //Year
-                pdu[14] = 0x07; //Month
-                pdu[15] = 0x0a; //Day
-                pdu[16] = 0x06; //Hour
-                pdu[17] = 0x06; //Min
-                pdu[18] = 0x06; //Sec
-                eaci_uart_write(sizeof(pdu), pdu);
+                app_eaci_data_req_send(ATT_SVC_HEALTH_THERMOM, msg_id,
+                                       param[0],             //Stable(0x01) intermediary(0x00)
+                                       param[1],             //Flags 0x06(celsius) 0x07(fahrenheit)
+                                       0x03,                 //Type (Ear)
+                                       (uint32_t)0x04030201, //Temperature Measurement Value
+                                       0x07DD,               //Year
+                                       0x07,                 //Month
+                                       0x0a,                 //Day
+                                       0x06,                 //Hour
+                                       0x06,                 //Min
+                                       0x06);                //Sec
             }
             break;
 
@@ -1940,7 +1889,13 @@ static void app_eaci_data_ind_htpc(uint8_t msg_id, uint8_t param_len, uint8_t co
                     QPRINTF("Temperature Measurement Value (Celsius): 0x%02X.\r\n", (uint8_t)param[1]);
                 }
                 uint32_t temp = param[5] << 24 | param[4] << 16 | param[3] << 8 | param[2];
+                int32_t temp_x10;
                 QPRINTF("Temperature Measurement Value: 0x%08X.\r\n", temp);
+                if (ieee11073_float_decode(temp, -1, &temp_x10) == IEEE11073_VAL_NUMBER)
+                {
+                    QPRINTF("Temperature: %s%d.%d.\r\n", (temp_x10 < 0) ? "-" : "",
+                            ((temp_x10 < 0) ? -temp_x10 : temp_x10) / 10, ((temp_x10 < 0) ? -temp_x10 : temp_x10) % 10);
+                }
             }
             break;
 
@@ -2110,13 +2065,8 @@ void app_eaci_data_req_pasps(uint8_t msg_id, uint8_t param_len, uint8_t const *p
         {
             if (param_len == BD_ADDR_LEN + 2)
             {
-                uint8_t pdu[] = {EACI_MSG_TYPE_DATA_REQ, EACI_MSG_DATA_REQ_PASPS_UPDATE_VAL, 9, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-                pdu[3] = (uint8_t)(ATT_SVC_PHONE_ALERT_STATUS);
-                pdu[4] = (uint8_t)(ATT_SVC_PHONE_ALERT_STATUS >> 8);
-                pdu[5] = param[0];
-                pdu[6] = param[1];
-                app_eaci_set_bd_addr_by_param((pdu + 7), (param + 2));
-                eaci_uart_write(sizeof(pdu), pdu);
+                app_eaci_data_req_send(ATT_SVC_PHONE_ALERT_STATUS, msg_id, param[0], param[1],
+                                       (struct bd_addr const *)(param + 2));
             }
         }
             break;
@@ -2444,21 +2394,11 @@ void app_eaci_data_req_rscps(uint8_t msg_id, uint8_t param_len, uint8_t const *p
         {
             if (param_len == BD_ADDR_LEN + 10)
             {
-                uint8_t pdu[] = {EACI_MSG_TYPE_DATA_REQ, EACI_MSG_DATA_REQ_RSCPS_NTF_MEAS, 16, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-                pdu[3] = (uint8_t)(ATT_SVC_RUNNING_SPEED_CADENCE);
-                pdu[4] = (uint8_t)(ATT_SVC_RUNNING_SPEED_CADENCE >> 8);
-                pdu[5] = param[0];
-                pdu[6] = param[1];
-                pdu[7] = param[2];
-                pdu[8] = param[3];
-                pdu[9] = param[4];
-                pdu[10] = param[5];
-                pdu[11] = param[6];
-                pdu[12] = param[7];
-                pdu[13] = param[8];
-                pdu[14] = param[9];
-                app_eaci_set_bd_addr_by_param((pdu + 15), (param + 10));
-                eaci_uart_write(sizeof(pdu), pdu);
+                // flags, cadence, speed, stride length, total distance
+                app_eaci_data_req_send(ATT_SVC_RUNNING_SPEED_CADENCE, msg_id, param[0], param[1],
+                                       param[3] << 8 | param[2], param[5] << 8 | param[4],
+                                       (uint32_t)param[9] << 24 | (uint32_t)param[8] << 16 | param[7] << 8 | param[6],
+                                       (struct bd_addr const *)(param + 10));
             }
         }
             break;
@@ -2467,14 +2407,8 @@ void app_eaci_data_req_rscps(uint8_t msg_id, uint8_t param_len, uint8_t const *p
         {
             if (param_len == BD_ADDR_LEN + 3)
             {
-                uint8_t pdu[] = {EACI_MSG_TYPE_DATA_REQ, EACI_MSG_DATA_REQ_RSCPS_CTNL_PT, 9, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-                pdu[3] = (uint8_t)(ATT_SVC_RUNNING_SPEED_CADENCE);
-                pdu[4] = (uint8_t)(ATT_SVC_RUNNING_SPEED_CADENCE >> 8);
-                pdu[5] = param[0];
-                pdu[6] = param[1];
-                pdu[7] = param[2];
-                app_eaci_set_bd_addr_by_param((pdu + 8), (param + 3));
-                eaci_uart_write(sizeof(pdu), pdu);
+                app_eaci_data_req_send(ATT_SVC_RUNNING_SPEED_CADENCE, msg_id, param[0],
+                                       param[2] << 8 | param[1], (struct bd_addr const *)(param + 3));
             }
         }
             break;
@@ -2870,11 +2804,16 @@ void app_eaci_data_ind(uint8_t msg_id, uint8_t param_len, uint8_t const *param)
     }
 
     uint16_t uuid = param[1] << 8 | param[0];
+
+    // Parameters are checked against the schema once, handlers can trust the length
+    if (!eaci_layout_check(eaci_data_ind_layout(uuid, msg_id), param_len - EACI_DATA_UUID_LEN))
+        return;
+
     switch (uuid)
     {
 #if (BLE_AN_CLIENT || BLE_AN_SERVER)
         case ATT_SVC_ALERT_NTF:
-            if (msg_id < EACI_MSG_DATA_IND_ANPC_MAX || msg_id == EACI_MSG_TYPE_DATA_ERROR)
+            if (msg_id < EACI_MSG_DATA_IND_ANPC_MAX)
             {
             #if BLE_AN_CLIENT
                 app_eaci_data_ind_anpc(msg_id, param_len-2, param+2);
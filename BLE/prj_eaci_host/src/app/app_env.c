@@ -35,6 +35,7 @@ struct app_env_tag app_env;
 static void app_env_init(void)
 {
     memset(&app_env, 0, sizeof(app_env));
+    eaci_msg_que_init(&app_env.msg_que);
     for (uint8_t idx = 0; idx < BLE_CONNECTION_MAX; idx++)
     {
         app_env.dev_rec[idx].free = true;
@@ -34,7 +34,9 @@
 #include "gatt_task.h"
 #include "fw_func_addr.h"
 #include "gap.h"
+#if (!defined(CFG_EACI_POSIX))
 #include "intc.h"
+#endif
 
 #include "app_sys.h"
 #include "app_util.h"
@@ -151,6 +153,9 @@
 
 #include "eaci.h"
 #include "eaci_uart.h"
+#if (defined(CFG_EACI_POSIX))
+#include "eaci_posix.h"
+#endif
 
 /*
  * GLOBAL VARIABLE DECLARATIONS
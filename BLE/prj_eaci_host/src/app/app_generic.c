@@ -19,6 +19,26 @@
  */
 #include "app_env.h"
 
+/**
+ ****************************************************************************************
+ * @brief Pack an EACI command with its schema layout and send it
+ *
+ ****************************************************************************************
+ */
+static void app_eaci_cmd_send(uint8_t cmd_id, ...)
+{
+    uint8_t pdu[EACI_PDU_MAX_LEN];
+    uint16_t len;
+    va_list ap;
+
+    va_start(ap, cmd_id);
+    len = eaci_vpack(pdu, EACI_MSG_TYPE_CMD, cmd_id, eaci_cmd_layout[cmd_id], ap);
+    va_end(ap);
+
+    if (len != 0)
+        eaci_uart_write(len, pdu);
+}
+
 /**
  ****************************************************************************************
  * @brief Adversting command
@@ -27,13 +47,7 @@
  */
 void app_eaci_cmd_adv(uint8_t const start, uint16_t adv_intv_min, uint16_t adv_intv_max)
 {
-    uint8_t pdu[] = {EACI_MSG_TYPE_CMD, EACI_MSG_CMD_ADV, 5, 0, 0, 0, 0, 0};
-    pdu[3] = start;
-    pdu[4] = (uint8_t)(adv_intv_min & 0xff);
-    pdu[5] = (uint8_t)(adv_intv_min >> 8 & 0xff);
-    pdu[6] = (uint8_t)(adv_intv_max & 0xff);
-    pdu[7] = (uint8_t)(adv_intv_max >> 8 & 0xff);
-    eaci_uart_write(sizeof(pdu), pdu);
+    app_eaci_cmd_send(EACI_MSG_CMD_ADV, start, adv_intv_min, adv_intv_max);
 }
 
 /**
@@ -44,9 +58,7 @@ void app_eaci_cmd_adv(uint8_t const start, uint16_t adv_intv_min, uint16_t adv_i
  */
 void app_eaci_cmd_scan(uint8_t const start)
 {
-    uint8_t pdu[] = {EACI_MSG_TYPE_CMD, EACI_MSG_CMD_SCAN, 1, 0};
-    pdu[3] = start;
-    eaci_uart_write(sizeof(pdu), pdu);
+    app_eaci_cmd_send(EACI_MSG_CMD_SCAN, start);
 
     if (start == 1)
         app_env.inq_id = 0;
@@ -61,17 +73,7 @@ void app_eaci_cmd_scan(uint8_t const start)
 void app_eaci_cmd_conn(uint8_t type, struct bd_addr *addr, uint16_t conn_intv_min,
                        uint16_t conn_intv_max, uint16_t cnnn_timeout)
 {
-    uint8_t pdu[] = {EACI_MSG_TYPE_CMD, EACI_MSG_CMD_CONN, 13, 0, 0, 0, 0, 0, 0, 0, 
-                        0, 0, 0, 0, 0, 0};
-    pdu[3] = type;
-    pdu[4] = (uint8_t)(conn_intv_min & 0xff);
-    pdu[5] = (uint8_t)(conn_intv_min >> 8 & 0xff);
-    pdu[6] = (uint8_t)(conn_intv_max & 0xff);
-    pdu[7] = (uint8_t)(conn_intv_max >> 8 & 0xff);
-    pdu[8] = (uint8_t)(cnnn_timeout & 0xff);
-    pdu[9] = (uint8_t)(cnnn_timeout >> 8 & 0xff);
-    app_eaci_set_bd_addr_by_param(pdu+10, (const uint8_t *)addr);
-    eaci_uart_write(sizeof(pdu), pdu);
+    app_eaci_cmd_send(EACI_MSG_CMD_CONN, type, conn_intv_min, conn_intv_max, cnnn_timeout, addr);
 }
 
 /**
@@ -82,9 +84,7 @@ void app_eaci_cmd_conn(uint8_t type, struct bd_addr *addr, uint16_t conn_intv_mi
  */
 void app_eaci_cmd_disc(struct bd_addr *addr)
 {
-    uint8_t pdu[] = {EACI_MSG_TYPE_CMD, EACI_MSG_CMD_DISC, 6, 0, 0, 0, 0, 0, 0};
-    app_eaci_set_bd_addr_by_param(pdu+3, (const uint8_t *)addr);
-    eaci_uart_write(sizeof(pdu), pdu);
+    app_eaci_cmd_send(EACI_MSG_CMD_DISC, addr);
 }
 
 /**
@@ -95,30 +95,12 @@ void app_eaci_cmd_disc(struct bd_addr *addr)
  */
 void app_eaci_set_dev_name_cmd(uint8_t val_len, uint8_t *dev_name)
 {
-    uint8_t *pdu;
-    pdu = (uint8_t *)malloc(3 + val_len);
-    if (pdu != NULL)
-    {
-        memset(pdu, 0, 3 + val_len);
-        pdu[0] = EACI_MSG_TYPE_CMD;
-        pdu[1] = EACI_MSG_CMD_SET_DEVNAME;
-        pdu[2] = val_len;
-    
-        for (int i = 0; i< val_len; i++)
-        {
-            pdu[3 + i] = dev_name[i];
-            QPRINTF(" %d ", dev_name[i]);
-        }
-        QPRINTF("\r\n");
-        eaci_uart_write((3 + val_len), pdu);
-        
-        free(pdu);
-        pdu = NULL;
-    }
-    else
+    for (int i = 0; i< val_len; i++)
     {
-        QPRINTF("Insufficient memory available\r\n");
+        QPRINTF(" %d ", dev_name[i]);
     }
+    QPRINTF("\r\n");
+    app_eaci_cmd_send(EACI_MSG_CMD_SET_DEVNAME, val_len, dev_name);
 }
 
 /**
@@ -129,29 +111,10 @@ void app_eaci_set_dev_name_cmd(uint8_t val_len, uint8_t *dev_name)
  */
 void app_eaci_cen_update_param_cmd(struct bd_addr *addr)
 {
-    uint8_t pdu[19];
-    pdu[0] = EACI_MSG_TYPE_CMD;
-    pdu[1] = EACI_MSG_CMD_CEN_UPDATE_PARAM;
-    pdu[2] = 16;
     // 0x0000: accept 0x0001: reject
-    pdu[3] = 0x00;
-    pdu[4] = 0x00; 
-    // Connection interval minimum
-    pdu[5] = (uint8_t)GAP_INIT_CONN_MIN_INTV;
-    pdu[6] = (uint8_t)((GAP_INIT_CONN_MIN_INTV >> 8) & 0xff);
-    // Connection interval maximum
-    pdu[7] = (uint8_t)GAP_INIT_CONN_MAX_INTV;
-    pdu[8] = (uint8_t)((GAP_INIT_CONN_MAX_INTV >> 8) & 0xff);
-    // Latency
-    pdu[9] = (uint8_t)GAP_CONN_LATENCY;
-    pdu[10] = (uint8_t)((GAP_CONN_LATENCY >> 8) & 0xff);
-    // Supervision timeout
-    pdu[11] = (uint8_t)GAP_CONN_SUPERV_TIMEOUT;
-    pdu[12] = (uint8_t)((GAP_CONN_SUPERV_TIMEOUT >> 8) & 0xff);
-
-    app_eaci_set_bd_addr_by_param(pdu+13, (const uint8_t *)addr);
-
-    eaci_uart_write(sizeof(pdu), pdu);
+    app_eaci_cmd_send(EACI_MSG_CMD_CEN_UPDATE_PARAM, 0x0000,
+                      GAP_INIT_CONN_MIN_INTV, GAP_INIT_CONN_MAX_INTV,
+                      GAP_CONN_LATENCY, GAP_CONN_SUPERV_TIMEOUT, addr);
 }
 
 /**
@@ -162,22 +125,9 @@ void app_eaci_cen_update_param_cmd(struct bd_addr *addr)
  */
 void app_eaci_slave_update_param_cmd(void)
 {
-    //uint8_t pdu[]= {EACI_MSG_TYPE_CMD,EACI_MSG_CMD_PER_UPDATE_PARAM,0x08,0x18,0x00,0x28,0x00,0x00,0x00,0xd0,0x07};
-    uint8_t pdu[]= {EACI_MSG_TYPE_CMD,EACI_MSG_CMD_PER_UPDATE_PARAM,0x08,0,0,0,0,0,0,0,0};
-    // Connection interval minimum
-    pdu[3] = (uint8_t)GAP_INIT_CONN_MIN_INTV;
-    pdu[4] = (uint8_t)((GAP_INIT_CONN_MIN_INTV >> 8) & 0xff);
-    // Connection interval maximum
-    pdu[5] = (uint8_t)GAP_INIT_CONN_MAX_INTV;
-    pdu[6] = (uint8_t)((GAP_INIT_CONN_MAX_INTV >> 8) & 0xff);
-    // Latency
-    pdu[7] = (uint8_t)GAP_CONN_LATENCY;
-    pdu[8] = (uint8_t)((GAP_CONN_LATENCY >> 8) & 0xff);
-    // Supervision timeout
-    pdu[9] = (uint8_t)GAP_CONN_SUPERV_TIMEOUT;
-    pdu[10] = (uint8_t)((GAP_CONN_SUPERV_TIMEOUT >> 8) & 0xff);
-
-    eaci_uart_write(sizeof(pdu), pdu);
+    app_eaci_cmd_send(EACI_MSG_CMD_PER_UPDATE_PARAM,
+                      GAP_INIT_CONN_MIN_INTV, GAP_INIT_CONN_MAX_INTV,
+                      GAP_CONN_LATENCY, GAP_CONN_SUPERV_TIMEOUT);
 }
 
 /**
@@ -188,9 +138,51 @@ void app_eaci_slave_update_param_cmd(void)
  */
 void app_eaci_cmd_bond(struct bd_addr *addr)
 {
-    uint8_t pdu[] = {EACI_MSG_TYPE_CMD, EACI_MSG_CMD_BOND, 6, 0, 0, 0, 0, 0, 0};
-    app_eaci_set_bd_addr_by_param(pdu+3, (const uint8_t *)addr);
-    eaci_uart_write(sizeof(pdu), pdu);
+    app_eaci_cmd_send(EACI_MSG_CMD_BOND, addr);
+}
+
+/**
+ ****************************************************************************************
+ * @brief BLE heap statistics command
+ *
+ ****************************************************************************************
+ */
+void app_eaci_cmd_heap_stat(void)
+{
+    app_eaci_cmd_send(EACI_MSG_CMD_HEAP_STAT);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Sleep profile command
+ *
+ ****************************************************************************************
+ */
+void app_eaci_cmd_sleep_stat(uint8_t reset)
+{
+    app_eaci_cmd_send(EACI_MSG_CMD_SLEEP_STAT, reset);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Handler profile command
+ *
+ ****************************************************************************************
+ */
+void app_eaci_cmd_task_prof(uint8_t reset)
+{
+    app_eaci_cmd_send(EACI_MSG_CMD_TASK_PROF, reset);
+}
+
+/**
+ ****************************************************************************************
+ * @brief BLE heap trace command
+ *
+ ****************************************************************************************
+ */
+void app_eaci_cmd_heap_trace(void)
+{
+    app_eaci_cmd_send(EACI_MSG_CMD_HEAP_TRACE);
 }
 
 /**
@@ -201,39 +193,46 @@ void app_eaci_cmd_bond(struct bd_addr *addr)
  */
 void app_eaci_evt(uint8_t msg_id, uint8_t param_len, uint8_t const *param)
 {
+    uint8_t status;
+    struct bd_addr peer_addr;
+
+    // Parameters are checked against the schema once for all the events
+    if (msg_id >= EACI_MSG_EVT_MAX || !eaci_layout_check(eaci_evt_layout[msg_id], param_len))
+        return;
+
     switch (msg_id)
     {
         case EACI_MSG_EVT_ADV:
-            if (param_len == 1)
-            {
-                // Adverstising
-                if (param[0] == 1)
-                    QPRINTF("Adverstising started.\r\n");
-                else
-                    QPRINTF("Adverstising stopped.\r\n");
-            }
+            // Adverstising
+            if (param[0] == 1)
+                QPRINTF("Adverstising started.\r\n");
+            else
+                QPRINTF("Adverstising stopped.\r\n");
             break;
 
         case EACI_MSG_EVT_INQ_RESULT:
-            if (param_len >= 7)
             {
+                uint8_t name_len;
+                uint8_t const *name;
+                struct app_inq_dev_record *rec = &app_env.inq_addr[app_env.inq_id];
+
                 // Scan result
-                app_env.inq_addr[app_env.inq_id].addr_type = param[0];
-                app_eaci_get_bd_addr_by_param(&app_env.inq_addr[app_env.inq_id].addr, param+1);
+                eaci_unpack(param, param_len, eaci_evt_layout[msg_id],
+                            &rec->addr_type, &rec->addr, &name_len, &name);
                 QPRINTF("%d. %c %02X%02X:%02X:%02X%02X%02X ",
                     app_env.inq_id, 
-                    app_env.inq_addr[app_env.inq_id].addr_type ? 'R' : 'P', 
-                    app_env.inq_addr[app_env.inq_id].addr.addr[5],
-                    app_env.inq_addr[app_env.inq_id].addr.addr[4],
-                    app_env.inq_addr[app_env.inq_id].addr.addr[3],
-                    app_env.inq_addr[app_env.inq_id].addr.addr[2],
-                    app_env.inq_addr[app_env.inq_id].addr.addr[1],
-                    app_env.inq_addr[app_env.inq_id].addr.addr[0]);
-
-                if (param_len > 7)
+                    rec->addr_type ? 'R' : 'P', 
+                    rec->addr.addr[5],
+                    rec->addr.addr[4],
+                    rec->addr.addr[3],
+                    rec->addr.addr[2],
+                    rec->addr.addr[1],
+                    rec->addr.addr[0]);
+
+                if (name_len != 0)
                 {
-                    for (uint8_t i = 0; i < param_len - 7; i++)
-                        QPRINTF("%c", param[7+i]);
+                    for (uint8_t i = 0; i < name_len; i++)
+                        QPRINTF("%c", name[i]);
                     QPRINTF("\r\n");
                 }
                 else
@@ -245,40 +244,30 @@ void app_eaci_evt(uint8_t msg_id, uint8_t param_len, uint8_t const *param)
             break;
 
         case EACI_MSG_EVT_INQ_CMP:
-            if (param_len == 1)
-            {
-                // Scan completed
-                QPRINTF("Total %d devices found.\r\n", param[0]);
-            }
+            // Scan completed
+            QPRINTF("Total %d devices found.\r\n", param[0]);
             break;
 
         case EACI_MSG_EVT_CONN:
-            if (param_len == 7)
+            eaci_unpack(param, param_len, eaci_evt_layout[msg_id], &status, &peer_addr);
+            // Connection completed
+            if (status == 0)
             {
-                struct bd_addr peer_addr;
-                app_eaci_get_bd_addr_by_param(&peer_addr, param+1);
-                // Connection completed
-                if (param[0] == 0)
-                {
-                    app_eaci_set_link_status(true, &peer_addr);
-                }
-                QPRINTF("Connection with %02X%02X:%02X:%02X%02X%02X result is 0x%x.\r\n", 
-                    peer_addr.addr[5],
-                    peer_addr.addr[4],
-                    peer_addr.addr[3],
-                    peer_addr.addr[2],
-                    peer_addr.addr[1],
-                    peer_addr.addr[0],
-                    param[0]);
+                app_eaci_set_link_status(true, &peer_addr);
             }
+            QPRINTF("Connection with %02X%02X:%02X:%02X%02X%02X result is 0x%x.\r\n", 
+                peer_addr.addr[5],
+                peer_addr.addr[4],
+                peer_addr.addr[3],
+                peer_addr.addr[2],
+                peer_addr.addr[1],
+                peer_addr.addr[0],
+                status);
             break;
 
         case EACI_MSG_EVT_DISC:
-            if (param_len == 7)
-            {
             // Connection disconnected
-            struct bd_addr peer_addr;
-            app_eaci_get_bd_addr_by_param(&peer_addr, param+1);
+            eaci_unpack(param, param_len, eaci_evt_layout[msg_id], &status, &peer_addr);
             app_eaci_set_link_status(false, &peer_addr); 
             QPRINTF("Disconnect with %02X%02X:%02X:%02X%02X%02X reason is 0x%x.\r\n", 
                     peer_addr.addr[5],
@@ -287,16 +276,15 @@ void app_eaci_evt(uint8_t msg_id, uint8_t param_len, uint8_t const *param)
                     peer_addr.addr[2],
                     peer_addr.addr[1],
                     peer_addr.addr[0],
-                    param[0]);
-            }
+                    status);
             break;
 
         case EACI_MSG_EVT_BOND:
-            if (param_len == 8)
             {
+                uint8_t bonded;
+
                 // Bond completed
-                struct bd_addr peer_addr;
-                app_eaci_get_bd_addr_by_param(&peer_addr, param+2);
+                eaci_unpack(param, param_len, eaci_evt_layout[msg_id], &status, &bonded, &peer_addr);
                 QPRINTF("Bond complete with %02X%02X:%02X:%02X%02X%02X, bonded: %01X, status: 0x%02X.\r\n", 
                         peer_addr.addr[5],
                         peer_addr.addr[4],
@@ -304,52 +292,110 @@ void app_eaci_evt(uint8_t msg_id, uint8_t param_len, uint8_t const *param)
                         peer_addr.addr[2],
                         peer_addr.addr[1],
                         peer_addr.addr[0],
-                        param[1],
-                        param[0]);
+                        bonded,
+                        status);
             }
             break;
 
         case EACI_MSG_EVT_CEN_UPDATE_PARAM:
-            if (param_len == 1)
+            // Update Param
+            if (param[0] == 0)
+                QPRINTF("Master update parameter complete.\r\n");
+            else
+                QPRINTF("Master update parameter failed.\r\n");
+            break;
+
+        case EACI_MSG_EVT_SMP_SEC:
+            if (param[0] == 0)
+                QPRINTF("SMPC Security complete.\r\n");
+            else
+                QPRINTF("SMPC Security failed.\r\n");
+            break;
+
+        case EACI_MSG_EVT_SET_DEVNAME:
+            if (param[0] == 0)
+                QPRINTF("Set Device Name complete.\r\n");
+            else
+                QPRINTF("Set Device Name failed.\r\n");
+            break;
+
+        case EACI_MSG_EVT_UPDATE_PARAM:
+            if (param[0] == 0)
+                QPRINTF("Slave update success.\r\n");
+            else
+                QPRINTF("Slave update failed.\r\n");
+            break;
+
+        case EACI_MSG_EVT_HEAP_STAT:
             {
-                // Update Param
-                if (param[0] == 0)
-                    QPRINTF("Master update parameter complete.\r\n");
-                else
-                    QPRINTF("Master update parameter failed.\r\n");
+                uint16_t size, avail, largest, peak;
+                uint8_t frag;
+
+                eaci_unpack(param, param_len, eaci_evt_layout[msg_id], &size, &avail, &largest, &peak, &frag);
+                QPRINTF("Heap size %d, free %d, largest %d, peak %d, fragmentation %d%%.\r\n",
+                        size, avail, largest, peak, frag);
             }
             break;
 
-        case EACI_MSG_EVT_SMP_SEC:
-            if (param_len == 1)
+        case EACI_MSG_EVT_SLEEP_STAT:
             {
-                // Update Param
-                if (param[0] == 0)
-                    QPRINTF("SMPC Security complete.\r\n");
-                else
-                    QPRINTF("SMPC Security failed.\r\n");
+                static const char * const table_name[] = {"Power mode", "Blocked by", "Wakeup by", "Devices"};
+                uint8_t table, idx;
+                uint32_t count, time;
+
+                eaci_unpack(param, param_len, eaci_evt_layout[msg_id], &table, &idx, &count, &time);
+                if (table <= EACI_SLEEP_STAT_DEV)
+                    QPRINTF("%s %d: count %lu, time %lu ms.\r\n", table_name[table], idx,
+                            (unsigned long)count, (unsigned long)time * 10);
             }
             break;
 
-        case EACI_MSG_EVT_SET_DEVNAME:
-            if (param_len == 1)
+        case EACI_MSG_EVT_TASK_PROF:
             {
-                // Update Param
-                if (param[0] == 0)
-                    QPRINTF("Set Device Name complete.\r\n");
-                else
-                    QPRINTF("Set Device Name failed.\r\n");
+                static const char * const table_name[] = {"Scheduler", "Event", "Message", "Queue"};
+                uint8_t table, task;
+                uint16_t id;
+                uint32_t count, max, total;
+
+                eaci_unpack(param, param_len, eaci_evt_layout[msg_id], &table, &task, &id, &count, &max, &total);
+                if (table <= EACI_TASK_PROF_QUEUE)
+                    QPRINTF("%s %d 0x%x: count %lu, max %lu, total %lu.\r\n", table_name[table], task, id,
+                            (unsigned long)count, (unsigned long)max, (unsigned long)total);
             }
             break;
 
-        case EACI_MSG_EVT_UPDATE_PARAM:
-            if (param_len == 1)
+        case EACI_MSG_EVT_HEAP_TRACE:
             {
-                // Update Param
-                if (param[0] == 0)
-                    QPRINTF("Slave update success.\r\n");
-                else
-                    QPRINTF("Slave update failed.\r\n");
+                uint8_t table;
+                uint16_t id, size;
+                uint32_t count, total;
+
+                eaci_unpack(param, param_len, eaci_evt_layout[msg_id], &table, &id, &size, &count, &total);
+                switch (table)
+                {
+                    case EACI_HEAP_TRACE_APP:
+                        QPRINTF("Application heap: held %d, peak %d, alloc %lu, free %lu.\r\n", id, size,
+                                (unsigned long)count, (unsigned long)total);
+                        break;
+                    case EACI_HEAP_TRACE_ADVICE:
+                        QPRINTF("Advised heap size %d, largest request %d, failed %lu%s.\r\n", id, size,
+                                (unsigned long)count, total ? ", heap was full" : "");
+                        break;
+                    case EACI_HEAP_TRACE_MSG:
+                        QPRINTF("Message 0x%x: count %lu, bytes %lu, max %d.\r\n", id,
+                                (unsigned long)count, (unsigned long)total, size);
+                        break;
+                    case EACI_HEAP_TRACE_BLK:
+                        QPRINTF("Held 0x%x: size %d, caller 0x%lx, age %lu.\r\n", id, size,
+                                (unsigned long)count, (unsigned long)total);
+                        break;
+                    case EACI_HEAP_TRACE_LOST:
+                        QPRINTF("Not traced: messages %lu, blocks %lu.\r\n",
+                                (unsigned long)count, (unsigned long)total);
+                        break;
+                    default:
+                        break;
+                }
             }
             break;
 
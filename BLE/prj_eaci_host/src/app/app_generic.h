@@ -17,63 +17,12 @@
 #define _APP_GENERIC_H_
 
 /*
- * TYPE DEFINITIONS
+ * INCLUDE FILES
  ****************************************************************************************
  */
 
-///EACI Command
-enum
-{
-    ///Reserved
-    EACI_MSG_CMD_RSV = 0x0,
-    ///Advertising
-    EACI_MSG_CMD_ADV,
-    ///Scan
-    EACI_MSG_CMD_SCAN,
-    ///Connect
-    EACI_MSG_CMD_CONN,
-    ///Central Disconnect
-    EACI_MSG_CMD_DISC,
-    ///Set Device Name
-    EACI_MSG_CMD_SET_DEVNAME,
-    ///Bond
-    EACI_MSG_CMD_BOND,
-    ///Central Update Param
-    EACI_MSG_CMD_CEN_UPDATE_PARAM,
-    ///Peripheral Update Param
-    EACI_MSG_CMD_PER_UPDATE_PARAM,
-    ///Number of Command
-    EACI_MSG_CMD_MAX
-};
-
-///EACI Event
-enum
-{
-    ///Reserved
-    EACI_MSG_EVT_RSV = 0x0,
-    ///Advertising Status
-    EACI_MSG_EVT_ADV,
-    ///Scan result
-    EACI_MSG_EVT_INQ_RESULT,
-    ///Scan complete
-    EACI_MSG_EVT_INQ_CMP,
-    ///Connect Status
-    EACI_MSG_EVT_CONN,
-    ///Disconnect Status
-    EACI_MSG_EVT_DISC,
-    ///Device Name
-    EACI_MSG_EVT_SET_DEVNAME,
-    ///Bond Status
-    EACI_MSG_EVT_BOND,
-    ///Central Update param State
-    EACI_MSG_EVT_CEN_UPDATE_PARAM,
-    ///SMPC Security started indication to host
-    EACI_MSG_EVT_SMP_SEC,
-    ///Peripheral Update param
-    EACI_MSG_EVT_UPDATE_PARAM,
-    ///Number of Event
-    EACI_MSG_EVT_MAX
-};
+///EACI Command and Event ids come from the shared schema, see eaci_schema.h
+#include "eaci_codec.h"
 
 /*
  ****************************************************************************************
@@ -147,4 +96,36 @@ void app_eaci_evt(uint8_t msg_id, uint8_t param_len, uint8_t const *param);
  ****************************************************************************************
  */
 void app_eaci_slave_update_param_cmd(void);
+
+/*
+ ****************************************************************************************
+ * @brief BLE heap statistics command
+ *
+ ****************************************************************************************
+ */
+void app_eaci_cmd_heap_stat(void);
+
+/*
+ ****************************************************************************************
+ * @brief Sleep profile command, the profile is cleared when reset is not 0
+ *
+ ****************************************************************************************
+ */
+void app_eaci_cmd_sleep_stat(uint8_t reset);
+
+/*
+ ****************************************************************************************
+ * @brief Handler profile command, the profile is cleared when reset is not 0
+ *
+ ****************************************************************************************
+ */
+void app_eaci_cmd_task_prof(uint8_t reset);
+
+/*
+ ****************************************************************************************
+ * @brief BLE heap trace command
+ *
+ ****************************************************************************************
+ */
+void app_eaci_cmd_heap_trace(void);
 #endif // APP_MSG_H_
@@ -663,7 +663,7 @@ static void app_menu_handler_anps(void)
             new_alert[2] = CAT_ID_NEWS;//Category ID
             new_alert[3] = 0x03;//Number of alerts
             new_alert[4] = 0x31;//Text String Information
-            app_eaci_data_req_anps(EACI_MSG_DATA_REQ_ANPS_NTF_ALERT, 5, new_alert);
+            app_eaci_data_req_anps(EACI_MSG_DATA_REQ_ANPS_NTF_NEW_ALERT, 5, new_alert);
         }
             break;
         case '2':
@@ -672,7 +672,7 @@ static void app_menu_handler_anps(void)
             unnew_alert[0] = ANPS_UPD_UNREAD_ALERT_STATUS_OP_CODE;//Update Unread Alert Status Char. value  
             unnew_alert[1] = CAT_ID_MISSED_CALL;//Category ID
             unnew_alert[2] = 0x06;//Number of alerts
-            app_eaci_data_req_anps(EACI_MSG_DATA_REQ_ANPS_NTF_ALERT, 3, unnew_alert);
+            app_eaci_data_req_anps(EACI_MSG_DATA_REQ_ANPS_NTF_NEW_ALERT, 3, unnew_alert);
         }
             break;
         case 'r':
@@ -20,6 +20,17 @@
  ****************************************************************************************
  */
 
+/**
+ ****************************************************************************************
+ * @brief Initialize the queue.
+ *
+ ****************************************************************************************
+ */
+void eaci_msg_que_init(struct eaci_msg_que *que)
+{
+    ring_init(&que->ring, que->buf, EACI_MSG_QUE_SIZE);
+}
+
 /**
  ****************************************************************************************
  * @brief Check if the queue is empty.
@@ -28,45 +39,63 @@
  */
 bool eaci_msg_que_is_empty(const struct eaci_msg_que *const que)
 {
-    return (que->first == NULL);
+    return (ring_count(&que->ring) == 0);
 }
 
-/*
+/**
  ****************************************************************************************
- * @brief Push one element as last in the queue.
+ * @brief Copy one PDU as last in the queue, may be called from an interrupt.
  *
  ****************************************************************************************
  */
-void eaci_msg_que_push(struct eaci_msg_que *que, void *que_elm)
+bool eaci_msg_que_push(struct eaci_msg_que *que, uint16_t len, uint8_t const *pdu)
 {
-    if (eaci_msg_que_is_empty(que))
-    {
-        que->first = que_elm;
-    }
-    else
-    {
-        que->last->next = que_elm;
-    }
+    uint8_t hdr[EACI_MSG_QUE_HDR_LEN];
 
-    que->last = que_elm;
-    ((struct eaci_msg_que_elm *)que_elm)->next = NULL;
+    if (ring_space(&que->ring) < EACI_MSG_QUE_HDR_LEN + len)
+        return false;
+
+    hdr[0] = len & 0xFF;
+    hdr[1] = len >> 8;
+    ring_fill(&que->ring, 0, hdr, EACI_MSG_QUE_HDR_LEN);
+    ring_fill(&que->ring, EACI_MSG_QUE_HDR_LEN, pdu, len);
+    // The consumer sees the whole PDU or nothing
+    ring_commit(&que->ring, EACI_MSG_QUE_HDR_LEN + len);
+
+    return true;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Length of the first PDU of the queue, 0 if the queue is empty.
+ *
+ ****************************************************************************************
+ */
+uint16_t eaci_msg_que_pick(const struct eaci_msg_que *que)
+{
+    uint8_t hdr[EACI_MSG_QUE_HDR_LEN];
+
+    if (!ring_peek(&que->ring, 0, hdr, EACI_MSG_QUE_HDR_LEN))
+        return 0;
+
+    return hdr[0] | (hdr[1] << 8);
 }
 
 /**
  ****************************************************************************************
- * @brief Pop the first one element from the queue.
- * 
+ * @brief Copy out and release the first PDU of the queue.
+ *
  ****************************************************************************************
  */
-void *eaci_msg_que_pop(struct eaci_msg_que *que)
+uint16_t eaci_msg_que_pop(struct eaci_msg_que *que, uint8_t *pdu)
 {
-    struct eaci_msg_que_elm *elm;
+    uint16_t len = eaci_msg_que_pick(que);
 
-    elm = que->first;
-    if (elm != NULL)
+    if (len != 0)
     {
-        que->first = que->first->next;
+        ring_peek(&que->ring, EACI_MSG_QUE_HDR_LEN, pdu, len);
+        ring_skip(&que->ring, EACI_MSG_QUE_HDR_LEN + len);
     }
-    
-    return elm;
+
+    return len;
 }
@@ -17,23 +17,36 @@
 #define _APP_MSG_H_
 
 /*
- * GLOBAL VARIABLE DECLARATIONS
+ * INCLUDE FILES
  ****************************************************************************************
  */
+#include "ring.h"
 
-/// structure of a queue element
-struct eaci_msg_que_elm
-{
-    struct eaci_msg_que_elm *next;
-};
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// Size of a message queue, a power of 2 holding at least one PDU of the longest payload
+#ifndef EACI_MSG_QUE_SIZE
+#define EACI_MSG_QUE_SIZE   1024
+#endif
+
+/// Length prefix of a PDU stored in a message queue
+#define EACI_MSG_QUE_HDR_LEN    2
+
+/*
+ * GLOBAL VARIABLE DECLARATIONS
+ ****************************************************************************************
+ */
 
-/// structure of a queue
+/// structure of a queue, PDUs are copied in with their length, one producer and one consumer
 struct eaci_msg_que
 {
-    /// pointer to first element
-    struct eaci_msg_que_elm *first;
-    /// pointer to the last element
-    struct eaci_msg_que_elm *last;
+    /// ring of length prefixed PDUs
+    struct ring ring;
+    /// storage of the ring
+    uint8_t buf[EACI_MSG_QUE_SIZE];
 };
 
 /*
@@ -43,43 +56,47 @@ struct eaci_msg_que
 
 /*
  ****************************************************************************************
- * @brief Check if the queue is empty.
+ * @brief Initialize the queue.
  *
  ****************************************************************************************
  */
-bool eaci_msg_que_is_empty(const struct eaci_msg_que *const que);
+void eaci_msg_que_init(struct eaci_msg_que *que);
 
 /*
  ****************************************************************************************
- * @brief Push one element as last in the queue.
+ * @brief Check if the queue is empty.
  *
  ****************************************************************************************
  */
-void eaci_msg_que_push(struct eaci_msg_que *que, void *msg);
+bool eaci_msg_que_is_empty(const struct eaci_msg_que *const que);
 
 /*
  ****************************************************************************************
- * @brief Pop the first one element from the queue.
- * 
+ * @brief Copy one PDU as last in the queue, may be called from an interrupt.
+ *
+ * @return false if the queue is full, nothing is pushed then.
  ****************************************************************************************
  */
-void *eaci_msg_que_pop(struct eaci_msg_que *que);
+bool eaci_msg_que_push(struct eaci_msg_que *que, uint16_t len, uint8_t const *pdu);
 
 /*
  ****************************************************************************************
- * @brief Malloc one EACI message.
+ * @brief Length of the first PDU of the queue, 0 if the queue is empty.
  *
  ****************************************************************************************
  */
-inline void *MSG_MALLOC(uint32_t size)  { return malloc(size); }
+uint16_t eaci_msg_que_pick(const struct eaci_msg_que *que);
 
 /*
  ****************************************************************************************
- * @brief Free one EACI message.
+ * @brief Copy out and release the first PDU of the queue.
+ *
+ * @param[out] pdu  Buffer of at least eaci_msg_que_pick() bytes
  *
+ * @return Length of the PDU, 0 if the queue is empty.
  ****************************************************************************************
  */
-inline void MSG_FREE(void * mem_ptr)    { free(mem_ptr); }
+uint16_t eaci_msg_que_pop(struct eaci_msg_que *que, uint8_t *pdu);
 
 #endif
 
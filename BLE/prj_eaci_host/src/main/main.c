@@ -151,8 +151,7 @@ void EINT3_IRQHandler(void)
 {
     #if defined(CFG_HCI_SPI)
         LPC_GPIOINT->IO0IntClr |= (1<<03);
-        if (eaci_env.rx_state == EACI_STATE_RX_START)
-        spi_read(QN_HCI_SPI, &eaci_env.msg_type, 1, eaci_uart_rx_done);
+        eaci_lpc_spi_rx_req();
     #endif
 }
 
@@ -185,6 +184,8 @@ static void AppInit(void)
  */
 static void AppSchedule(void)
 {
+    uint8_t pdu[EACI_PDU_MAX_LEN];
+
     while (1)
     {
         // Check debug uart input
@@ -195,16 +196,9 @@ static void AppSchedule(void)
         }
 
         // Check aci uart input
-        if (false == eaci_msg_que_is_empty(&app_env.msg_que))
+        if (eaci_msg_que_pop(&app_env.msg_que, pdu) != 0)
         {
-            struct eaci_msg *msg = (struct eaci_msg *)eaci_msg_que_pop(&app_env.msg_que);
-            if (msg)
-            {
-                app_eaci_msg_hdl(msg->msg_type, msg->msg_id, msg->param_len, msg->param);
-#ifndef MSG_BUFFER_EN
-                MSG_FREE(msg);
-#endif                
-            }
+            app_eaci_msg_hdl(pdu[0], pdu[1], pdu[2], pdu + EACI_PDU_HDR_LEN);
         }
         
         // Check for sleep have to be done with interrupt disabled
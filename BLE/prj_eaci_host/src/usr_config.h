@@ -28,7 +28,9 @@
     // SPI slave inform spi master to read
     #define HCI_SPI_RD_PIN_NUM      3
 #endif
-//#define MSG_BUFFER_EN
+/// Build the EACI host for Linux, the controller is reached through eaci_posix_open()
+/// (serial device or pty) or eaci_posix_connect() (TCP socket)
+//#define CFG_EACI_POSIX
 
 /// Profiles and services
 
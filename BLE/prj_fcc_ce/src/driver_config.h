@@ -209,9 +209,11 @@
 #define TIMER1_CALLBACK_EN                              TRUE        /*!< Enable/Disable Timer1 Driver Callback */
 #define TIMER2_CALLBACK_EN                              TRUE        /*!< Enable/Disable Timer2 Driver Callback */
 #define TIMER3_CALLBACK_EN                              TRUE        /*!< Enable/Disable Timer3 Driver Callback */
+#define TIMER_CAP_EN                                    FALSE       /*!< Enable/Disable input capture engine */
 
 #define RTC_CALLBACK_EN                                 TRUE        /*!< Enable/Disable RTC Driver Callback */
 #define RTC_CAP_CALLBACK_EN                             TRUE        /*!< Enable/Disable RTC Capture Driver Callback */
+#define RTC_EPOCH_EN                                    FALSE       /*!< Enable/Disable epoch clock with drift correction and alarm on the RTC */
 #define USE_STD_C_LIB_TIME                              TRUE        /*!< Enable/Disable Standard C library function to parse date and time */
 
 #define DMA_CALLBACK_EN                                 TRUE        /*!< Enable/Disable DMA Driver Callback */
@@ -186,6 +186,7 @@ void SystemInit(void)
  
 		OLED_ShowString(0,0,"  Firefly Team  ");
 		OLED_ShowString(0,2,"    Wait ...    ");
+		OLED_Refresh_Gram();
 //		OLED_ShowString(4,4,"Please wait...");
 #endif
 //#if		(FB_OLED)
@@ -130,6 +130,27 @@
 /// Support service discovery
 // #define CFG_SVC_DISC
 
+/// Create server databases without kernel message round-trips at boot
+// #define CFG_SVC_DB_DIRECT
+
+/// BLE heap statistics: free bytes, largest block, peak usage
+// #define CFG_HEAP_STAT
+
+/// Sleep profile: power mode residency, blocking reasons, wakeup sources
+// #define CFG_SLEEP_STAT
+
+/// Handler profile: calls and processor cycles of event callbacks and message handlers
+// #define CFG_TASK_PROF
+
+/// BLE heap trace: application allocations by message, outstanding blocks, size advice (needs CFG_HEAP_STAT)
+// #define CFG_HEAP_TRACE
+
+/// Resolve private addresses against all bonded IRKs locally, with a cache of resolved addresses
+// #define CFG_RPA_RESOLVE
+
+/// Request fast or slow connection parameters following the link traffic (peripheral)
+// #define CFG_CONN_POLICY
+
 /// Support white list
 // #define CFG_WL_SUPPORT
 
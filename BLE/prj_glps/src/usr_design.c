@@ -34,6 +34,7 @@
 #include "gpio.h"
 #include "button.h"
 #include "sleep.h"
+#include "ieee11073.h"
 
 #if	 (FB_JOYSTICKS)
 #include "joysticks.h"
@@ -74,33 +75,37 @@ struct usr_env_tag usr_env = {LED_ON_DUR_IDLE, LED_OFF_DUR_IDLE};
 
 /**
  ****************************************************************************************
- * @brief   Led1 for BLE status
+ * @brief   Arm the led timer with the delay returned by the led pattern engine
  ****************************************************************************************
  */
-static void usr_led1_set(uint16_t timer_on, uint16_t timer_off)
+static void usr_led1_timer(uint16_t delay)
 {
-    usr_env.led1_on_dur = timer_on;
-    usr_env.led1_off_dur = timer_off;
-
-    if (timer_on == 0 || timer_off == 0)
+    if (delay != 0)
     {
-        if (timer_on == 0)
-        {
-            led_set(1, LED_OFF);
-        }
-        if (timer_off == 0)
-        {
-            led_set(1, LED_ON);
-        }
-        ke_timer_clear(APP_SYS_LED_1_TIMER, TASK_APP);
+        ke_timer_set(APP_SYS_LED_1_TIMER, TASK_APP, delay);
     }
     else
     {
-        led_set(1, LED_OFF);
-        ke_timer_set(APP_SYS_LED_1_TIMER, TASK_APP, timer_off);
+        ke_timer_clear(APP_SYS_LED_1_TIMER, TASK_APP);
     }
 }
 
+/**
+ ****************************************************************************************
+ * @brief   Led1 for BLE status
+ ****************************************************************************************
+ */
+static void usr_led1_set(uint16_t timer_on, uint16_t timer_off)
+{
+    static struct led_pattern pattern;
+
+    usr_env.led1_on_dur = timer_on;
+    usr_env.led1_off_dur = timer_off;
+
+    led_pattern_blink(&pattern, LED_MATRIX(1), timer_on, timer_off);
+    usr_led1_timer(led_pattern_start(0, &pattern));
+}
+
 /**
  ****************************************************************************************
  * @brief   Led 1 flash process
@@ -108,16 +113,18 @@ static void usr_led1_set(uint16_t timer_on, uint16_t timer_off)
  */
 static void usr_led1_process(void)
 {
-    if(led_get(1) == LED_ON)
-    {
-        led_set(1, LED_OFF);
-        ke_timer_set(APP_SYS_LED_1_TIMER, TASK_APP, usr_env.led1_off_dur);
-    }
-    else
-    {
-        led_set(1, LED_ON);
-        ke_timer_set(APP_SYS_LED_1_TIMER, TASK_APP, usr_env.led1_on_dur);
-    }
+    usr_led1_timer(led_pattern_process());
+}
+
+/**
+ ****************************************************************************************
+ * @brief   Led 1 steps played at a wakeup of the BLE stack instead of their own
+ ****************************************************************************************
+ */
+static void app_event_led_pattern_handler(void)
+{
+    ke_evt_clear(1UL << EVENT_LED_PATTERN_ID);
+    usr_led1_timer(led_pattern_process_early());
 }
 
 /**
@@ -153,9 +160,9 @@ static void app_glps_meas_send(uint8_t ctx_exist)
     }
 
     if (meas.flags & GLP_MEAS_GL_CTR_UNITS_MOL_L)
-        meas.concentration = 25;
+        meas.concentration = ieee11073_sfloat_encode(55, -4);   // 5.5 mmol/L, in mol/L
     else
-        meas.concentration = 30;
+        meas.concentration = ieee11073_sfloat_encode(99, -5);   // 99 mg/dL, in kg/L
 
     if (meas.flags & GLP_MEAS_SENS_STAT_ANNUN_PRES)
         meas.status = GLP_MEAS_STATE_DEV_BAT_LOW;   // enum glp_meas_state
@@ -174,7 +181,7 @@ static void app_glps_meas_send(uint8_t ctx_exist)
         if (ctx.flags & GLP_CTX_CRBH_ID_AND_CRBH_PRES)
         {
             ctx.carbo_id = GLP_CID_BREAKFAST;   // see enum glp_meas_ctx_carbo
-            ctx.carbo_val = 20;                 // kilograms
+            ctx.carbo_val = ieee11073_sfloat_encode(20, -3);    // 20 g, in kilograms
         }
 
         if (ctx.flags & GLP_CTX_MEAL_PRES)
@@ -198,14 +205,14 @@ static void app_glps_meas_send(uint8_t ctx_exist)
         {
             ctx.med_id = GLP_MEDID_INTER_ACTING_INSULIN;    // enum glp_meas_ctx_med_id
             if (ctx.flags & GLP_CTX_MEDIC_VAL_UNITS_L)
-                ctx.med_val = 11;                           // liters
+                ctx.med_val = ieee11073_sfloat_encode(11, -5);  // 0.11 mL, in liters
             else
-                ctx.med_val = 12;                           // kilograms
+                ctx.med_val = ieee11073_sfloat_encode(12, -6);  // 12 mg, in kilograms
         }
 
         if (ctx.flags & GLP_CTX_HBA1C_PRES)
         {
-            ctx.hba1c_val = 13;
+            ctx.hba1c_val = ieee11073_sfloat_encode(65, -1);    // 6.5 percent
         }
 
         if (ctx.flags & GLP_CTX_EXTD_F_PRES)
@@ -496,6 +503,12 @@ void usr_sleep_restore(void)
     uart_tx_enable(QN_DEBUG_UART, MASK_ENABLE);
     uart_rx_enable(QN_DEBUG_UART, MASK_ENABLE);
 #endif
+
+    // A led step due soon ends now rather than waking the chip up again
+    if (led_pattern_due())
+    {
+        ke_evt_set(1UL << EVENT_LED_PATTERN_ID);
+    }
 }
 
 /**
@@ -658,6 +671,12 @@ void gpio_interrupt_callback(enum gpio_pin pin)
  */
 void usr_init(void)
 {
+    if(KE_EVENT_OK != ke_evt_callback_set(EVENT_LED_PATTERN_ID,
+                                            app_event_led_pattern_handler))
+    {
+        ASSERT_ERR(0);
+    }
+
     if(KE_EVENT_OK != ke_evt_callback_set(EVENT_BUTTON1_PRESS_ID, 
                                             app_event_button1_press_handler))
     {
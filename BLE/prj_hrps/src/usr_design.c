@@ -53,8 +53,11 @@
 #define LED_ON_DUR_IDLE                   0
 #define LED_OFF_DUR_IDLE                  0xffff
 
-#define APP_HEART_RATE_MEASUREMENT_TO     1400 // 14s
-#define APP_HRPS_ENERGY_EXPENDED_STEP     50
+// The demo simulates one beat every 860ms (70bpm) instead of one measurement every 14s,
+// the RR-Intervals are notified by the accumulator of app_hrps.c
+#define APP_HEART_RATE_MEASUREMENT_TO     86 // 860ms, one simulated beat
+#define APP_HRPS_DEMO_RR_INTERVAL         878 // 70bpm, unit 1/1024s
+#define APP_HRPS_ENERGY_EXPENDED_STEP     1
 
 #define EVENT_BUTTON1_PRESS_ID            0
 
@@ -73,33 +76,37 @@ struct usr_env_tag usr_env = {LED_ON_DUR_IDLE, LED_OFF_DUR_IDLE};
 
 /**
  ****************************************************************************************
- * @brief   Led1 for BLE status
+ * @brief   Arm the led timer with the delay returned by the led pattern engine
  ****************************************************************************************
  */
-static void usr_led1_set(uint16_t timer_on, uint16_t timer_off)
+static void usr_led1_timer(uint16_t delay)
 {
-    usr_env.led1_on_dur = timer_on;
-    usr_env.led1_off_dur = timer_off;
-
-    if (timer_on == 0 || timer_off == 0)
+    if (delay != 0)
     {
-        if (timer_on == 0)
-        {
-            led_set(1, LED_OFF);
-        }
-        if (timer_off == 0)
-        {
-            led_set(1, LED_ON);
-        }
-        ke_timer_clear(APP_SYS_LED_1_TIMER, TASK_APP);
+        ke_timer_set(APP_SYS_LED_1_TIMER, TASK_APP, delay);
     }
     else
     {
-        led_set(1, LED_OFF);
-        ke_timer_set(APP_SYS_LED_1_TIMER, TASK_APP, timer_off);
+        ke_timer_clear(APP_SYS_LED_1_TIMER, TASK_APP);
     }
 }
 
+/**
+ ****************************************************************************************
+ * @brief   Led1 for BLE status
+ ****************************************************************************************
+ */
+static void usr_led1_set(uint16_t timer_on, uint16_t timer_off)
+{
+    static struct led_pattern pattern;
+
+    usr_env.led1_on_dur = timer_on;
+    usr_env.led1_off_dur = timer_off;
+
+    led_pattern_blink(&pattern, LED_MATRIX(1), timer_on, timer_off);
+    usr_led1_timer(led_pattern_start(0, &pattern));
+}
+
 /**
  ****************************************************************************************
  * @brief   Led 1 flash process
@@ -107,16 +114,18 @@ static void usr_led1_set(uint16_t timer_on, uint16_t timer_off)
  */
 static void usr_led1_process(void)
 {
-    if(led_get(1) == LED_ON)
-    {
-        led_set(1, LED_OFF);
-        ke_timer_set(APP_SYS_LED_1_TIMER, TASK_APP, usr_env.led1_off_dur);
-    }
-    else
-    {
-        led_set(1, LED_ON);
-        ke_timer_set(APP_SYS_LED_1_TIMER, TASK_APP, usr_env.led1_on_dur);
-    }
+    usr_led1_timer(led_pattern_process());
+}
+
+/**
+ ****************************************************************************************
+ * @brief   Led 1 steps played at a wakeup of the BLE stack instead of their own
+ ****************************************************************************************
+ */
+static void app_event_led_pattern_handler(void)
+{
+    ke_evt_clear(1UL << EVENT_LED_PATTERN_ID);
+    usr_led1_timer(led_pattern_process_early());
 }
 
 /**
@@ -277,21 +286,13 @@ int app_hrps_timer_handler(ke_msg_id_t const msgid,
                            ke_task_id_t const dest_id,
                            ke_task_id_t const src_id)
 {
-    if (app_hrps_env->ntf_sending == false && app_hrps_env->features & HRPS_HR_MEAS_NTF_CFG)
+    if (app_hrps_env->features & HRPS_HR_MEAS_NTF_CFG)
     {
-        struct hrs_hr_meas meas_val;
-
-        meas_val.flags = HRS_FLAG_HR_8BITS_VALUE | HRS_FLAG_SENSOR_CCT_FET_NOT_SUPPORTED | HRS_FLAG_ENERGY_EXPENDED_PRESENT | HRS_FLAG_RR_INTERVAL_PRESENT;
-        //DEVELOPER NOTE: SET nb_rr_interval TO REAL VALUE OF USER APPLICATION HERE
-        meas_val.nb_rr_interval = 4;
-        //DEVELOPER NOTE: SET rr_intervals TO REAL VALUE OF USER APPLICATION HERE
-        meas_val.rr_intervals[0] = 0x12;
-        meas_val.rr_intervals[1] = 0x34;
-        meas_val.rr_intervals[2] = 0x56;
-        meas_val.rr_intervals[3] = 0x78;
-        //DEVELOPER NOTE: SET heart_rate TO REAL VALUE OF USER APPLICATION HERE
-        meas_val.heart_rate = 70;
-        meas_val.energy_expended = app_hrps_env->energy_expended;
+        //DEVELOPER NOTE: CALL app_hrps_rr_interval_add() FROM THE HEART RATE SENSOR ISR
+        // FOR EVERY DETECTED BEAT, NOTIFICATIONS ARE SENT WHEN FULL OR AFTER APP_HRPS_RR_LATENCY_TO
+        app_hrps_rr_interval_add(APP_HRPS_DEMO_RR_INTERVAL);
+
+        //DEVELOPER NOTE: SET energy_expended TO REAL VALUE OF USER APPLICATION HERE
         if ((0xffff - app_hrps_env->energy_expended) >= APP_HRPS_ENERGY_EXPENDED_STEP)
         {
             app_hrps_env->energy_expended += APP_HRPS_ENERGY_EXPENDED_STEP;
@@ -300,9 +301,6 @@ int app_hrps_timer_handler(ke_msg_id_t const msgid,
         {
             app_hrps_env->energy_expended = 0xFFFF;
         }
-
-        app_hrps_measurement_send(app_hrps_env->conhdl, &meas_val);
-        app_hrps_env->ntf_sending =true;
     }
     ke_timer_set(APP_HRPS_TIMER, TASK_APP, APP_HEART_RATE_MEASUREMENT_TO);
 
@@ -321,6 +319,12 @@ void usr_sleep_restore(void)
     uart_tx_enable(QN_DEBUG_UART, MASK_ENABLE);
     uart_rx_enable(QN_DEBUG_UART, MASK_ENABLE);
 #endif
+
+    // A led step due soon ends now rather than waking the chip up again
+    if (led_pattern_due())
+    {
+        ke_evt_set(1UL << EVENT_LED_PATTERN_ID);
+    }
 }
 
 /**
@@ -483,11 +487,19 @@ void gpio_interrupt_callback(enum gpio_pin pin)
  */
 void usr_init(void)
 {
+    if(KE_EVENT_OK != ke_evt_callback_set(EVENT_LED_PATTERN_ID,
+                                            app_event_led_pattern_handler))
+    {
+        ASSERT_ERR(0);
+    }
+
     if(KE_EVENT_OK != ke_evt_callback_set(EVENT_BUTTON1_PRESS_ID, 
                                             app_event_button1_press_handler))
     {
         ASSERT_ERR(0);
     }
+
+    app_hrps_rr_init();
 #if (FB_JOYSTICKS)
     if(KE_EVENT_OK != ke_evt_callback_set(EVENT_ADC_KEY_SAMPLE_CMP_ID,
                                             app_event_adc_key_sample_cmp_handler))
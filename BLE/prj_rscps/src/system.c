@@ -67,7 +67,11 @@ static void SystemIOCfg(void)
                              | P23_GPIO_19_PIN_CTRL
                              | P24_GPIO_20_PIN_CTRL
                              | P25_GPIO_21_PIN_CTRL
+#if (TIMER_CAP_EN==TRUE)
+                             | P26_TIMER2_ICP0_PIN_CTRL     //P2.6 step sensor
+#else
                              | P26_GPIO_22_PIN_CTRL
+#endif
                              | P27_GPIO_23_PIN_CTRL
 
 #if	!(FB_JOYSTICKS)
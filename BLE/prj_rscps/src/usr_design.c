@@ -34,6 +34,9 @@
 #include "gpio.h"
 #include "button.h"
 #include "sleep.h"
+#if (TIMER_CAP_EN==TRUE)
+#include "timer.h"
+#endif
 
 #if	 (FB_JOYSTICKS)
 #include "joysticks.h"
@@ -53,7 +56,23 @@
 #define LED_ON_DUR_IDLE         0
 #define LED_OFF_DUR_IDLE        0xffff
 
+// The step capture (TIMER_CAP_EN in driver_config.h, off by default) keeps Timer2
+// clocked, so the chip stays awake while notifications are enabled. Its measurements
+// are then sent every second like a real sensor instead of the 12s of the demo values.
+#if (TIMER_CAP_EN==TRUE)
+#define APP_RSCPS_MEAS_SEND_TO          100     // 1s
+#else
 #define APP_RSCPS_MEAS_SEND_TO          1200    // 12s
+#endif
+
+#if (TIMER_CAP_EN==TRUE)
+/// Step sensor on the capture pin of Timer2 (P2.6)
+#define USR_RSC_STEP_TIMER              QN_TIMER2
+/// Capture prescaler, 8kHz ticks with the 8MHz timer clock
+#define USR_RSC_CAP_PSCAL               999
+/// Stride length in cm
+#define USR_RSC_STRIDE_LEN              100
+#endif
 
 #define EVENT_BUTTON1_PRESS_ID            0
 
@@ -64,6 +83,13 @@
 
 struct usr_env_tag usr_env = {LED_ON_DUR_IDLE, LED_OFF_DUR_IDLE};
 
+#if (TIMER_CAP_EN==TRUE)
+/// Steps captured on the sensor edges
+static struct timer_cap usr_step_cap;
+/// Total distance in dm when the step count was 0
+static uint32_t usr_dist_base;
+#endif
+
 
 /*
  * FUNCTION DEFINITIONS
@@ -72,33 +98,37 @@ struct usr_env_tag usr_env = {LED_ON_DUR_IDLE, LED_OFF_DUR_IDLE};
 
 /**
  ****************************************************************************************
- * @brief   Led1 for BLE status
+ * @brief   Arm the led timer with the delay returned by the led pattern engine
  ****************************************************************************************
  */
-static void usr_led1_set(uint16_t timer_on, uint16_t timer_off)
+static void usr_led1_timer(uint16_t delay)
 {
-    usr_env.led1_on_dur = timer_on;
-    usr_env.led1_off_dur = timer_off;
-
-    if (timer_on == 0 || timer_off == 0)
+    if (delay != 0)
     {
-        if (timer_on == 0)
-        {
-            led_set(1, LED_OFF);
-        }
-        if (timer_off == 0)
-        {
-            led_set(1, LED_ON);
-        }
-        ke_timer_clear(APP_SYS_LED_1_TIMER, TASK_APP);
+        ke_timer_set(APP_SYS_LED_1_TIMER, TASK_APP, delay);
     }
     else
     {
-        led_set(1, LED_OFF);
-        ke_timer_set(APP_SYS_LED_1_TIMER, TASK_APP, timer_off);
+        ke_timer_clear(APP_SYS_LED_1_TIMER, TASK_APP);
     }
 }
 
+/**
+ ****************************************************************************************
+ * @brief   Led1 for BLE status
+ ****************************************************************************************
+ */
+static void usr_led1_set(uint16_t timer_on, uint16_t timer_off)
+{
+    static struct led_pattern pattern;
+
+    usr_env.led1_on_dur = timer_on;
+    usr_env.led1_off_dur = timer_off;
+
+    led_pattern_blink(&pattern, LED_MATRIX(1), timer_on, timer_off);
+    usr_led1_timer(led_pattern_start(0, &pattern));
+}
+
 /**
  ****************************************************************************************
  * @brief   Led 1 flash process
@@ -106,16 +136,18 @@ static void usr_led1_set(uint16_t timer_on, uint16_t timer_off)
  */
 static void usr_led1_process(void)
 {
-    if(led_get(1) == LED_ON)
-    {
-        led_set(1, LED_OFF);
-        ke_timer_set(APP_SYS_LED_1_TIMER, TASK_APP, usr_env.led1_off_dur);
-    }
-    else
-    {
-        led_set(1, LED_ON);
-        ke_timer_set(APP_SYS_LED_1_TIMER, TASK_APP, usr_env.led1_on_dur);
-    }
+    usr_led1_timer(led_pattern_process());
+}
+
+/**
+ ****************************************************************************************
+ * @brief   Led 1 steps played at a wakeup of the BLE stack instead of their own
+ ****************************************************************************************
+ */
+static void app_event_led_pattern_handler(void)
+{
+    ke_evt_clear(1UL << EVENT_LED_PATTERN_ID);
+    usr_led1_timer(led_pattern_process_early());
 }
 
 /**
@@ -183,6 +215,9 @@ void app_task_msg_hdl(ke_msg_id_t const msgid, void const *param)
 
         case RSCPS_DISABLE_IND:
             ke_timer_clear(APP_RSCPS_MEAS_SEND_TIMER, TASK_APP);
+#if (TIMER_CAP_EN==TRUE)
+            timer_cap_stop(&usr_step_cap);
+#endif
             break;
 
         case RSCPS_NTF_IND_CFG_IND:
@@ -195,10 +230,17 @@ void app_task_msg_hdl(ke_msg_id_t const msgid, void const *param)
                 {
                     app_rscps_env->ntf_sending = false;
                     ke_timer_set(APP_RSCPS_MEAS_SEND_TIMER, TASK_APP, APP_RSCPS_MEAS_SEND_TO);
+#if (TIMER_CAP_EN==TRUE)
+                    timer_cap_start(USR_RSC_STEP_TIMER, &usr_step_cap, USR_RSC_CAP_PSCAL, INCAP_EDGE_POS);
+                    usr_dist_base = 0;
+#endif
                 }
                 else
                 {
                     ke_timer_clear(APP_RSCPS_MEAS_SEND_TIMER, TASK_APP);
+#if (TIMER_CAP_EN==TRUE)
+                    timer_cap_stop(&usr_step_cap);
+#endif
                 }
             }
             else if (cfg->char_code == RSCP_RSCS_SC_CTNL_PT_CHAR)
@@ -216,6 +258,9 @@ void app_task_msg_hdl(ke_msg_id_t const msgid, void const *param)
             switch (cfg->op_code)
             {
                 case RSCP_CTNL_PT_OP_SET_CUMUL_VAL:
+#if (TIMER_CAP_EN==TRUE)
+                    usr_dist_base = cfg->value.cumul_value - usr_step_cap.count * USR_RSC_STRIDE_LEN / 10;
+#endif
                     app_rscps_sc_ctnl_pt_cfm(app_rscps_env->conhdl, PRF_ERR_OK, &value);
                     break;
                 case RSCP_CTNL_PT_OP_START_CALIB:
@@ -312,6 +357,11 @@ int app_rscps_meas_send_timer_handler(ke_msg_id_t const msgid,
                                       ke_task_id_t const dest_id,
                                       ke_task_id_t const src_id)
 {
+#if (TIMER_CAP_EN==TRUE)
+    struct timer_cap_stat step;
+    uint32_t cadence;
+#endif
+
     //DEVELOPER NOTE: SET REAL VALUE OF USER APPLICATION IN THIS FUNCTION
     if (app_rscps_env->enabled == true &&
         (app_rscps_env->app_cfg & RSCP_PRF_CFG_FLAG_RSC_MEAS_NTF))
@@ -319,8 +369,20 @@ int app_rscps_meas_send_timer_handler(ke_msg_id_t const msgid,
         if (app_rscps_env->ntf_sending == false)
         {
             app_rscps_env->ntf_sending = true;
+#if (TIMER_CAP_EN==TRUE)
+            timer_cap_stat_get(&usr_step_cap, &step);
+
+            // Steps per minute from the step frequency in mHz, speed in 1/256 m/s
+            cadence = step.freq * 60 / 1000;
+            app_rscps_ntf_rsc_meas_req(app_rscps_env->conhdl, RSCP_MEAS_INST_STRIDE_LEN_PRESENT | RSCP_MEAS_TOTAL_DST_MEAS_PRESENT,
+                                   (cadence > 0xFF) ? 0xFF : cadence,
+                                   (uint16_t)((uint64_t)step.freq * USR_RSC_STRIDE_LEN * 256 / 100000),
+                                   USR_RSC_STRIDE_LEN,
+                                   usr_dist_base + step.count * USR_RSC_STRIDE_LEN / 10);
+#else
             app_rscps_ntf_rsc_meas_req(app_rscps_env->conhdl, RSCP_MEAS_INST_STRIDE_LEN_PRESENT | RSCP_MEAS_TOTAL_DST_MEAS_PRESENT,  
                                    50, 60, 50, 2000);
+#endif
         }
         ke_timer_set(APP_RSCPS_MEAS_SEND_TIMER, TASK_APP, APP_RSCPS_MEAS_SEND_TO);
     }
@@ -339,6 +401,12 @@ void usr_sleep_restore(void)
     uart_tx_enable(QN_DEBUG_UART, MASK_ENABLE);
     uart_rx_enable(QN_DEBUG_UART, MASK_ENABLE);
 #endif
+
+    // A led step due soon ends now rather than waking the chip up again
+    if (led_pattern_due())
+    {
+        ke_evt_set(1UL << EVENT_LED_PATTERN_ID);
+    }
 }
 
 /**
@@ -501,6 +569,12 @@ void gpio_interrupt_callback(enum gpio_pin pin)
  */
 void usr_init(void)
 {
+    if(KE_EVENT_OK != ke_evt_callback_set(EVENT_LED_PATTERN_ID,
+                                            app_event_led_pattern_handler))
+    {
+        ASSERT_ERR(0);
+    }
+
     if(KE_EVENT_OK != ke_evt_callback_set(EVENT_BUTTON1_PRESS_ID, 
                                             app_event_button1_press_handler))
     {
@@ -140,7 +140,7 @@
 #define CONFIG_DMA_DEFAULT_IRQHANDLER                   TRUE        /*!< Enable/Disable DMA Default IRQ Handler */
 #define CONFIG_DMA_ENABLE_INTERRUPT                     TRUE        /*!< Enable/Disable DMA Interrupt */
 
-#define CONFIG_ENABLE_DRIVER_RTC                        FALSE       /*!< Enable/Disable RTC Driver */
+#define CONFIG_ENABLE_DRIVER_RTC                        TRUE        /*!< Enable/Disable RTC Driver */
 #define CONFIG_RTC_DEFAULT_IRQHANDLER                   TRUE        /*!< Enable/Disable RTC Default IRQ Handler */
 #define CONFIG_RTC_ENABLE_INTERRUPT                     TRUE        /*!< Enable/Disable RTC Interrupt */
 
@@ -194,9 +194,11 @@
 #define TIMER1_CALLBACK_EN                              TRUE        /*!< Enable/Disable Timer1 Driver Callback */
 #define TIMER2_CALLBACK_EN                              TRUE        /*!< Enable/Disable Timer2 Driver Callback */
 #define TIMER3_CALLBACK_EN                              TRUE        /*!< Enable/Disable Timer3 Driver Callback */
+#define TIMER_CAP_EN                                    FALSE       /*!< Enable/Disable input capture engine */
 
 #define RTC_CALLBACK_EN                                 TRUE        /*!< Enable/Disable RTC Driver Callback */
 #define RTC_CAP_CALLBACK_EN                             TRUE        /*!< Enable/Disable RTC Capture Driver Callback */
+#define RTC_EPOCH_EN                                    TRUE        /*!< Enable/Disable epoch clock with drift correction and alarm on the RTC */
 #define USE_STD_C_LIB_TIME                              TRUE        /*!< Enable/Disable Standard C library function to parse date and time */
 
 #define DMA_CALLBACK_EN                                 TRUE        /*!< Enable/Disable DMA Driver Callback */
@@ -61,8 +61,13 @@
  */
 void app_anps_create_db(uint16_t supp_new_alert_cat, uint16_t supp_unread_alert_cat)
 {
+#if (QN_SVC_DB_DIRECT)
+    struct anps_create_db_req req;
+    struct anps_create_db_req *msg = &req;
+#else
     struct anps_create_db_req *msg = KE_MSG_ALLOC(ANPS_CREATE_DB_REQ, TASK_ANPS, TASK_APP,
                                                   anps_create_db_req);
+#endif
     ///Supported New Alert Category Characteristic Value
     msg->supp_new_alert_cat.cat_id_mask_0 = (uint8_t)(supp_new_alert_cat & 0x00ff);
     msg->supp_new_alert_cat.cat_id_mask_1 = (uint8_t)((supp_new_alert_cat >> 8) & 0x00ff);
@@ -70,8 +75,17 @@ void app_anps_create_db(uint16_t supp_new_alert_cat, uint16_t supp_unread_alert_
     msg->supp_unread_alert_cat.cat_id_mask_0 = (uint8_t)(supp_unread_alert_cat & 0x00ff);
     msg->supp_unread_alert_cat.cat_id_mask_1 = (uint8_t)((supp_unread_alert_cat >> 8) & 0x00ff);
 
+#if (QN_SVC_DB_DIRECT)
+    struct anps_cmp_evt evt;
+
+    evt.conhdl = GAP_INVALID_CONHDL;
+    evt.operation = ANPS_CREATE_DB_OP_CODE;
+    evt.status = anps_create_db(msg);
+    app_anps_cmp_evt_handler(ANPS_CMP_EVT, &evt, TASK_APP, TASK_ANPS);
+#else
     // Send the message
     ke_msg_send(msg);
+#endif
 }
 
  /*
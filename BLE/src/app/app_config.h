@@ -272,10 +272,30 @@
     #define QN_DBG_INFO             0
 #endif
 
+/// Buffered H4 transport between the stack and the HCI UART in controller mode
+#if (defined(CFG_HCI_H4) && defined(CFG_WM_HCI) && defined(CFG_HCI_UART))
+    #define QN_HCI_H4               1
+#else
+    #define QN_HCI_H4               0
+#endif
+
+/// btsnoop capture of the H4 transport on a second UART
+#if (defined(CFG_HCI_SNOOP) && QN_HCI_H4)
+    #define QN_HCI_SNOOP            1
+    #define QN_HCI_SNOOP_PORT       CFG_HCI_SNOOP
+#else
+    #define QN_HCI_SNOOP            0
+#endif
+
 /// UART definitions
 #define QN_DEBUG_UART               CFG_DEBUG_UART
+#if (QN_HCI_H4)
+#define QN_HCI_UART_RD              (hci_api)hci_h4_read
+#define QN_HCI_UART_WR              (hci_api)hci_h4_write
+#else
 #define QN_HCI_UART_RD              (hci_api)uart_read
 #define QN_HCI_UART_WR              (hci_api)uart_write
+#endif
 #define QN_HCI_SPI_RD               (hci_api)spi_read
 #define QN_HCI_SPI_WR               (hci_api)spi_write
 
@@ -335,6 +355,80 @@
     #define QN_GATT_MAX_HDL_NB      (3 * GATT_MAX_HDL_LIST)
 #endif
 
+/// GATT client queue: one request in flight, Read Multiple, back to back write commands.
+/// Define CFG_GATT_QUEUE, with CFG_SVC_DISC, in usr_config.h of a project whose clients use it.
+#if (defined(CFG_GATT_QUEUE) && QN_SVC_DISC_USED)
+    #define QN_GATT_QUEUE           1
+#else
+    #define QN_GATT_QUEUE           0
+#endif
+
+/// Long reads and writes up to PRF_LONG_VALUE_MAX bytes: prepared writes and Read Blob on
+/// the client side, which needs QN_GATT_QUEUE, and the prepare queue of hogpd on the server
+/// side. Define CFG_LONG_WRITE in usr_config.h of a project which uses them.
+#if (defined(CFG_LONG_WRITE))
+    #define QN_LONG_WRITE           1
+#else
+    #define QN_LONG_WRITE           0
+#endif
+
+/// Create server databases by direct calls instead of *_CREATE_DB_REQ messages. OTAS is only
+/// shipped as a library and still creates its database by message.
+#if (defined(CFG_SVC_DB_DIRECT))
+    #define QN_SVC_DB_DIRECT        1
+#else
+    #define QN_SVC_DB_DIRECT        0
+#endif
+
+/// Connection parameter policy, the slave follows its link traffic with the connection parameters
+#if (defined(CFG_CONN_POLICY) && BLE_PERIPHERAL)
+    #define QN_CONN_POLICY          1
+#else
+    #define QN_CONN_POLICY          0
+#endif
+
+/// BLE heap statistics: free bytes, largest free block and peak usage
+#if (defined(CFG_HEAP_STAT))
+    #define QN_HEAP_STAT            1
+#else
+    #define QN_HEAP_STAT            0
+#endif
+
+/// BLE heap trace: allocations of the application by message, outstanding blocks and size advice
+#if (defined(CFG_HEAP_TRACE) && QN_HEAP_STAT)
+    #define QN_HEAP_TRACE           1
+#else
+    #define QN_HEAP_TRACE           0
+#endif
+
+/// BLE heap trace log: one QPRINTF line per traced event, replayed offline by test/heap_replay.c
+#if (defined(CFG_HEAP_TRACE_LOG) && QN_HEAP_TRACE && QN_DBG_PRINT)
+    #define QN_HEAP_TRACE_LOG       1
+#else
+    #define QN_HEAP_TRACE_LOG       0
+#endif
+
+/// Sleep profile: power mode residency, blocking reasons and wakeup sources
+#if (defined(CFG_SLEEP_STAT))
+    #define QN_SLEEP_STAT           1
+#else
+    #define QN_SLEEP_STAT           0
+#endif
+
+/// Handler profile: calls and cycles of event callbacks and message handlers
+#if (defined(CFG_TASK_PROF))
+    #define QN_TASK_PROF            1
+#else
+    #define QN_TASK_PROF            0
+#endif
+
+/// Resolve peer private addresses against all the bonded IRKs locally
+#if (defined(CFG_RPA_RESOLVE) && QN_SECURITY_ON)
+    #define QN_RPA_RESOLVE          1
+#else
+    #define QN_RPA_RESOLVE          0
+#endif
+
 /// SMP Security level and IO capbility definitions
 #if (QN_SECURITY_ON)
     #if QN_DEMO_MENU
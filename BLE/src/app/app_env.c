@@ -275,6 +275,9 @@ static void app_tips_init(void)
                              TIPS_NDCS_SUP              |
                              TIPS_RTUS_SUP;
     app_tips_env->conhdl = 0xFFFF;
+#if (APP_TIPS_RTC_TIME)
+    app_tips_time_init();
+#endif
 }
 #endif
 
@@ -443,6 +446,9 @@ void app_init(void)
 #if QN_DBG_PRINT
     app_uart_init();
 #endif
+#if (QN_32K_RCO)
+    app_rco_cal_init();
+#endif
 #if QN_EACI
 #if (defined(QN_TEST_CTRL_PIN))
     if(gpio_read_pin(QN_TEST_CTRL_PIN) == GPIO_HIGH)
@@ -28,6 +28,7 @@
 
 #include "app_config.h"
 #include "app_sys.h"
+#include "task_prof.h"
 #include "app_gap.h"
 #include "app_smp.h"
 #include "app_gatt.h"
@@ -179,9 +180,16 @@
  * TYPE DEFINITIONS
  ****************************************************************************************
  */
+#if (QN_GATT_QUEUE)
+#define APP_IDX_MAX                                 (1 + BLE_CONNECTION_MAX)
+#else
 #define APP_IDX_MAX                                 0x01
+#endif
 
+/// Bonded devices kept in NVDS, a project may raise it in usr_config.h
+#ifndef APP_MAX_BONDED_DEVICE_NUMBER
 #define APP_MAX_BONDED_DEVICE_NUMBER                1
+#endif
 
 // The TAG value after 100 reserved for application
 // Store bonded number
@@ -314,6 +322,11 @@ struct app_env_tag
     uint8_t cn_count;
     // Connected Device Record
     struct app_dev_record dev_rec[BLE_CONNECTION_MAX];
+#if (QN_GATT_QUEUE && QN_LONG_WRITE)
+    // Device Name read of app_gatt_read_name_req(), enum app_name_state
+    uint16_t name_conhdl;
+    uint8_t name_state;
+#endif
 
 #if BLE_AN_CLIENT
     struct app_anpc_env_tag anpc_ev[BLE_CONNECTION_MAX];
@@ -21,6 +21,15 @@
 
 #if QN_DEMO_MENU
 #include "app_menu.h"
+#if (QN_SLEEP_STAT)
+#include "sleep.h"
+#endif
+#if (QN_TASK_PROF)
+#include "task_prof.h"
+#endif
+#if (QN_HEAP_TRACE)
+#include "lib.h"
+#endif
 
 static void app_menu_show_line(void)
 {
@@ -91,12 +100,123 @@ static void app_menu_show_main(void)
 #endif
 #if BLE_QPP_CLIENT
     QPRINTF("* h. QPPC  Menu\r\n");
+#endif
+#if (QN_SLEEP_STAT)
+    QPRINTF("* p. Sleep Profile\r\n");
+#endif
+#if (QN_HEAP_TRACE)
+    QPRINTF("* m. Heap  Profile\r\n");
+#endif
+#if (QN_TASK_PROF)
+    QPRINTF("* t. Task  Profile\r\n");
 #endif
     QPRINTF("* r. Upper Menu\r\n");
     QPRINTF("* s. Show  Menu\r\n");
 	app_menu_show_line();
 }
 
+#if (QN_SLEEP_STAT)
+static void app_menu_show_sleep_stat(void)
+{
+    static const char * const pm_name[PM_DEEP_SLEEP + 1] = {"Active", "Idle", "Sleep", "Deep sleep"};
+    static const char * const block_name[SLEEP_BLOCK_NUM] =
+        {"PM set", "Kernel timer", "Device", "GPIO", "ACMP", "Debug UART", "EACI", "32k xtal", "BLE"};
+    struct sleep_stat stat;
+    uint8_t i;
+
+    sleep_stat_get(&stat);
+    sleep_stat_reset();
+
+    app_menu_show_line();
+    QPRINTF("* Power mode: count, time (10ms)\r\n");
+    for (i = PM_ACTIVE; i <= PM_DEEP_SLEEP; i++)
+        QPRINTF("* %s: %d, %d\r\n", pm_name[i], stat.pm[i].count, stat.pm[i].time);
+    QPRINTF("* Blocked by: count, time (10ms)\r\n");
+    for (i = 0; i < SLEEP_BLOCK_NUM; i++)
+    {
+        if (stat.block[i].count != 0)
+            QPRINTF("* %s: %d, %d\r\n", block_name[i], stat.block[i].count, stat.block[i].time);
+    }
+    QPRINTF("* Devices: 0x%x\r\n", stat.dev_bf);
+    QPRINTF("* Wakeup by IRQ: count\r\n");
+    for (i = 0; i < SLEEP_STAT_IRQ_NUM; i++)
+    {
+        if (stat.wakeup[i] != 0)
+            QPRINTF("* %d: %d\r\n", i, stat.wakeup[i]);
+    }
+}
+#endif
+
+#if (QN_TASK_PROF)
+static void app_menu_show_task_prof(void)
+{
+    struct task_prof const *prof = task_prof_get();
+    struct task_prof_item const *item;
+    uint8_t i;
+
+    app_menu_show_line();
+    QPRINTF("* Calls, max cycles, total cycles\r\n");
+    QPRINTF("* Scheduler: %d, %d, %d\r\n", prof->sched.count, prof->sched.max, prof->sched.total);
+    QPRINTF("* Service DB: %d cycles\r\n", task_prof_svc_db_get());
+    for (i = 0; i < TASK_PROF_EVT_NB; i++)
+    {
+        item = &prof->evt[i];
+        if (item->count != 0)
+            QPRINTF("* Event %d: %d, %d, %d\r\n", i, item->count, item->max, item->total);
+    }
+    for (i = 0; i < prof->msg_nb; i++)
+    {
+        item = &prof->msg[i].item;
+        QPRINTF("* Task %d msg 0x%x: %d, %d, %d\r\n", prof->msg[i].task, prof->msg[i].id,
+                item->count, item->max, item->total);
+    }
+    if (prof->msg_lost != 0)
+        QPRINTF("* Other msg: %d\r\n", prof->msg_lost);
+    QPRINTF("* Queue: samples, max, total\r\n");
+    QPRINTF("* Sent: %d, %d, %d\r\n", prof->queue_sent.count, prof->queue_sent.max, prof->queue_sent.total);
+    QPRINTF("* Saved: %d, %d, %d\r\n", prof->queue_saved.count, prof->queue_saved.max, prof->queue_saved.total);
+
+    task_prof_reset();
+}
+#endif
+
+#if (QN_HEAP_TRACE)
+static void app_menu_show_heap_trace(void)
+{
+    struct app_heap_trace const *trace = app_heap_trace_get();
+    struct app_heap_stat stat;
+    uint8_t i;
+
+    app_heap_stat_get(&stat);
+
+    app_menu_show_line();
+    QPRINTF("* Heap: size %d, free %d, largest %d, peak %d, frag %d%%\r\n",
+            stat.size, stat.free, stat.largest, stat.peak, stat.frag);
+    if (*(volatile uint32_t *)QN_DBG_INFO_REG & QN_DBG_INFO_BLE_HEAP_FULL)
+        QPRINTF("* Heap was full\r\n");
+    QPRINTF("* Advised size: %d\r\n", app_heap_size_advice());
+    QPRINTF("* App: alloc %d, free %d, fail %d, live %d, peak %d\r\n",
+            trace->alloc_cnt, trace->free_cnt, trace->fail_cnt, trace->live, trace->live_peak);
+    QPRINTF("* Msg: count, bytes, max\r\n");
+    for (i = 0; i < trace->hist_nb; i++)
+    {
+        QPRINTF("* 0x%x: %d, %d, %d\r\n", trace->hist[i].id,
+                trace->hist[i].count, trace->hist[i].bytes, trace->hist[i].max);
+    }
+    if (trace->hist_lost != 0)
+        QPRINTF("* Other: %d\r\n", trace->hist_lost);
+    QPRINTF("* Held: msg, size, caller, age\r\n");
+    for (i = 0; i < APP_HEAP_BLK_NB; i++)
+    {
+        if (trace->blk[i].ptr != NULL)
+            QPRINTF("* 0x%x: %d, 0x%x, %d\r\n", trace->blk[i].id,
+                    trace->blk[i].size, trace->blk[i].caller, trace->blk[i].age);
+    }
+    if (trace->blk_lost != 0)
+        QPRINTF("* Not followed: %d\r\n", trace->blk_lost);
+}
+#endif
+
 static void app_menu_handler_main(void)
 {
     switch (app_env.input[0])
@@ -193,6 +313,21 @@ static void app_menu_handler_main(void)
     case 'h':
         app_env.menu_id = menu_qppc;
         break;
+#endif
+#if (QN_SLEEP_STAT)
+    case 'p':
+        app_menu_show_sleep_stat();
+        break;
+#endif
+#if (QN_HEAP_TRACE)
+    case 'm':
+        app_menu_show_heap_trace();
+        break;
+#endif
+#if (QN_TASK_PROF)
+    case 't':
+        app_menu_show_task_prof();
+        break;
 #endif
     case 'r':
     case 's':
@@ -315,6 +450,7 @@ static void app_menu_show_gap_dev_record(void)
             }
         }
         if (app_env.menu_id != menu_gatt_disc_all_svc
+         && app_env.menu_id != menu_gatt_read_name
          && app_env.menu_id != menu_gap_disconnection
          && app_env.menu_id != menu_gap_bond
          && app_env.menu_id != menu_htpc_enable
@@ -341,7 +477,7 @@ static void app_menu_show_gap_dev_record(void)
     else
     {
         QPRINTF("Connected device record is NULL.\r\n");
-        if (app_env.menu_id == menu_gatt_disc_all_svc)
+        if ((app_env.menu_id == menu_gatt_disc_all_svc) || (app_env.menu_id == menu_gatt_read_name))
             app_env.menu_id = menu_gatt;
         else if (app_env.menu_id == menu_qppc_enable)
             app_env.menu_id = menu_qppc;
@@ -514,6 +650,17 @@ static void app_menu_handler_gap_dev_select(void)
                     QPRINTF("The selected device is not in connected status.\r\n");
             }
             break;
+#if (QN_GATT_QUEUE && QN_LONG_WRITE)
+        case menu_gatt_read_name:
+            {
+                uint16_t conhdl = app_get_conhdl_by_idx(app_env.select_idx);
+                if (conhdl != 0xFFFF)
+                    app_gatt_read_name_req(conhdl);
+                else
+                    QPRINTF("The selected device is not in connected status.\r\n");
+            }
+            break;
+#endif
         case menu_htpc_enable:
         case menu_blpc_enable:
         case menu_hrpc_enable:
@@ -575,7 +722,7 @@ static void app_menu_handler_gap_dev_select(void)
             app_env.menu_id = menu_anpc;
         else if (app_env.menu_id == menu_paspc_enable)
             app_env.menu_id = menu_paspc;
-        else if (app_env.menu_id == menu_gatt_disc_all_svc)
+        else if ((app_env.menu_id == menu_gatt_disc_all_svc) || (app_env.menu_id == menu_gatt_read_name))
             app_env.menu_id = menu_gatt;
         else
             app_env.menu_id = menu_gap;
@@ -593,6 +740,9 @@ static void app_menu_show_gatt(void)
 	QPRINTF("* QN BLE GATT Menu\r\n");
     QPRINTF("* 1. Discovery All Services\r\n");
     QPRINTF("* 2. Display All Services\r\n");
+#if (QN_GATT_QUEUE && QN_LONG_WRITE)
+    QPRINTF("* 3. Read Peer Device Name\r\n");
+#endif
 	app_menu_show_line();
 }
 
@@ -639,6 +789,11 @@ static void app_menu_handler_gatt(void)
     case '2':
         app_env.menu_id = menu_gatt_disp_all_svc;
         break;
+#if (QN_GATT_QUEUE && QN_LONG_WRITE)
+    case '3':
+        app_env.menu_id = menu_gatt_read_name;
+        break;
+#endif
     case 'r':
         app_env.menu_id = menu_main;
         break;
@@ -2490,6 +2645,7 @@ void app_menu_show(void)
     case menu_gap_bond:
     case menu_gap_disconnection:
     case menu_gatt_disc_all_svc:
+    case menu_gatt_read_name:
     case menu_htpc_enable:
     case menu_blpc_enable:
     case menu_hrpc_enable:
@@ -2753,6 +2909,7 @@ void app_menu_hdl(void)
 
 #if QN_SVC_DISC_USED
     case menu_gatt_disc_all_svc:
+    case menu_gatt_read_name:
 #endif
 
     case menu_htpc_enable:
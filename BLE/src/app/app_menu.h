@@ -33,6 +33,7 @@ typedef enum
     menu_gatt,
     menu_gatt_disc_all_svc,
     menu_gatt_disp_all_svc,
+    menu_gatt_read_name,
     menu_smp,
     menu_smp_sec_lvl_set,
     menu_smp_io_cap_set,
@@ -19,10 +19,72 @@
  */
 #include "app_env.h" 
 #include "uart.h"
+#if QN_DEMO_MENU
+#include "lib.h"
+#endif
+#if (QN_HEAP_STAT)
+#include "ke_mem.h"
+#endif
+#if (QN_32K_RCO)
+#include "lib.h"
+#include "syscon.h"
+#include "timer.h"
+#include "adc.h"
+#include "analog.h"
+#include "sleep.h"
+#if (CONFIG_ENABLE_DRIVER_RTC == TRUE)
+#include "rtc.h"
+#endif
+#endif
 
 #if QN_DEMO_MENU
 struct app_uart_env_tag app_uart_env;
 static void app_uart_rx_done(void);
+static void app_uart_rx_evt_handler(void);
+#endif
+
+#if (QN_HEAP_STAT)
+/// Header of an allocated block, in front of the pointer ke_malloc() returns
+#define APP_HEAP_USED_HDR   4
+/// A free block keeps room for its own header when a block is allocated from it
+#define APP_HEAP_FREE_HDR   sizeof(struct mblock_free)
+
+static uint8_t *app_heap;
+static uint16_t app_heap_size;
+#endif
+
+#if (QN_HEAP_TRACE)
+static struct app_heap_trace app_heap_trace;
+#if (QN_HEAP_TRACE_LOG)
+/// A message was sent since the last scheduler run logged
+static bool app_heap_log_sent;
+#endif
+
+#if defined(__CC_ARM)
+    #define APP_HEAP_CALLER()   __return_address()
+#elif defined(__GNUC__)
+    #define APP_HEAP_CALLER()   ((uint32_t)(uintptr_t)__builtin_return_address(0))
+#else
+    #define APP_HEAP_CALLER()   0
+#endif
+#endif
+
+#if (QN_32K_RCO)
+/// Calibration steps
+enum
+{
+    APP_RCO_CAL_IDLE,
+    APP_RCO_CAL_TEMP,
+    APP_RCO_CAL_CAPTURE,
+};
+
+/// 32k RCO calibration environment
+static struct
+{
+    uint8_t step;
+    int16_t temp_buf[APP_RCO_CAL_TEMP_SAMPLES];
+    struct app_rco_cal_stat stat;
+} app_rco_cal_env;
 #endif
 
 /**
@@ -35,39 +97,572 @@ void app_uart_init(void)
 {
 #if QN_DEMO_MENU
     app_uart_env.len = 0;
-    uart_read(QN_DEBUG_UART, app_uart_env.buf_rx, 1, app_uart_rx_done);
+    ring_init(&app_uart_env.ring, app_uart_env.ring_buf, QN_UART_RING_SIZE);
+    if(KE_EVENT_OK != ke_evt_callback_set(EVENT_APP_UART_RX_ID, app_uart_rx_evt_handler))
+    {
+        ASSERT_ERR(0);
+    }
+    uart_read(QN_DEBUG_UART, &app_uart_env.rx_byte, 1, app_uart_rx_done);
 #endif
 }
 
 #if QN_DEMO_MENU
 /**
  ****************************************************************************************
- * @brief UART receive call back function, input string should end with '\r''\n'.
+ * @brief UART receive call back function, hands the byte to the background.
+ *
+ * A byte is lost if the background is late by more than QN_UART_RING_SIZE bytes.
  *
  ****************************************************************************************
  */
 void app_uart_rx_done(void)
 {
-    if (app_uart_env.buf_rx[app_uart_env.len] == 0x0A)
+    ring_write(&app_uart_env.ring, &app_uart_env.rx_byte, 1);
+    ke_evt_set(1UL << EVENT_APP_UART_RX_ID);
+
+    uart_read(QN_DEBUG_UART, &app_uart_env.rx_byte, 1, app_uart_rx_done);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Assemble the received bytes, input string should end with '\r''\n'.
+ *
+ ****************************************************************************************
+ */
+static void app_uart_rx_evt_handler(void)
+{
+    // Clear first, a byte received while draining sets the event again
+    ke_evt_clear(1UL << EVENT_APP_UART_RX_ID);
+
+    while (ring_read(&app_uart_env.ring, app_uart_env.buf_rx + app_uart_env.len, 1))
+    {
+        if (app_uart_env.buf_rx[app_uart_env.len] == 0x0A)
+        {
+            struct app_uart_data_req *req = ke_msg_alloc(APP_SYS_UART_DATA_IND,
+                                                        TASK_APP,
+                                                        TASK_NONE,
+                                                        sizeof(struct app_uart_data_req) + (app_uart_env.len - 1));
+            app_uart_env.buf_rx[app_uart_env.len-1] = '\0';
+            req->len = app_uart_env.len;
+            memcpy(req->data, app_uart_env.buf_rx, app_uart_env.len);
+            ke_msg_send(req);
+            app_uart_env.len = 0;
+        }
+        else
+        {
+            if (app_uart_env.len == QN_UART_RX_LEN-1)
+                app_uart_env.len = 0;
+            else
+                app_uart_env.len += 1;
+        }
+    }
+}
+#endif
+
+#if (QN_HEAP_STAT)
+/**
+ ****************************************************************************************
+ * @brief Prepare the BLE heap for statistics, called before ble_init().
+ *
+ * The heap is filled with APP_HEAP_PATTERN, the bytes which still hold it later have
+ * never been used by the stack.
+ *
+ ****************************************************************************************
+ */
+void app_heap_stat_init(uint8_t *heap, uint16_t size)
+{
+    app_heap = heap;
+    app_heap_size = size;
+    memset(heap, APP_HEAP_PATTERN, size);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Bytes written since app_heap_stat_init(), the highest usage of the heap.
+ *
+ ****************************************************************************************
+ */
+static uint16_t app_heap_peak(void)
+{
+    uint16_t len = 0;
+    uint16_t i;
+
+    // Count the bytes never written since app_heap_stat_init()
+    for (i = 0; i < app_heap_size; i++)
     {
-        struct app_uart_data_req *req = ke_msg_alloc(APP_SYS_UART_DATA_IND,
-                                                    TASK_APP,
-                                                    TASK_NONE,
-                                                    sizeof(struct app_uart_data_req) + (app_uart_env.len - 1));
-        app_uart_env.buf_rx[app_uart_env.len-1] = '\0';
-        req->len = app_uart_env.len;
-        memcpy(req->data, app_uart_env.buf_rx, app_uart_env.len);
-        ke_msg_send(req);
-        app_uart_env.len = 0;
+        if (app_heap[i] == APP_HEAP_PATTERN)
+            len++;
     }
+
+    return app_heap_size - len;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Get the BLE heap statistics.
+ *
+ * The free list of the ROM allocator is walked without writing to the heap, so the
+ * pattern bytes counted by the peak are left alone. ke_malloc() takes a block from the
+ * end of a free block and keeps the free block header, so a free block of size S gives
+ * at most S - APP_HEAP_FREE_HDR - APP_HEAP_USED_HDR bytes. The walk stops at any link
+ * outside the heap or not in address order.
+ *
+ ****************************************************************************************
+ */
+void app_heap_stat_get(struct app_heap_stat *stat)
+{
+    struct ke_env_tag const *ke_env = (struct ke_env_tag const *)_ke_env;
+    struct mblock_free const *blk;
+    uint8_t const *heap_end = app_heap + app_heap_size;
+    uint8_t const *last = NULL;
+    uint32_t len;
+
+    stat->size = app_heap_size;
+    stat->peak = app_heap_peak();
+    stat->free = 0;
+    stat->largest = 0;
+
+    GLOBAL_INT_DISABLE();
+    for (blk = ke_env->mblock_first; blk != NULL; blk = blk->next)
+    {
+        if (((uint8_t const *)blk < app_heap) || ((uint8_t const *)blk >= heap_end)
+            || ((uint8_t const *)blk <= last) || (blk->size > (uint32_t)(heap_end - (uint8_t const *)blk)))
+            break;
+        last = (uint8_t const *)blk;
+
+        if (blk->size > APP_HEAP_FREE_HDR + APP_HEAP_USED_HDR)
+        {
+            len = (blk->size - APP_HEAP_FREE_HDR - APP_HEAP_USED_HDR) & ~3UL;
+            stat->free += len;
+            if (len > stat->largest)
+                stat->largest = len;
+        }
+    }
+    GLOBAL_INT_RESTORE();
+
+    stat->frag = (stat->free == 0) ? 0 : (100 - (uint32_t)stat->largest * 100 / stat->free);
+}
+#endif
+
+#if (QN_HEAP_TRACE)
+/**
+ ****************************************************************************************
+ * @brief Log a traced event, the lines are replayed offline by test/heap_replay.c.
+ *
+ * "heap a <id> <size> <block> <caller>" is an allocation, block 0 when it failed,
+ * "heap f <block>" a free by the application and "heap s <block>" a message handed to
+ * the kernel. "heap k" ends the scheduler run which handled the messages sent before.
+ *
+ ****************************************************************************************
+ */
+static void app_heap_log(char op, void const *ptr, uint16_t size, uint16_t id, uint32_t caller)
+{
+#if (QN_HEAP_TRACE_LOG)
+    if (op == 'a')
+        QPRINTF("heap a %04x %d %lx %lx\r\n", id, size, (unsigned long)ptr, (unsigned long)caller);
     else
+        QPRINTF("heap %c %lx\r\n", op, (unsigned long)ptr);
+
+    if (op == 's')
+        app_heap_log_sent = true;
+#endif
+}
+
+/**
+ ****************************************************************************************
+ * @brief Count an allocation and follow the block.
+ *
+ ****************************************************************************************
+ */
+static void app_heap_trace_alloc(void const *ptr, uint16_t size, uint16_t id, uint32_t caller)
+{
+    struct app_heap_trace *trace = &app_heap_trace;
+    struct app_heap_hist *hist = NULL;
+    uint8_t i;
+
+    app_heap_log('a', ptr, size, id, caller);
+    if (ptr == NULL)
     {
-        if (app_uart_env.len == QN_UART_RX_LEN-1)
-            app_uart_env.len = 0;
-        else
-            app_uart_env.len += 1;
+        trace->fail_cnt++;
+        return;
+    }
+
+    trace->alloc_cnt++;
+    if (size > trace->req_max)
+        trace->req_max = size;
+
+    // Histogram by message identifier
+    for (i = 0; i < trace->hist_nb; i++)
+    {
+        if (trace->hist[i].id == id)
+        {
+            hist = &trace->hist[i];
+            break;
+        }
+    }
+    if ((hist == NULL) && (trace->hist_nb < APP_HEAP_HIST_NB))
+    {
+        hist = &trace->hist[trace->hist_nb++];
+        hist->id = id;
     }
+    if (hist != NULL)
+    {
+        hist->count++;
+        hist->bytes += size;
+        if (size > hist->max)
+            hist->max = size;
+    }
+    else
+    {
+        trace->hist_lost++;
+    }
+
+    // Block owned by the application until it is freed or sent
+    for (i = 0; i < APP_HEAP_BLK_NB; i++)
+    {
+        if (trace->blk[i].ptr == NULL)
+        {
+            trace->blk[i].ptr = ptr;
+            trace->blk[i].caller = caller;
+            trace->blk[i].size = size;
+            trace->blk[i].id = id;
+            trace->blk[i].age = 0;
+            trace->live += size;
+            if (trace->live > trace->live_peak)
+                trace->live_peak = trace->live;
+            return;
+        }
+    }
+    trace->blk_lost++;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Stop following a block, freed or handed to the kernel.
+ *
+ * Blocks the application did not allocate, received messages for instance, are ignored.
+ *
+ ****************************************************************************************
+ */
+static void app_heap_trace_release(void const *ptr)
+{
+    uint8_t i;
+
+    for (i = 0; i < APP_HEAP_BLK_NB; i++)
+    {
+        if (app_heap_trace.blk[i].ptr == ptr)
+        {
+            app_heap_trace.blk[i].ptr = NULL;
+            app_heap_trace.live -= app_heap_trace.blk[i].size;
+            return;
+        }
+    }
+}
+
+void *app_heap_malloc(uint32_t size)
+{
+    void *ptr = ((p_ke_malloc)(_ke_malloc))(size);
+
+    app_heap_trace_alloc(ptr, size, APP_HEAP_ID_MALLOC, APP_HEAP_CALLER());
+
+    return ptr;
+}
+
+void app_heap_free(void *mem_ptr)
+{
+    app_heap_trace.free_cnt++;
+    app_heap_log('f', mem_ptr, 0, 0, 0);
+    app_heap_trace_release(mem_ptr);
+    ((p_ke_free)(_ke_free))(mem_ptr);
+}
+
+void *app_heap_msg_alloc(ke_msg_id_t const id, ke_task_id_t const dest_id,
+                         ke_task_id_t const src_id, uint16_t const param_len)
+{
+    void *param = ((p_ke_msg_alloc)(_ke_msg_alloc))(id, dest_id, src_id, param_len);
+
+    app_heap_trace_alloc((param != NULL) ? ke_param2msg(param) : NULL,
+                         sizeof(struct ke_msg) - sizeof(uint32_t) + param_len, id, APP_HEAP_CALLER());
 
-    uart_read(QN_DEBUG_UART, app_uart_env.buf_rx+app_uart_env.len, 1, app_uart_rx_done);
+    return param;
+}
+
+void app_heap_msg_free(struct ke_msg const *msg)
+{
+    app_heap_trace.free_cnt++;
+    app_heap_log('f', msg, 0, 0, 0);
+    app_heap_trace_release(msg);
+    ((p_ke_msg_free)(_ke_msg_free))(msg);
+}
+
+void app_heap_msg_send(void const *param_ptr)
+{
+    app_heap_log('s', ke_param2msg(param_ptr), 0, 0, 0);
+    app_heap_trace_release(ke_param2msg(param_ptr));
+    ((p_ke_msg_send)(_ke_msg_send))(param_ptr);
+}
+
+void app_heap_msg_send_front(void const *param_ptr)
+{
+    app_heap_log('s', ke_param2msg(param_ptr), 0, 0, 0);
+    app_heap_trace_release(ke_param2msg(param_ptr));
+    ((p_ke_msg_send_front)(_ke_msg_send_front))(param_ptr);
+}
+
+void app_heap_msg_forward(void const *param_ptr, ke_task_id_t const dest_id, ke_task_id_t const src_id)
+{
+    app_heap_log('s', ke_param2msg(param_ptr), 0, 0, 0);
+    app_heap_trace_release(ke_param2msg(param_ptr));
+    ((p_ke_msg_forward)(_ke_msg_forward))(param_ptr, dest_id, src_id);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Age the application blocks, called after each ke_schedule().
+ *
+ * A message sent by the application is owned by the kernel and left out, the blocks
+ * which get old are the ones kept on purpose (profile client environments, queues)
+ * and the leaks.
+ *
+ ****************************************************************************************
+ */
+void app_heap_trace_sched(void)
+{
+    uint8_t i;
+
+#if (QN_HEAP_TRACE_LOG)
+    if (app_heap_log_sent)
+    {
+        app_heap_log_sent = false;
+        QPRINTF("heap k\r\n");
+    }
+#endif
+
+    for (i = 0; i < APP_HEAP_BLK_NB; i++)
+    {
+        if ((app_heap_trace.blk[i].ptr != NULL) && (app_heap_trace.blk[i].age != 0xFFFF))
+            app_heap_trace.blk[i].age++;
+    }
+}
+
+/**
+ ****************************************************************************************
+ * @brief Get the allocations of the application.
+ *
+ ****************************************************************************************
+ */
+struct app_heap_trace const *app_heap_trace_get(void)
+{
+    return &app_heap_trace;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Heap size recommended from the peak usage and the largest request.
+ *
+ * The peak covers the stack and the application together, it is read from the pattern
+ * bytes only, so the advice does not depend on how often the statistics are queried.
+ * One more block of the largest request is kept free, with the allocator headers it
+ * needs, so the worst request still fits when the free space is fragmented. The result
+ * is rounded up to a word.
+ *
+ ****************************************************************************************
+ */
+uint16_t app_heap_size_advice(void)
+{
+    uint32_t size = (uint32_t)app_heap_peak() + app_heap_trace.req_max
+                  + APP_HEAP_FREE_HDR + APP_HEAP_USED_HDR;
+
+    return (uint16_t)((size + 3) & ~3UL);
+}
+#endif
+
+#if (QN_32K_RCO)
+/**
+ ****************************************************************************************
+ * @brief End of a temperature conversion or of a 32k capture, in interrupt.
+ *
+ * The ADC is released here, a user which starts it from the kernel after the conversion
+ * finds it free and is not stopped by the calibration.
+ *
+ ****************************************************************************************
+ */
+static void app_rco_cal_isr_cb(void)
+{
+    if (app_rco_cal_env.step == APP_RCO_CAL_TEMP)
+    {
+        temp_sensor_enable(MASK_DISABLE);
+        adc_clock_off();
+        adc_power_off();
+    }
+    ke_evt_set(1UL << EVENT_RCO_CAL_ID);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Filter a new error estimate and adapt the calibration period.
+ *
+ * The estimate is averaged with the previous ones while the temperature is stable, the
+ * RCO follows the temperature so a step restarts the filter. The period doubles while
+ * the filtered error and the temperature hold, it falls back to the minimum on drift.
+ *
+ ****************************************************************************************
+ */
+static void app_rco_cal_update(int32_t raw, int16_t temp_x10)
+{
+    struct app_rco_cal_stat *stat = &app_rco_cal_env.stat;
+    int32_t prev = stat->ppm;
+    int32_t drift;
+    int16_t temp_diff = abs(temp_x10 - stat->temp_x10);
+    bool temp_step = (stat->count == 0) || (temp_diff >= APP_RCO_CAL_TEMP_STEP);
+
+    if (stat->count == 0)
+    {
+        prev = raw;
+        stat->raw_min = raw;
+        stat->raw_max = raw;
+    }
+
+    if (temp_step)
+        stat->ppm = raw;
+    else
+        stat->ppm += (raw - stat->ppm) / (1 << APP_RCO_CAL_FILTER_SHIFT);
+
+    if (raw < stat->raw_min)
+        stat->raw_min = raw;
+    if (raw > stat->raw_max)
+        stat->raw_max = raw;
+
+    drift = abs(stat->ppm - prev);
+    if (drift > stat->drift_max)
+        stat->drift_max = drift;
+
+    // A slow ramp moves less than a step between passes, it still restarts the fast period
+    if (temp_step || drift > 2 * APP_RCO_CAL_DRIFT_LOW || temp_diff > APP_RCO_CAL_TEMP_STEP / 4)
+        stat->period = APP_RCO_CAL_PERIOD_MIN;
+    else if (drift <= APP_RCO_CAL_DRIFT_LOW)
+        stat->period = (stat->period >= APP_RCO_CAL_PERIOD_MAX / 2) ? APP_RCO_CAL_PERIOD_MAX
+                                                                    : stat->period * 2;
+
+    stat->raw = raw;
+    stat->temp_x10 = temp_x10;
+    stat->count++;
+
+    set_32k_ppm(stat->ppm);
+#if (CONFIG_ENABLE_DRIVER_RTC == TRUE)
+    // Do not wait for the 32k domain, the next calibration writes it
+    if (!rtc_calibration_busy())
+        rtc_calibration(stat->ppm < 0, abs(stat->ppm));
+#endif
+}
+
+/**
+ ****************************************************************************************
+ * @brief Run the calibration steps in background.
+ *
+ ****************************************************************************************
+ */
+static void app_rco_cal_evt_handler(void)
+{
+    int32_t sum = 0;
+    uint8_t i;
+
+    ke_evt_clear(1UL << EVENT_RCO_CAL_ID);
+
+    switch (app_rco_cal_env.step)
+    {
+    case APP_RCO_CAL_TEMP:
+        for (i = 0; i < APP_RCO_CAL_TEMP_SAMPLES; i++)
+            sum += app_rco_cal_env.temp_buf[i];
+        app_rco_cal_env.temp_buf[0] = TEMPERATURE_X10(sum / APP_RCO_CAL_TEMP_SAMPLES);
+
+        // Timer1 needs the AHB clock until the capture ends
+        app_rco_cal_env.step = APP_RCO_CAL_CAPTURE;
+        dev_prevent_sleep(PM_MASK_TIMER1_ACTIVE_BIT);
+        clock_32k_correction_start(APP_RCO_CAL_CYCLES, app_rco_cal_isr_cb);
+        break;
+
+    case APP_RCO_CAL_CAPTURE:
+        clock_32k_correction_stop();
+        dev_allow_sleep(PM_MASK_TIMER1_ACTIVE_BIT);
+        app_rco_cal_update(clock_32k_correction_ppm(timer1_env.count, APP_RCO_CAL_CYCLES),
+                           app_rco_cal_env.temp_buf[0]);
+
+        app_rco_cal_env.step = APP_RCO_CAL_IDLE;
+        ke_timer_set(APP_SYS_RCO_CAL_TIMER, TASK_APP, app_rco_cal_env.stat.period);
+        break;
+
+    default:
+        break;
+    }
+}
+
+/**
+ ****************************************************************************************
+ * @brief Initialize the 32k RCO calibration service.
+ *
+ ****************************************************************************************
+ */
+void app_rco_cal_init(void)
+{
+    memset(&app_rco_cal_env, 0, sizeof(app_rco_cal_env));
+    app_rco_cal_env.stat.period = APP_RCO_CAL_PERIOD_MIN;
+
+    if(KE_EVENT_OK != ke_evt_callback_set(EVENT_RCO_CAL_ID, app_rco_cal_evt_handler))
+    {
+        ASSERT_ERR(0);
+    }
+}
+
+/**
+ ****************************************************************************************
+ * @brief Start one calibration with a temperature measurement.
+ *
+ * The steps end in interrupts and go on in background, nothing waits on the hardware.
+ * The ADC has no owner: the pass is put off while another user holds it, and a pass
+ * which lost its conversion to a user starting the ADC meanwhile ends at the timeout.
+ *
+ ****************************************************************************************
+ */
+void app_rco_cal_start(void)
+{
+    adc_read_configuration read_cfg;
+
+    if (app_rco_cal_env.step == APP_RCO_CAL_CAPTURE)
+    {
+        clock_32k_correction_stop();
+        dev_allow_sleep(PM_MASK_TIMER1_ACTIVE_BIT);
+    }
+    app_rco_cal_env.step = APP_RCO_CAL_IDLE;
+
+    if (adc_busy())
+    {
+        app_rco_cal_env.stat.busy_cnt++;
+        ke_timer_set(APP_SYS_RCO_CAL_TIMER, TASK_APP, APP_RCO_CAL_RETRY);
+        return;
+    }
+
+    app_rco_cal_env.step = APP_RCO_CAL_TEMP;
+    // Timeout of the pass, the last step sets the next period
+    ke_timer_set(APP_SYS_RCO_CAL_TIMER, TASK_APP, APP_RCO_CAL_RETRY);
+
+    temp_sensor_enable(MASK_ENABLE);
+    adc_init(ADC_DIFF_WITH_BUF_DRV, ADC_CLK_1000000, ADC_INT_REF, ADC_12BIT);
+    read_cfg.trig_src = ADC_TRIG_SOFT;
+    read_cfg.mode = CONTINUE_MOD;
+    read_cfg.start_ch = TEMP;
+    read_cfg.end_ch = TEMP;
+    adc_read(&read_cfg, app_rco_cal_env.temp_buf, APP_RCO_CAL_TEMP_SAMPLES, app_rco_cal_isr_cb);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Get the 32k RCO calibration statistics.
+ *
+ ****************************************************************************************
+ */
+void app_rco_cal_stat_get(struct app_rco_cal_stat *stat)
+{
+    *stat = app_rco_cal_env.stat;
 }
 #endif
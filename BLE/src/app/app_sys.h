@@ -24,13 +24,27 @@
 #if (QN_DEMO_MENU || QN_EACI)
 #if (QN_DEMO_MENU)
 
+#include "ring.h"
+
 #define QN_UART_RX_LEN      0x10
+/// Size of the ring between the RX interrupt and the background, a power of 2
+#define QN_UART_RING_SIZE   0x20
+
+/// Background event assembling the received lines
+#ifndef EVENT_APP_UART_RX_ID
+#define EVENT_APP_UART_RX_ID    9
+#endif
 
 /// Application UART environment context structure
 struct app_uart_env_tag
 {
     uint8_t len;
     uint8_t buf_rx[QN_UART_RX_LEN];
+    /// Byte being received by the interrupt
+    uint8_t rx_byte;
+    /// Received bytes handed from the RX interrupt to the background
+    struct ring ring;
+    uint8_t ring_buf[QN_UART_RING_SIZE];
 };
 #endif
 
@@ -62,5 +76,229 @@ void app_uart_init(void);
 
 #endif
 
+#if (QN_HEAP_STAT)
+
+/// Fill value of never used heap bytes
+#define APP_HEAP_PATTERN    0xA5
+
+/// BLE heap statistics, all values in bytes
+struct app_heap_stat
+{
+    /// Heap size
+    uint16_t size;
+    /// Sum of the blocks which can be allocated now
+    uint16_t free;
+    /// Largest block which can be allocated now
+    uint16_t largest;
+    /// Highest usage since boot
+    uint16_t peak;
+    /// Fragmentation in percent, 0 when all free bytes are contiguous
+    uint8_t frag;
+};
+
+/*
+ ****************************************************************************************
+ * @brief Prepare the BLE heap for statistics, called before ble_init().
+ ****************************************************************************************
+ */
+void app_heap_stat_init(uint8_t *heap, uint16_t size);
+
+/*
+ ****************************************************************************************
+ * @brief Get the BLE heap statistics.
+ ****************************************************************************************
+ */
+void app_heap_stat_get(struct app_heap_stat *stat);
+
+#if (QN_HEAP_TRACE)
+
+#include "ke_mem.h"
+#include "ke_msg.h"
+
+/// Message identifiers counted in the histogram, further ones are counted in hist_lost
+#define APP_HEAP_HIST_NB    16
+/// Application blocks followed until they are freed or sent, further ones in blk_lost
+#define APP_HEAP_BLK_NB     16
+/// Identifier of the blocks from ke_malloc()
+#define APP_HEAP_ID_MALLOC  0xFFFF
+
+/// Allocations of one message identifier
+struct app_heap_hist
+{
+    /// Message identifier, APP_HEAP_ID_MALLOC for ke_malloc()
+    uint16_t id;
+    /// Largest allocation
+    uint16_t max;
+    /// Number of allocations
+    uint32_t count;
+    /// Bytes of all the allocations
+    uint32_t bytes;
+};
+
+/// Application block still owned by the application
+struct app_heap_blk
+{
+    /// Block, NULL for an unused entry
+    void const *ptr;
+    /// Return address of the allocation
+    uint32_t caller;
+    /// Requested size, message header included
+    uint16_t size;
+    /// Message identifier, APP_HEAP_ID_MALLOC for ke_malloc()
+    uint16_t id;
+    /// Scheduler runs since the allocation, saturated
+    uint16_t age;
+};
+
+/// Allocations made by the application through the ke_malloc()/ke_msg_alloc() wrappers
+struct app_heap_trace
+{
+    /// Allocations, frees and allocations which failed
+    uint32_t alloc_cnt;
+    uint32_t free_cnt;
+    uint32_t fail_cnt;
+    /// Bytes held by the application blocks now and at most
+    uint16_t live;
+    uint16_t live_peak;
+    /// Largest request
+    uint16_t req_max;
+    /// Allocations by message identifier, in the order of their first allocation
+    struct app_heap_hist hist[APP_HEAP_HIST_NB];
+    uint8_t hist_nb;
+    uint32_t hist_lost;
+    /// Blocks not freed nor sent yet
+    struct app_heap_blk blk[APP_HEAP_BLK_NB];
+    uint32_t blk_lost;
+};
+
+/*
+ ****************************************************************************************
+ * @brief Age the application blocks, called after each ke_schedule().
+ ****************************************************************************************
+ */
+void app_heap_trace_sched(void);
+
+/*
+ ****************************************************************************************
+ * @brief Get the allocations of the application.
+ ****************************************************************************************
+ */
+struct app_heap_trace const *app_heap_trace_get(void);
+
+/*
+ ****************************************************************************************
+ * @brief Heap size recommended from the peak usage and the largest request.
+ ****************************************************************************************
+ */
+uint16_t app_heap_size_advice(void);
+
+/*
+ ****************************************************************************************
+ * @brief Tracing wrappers of the kernel heap and message functions, see below.
+ ****************************************************************************************
+ */
+void *app_heap_malloc(uint32_t size);
+void app_heap_free(void *mem_ptr);
+void *app_heap_msg_alloc(ke_msg_id_t const id, ke_task_id_t const dest_id,
+                         ke_task_id_t const src_id, uint16_t const param_len);
+void app_heap_msg_send(void const *param_ptr);
+void app_heap_msg_send_front(void const *param_ptr);
+void app_heap_msg_forward(void const *param_ptr, ke_task_id_t const dest_id, ke_task_id_t const src_id);
+void app_heap_msg_free(struct ke_msg const *msg);
+
+/*
+ * ROM API REDIRECTION
+ ****************************************************************************************
+ */
+
+/// Blocks and messages of the sources which include this header are traced until freed or sent
+#undef ke_malloc
+#define ke_malloc           app_heap_malloc
+#undef ke_free
+#define ke_free             app_heap_free
+#undef ke_msg_alloc
+#define ke_msg_alloc        app_heap_msg_alloc
+#undef ke_msg_send
+#define ke_msg_send         app_heap_msg_send
+#undef ke_msg_send_front
+#define ke_msg_send_front   app_heap_msg_send_front
+#undef ke_msg_forward
+#define ke_msg_forward      app_heap_msg_forward
+#undef ke_msg_free
+#define ke_msg_free         app_heap_msg_free
+
+#endif
+
+#endif
+
+#if (QN_32K_RCO)
+
+/// 32k cycles of a capture, 8 times the driver default for a finer estimate. The capture
+/// runs on Timer1.
+#define APP_RCO_CAL_CYCLES          128
+/// Shortest and longest calibration period, in 10ms
+#define APP_RCO_CAL_PERIOD_MIN      100
+#define APP_RCO_CAL_PERIOD_MAX      6000
+/// Delay of a pass put off while the ADC is in use, and timeout of a pass, in 10ms
+#define APP_RCO_CAL_RETRY           10
+/// Change of the filtered error below which the period doubles, in 2^-20 units
+#define APP_RCO_CAL_DRIFT_LOW       16
+/// Temperature change which restarts the filter and the fast period, in 0.1 degree C
+#define APP_RCO_CAL_TEMP_STEP       20
+/// Weight of a new estimate in the filter is 1/2^APP_RCO_CAL_FILTER_SHIFT
+#define APP_RCO_CAL_FILTER_SHIFT    2
+/// Temperature sensor samples averaged per calibration
+#define APP_RCO_CAL_TEMP_SAMPLES    4
+
+/// Background event of the calibration steps
+#ifndef EVENT_RCO_CAL_ID
+#define EVENT_RCO_CAL_ID            11
+#endif
+
+/// 32k RCO calibration statistics, clock errors in 2^-20 units (about 0.95ppm)
+struct app_rco_cal_stat
+{
+    /// Filtered error given to the stack
+    int32_t ppm;
+    /// Last measured error
+    int32_t raw;
+    /// Lowest and highest measured errors since boot
+    int32_t raw_min;
+    int32_t raw_max;
+    /// Largest change of the filtered error between two calibrations
+    int32_t drift_max;
+    /// Temperature of the last calibration, in 0.1 degree C
+    int16_t temp_x10;
+    /// Current calibration period, in 10ms
+    uint16_t period;
+    /// Number of calibrations since boot
+    uint16_t count;
+    /// Number of passes put off because the ADC was in use
+    uint16_t busy_cnt;
+};
+
+/*
+ ****************************************************************************************
+ * @brief Initialize the 32k RCO calibration service.
+ ****************************************************************************************
+ */
+void app_rco_cal_init(void);
+
+/*
+ ****************************************************************************************
+ * @brief Start one calibration, the next one is scheduled when it ends.
+ ****************************************************************************************
+ */
+void app_rco_cal_start(void);
+
+/*
+ ****************************************************************************************
+ * @brief Get the 32k RCO calibration statistics.
+ ****************************************************************************************
+ */
+void app_rco_cal_stat_get(struct app_rco_cal_stat *stat);
+
+#endif
+
 #endif // _APP_SYS_H_
 
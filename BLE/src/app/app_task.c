@@ -38,10 +38,6 @@
 #include "sleep.h"
 #endif
 
-#if (QN_EACI&&(EACI_MSG_BUFFER_EN==TRUE))
-#include "app_eaci_trans.h"
-#endif
-
 /*
  * FUNCTION DEFINITIONS
  ****************************************************************************************
@@ -84,17 +80,7 @@ static int app_uart_data_ind_handler(ke_msg_id_t const msgid, struct app_uart_da
         break;
     }
 
-#if (QN_EACI&&(EACI_MSG_BUFFER_EN==TRUE))
-    if (eaci_msg_buf_used == EACI_BUF_DEEP) {
-        eaci_trans_init();
-    }
-    if (eaci_msg_buf_used) {
-        eaci_msg_buf_used--;
-    }
-    return (KE_MSG_NO_FREE);
-#else
     return (KE_MSG_CONSUMED);
-#endif
 }
 #endif
 
@@ -114,11 +100,8 @@ static int app_uart_data_ind_handler(ke_msg_id_t const msgid, struct app_uart_da
 static int app_rco_cal_timer_handler(ke_msg_id_t const msgid, void const *param,
                                ke_task_id_t const dest_id, ke_task_id_t const src_id)
 {
-    clock_32k_correction_enable(clock_32k_correction_cb);
-
-    dev_prevent_sleep(PM_MASK_TIMER1_ACTIVE_BIT);
-
-    ke_timer_set(APP_SYS_RCO_CAL_TIMER, TASK_APP, 100);
+    // The service schedules the next calibration
+    app_rco_cal_start();
 
     return (KE_MSG_CONSUMED);
 }
@@ -170,6 +153,10 @@ const struct ke_msg_handler app_default_state[] =
     {APP_SYS_RCO_CAL_TIMER,                 (ke_msg_func_t) app_rco_cal_timer_handler},
 #endif
 
+#if (QN_CONN_POLICY)
+    {APP_CONN_POLICY_TIMER,                 (ke_msg_func_t) app_conn_policy_timer_handler},
+#endif
+
 #if (QN_DEEP_SLEEP_EN && !QN_32K_RCO)
     {APP_SYS_32K_XTAL_WAKEUP_TIMER,         (ke_msg_func_t) app_32k_xtal_wakeup_timer},
 #endif
@@ -185,7 +172,7 @@ const struct ke_msg_handler app_default_state[] =
     {APP_SYS_BUTTON_1_TIMER,                (ke_msg_func_t) app_button_timer_handler},
     {APP_SYS_BUTTON_2_TIMER,                (ke_msg_func_t) app_button_timer_handler},
 #if (FB_JOYSTICKS)
-		{APP_KEY_PROCESS_TIMER,						(ke_msg_func_t) app_key_process_timer_handler},
+		{APP_KEY_IND,											(ke_msg_func_t) app_key_ind_handler},
 		{APP_KEY_SCAN_TIMER,						(ke_msg_func_t) app_key_scan_timer_handler},
 #endif
 #if	(FB_OLED)
@@ -352,6 +339,7 @@ const struct ke_msg_handler app_default_state[] =
     {HRPS_CFG_INDNTF_IND,                   (ke_msg_func_t) app_hrps_cfg_indntf_ind_handler},
     {HRPS_ENERGY_EXP_RESET_IND,             (ke_msg_func_t) app_hrps_energy_exp_reset_ind_handler},
     {HRPS_CREATE_DB_CFM,                    (ke_msg_func_t) app_hrps_create_db_cfm_handler},
+    {APP_HRPS_RR_TIMER,                     (ke_msg_func_t) app_hrps_rr_timer_handler},
     #if (!QN_WORK_MODE && !QN_EACI && !QN_EAPI)
     {APP_HRPS_TIMER,                        (ke_msg_func_t) app_hrps_timer_handler},
     #endif
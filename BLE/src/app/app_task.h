@@ -43,8 +43,13 @@
  ****************************************************************************************
  */
 
-/// number of APP Instance
+/// number of APP Instance, the GATT client queue sends the requests of each connection
+/// from its own instance, see PRF_GATTQ_TASK()
+#if (QN_GATT_QUEUE)
+#define APP_IDX_MAX                                 (1 + BLE_CONNECTION_MAX)
+#else
 #define APP_IDX_MAX                                 0x01
+#endif
 
 /// states of APP task
 enum
@@ -73,11 +78,13 @@ enum
     APP_SYS_32K_XTAL_WAKEUP_TIMER,
 
     APP_SYS_TIME_CHECK_TIMER,
+    APP_CONN_POLICY_TIMER,
 
     APP_SYS_BUTTON_1_TIMER,
     APP_SYS_BUTTON_2_TIMER,
 #if (FB_JOYSTICKS)
-    APP_KEY_PROCESS_TIMER,
+    /// Joystick key event
+    APP_KEY_IND,
     APP_KEY_SCAN_TIMER,
 #endif
 #if		(FB_OLED)
@@ -100,6 +107,7 @@ enum
     APP_PROXR_ALERT_STOP_TIMER,
     APP_BLPS_PRESSURE_TIMER,
     APP_HRPS_TIMER,
+    APP_HRPS_RR_TIMER,
     APP_TIPS_CURRENT_TIME_TIMER,
     APP_SCPPS_SCAN_REFRESH_TIMER,
     APP_BASS_BATT_LEVEL_TIMER,
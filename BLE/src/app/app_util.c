@@ -17,6 +17,9 @@
 #if !QN_WORK_MODE
 #include "qnrf.h"
 #endif
+#if (QN_TASK_PROF)
+#include "task_prof.h"
+#endif
 
 #if (defined(CFG_EACI))
 extern struct device_name_set device_name;
@@ -288,6 +291,9 @@ bool app_get_bond_status(uint8_t idx, uint8_t key_flag)
 #if (QN_SECURITY_ON)
 bool app_add_bonded_dev(void *bonded_dev)
 {
+#if (QN_RPA_RESOLVE)
+    app_rpa_reset();
+#endif
     if (app_env.bonded_count < APP_MAX_BONDED_DEVICE_NUMBER)
     {
         app_env.bonded_info[app_env.bonded_count++] = *(struct app_bonded_info *)bonded_dev;
@@ -351,6 +357,248 @@ uint8_t app_find_bonded_dev(struct bd_addr const *addr)
 }
 #endif
 
+#if (QN_RPA_RESOLVE)
+/// Resolved private address
+struct app_rpa_cache
+{
+    struct bd_addr addr;
+    /// Bonded device index
+    uint8_t bond;
+};
+
+/// Private address resolver environment
+struct app_rpa_env_tag
+{
+    /// Expanded IRK of each bonded device, MSB first
+    uint8_t rk[APP_MAX_BONDED_DEVICE_NUMBER][APP_AES_RK_LEN];
+    /// Bonded device distributed its IRK
+    bool irk[APP_MAX_BONDED_DEVICE_NUMBER];
+    /// IRKs are expanded
+    bool ready;
+    /// Recently resolved addresses
+    struct app_rpa_cache cache[APP_RPA_CACHE_NB];
+    /// Valid cache entries
+    uint8_t cache_nb;
+    /// Next cache entry to replace
+    uint8_t cache_pos;
+};
+
+static struct app_rpa_env_tag app_rpa_env;
+
+/// AES S-box
+static const uint8_t app_aes_sbox[256] =
+{
+    0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
+    0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
+    0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
+    0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75,
+    0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84,
+    0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
+    0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8,
+    0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2,
+    0xcd, 0x0c, 0x13, 0xec, 0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
+    0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb,
+    0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79,
+    0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
+    0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a,
+    0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e,
+    0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
+    0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16
+};
+
+/**
+ ****************************************************************************************
+ * @brief Multiply by x in GF(2^8)
+ *
+ ****************************************************************************************
+ */
+static uint8_t app_aes_xtime(uint8_t x)
+{
+    return (uint8_t)((x << 1) ^ ((x & 0x80) ? 0x1b : 0x00));
+}
+
+/**
+ ****************************************************************************************
+ * @brief Expand an IRK into the AES-128 round keys
+ *
+ ****************************************************************************************
+ */
+static void app_aes_expand(struct smp_key const *irk, uint8_t *rk)
+{
+    uint8_t rcon = 0x01;
+    uint8_t t[4], tmp;
+    int i;
+
+    // IRK is LSB first, AES works MSB first
+    for (i = 0; i < KEY_LEN; i++)
+        rk[i] = irk->key[KEY_LEN - 1 - i];
+
+    for (i = KEY_LEN; i < APP_AES_RK_LEN; i += 4)
+    {
+        t[0] = rk[i - 4];
+        t[1] = rk[i - 3];
+        t[2] = rk[i - 2];
+        t[3] = rk[i - 1];
+        if ((i % KEY_LEN) == 0)
+        {
+            tmp = t[0];
+            t[0] = app_aes_sbox[t[1]] ^ rcon;
+            t[1] = app_aes_sbox[t[2]];
+            t[2] = app_aes_sbox[t[3]];
+            t[3] = app_aes_sbox[tmp];
+            rcon = app_aes_xtime(rcon);
+        }
+        rk[i + 0] = rk[i - 16] ^ t[0];
+        rk[i + 1] = rk[i - 15] ^ t[1];
+        rk[i + 2] = rk[i - 14] ^ t[2];
+        rk[i + 3] = rk[i - 13] ^ t[3];
+    }
+}
+
+/**
+ ****************************************************************************************
+ * @brief Encrypt one block in place with expanded round keys
+ *
+ ****************************************************************************************
+ */
+static void app_aes_encrypt(uint8_t const *rk, uint8_t *s)
+{
+    uint8_t t[KEY_LEN];
+    uint8_t a, b, c, d, e;
+    int r, i;
+
+    for (i = 0; i < KEY_LEN; i++)
+        s[i] ^= rk[i];
+
+    for (r = 1; r <= 10; r++)
+    {
+        // SubBytes and ShiftRows, the state is column major
+        for (i = 0; i < KEY_LEN; i++)
+            t[i] = app_aes_sbox[s[(i + 4 * (i & 3)) & 0x0f]];
+
+        // MixColumns, skipped in the last round
+        for (i = 0; i < KEY_LEN; i += 4)
+        {
+            a = t[i];
+            b = t[i + 1];
+            c = t[i + 2];
+            d = t[i + 3];
+            if (r != 10)
+            {
+                e = a ^ b ^ c ^ d;
+                s[i + 0] = a ^ e ^ app_aes_xtime(a ^ b);
+                s[i + 1] = b ^ e ^ app_aes_xtime(b ^ c);
+                s[i + 2] = c ^ e ^ app_aes_xtime(c ^ d);
+                s[i + 3] = d ^ e ^ app_aes_xtime(d ^ a);
+            }
+            else
+            {
+                s[i + 0] = a;
+                s[i + 1] = b;
+                s[i + 2] = c;
+                s[i + 3] = d;
+            }
+        }
+
+        for (i = 0; i < KEY_LEN; i++)
+            s[i] ^= rk[r * KEY_LEN + i];
+    }
+}
+
+/**
+ ****************************************************************************************
+ * @brief Check a private address against one expanded IRK
+ *
+ ****************************************************************************************
+ */
+static bool app_rpa_match(uint8_t const *rk, struct bd_addr const *addr)
+{
+    uint8_t s[KEY_LEN];
+
+    // ah(k, r) = e(k, padding || prand) mod 2^24, prand is addr[3~5] and hash addr[0~2]
+    memset(s, 0, KEY_LEN - 3);
+    s[KEY_LEN - 3] = addr->addr[5];
+    s[KEY_LEN - 2] = addr->addr[4];
+    s[KEY_LEN - 1] = addr->addr[3];
+    app_aes_encrypt(rk, s);
+
+    return (s[KEY_LEN - 1] == addr->addr[0])
+        && (s[KEY_LEN - 2] == addr->addr[1])
+        && (s[KEY_LEN - 3] == addr->addr[2]);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Resolve a private address against all the bonded IRKs
+ *
+ * @param[in] addr      Peer resolvable private address
+ * @return Bonded device index, GAP_INVALID_CONIDX if no IRK matches
+ *
+ * The IRKs are expanded once after the bonded database changes, so one resolution costs
+ * one AES block per bonded device, or nothing when the address was resolved recently.
+ *
+ ****************************************************************************************
+ */
+uint8_t app_rpa_resolve(struct bd_addr const *addr)
+{
+    uint8_t i, idx = GAP_INVALID_CONIDX;
+
+    // Resolvable private address has 0b01 in the two most significant bits
+    if ((addr->addr[BD_ADDR_LEN - 1] & 0xC0) != 0x40)
+        return GAP_INVALID_CONIDX;
+
+    for (i = 0; i < app_rpa_env.cache_nb; i++)
+    {
+        if (true == co_bt_bdaddr_compare(addr, &app_rpa_env.cache[i].addr))
+            return app_rpa_env.cache[i].bond;
+    }
+
+    if (!app_rpa_env.ready)
+    {
+        for (i = 0; i < app_env.bonded_count; i++)
+        {
+            app_rpa_env.irk[i] = app_get_bond_status(i, SMP_KDIST_IDKEY);
+            if (app_rpa_env.irk[i])
+                app_aes_expand(&app_env.bonded_info[i].pair_info.irk, app_rpa_env.rk[i]);
+        }
+        app_rpa_env.ready = true;
+    }
+
+    for (i = 0; i < app_env.bonded_count; i++)
+    {
+        if (app_rpa_env.irk[i] && app_rpa_match(app_rpa_env.rk[i], addr))
+        {
+            idx = i;
+            break;
+        }
+    }
+
+    if (idx != GAP_INVALID_CONIDX)
+    {
+        app_rpa_env.cache[app_rpa_env.cache_pos].addr = *addr;
+        app_rpa_env.cache[app_rpa_env.cache_pos].bond = idx;
+        app_rpa_env.cache_pos = (app_rpa_env.cache_pos + 1) % APP_RPA_CACHE_NB;
+        if (app_rpa_env.cache_nb < APP_RPA_CACHE_NB)
+            app_rpa_env.cache_nb++;
+    }
+
+    return idx;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Drop the precomputed IRKs and the resolved address cache
+ *
+ ****************************************************************************************
+ */
+void app_rpa_reset(void)
+{
+    app_rpa_env.ready = false;
+    app_rpa_env.cache_nb = 0;
+    app_rpa_env.cache_pos = 0;
+}
+#endif
+
 /**
  ****************************************************************************************
  * @brief Check Service setup FLAG and Initiate SMP IRK and CSRK
@@ -442,6 +690,11 @@ uint16_t app_get_local_service_flag(void)
 void app_clear_local_service_flag(uint16_t srv_bit)
 {
     app_env.srv_flag &= ~srv_bit;
+#if (QN_TASK_PROF)
+    // Last database confirmed, the boot time of the server databases is known
+    if (app_env.srv_flag == 0)
+        task_prof_svc_db_end();
+#endif
 }
 #endif
 
@@ -845,6 +1098,9 @@ void app_set_client_service_status(uint16_t conhdl)
 #if (BLE_PERIPHERAL)
 void app_create_server_service_DB(void)
 {
+#if (QN_TASK_PROF)
+    task_prof_svc_db_start();
+#endif
 #if (BLE_AN_SERVER)
     app_anps_create_db(app_anps_env->supp_new_alert_cat, app_anps_env->supp_unread_alert_cat);
 #endif
@@ -1627,5 +1883,261 @@ bool app_parser_adv_data(uint8_t *pdata, uint8_t total_len, struct app_adv_data
  */
 bool app_check_update_conn_param(struct gap_conn_param_update const *conn_param)
 {
+    // Connection interval 7.5ms to 4s, unit 1.25ms
+    if ((conn_param->intv_min < 0x0006) || (conn_param->intv_max > 0x0C80)
+        || (conn_param->intv_min > conn_param->intv_max))
+        return false;
+
+    // Slave latency 0 to 499
+    if (conn_param->latency > 0x01F3)
+        return false;
+
+    // Supervision timeout 100ms to 32s, unit 10ms
+    if ((conn_param->time_out < 0x000A) || (conn_param->time_out > 0x0C80))
+        return false;
+
+    // Supervision timeout shall be larger than (1 + latency) * intv_max * 2
+    if ((uint32_t)conn_param->time_out * 4 <= (uint32_t)(1 + conn_param->latency) * conn_param->intv_max)
+        return false;
+
     return true;
 }
+
+#if (QN_CONN_POLICY)
+/// Connection parameter sets of the policy
+enum
+{
+    APP_CONN_POLICY_NONE,
+    APP_CONN_POLICY_FAST,
+    APP_CONN_POLICY_SLOW
+};
+
+/// Connection parameter policy environment
+struct app_conn_policy_env_tag
+{
+    /// Connection handle of the slave link, GAP_INVALID_CONHDL when not connected
+    uint16_t conhdl;
+    /// Bytes exchanged during the current tick
+    uint16_t bytes;
+    /// Ticks without traffic
+    uint16_t idle;
+    /// Ticks left before a new update request is allowed
+    uint16_t holdoff;
+    /// Parameter set the current connection parameters belong to
+    uint8_t mode;
+    /// Parameter set requested, APP_CONN_POLICY_NONE when no request is in progress
+    uint8_t req_mode;
+    /// Number of bulk transfers in progress
+    uint8_t busy;
+};
+
+static struct app_conn_policy_env_tag app_conn_policy_env = {GAP_INVALID_CONHDL};
+
+/**
+ ****************************************************************************************
+ * @brief Classify connection parameters
+ *
+ ****************************************************************************************
+ */
+static uint8_t app_conn_policy_mode(uint16_t interval, uint16_t latency)
+{
+    if ((latency == 0) && (interval <= APP_CONN_POLICY_FAST_INTV_MAX))
+        return APP_CONN_POLICY_FAST;
+
+    // Slave latency stretches the interval between two radio events
+    if ((uint32_t)interval * (1 + latency) >= APP_CONN_POLICY_SLOW_INTV_MIN)
+        return APP_CONN_POLICY_SLOW;
+
+    return APP_CONN_POLICY_NONE;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Request one of the policy parameter sets
+ *
+ ****************************************************************************************
+ */
+static void app_conn_policy_request(uint8_t mode)
+{
+    struct gap_conn_param_update conn_par;
+
+    if (mode == APP_CONN_POLICY_FAST)
+    {
+        conn_par.intv_min = APP_CONN_POLICY_FAST_INTV_MIN;
+        conn_par.intv_max = APP_CONN_POLICY_FAST_INTV_MAX;
+        conn_par.latency = 0;
+        conn_par.time_out = APP_CONN_POLICY_FAST_TO;
+    }
+    else
+    {
+        conn_par.intv_min = APP_CONN_POLICY_SLOW_INTV_MIN;
+        conn_par.intv_max = APP_CONN_POLICY_SLOW_INTV_MAX;
+        conn_par.latency = APP_CONN_POLICY_SLOW_LATENCY;
+        conn_par.time_out = APP_CONN_POLICY_SLOW_TO;
+    }
+
+    app_conn_policy_env.req_mode = mode;
+    app_conn_policy_env.holdoff = APP_CONN_POLICY_HOLDOFF;
+    app_gap_param_update_req(app_conn_policy_env.conhdl, &conn_par);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Start the connection parameter policy on a new slave link
+ *
+ ****************************************************************************************
+ */
+void app_conn_policy_start(uint16_t conhdl, uint16_t interval, uint16_t latency)
+{
+    app_conn_policy_env.conhdl = conhdl;
+    app_conn_policy_env.bytes = 0;
+    app_conn_policy_env.idle = 0;
+    app_conn_policy_env.busy = 0;
+    app_conn_policy_env.mode = app_conn_policy_mode(interval, latency);
+    app_conn_policy_env.req_mode = APP_CONN_POLICY_NONE;
+    // Leave the master some time for its own procedures after connection
+    app_conn_policy_env.holdoff = APP_CONN_POLICY_HOLDOFF;
+
+    ke_timer_set(APP_CONN_POLICY_TIMER, TASK_APP, APP_CONN_POLICY_TICK);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Stop the connection parameter policy when the slave link is lost
+ *
+ ****************************************************************************************
+ */
+void app_conn_policy_stop(uint16_t conhdl)
+{
+    if (conhdl == app_conn_policy_env.conhdl)
+    {
+        app_conn_policy_env.conhdl = GAP_INVALID_CONHDL;
+        ke_timer_clear(APP_CONN_POLICY_TIMER, TASK_APP);
+    }
+}
+
+/**
+ ****************************************************************************************
+ * @brief Account data sent or received on the slave link
+ *
+ ****************************************************************************************
+ */
+void app_conn_policy_traffic(uint16_t len)
+{
+    uint16_t bytes = app_conn_policy_env.bytes + len;
+
+    // Saturate, only the burst threshold matters
+    app_conn_policy_env.bytes = (bytes < len) ? 0xFFFF : bytes;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Mark the start or the end of a bulk transfer, the link stays fast meanwhile
+ *
+ ****************************************************************************************
+ */
+void app_conn_policy_busy(bool busy)
+{
+    if (busy)
+        app_conn_policy_env.busy++;
+    else if (app_conn_policy_env.busy)
+        app_conn_policy_env.busy--;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Outcome of a connection parameter update request sent by the policy
+ *
+ ****************************************************************************************
+ */
+void app_conn_policy_update_resp(bool accepted)
+{
+    if (app_conn_policy_env.req_mode == APP_CONN_POLICY_NONE)
+        return;
+
+    if (accepted)
+    {
+        // Refined by app_conn_policy_param_ind() when the link is updated
+        app_conn_policy_env.mode = app_conn_policy_env.req_mode;
+    }
+    else
+    {
+        // The peer does not want these parameters now, do not insist
+        app_conn_policy_env.holdoff = APP_CONN_POLICY_REJECT_HOLDOFF;
+    }
+    app_conn_policy_env.req_mode = APP_CONN_POLICY_NONE;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Connection parameters of the slave link have been changed
+ *
+ ****************************************************************************************
+ */
+void app_conn_policy_param_ind(uint16_t interval, uint16_t latency)
+{
+    if (app_conn_policy_env.conhdl == GAP_INVALID_CONHDL)
+        return;
+
+    // Parameters chosen by the master are followed as they are
+    app_conn_policy_env.mode = app_conn_policy_mode(interval, latency);
+    app_conn_policy_env.req_mode = APP_CONN_POLICY_NONE;
+    // Out of both sets, the master wants its own parameters: do not insist
+    if (app_conn_policy_env.mode == APP_CONN_POLICY_NONE)
+        app_conn_policy_env.holdoff = APP_CONN_POLICY_REJECT_HOLDOFF;
+
+    QPRINTF("Conn policy: %d radio events/s.\r\n", 800 / ((uint32_t)interval * (1 + latency)));
+}
+
+/**
+ ****************************************************************************************
+ * @brief Handles the connection parameter policy timer
+ *
+ * @param[in] msgid     APP_CONN_POLICY_TIMER
+ * @param[in] param     None
+ * @param[in] dest_id   TASK_APP
+ * @param[in] src_id    TASK_APP
+ *
+ * @return If the message was consumed or not.
+ ****************************************************************************************
+ */
+int app_conn_policy_timer_handler(ke_msg_id_t const msgid, void const *param,
+                                  ke_task_id_t const dest_id, ke_task_id_t const src_id)
+{
+    uint8_t target = APP_CONN_POLICY_NONE;
+
+    if (app_conn_policy_env.busy || (app_conn_policy_env.bytes >= APP_CONN_POLICY_BURST_LEN))
+    {
+        app_conn_policy_env.idle = 0;
+        target = APP_CONN_POLICY_FAST;
+    }
+    else if (app_conn_policy_env.bytes == 0)
+    {
+        if (app_conn_policy_env.idle < APP_CONN_POLICY_IDLE_TICKS)
+            app_conn_policy_env.idle++;
+        else
+            target = APP_CONN_POLICY_SLOW;
+    }
+    else
+    {
+        // Light traffic keeps the current parameters
+        app_conn_policy_env.idle = 0;
+    }
+    app_conn_policy_env.bytes = 0;
+
+    if (app_conn_policy_env.holdoff)
+    {
+        app_conn_policy_env.holdoff--;
+    }
+    else if ((target != APP_CONN_POLICY_NONE)
+             && (target != app_conn_policy_env.mode)
+             && (app_conn_policy_env.req_mode == APP_CONN_POLICY_NONE))
+    {
+        app_conn_policy_request(target);
+    }
+
+    ke_timer_set(APP_CONN_POLICY_TIMER, TASK_APP, APP_CONN_POLICY_TICK);
+
+    return (KE_MSG_CONSUMED);
+}
+#endif
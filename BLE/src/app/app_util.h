@@ -43,6 +43,52 @@
 #define BLE_RSCP_SERVER_BIT         0x4000
 #define BLE_QPPS_SERVER_BIT         0x8000
 
+#if (QN_CONN_POLICY)
+// Connection parameter policy, interval unit 1.25ms, timeout unit 10ms
+/// Policy evaluation period, unit 10ms
+#ifndef APP_CONN_POLICY_TICK
+#define APP_CONN_POLICY_TICK            100
+#endif
+/// Bytes per tick which start a burst
+#ifndef APP_CONN_POLICY_BURST_LEN
+#define APP_CONN_POLICY_BURST_LEN       200
+#endif
+/// Ticks without traffic before the link goes slow
+#ifndef APP_CONN_POLICY_IDLE_TICKS
+#define APP_CONN_POLICY_IDLE_TICKS      5
+#endif
+/// Minimum ticks between two update requests
+#ifndef APP_CONN_POLICY_HOLDOFF
+#define APP_CONN_POLICY_HOLDOFF         5
+#endif
+/// Ticks to wait after the peer rejected a request
+#ifndef APP_CONN_POLICY_REJECT_HOLDOFF
+#define APP_CONN_POLICY_REJECT_HOLDOFF  30
+#endif
+/// Fast parameters, 15ms to 30ms
+#ifndef APP_CONN_POLICY_FAST_INTV_MIN
+#define APP_CONN_POLICY_FAST_INTV_MIN   0x000C
+#define APP_CONN_POLICY_FAST_INTV_MAX   0x0018
+#define APP_CONN_POLICY_FAST_TO         0x012C
+#endif
+/// Slow parameters, 480ms to 500ms with slave latency 2
+#ifndef APP_CONN_POLICY_SLOW_INTV_MIN
+#define APP_CONN_POLICY_SLOW_INTV_MIN   0x0180
+#define APP_CONN_POLICY_SLOW_INTV_MAX   0x0190
+#define APP_CONN_POLICY_SLOW_LATENCY    2
+#define APP_CONN_POLICY_SLOW_TO         0x0258
+#endif
+#endif
+
+#if (QN_RPA_RESOLVE)
+/// Number of recently resolved private addresses kept
+#ifndef APP_RPA_CACHE_NB
+#define APP_RPA_CACHE_NB                4
+#endif
+/// AES-128 expanded key length, kept in RAM for each bonded device
+#define APP_AES_RK_LEN                  176
+#endif
+
 // Advertising data FLAG
 #define AD_TYPE_NAME_BIT            0x0001
 #define AD_TYPE_16bitUUID_BIT       0x0002
@@ -197,6 +243,24 @@ bool app_add_bonded_dev(void *bonded_dev);
  */
 uint8_t app_find_bonded_dev(struct bd_addr const *addr);
 
+#if (QN_RPA_RESOLVE)
+/*
+ ****************************************************************************************
+ * @brief Resolve a private address against all the bonded IRKs
+ *
+ ****************************************************************************************
+ */
+uint8_t app_rpa_resolve(struct bd_addr const *addr);
+
+/*
+ ****************************************************************************************
+ * @brief Drop the precomputed IRKs and the resolved address cache
+ *
+ ****************************************************************************************
+ */
+void app_rpa_reset(void);
+#endif
+
 /*
  ****************************************************************************************
  * @brief Check Service setup FLAG and Initiate SMP IRK and CSRK
@@ -325,5 +389,64 @@ bool app_parser_adv_data(uint8_t *pdata, uint8_t total_len, struct app_adv_data
  */
 bool app_check_update_conn_param(struct gap_conn_param_update const *conn_param);
 
+#if (QN_CONN_POLICY)
+/*
+ ****************************************************************************************
+ * @brief Start the connection parameter policy on a new slave link
+ *
+ ****************************************************************************************
+ */
+void app_conn_policy_start(uint16_t conhdl, uint16_t interval, uint16_t latency);
+
+/*
+ ****************************************************************************************
+ * @brief Stop the connection parameter policy when the slave link is lost
+ *
+ ****************************************************************************************
+ */
+void app_conn_policy_stop(uint16_t conhdl);
+
+/*
+ ****************************************************************************************
+ * @brief Account data sent or received on the slave link
+ *
+ ****************************************************************************************
+ */
+void app_conn_policy_traffic(uint16_t len);
+
+/*
+ ****************************************************************************************
+ * @brief Mark the start or the end of a bulk transfer
+ *
+ ****************************************************************************************
+ */
+void app_conn_policy_busy(bool busy);
+
+/*
+ ****************************************************************************************
+ * @brief Outcome of a connection parameter update request
+ *
+ ****************************************************************************************
+ */
+void app_conn_policy_update_resp(bool accepted);
+
+/*
+ ****************************************************************************************
+ * @brief Connection parameters of the slave link have been changed
+ *
+ ****************************************************************************************
+ */
+void app_conn_policy_param_ind(uint16_t interval, uint16_t latency);
+
+/*
+ ****************************************************************************************
+ * @brief Handles the connection parameter policy timer
+ *
+ ****************************************************************************************
+ */
+int app_conn_policy_timer_handler(ke_msg_id_t const msgid, void const *param,
+                                  ke_task_id_t const dest_id, ke_task_id_t const src_id);
+#endif
+
 #endif
 
@@ -63,13 +63,25 @@
 void app_bass_create_db(uint8_t bas_nb, uint8_t *features)
 {
     uint8_t i;
+#if (QN_SVC_DB_DIRECT)
+    struct bass_create_db_req req;
+    struct bass_create_db_req *msg = &req;
+#else
     struct bass_create_db_req * msg = KE_MSG_ALLOC(BASS_CREATE_DB_REQ, TASK_BASS, TASK_APP, bass_create_db_req);
+#endif
 
     msg->bas_nb = bas_nb;
     // Features of each BAS instance
     for (i = 0; i < bas_nb; i++)
         msg->features[i] = features[i];
+#if (QN_SVC_DB_DIRECT)
+    struct bass_create_db_cfm cfm;
+
+    cfm.status = bass_create_db(msg);
+    app_bass_create_db_cfm_handler(BASS_CREATE_DB_CFM, &cfm, TASK_APP, TASK_BASS);
+#else
     ke_msg_send(msg);
+#endif
 }
 
 /*
@@ -28,6 +28,7 @@
 
 #if BLE_BP_COLLECTOR
 #include "app_blpc.h"
+#include "ieee11073.h"
 
 /// @cond
 /*
@@ -185,7 +186,11 @@ int app_blpc_bp_meas_ind_handler(ke_msg_id_t const msgid,
                       ke_task_id_t const dest_id,
                       ke_task_id_t const src_id)
 {
+    int32_t pulse_rate = 0;
 #if QN_DBG_TRACE_MORE  
+    int32_t pressure[3] = {0, 0, 0};
+    int8_t exp = (param->meas_val.flags & BPS_FLAG_KPA) ? -2 : 0;
+
     if (param->meas_val.flags & BPS_FLAG_TIME_STAMP_PRESENT)
         QPRINTF("Date: %04d:%02d:%02d Time: %02d:%02d:%02d\r\n", 
             param->meas_val.time_stamp.year,
@@ -196,26 +201,33 @@ int app_blpc_bp_meas_ind_handler(ke_msg_id_t const msgid,
             param->meas_val.time_stamp.sec);
 #endif
 
+    if (param->meas_val.flags & BPS_FLAG_PULSE_RATE_PRESENT)
+        ieee11073_sfloat_decode(param->meas_val.pulse_rate, 0, &pulse_rate);
+
     QPRINTF("BP Value(%d), Flag:%X, User ID:%X, Meas Status:%X, Pulse Rate:%d\r\n",
         param->flag_interm_cp,
         param->meas_val.flags,
         (param->meas_val.flags & BPS_FLAG_USER_ID_PRESENT) ? param->meas_val.user_id : 0,
         (param->meas_val.flags & BPS_FLAG_MEAS_STATUS_PRESENT) ? param->meas_val.meas_status : 0,
-        (param->meas_val.flags & BPS_FLAG_PULSE_RATE_PRESENT) ? param->meas_val.pulse_rate : 0
+        pulse_rate
         );
 
 #if QN_DBG_TRACE_MORE    
+    // Hundredths of kPa or mmHg
+    ieee11073_sfloat_decode(param->meas_val.systolic, exp, &pressure[0]);
+    ieee11073_sfloat_decode(param->meas_val.diastolic, exp, &pressure[1]);
+    ieee11073_sfloat_decode(param->meas_val.mean_arterial_pressure, exp, &pressure[2]);
     if (param->meas_val.flags & BPS_FLAG_KPA)
-        QPRINTF("Systolic:0x%X(kpa), Diastolic:0x%X(kpa), Mean Arterial Pressure:0x%X(kpa)\r\r\n",
-            param->meas_val.systolic,
-            param->meas_val.diastolic,
-            param->meas_val.mean_arterial_pressure
+        QPRINTF("Systolic:%d.%02d(kpa), Diastolic:%d.%02d(kpa), Mean Arterial Pressure:%d.%02d(kpa)\r\r\n",
+            pressure[0] / 100, pressure[0] % 100,
+            pressure[1] / 100, pressure[1] % 100,
+            pressure[2] / 100, pressure[2] % 100
             );
     else
         QPRINTF("Systolic:%d(mmhg), Diastolic:%d(mmhg), Mean Arterial Pressure:%d(mmhg)\r\r\n",
-            param->meas_val.systolic,
-            param->meas_val.diastolic,
-            param->meas_val.mean_arterial_pressure
+            pressure[0],
+            pressure[1],
+            pressure[2]
             );
 #endif
     app_task_msg_hdl(msgid, param);
@@ -70,11 +70,23 @@
  */
 void app_blps_create_db(uint8_t features)
 {
+#if (QN_SVC_DB_DIRECT)
+    struct blps_create_db_req req;
+    struct blps_create_db_req *msg = &req;
+#else
     struct blps_create_db_req * msg = KE_MSG_ALLOC(BLPS_CREATE_DB_REQ, TASK_BLPS, TASK_APP,
                                                    blps_create_db_req);
+#endif
 
     msg->features = features;
+#if (QN_SVC_DB_DIRECT)
+    struct blps_create_db_cfm cfm;
+
+    cfm.status = blps_create_db(msg);
+    app_blps_create_db_cfm_handler(BLPS_CREATE_DB_CFM, &cfm, TASK_APP, TASK_BLPS);
+#else
     ke_msg_send(msg);
+#endif
 }
 
 /*
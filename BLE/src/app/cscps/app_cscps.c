@@ -57,13 +57,27 @@
  */
 void app_cscps_create_db(uint16_t csc_feature, uint8_t sensor_loc_supp, uint8_t sensor_loc)
 {
+#if (QN_SVC_DB_DIRECT)
+    struct cscps_create_db_req req;
+    struct cscps_create_db_req *msg = &req;
+#else
     struct cscps_create_db_req * msg = KE_MSG_ALLOC(CSCPS_CREATE_DB_REQ, TASK_CSCPS, TASK_APP, cscps_create_db_req);
+#endif
 
     msg->csc_feature = csc_feature;
     msg->sensor_loc_supp = sensor_loc_supp;
     // Sensor location
     msg->sensor_loc = sensor_loc;
+#if (QN_SVC_DB_DIRECT)
+    struct cscps_cmp_evt evt;
+
+    evt.conhdl = GAP_INVALID_CONHDL;
+    evt.operation = CSCPS_CREATE_DB_OP_CODE;
+    evt.status = cscps_create_db(msg);
+    app_cscps_cmp_evt_handler(CSCPS_CMP_EVT, &evt, TASK_APP, TASK_CSCPS);
+#else
     ke_msg_send(msg);
+#endif
 }
 
 /*
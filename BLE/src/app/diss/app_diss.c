@@ -71,10 +71,22 @@
  */
 void app_diss_create_db(uint16_t features)
 {
+#if (QN_SVC_DB_DIRECT)
+    struct diss_create_db_req req;
+    struct diss_create_db_req *msg = &req;
+#else
     struct diss_create_db_req *msg = KE_MSG_ALLOC(DISS_CREATE_DB_REQ, TASK_DISS, TASK_APP, diss_create_db_req);
+#endif
 
     msg->features = features;
+#if (QN_SVC_DB_DIRECT)
+    struct diss_create_db_cfm cfm;
+
+    cfm.status = diss_create_db(msg);
+    app_diss_create_db_cfm_handler(DISS_CREATE_DB_CFM, &cfm, TASK_APP, TASK_DISS);
+#else
     ke_msg_send(msg);
+#endif
 }
 
 /*
@@ -60,10 +60,22 @@
  */
 void app_findt_create_db(void)
 {
+#if (QN_SVC_DB_DIRECT)
+    struct findt_create_db_req req;
+    struct findt_create_db_req *msg = &req;
+#else
     struct findt_create_db_req * msg = KE_MSG_ALLOC(FINDT_CREATE_DB_REQ, TASK_FINDT, TASK_APP,
                                                     findt_create_db_req);
+#endif
 
+#if (QN_SVC_DB_DIRECT)
+    struct findt_create_db_cfm cfm;
+
+    cfm.status = findt_create_db(msg);
+    app_findt_create_db_cfm_handler(FINDT_CREATE_DB_CFM, &cfm, TASK_APP, TASK_FINDT);
+#else
     ke_msg_send(msg);
+#endif
 }
 
 /*
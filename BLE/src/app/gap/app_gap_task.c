@@ -548,6 +548,14 @@ int app_gap_le_create_conn_req_cmp_evt_handler(ke_msg_id_t const msgid, struct g
 #if (BLE_PERIPHERAL)
         app_enable_server_service(true, param->conn_info.conhdl);
 #endif
+
+#if (QN_CONN_POLICY)
+        if (app_get_role() == GAP_PERIPHERAL_SLV)
+        {
+            app_conn_policy_start(param->conn_info.conhdl, param->conn_info.con_interval,
+                                  param->conn_info.con_latency);
+        }
+#endif
     }
 
     app_task_msg_hdl(msgid, param);
@@ -614,6 +622,14 @@ int app_gap_discon_cmp_evt_handler(ke_msg_id_t const msgid, struct gap_discon_cm
                     param->reason);
     
         app_set_link_status_by_conhdl(param->conhdl, NULL, false);
+        #if (QN_CONN_POLICY)
+        app_conn_policy_stop(param->conhdl);
+        #endif
+        #if (QN_GATT_QUEUE && QN_LONG_WRITE)
+        // The GATT client queue drops the Device Name read of the link
+        if (app_env.name_conhdl == param->conhdl)
+            app_env.name_state = APP_NAME_IDLE;
+        #endif
         #if (BLE_CENTRAL)
         app_set_client_service_status(param->conhdl);
         #endif
@@ -871,6 +887,9 @@ int app_gap_param_update_resp_handler(ke_msg_id_t const msgid, struct gap_param_
     {
         QPRINTF("failed.\r\n");
     }
+#if (QN_CONN_POLICY)
+    app_conn_policy_update_resp(param->status == CO_ERROR_NO_ERROR && param->result == 0);
+#endif
     app_task_msg_hdl(msgid, param);
 
     return (KE_MSG_CONSUMED);
@@ -899,6 +918,9 @@ int app_gap_change_param_req_cmp_handler(ke_msg_id_t const msgid, struct gap_cha
     {
         QPRINTF("Update parameter complete, interval: 0x%x, latency: 0x%x, sup to: 0x%x.\r\n", 
                                     param->con_interval, param->con_latency, param->sup_to);
+#if (QN_CONN_POLICY)
+        app_conn_policy_param_ind(param->con_interval, param->con_latency);
+#endif
     }
     else
     {
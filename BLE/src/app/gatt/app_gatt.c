@@ -166,13 +166,28 @@ void app_gatt_disc_char_desc_req(uint16_t conhdl)
  *  if not correct then the GATT_CMP_EVT message with error code GATT_INVALID_PARAM_ERR 
  *  will be generically built and sent to Application directly. If parameter is correct,
  *  the GATT_READ_CHAR_RESP message will be received.
+ *  With CFG_GATT_QUEUE, GATT_READ_CHAR reads wait in the GATT client queue, see
+ *  prf_gattq_read(), at the end of a Read Multiple of the profiles as their length is not
+ *  known here, and with CFG_LONG_WRITE too, GATT_READ_LONG_CHAR reads values of up
+ *  to PRF_LONG_VALUE_MAX bytes, see prf_gattq_read_long(), into a response of that size
+ *  allocated for the read.
  *
  ****************************************************************************************
  */
 void app_gatt_read_char_req(uint8_t req_type, uint16_t conhdl, uint16_t valhdl)
 {
-    struct gatt_read_char_req *msg = KE_MSG_ALLOC(GATT_READ_CHAR_REQ, TASK_GATT, TASK_APP,
-                                                  gatt_read_char_req);
+    struct gatt_read_char_req *msg;
+
+#if (QN_GATT_QUEUE)
+    if ((req_type == GATT_READ_CHAR) && prf_gattq_read(TASK_APP, conhdl, valhdl, 0))
+        return;
+#if (QN_LONG_WRITE)
+    if ((req_type == GATT_READ_LONG_CHAR) && prf_gattq_read_long(TASK_APP, conhdl, valhdl, PRF_LONG_VALUE_MAX))
+        return;
+#endif
+#endif
+
+    msg = KE_MSG_ALLOC(GATT_READ_CHAR_REQ, TASK_GATT, TASK_APP, gatt_read_char_req);
 
     //Connection handle
     msg->conhdl = conhdl;
@@ -194,6 +209,52 @@ void app_gatt_read_char_req(uint8_t req_type, uint16_t conhdl, uint16_t valhdl)
     ke_msg_send(msg);
 }
 
+#if (QN_GATT_QUEUE && QN_LONG_WRITE)
+/*
+ ****************************************************************************************
+ * @brief Gatt Read Device Name of the peer. *//**
+ *
+ * @param[in] conhdl        Connection handle.
+ * @response  GATT_DISC_CHAR_BY_UUID_CMP_EVT, then GATT_READ_CHAR_RESP
+ * @description
+ *
+ *  This API is used by the application to read the Device Name characteristic of the
+ *  peer, which may be longer than a long read of the GATT. The characteristic is first
+ *  discovered by its UUID, its handler then reads the value of up to APP_PEER_NAME_MAX
+ *  bytes with prf_gattq_read_long() and the GATT_READ_CHAR_RESP handler prints it.
+ *
+ ****************************************************************************************
+ */
+void app_gatt_read_name_req(uint16_t conhdl)
+{
+    struct gatt_disc_char_req *msg;
+
+    if (app_env.name_state != APP_NAME_IDLE)
+    {
+        QPRINTF("Device Name read in progress.\r\n");
+        return;
+    }
+
+    msg = KE_MSG_ALLOC(GATT_DISC_CHAR_REQ, TASK_GATT, TASK_APP, gatt_disc_char_req);
+    //Connection handle
+    msg->conhdl = conhdl;
+    //GATT request type
+    msg->req_type = GATT_DISC_BY_UUID_CHAR;
+    //Start handle range
+    msg->start_hdl = 0x0001;
+    //End handle range
+    msg->end_hdl = GATT_MAX_ATTR_HDL;
+    //Desired characteristic
+    msg->desired_char.value_size = ATT_UUID_16_LEN;
+    co_write16p(&msg->desired_char.value[0], ATT_CHAR_DEVICE_NAME);
+
+    app_env.name_conhdl = conhdl;
+    app_env.name_state = APP_NAME_DISC;
+
+    ke_msg_send(msg);
+}
+#endif
+
 /*
  ****************************************************************************************
  * @brief Gatt Write Characteristic request. *//**
@@ -217,13 +278,21 @@ void app_gatt_read_char_req(uint8_t req_type, uint16_t conhdl, uint16_t valhdl)
  *  if not correct then the GATT_CMP_EVT message with error code GATT_INVALID_PARAM_ERR 
  *  will be generically built and sent to Application directly. If parameter is correct,
  *  the GATT_WRITE_CHAR_RESP message will be received.
+ *  With CFG_GATT_QUEUE, writes and write commands wait in the GATT client queue, see
+ *  prf_gattq_write().
  *
  ****************************************************************************************
  */
 void app_gatt_write_char_req(uint8_t req_type, uint16_t conhdl, uint16_t valhdl, uint16_t val_len, uint8_t *pdata)
 {
-    struct gatt_write_char_req *msg = KE_MSG_ALLOC_DYN(GATT_WRITE_CHAR_REQ, TASK_GATT, TASK_APP,
-                                                   gatt_write_char_req, val_len);
+    struct gatt_write_char_req *msg;
+
+#if (QN_GATT_QUEUE)
+    if (prf_gattq_write(TASK_APP, conhdl, valhdl, pdata, val_len, req_type))
+        return;
+#endif
+
+    msg = KE_MSG_ALLOC_DYN(GATT_WRITE_CHAR_REQ, TASK_GATT, TASK_APP, gatt_write_char_req, val_len);
 
     //Connection handle
     msg->conhdl = conhdl;
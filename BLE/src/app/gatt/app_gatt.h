@@ -43,6 +43,24 @@
 #include "attc_task.h"
 #include "app_gatt_task.h"
 
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// Longest Device Name of a peer (GAP)
+#define APP_PEER_NAME_MAX           248
+
+/// Steps of the Device Name read of app_gatt_read_name_req()
+enum app_name_state
+{
+    APP_NAME_IDLE,
+    /// Discovery of the characteristic
+    APP_NAME_DISC,
+    /// Long read of its value
+    APP_NAME_READ,
+};
+
 /*
  ****************************************************************************************
  * @brief Gatt Discovery Service request
@@ -75,6 +93,16 @@ void app_gatt_disc_char_desc_req(uint16_t conhdl);
  */
 void app_gatt_read_char_req(uint8_t req_type, uint16_t conhdl, uint16_t valhdl);
 
+#if (QN_GATT_QUEUE && QN_LONG_WRITE)
+/*
+ ****************************************************************************************
+ * @brief Gatt Read Device Name of the peer
+ *
+ ****************************************************************************************
+ */
+void app_gatt_read_name_req(uint16_t conhdl);
+#endif
+
 /*
  ****************************************************************************************
  * @brief Gatt Write Characteristic request
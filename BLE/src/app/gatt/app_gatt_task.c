@@ -242,6 +242,18 @@ int app_gatt_disc_char_by_uuid_cmp_evt_handler(ke_msg_id_t const msgid, struct g
         }
     }
 
+#if (QN_GATT_QUEUE && QN_LONG_WRITE)
+    // Device Name of app_gatt_read_name_req(), read in as many long reads as it takes
+    if ((app_env.name_state == APP_NAME_DISC) && (param->nb_entry != 0)
+     && (param->list[0].uuid == ATT_CHAR_DEVICE_NAME))
+    {
+        if (prf_gattq_read_long(TASK_APP, app_env.name_conhdl, param->list[0].pointer_hdl, APP_PEER_NAME_MAX))
+            app_env.name_state = APP_NAME_READ;
+        else
+            app_env.name_state = APP_NAME_IDLE;
+    }
+#endif
+
     return (KE_MSG_CONSUMED);
 }
 
@@ -391,10 +403,32 @@ int app_gatt_disc_char_desc_128_cmp_evt_handler(ke_msg_id_t const msgid, struct
 int app_gatt_read_char_resp_handler(ke_msg_id_t const msgid, struct gatt_read_char_resp const *param,
                                ke_task_id_t const dest_id, ke_task_id_t const src_id)
 {
+#if (QN_GATT_QUEUE)
+    if (prf_gattq_rsp(msgid, param, dest_id))
+        return (KE_MSG_CONSUMED);
+#endif
+
+#if (QN_GATT_QUEUE && QN_LONG_WRITE)
+    if (app_env.name_state == APP_NAME_READ)
+    {
+        app_env.name_state = APP_NAME_IDLE;
+        if (param->status == ATT_ERR_NO_ERROR)
+        {
+            // In pieces which fit in the print buffer
+            QPRINTF("Peer device name: ");
+            for (uint16_t i = 0; i < param->data.len; i += 64)
+                QPRINTF("%.*s", (param->data.len - i < 64) ? param->data.len - i : 64,
+                        (char const *)&param->data.data[i]);
+            QPRINTF("\r\n");
+            return (KE_MSG_CONSUMED);
+        }
+    }
+#endif
+
     if (param->status == ATT_ERR_NO_ERROR)
     {
         QPRINTF("Gatt read characteristic sucess, ");
-        for (int8_t i = 0; i < param->data.len; i++)
+        for (uint16_t i = 0; i < param->data.len; i++)
             QPRINTF("%02x", param->data.data[i]);
         QPRINTF("\r\n");
     }
@@ -426,6 +460,11 @@ int app_gatt_read_char_resp_handler(ke_msg_id_t const msgid, struct gatt_read_ch
 int app_gatt_read_char_mult_resp_handler(ke_msg_id_t const msgid, struct gatt_read_char_mult_resp const *param,
                                ke_task_id_t const dest_id, ke_task_id_t const src_id)
 {
+#if (QN_GATT_QUEUE)
+    if (prf_gattq_rsp(msgid, param, dest_id))
+        return (KE_MSG_CONSUMED);
+#endif
+
     //App should save the set of handles to be read and expected value size when sending read request
     if (param->status == ATT_ERR_NO_ERROR)
     {
@@ -458,6 +497,11 @@ int app_gatt_read_char_mult_resp_handler(ke_msg_id_t const msgid, struct gatt_re
 int app_gatt_write_char_resp_handler(ke_msg_id_t const msgid, struct gatt_write_char_resp const *param,
                                ke_task_id_t const dest_id, ke_task_id_t const src_id)
 {
+#if (QN_GATT_QUEUE)
+    if (prf_gattq_rsp(msgid, param, dest_id))
+        return (KE_MSG_CONSUMED);
+#endif
+
     if (param->status == ATT_ERR_NO_ERROR)
     {
         QPRINTF("Gatt write sucess\r\n");
@@ -520,6 +564,11 @@ int app_gatt_write_char_reliable_resp_handler(ke_msg_id_t const msgid, struct ga
 int app_gatt_cancel_write_char_resp_handler(ke_msg_id_t const msgid, void const *param,
                                ke_task_id_t const dest_id, ke_task_id_t const src_id)
 {
+#if (QN_GATT_QUEUE)
+    if (prf_gattq_rsp(msgid, param, dest_id))
+        return (KE_MSG_CONSUMED);
+#endif
+
     QPRINTF("Gatt cancel write complete\r\n");
 
     return (KE_MSG_CONSUMED);
@@ -560,13 +609,20 @@ int app_gatt_notify_cmp_evt_handler(ke_msg_id_t const msgid, struct gatt_notify_
  * @return If the message was consumed or not.
  * @description
  *
- *  This handler is used by the Client role of GATT to handle the value notification
+ *  This handler is used by the Client role of GATT to handle the value notification.
+ *  Notifications of a characteristic known by a profile client of the connection are
+ *  forwarded to it.
  *
  ****************************************************************************************
  */
 int app_gatt_handle_value_notif_handler(ke_msg_id_t const msgid, struct gatt_handle_value_notif const *param,
                                ke_task_id_t const dest_id, ke_task_id_t const src_id)
 {
+#if (BLE_ATTC)
+    if (prf_ntf_forward(param))
+        return (KE_MSG_NO_FREE);
+#endif
+
     QPRINTF("Gatt received notify from remote, handle 0x%04x, ", param->charhdl);
     for (uint8_t i = 0; i < param->size; i++)
         QPRINTF("%02x", param->value[i]);
@@ -644,6 +700,15 @@ int app_gatt_handle_value_cfm_handler(ke_msg_id_t const msgid, struct gatt_handl
 int app_gatt_disc_cmp_evt_handler(ke_msg_id_t const msgid, struct gatt_disc_cmp_evt const *param,
                                ke_task_id_t const dest_id, ke_task_id_t const src_id)
 {
+#if (QN_GATT_QUEUE && QN_LONG_WRITE)
+    if (app_env.name_state == APP_NAME_DISC)
+    {
+        QPRINTF("Device Name not found.\r\n");
+        app_env.name_state = APP_NAME_IDLE;
+        return (KE_MSG_CONSUMED);
+    }
+#endif
+
     QPRINTF("Discovery Services finished.\r\n");
 
     return (KE_MSG_CONSUMED);
@@ -667,6 +732,11 @@ int app_gatt_disc_cmp_evt_handler(ke_msg_id_t const msgid, struct gatt_disc_cmp_
 int app_gatt_cmp_evt_handler(ke_msg_id_t const msgid, struct gatt_cmp_evt const *param,
                           ke_task_id_t const dest_id, ke_task_id_t const src_id)
 {
+#if (QN_GATT_QUEUE)
+    if (prf_gattq_rsp(msgid, param, dest_id))
+        return (KE_MSG_CONSUMED);
+#endif
+
     QPRINTF("Gatt command ");
     if (param->status == ATT_ERR_NO_ERROR)
         QPRINTF("success.\r\n");
@@ -29,6 +29,7 @@
 
 #if BLE_GL_COLLECTOR
 #include "app_glpc.h"
+#include "ieee11073.h"
 
 /*
  * GLOBAL VARIABLE DEFINITIONS
@@ -272,6 +273,8 @@ int app_glpc_meas_ind_handler(ke_msg_id_t const msgid,
                       ke_task_id_t const dest_id,
                       ke_task_id_t const src_id)
 {
+    int32_t concentration = 0;
+
     QPRINTF("GLPC measurement value received with sequence number: 0x%04X\r\r\n", param->seq_num);
 
     /// Base Time
@@ -356,9 +359,17 @@ int app_glpc_meas_ind_handler(ke_msg_id_t const msgid,
     /// Glucose Concentration Units (kg/L, mol/L)
     QPRINTF("Concentration Units: ");
     if (param->meas_val.flags & GLP_MEAS_GL_CTR_UNITS_MOL_L)
-        QPRINTF("%d(mol/L)\r\r\n", param->meas_val.concentration);
+    {
+        // Tenths of mmol/L
+        ieee11073_sfloat_decode(param->meas_val.concentration, -4, &concentration);
+        QPRINTF("%d.%d(mmol/L)\r\r\n", concentration / 10, concentration % 10);
+    }
     else
-        QPRINTF("%d(kg/L)\r\r\n", param->meas_val.concentration);
+    {
+        // mg/dL
+        ieee11073_sfloat_decode(param->meas_val.concentration, -5, &concentration);
+        QPRINTF("%d(mg/dL)\r\r\n", concentration);
+    }
     
     /// Sensor Status Annunciation Present
     if (param->meas_val.flags & GLP_MEAS_SENS_STAT_ANNUN_PRES)
@@ -51,11 +51,23 @@
  */
 void app_glps_create_db(uint16_t start_hdl, uint8_t meas_ctx_supported)
 {
+#if (QN_SVC_DB_DIRECT)
+    struct glps_create_db_req req;
+    struct glps_create_db_req *msg = &req;
+#else
     struct glps_create_db_req * msg = KE_MSG_ALLOC(GLPS_CREATE_DB_REQ, TASK_GLPS, TASK_APP, glps_create_db_req);
+#endif
 
     msg->start_hdl = start_hdl;
     msg->meas_ctx_supported = meas_ctx_supported;
+#if (QN_SVC_DB_DIRECT)
+    struct glps_create_db_cfm cfm;
+
+    cfm.status = glps_create_db(msg);
+    app_glps_create_db_cfm_handler(GLPS_CREATE_DB_CFM, &cfm, TASK_APP, TASK_GLPS);
+#else
     ke_msg_send(msg);
+#endif
 }
 
 /*
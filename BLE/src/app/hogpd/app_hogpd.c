@@ -53,12 +53,24 @@
  */
 void app_hogpd_create_db(uint8_t hids_nb, struct hogpd_hids_cfg *cfg)
 {
+#if (QN_SVC_DB_DIRECT)
+    struct hogpd_create_db_req req;
+    struct hogpd_create_db_req *msg = &req;
+#else
     struct hogpd_create_db_req * msg = KE_MSG_ALLOC(HOGPD_CREATE_DB_REQ, TASK_HOGPD, TASK_APP, hogpd_create_db_req);
+#endif
 
     msg->hids_nb = hids_nb;
     while (hids_nb--)
         msg->cfg[hids_nb] = cfg[hids_nb];
+#if (QN_SVC_DB_DIRECT)
+    struct hogpd_create_db_cfm cfm;
+
+    cfm.status = hogpd_create_db(msg);
+    app_hogpd_create_db_cfm_handler(HOGPD_CREATE_DB_CFM, &cfm, TASK_APP, TASK_HOGPD);
+#else
     ke_msg_send(msg);
+#endif
 }
 
 /*
@@ -145,7 +157,7 @@ void app_hogpd_enable_req(uint16_t conhdl, uint8_t sec_lvl, uint8_t con_type, ui
 void app_hogpd_report_upd_req(uint16_t conhdl, uint8_t hids_nb, uint8_t report_nb, uint8_t report_length, uint8_t *report)
 {
     struct hogpd_report_info * msg = KE_MSG_ALLOC_DYN(HOGPD_REPORT_UPD_REQ, TASK_HOGPD, TASK_APP, 
-                                                      hogpd_report_info, report_length);
+                                                      hogpd_report_info, PRF_MSG_LEN_CLASS(report_length));
 
     msg->conhdl = conhdl;
     msg->hids_nb = hids_nb;
@@ -153,6 +165,11 @@ void app_hogpd_report_upd_req(uint16_t conhdl, uint8_t hids_nb, uint8_t report_n
     msg->report_length = report_length;
     memcpy(msg->report, report, report_length);
     ke_msg_send(msg);
+
+#if (QN_CONN_POLICY)
+    // Input reports are latency sensitive, each one counts as a burst
+    app_conn_policy_traffic(APP_CONN_POLICY_BURST_LEN);
+#endif
 }
 
 /*
@@ -186,6 +203,11 @@ void app_hogpd_boot_report_upd_req(uint16_t conhdl, uint8_t hids_nb, uint8_t cha
     msg->report_length = report_length;
     memcpy(msg->boot_report, boot_report, report_length);                       
     ke_msg_send(msg);
+
+#if (QN_CONN_POLICY)
+    // Input reports are latency sensitive, each one counts as a burst
+    app_conn_policy_traffic(APP_CONN_POLICY_BURST_LEN);
+#endif
 }
 
 #endif // BLE_HID_DEVICE
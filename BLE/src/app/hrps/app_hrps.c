@@ -29,6 +29,62 @@
 
 #if BLE_HR_SENSOR
 #include "app_hrps.h"
+#include "lib.h"
+#include "intc.h"
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// Number of RR-Interval pending in the accumulator
+#define APP_HRPS_RR_PENDING()       ((uint8_t)(app_hrps_env->rr_wr - app_hrps_env->rr_rd))
+
+/// Convert RR-Intervals (unit: 1/1024s) to beats per minute
+#define APP_HRPS_RR_TO_BPM(nb, sum) ((60UL * 1024 * (nb) + ((sum) >> 1)) / (sum))
+
+/*
+ * LOCAL FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+/*
+ ****************************************************************************************
+ * @brief Number of RR-Interval which fit in one notification with the given flags, the ROM
+ * keeps ATT_DEFAULT_MTU on every link; limited by the accumulator buffer too
+ ****************************************************************************************
+ */
+static uint8_t app_hrps_rr_capacity(uint8_t flags)
+{
+    // flags + 8 bits heart rate
+    uint16_t len = HRPS_HT_MEAS_MAX_LEN - 2;
+
+    if (flags & HRS_FLAG_HR_16BITS_VALUE)
+    {
+        len -= 1;
+    }
+    if (flags & HRS_FLAG_ENERGY_EXPENDED_PRESENT)
+    {
+        len -= 2;
+    }
+
+    len = CO_MIN(len / 2, HRS_MAX_RR_INTERVAL);
+
+    // Keep room in the accumulator for the beats arriving while this packet is sent
+    return (uint8_t)CO_MIN(len, APP_HRPS_RR_BUF_SIZE / 2);
+}
+
+/*
+ ****************************************************************************************
+ * @brief RR-Interval event handler, runs in the kernel context after the sensor ISR
+ ****************************************************************************************
+ */
+static void app_event_hrps_rr_handler(void)
+{
+    ke_evt_clear(1UL << EVENT_HRPS_RR_INTERVAL_ID);
+
+    app_hrps_rr_flush(false);
+}
 
 /*
  * FUNCTION DECLARATIONS
@@ -53,10 +109,22 @@
  */
 void app_hrps_create_db(uint8_t features)
 {
+#if (QN_SVC_DB_DIRECT)
+    struct hrps_create_db_req req;
+    struct hrps_create_db_req *msg = &req;
+#else
     struct hrps_create_db_req * msg = KE_MSG_ALLOC(HRPS_CREATE_DB_REQ, TASK_HRPS, TASK_APP, hrps_create_db_req);
+#endif
 
     msg->features = features;
+#if (QN_SVC_DB_DIRECT)
+    struct hrps_create_db_cfm cfm;
+
+    cfm.status = hrps_create_db(msg);
+    app_hrps_create_db_cfm_handler(HRPS_CREATE_DB_CFM, &cfm, TASK_APP, TASK_HRPS);
+#else
     ke_msg_send(msg);
+#endif
 }
 
 /*
@@ -125,6 +193,173 @@ void app_hrps_measurement_send(uint16_t conhdl, struct hrs_hr_meas *meas_val)
     ke_msg_send(msg);
 }
 
+/*
+ ****************************************************************************************
+ * @brief Initialize the RR-Interval accumulator       *//**
+ *
+ * @response None
+ * @description
+ * This function shall be called once at user initialization before app_hrps_rr_interval_add()
+ * is used. It registers the kernel event which moves RR-Intervals from the sensor ISR to the
+ * application.
+ ****************************************************************************************
+ */
+void app_hrps_rr_init(void)
+{
+    app_hrps_env->rr_rd = 0;
+    app_hrps_env->rr_wr = 0;
+    app_hrps_env->rr_lost = 0;
+    app_hrps_env->ee_cnt = 0;
+    app_hrps_env->rr_timer_on = false;
+
+    if(KE_EVENT_OK != ke_evt_callback_set(EVENT_HRPS_RR_INTERVAL_ID,
+                                            app_event_hrps_rr_handler))
+    {
+        ASSERT_ERR(0);
+    }
+}
+
+/*
+ ****************************************************************************************
+ * @brief Add one beat-to-beat interval to the accumulator - ISR safe      *//**
+ *
+ * @param[in] rr_interval RR-Interval, unit: 1/1024 second
+ *
+ * @response HRPS_MEAS_SEND_CFM or None
+ * @description
+ * This function is called by the heart rate sensor driver (typically from its interrupt
+ * handler) for every detected beat. RR-Intervals are accumulated and notified as soon as
+ * one notification is full or APP_HRPS_RR_LATENCY_TO expires after the first pending one.
+ * When the accumulator is full the new interval is dropped and counted in rr_lost.
+ ****************************************************************************************
+ */
+void app_hrps_rr_interval_add(uint16_t rr_interval)
+{
+    GLOBAL_INT_DISABLE();
+    if (APP_HRPS_RR_PENDING() < APP_HRPS_RR_BUF_SIZE)
+    {
+        app_hrps_env->rr_buf[app_hrps_env->rr_wr & (APP_HRPS_RR_BUF_SIZE - 1)] = rr_interval;
+        app_hrps_env->rr_wr++;
+    }
+    else
+    {
+        app_hrps_env->rr_lost++;
+    }
+    GLOBAL_INT_RESTORE();
+
+    ke_evt_set(1UL << EVENT_HRPS_RR_INTERVAL_ID);
+}
+
+/*
+ ****************************************************************************************
+ * @brief Notify the accumulated RR-Intervals      *//**
+ *
+ * @param[in] force Send the pending RR-Intervals even if they don't fill one notification
+ *
+ * @response HRPS_MEAS_SEND_CFM or None
+ * @description
+ * Packs as many pending RR-Intervals as fit in one notification. Heart Rate is computed from
+ * the packed intervals, Energy Expended is included once every APP_HRPS_EE_INTERVAL
+ * measurements. Only one notification is in flight, the next one is sent when
+ * HRPS_MEAS_SEND_CFM is received.
+ ****************************************************************************************
+ */
+void app_hrps_rr_flush(bool force)
+{
+    struct hrs_hr_meas meas_val;
+    uint32_t rr_sum = 0;
+    uint8_t pending = APP_HRPS_RR_PENDING();
+    uint8_t nb;
+    uint16_t rr;
+
+    if (pending == 0)
+    {
+        return;
+    }
+
+    // Nobody is listening, RR-Intervals are discarded
+    if ((app_hrps_env->enabled == false) || !(app_hrps_env->features & HRPS_HR_MEAS_NTF_CFG))
+    {
+        app_hrps_env->rr_rd += pending;
+        if (app_hrps_env->rr_timer_on)
+        {
+            ke_timer_clear(APP_HRPS_RR_TIMER, TASK_APP);
+            app_hrps_env->rr_timer_on = false;
+        }
+        return;
+    }
+
+    // Previous notification is not confirmed yet
+    if (app_hrps_env->ntf_sending == true)
+    {
+        if (force && (app_hrps_env->rr_timer_on == false))
+        {
+            // deadline expired, retry as soon as possible
+            ke_timer_set(APP_HRPS_RR_TIMER, TASK_APP, 1);
+            app_hrps_env->rr_timer_on = true;
+        }
+        return;
+    }
+
+    meas_val.flags = HRS_FLAG_SENSOR_CCT_FET_NOT_SUPPORTED | HRS_FLAG_RR_INTERVAL_PRESENT;
+    if ((app_hrps_env->features & HRPS_ENGY_EXP_FEAT_SUP) && (app_hrps_env->ee_cnt == 0))
+    {
+        meas_val.flags |= HRS_FLAG_ENERGY_EXPENDED_PRESENT;
+    }
+    // Heart rate value format follows the newest beat
+    rr = app_hrps_env->rr_buf[(uint8_t)(app_hrps_env->rr_wr - 1) & (APP_HRPS_RR_BUF_SIZE - 1)];
+    if ((rr != 0) && (APP_HRPS_RR_TO_BPM(1, rr) > 0xFF))
+    {
+        meas_val.flags |= HRS_FLAG_HR_16BITS_VALUE;
+    }
+
+    nb = app_hrps_rr_capacity(meas_val.flags);
+    if ((pending < nb) && (force == false))
+    {
+        // Wait for the notification to be filled, or for the latency deadline
+        if (app_hrps_env->rr_timer_on == false)
+        {
+            ke_timer_set(APP_HRPS_RR_TIMER, TASK_APP, APP_HRPS_RR_LATENCY_TO);
+            app_hrps_env->rr_timer_on = true;
+        }
+        return;
+    }
+    if (pending < nb)
+    {
+        nb = pending;
+    }
+
+    for (uint8_t i = 0; i < nb; i++)
+    {
+        meas_val.rr_intervals[i] = app_hrps_env->rr_buf[(uint8_t)(app_hrps_env->rr_rd + i)
+                                                        & (APP_HRPS_RR_BUF_SIZE - 1)];
+        rr_sum += meas_val.rr_intervals[i];
+    }
+    app_hrps_env->rr_rd += nb;
+
+    meas_val.nb_rr_interval = nb;
+    meas_val.heart_rate = (rr_sum != 0) ? APP_HRPS_RR_TO_BPM(nb, rr_sum) : 0;
+    if (!(meas_val.flags & HRS_FLAG_HR_16BITS_VALUE) && (meas_val.heart_rate > 0xFF))
+    {
+        meas_val.heart_rate = 0xFF;
+    }
+    meas_val.energy_expended = app_hrps_env->energy_expended;
+
+    if (++app_hrps_env->ee_cnt >= APP_HRPS_EE_INTERVAL)
+    {
+        app_hrps_env->ee_cnt = 0;
+    }
+
+    if (app_hrps_env->rr_timer_on)
+    {
+        ke_timer_clear(APP_HRPS_RR_TIMER, TASK_APP);
+        app_hrps_env->rr_timer_on = false;
+    }
+
+    app_hrps_measurement_send(app_hrps_env->conhdl, &meas_val);
+    app_hrps_env->ntf_sending = true;
+}
+
 #endif // BLE_HR_SENSOR
 
 /// @} APP_HRPS_API
@@ -78,6 +78,30 @@ void app_hrps_enable_req(uint16_t conhdl, uint8_t sec_lvl, uint8_t con_type,
  */
 void app_hrps_measurement_send(uint16_t conhdl, struct hrs_hr_meas *meas_val);
 
+/*
+ ****************************************************************************************
+ * @brief Initialize the RR-Interval accumulator
+ *
+ ****************************************************************************************
+ */
+void app_hrps_rr_init(void);
+
+/*
+ ****************************************************************************************
+ * @brief Add one beat-to-beat interval to the accumulator - ISR safe
+ *
+ ****************************************************************************************
+ */
+void app_hrps_rr_interval_add(uint16_t rr_interval);
+
+/*
+ ****************************************************************************************
+ * @brief Notify the accumulated RR-Intervals
+ *
+ ****************************************************************************************
+ */
+void app_hrps_rr_flush(bool force);
+
 #endif // BLE_HR_SENSOR
 
 /// @} APP_HRPS_API
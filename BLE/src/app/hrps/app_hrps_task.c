@@ -89,6 +89,10 @@ int app_hrps_disable_ind_handler(ke_msg_id_t const msgid,
     app_hrps_env->conhdl = 0xFFFF;
     app_hrps_env->enabled = false;
     app_hrps_env->ntf_sending = false;
+    // Drop the RR-Intervals which will never be notified
+    app_hrps_env->rr_rd = app_hrps_env->rr_wr;
+    app_hrps_env->rr_timer_on = false;
+    ke_timer_clear(APP_HRPS_RR_TIMER, TASK_APP);
     app_task_msg_hdl(msgid, param);
     
     return (KE_MSG_CONSUMED);
@@ -138,6 +142,10 @@ int app_hrps_means_send_cfm_handler(ke_msg_id_t const msgid,
 {
     app_hrps_env->ntf_sending = false;
     app_task_msg_hdl(msgid, param);
+
+    // Continue with the RR-Intervals accumulated in the meantime
+    app_hrps_rr_flush(false);
+
     return (KE_MSG_CONSUMED);
 }
 
@@ -199,6 +207,32 @@ int app_hrps_energy_exp_reset_ind_handler(ke_msg_id_t const msgid,
     return (KE_MSG_CONSUMED);
 }
 
+/*
+ ****************************************************************************************
+ * @brief Handles the RR-Interval latency deadline timer.       *//**
+ *
+ * @param[in] msgid     APP_HRPS_RR_TIMER
+ * @param[in] param     None
+ * @param[in] dest_id   TASK_APP
+ * @param[in] src_id    TASK_APP
+ *
+ * @return If the message was consumed or not.
+ * @description
+ * This handler sends the pending RR-Intervals when they did not fill a notification within
+ * APP_HRPS_RR_LATENCY_TO.
+ ****************************************************************************************
+ */
+int app_hrps_rr_timer_handler(ke_msg_id_t const msgid,
+                              void const *param,
+                              ke_task_id_t const dest_id,
+                              ke_task_id_t const src_id)
+{
+    app_hrps_env->rr_timer_on = false;
+    app_hrps_rr_flush(true);
+
+    return (KE_MSG_CONSUMED);
+}
+
 #endif // BLE_HR_SENSOR
 
 /// @} APP_HRPS_TASK
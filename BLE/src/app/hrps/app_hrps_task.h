@@ -35,6 +35,31 @@
  */
 #include "app_hrps.h"
 
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// RR-Interval accumulator size, must be a power of 2 and hold at least two full notifications
+#ifndef APP_HRPS_RR_BUF_SIZE
+#define APP_HRPS_RR_BUF_SIZE            32
+#endif
+
+/// Maximum time a RR-Interval waits in the accumulator before being notified (unit: 10ms)
+#ifndef APP_HRPS_RR_LATENCY_TO
+#define APP_HRPS_RR_LATENCY_TO          200 // 2s
+#endif
+
+/// Energy Expended is included once every APP_HRPS_EE_INTERVAL measurements
+#ifndef APP_HRPS_EE_INTERVAL
+#define APP_HRPS_EE_INTERVAL            10
+#endif
+
+/// Kernel event used to move RR-Intervals from the sensor ISR to the application
+#ifndef EVENT_HRPS_RR_INTERVAL_ID
+#define EVENT_HRPS_RR_INTERVAL_ID       8
+#endif
+
 /// @cond
 
 // Heart Rate Profile Server environment variable
@@ -48,6 +73,17 @@ struct app_hrps_env_tag
     uint16_t energy_expended;
     // Current Time Notification flow control
     bool ntf_sending;
+    // RR-Interval accumulator, filled from the sensor ISR
+    uint16_t rr_buf[APP_HRPS_RR_BUF_SIZE];
+    // RR-Interval accumulator read/write index
+    uint8_t rr_rd;
+    uint8_t rr_wr;
+    // Number of RR-Interval dropped because the accumulator was full
+    uint8_t rr_lost;
+    // Measurements sent since Energy Expended was last included
+    uint8_t ee_cnt;
+    // Latency deadline timer is running
+    bool rr_timer_on;
 };
 
 /*
@@ -140,6 +176,17 @@ int app_hrps_energy_exp_reset_ind_handler(ke_msg_id_t const msgid,
                                           ke_task_id_t const dest_id,
                                           ke_task_id_t const src_id);
 
+/*
+ ****************************************************************************************
+ * @brief Handles the RR-Interval latency deadline timer.
+ *
+ ****************************************************************************************
+ */
+int app_hrps_rr_timer_handler(ke_msg_id_t const msgid,
+                              void const *param,
+                              ke_task_id_t const dest_id,
+                              ke_task_id_t const src_id);
+
 #endif // BLE_HR_SENSOR
 
 /// @} APP_HRPS_TASK
@@ -30,6 +30,7 @@
 
 #if BLE_HT_COLLECTOR
 #include "app_htpc.h"
+#include "ieee11073.h"
 
 /// @cond
 /*
@@ -205,6 +206,7 @@ int app_htpc_wr_char_rsp_handler(ke_msg_id_t const msgid,
  *  - first byte: exponent (signed)
  *  - following three bytes: integer
  *  - for example: 0xff000173 = 371*10(expo: -1) = 37.1 Celsius
+ *  it is shown in tenths of a degree, see ieee11073_float_decode().
  *
  ****************************************************************************************
  */
@@ -213,6 +215,8 @@ int app_htpc_temp_ind_handler(ke_msg_id_t const msgid,
                       ke_task_id_t const dest_id,
                       ke_task_id_t const src_id)
 {
+    int32_t temp_x10;
+
 #if QN_DBG_TRACE_MORE 
     QPRINTF("Date: %04d:%02d:%02d Time: %02d:%02d:%02d\r\n", 
         param->temp_meas.time_stamp.year,
@@ -223,7 +227,11 @@ int app_htpc_temp_ind_handler(ke_msg_id_t const msgid,
         param->temp_meas.time_stamp.sec);
 #endif
 
-    QPRINTF("Temperature Value(%d): 0x%04x\r\n", param->flag_stable_meas, param->temp_meas.temp);
+    if (ieee11073_float_decode(param->temp_meas.temp, -1, &temp_x10) == IEEE11073_VAL_NUMBER)
+        QPRINTF("Temperature Value(%d): %s%d.%d\r\n", param->flag_stable_meas, (temp_x10 < 0) ? "-" : "",
+                ((temp_x10 < 0) ? -temp_x10 : temp_x10) / 10, ((temp_x10 < 0) ? -temp_x10 : temp_x10) % 10);
+    else
+        QPRINTF("Temperature Value(%d): 0x%08x\r\n", param->flag_stable_meas, param->temp_meas.temp);
     app_task_msg_hdl(msgid, param);
 
     return (KE_MSG_CONSUMED);
@@ -67,13 +67,25 @@
  */
 void app_htpt_create_db(uint16_t valid_range_min, uint16_t valid_range_max, uint8_t features)
 {
+#if (QN_SVC_DB_DIRECT)
+    struct htpt_create_db_req req;
+    struct htpt_create_db_req *msg = &req;
+#else
     struct htpt_create_db_req * msg = KE_MSG_ALLOC(HTPT_CREATE_DB_REQ, TASK_HTPT, TASK_APP,
                                                    htpt_create_db_req);
+#endif
 
     msg->valid_range_min = valid_range_min;
     msg->valid_range_max = valid_range_max;
     msg->features = features;
+#if (QN_SVC_DB_DIRECT)
+    struct htpt_create_db_cfm cfm;
+
+    cfm.status = htpt_create_db(msg);
+    app_htpt_create_db_cfm_handler(HTPT_CREATE_DB_CFM, &cfm, TASK_APP, TASK_HTPT);
+#else
     ke_msg_send(msg);
+#endif
 }
 
 /*
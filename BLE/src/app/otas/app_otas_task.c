@@ -47,6 +47,14 @@
 int app_otas_start_handler(ke_msg_id_t const msgid, struct otas_transimit_status_ind const * param,
                            ke_task_id_t const dest_id, ke_task_id_t const src_id)
 {
+#if (QN_CONN_POLICY)
+    // Keep the link fast while the image is transferred
+    if (param->status == OTA_STATUS_START_REQ)
+        app_conn_policy_busy(true);
+    else if (param->status != OTA_STATUS_ONGOING)
+        app_conn_policy_busy(false);
+#endif
+
     app_task_msg_hdl(msgid, param);
     
     return (KE_MSG_CONSUMED);    
@@ -59,11 +59,25 @@
  */
 void app_pasps_create_db(uint8_t alert_status, uint8_t ringer_setting)
 {
+#if (QN_SVC_DB_DIRECT)
+    struct pasps_create_db_req req;
+    struct pasps_create_db_req *msg = &req;
+#else
     struct pasps_create_db_req * msg = KE_MSG_ALLOC(PASPS_CREATE_DB_REQ, TASK_PASPS, TASK_APP, pasps_create_db_req);
+#endif
 
     msg->alert_status = alert_status;
     msg->ringer_setting = ringer_setting;
+#if (QN_SVC_DB_DIRECT)
+    struct pasps_cmp_evt evt;
+
+    evt.conhdl = GAP_INVALID_CONHDL;
+    evt.operation = PASPS_CREATE_DB_OP_CODE;
+    evt.status = pasps_create_db(msg);
+    app_pasps_cmp_evt_handler(PASPS_CMP_EVT, &evt, TASK_APP, TASK_PASPS);
+#else
     ke_msg_send(msg);
+#endif
 }
 
 /*
@@ -52,11 +52,23 @@
  */
 void app_proxr_create_db(uint8_t features)
 {
+#if (QN_SVC_DB_DIRECT)
+    struct proxr_create_db_req req;
+    struct proxr_create_db_req *msg = &req;
+#else
     struct proxr_create_db_req * msg = KE_MSG_ALLOC(PROXR_CREATE_DB_REQ, TASK_PROXR, TASK_APP,
                                                     proxr_create_db_req);
+#endif
 
     msg->features = features;
+#if (QN_SVC_DB_DIRECT)
+    struct proxr_create_db_cfm cfm;
+
+    cfm.status = proxr_create_db(msg);
+    app_proxr_create_db_cfm_handler(PROXR_CREATE_DB_CFM, &cfm, TASK_APP, TASK_PROXR);
+#else
     ke_msg_send(msg);
+#endif
 }
 
 /*
@@ -53,11 +53,23 @@
  */
 void app_qpps_create_db(uint8_t char_num)
 {
+#if (QN_SVC_DB_DIRECT)
+    struct qpps_create_db_req req;
+    struct qpps_create_db_req *msg = &req;
+#else
     struct qpps_create_db_req * msg = KE_MSG_ALLOC(QPPS_CREATE_DB_REQ, TASK_QPPS, TASK_APP, qpps_create_db_req);
+#endif
 
     msg->tx_char_num = char_num;
 
+#if (QN_SVC_DB_DIRECT)
+    struct qpps_create_db_cfm cfm;
+
+    cfm.status = qpps_create_db(msg, TASK_APP);
+    app_qpps_create_db_cfm_handler(QPPS_CREATE_DB_CFM, &cfm, TASK_APP, TASK_QPPS);
+#else
     ke_msg_send(msg);
+#endif
 }
 
 /*
@@ -110,7 +122,7 @@ void app_qpps_enable_req(uint16_t conhdl, uint8_t sec_lvl, uint8_t con_type, uin
 void app_qpps_data_send(uint16_t conhdl, uint8_t index, uint8_t length, uint8_t *data)
 {
     struct qpps_data_send_req * msg = KE_MSG_ALLOC_DYN(QPPS_DATA_SEND_REQ, TASK_QPPS, TASK_APP,
-                                                       qpps_data_send_req, length);
+                                                       qpps_data_send_req, PRF_MSG_LEN_CLASS(length));
 
     msg->conhdl = conhdl;
     msg->index = index;
@@ -118,6 +130,10 @@ void app_qpps_data_send(uint16_t conhdl, uint8_t index, uint8_t length, uint8_t
     memcpy(msg->data, data, length);
 
     ke_msg_send(msg);
+
+#if (QN_CONN_POLICY)
+    app_conn_policy_traffic(length);
+#endif
 }
 
 #endif // BLE_QPP_SERVER
@@ -248,6 +248,10 @@ int app_qpps_data_ind_handler(ke_msg_id_t const msgid,
     }
     QPRINTF("\r\n");
 
+#if (QN_CONN_POLICY)
+    app_conn_policy_traffic(param->length);
+#endif
+
     return (KE_MSG_CONSUMED);
 }
 
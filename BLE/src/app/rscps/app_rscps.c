@@ -58,13 +58,27 @@
  */
 void app_rscps_create_db(uint16_t rsc_feature, uint8_t sensor_loc_supp, uint8_t sensor_loc)
 {
+#if (QN_SVC_DB_DIRECT)
+    struct rscps_create_db_req req;
+    struct rscps_create_db_req *msg = &req;
+#else
     struct rscps_create_db_req * msg = KE_MSG_ALLOC(RSCPS_CREATE_DB_REQ, TASK_RSCPS, TASK_APP, rscps_create_db_req);
+#endif
 
     msg->rsc_feature = rsc_feature;
     msg->sensor_loc_supp = sensor_loc_supp;
     // Sensor location
     msg->sensor_loc = sensor_loc;
+#if (QN_SVC_DB_DIRECT)
+    struct rscps_cmp_evt evt;
+
+    evt.conhdl = GAP_INVALID_CONHDL;
+    evt.operation = RSCPS_CREATE_DB_OP_CODE;
+    evt.status = rscps_create_db(msg);
+    app_rscps_cmp_evt_handler(RSCPS_CMP_EVT, &evt, TASK_APP, TASK_RSCPS);
+#else
     ke_msg_send(msg);
+#endif
 }
 
 /*
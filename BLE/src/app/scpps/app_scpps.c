@@ -59,10 +59,22 @@
  */
 void app_scpps_create_db(uint8_t features)
 {
+#if (QN_SVC_DB_DIRECT)
+    struct scpps_create_db_req req;
+    struct scpps_create_db_req *msg = &req;
+#else
     struct scpps_create_db_req * msg = KE_MSG_ALLOC(SCPPS_CREATE_DB_REQ, TASK_SCPPS, TASK_APP, scpps_create_db_req);
+#endif
 
     msg->features = features;
+#if (QN_SVC_DB_DIRECT)
+    struct scpps_create_db_cfm cfm;
+
+    cfm.status = scpps_create_db(msg);
+    app_scpps_create_db_cfm_handler(SCPPS_CREATE_DB_CFM, &cfm, TASK_APP, TASK_SCPPS);
+#else
     ke_msg_send(msg);
+#endif
 }
 
 /*
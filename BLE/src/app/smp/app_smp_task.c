@@ -297,6 +297,8 @@ int app_smpc_ltk_req_ind_handler(ke_msg_id_t const msgid, struct smpc_ltk_req_in
  *  The application are asked to deliver an IRK as long as they no longer hold any record
  *  of IRKs for the known devices that have bonded with the local device, or until the 
  *  address has been solved.
+ *  With QN_RPA_RESOLVE the address is resolved locally against all the IRKs at the first
+ *  request, so only the matching IRK is delivered or the request is rejected at once.
  *
  ****************************************************************************************
  */
@@ -318,6 +320,29 @@ int app_smpc_irk_req_ind_handler(ke_msg_id_t const msgid, struct smpc_irk_req_in
         return (KE_MSG_CONSUMED);
     }
 
+#if (QN_RPA_RESOLVE)
+    if (app_env.irk_pos == 0)
+    {
+        uint8_t bonded_idx = app_rpa_resolve(&app_env.dev_rec[param->idx].bonded_info.peer_addr);
+
+        if (bonded_idx == GAP_INVALID_CONIDX)
+        {
+            reject = 1;
+            app_smpc_irk_req_rsp(param->idx, reject, NULL, NULL);
+        }
+        else
+        {
+            reject = 0;
+            app_smpc_irk_req_rsp(param->idx,
+                                 reject,
+                                 &app_env.bonded_info[bonded_idx].peer_addr,
+                                 &app_env.bonded_info[bonded_idx].pair_info.irk);
+            app_env.irk_pos = bonded_idx + 1;
+        }
+        return (KE_MSG_CONSUMED);
+    }
+#endif
+
     for (; app_env.irk_pos < bonded_count; app_env.irk_pos++)
     {    
         if (app_get_bond_status(app_env.irk_pos, SMP_KDIST_IDKEY))   //update get bond function
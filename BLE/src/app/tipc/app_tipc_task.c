@@ -29,6 +29,7 @@
 
 #if BLE_TIP_CLIENT
 #include "app_tipc.h"
+#include "rtc.h"
 
 /// @cond
 /*
@@ -175,6 +176,32 @@ int app_tipc_ct_ind_handler(ke_msg_id_t const msgid,
         param->ct_val.exact_time_256.day_date_time.date_time.sec
         );
 #endif
+
+#if (CONFIG_ENABLE_DRIVER_RTC == TRUE) && (RTC_EPOCH_EN == TRUE)
+    {
+        // The peer time is a reference of the RTC epoch clock, it feeds the drift estimation
+        struct rtc_epoch_date date;
+        uint32_t sec;
+        int32_t step;
+
+        date.year = param->ct_val.exact_time_256.day_date_time.date_time.year;
+        date.month = param->ct_val.exact_time_256.day_date_time.date_time.month;
+        date.day = param->ct_val.exact_time_256.day_date_time.date_time.day;
+        date.hour = param->ct_val.exact_time_256.day_date_time.date_time.hour;
+        date.minute = param->ct_val.exact_time_256.day_date_time.date_time.min;
+        date.second = param->ct_val.exact_time_256.day_date_time.date_time.sec;
+        if (rtc_epoch_from_date(&date, &sec))
+        {
+            step = rtc_epoch_ref(sec, param->ct_val.exact_time_256.fraction_256);
+            QPRINTF("TIPC reference time: step %d/256 s, drift %d ppb.\r\n", step, rtc_epoch_stat_get()->drift_ppb);
+#if BLE_TIP_SERVER
+            app_tips_time_adjust(TIPS_FLAG_EXT_TIME_UPDATE, step, 0);
+#else
+            (void)step;
+#endif
+        }
+    }
+#endif
     app_task_msg_hdl(msgid, param);
 
     return (KE_MSG_CONSUMED);
@@ -29,6 +29,7 @@
 
 #if BLE_TIP_SERVER
 #include "app_tips.h"
+#include "lib.h"
 
 /*
  * TYPE DEFINITIONS
@@ -45,6 +46,122 @@
  ****************************************************************************************
  */
 
+#if (APP_TIPS_RTC_TIME)
+/*
+ * LOCAL FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+/*
+ ****************************************************************************************
+ * @brief RTC alarm, in interrupt
+ *
+ ****************************************************************************************
+ */
+static void app_tips_time_alarm_cb(void)
+{
+    ke_evt_set(1UL << EVENT_TIPS_TIME_ID);
+}
+
+/*
+ ****************************************************************************************
+ * @brief Set the RTC alarm on the next refresh period of the clock
+ *
+ ****************************************************************************************
+ */
+static void app_tips_time_alarm_next(uint32_t now)
+{
+    rtc_epoch_alarm_set(now - now % APP_TIPS_TIME_REFRESH + APP_TIPS_TIME_REFRESH, app_tips_time_alarm_cb);
+}
+
+/*
+ ****************************************************************************************
+ * @brief Notify the Current Time value
+ *
+ ****************************************************************************************
+ */
+static void app_tips_time_ntf_send(struct tip_curr_time *current_time, uint32_t now)
+{
+    app_tips_upd_curr_time_req(app_tips_env->conhdl, current_time, 1);
+    app_tips_env->ntf_sending = true;
+    app_tips_env->ntf_last = now;
+    app_tips_env->ntf_time = now - now % APP_TIPS_NTF_PERIOD + APP_TIPS_NTF_PERIOD;
+}
+
+/*
+ ****************************************************************************************
+ * @brief Update the Reference Time Information when the hours since the last external
+ * update change
+ *
+ ****************************************************************************************
+ */
+static void app_tips_time_ref_upd(uint32_t now, bool force)
+{
+    struct rtc_epoch_stat const *stat = rtc_epoch_stat_get();
+    struct tip_ref_time_info ref_time_info;
+    uint32_t hours;
+    uint32_t accuracy;
+
+    if (!(app_tips_env->features & TIPS_CTS_REF_TIME_INFO_SUP) || (stat->ref_nb == 0))
+        return;
+
+    hours = (now - stat->ref_time) / SECONDINHOUR;
+    if (!force && (hours == app_tips_env->ref_hours))
+        return;
+    app_tips_env->ref_hours = hours;
+
+    ref_time_info.time_source = app_tips_env->ref_source;
+    // The error corrected by the last update, unknown before the clock was set once
+    accuracy = (uint32_t)((stat->ref_err < 0) ? -(int64_t)stat->ref_err : stat->ref_err) / 32;
+    ref_time_info.time_accuracy = (stat->ref_nb < 2) ? 255 : ((accuracy > 253) ? 254 : accuracy);
+    if (hours >= 255 * 24)
+    {
+        ref_time_info.days_update = 255;
+        ref_time_info.hours_update = 255;
+    }
+    else
+    {
+        ref_time_info.days_update = hours / 24;
+        ref_time_info.hours_update = hours % 24;
+    }
+    app_tips_upd_ref_time_info_req(app_tips_env->conhdl, &ref_time_info);
+}
+
+/*
+ ****************************************************************************************
+ * @brief Refresh the Current Time value, handles the RTC alarm
+ *
+ * The value read by the clients is written at each alarm, every APP_TIPS_TIME_REFRESH
+ * seconds, it is notified on the clock periods while the notifications are enabled.
+ ****************************************************************************************
+ */
+static void app_tips_time_evt_handler(void)
+{
+    struct tip_curr_time current_time;
+    uint32_t now;
+
+    ke_evt_clear(1UL << EVENT_TIPS_TIME_ID);
+
+    if (!app_tips_env->enabled)
+        return;
+
+    now = app_tips_curr_time_get(&current_time, 0);
+    if ((app_tips_env->features & TIPS_CTS_CURRENT_TIME_CFG)
+        && ((int32_t)(now - app_tips_env->ntf_time) >= 0)
+        && (app_tips_env->ntf_sending == false))
+    {
+        app_tips_time_ntf_send(&current_time, now);
+    }
+    else
+    {
+        tips_curr_time_set(&current_time);
+    }
+    app_tips_time_ref_upd(now, false);
+
+    app_tips_time_alarm_next(now);
+}
+#endif
+
 /*
  ****************************************************************************************
  * @brief Create the time server database - at initiation       *//**
@@ -65,10 +182,22 @@
  */
 void app_tips_create_db(uint8_t features)
 {
+#if (QN_SVC_DB_DIRECT)
+    struct tips_create_db_req req;
+    struct tips_create_db_req *msg = &req;
+#else
     struct tips_create_db_req * msg = KE_MSG_ALLOC(TIPS_CREATE_DB_REQ, TASK_TIPS, TASK_APP, tips_create_db_req);
+#endif
 
     msg->features = features;
+#if (QN_SVC_DB_DIRECT)
+    struct tips_create_db_cfm cfm;
+
+    cfm.status = tips_create_db(msg);
+    app_tips_create_db_cfm_handler(TIPS_CREATE_DB_CFM, &cfm, TASK_APP, TASK_TIPS);
+#else
     ke_msg_send(msg);
+#endif
 }
 
 /*
@@ -99,6 +228,12 @@ void app_tips_enable_req(uint16_t conhdl, uint8_t sec_lvl, uint8_t con_type, uin
     msg->con_type = con_type;
     msg->current_time_ntf_en = current_time_ntf_en;
     ke_msg_send(msg);
+
+#if (APP_TIPS_RTC_TIME)
+    // Refresh the Current Time value from the next second
+    app_tips_env->ntf_time = rtc_epoch_get(NULL);
+    rtc_epoch_alarm_set(app_tips_env->ntf_time, app_tips_time_alarm_cb);
+#endif
 }
 
 /*
@@ -227,6 +362,109 @@ void app_tips_upd_time_upd_state_req(uint16_t conhdl, struct tip_time_upd_state
     ke_msg_send(msg);
 }
 
+#if (APP_TIPS_RTC_TIME)
+/*
+ ****************************************************************************************
+ * @brief Register the RTC alarm event - at initiation      *//**
+ * @response None
+ * @description
+ * This function registers the kernel event which moves the RTC alarm to the application.
+ * The RTC epoch clock is started by the user, rtc_init() and rtc_epoch_init(). While the
+ * Time Server role is enabled, the Current Time value is refreshed in the database every
+ * APP_TIPS_TIME_REFRESH seconds and notified every APP_TIPS_NTF_PERIOD seconds, no
+ * application timer polls the time.
+ ****************************************************************************************
+ */
+void app_tips_time_init(void)
+{
+    if(KE_EVENT_OK != ke_evt_callback_set(EVENT_TIPS_TIME_ID, app_tips_time_evt_handler))
+    {
+        ASSERT_ERR(0);
+    }
+}
+
+/*
+ ****************************************************************************************
+ * @brief Get the Current Time value from the RTC epoch clock     *//**
+ * @param[out] current_time Current Time value
+ * @param[in] adjust_reason Adjust reason of the value
+ * @return Epoch second of the value
+ * @description
+ * The date and time fields are computed from the epoch second, without BCD conversion.
+ ****************************************************************************************
+ */
+uint32_t app_tips_curr_time_get(struct tip_curr_time *current_time, uint8_t adjust_reason)
+{
+    struct rtc_epoch_date date;
+    uint8_t frac_256;
+    uint32_t now = rtc_epoch_get(&frac_256);
+
+    rtc_epoch_to_date(now, &date);
+    current_time->exact_time_256.day_date_time.date_time.year = date.year;
+    current_time->exact_time_256.day_date_time.date_time.month = date.month;
+    current_time->exact_time_256.day_date_time.date_time.day = date.day;
+    current_time->exact_time_256.day_date_time.date_time.hour = date.hour;
+    current_time->exact_time_256.day_date_time.date_time.min = date.minute;
+    current_time->exact_time_256.day_date_time.date_time.sec = date.second;
+    current_time->exact_time_256.day_date_time.day_of_week = date.week;
+    current_time->exact_time_256.fraction_256 = frac_256;
+    current_time->adjust_reason = adjust_reason;
+
+    return now;
+}
+
+/*
+ ****************************************************************************************
+ * @brief Notify a change of the RTC epoch clock - at connection     *//**
+ * @param[in] adjust_reason TIPS_FLAG_MAN_TIME_UPDATE, TIPS_FLAG_EXT_TIME_UPDATE...
+ * @param[in] step Change of the clock, unit: 1/256 s
+ * @param[in] time_source Time source of an external update
+ * @response None or TIPS_ERROR_IND
+ * @description
+ * This function shall be called after rtc_epoch_set() or rtc_epoch_ref(). The new Current
+ * Time value is notified at once, except an external update of less than a minute within
+ * 15 minutes of the last notification, as required by CTS. An external update also resets
+ * the Reference Time Information.
+ ****************************************************************************************
+ */
+void app_tips_time_adjust(uint8_t adjust_reason, int32_t step, uint8_t time_source)
+{
+    struct tip_curr_time current_time;
+    uint32_t now = app_tips_curr_time_get(&current_time, adjust_reason);
+    uint8_t enable_ntf_send = 1;
+
+    if (adjust_reason & TIPS_FLAG_EXT_TIME_UPDATE)
+    {
+        app_tips_env->ref_source = time_source;
+        if ((step >= -60 * 256) && (step <= 60 * 256)
+            && ((now - app_tips_env->ntf_last) < APP_TIPS_EXT_NTF_INTV))
+        {
+            enable_ntf_send = 0;
+        }
+    }
+
+    if (!app_tips_env->enabled)
+        return;
+
+    if ((app_tips_env->features & TIPS_CTS_CURRENT_TIME_CFG) && enable_ntf_send
+        && (app_tips_env->ntf_sending == false))
+    {
+        app_tips_time_ntf_send(&current_time, now);
+    }
+    else
+    {
+        tips_curr_time_set(&current_time);
+    }
+    if (adjust_reason & TIPS_FLAG_EXT_TIME_UPDATE)
+    {
+        app_tips_time_ref_upd(now, true);
+    }
+
+    // The alarm follows the new time
+    app_tips_time_alarm_next(now);
+}
+#endif
+
 #endif // BLE_TIP_SERVER
 
 /// @} APP_TIPS_API
@@ -108,6 +108,32 @@ void app_tips_upd_time_dst_req(uint16_t conhdl, struct tip_time_with_dst *time_w
  */
 void app_tips_upd_time_upd_state_req(uint16_t conhdl, struct tip_time_upd_state *time_upd_state);
 
+#if (APP_TIPS_RTC_TIME)
+/*
+ ****************************************************************************************
+ * @brief Register the RTC alarm event - at initiation
+ *
+ ****************************************************************************************
+ */
+void app_tips_time_init(void);
+
+/*
+ ****************************************************************************************
+ * @brief Get the Current Time value from the RTC epoch clock
+ *
+ ****************************************************************************************
+ */
+uint32_t app_tips_curr_time_get(struct tip_curr_time *current_time, uint8_t adjust_reason);
+
+/*
+ ****************************************************************************************
+ * @brief Notify a change of the RTC epoch clock - at connection
+ *
+ ****************************************************************************************
+ */
+void app_tips_time_adjust(uint8_t adjust_reason, int32_t step, uint8_t time_source);
+#endif
+
 #endif // BLE_TIP_SERVER
 
 /// @} APP_TIPS_API
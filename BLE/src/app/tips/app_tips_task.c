@@ -90,6 +90,9 @@ int app_tips_disable_ind_handler(ke_msg_id_t const msgid,
     app_tips_env->conhdl = 0xFFFF;
     app_tips_env->enabled = false;
     app_tips_env->ntf_sending = false;
+#if (APP_TIPS_RTC_TIME)
+    rtc_epoch_alarm_clear();
+#endif
     app_task_msg_hdl(msgid, param);
     
     return (KE_MSG_CONSUMED);
@@ -149,6 +152,11 @@ int app_tips_current_time_ccc_ind_handler(ke_msg_id_t const msgid,
     if (param->cfg_val == PRF_CLI_START_NTF) 
     {
         app_tips_env->features |= TIPS_CTS_CURRENT_TIME_CFG;
+#if (APP_TIPS_RTC_TIME)
+        // First notification at the next alarm
+        app_tips_env->ntf_sending = false;
+        app_tips_env->ntf_time = rtc_epoch_get(NULL);
+#endif
     }
     else
     {
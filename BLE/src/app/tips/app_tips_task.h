@@ -34,6 +34,32 @@
  ****************************************************************************************
  */
 #include "app_tips.h"
+#include "rtc.h"
+
+/// Current Time value kept by the RTC epoch clock, see rtc_epoch_init()
+#define APP_TIPS_RTC_TIME               ((CONFIG_ENABLE_DRIVER_RTC == TRUE) && (RTC_EPOCH_EN == TRUE))
+
+#if (APP_TIPS_RTC_TIME)
+/// Period of the Current Time notifications, aligned on the clock (unit: s)
+#ifndef APP_TIPS_NTF_PERIOD
+#define APP_TIPS_NTF_PERIOD             60
+#endif
+
+/// Period of the Current Time value refresh in the database while connected, aligned on
+/// the clock (unit: s). The ROM answers the reads from the database without the profile,
+/// a read returns the value of the last refresh, notification or adjustment.
+#ifndef APP_TIPS_TIME_REFRESH
+#define APP_TIPS_TIME_REFRESH           APP_TIPS_NTF_PERIOD
+#endif
+
+/// An external update of less than a minute is only notified this long after the last notification (unit: s)
+#define APP_TIPS_EXT_NTF_INTV           (15 * 60)
+
+/// Kernel event moving the RTC alarm to the application
+#ifndef EVENT_TIPS_TIME_ID
+#define EVENT_TIPS_TIME_ID              14
+#endif
+#endif
 
 /// @cond
 
@@ -52,6 +78,15 @@ struct app_tips_env_tag
     uint16_t conhdl;
     // Current Time Notification flow control
     uint8_t ntf_sending;
+#if (APP_TIPS_RTC_TIME)
+    // Time source of the last external update
+    uint8_t ref_source;
+    // Hours since the last external update, as in the database
+    uint16_t ref_hours;
+    // Epoch second of the next periodic notification and of the last notification
+    uint32_t ntf_time;
+    uint32_t ntf_last;
+#endif
 };
 
 /*
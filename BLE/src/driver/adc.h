@@ -292,6 +292,21 @@ __STATIC_INLINE void adc_clock_off(void)
     syscon_SetCRSS(QN_SYSCON, SYSCON_MASK_GATING_ADC);
 }
 
+/**
+ ****************************************************************************************
+ * @brief   Check if the ADC is in use
+ * @description
+ *  The ADC clock is gated at boot and by each user when its conversions are done, so it
+ *  runs from adc_init() to adc_clock_off(). A user which shares the ADC in background
+ *  checks this before adc_init(), which would take the ADC from the current user.
+ *
+ *****************************************************************************************
+ */
+__STATIC_INLINE bool adc_busy(void)
+{
+    return (syscon_GetCRSS(QN_SYSCON) & SYSCON_MASK_GATING_ADC) == 0;
+}
+
 /**
  ****************************************************************************************
  * @brief   Power on ADC
@@ -51,6 +51,34 @@ struct rtc_env_tag rtc_env = {0};
 struct rtc_capture_env_tag rtc_capture_env = {0};
 #endif
 
+#if RTC_EPOCH_EN==TRUE
+/// Days from 0000-03-01 to 2000-01-01, the civil calendar conversions count from 0000-03-01
+#define RTC_EPOCH_DAYS_0000     730425
+
+///Structure defining the epoch clock parameters
+struct rtc_epoch_env_tag
+{
+    /// Epoch time when the RTC counter was at base_sec/base_cnt, 1/256 s
+    uint64_t base_time;
+    uint32_t base_sec;
+    uint16_t base_cnt;
+    /// RTC counter at the last reference time, the drift is measured from there
+    uint16_t ref_cnt;
+    uint32_t ref_sec;
+    bool     ref_valid;
+    /// Second of the RTC counter raising the alarm, and its epoch second
+    uint32_t alarm_sec;
+    uint32_t alarm_time;
+    void   (*alarm_cb)(void);
+    struct rtc_epoch_stat stat;
+};
+
+///RTC epoch clock environment variable
+static struct rtc_epoch_env_tag rtc_epoch_env;
+
+static const uint8_t rtc_epoch_month_days[12] = {31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+#endif
+
 /*
  * FUNCTION DEFINITIONS
  ****************************************************************************************
@@ -90,6 +118,96 @@ uint8_t bcd2dec(uint8_t bcd)
     return decade;
 }
 
+#if RTC_EPOCH_EN==TRUE
+/**
+ ****************************************************************************************
+ * @brief Read the RTC counter
+ * @param[out]   sec            second counter
+ * @param[out]   cnt            32k clock counts in the second
+ * @description
+ *  The second may change between the two registers, they are read again in that case.
+ ****************************************************************************************
+ */
+static void rtc_epoch_raw_get(uint32_t *sec, uint16_t *cnt)
+{
+    uint32_t s;
+
+    do {
+        s = rtc_rtc_GetSecVal(QN_RTC);
+        *cnt = rtc_rtc_GetCNT(QN_RTC) & RTC_MASK_CNT_VAL;
+    } while (s != rtc_rtc_GetSecVal(QN_RTC));
+
+    *sec = s;
+}
+
+/**
+ ****************************************************************************************
+ * @brief RTC time between two counter values, 1/256 s
+ ****************************************************************************************
+ */
+static int64_t rtc_epoch_elapsed(uint32_t sec, uint16_t cnt, uint32_t from_sec, uint16_t from_cnt)
+{
+    return (int64_t)(sec - from_sec) * 256 + ((int32_t)cnt - from_cnt) * 256 / RTC_CNT_PER_SEC;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Epoch time at a counter value, corrected for the drift, 1/256 s
+ ****************************************************************************************
+ */
+static uint64_t rtc_epoch_at(uint32_t sec, uint16_t cnt)
+{
+    int64_t elapsed = rtc_epoch_elapsed(sec, cnt, rtc_epoch_env.base_sec, rtc_epoch_env.base_cnt);
+
+    return rtc_epoch_env.base_time + elapsed + elapsed * rtc_epoch_env.stat.drift_ppb / 1000000000;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Find the second of the RTC counter at which the alarm time is reached
+ * @description
+ *  The second interrupt comes when the counter moves to a new second, the alarm is raised
+ *  by the first one at or after the alarm time. Called again when the clock is set.
+ ****************************************************************************************
+ */
+static void rtc_epoch_alarm_update(void)
+{
+    int64_t diff = ((int64_t)rtc_epoch_env.alarm_time << 8) - (int64_t)rtc_epoch_env.base_time;
+    int64_t cnt;
+
+    if (diff <= 0) {
+        rtc_epoch_env.alarm_sec = rtc_epoch_env.base_sec;
+        return;
+    }
+
+    // Remove the drift correction: elapsed = diff / (1 + drift)
+    diff -= diff * rtc_epoch_env.stat.drift_ppb / (1000000000 + rtc_epoch_env.stat.drift_ppb);
+    cnt = rtc_epoch_env.base_cnt + (diff * RTC_CNT_PER_SEC + 255) / 256;
+    rtc_epoch_env.alarm_sec = rtc_epoch_env.base_sec + (uint32_t)((cnt + RTC_CNT_PER_SEC - 1) / RTC_CNT_PER_SEC);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Second interrupt of the epoch clock
+ * @description
+ *  Raises the alarm when its second is reached, the interrupt is disabled at the first
+ *  second without alarm. An alarm set again from the callback keeps it enabled.
+ ****************************************************************************************
+ */
+static void rtc_epoch_sec_isr(void)
+{
+    void (*callback)(void) = rtc_epoch_env.alarm_cb;
+
+    if (callback == NULL) {
+        rtc_int_disable();
+    }
+    else if ((int32_t)(rtc_rtc_GetSecVal(QN_RTC) - rtc_epoch_env.alarm_sec) >= 0) {
+        rtc_epoch_env.alarm_cb = NULL;
+        callback();
+    }
+}
+#endif
+
 #if CONFIG_RTC_DEFAULT_IRQHANDLER==TRUE
 /**
  ****************************************************************************************
@@ -102,7 +220,11 @@ void RTC_IRQHandler(void)
 
     reg = rtc_rtc_GetSR(QN_RTC);
     if (reg & RTC_MASK_SEC_IF) {
+#if RTC_EPOCH_EN==TRUE
+        rtc_epoch_sec_isr();
+#else
         rtc_time_get();
+#endif
     }
 
     // wait until last time configuration synchronize
@@ -580,5 +702,244 @@ void rtc_time_get(void)
 }
 #endif
 
+#if RTC_EPOCH_EN==TRUE
+/**
+ ****************************************************************************************
+ * @brief Start the epoch clock
+ * @description
+ *  This function is called after rtc_init() instead of rtc_time_set(). The second counter
+ *  starts from 0 and is never written again, the epoch clock reads 2000-01-01 00:00:00
+ *  until it is set.
+ ****************************************************************************************
+ */
+void rtc_epoch_init(void)
+{
+    memset(&rtc_epoch_env, 0, sizeof(rtc_epoch_env));
+
+    // wait until last time configuration synchronize
+    while (rtc_rtc_GetSR(QN_RTC) & RTC_MASK_SEC_SYNC_BUSY);
+    rtc_rtc_SetSecVal(QN_RTC, 0);
+
+    // wait until last time configuration synchronize
+    while (rtc_rtc_GetSR(QN_RTC) & RTC_MASK_CR_SYNC_BUSY);
+    // Enable the real time clock configuration
+    rtc_rtc_SetCRWithMask(QN_RTC, RTC_MASK_CFG, MASK_ENABLE);
+
+#if CONFIG_RTC_ENABLE_INTERRUPT==TRUE
+    NVIC_EnableIRQ(RTC_IRQn);
+#endif
+}
+
+/**
+ ****************************************************************************************
+ * @brief Set the epoch clock
+ * @param[in]    sec            seconds from 2000-01-01 00:00:00
+ * @param[in]    frac_256       1/256 s
+ * @description
+ *  The drift correction is kept, the next reference time only sets the clock since the
+ *  interval from the previous one was not measured by the RTC alone.
+ ****************************************************************************************
+ */
+void rtc_epoch_set(uint32_t sec, uint8_t frac_256)
+{
+    rtc_epoch_raw_get(&rtc_epoch_env.base_sec, &rtc_epoch_env.base_cnt);
+    rtc_epoch_env.base_time = ((uint64_t)sec << 8) + frac_256;
+    rtc_epoch_env.ref_valid = false;
+    rtc_epoch_alarm_update();
+}
+
+/**
+ ****************************************************************************************
+ * @brief Get the epoch clock
+ * @param[out]   frac_256       1/256 s, may be NULL
+ * @return       seconds from 2000-01-01 00:00:00
+ ****************************************************************************************
+ */
+uint32_t rtc_epoch_get(uint8_t *frac_256)
+{
+    uint64_t time;
+    uint32_t sec;
+    uint16_t cnt;
+
+    rtc_epoch_raw_get(&sec, &cnt);
+    time = rtc_epoch_at(sec, cnt);
+    if (frac_256 != NULL) {
+        *frac_256 = (uint8_t)time;
+    }
+
+    return (uint32_t)(time >> 8);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Set the epoch clock from a reference time
+ * @param[in]    sec            seconds from 2000-01-01 00:00:00
+ * @param[in]    frac_256       1/256 s
+ * @return       step of the clock, reference - epoch clock, 1/256 s
+ * @description
+ *  The error against the previous reference time, RTC_EPOCH_REF_MIN or more before,
+ *  gives the drift left after the correction. The first estimate is taken as is, the
+ *  next ones are averaged with the correction.
+ ****************************************************************************************
+ */
+int32_t rtc_epoch_ref(uint32_t sec, uint8_t frac_256)
+{
+    struct rtc_epoch_stat *stat = &rtc_epoch_env.stat;
+    uint64_t ref = ((uint64_t)sec << 8) + frac_256;
+    int64_t err, elapsed, drift;
+    uint32_t now_sec;
+    uint16_t now_cnt;
+
+    rtc_epoch_raw_get(&now_sec, &now_cnt);
+    err = (int64_t)(ref - rtc_epoch_at(now_sec, now_cnt));
+
+    // An error of years is a clock set, not a drift
+    if (rtc_epoch_env.ref_valid && (err > -((int64_t)1 << 32)) && (err < ((int64_t)1 << 32))) {
+        elapsed = rtc_epoch_elapsed(now_sec, now_cnt, rtc_epoch_env.ref_sec, rtc_epoch_env.ref_cnt);
+        if (elapsed >= (int64_t)RTC_EPOCH_REF_MIN * 256) {
+            drift = err * 1000000000 / elapsed;
+            drift = stat->drift_ppb + ((stat->drift_nb == 0) ? drift : drift / 2);
+            if ((drift >= -RTC_EPOCH_DRIFT_MAX) && (drift <= RTC_EPOCH_DRIFT_MAX)) {
+                stat->drift_ppb = (int32_t)drift;
+                stat->drift_nb++;
+            }
+        }
+    }
+
+    rtc_epoch_env.base_sec = now_sec;
+    rtc_epoch_env.base_cnt = now_cnt;
+    rtc_epoch_env.base_time = ref;
+    rtc_epoch_env.ref_sec = now_sec;
+    rtc_epoch_env.ref_cnt = now_cnt;
+    rtc_epoch_env.ref_valid = true;
+    rtc_epoch_alarm_update();
+
+    if (err > INT32_MAX) {
+        err = INT32_MAX;
+    }
+    else if (err < INT32_MIN) {
+        err = INT32_MIN;
+    }
+    stat->ref_err = (int32_t)err;
+    stat->ref_time = sec;
+    stat->ref_nb++;
+
+    return stat->ref_err;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Get the drift estimation of the epoch clock
+ ****************************************************************************************
+ */
+struct rtc_epoch_stat const *rtc_epoch_stat_get(void)
+{
+    return &rtc_epoch_env.stat;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Set the alarm of the epoch clock
+ * @param[in]    sec            epoch second of the alarm
+ * @param[in]    callback       called once in the RTC interrupt when the alarm is raised
+ * @description
+ *  The alarm is raised by the first second interrupt at or after sec, an alarm in the
+ *  past is raised at the next second. It replaces the previous alarm.
+ ****************************************************************************************
+ */
+void rtc_epoch_alarm_set(uint32_t sec, void (*callback)(void))
+{
+    rtc_epoch_env.alarm_cb = NULL;
+    rtc_epoch_env.alarm_time = sec;
+    rtc_epoch_alarm_update();
+    rtc_epoch_env.alarm_cb = callback;
+
+    if (!(rtc_rtc_GetCR(QN_RTC) & RTC_MASK_SEC_IE)) {
+        rtc_int_enable();
+    }
+}
+
+/**
+ ****************************************************************************************
+ * @brief Clear the alarm of the epoch clock
+ * @description
+ *  The second interrupt stops at the next second.
+ ****************************************************************************************
+ */
+void rtc_epoch_alarm_clear(void)
+{
+    rtc_epoch_env.alarm_cb = NULL;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Convert an epoch second to date and time
+ * @param[in]    sec            seconds from 2000-01-01 00:00:00
+ * @param[out]   date           date and time
+ * @description
+ *  The years start on march 1st so that the leap day is the last day of a year, the date
+ *  is then found with a few divisions instead of going through the years and the months.
+ ****************************************************************************************
+ */
+void rtc_epoch_to_date(uint32_t sec, struct rtc_epoch_date *date)
+{
+    uint32_t days = sec / SECONDINDAY;
+    uint32_t rem = sec % SECONDINDAY;
+    uint32_t era, doe, yoe, doy, mp;
+
+    date->hour = rem / SECONDINHOUR;
+    rem %= SECONDINHOUR;
+    date->minute = rem / 60;
+    date->second = rem % 60;
+    // 2000-01-01 was a saturday
+    date->week = (days + 5) % 7 + 1;
+
+    days += RTC_EPOCH_DAYS_0000;
+    era = days / 146097;
+    doe = days - era * 146097;
+    yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    mp = (5 * doy + 2) / 153;
+    date->day = doy - (153 * mp + 2) / 5 + 1;
+    date->month = (mp < 10) ? (mp + 3) : (mp - 9);
+    date->year = era * 400 + yoe + (date->month <= 2);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Convert date and time to an epoch second
+ * @param[in]    date           date and time, the day of week is not used
+ * @param[out]   sec            seconds from 2000-01-01 00:00:00
+ * @return       false if the date is not valid or out of the range of the epoch clock
+ ****************************************************************************************
+ */
+bool rtc_epoch_from_date(struct rtc_epoch_date const *date, uint32_t *sec)
+{
+    uint32_t y = date->year;
+    uint32_t m = date->month;
+    uint32_t era, yoe, doy, doe;
+
+    if ((y < RTC_EPOCH_YEAR) || (y > RTC_EPOCH_YEAR_MAX) || (m < 1) || (m > 12)
+        || (date->day < 1) || (date->day > rtc_epoch_month_days[m - 1])
+        || ((m == 2) && (date->day == 29) && ((y % 4 != 0) || ((y % 100 == 0) && (y % 400 != 0))))
+        || (date->hour > 23) || (date->minute > 59) || (date->second > 59)) {
+        return false;
+    }
+
+    if (m <= 2) {
+        y--;
+    }
+    era = y / 400;
+    yoe = y - era * 400;
+    doy = (153 * ((m > 2) ? (m - 3) : (m + 9)) + 2) / 5 + date->day - 1;
+    doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+
+    *sec = (era * 146097 + doe - RTC_EPOCH_DAYS_0000) * SECONDINDAY
+         + date->hour * SECONDINHOUR + date->minute * 60 + date->second;
+
+    return true;
+}
+#endif
+
 #endif /* CONFIG_ENABLE_DRIVER_RTC==TRUE */
 /// @} RTC
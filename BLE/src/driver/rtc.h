@@ -33,6 +33,11 @@
  *    - The capture edge can be configured as positive or negative edge
  *    - Capture interrupt can be masked
  *
+ *  With RTC_EPOCH_EN the second counter runs freely and rtc_epoch_*() keep an epoch clock on
+ *  top of it, corrected for the drift measured against reference times. The second interrupt
+ *  is only enabled while an alarm is set. rtc_time_set() and rtc_time_get() shall not be used
+ *  together with the epoch clock.
+ *
  * @{
  *
  ****************************************************************************************
@@ -66,6 +71,21 @@
 /// Total days in a little month
 #define DAYINLITTLEMONTH       30
 
+#if RTC_EPOCH_EN==TRUE
+/// First year of the epoch clock, its seconds are counted from 2000-01-01 00:00:00
+#define RTC_EPOCH_YEAR         2000
+/// Last year the seconds of the epoch clock can reach
+#define RTC_EPOCH_YEAR_MAX     2135
+/// Counts of the 32k clock in a second, see rtc_correction()
+#define RTC_CNT_PER_SEC        32000
+/// Shortest interval between two reference times to estimate the drift (s)
+#ifndef RTC_EPOCH_REF_MIN
+#define RTC_EPOCH_REF_MIN      600
+#endif
+/// Largest drift corrected (ppb), a larger estimate only sets the time
+#define RTC_EPOCH_DRIFT_MAX    500000
+#endif
+
 
 /*
  * ENUMERATION DEFINITIONS
@@ -114,6 +134,30 @@ struct rtc_env_tag
 #endif
 };
 
+#if RTC_EPOCH_EN==TRUE
+/// Date and time of the epoch clock, binary fields
+struct rtc_epoch_date
+{
+    uint16_t year;          /*!< Year, RTC_EPOCH_YEAR ~ RTC_EPOCH_YEAR_MAX */
+    uint8_t  month;         /*!< Month, 1 ~ 12 */
+    uint8_t  day;           /*!< Day, 1 ~ 31 */
+    uint8_t  hour;          /*!< Hour, 0 ~ 23 */
+    uint8_t  minute;        /*!< Minute, 0 ~ 59 */
+    uint8_t  second;        /*!< Second, 0 ~ 59 */
+    uint8_t  week;          /*!< Day of week, 1:monday ...... 7:sunday */
+};
+
+/// Epoch clock drift estimation
+struct rtc_epoch_stat
+{
+    int32_t  drift_ppb;     /*!< Correction applied to the RTC, parts per billion, > 0 when the RTC is slow */
+    int32_t  ref_err;       /*!< Error measured by the last reference time, 1/256 s */
+    uint32_t ref_time;      /*!< Epoch second of the last reference time, 0 if none */
+    uint16_t ref_nb;        /*!< Reference times received */
+    uint16_t drift_nb;      /*!< Drift estimates, the reference times far enough from the previous one */
+};
+#endif
+
 
 /*
  * FUNCTION DEFINITIONS
@@ -191,6 +235,20 @@ __STATIC_INLINE void rtc_reset(void)
     syscon_SetCRSC(QN_SYSCON, SYSCON_MASK_32K_RST);
 }
 
+/**
+ ****************************************************************************************
+ * @brief   Check if rtc_calibration() would wait
+ * @description
+ *  This function is used to postpone a calibration while the last configuration is
+ *  synchronized to the 32k domain, instead of waiting for it.
+ *
+ *****************************************************************************************
+ */
+__STATIC_INLINE bool rtc_calibration_busy(void)
+{
+    return (rtc_rtc_GetSR(QN_RTC) & (RTC_MASK_CALIB_SYNC_BUSY | RTC_MASK_CR_SYNC_BUSY)) != 0;
+}
+
 /*
  * FUNCTION DECLARATIONS
  ****************************************************************************************
@@ -221,6 +279,18 @@ extern uint32_t rtc_time_get(void);
 extern void rtc_time_get(void);
 #endif
 
+#if RTC_EPOCH_EN==TRUE
+extern void rtc_epoch_init(void);
+extern void rtc_epoch_set(uint32_t sec, uint8_t frac_256);
+extern uint32_t rtc_epoch_get(uint8_t *frac_256);
+extern int32_t rtc_epoch_ref(uint32_t sec, uint8_t frac_256);
+extern struct rtc_epoch_stat const *rtc_epoch_stat_get(void);
+extern void rtc_epoch_alarm_set(uint32_t sec, void (*callback)(void));
+extern void rtc_epoch_alarm_clear(void);
+extern void rtc_epoch_to_date(uint32_t sec, struct rtc_epoch_date *date);
+extern bool rtc_epoch_from_date(struct rtc_epoch_date const *date, uint32_t *sec);
+#endif
+
 /// @} RTC
 #endif /* CONFIG_ENABLE_DRIVER_RTC==TRUE */
 #endif /* _RTC_H_ */
@@ -53,6 +53,9 @@ struct sleep_env_tag sleep_env = {QN_DEEP_SLEEP, 0, true, 0, 0};
 volatile uint32_t PGCR1_restore;
 volatile uint8_t low_power_mode_en = 0;
 volatile uint32_t ahb_clock_flag = 0;
+#if (QN_SLEEP_STAT)
+struct sleep_stat_env_tag sleep_stat_env;
+#endif
 
 /*
  * LOCAL FUNCTION DEFINITIONS
@@ -76,11 +79,16 @@ int usr_sleep(void)
     int32_t rt;
 
     rt = sleep_get_pm();
+    if(rt != PM_DEEP_SLEEP)
+    {
+        SLEEP_STAT_BLOCK(SLEEP_BLOCK_PM_SET);
+    }
 
     // If the BLE timer queue is not NULL, prevent entering into DEEPSLEEP mode
     if(rt == PM_DEEP_SLEEP && !ke_timer_empty())
     {
         rt = PM_SLEEP;
+        SLEEP_STAT_BLOCK(SLEEP_BLOCK_KE_TIMER);
     }
 
     // Check Device status
@@ -89,16 +97,19 @@ int usr_sleep(void)
     {
         // If any devices are still working, the chip cann't enter into SLEEP/DEEPSLEEP mode.
         rt = PM_IDLE;
+        SLEEP_STAT_BLOCK(SLEEP_BLOCK_DEVICE);
     }
 
     if ((rt >= PM_SLEEP) && (!gpio_sleep_allowed()))
     {
+        SLEEP_STAT_BLOCK(SLEEP_BLOCK_GPIO);
         return PM_ACTIVE;
     }
 
 #if ACMP_WAKEUP_EN == TRUE
     if ((rt >= PM_SLEEP) && (!acmp_sleep_allowed()))
     {
+        SLEEP_STAT_BLOCK(SLEEP_BLOCK_ACMP);
         return PM_ACTIVE;
     }
 #endif
@@ -110,9 +121,11 @@ int usr_sleep(void)
     if((rt >= PM_SLEEP) && (uart_tx_st == UART_TX_BUF_BUSY))
     {
         rt = PM_IDLE;
+        SLEEP_STAT_BLOCK(SLEEP_BLOCK_DBG_UART);
     }
     else if(uart_tx_st == UART_LAST_BYTE_ONGOING)
     {
+        SLEEP_STAT_BLOCK(SLEEP_BLOCK_DBG_UART);
         return PM_ACTIVE;    // If CLOCK OFF & POWER DOWN is disabled, return immediately
     }
 #endif
@@ -123,6 +136,7 @@ int usr_sleep(void)
         || (eaci_env.rx_state!=EACI_STATE_RX_START)) )          // Check EACI UART RX status
     {
         rt = PM_IDLE;
+        SLEEP_STAT_BLOCK(SLEEP_BLOCK_EACI);
     }
 
     int tx_st = 0;
@@ -131,9 +145,11 @@ int usr_sleep(void)
     if ((rt >= PM_SLEEP) && (tx_st == UART_TX_BUF_BUSY))
     {
         rt = PM_IDLE;
+        SLEEP_STAT_BLOCK(SLEEP_BLOCK_EACI);
     }
     else if (tx_st == UART_LAST_BYTE_ONGOING)
     {
+        SLEEP_STAT_BLOCK(SLEEP_BLOCK_EACI);
         return PM_ACTIVE;    // If CLOCK OFF & POWER DOWN is disabled, return immediately
     }
     #elif (defined(CFG_HCI_SPI))
@@ -141,9 +157,11 @@ int usr_sleep(void)
     if ((rt >= PM_SLEEP) && (tx_st == SPI_TX_BUF_BUSY))
     {
         rt = PM_IDLE;
+        SLEEP_STAT_BLOCK(SLEEP_BLOCK_EACI);
     }
     else if (tx_st == SPI_LAST_BYTE_ONGOING)
     {
+        SLEEP_STAT_BLOCK(SLEEP_BLOCK_EACI);
         return PM_ACTIVE;    // If CLOCK OFF & POWER DOWN is disabled, return immediately
     }
     #endif
@@ -162,6 +180,7 @@ int usr_sleep(void)
     else if(rt > PM_ACTIVE)
     {
         rt = PM_ACTIVE;
+        SLEEP_STAT_BLOCK(SLEEP_BLOCK_XTAL32);
     }
 #endif
 
@@ -169,6 +188,110 @@ int usr_sleep(void)
 }
 #endif
 
+#if (QN_SLEEP_STAT)
+/**
+ ****************************************************************************************
+ * @brief   Record a power mode decision
+ * @param[in]   usr_st  power mode allowed by usr_sleep()
+ * @param[in]   ble_st  power mode allowed by ble_sleep(), ignored when usr_st is PM_ACTIVE
+ * @description
+ *  This function is called with interrupt disabled before the chip enters the decided
+ *  power mode. The kernel time since the last decision is charged to the last power mode
+ *  and to the reasons which blocked it, the 10ms time base makes it a sampled measure
+ *  which is accurate over many decisions. A blocking reason counts one episode each time
+ *  it appears.
+ *****************************************************************************************
+ */
+void sleep_stat_enter(int usr_st, int ble_st)
+{
+    struct sleep_stat *stat = &sleep_stat_env.stat;
+    uint32_t now = ke_time();
+    uint32_t elapsed = (now - sleep_stat_env.time) & SLEEP_STAT_TIME_MASK;
+    uint16_t block;
+    uint8_t pm;
+    uint8_t i;
+
+    // Power mode from the table of the main loop
+    if ((usr_st == PM_ACTIVE) || (ble_st == PM_ACTIVE))
+        pm = PM_ACTIVE;
+    else if ((usr_st == PM_IDLE) || (ble_st == PM_IDLE))
+        pm = PM_IDLE;
+    else
+        pm = usr_st;
+
+    if ((usr_st >= PM_SLEEP) && (ble_st < PM_SLEEP))
+        sleep_stat_block(SLEEP_BLOCK_BLE);
+
+    // Charge the last decision
+    stat->pm[sleep_stat_env.pm].time += elapsed;
+    for (i = 0; i < SLEEP_BLOCK_NUM; i++)
+    {
+        if (sleep_stat_env.block_prev & (1 << i))
+            stat->block[i].time += elapsed;
+    }
+
+    // Start the new one
+    block = sleep_stat_env.block;
+    for (i = 0; i < SLEEP_BLOCK_NUM; i++)
+    {
+        if ((block & ~sleep_stat_env.block_prev) & (1 << i))
+            stat->block[i].count++;
+    }
+    if (block & (1 << SLEEP_BLOCK_DEVICE))
+        stat->dev_bf |= dev_get_bf();
+    if (pm != sleep_stat_env.pm || pm != PM_ACTIVE)
+        stat->pm[pm].count++;
+
+    sleep_stat_env.time = now;
+    sleep_stat_env.pm = pm;
+    sleep_stat_env.block_prev = block;
+    sleep_stat_env.block = 0;
+}
+
+/**
+ ****************************************************************************************
+ * @brief   Record the wakeup sources of a sleep
+ * @description
+ *  This function is called with interrupt disabled when the chip wakes up from sleep or
+ *  deep sleep, the interrupts which woke it up are still pending.
+ *****************************************************************************************
+ */
+void sleep_stat_wakeup(void)
+{
+    uint32_t pending = NVIC->ISPR[0];
+    uint8_t i;
+
+    for (i = 0; i < SLEEP_STAT_IRQ_NUM; i++)
+    {
+        if ((pending & (1 << i)) && (sleep_stat_env.stat.wakeup[i] != 0xFFFF))
+            sleep_stat_env.stat.wakeup[i]++;
+    }
+}
+
+/**
+ ****************************************************************************************
+ * @brief   Get the sleep profile
+ * @param[out]  stat    sleep profile
+ * @description
+ *  The profile is only updated by the main loop, so the background reads it without lock.
+ *****************************************************************************************
+ */
+void sleep_stat_get(struct sleep_stat *stat)
+{
+    *stat = sleep_stat_env.stat;
+}
+
+/**
+ ****************************************************************************************
+ * @brief   Clear the sleep profile
+ *****************************************************************************************
+ */
+void sleep_stat_reset(void)
+{
+    memset(&sleep_stat_env.stat, 0, sizeof(sleep_stat_env.stat));
+}
+#endif
+
 /**
  ****************************************************************************************
  * @brief  Init sleep power down modules
@@ -211,6 +211,78 @@ struct sleep_env_tag
 
 extern struct sleep_env_tag sleep_env;
 
+#if (QN_SLEEP_STAT)
+/// Number of interrupts counted as wakeup sources
+#define SLEEP_STAT_IRQ_NUM          (CALIB_IRQn + 1)
+/// Mask of the 10ms kernel time
+#define SLEEP_STAT_TIME_MASK        (0x7FFFFF)
+
+/// Reasons which kept the chip out of deep sleep, in the order usr_sleep() checks them
+enum SLEEP_BLOCK
+{
+    SLEEP_BLOCK_PM_SET,         /*!< Power mode limited by sleep_set_pm() */
+    SLEEP_BLOCK_KE_TIMER,       /*!< Kernel timer pending */
+    SLEEP_BLOCK_DEVICE,         /*!< Device active, see dev_prevent_sleep() */
+    SLEEP_BLOCK_GPIO,           /*!< GPIO wakeup pin not at its sleep level */
+    SLEEP_BLOCK_ACMP,           /*!< Analog comparator wakeup not allowed */
+    SLEEP_BLOCK_DBG_UART,       /*!< Debug UART transmitting */
+    SLEEP_BLOCK_EACI,           /*!< EACI or HCI transport busy */
+    SLEEP_BLOCK_XTAL32,         /*!< 32k xtal not ready */
+    SLEEP_BLOCK_BLE,            /*!< BLE stack */
+    SLEEP_BLOCK_NUM
+};
+
+/// Number of occurrences and accumulated time in 10ms
+struct sleep_stat_item
+{
+    uint32_t    count;
+    uint32_t    time;
+};
+
+/// Sleep profile
+struct sleep_stat
+{
+    /// Entries and residency of each power mode, PM_ACTIVE to PM_DEEP_SLEEP
+    struct sleep_stat_item  pm[PM_DEEP_SLEEP + 1];
+    /// Episodes and time each reason kept the chip out of deep sleep
+    struct sleep_stat_item  block[SLEEP_BLOCK_NUM];
+    /// Wakeups from sleep and deep sleep, per interrupt
+    uint16_t                wakeup[SLEEP_STAT_IRQ_NUM];
+    /// Devices seen blocking the sleep
+    uint32_t                dev_bf;
+};
+
+/// Sleep profiler environment
+struct sleep_stat_env_tag
+{
+    struct sleep_stat   stat;
+    /// Kernel time of the last power mode decision
+    uint32_t            time;
+    /// Reasons of the decision being made and of the last one
+    uint16_t            block;
+    uint16_t            block_prev;
+    /// Power mode of the last decision
+    uint8_t             pm;
+};
+
+extern struct sleep_stat_env_tag sleep_stat_env;
+
+/**
+ ****************************************************************************************
+ * @brief   Record a reason which keeps the chip out of deep sleep
+ * @param[in]   reason  blocking reason
+ ****************************************************************************************
+ */
+__STATIC_INLINE void sleep_stat_block(enum SLEEP_BLOCK reason)
+{
+    sleep_stat_env.block |= (1 << reason);
+}
+
+#define SLEEP_STAT_BLOCK(reason)    sleep_stat_block(reason)
+#else
+#define SLEEP_STAT_BLOCK(reason)
+#endif
+
 extern volatile uint32_t PGCR1_restore;
 extern volatile uint8_t low_power_mode_en;
 extern volatile uint32_t ahb_clock_flag;
@@ -321,6 +393,13 @@ extern void wakeup_32k_xtal_start_timer(void);
 extern void enter_low_power_mode(uint32_t en);
 extern void restore_from_low_power_mode(void (*callback)(void));
 
+#if (QN_SLEEP_STAT)
+extern void sleep_stat_enter(int usr_st, int ble_st);
+extern void sleep_stat_wakeup(void);
+extern void sleep_stat_get(struct sleep_stat *stat);
+extern void sleep_stat_reset(void);
+#endif
+
 
 
 
@@ -373,14 +373,16 @@ void clock_32k_correction_init(void)
 
 /**
  ****************************************************************************************
- * @brief enable 32k clock correction
+ * @brief start 32k clock correction on a capture window of ncycle 32k cycles
+ * @param[in]    ncycle         Number of 32k cycles measured, a longer window gives a finer result
  * @param[in]    callback       Callback function pointer, which is called in IRQHandler
  * @return
  * @description
- *  This function is used to enable correction of 32K clock
+ *  This function is used to measure the 32K clock against the AHB clock with Timer1, the
+ *  counter value is in timer1_env.count when the callback is called.
  *****************************************************************************************
  */
-void clock_32k_correction_enable(void (*callback)(void))
+void clock_32k_correction_start(uint32_t ncycle, void (*callback)(void))
 {
     uint32_t reg;
     
@@ -391,8 +393,8 @@ void clock_32k_correction_enable(void (*callback)(void))
     syscon_SetCRSS(QN_SYSCON, SYSCON_MASK_TIMER1_RST);
     syscon_SetCRSC(QN_SYSCON, SYSCON_MASK_TIMER1_RST);
 
-    // set counter event top number fix to 16
-    timer_timer_SetTOPR(QN_TIMER1, 16);
+    // set counter event top number to the window
+    timer_timer_SetTOPR(QN_TIMER1, ncycle);
     reg = CLK_PSCL                             /* set clock source to prescaler clock */
         | (0 << TIMER_POS_PSCL)                /* set prescaler to zero */
         | TIMER_MASK_ICNCE                     /* enable input capture noise canceller */
@@ -421,6 +423,60 @@ void clock_32k_correction_enable(void (*callback)(void))
 #endif
 }
 
+/**
+ ****************************************************************************************
+ * @brief enable 32k clock correction
+ * @param[in]    callback       Callback function pointer, which is called in IRQHandler
+ * @return
+ * @description
+ *  This function is used to enable correction of 32K clock
+ *****************************************************************************************
+ */
+void clock_32k_correction_enable(void (*callback)(void))
+{
+    clock_32k_correction_start(CLOCK_32K_CORRECTION_CYCLES, callback);
+}
+
+/**
+ ****************************************************************************************
+ * @brief stop 32k clock correction
+ * @description
+ *  This function is used to stop Timer1 once the capture is read out
+ *****************************************************************************************
+ */
+void clock_32k_correction_stop(void)
+{
+    // disable timer
+    timer_enable(QN_TIMER1, MASK_DISABLE);
+    // Disable Timer1 clock
+    timer_clock_off(QN_TIMER1);
+}
+
+/**
+ ****************************************************************************************
+ * @brief convert a 32k capture to a clock error
+ * @param[in]    count          Timer1 counter value of the capture
+ * @param[in]    ncycle         Number of 32k cycles of the capture window
+ * @return       Clock error in 2^-20 units (about 0.95ppm), positive when the 32k clock is slow,
+ *               limited to +/-0xFFFF as expected by the RTC and set_32k_ppm()
+ *****************************************************************************************
+ */
+int32_t clock_32k_correction_ppm(uint32_t count, uint32_t ncycle)
+{
+    int32_t ppm;
+
+    // Formula: ppm = (0x100000ull * 32000(Hz) * count) / (refclk_freq(Hz) * ncycle) - 0x100000;
+    ppm = (int32_t)((((uint64_t)count * 32000) << 20) / ((uint64_t)__AHB_CLK * ncycle)) - 0x100000;
+
+    if (ppm > 0xFFFF) {
+        ppm = 0xFFFF;
+    }
+    else if (ppm < -0xFFFF) {
+        ppm = -0xFFFF;
+    }
+    return ppm;
+}
+
 /**
  ****************************************************************************************
  * @brief callback function of 32k clock correction
@@ -432,41 +488,22 @@ void clock_32k_correction_enable(void (*callback)(void))
 void clock_32k_correction_cb(void)
 {
     uint32_t dir = 0;
+    int32_t real_ppm;
     uint32_t ppm;
-    uint32_t tmp;
 
     // remove warning
     dir = dir;
 
-    // Formula: ppm = (0x100000ull * 32000(Hz) * count) / (refclk_freq(Hz) * ncycle(32K cycle number));
-    // In this function, refclk_freq is set to 8MHz, ncycle is set to 16
-    //ppm = (0x2000000ull * timer1_env.count) / (8*16 * 1000);
-    //ppm = (0x8000 * timer1_env.count) / 125;
-#if (__AHB_CLK == CLK_8M)
-    tmp = (0x8000 * timer1_env.count);
-#elif (__AHB_CLK == CLK_16M) 
-    tmp = (0x4000 * timer1_env.count);
-#else 
-    tmp = (0x2000 * timer1_env.count);
-#endif
-    // error: 1.3e-9
-    ppm = (tmp>>7) + (tmp>>13) + (tmp>>14) + (tmp>>18) + (tmp>>21) + (tmp>>24) + (tmp>>25) + (tmp>>26);
-    
-    if (ppm > 0x100000) {
-        ppm = ppm - 0x100000;
+    real_ppm = clock_32k_correction_ppm(timer1_env.count, CLOCK_32K_CORRECTION_CYCLES);
+    if (real_ppm >= 0) {
+        ppm = real_ppm;
         dir = 0;
     }
     else {
-        ppm = 0x100000 - ppm;
+        ppm = -real_ppm;
         dir = 1;
     }
-    if (ppm > 0xFFFF) {
-        ppm = 0xFFFF;
-    }
-    // disable timer
-    timer_enable(QN_TIMER1, MASK_DISABLE);
-    // Disable Timer1 clock
-    timer_clock_off(QN_TIMER1);
+    clock_32k_correction_stop();
 
 #if (CONFIG_ENABLE_DRIVER_RTC == TRUE)
     // write to rtc calibration register
@@ -476,7 +513,6 @@ void clock_32k_correction_cb(void)
     // TODO: add user code here
 #ifdef BLE_PRJ
 #if (QN_32K_RCO)
-    int32_t real_ppm = (dir)? -ppm : ppm;
     set_32k_ppm(real_ppm);
     dev_allow_sleep(PM_MASK_TIMER1_ACTIVE_BIT);
 #endif
@@ -56,6 +56,9 @@
 /// BLE_CLK = AHB_CLK/(2*(BLE_DIVIDER+1)), n is BLE_CLK;
 #define BLE_CLK_DIV(n)      (g_AhbClock/(2*n) - 1)
 
+/// Number of 32k cycles measured by clock_32k_correction_enable()
+#define CLOCK_32K_CORRECTION_CYCLES     16
+
 
 /*
  * ENUMERATION DEFINITIONS
@@ -214,7 +217,10 @@ extern enum RESET_CAUSE syscon_get_reset_cause(void);
 extern void syscon_enable_transceiver(uint32_t able);
 #if CLOCK_32K_CORRECTION_EN==TRUE
 extern void clock_32k_correction_init(void);
+extern void clock_32k_correction_start(uint32_t ncycle, void (*callback)(void));
 extern void clock_32k_correction_enable(void (*callback)(void));
+extern void clock_32k_correction_stop(void);
+extern int32_t clock_32k_correction_ppm(uint32_t count, uint32_t ncycle);
 extern void clock_32k_correction_cb(void);
 #endif
 
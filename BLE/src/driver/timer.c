@@ -25,6 +25,9 @@
  ****************************************************************************************
  */
 #include "timer.h"
+#if TIMER_CAP_EN==TRUE
+#include "intc.h"
+#endif
 #if ((CONFIG_ENABLE_DRIVER_TIMER0==TRUE || CONFIG_ENABLE_DRIVER_TIMER1==TRUE \
     || CONFIG_ENABLE_DRIVER_TIMER1==TRUE  || CONFIG_ENABLE_DRIVER_TIMER3==TRUE))
 
@@ -50,6 +53,11 @@ struct timer_env_tag timer2_env;
 struct timer_env_tag timer3_env;
 #endif
 
+#if TIMER_CAP_EN==TRUE
+///Capture engine of each timer
+static struct timer_cap *timer_cap_inst[4];
+#endif
+
 /*
  * FUNCTION DEFINITIONS
  ****************************************************************************************
@@ -106,6 +114,9 @@ void TIMER0_IRQHandler(void)
     uint32_t reg;
 
     reg = timer_timer_GetIntFlag(QN_TIMER0);
+#if TIMER0_CALLBACK_EN==TRUE
+    timer0_env.int_flag = reg;
+#endif
     // timer
     if (reg & TIMER_MASK_TOVF) {
         /* clear interrupt flag */
@@ -151,6 +162,9 @@ void TIMER1_IRQHandler(void)
     uint32_t reg;
 
     reg = timer_timer_GetIntFlag(QN_TIMER1);
+#if TIMER1_CALLBACK_EN==TRUE
+    timer1_env.int_flag = reg;
+#endif
     // timer
     if (reg & TIMER_MASK_TOVF) {
         /* clear interrupt flag */
@@ -196,6 +210,9 @@ void TIMER2_IRQHandler(void)
     uint32_t reg;
 
     reg = timer_timer_GetIntFlag(QN_TIMER2);
+#if TIMER2_CALLBACK_EN==TRUE
+    timer2_env.int_flag = reg;
+#endif
     // timer
     if (reg & TIMER_MASK_TOVF) {
         /* clear interrupt flag */
@@ -241,6 +258,9 @@ void TIMER3_IRQHandler(void)
     uint32_t reg;
 
     reg = timer_timer_GetIntFlag(QN_TIMER3);
+#if TIMER3_CALLBACK_EN==TRUE
+    timer3_env.int_flag = reg;
+#endif
     // timer
     if (reg & TIMER_MASK_TOVF) {
         /* clear interrupt flag */
@@ -587,5 +607,249 @@ void timer_capture_config(QN_TIMER_TypeDef *TIMER, uint32_t cap_mode, uint32_t p
     }
 }
 
+#if TIMER_CAP_EN==TRUE
+/**
+ ****************************************************************************************
+ * @brief Record an edge or an overflow of a capture engine
+ * @param[in]    idx            timer index
+ * @param[in]    flag           interrupt flags
+ * @description
+ * The 16-bit counter is extended by the overflow count into a 32-bit time. When the
+ * overflow is still pending, a capture in the low half of the counter came after it.
+ ****************************************************************************************
+ */
+static void timer_cap_isr(uint8_t idx, uint32_t flag)
+{
+    struct timer_cap *cap = timer_cap_inst[idx];
+    uint32_t ccr;
+    uint32_t ovf;
+
+    if (cap == NULL) {
+        return;
+    }
+
+    if (flag & TIMER_MASK_ICF) {
+        ccr = timer_timer_GetCCR(cap->timer) & 0xFFFF;
+        ovf = cap->ovf;
+        if ((flag & TIMER_MASK_TOVF) && (ccr < 0x8000)) {
+            ovf++;
+        }
+        cap->ts[cap->count & (TIMER_CAP_HIST - 1)] = (ovf << 16) | ccr;
+        cap->count++;
+    }
+    if (flag & TIMER_MASK_TOVF) {
+        cap->ovf++;
+    }
+}
+
+#if (CONFIG_ENABLE_DRIVER_TIMER0==TRUE && CONFIG_TIMER0_DEFAULT_IRQHANDLER==TRUE && TIMER0_CALLBACK_EN==TRUE)
+static void timer_cap0_cb(void)
+{
+    timer_cap_isr(0, timer0_env.int_flag);
+}
+#endif
+#if (CONFIG_ENABLE_DRIVER_TIMER1==TRUE && CONFIG_TIMER1_DEFAULT_IRQHANDLER==TRUE && TIMER1_CALLBACK_EN==TRUE)
+static void timer_cap1_cb(void)
+{
+    timer_cap_isr(1, timer1_env.int_flag);
+}
+#endif
+#if (CONFIG_ENABLE_DRIVER_TIMER2==TRUE && CONFIG_TIMER2_DEFAULT_IRQHANDLER==TRUE && TIMER2_CALLBACK_EN==TRUE)
+static void timer_cap2_cb(void)
+{
+    timer_cap_isr(2, timer2_env.int_flag);
+}
+#endif
+#if (CONFIG_ENABLE_DRIVER_TIMER3==TRUE && CONFIG_TIMER3_DEFAULT_IRQHANDLER==TRUE && TIMER3_CALLBACK_EN==TRUE)
+static void timer_cap3_cb(void)
+{
+    timer_cap_isr(3, timer3_env.int_flag);
+}
+#endif
+
+///Interrupt callback of the capture engine of each timer
+static void (* const timer_cap_cb[4])(void) =
+{
+#if (CONFIG_ENABLE_DRIVER_TIMER0==TRUE && CONFIG_TIMER0_DEFAULT_IRQHANDLER==TRUE && TIMER0_CALLBACK_EN==TRUE)
+    timer_cap0_cb,
+#else
+    NULL,
+#endif
+#if (CONFIG_ENABLE_DRIVER_TIMER1==TRUE && CONFIG_TIMER1_DEFAULT_IRQHANDLER==TRUE && TIMER1_CALLBACK_EN==TRUE)
+    timer_cap1_cb,
+#else
+    NULL,
+#endif
+#if (CONFIG_ENABLE_DRIVER_TIMER2==TRUE && CONFIG_TIMER2_DEFAULT_IRQHANDLER==TRUE && TIMER2_CALLBACK_EN==TRUE)
+    timer_cap2_cb,
+#else
+    NULL,
+#endif
+#if (CONFIG_ENABLE_DRIVER_TIMER3==TRUE && CONFIG_TIMER3_DEFAULT_IRQHANDLER==TRUE && TIMER3_CALLBACK_EN==TRUE)
+    timer_cap3_cb,
+#else
+    NULL,
+#endif
+};
+
+/**
+ ****************************************************************************************
+ * @brief Get the index of a timer
+ ****************************************************************************************
+ */
+static uint8_t timer_cap_index(QN_TIMER_TypeDef *TIMER)
+{
+    if (TIMER == QN_TIMER0) {
+        return 0;
+    }
+    if (TIMER == QN_TIMER1) {
+        return 1;
+    }
+    if (TIMER == QN_TIMER2) {
+        return 2;
+    }
+    return 3;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Start an input capture engine
+ * @param[in]    TIMER          QN_TIMER0,1,2,3
+ * @param[in]    cap            capture engine
+ * @param[in]    pscal          timer prescaler value, the ticks run at TIMER_CAP_HZ(pscal)
+ * @param[in]    edge           INCAP_EDGE_POS, INCAP_EDGE_NEG or INCAP_EDGE_BOTH
+ * @description
+ * The timer counts in input capture timer mode on its TIMER_INCAP_PIN_CFG pin, which shall
+ * be set to its capture function. Every edge is timestamped in the timer interrupt, with
+ * no re-arming, and the last TIMER_CAP_HIST times are kept. The timer default IRQ handler
+ * and callback shall be enabled. The chip does not sleep while the engine runs.
+ ****************************************************************************************
+ */
+void timer_cap_start(QN_TIMER_TypeDef *TIMER, struct timer_cap *cap, uint32_t pscal, enum INCAP_EDGE edge)
+{
+    uint8_t idx = timer_cap_index(TIMER);
+
+    memset(cap, 0, sizeof(struct timer_cap));
+    cap->timer = TIMER;
+    cap->hz = TIMER_CAP_HZ(pscal);
+    timer_cap_inst[idx] = cap;
+
+    timer_init(TIMER, timer_cap_cb[idx]);
+    timer_timer_SetTOPR(TIMER, 0xFFFF);
+    timer_timer_SetCR(TIMER, CLK_PSCL                               /* set clock source to prescaler clock */
+                           | (pscal << TIMER_POS_PSCL)              /* set prescaler value */
+                           | TIMER_MASK_ICNCE                       /* enable input capure noise canceller */
+                           | TIMER_INCAP_PIN_CFG                    /* set input capure pin */
+                           | INCAP_SRC_PIN                          /* set input capure source to capure PIN */
+                           | edge                                   /* set input capure edge */
+                           | INCAP_TIMER_MOD                        /* select input capure timer mode */
+                           | TIMER_MASK_ICIE                        /* enable input capure int */
+                           | TIMER_MASK_TOVIE);                     /* enable timer overflow int */
+    dev_prevent_sleep(PM_MASK_TIMER0_ACTIVE_BIT << idx);
+    timer_enable(TIMER, MASK_ENABLE);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Stop an input capture engine
+ * @param[in]    cap            capture engine, its records are kept
+ ****************************************************************************************
+ */
+void timer_cap_stop(struct timer_cap *cap)
+{
+    uint8_t idx = timer_cap_index(cap->timer);
+
+    if (timer_cap_inst[idx] != cap) {
+        return;
+    }
+
+    timer_enable(cap->timer, MASK_DISABLE);
+    timer_clock_off(cap->timer);
+    dev_allow_sleep(PM_MASK_TIMER0_ACTIVE_BIT << idx);
+    timer_cap_inst[idx] = NULL;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Get the statistics of an input capture engine
+ * @param[in]    cap            capture engine
+ * @param[out]   stat           statistics over the last TIMER_CAP_HIST edges
+ * @description
+ * The frequency is the average over the kept edges. The input is reported stopped when no
+ * edge came for TIMER_CAP_STOP_PERIODS average periods, the period then reads 0 while the
+ * minimum and maximum keep the last values.
+ ****************************************************************************************
+ */
+void timer_cap_stat_get(struct timer_cap *cap, struct timer_cap_stat *stat)
+{
+    uint32_t ts[TIMER_CAP_HIST];
+    uint32_t count;
+    uint32_t now = 0;
+    bool running = false;
+    uint32_t period;
+    uint8_t n;
+    uint8_t i;
+
+    GLOBAL_INT_DISABLE();
+    memcpy(ts, cap->ts, sizeof(ts));
+    count = cap->count;
+    if (timer_cap_inst[timer_cap_index(cap->timer)] == cap) {
+        running = true;
+        now = timer_timer_GetCNT(cap->timer) & 0xFFFF;
+        if ((timer_timer_GetIntFlag(cap->timer) & TIMER_MASK_TOVF) && (now < 0x8000)) {
+            now |= (uint32_t)(cap->ovf + 1) << 16;
+        }
+        else {
+            now |= (uint32_t)cap->ovf << 16;
+        }
+    }
+    GLOBAL_INT_RESTORE();
+
+    memset(stat, 0, sizeof(struct timer_cap_stat));
+    stat->count = count;
+    if (count == 0) {
+        return;
+    }
+    stat->last = ts[(count - 1) & (TIMER_CAP_HIST - 1)];
+
+    // Periods between the kept edges, newest first
+    n = (count < TIMER_CAP_HIST) ? count : TIMER_CAP_HIST;
+    stat->period_min = 0xFFFFFFFF;
+    for (i = 1; i < n; i++) {
+        period = ts[(count - i) & (TIMER_CAP_HIST - 1)] - ts[(count - i - 1) & (TIMER_CAP_HIST - 1)];
+        if (period < stat->period_min) {
+            stat->period_min = period;
+        }
+        if (period > stat->period_max) {
+            stat->period_max = period;
+        }
+    }
+    if (n < 2) {
+        stat->period_min = 0;
+        return;
+    }
+
+    period = (stat->last - ts[(count - n) & (TIMER_CAP_HIST - 1)]) / (n - 1);
+    if ((period == 0) || (running && ((now - stat->last) > period * TIMER_CAP_STOP_PERIODS))) {
+        return;
+    }
+    stat->period = period;
+    stat->freq = (uint32_t)(((uint64_t)cap->hz * 1000) / period);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Convert a capture time to 1/1024 s
+ * @param[in]    cap            capture engine
+ * @param[in]    time           time in ticks
+ * @return time in 1/1024 s, wrapping as the event times of the CSC profile
+ ****************************************************************************************
+ */
+uint16_t timer_cap_time_1024(struct timer_cap const *cap, uint32_t time)
+{
+    return (uint16_t)(((uint64_t)time << 10) / cap->hz);
+}
+#endif
+
 #endif /* CONFIG_ENABLE_DRIVER_TIMER==TRUE */
 /// @} TIMER
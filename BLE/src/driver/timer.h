@@ -170,8 +170,39 @@ struct timer_env_tag
 {
     uint32_t    count;                          /*!< Timer counter value, different working modes have different values */
     void        (*callback)(void);              /*!< The callback of timer interrupt */
+    uint32_t    int_flag;                       /*!< Interrupt flags of the last interrupt */
 };
 
+#if TIMER_CAP_EN==TRUE
+/// Number of edge timestamps kept by a capture engine, power of 2
+#define TIMER_CAP_HIST                  8
+/// Edges missing for this many average periods mean the input stopped
+#define TIMER_CAP_STOP_PERIODS          4
+/// Tick frequency of a capture engine with a prescaler value
+#define TIMER_CAP_HZ(pscal)             PSCL_CLK(TIMER_DIV, pscal)
+
+///Input capture engine, allocated by its user
+struct timer_cap
+{
+    QN_TIMER_TypeDef    *timer;                 /*!< Hardware timer */
+    uint32_t            hz;                     /*!< Tick frequency */
+    uint32_t            ts[TIMER_CAP_HIST];     /*!< Times of the last edges in ticks */
+    uint32_t            count;                  /*!< Number of edges since start */
+    uint16_t            ovf;                    /*!< Counter overflows, high half of the time */
+};
+
+///Input capture statistics over the last edges
+struct timer_cap_stat
+{
+    uint32_t            count;                  /*!< Number of edges since start */
+    uint32_t            last;                   /*!< Time of the last edge in ticks */
+    uint32_t            period;                 /*!< Average period in ticks, 0 when stopped */
+    uint32_t            period_min;             /*!< Shortest period in ticks */
+    uint32_t            period_max;             /*!< Longest period in ticks */
+    uint32_t            freq;                   /*!< Average frequency in mHz, 0 when stopped */
+};
+#endif
+
 
 /*
  * FUNCTION DEFINITIONS
@@ -354,6 +385,12 @@ extern void timer_init(QN_TIMER_TypeDef *TIMER, void (*callback)(void));
 extern void timer_config(QN_TIMER_TypeDef *TIMER, uint32_t pscal, uint32_t count);
 extern void timer_pwm_config(QN_TIMER_TypeDef *TIMER, uint32_t pscal, uint32_t periodcount, uint32_t pulsecount);
 extern void timer_capture_config(QN_TIMER_TypeDef *TIMER, uint32_t cap_mode, uint32_t pscal, uint32_t count, uint32_t event_num);
+#if TIMER_CAP_EN==TRUE
+extern void timer_cap_start(QN_TIMER_TypeDef *TIMER, struct timer_cap *cap, uint32_t pscal, enum INCAP_EDGE edge);
+extern void timer_cap_stop(struct timer_cap *cap);
+extern void timer_cap_stat_get(struct timer_cap *cap, struct timer_cap_stat *stat);
+extern uint16_t timer_cap_time_1024(struct timer_cap const *cap, uint32_t time);
+#endif
 
 
 /// @} TIMER
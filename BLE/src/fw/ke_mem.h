@@ -31,6 +31,9 @@
 #define _KE_MEM_H_
 
 #include <stdint.h>                 // standard includes
+#include <stddef.h>                 // offsetof
+#include "co_list.h"                // co_list
+#include "fw_func_addr.h"           // _ke_env
 
 /**
  ****************************************************************************************
@@ -45,6 +48,38 @@
  ****************************************************************************************
  */
 
+/// Free block of the ROM heap, free blocks are linked in address order
+struct mblock_free
+{
+    /// Next free block
+    struct mblock_free *next;
+    /// Block size, this header included
+    uint32_t size;
+};
+
+/// Head of the kernel environment of the ROM, at _ke_env
+struct ke_env_tag
+{
+    /// Messages sent but not yet handled
+    struct co_list queue_sent;
+    /// Messages saved by their receiver until it changes state
+    struct co_list queue_saved;
+    /// Programmed timers
+    struct co_list queue_timer;
+    /// First free block of the heap
+    struct mblock_free *mblock_first;
+};
+
+/// Offset of mblock_first in the ROM, three lists of two pointers
+#define KE_ENV_MBLOCK_FIRST_OFFSET      24
+
+/// ROM layout check, only meaningful with the 32-bit pointers of the chip
+#define KE_ENV_CHECK(cond)              ((sizeof(void *) != 4) || (cond))
+typedef char ke_env_offset_check[KE_ENV_CHECK(offsetof(struct ke_env_tag, mblock_first)
+                                              == KE_ENV_MBLOCK_FIRST_OFFSET) ? 1 : -1];
+typedef char ke_env_size_check[KE_ENV_CHECK(sizeof(struct ke_env_tag)
+                                            <= (_aci_env - _ke_env)) ? 1 : -1];
+
 /**
  ****************************************************************************************
  * @brief Allocation of a block of memory.
@@ -0,0 +1,478 @@
+/**
+ ****************************************************************************************
+ *
+ * @file eaci_codec.c
+ *
+ * @brief Easy ACI message codec driven by the layouts of eaci_schema.h.
+ *
+ * Copyright(C) 2015 NXP Semiconductors N.V.
+ * All rights reserved.
+ *
+ * $Rev: $
+ *
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+#include <string.h>
+#include "eaci_codec.h"
+#include "attm.h"
+
+/*
+ * GLOBAL VARIABLE DEFINITIONS
+ ****************************************************************************************
+ */
+
+#define EACI_SCHEMA_CMD_LAYOUT(name, layout, evt, key)  layout,
+#define EACI_SCHEMA_CMD_EVT(name, layout, evt, key)     EACI_MSG_EVT_##evt,
+#define EACI_SCHEMA_CMD_KEY(name, layout, evt, key)     EACI_KEY_##key,
+#define EACI_SCHEMA_LAYOUT(name, layout)                layout,
+
+/// Parameter layout of each EACI command, indexed by command id
+const char * const eaci_cmd_layout[EACI_MSG_CMD_MAX] =
+{
+    NULL,
+    EACI_CMD_SCHEMA(EACI_SCHEMA_CMD_LAYOUT)
+};
+
+/// Event answering each EACI command, indexed by command id
+const uint8_t eaci_cmd_evt[EACI_MSG_CMD_MAX] =
+{
+    EACI_MSG_EVT_RSV,
+    EACI_CMD_SCHEMA(EACI_SCHEMA_CMD_EVT)
+};
+
+/// How the answering event of each EACI command is matched, indexed by command id
+const uint8_t eaci_cmd_key[EACI_MSG_CMD_MAX] =
+{
+    EACI_KEY_NONE,
+    EACI_CMD_SCHEMA(EACI_SCHEMA_CMD_KEY)
+};
+
+/// Parameter layout of each EACI event, indexed by event id
+const char * const eaci_evt_layout[EACI_MSG_EVT_MAX] =
+{
+    NULL,
+    EACI_EVT_SCHEMA(EACI_SCHEMA_LAYOUT)
+};
+
+/*
+ * LOCAL VARIABLE DEFINITIONS
+ ****************************************************************************************
+ */
+
+/// Parameter layouts of the data messages of a profile, indexed by data id: the client
+/// ones, then the server ones
+#define EACI_DATA_LAYOUT(cli, srv)      {NULL, cli(EACI_SCHEMA_LAYOUT) srv(EACI_SCHEMA_LAYOUT)}
+/// Profile without data messages on one side
+#define EACI_DATA_NONE_SCHEMA(X)
+
+static const char * const eaci_data_req_an[] = EACI_DATA_LAYOUT(EACI_DATA_REQ_ANPC_SCHEMA, EACI_DATA_REQ_ANPS_SCHEMA);
+static const char * const eaci_data_ind_an[] = EACI_DATA_LAYOUT(EACI_DATA_IND_ANPC_SCHEMA, EACI_DATA_IND_ANPS_SCHEMA);
+static const char * const eaci_data_req_batt[] = EACI_DATA_LAYOUT(EACI_DATA_REQ_BASC_SCHEMA, EACI_DATA_REQ_BASS_SCHEMA);
+static const char * const eaci_data_ind_batt[] = EACI_DATA_LAYOUT(EACI_DATA_IND_BASC_SCHEMA, EACI_DATA_IND_BASS_SCHEMA);
+static const char * const eaci_data_req_bp[] = EACI_DATA_LAYOUT(EACI_DATA_REQ_BLPC_SCHEMA, EACI_DATA_REQ_BLPS_SCHEMA);
+static const char * const eaci_data_ind_bp[] = EACI_DATA_LAYOUT(EACI_DATA_IND_BLPC_SCHEMA, EACI_DATA_IND_BLPS_SCHEMA);
+static const char * const eaci_data_req_csc[] = EACI_DATA_LAYOUT(EACI_DATA_REQ_CSCPC_SCHEMA, EACI_DATA_REQ_CSCPS_SCHEMA);
+static const char * const eaci_data_ind_csc[] = EACI_DATA_LAYOUT(EACI_DATA_IND_CSCPC_SCHEMA, EACI_DATA_IND_CSCPS_SCHEMA);
+static const char * const eaci_data_req_dis[] = EACI_DATA_LAYOUT(EACI_DATA_REQ_DISC_SCHEMA, EACI_DATA_REQ_DISS_SCHEMA);
+static const char * const eaci_data_ind_dis[] = EACI_DATA_LAYOUT(EACI_DATA_IND_DISC_SCHEMA, EACI_DATA_NONE_SCHEMA);
+static const char * const eaci_data_req_fm[] = EACI_DATA_LAYOUT(EACI_DATA_REQ_FINDL_SCHEMA, EACI_DATA_NONE_SCHEMA);
+static const char * const eaci_data_ind_fm[] = EACI_DATA_LAYOUT(EACI_DATA_IND_FINDL_SCHEMA, EACI_DATA_IND_FINDT_SCHEMA);
+static const char * const eaci_data_req_gl[] = EACI_DATA_LAYOUT(EACI_DATA_REQ_GLPC_SCHEMA, EACI_DATA_REQ_GLPS_SCHEMA);
+static const char * const eaci_data_ind_gl[] = EACI_DATA_LAYOUT(EACI_DATA_IND_GLPC_SCHEMA, EACI_DATA_IND_GLPS_SCHEMA);
+static const char * const eaci_data_req_hrp[] = EACI_DATA_LAYOUT(EACI_DATA_REQ_HRPC_SCHEMA, EACI_DATA_REQ_HRPS_SCHEMA);
+static const char * const eaci_data_ind_hrp[] = EACI_DATA_LAYOUT(EACI_DATA_IND_HRPC_SCHEMA, EACI_DATA_IND_HRPS_SCHEMA);
+static const char * const eaci_data_req_ht[] = EACI_DATA_LAYOUT(EACI_DATA_REQ_HTPC_SCHEMA, EACI_DATA_REQ_HTPT_SCHEMA);
+static const char * const eaci_data_ind_ht[] = EACI_DATA_LAYOUT(EACI_DATA_IND_HTPC_SCHEMA, EACI_DATA_IND_HTPT_SCHEMA);
+static const char * const eaci_data_req_pas[] = EACI_DATA_LAYOUT(EACI_DATA_REQ_PASPC_SCHEMA, EACI_DATA_REQ_PASPS_SCHEMA);
+static const char * const eaci_data_ind_pas[] = EACI_DATA_LAYOUT(EACI_DATA_IND_PASPC_SCHEMA, EACI_DATA_IND_PASPS_SCHEMA);
+static const char * const eaci_data_req_prox[] = EACI_DATA_LAYOUT(EACI_DATA_REQ_PROXM_SCHEMA, EACI_DATA_NONE_SCHEMA);
+static const char * const eaci_data_ind_prox[] = EACI_DATA_LAYOUT(EACI_DATA_IND_PROXM_SCHEMA, EACI_DATA_IND_PROXR_SCHEMA);
+static const char * const eaci_data_req_rsc[] = EACI_DATA_LAYOUT(EACI_DATA_REQ_RSCPC_SCHEMA, EACI_DATA_REQ_RSCPS_SCHEMA);
+static const char * const eaci_data_ind_rsc[] = EACI_DATA_LAYOUT(EACI_DATA_IND_RSCPC_SCHEMA, EACI_DATA_IND_RSCPS_SCHEMA);
+static const char * const eaci_data_req_sp[] = EACI_DATA_LAYOUT(EACI_DATA_REQ_SCPPC_SCHEMA, EACI_DATA_REQ_SCPPS_SCHEMA);
+static const char * const eaci_data_ind_sp[] = EACI_DATA_LAYOUT(EACI_DATA_IND_SCPPC_SCHEMA, EACI_DATA_IND_SCPPS_SCHEMA);
+static const char * const eaci_data_req_tip[] = EACI_DATA_LAYOUT(EACI_DATA_REQ_TIPC_SCHEMA, EACI_DATA_REQ_TIPS_SCHEMA);
+static const char * const eaci_data_ind_tip[] = EACI_DATA_LAYOUT(EACI_DATA_IND_TIPC_SCHEMA, EACI_DATA_IND_TIPS_SCHEMA);
+
+/// Data message layouts of the profiles using a service UUID
+struct eaci_data_schema
+{
+    /// Service UUID leading the parameters
+    uint16_t uuid;
+    /// Number of data request ids, reserved one included
+    uint8_t req_nb;
+    /// Number of data indication ids, reserved one included
+    uint8_t ind_nb;
+    /// Data request layouts, indexed by id
+    const char * const *req;
+    /// Data indication layouts, indexed by id
+    const char * const *ind;
+};
+
+#define EACI_DATA_SCHEMA(uuid, req, ind) \
+    {uuid, sizeof(req) / sizeof(req[0]), sizeof(ind) / sizeof(ind[0]), req, ind}
+
+/// Data message layouts, by service UUID
+static const struct eaci_data_schema eaci_data_schema_tab[] =
+{
+    EACI_DATA_SCHEMA(ATT_SVC_ALERT_NTF,             eaci_data_req_an,   eaci_data_ind_an),
+    EACI_DATA_SCHEMA(ATT_SVC_BATTERY_SERVICE,       eaci_data_req_batt, eaci_data_ind_batt),
+    EACI_DATA_SCHEMA(ATT_SVC_BLOOD_PRESSURE,        eaci_data_req_bp,   eaci_data_ind_bp),
+    EACI_DATA_SCHEMA(ATT_SVC_CYCLING_SPEED_CADENCE, eaci_data_req_csc,  eaci_data_ind_csc),
+    EACI_DATA_SCHEMA(ATT_SVC_DEVICE_INFO,           eaci_data_req_dis,  eaci_data_ind_dis),
+    EACI_DATA_SCHEMA(ATT_SVC_IMMEDIATE_ALERT,       eaci_data_req_fm,   eaci_data_ind_fm),
+    EACI_DATA_SCHEMA(ATT_SVC_GLUCOSE,               eaci_data_req_gl,   eaci_data_ind_gl),
+    EACI_DATA_SCHEMA(ATT_SVC_HEART_RATE,            eaci_data_req_hrp,  eaci_data_ind_hrp),
+    EACI_DATA_SCHEMA(ATT_SVC_HEALTH_THERMOM,        eaci_data_req_ht,   eaci_data_ind_ht),
+    EACI_DATA_SCHEMA(ATT_SVC_PHONE_ALERT_STATUS,    eaci_data_req_pas,  eaci_data_ind_pas),
+    EACI_DATA_SCHEMA(ATT_SVC_LINK_LOSS,             eaci_data_req_prox, eaci_data_ind_prox),
+    EACI_DATA_SCHEMA(ATT_SVC_TX_POWER,              eaci_data_req_prox, eaci_data_ind_prox),
+    EACI_DATA_SCHEMA(ATT_SVC_RUNNING_SPEED_CADENCE, eaci_data_req_rsc,  eaci_data_ind_rsc),
+    EACI_DATA_SCHEMA(ATT_SVC_SCAN_PARAMETERS,       eaci_data_req_sp,   eaci_data_ind_sp),
+    EACI_DATA_SCHEMA(ATT_SVC_CURRENT_TIME,          eaci_data_req_tip,  eaci_data_ind_tip),
+    EACI_DATA_SCHEMA(ATT_SVC_REF_TIME_UPDATE,       eaci_data_req_tip,  eaci_data_ind_tip),
+    EACI_DATA_SCHEMA(ATT_SVC_NEXT_DST_CHANGE,       eaci_data_req_tip,  eaci_data_ind_tip),
+};
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @brief Length of the fixed fields of a layout.
+ *
+ ****************************************************************************************
+ */
+static uint16_t eaci_layout_len(char const *layout, bool *var)
+{
+    uint16_t len = 0;
+
+    *var = false;
+    for (; *layout != '\0'; layout++)
+    {
+        switch (*layout)
+        {
+        case 'B':
+            len += 1;
+            break;
+        case 'H':
+            len += 2;
+            break;
+        case 'W':
+            len += 4;
+            break;
+        case 'A':
+            len += BD_ADDR_LEN;
+            break;
+        case 's':
+            *var = true;
+            break;
+        default:
+            break;
+        }
+    }
+
+    return len;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Check a parameter length against a layout.
+ *
+ ****************************************************************************************
+ */
+bool eaci_layout_check(char const *layout, uint8_t param_len)
+{
+    bool var;
+    uint16_t len;
+
+    if (layout == NULL)
+        return false;
+
+    len = eaci_layout_len(layout, &var);
+
+    return var ? (param_len >= len) : (param_len == len);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Data message layouts of a service UUID, NULL for an unknown service.
+ *
+ ****************************************************************************************
+ */
+static struct eaci_data_schema const *eaci_data_schema_find(uint16_t uuid)
+{
+    for (uint8_t i = 0; i < sizeof(eaci_data_schema_tab) / sizeof(eaci_data_schema_tab[0]); i++)
+    {
+        if (eaci_data_schema_tab[i].uuid == uuid)
+            return &eaci_data_schema_tab[i];
+    }
+
+    return NULL;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Parameter layout of a data request.
+ *
+ ****************************************************************************************
+ */
+char const *eaci_data_req_layout(uint16_t uuid, uint8_t id)
+{
+    struct eaci_data_schema const *schema = eaci_data_schema_find(uuid);
+
+    return (schema != NULL && id < schema->req_nb) ? schema->req[id] : NULL;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Parameter layout of a data indication.
+ *
+ ****************************************************************************************
+ */
+char const *eaci_data_ind_layout(uint16_t uuid, uint8_t id)
+{
+    struct eaci_data_schema const *schema = eaci_data_schema_find(uuid);
+
+    return (schema != NULL && id < schema->ind_nb) ? schema->ind[id] : NULL;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Find the BD address field of a message.
+ *
+ ****************************************************************************************
+ */
+uint8_t const *eaci_layout_addr(char const *layout, uint8_t const *param, uint8_t param_len)
+{
+    uint16_t off = 0;
+
+    if (layout == NULL)
+        return NULL;
+
+    for (; *layout != '\0'; layout++)
+    {
+        switch (*layout)
+        {
+        case 'B':
+            off += 1;
+            break;
+        case 'H':
+            off += 2;
+            break;
+        case 'W':
+            off += 4;
+            break;
+        case 'A':
+            return (off + BD_ADDR_LEN <= param_len) ? (param + off) : NULL;
+        default:
+            // Nothing has a fixed offset after a variable field
+            return NULL;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Pack the fields of a layout from offset len of pdu, fill the header.
+ *
+ ****************************************************************************************
+ */
+static uint16_t eaci_vpack_param(uint8_t *pdu, uint16_t len, uint8_t type, uint8_t id,
+                                 char const *layout, va_list ap)
+{
+    uint16_t val;
+    uint32_t word;
+    uint8_t const *data;
+    struct bd_addr const *addr;
+
+    if (layout == NULL)
+        return 0;
+
+    for (; *layout != '\0'; layout++)
+    {
+        switch (*layout)
+        {
+        case 'B':
+            pdu[len++] = (uint8_t)va_arg(ap, unsigned int);
+            break;
+        case 'H':
+            val = (uint16_t)va_arg(ap, unsigned int);
+            pdu[len++] = (uint8_t)(val & 0xff);
+            pdu[len++] = (uint8_t)(val >> 8);
+            break;
+        case 'W':
+            word = va_arg(ap, uint32_t);
+            pdu[len++] = (uint8_t)(word & 0xff);
+            pdu[len++] = (uint8_t)(word >> 8);
+            pdu[len++] = (uint8_t)(word >> 16);
+            pdu[len++] = (uint8_t)(word >> 24);
+            break;
+        case 'A':
+            addr = va_arg(ap, struct bd_addr const *);
+            memcpy(pdu + len, addr->addr, BD_ADDR_LEN);
+            len += BD_ADDR_LEN;
+            break;
+        case 's':
+            val = (uint8_t)va_arg(ap, unsigned int);
+            data = va_arg(ap, uint8_t const *);
+            if (len + val > EACI_PDU_MAX_LEN)
+                return 0;
+            memcpy(pdu + len, data, val);
+            len += val;
+            break;
+        default:
+            break;
+        }
+    }
+
+    pdu[0] = type;
+    pdu[1] = id;
+    pdu[2] = (uint8_t)(len - EACI_PDU_HDR_LEN);
+
+    return len;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Pack an EACI message.
+ *
+ ****************************************************************************************
+ */
+uint16_t eaci_vpack(uint8_t *pdu, uint8_t type, uint8_t id, char const *layout, va_list ap)
+{
+    return eaci_vpack_param(pdu, EACI_PDU_HDR_LEN, type, id, layout, ap);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Pack an EACI message.
+ *
+ ****************************************************************************************
+ */
+uint16_t eaci_pack(uint8_t *pdu, uint8_t type, uint8_t id, char const *layout, ...)
+{
+    va_list ap;
+    uint16_t len;
+
+    va_start(ap, layout);
+    len = eaci_vpack(pdu, type, id, layout, ap);
+    va_end(ap);
+
+    return len;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Pack an EACI data request or indication.
+ *
+ ****************************************************************************************
+ */
+uint16_t eaci_data_vpack(uint8_t *pdu, uint8_t type, uint8_t id, uint16_t uuid,
+                         char const *layout, va_list ap)
+{
+    pdu[EACI_PDU_HDR_LEN] = (uint8_t)(uuid & 0xff);
+    pdu[EACI_PDU_HDR_LEN + 1] = (uint8_t)(uuid >> 8);
+
+    return eaci_vpack_param(pdu, EACI_PDU_HDR_LEN + EACI_DATA_UUID_LEN, type, id, layout, ap);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Pack an EACI data request or indication.
+ *
+ ****************************************************************************************
+ */
+uint16_t eaci_data_pack(uint8_t *pdu, uint8_t type, uint8_t id, uint16_t uuid, char const *layout, ...)
+{
+    va_list ap;
+    uint16_t len;
+
+    va_start(ap, layout);
+    len = eaci_data_vpack(pdu, type, id, uuid, layout, ap);
+    va_end(ap);
+
+    return len;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Unpack the parameters of an EACI message.
+ *
+ ****************************************************************************************
+ */
+bool eaci_vunpack(uint8_t const *param, uint8_t param_len, char const *layout, va_list ap)
+{
+    uint8_t const *end = param + param_len;
+    uint16_t *val;
+    uint32_t *word;
+    uint8_t *len;
+    struct bd_addr *addr;
+
+    if (!eaci_layout_check(layout, param_len))
+        return false;
+
+    for (; *layout != '\0'; layout++)
+    {
+        switch (*layout)
+        {
+        case 'B':
+            *va_arg(ap, uint8_t *) = *param++;
+            break;
+        case 'H':
+            val = va_arg(ap, uint16_t *);
+            *val = param[1] << 8 | param[0];
+            param += 2;
+            break;
+        case 'W':
+            word = va_arg(ap, uint32_t *);
+            *word = (uint32_t)param[3] << 24 | (uint32_t)param[2] << 16 | param[1] << 8 | param[0];
+            param += 4;
+            break;
+        case 'A':
+            addr = va_arg(ap, struct bd_addr *);
+            memcpy(addr->addr, param, BD_ADDR_LEN);
+            param += BD_ADDR_LEN;
+            break;
+        case 's':
+            len = va_arg(ap, uint8_t *);
+            *len = (uint8_t)(end - param);
+            *va_arg(ap, uint8_t const **) = param;
+            param = end;
+            break;
+        default:
+            break;
+        }
+    }
+
+    return true;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Unpack the parameters of an EACI message.
+ *
+ ****************************************************************************************
+ */
+bool eaci_unpack(uint8_t const *param, uint8_t param_len, char const *layout, ...)
+{
+    va_list ap;
+    bool ret;
+
+    va_start(ap, layout);
+    ret = eaci_vunpack(param, param_len, layout, ap);
+    va_end(ap);
+
+    return ret;
+}
+
+/// @} EACI_CODEC
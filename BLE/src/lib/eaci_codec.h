@@ -0,0 +1,192 @@
+/**
+ ****************************************************************************************
+ *
+ * @file eaci_codec.h
+ *
+ * @brief Easy ACI message codec driven by the layouts of eaci_schema.h.
+ *
+ * Copyright(C) 2015 NXP Semiconductors N.V.
+ * All rights reserved.
+ *
+ * $Rev: $
+ *
+ ****************************************************************************************
+ */
+
+#ifndef _EACI_CODEC_H_
+#define _EACI_CODEC_H_
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "co_bt.h"
+#include "eaci_schema.h"
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// Length of the EACI message header: type, id and parameter length
+#define EACI_PDU_HDR_LEN            3
+/// Maximum length of an EACI message
+#define EACI_PDU_MAX_LEN            (EACI_PDU_HDR_LEN + 0xFF)
+/// Length of the service UUID leading the parameters of a data request or indication
+#define EACI_DATA_UUID_LEN          2
+/// Longest data message parameters without variable field, after the service UUID
+#define EACI_DATA_FIX_MAX_LEN       16
+
+/*
+ * GLOBAL VARIABLE DECLARATIONS
+ ****************************************************************************************
+ */
+
+/// Parameter layout of each EACI command, indexed by command id
+extern const char * const eaci_cmd_layout[EACI_MSG_CMD_MAX];
+/// Event answering each EACI command, indexed by command id
+extern const uint8_t eaci_cmd_evt[EACI_MSG_CMD_MAX];
+/// How the answering event of each EACI command is matched, indexed by command id
+extern const uint8_t eaci_cmd_key[EACI_MSG_CMD_MAX];
+/// Parameter layout of each EACI event, indexed by event id
+extern const char * const eaci_evt_layout[EACI_MSG_EVT_MAX];
+
+/*
+ * FUNCTION DECLARATIONS
+ ****************************************************************************************
+ */
+
+/*
+ ****************************************************************************************
+ * @brief Check a parameter length against a layout.
+ *
+ * @param[in] layout     Parameter layout, NULL for an unknown message
+ * @param[in] param_len  Received parameter length
+ *
+ * @return true if the length is the layout length, or at least the fixed part of it
+ *         when the layout ends with a variable field.
+ ****************************************************************************************
+ */
+bool eaci_layout_check(char const *layout, uint8_t param_len);
+
+/*
+ ****************************************************************************************
+ * @brief Find the BD address field of a message.
+ *
+ * @param[in] layout     Parameter layout, NULL for an unknown message
+ * @param[in] param      Message parameters
+ * @param[in] param_len  Parameter length
+ *
+ * @return The first address field in param, NULL if the layout has none or the
+ *         parameters are too short to hold it.
+ ****************************************************************************************
+ */
+uint8_t const *eaci_layout_addr(char const *layout, uint8_t const *param, uint8_t param_len);
+
+/*
+ ****************************************************************************************
+ * @brief Parameter layout of a data request.
+ *
+ * @param[in] uuid       Service UUID leading the request parameters
+ * @param[in] id         Data request id
+ *
+ * @return The layout of the parameters after the UUID, NULL for an unknown request.
+ ****************************************************************************************
+ */
+char const *eaci_data_req_layout(uint16_t uuid, uint8_t id);
+
+/*
+ ****************************************************************************************
+ * @brief Parameter layout of a data indication.
+ *
+ * @param[in] uuid       Service UUID leading the indication parameters
+ * @param[in] id         Data indication id
+ *
+ * @return The layout of the parameters after the UUID, NULL for an unknown indication.
+ ****************************************************************************************
+ */
+char const *eaci_data_ind_layout(uint16_t uuid, uint8_t id);
+
+/*
+ ****************************************************************************************
+ * @brief Pack an EACI message.
+ *
+ * The fields follow the layout: 'B' and 'H' take an unsigned int, 'W' a uint32_t, 'A'
+ * takes a struct bd_addr const *, 's' takes a uint8_t length then a uint8_t const * buffer.
+ *
+ * @param[out] pdu      Message buffer, at least EACI_PDU_MAX_LEN bytes
+ * @param[in]  type     Message type
+ * @param[in]  id       Message id
+ * @param[in]  layout   Parameter layout
+ * @param[in]  ap       Fields
+ *
+ * @return Message length, 0 if the parameters do not fit in a message.
+ ****************************************************************************************
+ */
+uint16_t eaci_vpack(uint8_t *pdu, uint8_t type, uint8_t id, char const *layout, va_list ap);
+
+/*
+ ****************************************************************************************
+ * @brief Pack an EACI message, see eaci_vpack().
+ *
+ ****************************************************************************************
+ */
+uint16_t eaci_pack(uint8_t *pdu, uint8_t type, uint8_t id, char const *layout, ...);
+
+/*
+ ****************************************************************************************
+ * @brief Pack an EACI data request or indication: the service UUID, then the fields as
+ * in eaci_vpack().
+ *
+ * @param[out] pdu      Message buffer, at least EACI_PDU_MAX_LEN bytes, or
+ *                      EACI_PDU_HDR_LEN + EACI_DATA_UUID_LEN + EACI_DATA_FIX_MAX_LEN for a
+ *                      layout without variable field
+ * @param[in]  type     Message type
+ * @param[in]  id       Data message id
+ * @param[in]  uuid     Service UUID
+ * @param[in]  layout   Parameter layout after the UUID, NULL for an unknown message
+ * @param[in]  ap       Fields
+ *
+ * @return Message length, 0 for an unknown message or if the parameters do not fit.
+ ****************************************************************************************
+ */
+uint16_t eaci_data_vpack(uint8_t *pdu, uint8_t type, uint8_t id, uint16_t uuid,
+                         char const *layout, va_list ap);
+
+/*
+ ****************************************************************************************
+ * @brief Pack an EACI data request or indication, see eaci_data_vpack().
+ *
+ ****************************************************************************************
+ */
+uint16_t eaci_data_pack(uint8_t *pdu, uint8_t type, uint8_t id, uint16_t uuid, char const *layout, ...);
+
+/*
+ ****************************************************************************************
+ * @brief Unpack the parameters of an EACI message.
+ *
+ * The fields follow the layout: 'B' takes a uint8_t *, 'H' a uint16_t *, 'W' a
+ * uint32_t *, 'A' a struct bd_addr *, 's' a uint8_t * length then a uint8_t const ** pointing in param.
+ *
+ * @param[in] param      Message parameters
+ * @param[in] param_len  Message parameter length
+ * @param[in] layout     Parameter layout
+ * @param[in] ap         Fields
+ *
+ * @return false if the parameter length does not match the layout, nothing is unpacked.
+ ****************************************************************************************
+ */
+bool eaci_vunpack(uint8_t const *param, uint8_t param_len, char const *layout, va_list ap);
+
+/*
+ ****************************************************************************************
+ * @brief Unpack the parameters of an EACI message, see eaci_vunpack().
+ *
+ ****************************************************************************************
+ */
+bool eaci_unpack(uint8_t const *param, uint8_t param_len, char const *layout, ...);
+
+#endif // _EACI_CODEC_H_
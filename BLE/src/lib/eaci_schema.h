@@ -0,0 +1,1133 @@
+/**
+ ****************************************************************************************
+ *
+ * @file eaci_schema.h
+ *
+ * @brief Easy ACI message schema, shared by the EACI controller and host.
+ *
+ * Each command and event is described once, by its name and the layout of its
+ * parameters, commands also name the event answering them. The message ids are the
+ * positions in the lists, the codec in eaci_codec.c packs and checks the parameters
+ * from the same layouts.
+ *
+ * Profile data requests and indications are described the same way, one list per
+ * profile role. Their ids are counted per service UUID: the client ids start at 1 and
+ * the server ids follow the last client id. The layouts describe the parameters after
+ * the service UUID.
+ *
+ * Layout characters:
+ *  - 'B': uint8_t
+ *  - 'H': uint16_t, little endian
+ *  - 'W': uint32_t, little endian
+ *  - 'A': struct bd_addr, BD_ADDR_LEN bytes
+ *  - 's': rest of the message (length + bytes), only as last field
+ *
+ * Copyright(C) 2015 NXP Semiconductors N.V.
+ * All rights reserved.
+ *
+ * $Rev: $
+ *
+ ****************************************************************************************
+ */
+
+#ifndef _EACI_SCHEMA_H_
+#define _EACI_SCHEMA_H_
+
+/*
+ * SCHEMA
+ ****************************************************************************************
+ */
+
+///EACI Command: name, parameter layout, answering event, how the answer is matched
+///(see EACI_KEY_*)
+#define EACI_CMD_SCHEMA(X)                                                           \
+    /* Advertising: start, interval min, interval max */                             \
+    X(ADV,                 "BHH",    ADV,              ECHO)                         \
+    /* Scan: start */                                                                \
+    X(SCAN,                "B",      INQ_CMP,          NONE)                         \
+    /* Connect: address type, interval min, interval max, timeout, address */        \
+    X(CONN,                "BHHHA",  CONN,             ADDR)                         \
+    /* Central Disconnect: address */                                                \
+    X(DISC,                "A",      DISC,             ADDR)                         \
+    /* Set Device Name: name */                                                      \
+    X(SET_DEVNAME,         "s",      SET_DEVNAME,      NONE)                         \
+    /* Bond: address */                                                              \
+    X(BOND,                "A",      BOND,             ADDR)                         \
+    /* Central Update Param: result, interval min, max, latency, timeout, address */ \
+    X(CEN_UPDATE_PARAM,    "HHHHHA", CEN_UPDATE_PARAM, NONE)                         \
+    /* Peripheral Update Param: interval min, max, latency, timeout */               \
+    X(PER_UPDATE_PARAM,    "HHHH",   UPDATE_PARAM,     NONE)                         \
+    /* BLE Heap Statistics */                                                        \
+    X(HEAP_STAT,           "",       HEAP_STAT,        NONE)                         \
+    /* Sleep Profile: reset after reading */                                         \
+    X(SLEEP_STAT,          "B",      SLEEP_STAT,       NONE)                         \
+    /* Handler Profile: reset after reading */                                       \
+    X(TASK_PROF,           "B",      TASK_PROF,        NONE)                         \
+    /* BLE Heap Trace */                                                             \
+    X(HEAP_TRACE,          "",       HEAP_TRACE,       NONE)
+
+///EACI Event: name, parameter layout
+#define EACI_EVT_SCHEMA(X)                                                           \
+    /* Advertising Status: started */                                                \
+    X(ADV,                  "B")                                                     \
+    /* Scan result: address type, address, name */                                   \
+    X(INQ_RESULT,           "BAs")                                                   \
+    /* Scan complete: number of devices */                                           \
+    X(INQ_CMP,              "B")                                                     \
+    /* Connect Status: status, address */                                            \
+    X(CONN,                 "BA")                                                    \
+    /* Disconnect Status: reason, address */                                         \
+    X(DISC,                 "BA")                                                    \
+    /* Device Name: status */                                                        \
+    X(SET_DEVNAME,          "B")                                                     \
+    /* Bond Status: status, bonded, address */                                       \
+    X(BOND,                 "BBA")                                                   \
+    /* Central Update param State: status */                                         \
+    X(CEN_UPDATE_PARAM,     "B")                                                     \
+    /* SMPC Security started indication to host: status */                           \
+    X(SMP_SEC,              "B")                                                     \
+    /* Peripheral Update param: status */                                            \
+    X(UPDATE_PARAM,         "B")                                                     \
+    /* BLE Heap Statistics: size, free, largest, peak, fragmentation */              \
+    X(HEAP_STAT,            "HHHHB")                                                 \
+    /* Sleep Profile row: table, index, count, time in 10ms */                       \
+    X(SLEEP_STAT,           "BBWW")                                                  \
+    /* Handler Profile row: table, task, id, count, max, total */                    \
+    X(TASK_PROF,            "BBHWWW")                                                \
+    /* BLE Heap Trace row: table, id, size, count, total */                          \
+    X(HEAP_TRACE,           "BHHWW")
+
+/**
+*************************************************************************************
+*** Alert Notification Profile
+*************************************************************************************
+*/
+
+///EACI Data Request - ANPC: name, parameter layout
+#define EACI_DATA_REQ_ANPC_SCHEMA(X)                                                 \
+    /* Enable Request: address */                                                    \
+    X(REQ_ANPC_ENABLE,               "A")                                            \
+    /* Read CFG: characteristic code, address */                                     \
+    X(REQ_ANPC_RD_CFG,               "BA")                                           \
+    /* Write Characteristic: operation, value, address */                            \
+    X(REQ_ANPC_WR_VAL,               "BHA")
+
+///EACI Data Request - ANPS: name, parameter layout
+#define EACI_DATA_REQ_ANPS_SCHEMA(X)                                                 \
+    /* Update new alert: operation, alert value */                                   \
+    X(REQ_ANPS_NTF_NEW_ALERT,        "Bs")                                           \
+    /* Update unread alert: operation, alert value */                                \
+    X(REQ_ANPS_NTF_UNREAD_ALERT,     "Bs")
+
+///EACI Data Indication - ANPC: name, parameter layout
+#define EACI_DATA_IND_ANPC_SCHEMA(X)                                                 \
+    /* Enable Confirmation: status */                                                \
+    X(IND_ANPC_ENABLE,               "B")                                            \
+    /* Write attribute value Procedure: status */                                    \
+    X(IND_ANPC_WR_STATUS,            "B")                                            \
+    /* New Alert Client Char. Cfg. Descriptor: value */                              \
+    X(IND_ANPC_NEW_ALERT_CFG,        "H")                                            \
+    /* Unread Alert Status Client Char. Cfg. Descriptor: value */                    \
+    X(IND_ANPC_UNREAD_ALERT_CFG,     "H")                                            \
+    /* New Alert: category id, number of new alerts */                               \
+    X(IND_ANPC_NEW_ALERT,            "BB")                                           \
+    /* Unread Alert Status: category id, number of unread alerts */                  \
+    X(IND_ANPC_UNREAD_ALERT_STATUS,  "BB")
+
+///EACI Data Indication - ANPS: name, parameter layout
+#define EACI_DATA_IND_ANPS_SCHEMA(X)                                                 \
+    /* Update New Alert Char. value: status */                                       \
+    X(IND_ANPS_UPD_NEW_ALERT,        "B")                                            \
+    /* Update Unread Alert Status Char. value: status */                             \
+    X(IND_ANPS_UPD_UNREAD_ALERT,     "B")
+
+/**
+*************************************************************************************
+*** Battery Profile
+*************************************************************************************
+*/
+
+///EACI Data Request - BASC: name, parameter layout
+#define EACI_DATA_REQ_BASC_SCHEMA(X)                                                 \
+    /* Enable Request: address */                                                    \
+    X(REQ_BATT_ENABLE,               "A")                                            \
+    /* Read Characteristic Value Request: characteristic code, address */            \
+    X(REQ_BATT_RD_CHAR_VAL,          "BA")                                           \
+    /* Write Battery Level Notification: configuration, address */                   \
+    X(REQ_BATT_CFG_NOTIFY,           "HA")
+
+///EACI Data Request - BASS: name, parameter layout
+#define EACI_DATA_REQ_BASS_SCHEMA(X)                                                 \
+    /* Send the battery level update: instance, level, address */                    \
+    X(REQ_BASS_BATT_LEVEL_UPD,       "BBA")
+
+///EACI Data Indication - BASC: name, parameter layout
+#define EACI_DATA_IND_BASC_SCHEMA(X)                                                 \
+    /* Enable Confirmation: status */                                                \
+    X(IND_BATT_ENABLE,               "B")                                            \
+    /* Battery Level: level */                                                       \
+    X(IND_BATT_LEVEL,                "B")                                            \
+    /* Battery CFG.: notification configuration */                                   \
+    X(IND_BATT_RD_CFG,               "H")                                            \
+    /* Write Char RSP.: status */                                                    \
+    X(IND_BATT_WR_RSP,               "B")
+
+///EACI Data Indication - BASS: name, parameter layout
+#define EACI_DATA_IND_BASS_SCHEMA(X)                                                 \
+    /* Battery level update confirm: status */                                       \
+    X(IND_BASS_BATT_UPD_CFM,         "B")
+
+/**
+*************************************************************************************
+*** Blood Pressure Profile
+*************************************************************************************
+*/
+
+///EACI Data Request - BLPC: name, parameter layout
+#define EACI_DATA_REQ_BLPC_SCHEMA(X)                                                 \
+    /* Enable Request: address */                                                    \
+    X(REQ_BP_ENABLE,                 "A")                                            \
+    /* Read BPS CHAR CODE: characteristic code, address */                           \
+    X(REQ_BP_RD_CHAR_CODE,           "BA")                                           \
+    /* Configuration characteristics: characteristic code, configuration, */         \
+    /*    address */                                                                 \
+    X(REQ_BP_CFG_INDNTF,             "BHA")
+
+///EACI Data Request - BLPS: name, parameter layout
+#define EACI_DATA_REQ_BLPS_SCHEMA(X)                                                 \
+    /* Send Pressure: flags, interm. cuff pressure, measurement */                   \
+    X(REQ_BP_SEND_PRES,              "BBs")
+
+///EACI Data Indication - BLPC: name, parameter layout
+#define EACI_DATA_IND_BLPC_SCHEMA(X)                                                 \
+    /* Enable Confirmation: status */                                                \
+    X(IND_BP_ENABLE,                 "B")                                            \
+    /* Read Char RSP: status, value */                                               \
+    X(IND_BP_RD_RSP,                 "Bs")                                           \
+    /* Write Char RSP: status */                                                     \
+    X(IND_BP_WR_RSP,                 "B")                                            \
+    /* BP Measurement: flags, interm. cuff pressure, measurement */                  \
+    X(IND_BP_MEAS,                   "HBs")
+
+///EACI Data Indication - BLPS: name, parameter layout
+#define EACI_DATA_IND_BLPS_SCHEMA(X)                                                 \
+    /* BLPS CFG.: characteristic code, configuration */                              \
+    X(IND_BPS_CFG,                   "BH")                                           \
+    /* Blood Pressure Measurement value confirm: status */                           \
+    X(IND_BPS_MEAS_SEND_CFM,         "B")
+
+/**
+*************************************************************************************
+*** Cycling Speed and Cadence Profile
+*************************************************************************************
+*/
+
+///EACI Data Request - CSCPC: name, parameter layout
+#define EACI_DATA_REQ_CSCPC_SCHEMA(X)                                                \
+    /* Enable Request: address */                                                    \
+    X(REQ_CSCPC_ENABLE,              "A")                                            \
+    /* Read the value of attribute: read code, address */                            \
+    X(REQ_CSCPC_RD_CODE,             "BA")                                           \
+    /* Configure sending of notification/indication: descriptor code, */             \
+    /*    configuration, address */                                                  \
+    X(REQ_CSCPC_WR_CFG,              "BHA")                                          \
+    /* Send the value of the SC Control Point: op code, value, address */            \
+    X(REQ_CSCPC_SEND_CTNL_PT,        "BWA")
+
+///EACI Data Request - CSCPS: name, parameter layout
+#define EACI_DATA_REQ_CSCPS_SCHEMA(X)                                                \
+    /* Send the CSCP Sensor Measurement value: flags, cumul. crank rev., last */     \
+    /*    crank event time, last wheel event time, wheel rev., address */            \
+    X(REQ_CSCPS_NTF_MEAS,            "BHHHHA")                                       \
+    /* Response for the CSCPS_SC_CTNL_PT_REQ_IND message: op code, value, */         \
+    /*    address */                                                                 \
+    X(REQ_CSCPS_CTNL_PT,             "BWA")
+
+///EACI Data Indication - CSCPC: name, parameter layout
+#define EACI_DATA_IND_CSCPC_SCHEMA(X)                                                \
+    /* Enable Confirmation: status */                                                \
+    X(IND_CSCPC_ENABLE,              "B")                                            \
+    /* Read Request: status */                                                       \
+    X(IND_CSCPC_READ,                "B")                                            \
+    /* Read SC Control Point CFG.: configuration */                                  \
+    X(IND_CSCPC_READ_CTNL_PT_CFG,    "H")                                            \
+    /* Read CSC Measurement CFG.: configuration */                                   \
+    X(IND_CSCPC_READ_MEAS_CFG,       "H")                                            \
+    /* Indicated SC Control Point: request op code, response value, supported */     \
+    /*    locations */                                                               \
+    X(IND_CSCPC_SC_CTNL_PT,          "BBH")                                          \
+    /* Notify CSC meas: flags, cumul. crank rev., last crank event time, last */     \
+    /*    wheel event time, cumul. wheel rev. */                                     \
+    X(IND_CSCPC_NTF_MEAS,            "BHHHW")                                        \
+    /* Wait CFG. Response: status */                                                 \
+    X(IND_CSCPC_WR_CFG_STATUS,       "B")                                            \
+    /* Write Response of the SC Control Point Char.: status */                       \
+    X(IND_CSCPC_CFG_WR,              "B")                                            \
+    /* CSC Feature: features */                                                      \
+    X(IND_CSCPC_RD_CSC_FEAT,         "H")                                            \
+    /* Sensor Location: location */                                                  \
+    X(IND_CSCPC_RD_SENSOR_LOC,       "B")
+
+///EACI Data Indication - CSCPS: name, parameter layout
+#define EACI_DATA_IND_CSCPS_SCHEMA(X)                                                \
+    /* Send CSC Measurement Status: status */                                        \
+    X(IND_CSCPS_MEAS,                "B")
+
+/**
+*************************************************************************************
+*** Device Information Service Profile
+*************************************************************************************
+*/
+
+///EACI Data Request - DISC: name, parameter layout
+#define EACI_DATA_REQ_DISC_SCHEMA(X)                                                 \
+    /* Enable Request: address */                                                    \
+    X(REQ_DISC_ENABLE,               "A")                                            \
+    /* read char: characteristic code, address */                                    \
+    X(REQ_DISC_CHAR_RD,              "BA")
+
+///EACI Data Request - DISS: name, parameter layout
+#define EACI_DATA_REQ_DISS_SCHEMA(X)                                                 \
+    /* write char: characteristic code, value */                                     \
+    X(REQ_DISS_CHAR_WR,              "Bs")
+
+///EACI Data Indication - DISC: name, parameter layout
+#define EACI_DATA_IND_DISC_SCHEMA(X)                                                 \
+    /* Enable Confirmation: status */                                                \
+    X(IND_DISC_ENABLE,               "B")                                            \
+    /* read char: status, value */                                                   \
+    X(IND_DISC_CHAR_RD,              "Bs")
+
+/**
+*************************************************************************************
+*** Find Me Profile
+*************************************************************************************
+*/
+
+///EACI Data Request - FINDL: name, parameter layout
+#define EACI_DATA_REQ_FINDL_SCHEMA(X)                                                \
+    /* Enable Request: address */                                                    \
+    X(REQ_FM_ENABLE,                 "A")                                            \
+    /* Write Alert Level: alert level, address */                                    \
+    X(REQ_FM_WR_ALERT,               "BA")
+
+///EACI Data Indication - FINDL: name, parameter layout
+#define EACI_DATA_IND_FINDL_SCHEMA(X)                                                \
+    /* Enable Confirmation: status */                                                \
+    X(IND_FM_ENABLE,                 "B")
+
+///EACI Data Indication - FINDT: name, parameter layout
+#define EACI_DATA_IND_FINDT_SCHEMA(X)                                                \
+    /* Alert Level: alert level */                                                   \
+    X(IND_ALERT_LEV,                 "B")
+
+/**
+*************************************************************************************
+*** Glucose Profile
+*************************************************************************************
+*/
+
+///EACI Data Request - GLPC: name, parameter layout
+#define EACI_DATA_REQ_GLPC_SCHEMA(X)                                                 \
+    /* Enable Request: address */                                                    \
+    X(REQ_GL_ENABLE,                 "A")                                            \
+    /* Register: measurement context enable, address */                              \
+    X(REQ_GL_REGISTER,               "BA")                                           \
+    /* Read Features: address */                                                     \
+    X(REQ_GL_FEATURES_RD,            "A")                                            \
+    /* Report Stored Records: operator, min, max sequence number, address */         \
+    X(REQ_GL_RSR_RACP,               "BHHA")                                         \
+    /* Delete Stored Records: operator, min, max sequence number, address */         \
+    X(REQ_GL_DSR_RACP,               "BHHA")                                         \
+    /* Abort Operation: operator, min, max sequence number, address */               \
+    X(REQ_GL_AO_RACP,                "BHHA")                                         \
+    /* Report Number of Stored Records: operator, min, max sequence number, */       \
+    /*    address */                                                                 \
+    X(REQ_GL_RN_RACP,                "BHHA")
+
+///EACI Data Request - GLPS: name, parameter layout
+#define EACI_DATA_REQ_GLPS_SCHEMA(X)                                                 \
+    /* Send Glucose measurement without context: flags, sequence number, year, */    \
+    /*    month, day, hour, min, sec, optional fields */                             \
+    X(REQ_GL_SEND_MEAS_WITHOUT_CTX,  "BHHBBBBBs")                                    \
+    /* Send Glucose measurement with context: flags, sequence number, year, */       \
+    /*    month, day, hour, min, sec, optional fields */                             \
+    X(REQ_GL_SEND_MEAS_WITH_CTX,     "BHHBBBBBs")
+
+///EACI Data Indication - GLPC: name, parameter layout
+#define EACI_DATA_IND_GLPC_SCHEMA(X)                                                 \
+    /* Enable Confirmation: status */                                                \
+    X(IND_GL_ENABLE,                 "B")                                            \
+    /* Register: status */                                                           \
+    X(IND_GL_REGISTER,               "B")                                            \
+    /* Features: status, features */                                                 \
+    X(IND_GL_FEATURES_RD,            "BH")                                           \
+    /* Glucose measurement value: flags, sequence number, year, month, day, */       \
+    /*    hour, min, sec, optional fields */                                         \
+    X(IND_GL_MEAS,                   "BHHBBBBBs")                                    \
+    /* Glucose measurement value with CTX: flags, sequence number, optional */       \
+    /*    fields */                                                                  \
+    X(IND_GL_MEAS_CTX,               "BHs")                                          \
+    /* GLPC RACP response OP code: op code, operand */                               \
+    X(IND_GL_RACP_RSP,               "BH")
+
+///EACI Data Indication - GLPS: name, parameter layout
+#define EACI_DATA_IND_GLPS_SCHEMA(X)                                                 \
+    /* cfg. message: event configuration */                                          \
+    X(IND_GLS_CFG,                   "B")
+
+/**
+*************************************************************************************
+*** Heart Rate Profile
+*************************************************************************************
+*/
+
+///EACI Data Request - HRPC: name, parameter layout
+#define EACI_DATA_REQ_HRPC_SCHEMA(X)                                                 \
+    /* Enable Request: address */                                                    \
+    X(REQ_HRPC_ENABLE,               "A")                                            \
+    /* Read Body Sensor Location: address */                                         \
+    X(READ_HRPC_BODY_SENSOR,         "A")                                            \
+    /* Configure Heart Rate Measurement: configuration, address */                   \
+    X(READ_HRPC_CFG_INDNTF,          "HA")
+
+///EACI Data Request - HRPS: name, parameter layout
+#define EACI_DATA_REQ_HRPS_SCHEMA(X)                                                 \
+    /* Heart Rate measurement value: heart rate */                                   \
+    X(REQ_HRPS_MEAS_VALUE,           "H")
+
+///EACI Data Indication - HRPC: name, parameter layout
+#define EACI_DATA_IND_HRPC_SCHEMA(X)                                                 \
+    /* Enable Confirmation: status */                                                \
+    X(IND_HRPC_ENABLE,               "B")                                            \
+    /* Read Body Sensor Location rsp: status, location */                            \
+    X(IND_HRPC_READ_BSL_RSP,         "BB")                                           \
+    /* Write RSP.: status */                                                         \
+    X(IND_HRPC_WR_RSP,               "B")                                            \
+    /* Heart Rate value send to APP: heart rate */                                   \
+    X(IND_HRPC_MEAS,                 "H")
+
+///EACI Data Indication - HRPS: name, parameter layout
+#define EACI_DATA_IND_HRPS_SCHEMA(X)                                                 \
+    /* cfg send to app: configuration */                                             \
+    X(IND_HRPS_CFG,                  "H")
+
+/**
+*************************************************************************************
+*** Health Thermometer Profile
+*************************************************************************************
+*/
+
+///EACI Data Request - HTPC: name, parameter layout
+#define EACI_DATA_REQ_HTPC_SCHEMA(X)                                                 \
+    /* Enable Request: address */                                                    \
+    X(REQ_HT_ENABLE,                 "A")                                            \
+    /* CFG. Temperature Measurement: configuration, address */                       \
+    X(REQ_HT_TEMP_MEAS,              "HA")                                           \
+    /* CFG. Intermediate Temperature: configuration, address */                      \
+    X(REQ_HT_INTM_TEMP,              "HA")                                           \
+    /* CFG. Measurement Interval: configuration, address */                          \
+    X(REQ_HT_MEAS_INTV,              "HA")                                           \
+    /* read measurement interval: address */                                         \
+    X(REQ_HT_RD_MEAS_INTV,           "A")
+
+///EACI Data Request - HTPT: name, parameter layout
+#define EACI_DATA_REQ_HTPT_SCHEMA(X)                                                 \
+    /* Send Measurement Interval value: interval */                                  \
+    X(REQ_HT_SEND_INTER_VALUE,       "H")                                            \
+    /* Send Temperature Measurement value: stable, flags, type, temperature, */      \
+    /*    year, month, day, hour, min, sec */                                        \
+    X(REQ_HT_SEND_TEMP_VALUE,        "BBBWHBBBBB")
+
+///EACI Data Indication - HTPC: name, parameter layout
+#define EACI_DATA_IND_HTPC_SCHEMA(X)                                                 \
+    /* Enable Confirmation: status */                                                \
+    X(IND_HT_ENABLE,                 "B")                                            \
+    /* Read Char rsp: status, value */                                               \
+    X(IND_HT_RD_CHAR_RSP,            "BH")                                           \
+    /* Write Status: status */                                                       \
+    X(IND_HT_WR_RSP,                 "B")                                            \
+    /* Temperature Measurement: stable, unit, temperature */                         \
+    X(IND_HT_TEM_MEA,                "BBW")                                          \
+    /* Measurement Interval: interval */                                             \
+    X(IND_HT_MEAS_INTE,              "H")
+
+///EACI Data Indication - HTPT: name, parameter layout
+#define EACI_DATA_IND_HTPT_SCHEMA(X)                                                 \
+    /* Thermom Measurement Interval: interval */                                     \
+    X(IND_HT_TH_TEM_MEA,             "H")                                            \
+    /* Thermom cfg indication: configuration */                                      \
+    X(IND_HT_TH_CFG_IND,             "H")
+
+/**
+*************************************************************************************
+*** Phone Alert Status Profile
+*************************************************************************************
+*/
+
+///EACI Data Request - PASPC: name, parameter layout
+#define EACI_DATA_REQ_PASPC_SCHEMA(X)                                                \
+    /* Enable Request: address */                                                    \
+    X(REQ_PASPC_ENABLE,              "A")                                            \
+    /* Read Request: read code, address */                                           \
+    X(REQ_PASPC_RD,                  "BA")                                           \
+    /* Write Code: write code, value, address */                                     \
+    X(REQ_PASPC_WR,                  "BHA")
+
+///EACI Data Request - PASPS: name, parameter layout
+#define EACI_DATA_REQ_PASPS_SCHEMA(X)                                                \
+    /* Update the value of the Alert Status or the Ringer Setting: operation, */     \
+    /*    value, address */                                                          \
+    X(REQ_PASPS_UPDATE_VAL,          "BBA")
+
+///EACI Data Indication - PASPC: name, parameter layout
+#define EACI_DATA_IND_PASPC_SCHEMA(X)                                                \
+    /* Enable Confirmation: status */                                                \
+    X(IND_PASPC_ENABLE,              "B")                                            \
+    /* Read attribute value Procedure: status */                                     \
+    X(IND_PASPC_READ,                "B")                                            \
+    /* Write attribute value Procedure: status */                                    \
+    X(IND_PASPC_WRITE,               "B")                                            \
+    /* PAS Alert Status: alert status */                                             \
+    X(IND_PASPC_ALERT_STATUS,        "B")                                            \
+    /* PAS Ringer Setting: ringer setting */                                         \
+    X(IND_PASPC_RINGER_SETTING,      "H")                                            \
+    /* PAS Alert Status Client Char. Cfg. Descriptor: value */                       \
+    X(IND_PASPC_ALERT_STATUS_CFG,    "H")                                            \
+    /* PAS Ringer Setting Client Char. Cfg. Descriptor: value */                     \
+    X(IND_PASPC_RINGER_SETTING_CFG,  "H")
+
+///EACI Data Indication - PASPS: name, parameter layout
+#define EACI_DATA_IND_PASPS_SCHEMA(X)                                                \
+    /* Update Alert Status Char. value: status */                                    \
+    X(IND_PASPC_UPD_ALERT_STATUS,    "B")                                            \
+    /* Update Ringer Setting Char. value: status */                                  \
+    X(IND_PASPC_UPD_RINGER_SETTING,  "B")
+
+/**
+*************************************************************************************
+*** Proximity Profile
+*************************************************************************************
+*/
+
+///EACI Data Request - PROXM: name, parameter layout
+#define EACI_DATA_REQ_PROXM_SCHEMA(X)                                                \
+    /* Enable Request: address */                                                    \
+    X(REQ_PROXM_ENABLE,              "A")                                            \
+    /* Read TX Power: address */                                                     \
+    X(READ_PROXM_TX_POWER,           "A")                                            \
+    /* Write IAS data: alert level, address */                                       \
+    X(WRITE_PROXM_IAS,               "BA")                                           \
+    /* Write LLS data: alert level, address */                                       \
+    X(WRITE_PROXM_LLS,               "BA")
+
+///EACI Data Indication - PROXM: name, parameter layout
+#define EACI_DATA_IND_PROXM_SCHEMA(X)                                                \
+    /* Enable Confirmation: status */                                                \
+    X(IND_PROXM_ENABLE,              "B")                                            \
+    /* tx power lv: level */                                                         \
+    X(IND_PROXM_TX_POWER,            "B")
+
+///EACI Data Indication - PROXR: name, parameter layout
+#define EACI_DATA_IND_PROXR_SCHEMA(X)                                                \
+    /* Alert Level: alert level */                                                   \
+    X(IND_PROXR_ALERT,               "B")                                            \
+    /* Link Lost: alert level */                                                     \
+    X(IND_PROXR_LINK_LOST,           "B")
+
+/**
+*************************************************************************************
+*** Running Speed and Cadence Profile
+*************************************************************************************
+*/
+
+///EACI Data Request - RSCPC: name, parameter layout
+#define EACI_DATA_REQ_RSCPC_SCHEMA(X)                                                \
+    /* Enable Request: address */                                                    \
+    X(REQ_RSCPC_ENABLE,              "A")                                            \
+    /* Read Request: read code, address */                                           \
+    X(REQ_RSCPC_RD,                  "BA")                                           \
+    /* Configure sending of notification/indication: descriptor code, */             \
+    /*    configuration, address */                                                  \
+    X(REQ_RSCPC_CFG_NTFIND,          "BHA")                                          \
+    /* Send the value of the SC Control Point: op code, value, address */            \
+    X(REQ_RSCPC_CFG_CTNL_PT,         "BWA")
+
+///EACI Data Request - RSCPS: name, parameter layout
+#define EACI_DATA_REQ_RSCPS_SCHEMA(X)                                                \
+    /* Send the RSC Sensor Measurement value: flags, cadence, speed, stride */       \
+    /*    length, total distance, address */                                         \
+    X(REQ_RSCPS_NTF_MEAS,            "BBHHWA")                                       \
+    /* Response for the RSCPS_SC_CTNL_PT_REQ_IND message: op code, value, */         \
+    /*    address */                                                                 \
+    X(REQ_RSCPS_CTNL_PT,             "BHA")
+
+///EACI Data Indication - RSCPC: name, parameter layout
+#define EACI_DATA_IND_RSCPC_SCHEMA(X)                                                \
+    /* Enable Confirmation: status */                                                \
+    X(IND_RSCPC_ENABLE,              "B")                                            \
+    /* Read attribute value Procedure: status */                                     \
+    X(IND_RSCPC_READ,                "B")                                            \
+    /* Write Response of a Client Char. Cfg. Descriptor: status */                   \
+    X(IND_RSCPC_CFG_NTF_IND,         "B")                                            \
+    /* Write Response of the SC Control Point Char.: status */                       \
+    X(IND_RSCPC_CTNL_PT_CFG_WR,      "B")                                            \
+    /* Indication Response of the SC Control Point Char.: status */                  \
+    X(IND_RSCPC_CTNL_PT_CFG_IND,     "B")                                            \
+    /* Notified RSC Measurement: flags, cadence, speed, stride length, total */      \
+    /*    distance */                                                                \
+    X(IND_RSCPC_NTF_MEAS,            "BBHHW")                                        \
+    /* RSC Feature: features */                                                      \
+    X(IND_RSCPC_RSC_FEAT,            "H")                                            \
+    /* Sensor Location: location */                                                  \
+    X(IND_RSCPC_SENSOR_LOC,          "B")                                            \
+    /* Indicated SC Control Point: request op code, response value, supported */     \
+    /*    locations */                                                               \
+    X(IND_RSCPC_CTNL_PT,             "BBH")                                          \
+    /* RSC Measurement cfg.: configuration */                                        \
+    X(IND_RSCPC_RSC_MEAS_CFG,        "H")                                            \
+    /* SC Control Point cfg.: configuration */                                       \
+    X(IND_RSCPC_RSC_PT_CFG,          "H")
+
+///EACI Data Indication - RSCPS: name, parameter layout
+#define EACI_DATA_IND_RSCPS_SCHEMA(X)                                                \
+    /* RSC Measurement: status */                                                    \
+    X(IND_PASPS_SEND_MEAS,           "B")                                            \
+    /* Set Cumulative Value: status */                                               \
+    X(IND_PASPS_CTNL_CUMUL,          "B")                                            \
+    /* Update Sensor Location: status */                                             \
+    X(IND_PASPS_CTNL_UPD_LOC,        "B")                                            \
+    /* Supported Sensor Locations: status */                                         \
+    X(IND_PASPS_CTNL_SUPP_LOC,       "B")
+
+/**
+*************************************************************************************
+*** Scan Parameters Profile
+*************************************************************************************
+*/
+
+///EACI Data Request - SCPPC: name, parameter layout
+#define EACI_DATA_REQ_SCPPC_SCHEMA(X)                                                \
+    /* Enable Request: address */                                                    \
+    X(REQ_SP_ENABLE,                 "A")                                            \
+    /* Read Scan Refresh Cfg: address */                                             \
+    X(REQ_SP_RD_CFG,                 "A")                                            \
+    /* Send Scan Interval and Win: interval, window, address */                      \
+    X(REQ_SP_WR_WD,                  "HHA")                                          \
+    /* Configure Scan Refresh: configuration, address */                             \
+    X(REQ_SP_WR_MEAS,                "HA")
+
+///EACI Data Request - SCPPS: name, parameter layout
+#define EACI_DATA_REQ_SCPPS_SCHEMA(X)                                                \
+    /* Send the scan refresh value */                                                \
+    X(REQ_SP_SCAN_REFRESH_REQ,       "")
+
+///EACI Data Indication - SCPPC: name, parameter layout
+#define EACI_DATA_IND_SCPPC_SCHEMA(X)                                                \
+    /* Enable Confirmation: status */                                                \
+    X(IND_SP_ENABLE,                 "B")                                            \
+    /* Write Status: status */                                                       \
+    X(IND_SP_WR_RSP,                 "B")                                            \
+    /* Scan Refresh Cfg.: configuration */                                           \
+    X(IND_SP_RD_CFG,                 "H")
+
+///EACI Data Indication - SCPPS: name, parameter layout
+#define EACI_DATA_IND_SCPPS_SCHEMA(X)                                                \
+    /* Scan Interval and Win: interval, window */                                    \
+    X(IND_SP_INTV_WD,                "HH")                                           \
+    /* Configure Scan Refresh: configuration */                                      \
+    X(IND_SP_REFRESH_NTF_CFG,        "H")
+
+/**
+*************************************************************************************
+*** Time Profile
+*************************************************************************************
+*/
+
+///EACI Data Request - TIPC: name, parameter layout
+#define EACI_DATA_REQ_TIPC_SCHEMA(X)                                                 \
+    /* Enable Request: address */                                                    \
+    X(REQ_TIP_ENABLE,                "A")                                            \
+    /* Read a CTS or NDCS or RTUS characteristic: characteristic code, address */    \
+    X(REQ_TIP_CHAR_VAL_RD,           "BA")                                           \
+    /* Configuring the Current Time Characteristic: configuration, address */        \
+    X(REQ_TIP_CT_NTF_CFG,            "HA")                                           \
+    /* Writing Time Control Point: value, address */                                 \
+    X(REQ_TIP_WR_UDP_CTNL_PT,        "BA")
+
+///EACI Data Request - TIPS: name, parameter layout
+#define EACI_DATA_REQ_TIPS_SCHEMA(X)                                                 \
+    /* update current time: year, month, day, hour, min, sec, day of week */         \
+    X(TIPS_UPD_CURR_TIME,            "HBBBBBB")
+
+///EACI Data Indication - TIPC: name, parameter layout
+#define EACI_DATA_IND_TIPC_SCHEMA(X)                                                 \
+    /* Enable Confirmation: status */                                                \
+    X(IND_TIP_ENABLE,                "B")                                            \
+    /* Write Status: status */                                                       \
+    X(IND_TIP_WR_RSP,                "B")                                            \
+    /* Current Time value: year, month, day, hour, min, sec, day of week */          \
+    X(IND_TIP_CT,                    "HBBBBBB")                                      \
+    /* Read Current Time Notification Configuration: configuration */                \
+    X(IND_TIP_NTF_CFG_RD,            "H")                                            \
+    /* Local Time Info: time zone, DST offset */                                     \
+    X(IND_TIP_LTI_RD,                "BB")                                           \
+    /* Reference Time Info: source, accuracy, days, hours since update */            \
+    X(IND_TIP_RTI_RD,                "BBBB")                                         \
+    /* Time With DST: DST offset */                                                  \
+    X(IND_TIP_TDST_RD,               "B")                                            \
+    /* Time Update State: current state, result */                                   \
+    X(IND_TIP_TUS_RD,                "BB")
+
+///EACI Data Indication - TIPS: name, parameter layout
+#define EACI_DATA_IND_TIPS_SCHEMA(X)                                                 \
+    /* Current time CCC Cfg.: configuration */                                       \
+    X(IND_TIP_CURRENT_CCC,           "H")                                            \
+    /* Time Update Control Point value: value */                                     \
+    X(IND_TIP_UPD_CTNL_PT,           "B")
+
+/*
+ * TYPE DEFINITIONS
+ ****************************************************************************************
+ */
+
+#define EACI_SCHEMA_CMD_ID(name, layout, evt, key)  EACI_MSG_CMD_##name,
+#define EACI_SCHEMA_EVT_ID(name, layout)            EACI_MSG_EVT_##name,
+#define EACI_SCHEMA_DATA_ID(name, layout)           EACI_MSG_DATA_##name,
+
+///EACI Command
+enum
+{
+    ///Reserved
+    EACI_MSG_CMD_RSV = 0x0,
+    EACI_CMD_SCHEMA(EACI_SCHEMA_CMD_ID)
+    ///Number of Command
+    EACI_MSG_CMD_MAX
+};
+
+///EACI Event
+enum
+{
+    ///Reserved
+    EACI_MSG_EVT_RSV = 0x0,
+    EACI_EVT_SCHEMA(EACI_SCHEMA_EVT_ID)
+    ///Number of Event
+    EACI_MSG_EVT_MAX
+};
+
+///How the event answering a command is told apart from the same event sent unsolicited
+enum
+{
+    ///Event id only, the event is only sent as an answer
+    EACI_KEY_NONE = 0,
+    ///The BD address of the command is the one of the event, EACI names a link by its peer
+    ///address: a connection, disconnection or bond of another peer is not the answer
+    EACI_KEY_ADDR,
+    ///The first parameter byte of the command is the first one of the event
+    EACI_KEY_ECHO,
+};
+
+///Tables of the Sleep Profile rows
+enum
+{
+    ///Power mode, index PM_ACTIVE to PM_DEEP_SLEEP
+    EACI_SLEEP_STAT_PM = 0,
+    ///Reason blocking deep sleep, index in enum SLEEP_BLOCK
+    EACI_SLEEP_STAT_BLOCK,
+    ///Wakeup source, index is the interrupt number, time unused
+    EACI_SLEEP_STAT_WAKEUP,
+    ///Devices seen blocking, count is the PM_MASK bit field
+    EACI_SLEEP_STAT_DEV,
+};
+
+///Tables of the Handler Profile rows, max and total are in processor cycles
+enum
+{
+    ///ke_schedule() passes, task and id unused
+    EACI_TASK_PROF_SCHED = 0,
+    ///Event callback, id is the event
+    EACI_TASK_PROF_EVT,
+    ///Message handler, task is the receiver type and id the message, task 0xFF counts
+    ///the calls of the handlers beyond the profile
+    EACI_TASK_PROF_MSG,
+    ///Kernel message queue depth, id 0 for sent and 1 for saved, count is the samples
+    EACI_TASK_PROF_QUEUE,
+};
+
+///Tables of the Heap Trace rows, all sizes in bytes
+enum
+{
+    ///Application blocks: id is the bytes held now, size the most held, count the
+    ///allocations and total the frees
+    EACI_HEAP_TRACE_APP = 0,
+    ///Sizing: id is the advised heap size, size the largest request, count the failed
+    ///allocations and total 1 if the heap has been full
+    EACI_HEAP_TRACE_ADVICE,
+    ///Allocations of a message, id 0xFFFF for ke_malloc(): size is the largest, count the
+    ///allocations and total their bytes
+    EACI_HEAP_TRACE_MSG,
+    ///Block held by the application: id is the message, count the caller address and
+    ///total the scheduler runs since it was allocated
+    EACI_HEAP_TRACE_BLK,
+    ///Beyond the trace: count the allocations of other messages, total the blocks not held
+    EACI_HEAP_TRACE_LOST,
+};
+
+///EACI Data Request - Alert Notification Profile
+enum
+{
+    ///Reserved
+    EACI_MSG_DATA_REQ_ANPC_RSV = 0x0,
+    EACI_DATA_REQ_ANPC_SCHEMA(EACI_SCHEMA_DATA_ID)
+    ///Number of Data Request of ANPC
+    EACI_MSG_DATA_REQ_ANPC_MAX,
+    ///Data Requests of ANPS follow
+    EACI_MSG_DATA_REQ_ANPS_BASE = EACI_MSG_DATA_REQ_ANPC_MAX - 1,
+    EACI_DATA_REQ_ANPS_SCHEMA(EACI_SCHEMA_DATA_ID)
+};
+
+///EACI Data Indication - Alert Notification Profile
+enum
+{
+    ///Reserved
+    EACI_MSG_DATA_IND_ANPC_RSV = 0x0,
+    EACI_DATA_IND_ANPC_SCHEMA(EACI_SCHEMA_DATA_ID)
+    ///Number of Data Indication of AN
+    EACI_MSG_DATA_IND_ANPC_MAX,
+    ///Data Indications of ANPS follow
+    EACI_MSG_DATA_IND_ANPS_BASE = EACI_MSG_DATA_IND_ANPC_MAX - 1,
+    EACI_DATA_IND_ANPS_SCHEMA(EACI_SCHEMA_DATA_ID)
+};
+
+///EACI Data Request - Battery Profile
+enum
+{
+    ///Reserved
+    EACI_MSG_DATA_REQ_BATT_RSV = 0x0,
+    EACI_DATA_REQ_BASC_SCHEMA(EACI_SCHEMA_DATA_ID)
+    ///Number of Data Request of BATT
+    EACI_MSG_DATA_REQ_BATT_MAX,
+    ///Data Requests of BASS follow
+    EACI_MSG_DATA_REQ_BASS_BASE = EACI_MSG_DATA_REQ_BATT_MAX - 1,
+    EACI_DATA_REQ_BASS_SCHEMA(EACI_SCHEMA_DATA_ID)
+};
+
+///EACI Data Indication - Battery Profile
+enum
+{
+    ///Reserved
+    EACI_MSG_DATA_IND_BATT_RSV = 0x0,
+    EACI_DATA_IND_BASC_SCHEMA(EACI_SCHEMA_DATA_ID)
+    ///Number of Data Indication of BATT
+    EACI_MSG_DATA_IND_BATT_MAX,
+    ///Data Indications of BASS follow
+    EACI_MSG_DATA_IND_BASS_BASE = EACI_MSG_DATA_IND_BATT_MAX - 1,
+    EACI_DATA_IND_BASS_SCHEMA(EACI_SCHEMA_DATA_ID)
+};
+
+///EACI Data Request - Blood Pressure Profile
+enum
+{
+    ///Reserved
+    EACI_MSG_DATA_REQ_BP_RSV = 0x0,
+    EACI_DATA_REQ_BLPC_SCHEMA(EACI_SCHEMA_DATA_ID)
+    ///Number of Data Request of BP
+    EACI_MSG_DATA_REQ_BP_MAX,
+    ///Data Requests of BLPS follow
+    EACI_MSG_DATA_REQ_BLPS_BASE = EACI_MSG_DATA_REQ_BP_MAX - 1,
+    EACI_DATA_REQ_BLPS_SCHEMA(EACI_SCHEMA_DATA_ID)
+};
+
+///EACI Data Indication - Blood Pressure Profile
+enum
+{
+    ///Reserved
+    EACI_MSG_DATA_IND_BP_RSV = 0x0,
+    EACI_DATA_IND_BLPC_SCHEMA(EACI_SCHEMA_DATA_ID)
+    ///Number of Data Indication of BP
+    EACI_MSG_DATA_IND_BP_MAX,
+    ///Data Indications of BLPS follow
+    EACI_MSG_DATA_IND_BLPS_BASE = EACI_MSG_DATA_IND_BP_MAX - 1,
+    EACI_DATA_IND_BLPS_SCHEMA(EACI_SCHEMA_DATA_ID)
+};
+
+///EACI Data Request - Cycling Speed and Cadence Profile
+enum
+{
+    ///Reserved
+    EACI_MSG_DATA_REQ_CSCPC_RSV = 0x0,
+    EACI_DATA_REQ_CSCPC_SCHEMA(EACI_SCHEMA_DATA_ID)
+    ///Number of Data Request of CSCPC
+    EACI_MSG_DATA_REQ_CSCPC_MAX,
+    ///Data Requests of CSCPS follow
+    EACI_MSG_DATA_REQ_CSCPS_BASE = EACI_MSG_DATA_REQ_CSCPC_MAX - 1,
+    EACI_DATA_REQ_CSCPS_SCHEMA(EACI_SCHEMA_DATA_ID)
+};
+
+///EACI Data Indication - Cycling Speed and Cadence Profile
+enum
+{
+    ///Reserved
+    EACI_MSG_DATA_IND_CSCPC_RSV = 0x0,
+    EACI_DATA_IND_CSCPC_SCHEMA(EACI_SCHEMA_DATA_ID)
+    ///Number of Data Indication of CSC
+    EACI_MSG_DATA_IND_CSCPC_MAX,
+    ///Data Indications of CSCPS follow
+    EACI_MSG_DATA_IND_CSCPS_BASE = EACI_MSG_DATA_IND_CSCPC_MAX - 1,
+    EACI_DATA_IND_CSCPS_SCHEMA(EACI_SCHEMA_DATA_ID)
+};
+
+///EACI Data Request - Device Information Service Profile
+enum
+{
+    ///Reserved
+    EACI_MSG_DATA_REQ_DISC_RSV = 0x0,
+    EACI_DATA_REQ_DISC_SCHEMA(EACI_SCHEMA_DATA_ID)
+    ///Number of Data Request of DISC
+    EACI_MSG_DATA_REQ_DISC_MAX,
+    ///Data Requests of DISS follow
+    EACI_MSG_DATA_REQ_DISS_BASE = EACI_MSG_DATA_REQ_DISC_MAX - 1,
+    EACI_DATA_REQ_DISS_SCHEMA(EACI_SCHEMA_DATA_ID)
+};
+
+///EACI Data Indication - Device Information Service Profile
+enum
+{
+    ///Reserved
+    EACI_MSG_DATA_IND_DISC_RSV = 0x0,
+    EACI_DATA_IND_DISC_SCHEMA(EACI_SCHEMA_DATA_ID)
+    ///Number of Data Indication of DISC
+    EACI_MSG_DATA_IND_DISC_MAX,
+};
+
+///EACI Data Request - Find Me Profile
+enum
+{
+    ///Reserved
+    EACI_MSG_DATA_REQ_FM_RSV = 0x0,
+    EACI_DATA_REQ_FINDL_SCHEMA(EACI_SCHEMA_DATA_ID)
+    ///Number of Data Request of FM
+    EACI_MSG_DATA_REQ_FM_MAX,
+};
+
+///EACI Data Indication - Find Me Profile
+enum
+{
+    ///Reserved
+    EACI_MSG_DATA_IND_FM_RSV = 0x0,
+    EACI_DATA_IND_FINDL_SCHEMA(EACI_SCHEMA_DATA_ID)
+    ///Number of Data Indication of FM
+    EACI_MSG_DATA_IND_FM_MAX,
+    ///Data Indications of FINDT follow
+    EACI_MSG_DATA_IND_FINDT_BASE = EACI_MSG_DATA_IND_FM_MAX - 1,
+    EACI_DATA_IND_FINDT_SCHEMA(EACI_SCHEMA_DATA_ID)
+};
+
+///EACI Data Request - Glucose Profile
+enum
+{
+    ///Reserved
+    EACI_MSG_DATA_REQ_GL_RSV = 0x0,
+    EACI_DATA_REQ_GLPC_SCHEMA(EACI_SCHEMA_DATA_ID)
+    ///Number of Data Request of GL
+    EACI_MSG_DATA_REQ_GL_MAX,
+    ///Data Requests of GLPS follow
+    EACI_MSG_DATA_REQ_GLPS_BASE = EACI_MSG_DATA_REQ_GL_MAX - 1,
+    EACI_DATA_REQ_GLPS_SCHEMA(EACI_SCHEMA_DATA_ID)
+};
+
+///EACI Data Indication - Glucose Profile
+enum
+{
+    ///Reserved
+    EACI_MSG_DATA_IND_GL_RSV = 0x0,
+    EACI_DATA_IND_GLPC_SCHEMA(EACI_SCHEMA_DATA_ID)
+    ///Number of Data Indication of GL
+    EACI_MSG_DATA_IND_GL_MAX,
+    ///Data Indications of GLPS follow
+    EACI_MSG_DATA_IND_GLPS_BASE = EACI_MSG_DATA_IND_GL_MAX - 1,
+    EACI_DATA_IND_GLPS_SCHEMA(EACI_SCHEMA_DATA_ID)
+};
+
+///EACI Data Request - Heart Rate Profile
+enum
+{
+    ///Reserved
+    EACI_MSG_DATA_REQ_HRP_RSV = 0x0,
+    EACI_DATA_REQ_HRPC_SCHEMA(EACI_SCHEMA_DATA_ID)
+    ///Number of Data Request of HRPC
+    EACI_MSG_DATA_REQ_HRPC_MAX,
+    ///Data Requests of HRPS follow
+    EACI_MSG_DATA_REQ_HRPS_BASE = EACI_MSG_DATA_REQ_HRPC_MAX - 1,
+    EACI_DATA_REQ_HRPS_SCHEMA(EACI_SCHEMA_DATA_ID)
+};
+
+///EACI Data Indication - Heart Rate Profile
+enum
+{
+    ///Reserved
+    EACI_MSG_DATA_IND_HRP_RSV = 0x0,
+    EACI_DATA_IND_HRPC_SCHEMA(EACI_SCHEMA_DATA_ID)
+    ///Number of Data Indication of HRPC
+    EACI_MSG_DATA_IND_HRPC_MAX,
+    ///Data Indications of HRPS follow
+    EACI_MSG_DATA_IND_HRPS_BASE = EACI_MSG_DATA_IND_HRPC_MAX - 1,
+    EACI_DATA_IND_HRPS_SCHEMA(EACI_SCHEMA_DATA_ID)
+};
+
+///EACI Data Request - Health Thermometer Profile
+enum
+{
+    ///Reserved
+    EACI_MSG_DATA_REQ_HT_RSV = 0x0,
+    EACI_DATA_REQ_HTPC_SCHEMA(EACI_SCHEMA_DATA_ID)
+    ///Number of Data Request of HT
+    EACI_MSG_DATA_REQ_HT_MAX,
+    ///Data Requests of HTPT follow
+    EACI_MSG_DATA_REQ_HTPT_BASE = EACI_MSG_DATA_REQ_HT_MAX - 1,
+    EACI_DATA_REQ_HTPT_SCHEMA(EACI_SCHEMA_DATA_ID)
+};
+
+///EACI Data Indication - Health Thermometer Profile
+enum
+{
+    ///Reserved
+    EACI_MSG_DATA_IND_HT_RSV = 0x0,
+    EACI_DATA_IND_HTPC_SCHEMA(EACI_SCHEMA_DATA_ID)
+    ///Number of Data Indication of HT
+    EACI_MSG_DATA_IND_HT_MAX,
+    ///Data Indications of HTPT follow
+    EACI_MSG_DATA_IND_HTPT_BASE = EACI_MSG_DATA_IND_HT_MAX - 1,
+    EACI_DATA_IND_HTPT_SCHEMA(EACI_SCHEMA_DATA_ID)
+};
+
+///EACI Data Request - Phone Alert Status Profile
+enum
+{
+    ///Reserved
+    EACI_MSG_DATA_REQ_PASPC_RSV = 0x0,
+    EACI_DATA_REQ_PASPC_SCHEMA(EACI_SCHEMA_DATA_ID)
+    ///Number of Data Request of PASPC
+    EACI_MSG_DATA_REQ_PASPC_MAX,
+    ///Data Requests of PASPS follow
+    EACI_MSG_DATA_REQ_PASPS_BASE = EACI_MSG_DATA_REQ_PASPC_MAX - 1,
+    EACI_DATA_REQ_PASPS_SCHEMA(EACI_SCHEMA_DATA_ID)
+};
+
+///EACI Data Indication - Phone Alert Status Profile
+enum
+{
+    ///Reserved
+    EACI_MSG_DATA_IND_PASPC_RSV = 0x0,
+    EACI_DATA_IND_PASPC_SCHEMA(EACI_SCHEMA_DATA_ID)
+    ///Number of Data Indication of PAS
+    EACI_MSG_DATA_IND_PASPC_MAX,
+    ///Data Indications of PASPS follow
+    EACI_MSG_DATA_IND_PASPS_BASE = EACI_MSG_DATA_IND_PASPC_MAX - 1,
+    EACI_DATA_IND_PASPS_SCHEMA(EACI_SCHEMA_DATA_ID)
+};
+
+///EACI Data Request - Proximity Profile
+enum
+{
+    ///Reserved
+    EACI_MSG_DATA_REQ_PROX_RSV = 0x0,
+    EACI_DATA_REQ_PROXM_SCHEMA(EACI_SCHEMA_DATA_ID)
+    ///Number of Data Request of PROXM
+    EACI_MSG_DATA_REQ_PROXM_MAX,
+    ///Number of Data Request of PROX
+    EACI_MSG_DATA_REQ_PROX_MAX = EACI_MSG_DATA_REQ_PROXM_MAX
+};
+
+///EACI Data Indication - Proximity Profile
+enum
+{
+    ///Reserved
+    EACI_MSG_DATA_IND_PROX_RSV = 0x0,
+    EACI_DATA_IND_PROXM_SCHEMA(EACI_SCHEMA_DATA_ID)
+    ///Number of Data Indication of PROXM
+    EACI_MSG_DATA_IND_PROM_MAX,
+    ///Data Indications of PROXR follow
+    EACI_MSG_DATA_IND_PROXR_BASE = EACI_MSG_DATA_IND_PROM_MAX - 1,
+    EACI_DATA_IND_PROXR_SCHEMA(EACI_SCHEMA_DATA_ID)
+};
+
+///EACI Data Request - Running Speed and Cadence Profile
+enum
+{
+    ///Reserved
+    EACI_MSG_DATA_REQ_RSCPC_RSV = 0x0,
+    EACI_DATA_REQ_RSCPC_SCHEMA(EACI_SCHEMA_DATA_ID)
+    ///Number of Data Request of RSCPC
+    EACI_MSG_DATA_REQ_RSCPC_MAX,
+    ///Data Requests of RSCPS follow
+    EACI_MSG_DATA_REQ_RSCPS_BASE = EACI_MSG_DATA_REQ_RSCPC_MAX - 1,
+    EACI_DATA_REQ_RSCPS_SCHEMA(EACI_SCHEMA_DATA_ID)
+};
+
+///EACI Data Indication - Running Speed and Cadence Profile
+enum
+{
+    ///Reserved
+    EACI_MSG_DATA_IND_RSCPC_RSV = 0x0,
+    EACI_DATA_IND_RSCPC_SCHEMA(EACI_SCHEMA_DATA_ID)
+    ///Number of Data Indication of RSC
+    EACI_MSG_DATA_IND_RSCPC_MAX,
+    ///Data Indications of RSCPS follow
+    EACI_MSG_DATA_IND_RSCPS_BASE = EACI_MSG_DATA_IND_RSCPC_MAX - 1,
+    EACI_DATA_IND_RSCPS_SCHEMA(EACI_SCHEMA_DATA_ID)
+};
+
+///EACI Data Request - Scan Parameters Profile
+enum
+{
+    ///Reserved
+    EACI_MSG_DATA_REQ_SP_RSV = 0x0,
+    EACI_DATA_REQ_SCPPC_SCHEMA(EACI_SCHEMA_DATA_ID)
+    ///Number of Data Request of SP
+    EACI_MSG_DATA_REQ_SP_MAX,
+    ///Data Requests of SCPPS follow
+    EACI_MSG_DATA_REQ_SCPPS_BASE = EACI_MSG_DATA_REQ_SP_MAX - 1,
+    EACI_DATA_REQ_SCPPS_SCHEMA(EACI_SCHEMA_DATA_ID)
+};
+
+///EACI Data Indication - Scan Parameters Profile
+enum
+{
+    ///Reserved
+    EACI_MSG_DATA_IND_SP_RSV = 0x0,
+    EACI_DATA_IND_SCPPC_SCHEMA(EACI_SCHEMA_DATA_ID)
+    ///Number of Data Indication of SP
+    EACI_MSG_DATA_IND_SP_MAX,
+    ///Data Indications of SCPPS follow
+    EACI_MSG_DATA_IND_SCPPS_BASE = EACI_MSG_DATA_IND_SP_MAX - 1,
+    EACI_DATA_IND_SCPPS_SCHEMA(EACI_SCHEMA_DATA_ID)
+};
+
+///EACI Data Request - Time Profile
+enum
+{
+    ///Reserved
+    EACI_MSG_DATA_REQ_TIP_RSV = 0x0,
+    EACI_DATA_REQ_TIPC_SCHEMA(EACI_SCHEMA_DATA_ID)
+    ///Number of Data Request of TIP
+    EACI_MSG_DATA_REQ_TIP_MAX,
+    ///Data Requests of TIPS follow
+    EACI_MSG_DATA_REQ_TIPS_BASE = EACI_MSG_DATA_REQ_TIP_MAX - 1,
+    EACI_DATA_REQ_TIPS_SCHEMA(EACI_SCHEMA_DATA_ID)
+};
+
+///EACI Data Indication - Time Profile
+enum
+{
+    ///Reserved
+    EACI_MSG_DATA_IND_TIP_RSV = 0x0,
+    EACI_DATA_IND_TIPC_SCHEMA(EACI_SCHEMA_DATA_ID)
+    ///Number of Data Indication of TIP
+    EACI_MSG_DATA_IND_TIP_MAX,
+    ///Data Indications of TIPS follow
+    EACI_MSG_DATA_IND_TIPS_BASE = EACI_MSG_DATA_IND_TIP_MAX - 1,
+    EACI_DATA_IND_TIPS_SCHEMA(EACI_SCHEMA_DATA_ID)
+};
+
+#endif // _EACI_SCHEMA_H_
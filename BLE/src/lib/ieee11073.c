@@ -0,0 +1,274 @@
+/**
+ ****************************************************************************************
+ *
+ * @file ieee11073.c
+ *
+ * @brief IEEE-11073 SFLOAT and FLOAT codec of the health profile measurements.
+ *
+ * Copyright(C) 2015 NXP Semiconductors N.V.
+ * All rights reserved.
+ *
+ * $Rev: $
+ *
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+#include <stdbool.h>
+#include "ieee11073.h"
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// Powers of ten which fit in a uint32_t
+#define IEEE11073_POW10_NB          10
+
+/// Largest mantissa of a number with a zero exponent, the ones above are special values
+#define IEEE11073_SFLOAT_MANT_MAX   0x07FD
+#define IEEE11073_FLOAT_MANT_MAX    0x007FFFFD
+
+/*
+ * TYPE DEFINITIONS
+ ****************************************************************************************
+ */
+
+/// Layout of a format
+struct ieee11073_fmt
+{
+    /// Largest magnitude of the mantissa of a number with a zero exponent
+    uint32_t mant_max;
+    /// Special values returned when the exponent is too large
+    uint32_t pinf;
+    uint32_t ninf;
+    /// Bits of the mantissa and of the exponent
+    uint8_t mant_bits;
+    uint8_t exp_bits;
+};
+
+/*
+ * LOCAL VARIABLES
+ ****************************************************************************************
+ */
+
+static const uint32_t ieee11073_pow10[IEEE11073_POW10_NB] =
+{
+    1UL, 10UL, 100UL, 1000UL, 10000UL, 100000UL, 1000000UL, 10000000UL, 100000000UL, 1000000000UL
+};
+
+/// Special values with a zero exponent, from mantissa 2^(n-1) - 2 to 2^(n-1) + 2
+static const uint8_t ieee11073_special[5] =
+{
+    IEEE11073_VAL_PINF, IEEE11073_VAL_NAN, IEEE11073_VAL_NRES, IEEE11073_VAL_RSVD, IEEE11073_VAL_NINF
+};
+
+static const struct ieee11073_fmt ieee11073_sfloat_fmt =
+{
+    IEEE11073_SFLOAT_MANT_MAX, IEEE11073_SFLOAT_PINF, IEEE11073_SFLOAT_NINF, 12, 4
+};
+
+static const struct ieee11073_fmt ieee11073_float_fmt =
+{
+    IEEE11073_FLOAT_MANT_MAX, IEEE11073_FLOAT_PINF, IEEE11073_FLOAT_NINF, 24, 8
+};
+
+/*
+ * LOCAL FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+/// Largest magnitude of the mantissa of a number with the exponent e
+static uint32_t ieee11073_mant_max(int16_t e, bool neg, struct ieee11073_fmt const *fmt)
+{
+    uint32_t half = 1UL << (fmt->mant_bits - 1);
+
+    // The special values only take mantissas of the zero exponent
+    if (e == 0)
+        return fmt->mant_max;
+
+    return neg ? half : (half - 1);
+}
+
+static uint32_t ieee11073_encode(int32_t val, int8_t exp, struct ieee11073_fmt const *fmt)
+{
+    bool neg = (val < 0);
+    uint32_t mag = neg ? (0UL - (uint32_t)val) : (uint32_t)val;
+    uint32_t limit;
+    int16_t exp_min = -(1 << (fmt->exp_bits - 1));
+    int16_t exp_max = (1 << (fmt->exp_bits - 1)) - 1;
+    int16_t e = exp;
+    uint8_t shift = 0;
+
+    // Fewest digits to drop so that the rounded mantissa fits and the exponent is in range,
+    // round(mag / 10^shift) fits when mag < limit * 10^shift - 10^shift / 2
+    for (; shift < IEEE11073_POW10_NB; shift++)
+    {
+        limit = ieee11073_mant_max(e + shift, neg, fmt) + 1;
+        if ((e + shift >= exp_min)
+            && ((ieee11073_pow10[shift] > 0xFFFFFFFFUL / limit)
+             || (mag < limit * ieee11073_pow10[shift] - ieee11073_pow10[shift] / 2)))
+        {
+            break;
+        }
+    }
+
+    if (shift == IEEE11073_POW10_NB)
+        return 0;
+
+    if (shift != 0)
+        mag = (mag + ieee11073_pow10[shift] / 2) / ieee11073_pow10[shift];
+    e += shift;
+
+    // Exponent too large, move it to the mantissa while it fits
+    while ((e > exp_max) && (mag <= ieee11073_mant_max(e - 1, neg, fmt) / 10))
+    {
+        mag *= 10;
+        e--;
+    }
+    if (e > exp_max)
+        return neg ? fmt->ninf : fmt->pinf;
+
+    if (neg)
+        mag = 0UL - mag;
+
+    return (((uint32_t)e & ((1UL << fmt->exp_bits) - 1)) << fmt->mant_bits)
+         | (mag & ((1UL << fmt->mant_bits) - 1));
+}
+
+static uint8_t ieee11073_decode(uint32_t raw, int8_t exp, int32_t *val, struct ieee11073_fmt const *fmt)
+{
+    uint32_t half = 1UL << (fmt->mant_bits - 1);
+    uint32_t mant = raw & ((half << 1) - 1);
+    int16_t e_half = 1 << (fmt->exp_bits - 1);
+    int16_t e = (int16_t)(((raw >> fmt->mant_bits) & ((1UL << fmt->exp_bits) - 1)) ^ e_half) - e_half;
+    bool neg = (mant & half) != 0;
+    uint32_t mag;
+    int16_t d;
+
+    if ((e == 0) && (mant >= half - 2) && (mant <= half + 2))
+        return ieee11073_special[mant - (half - 2)];
+
+    mag = neg ? ((half << 1) - mant) : mant;
+    d = e - exp;
+    if (d >= 0)
+    {
+        if (mag != 0)
+        {
+            if ((d >= IEEE11073_POW10_NB) || (mag > 0x7FFFFFFFUL / ieee11073_pow10[d]))
+                return IEEE11073_VAL_RANGE;
+            mag *= ieee11073_pow10[d];
+        }
+    }
+    else
+    {
+        d = -d;
+        mag = (d >= IEEE11073_POW10_NB) ? 0 : ((mag + ieee11073_pow10[d] / 2) / ieee11073_pow10[d]);
+    }
+
+    *val = neg ? -(int32_t)mag : (int32_t)mag;
+
+    return IEEE11073_VAL_NUMBER;
+}
+
+/*
+ * EXPORTED FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+uint16_t ieee11073_sfloat_encode(int32_t val, int8_t exp)
+{
+    return (uint16_t)ieee11073_encode(val, exp, &ieee11073_sfloat_fmt);
+}
+
+uint8_t ieee11073_sfloat_decode(uint16_t sfloat, int8_t exp, int32_t *val)
+{
+    return ieee11073_decode(sfloat, exp, val, &ieee11073_sfloat_fmt);
+}
+
+uint32_t ieee11073_float_encode(int32_t val, int8_t exp)
+{
+    return ieee11073_encode(val, exp, &ieee11073_float_fmt);
+}
+
+uint8_t ieee11073_float_decode(uint32_t ieee_float, int8_t exp, int32_t *val)
+{
+    return ieee11073_decode(ieee_float, exp, val, &ieee11073_float_fmt);
+}
+
+void ieee11073_sfloat_pack(uint8_t *packed, int32_t const *val, int8_t exp, uint16_t nb)
+{
+    uint16_t exp_bits = (uint16_t)(((uint8_t)exp & 0x0F) << 12);
+    bool direct = (exp >= -8) && (exp <= 7);
+    uint16_t sfloat;
+
+    for (; nb != 0; nb--, val++, packed += 2)
+    {
+        // Readings which fit in the mantissa are already in SFLOAT form
+        if (direct && ((uint32_t)*val + IEEE11073_SFLOAT_MANT_MAX <= 2 * IEEE11073_SFLOAT_MANT_MAX))
+            sfloat = exp_bits | ((uint16_t)*val & 0x0FFF);
+        else
+            sfloat = ieee11073_sfloat_encode(*val, exp);
+
+        packed[0] = (uint8_t)sfloat;
+        packed[1] = (uint8_t)(sfloat >> 8);
+    }
+}
+
+uint16_t ieee11073_sfloat_unpack(uint8_t const *packed, int32_t *val, int8_t exp, uint16_t nb)
+{
+    uint16_t invalid = 0;
+
+    for (; nb != 0; nb--, val++, packed += 2)
+    {
+        if (ieee11073_sfloat_decode(packed[0] | ((uint16_t)packed[1] << 8), exp, val) != IEEE11073_VAL_NUMBER)
+        {
+            *val = IEEE11073_VAL_INVALID;
+            invalid++;
+        }
+    }
+
+    return invalid;
+}
+
+void ieee11073_float_pack(uint8_t *packed, int32_t const *val, int8_t exp, uint16_t nb)
+{
+    uint32_t exp_bits = (uint32_t)(uint8_t)exp << 24;
+    uint32_t ieee_float;
+
+    for (; nb != 0; nb--, val++, packed += 4)
+    {
+        // Any int8_t exponent is a FLOAT exponent, only the mantissa is checked
+        if ((uint32_t)*val + IEEE11073_FLOAT_MANT_MAX <= 2 * IEEE11073_FLOAT_MANT_MAX)
+            ieee_float = exp_bits | ((uint32_t)*val & 0x00FFFFFF);
+        else
+            ieee_float = ieee11073_float_encode(*val, exp);
+
+        packed[0] = (uint8_t)ieee_float;
+        packed[1] = (uint8_t)(ieee_float >> 8);
+        packed[2] = (uint8_t)(ieee_float >> 16);
+        packed[3] = (uint8_t)(ieee_float >> 24);
+    }
+}
+
+uint16_t ieee11073_float_unpack(uint8_t const *packed, int32_t *val, int8_t exp, uint16_t nb)
+{
+    uint16_t invalid = 0;
+    uint32_t ieee_float;
+
+    for (; nb != 0; nb--, val++, packed += 4)
+    {
+        ieee_float = packed[0] | ((uint32_t)packed[1] << 8) | ((uint32_t)packed[2] << 16)
+                   | ((uint32_t)packed[3] << 24);
+        if (ieee11073_float_decode(ieee_float, exp, val) != IEEE11073_VAL_NUMBER)
+        {
+            *val = IEEE11073_VAL_INVALID;
+            invalid++;
+        }
+    }
+
+    return invalid;
+}
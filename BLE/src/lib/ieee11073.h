@@ -0,0 +1,158 @@
+/**
+ ****************************************************************************************
+ *
+ * @file ieee11073.h
+ *
+ * @brief IEEE-11073 SFLOAT and FLOAT codec of the health profile measurements.
+ *
+ * The values are exchanged with the application as fixed point integers: val * 10^exp,
+ * exp being chosen by the caller (-1 for a temperature in tenths of a degree, -2 for a
+ * pressure in hundredths of kPa). The conversions use integers only and divide at most
+ * once per value.
+ *
+ * SFLOAT: 4 bits exponent, 12 bits mantissa. FLOAT: 8 bits exponent, 24 bits mantissa.
+ * Both exponent and mantissa are signed, the value is mantissa * 10^exponent.
+ *
+ * Copyright(C) 2015 NXP Semiconductors N.V.
+ * All rights reserved.
+ *
+ * $Rev: $
+ *
+ ****************************************************************************************
+ */
+
+#ifndef _IEEE11073_H_
+#define _IEEE11073_H_
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+#include <stdint.h>
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// SFLOAT special values
+#define IEEE11073_SFLOAT_NAN        0x07FF
+#define IEEE11073_SFLOAT_NRES       0x0800
+#define IEEE11073_SFLOAT_PINF       0x07FE
+#define IEEE11073_SFLOAT_NINF       0x0802
+#define IEEE11073_SFLOAT_RSVD       0x0801
+
+/// FLOAT special values
+#define IEEE11073_FLOAT_NAN         0x007FFFFF
+#define IEEE11073_FLOAT_NRES        0x00800000
+#define IEEE11073_FLOAT_PINF        0x007FFFFE
+#define IEEE11073_FLOAT_NINF        0x00800002
+#define IEEE11073_FLOAT_RSVD        0x00800001
+
+/// Value stored by the unpack functions for a field which is not a number
+#define IEEE11073_VAL_INVALID       INT32_MIN
+
+/// Kind of a decoded value
+enum IEEE11073_VAL
+{
+    /// A number, converted
+    IEEE11073_VAL_NUMBER = 0,
+    /// Not a Number
+    IEEE11073_VAL_NAN,
+    /// Not at this Resolution
+    IEEE11073_VAL_NRES,
+    /// + Infinity
+    IEEE11073_VAL_PINF,
+    /// - Infinity
+    IEEE11073_VAL_NINF,
+    /// Reserved for future use
+    IEEE11073_VAL_RSVD,
+    /// A number which does not fit in an int32_t at the requested exponent
+    IEEE11073_VAL_RANGE,
+};
+
+/*
+ * FUNCTION DECLARATIONS
+ ****************************************************************************************
+ */
+
+/*
+ ****************************************************************************************
+ * @brief Encode val * 10^exp as an SFLOAT.
+ *
+ * Digits which do not fit in the mantissa are rounded half away from zero, a value too
+ * large for any exponent gives +INF or -INF.
+ ****************************************************************************************
+ */
+uint16_t ieee11073_sfloat_encode(int32_t val, int8_t exp);
+
+/*
+ ****************************************************************************************
+ * @brief Decode an SFLOAT to a fixed point value.
+ *
+ * @param[in]  sfloat  SFLOAT
+ * @param[in]  exp     Exponent of the result, *val is the value / 10^exp rounded
+ * @param[out] val     Value, written for IEEE11073_VAL_NUMBER only
+ *
+ * @return Kind of the value, see enum IEEE11073_VAL
+ ****************************************************************************************
+ */
+uint8_t ieee11073_sfloat_decode(uint16_t sfloat, int8_t exp, int32_t *val);
+
+/*
+ ****************************************************************************************
+ * @brief Encode val * 10^exp as a FLOAT, see ieee11073_sfloat_encode().
+ ****************************************************************************************
+ */
+uint32_t ieee11073_float_encode(int32_t val, int8_t exp);
+
+/*
+ ****************************************************************************************
+ * @brief Decode a FLOAT to a fixed point value, see ieee11073_sfloat_decode().
+ ****************************************************************************************
+ */
+uint8_t ieee11073_float_decode(uint32_t ieee_float, int8_t exp, int32_t *val);
+
+/*
+ ****************************************************************************************
+ * @brief Pack readings of the same exponent as little endian SFLOATs.
+ *
+ * Readings which fit in the mantissa are packed without any conversion.
+ *
+ * @param[out] packed  Buffer of 2 * nb bytes
+ * @param[in]  val     Readings
+ * @param[in]  exp     Exponent of the readings
+ * @param[in]  nb      Number of readings
+ ****************************************************************************************
+ */
+void ieee11073_sfloat_pack(uint8_t *packed, int32_t const *val, int8_t exp, uint16_t nb);
+
+/*
+ ****************************************************************************************
+ * @brief Unpack little endian SFLOATs to fixed point values.
+ *
+ * @param[in]  packed  Buffer of 2 * nb bytes
+ * @param[out] val     Values, IEEE11073_VAL_INVALID for the fields which are not numbers
+ * @param[in]  exp     Exponent of the values
+ * @param[in]  nb      Number of values
+ *
+ * @return Number of fields which are not numbers
+ ****************************************************************************************
+ */
+uint16_t ieee11073_sfloat_unpack(uint8_t const *packed, int32_t *val, int8_t exp, uint16_t nb);
+
+/*
+ ****************************************************************************************
+ * @brief Pack readings as little endian FLOATs, see ieee11073_sfloat_pack().
+ ****************************************************************************************
+ */
+void ieee11073_float_pack(uint8_t *packed, int32_t const *val, int8_t exp, uint16_t nb);
+
+/*
+ ****************************************************************************************
+ * @brief Unpack little endian FLOATs, see ieee11073_sfloat_unpack().
+ ****************************************************************************************
+ */
+uint16_t ieee11073_float_unpack(uint8_t const *packed, int32_t *val, int8_t exp, uint16_t nb);
+
+#endif // _IEEE11073_H_
@@ -303,7 +303,13 @@ typedef void (*p_ke_evt_clear)(uint32_t const);
  ****************************************************************************************
  */
 typedef enum KE_EVENT_STATUS (*p_ke_evt_callback_set)(uint8_t event_type, void (*p_callback)(void));
+#if (QN_TASK_PROF)
+// Event callbacks are wrapped by the profiler, see task_prof.h
+extern enum KE_EVENT_STATUS task_prof_evt_callback_set(uint8_t event_type, void (*p_callback)(void));
+#define ke_evt_callback_set task_prof_evt_callback_set
+#else
 #define ke_evt_callback_set ((p_ke_evt_callback_set)(_ke_evt_callback_set))
+#endif
 
 /**
  ****************************************************************************************
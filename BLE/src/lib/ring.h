@@ -0,0 +1,237 @@
+/**
+ ****************************************************************************************
+ *
+ * @file ring.h
+ *
+ * @brief Bounded single producer, single consumer byte ring.
+ *
+ * Hands bytes or frames from an interrupt handler to the background (or back) without
+ * locks and without heap. Only the producer moves the write index and only the
+ * consumer moves the read index, so each side may run in its own context as long
+ * as there is one producer and one consumer.
+ *
+ * A frame is written with ring_fill() and published at once by ring_commit(), the
+ * consumer never sees half a frame.
+ *
+ * Copyright(C) 2015 NXP Semiconductors N.V.
+ * All rights reserved.
+ *
+ * $Rev: $
+ *
+ ****************************************************************************************
+ */
+
+#ifndef _RING_H_
+#define _RING_H_
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+#if defined(__CC_ARM)
+    #define RING_INLINE         static __inline
+    // Keep the data accesses before the index update
+    #define RING_BARRIER()      __schedule_barrier()
+#elif defined(__GNUC__)
+    #define RING_INLINE         static inline
+    #define RING_BARRIER()      __sync_synchronize()
+#else
+    #define RING_INLINE         static inline
+    #define RING_BARRIER()
+#endif
+
+/*
+ * TYPE DEFINITIONS
+ ****************************************************************************************
+ */
+
+/// Single producer, single consumer ring
+struct ring
+{
+    /// Storage
+    volatile uint8_t *buf;
+    /// Storage size - 1, the size is a power of 2
+    uint16_t mask;
+    /// Write index, only moved by the producer
+    volatile uint16_t head;
+    /// Read index, only moved by the consumer
+    volatile uint16_t tail;
+};
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @brief Initialize a ring on a storage of size bytes, size must be a power of 2.
+ *
+ ****************************************************************************************
+ */
+RING_INLINE void ring_init(struct ring *r, uint8_t *buf, uint16_t size)
+{
+    r->buf = buf;
+    r->mask = size - 1;
+    r->head = 0;
+    r->tail = 0;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Number of bytes ready for the consumer.
+ *
+ ****************************************************************************************
+ */
+RING_INLINE uint16_t ring_count(struct ring const *r)
+{
+    return (uint16_t)(r->head - r->tail);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Number of bytes the producer can still write.
+ *
+ ****************************************************************************************
+ */
+RING_INLINE uint16_t ring_space(struct ring const *r)
+{
+    return (uint16_t)(r->mask + 1 - ring_count(r));
+}
+
+/**
+ ****************************************************************************************
+ * @brief Producer: copy len bytes at off bytes after the write index, not published yet.
+ *
+ ****************************************************************************************
+ */
+RING_INLINE void ring_fill(struct ring *r, uint16_t off, uint8_t const *data, uint16_t len)
+{
+    uint16_t pos = r->head + off;
+
+    while (len--)
+        r->buf[pos++ & r->mask] = *data++;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Producer: get the contiguous room at off bytes after the write index.
+ *
+ * Lets a driver receive straight into the ring, the bytes are published by ring_commit().
+ *
+ * @param[out] len  Contiguous length up to the end of the storage
+ ****************************************************************************************
+ */
+RING_INLINE uint8_t *ring_fill_ptr(struct ring *r, uint16_t off, uint16_t *len)
+{
+    uint16_t pos = (r->head + off) & r->mask;
+
+    *len = r->mask + 1 - pos;
+    return (uint8_t *)&r->buf[pos];
+}
+
+/**
+ ****************************************************************************************
+ * @brief Producer: publish len bytes written by ring_fill().
+ *
+ ****************************************************************************************
+ */
+RING_INLINE void ring_commit(struct ring *r, uint16_t len)
+{
+    RING_BARRIER();
+    r->head += len;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Producer: write and publish len bytes, nothing is written if they do not fit.
+ *
+ ****************************************************************************************
+ */
+RING_INLINE bool ring_write(struct ring *r, uint8_t const *data, uint16_t len)
+{
+    if (ring_space(r) < len)
+        return false;
+
+    ring_fill(r, 0, data, len);
+    ring_commit(r, len);
+    return true;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Consumer: copy len bytes at off bytes after the read index, without consuming.
+ *
+ * @return false if fewer than off + len bytes are ready.
+ ****************************************************************************************
+ */
+RING_INLINE bool ring_peek(struct ring const *r, uint16_t off, uint8_t *data, uint16_t len)
+{
+    uint16_t pos = r->tail + off;
+
+    if (ring_count(r) < off + len)
+        return false;
+
+    RING_BARRIER();
+    while (len--)
+        *data++ = r->buf[pos++ & r->mask];
+    return true;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Consumer: get the contiguous ready bytes at the read index, without consuming.
+ *
+ * Lets a driver transmit straight from the ring, the bytes are released by ring_skip().
+ *
+ * @param[out] len  Contiguous length up to the end of the storage
+ ****************************************************************************************
+ */
+RING_INLINE uint8_t *ring_peek_ptr(struct ring const *r, uint16_t *len)
+{
+    uint16_t pos = r->tail & r->mask;
+    uint16_t count = ring_count(r);
+
+    *len = r->mask + 1 - pos;
+    if (*len > count)
+        *len = count;
+    RING_BARRIER();
+    return (uint8_t *)&r->buf[pos];
+}
+
+/**
+ ****************************************************************************************
+ * @brief Consumer: release len bytes.
+ *
+ ****************************************************************************************
+ */
+RING_INLINE void ring_skip(struct ring *r, uint16_t len)
+{
+    RING_BARRIER();
+    r->tail += len;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Consumer: read and release len bytes, nothing is read if they are not ready.
+ *
+ ****************************************************************************************
+ */
+RING_INLINE bool ring_read(struct ring *r, uint8_t *data, uint16_t len)
+{
+    if (!ring_peek(r, 0, data, len))
+        return false;
+
+    ring_skip(r, len);
+    return true;
+}
+
+#endif // _RING_H_
@@ -0,0 +1,526 @@
+/**
+ ****************************************************************************************
+ *
+ * @file task_prof.c
+ *
+ * @brief Profiler of the kernel event callbacks and task message handlers.
+ *
+ * Copyright(C) 2015 NXP Semiconductors N.V.
+ * All rights reserved.
+ *
+ * $Rev: $
+ *
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+#include <string.h>
+#include "task_prof.h"
+
+#if (QN_TASK_PROF)
+#include "intc.h"
+#include "lib.h"
+#include "ke_mem.h"
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// SysTick is a 24-bit down counter
+#define TASK_PROF_CYCLE_MASK        (0xFFFFFF)
+/// Data memory which may hold kernel messages
+#define TASK_PROF_RAM_START         (0x10000000)
+#define TASK_PROF_RAM_END           (0x10010000)
+
+/*
+ * TYPE DEFINITIONS
+ ****************************************************************************************
+ */
+
+/// Handlers of a wrapped task
+struct task_prof_task
+{
+    /// Handlers given to task_desc_register()
+    const struct ke_state_handler *state_handler;
+    const struct ke_state_handler *default_handler;
+    /// Copies given to the kernel instead
+    struct ke_state_handler *state_copy;
+    struct ke_state_handler *default_copy;
+    /// Number of states
+    uint16_t state_max;
+    /// Task type
+    uint8_t type;
+};
+
+/// Profiler environment
+struct task_prof_env_tag
+{
+    struct task_prof prof;
+    /// Event callbacks given to ke_evt_callback_set()
+    void (*evt_cb[TASK_PROF_EVT_NB])(void);
+    /// Wrapped tasks
+    struct task_prof_task task[TASK_PROF_TASK_NB];
+    uint8_t task_nb;
+    /// Copies of the handler tables, handed out in order
+    struct ke_state_handler state_pool[TASK_PROF_STATE_NB];
+    struct ke_msg_handler handler_pool[TASK_PROF_HANDLER_NB];
+    uint16_t state_used;
+    uint16_t handler_used;
+    /// Server databases creation: cycle counter at start, cycles once done
+    uint32_t svc_db_start;
+    uint32_t svc_db_cycles;
+    bool svc_db_on;
+};
+
+/*
+ * LOCAL VARIABLES
+ ****************************************************************************************
+ */
+
+static struct task_prof_env_tag task_prof_env;
+
+/*
+ * LOCAL FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @brief Read the cycle counter
+ ****************************************************************************************
+ */
+__STATIC_INLINE uint32_t task_prof_cycle(void)
+{
+    return SysTick->VAL;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Charge a call to a handler
+ * @param[in] item      Handler profile
+ * @param[in] start     Cycle counter before the call
+ * @description
+ *  SysTick counts down and wraps every 2^24 cycles, longer calls are underestimated.
+ ****************************************************************************************
+ */
+static void task_prof_add(struct task_prof_item *item, uint32_t start)
+{
+    uint32_t cycles = (start - task_prof_cycle()) & TASK_PROF_CYCLE_MASK;
+
+    item->count++;
+    item->total += cycles;
+    if (cycles > item->max)
+        item->max = cycles;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Count the messages of a kernel queue
+ * @description
+ *  The walk is bounded and stops at any link which does not point to data memory, so
+ *  a queue being updated can only give a wrong sample.
+ ****************************************************************************************
+ */
+static uint32_t task_prof_queue_depth(struct co_list const *list)
+{
+    struct co_list_hdr const *hdr = list->first;
+    uint32_t depth = 0;
+
+    while ((hdr != NULL) && (depth < TASK_PROF_QUEUE_MAX)
+        && ((uint32_t)hdr >= TASK_PROF_RAM_START) && ((uint32_t)hdr < TASK_PROF_RAM_END))
+    {
+        depth++;
+        hdr = hdr->next;
+    }
+
+    return depth;
+}
+
+static void task_prof_queue_add(struct task_prof_queue *queue, uint32_t depth)
+{
+    queue->count++;
+    queue->total += depth;
+    if (depth > queue->max)
+        queue->max = depth;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Sample the depth of the kernel message queues
+ ****************************************************************************************
+ */
+static void task_prof_queue_sample(void)
+{
+    struct ke_env_tag const *ke_env = (struct ke_env_tag const *)_ke_env;
+    uint32_t sent, saved;
+
+    GLOBAL_INT_DISABLE();
+    sent = task_prof_queue_depth(&ke_env->queue_sent);
+    saved = task_prof_queue_depth(&ke_env->queue_saved);
+    GLOBAL_INT_RESTORE();
+
+    task_prof_queue_add(&task_prof_env.prof.queue_sent, sent);
+    task_prof_queue_add(&task_prof_env.prof.queue_saved, saved);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Call an event callback
+ ****************************************************************************************
+ */
+static void task_prof_evt_call(uint8_t event_type)
+{
+    uint32_t start = task_prof_cycle();
+
+    task_prof_env.evt_cb[event_type]();
+    task_prof_add(&task_prof_env.prof.evt[event_type], start);
+}
+
+#define TASK_PROF_EVT_HDL(n)                                                        \
+    static void task_prof_evt_hdl_##n(void) { task_prof_evt_call(n); }
+
+TASK_PROF_EVT_HDL(0)  TASK_PROF_EVT_HDL(1)  TASK_PROF_EVT_HDL(2)  TASK_PROF_EVT_HDL(3)
+TASK_PROF_EVT_HDL(4)  TASK_PROF_EVT_HDL(5)  TASK_PROF_EVT_HDL(6)  TASK_PROF_EVT_HDL(7)
+TASK_PROF_EVT_HDL(8)  TASK_PROF_EVT_HDL(9)  TASK_PROF_EVT_HDL(10) TASK_PROF_EVT_HDL(11)
+TASK_PROF_EVT_HDL(12) TASK_PROF_EVT_HDL(13) TASK_PROF_EVT_HDL(14) TASK_PROF_EVT_HDL(15)
+TASK_PROF_EVT_HDL(16) TASK_PROF_EVT_HDL(17) TASK_PROF_EVT_HDL(18) TASK_PROF_EVT_HDL(19)
+TASK_PROF_EVT_HDL(20) TASK_PROF_EVT_HDL(21) TASK_PROF_EVT_HDL(22) TASK_PROF_EVT_HDL(23)
+
+/// Wrapper registered in the kernel for each event, the callback has no parameter
+static void (* const task_prof_evt_hdl[TASK_PROF_EVT_NB])(void) =
+{
+    task_prof_evt_hdl_0,  task_prof_evt_hdl_1,  task_prof_evt_hdl_2,  task_prof_evt_hdl_3,
+    task_prof_evt_hdl_4,  task_prof_evt_hdl_5,  task_prof_evt_hdl_6,  task_prof_evt_hdl_7,
+    task_prof_evt_hdl_8,  task_prof_evt_hdl_9,  task_prof_evt_hdl_10, task_prof_evt_hdl_11,
+    task_prof_evt_hdl_12, task_prof_evt_hdl_13, task_prof_evt_hdl_14, task_prof_evt_hdl_15,
+    task_prof_evt_hdl_16, task_prof_evt_hdl_17, task_prof_evt_hdl_18, task_prof_evt_hdl_19,
+    task_prof_evt_hdl_20, task_prof_evt_hdl_21, task_prof_evt_hdl_22, task_prof_evt_hdl_23,
+};
+
+static struct task_prof_task *task_prof_task_find(uint8_t type)
+{
+    uint8_t i;
+
+    for (i = 0; i < task_prof_env.task_nb; i++)
+    {
+        if (task_prof_env.task[i].type == type)
+            return &task_prof_env.task[i];
+    }
+
+    return NULL;
+}
+
+static ke_msg_func_t task_prof_func_find(struct ke_state_handler const *state, ke_msg_id_t const msgid)
+{
+    uint16_t i;
+
+    if ((state == NULL) || (state->msg_table == NULL))
+        return NULL;
+
+    for (i = 0; i < state->msg_cnt; i++)
+    {
+        if (state->msg_table[i].id == msgid)
+            return state->msg_table[i].func;
+    }
+
+    return NULL;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Get the profile of a message handler
+ * @return the profile, NULL when the table is full
+ ****************************************************************************************
+ */
+static struct task_prof_item *task_prof_msg_item(uint8_t type, ke_msg_id_t const msgid)
+{
+    struct task_prof *prof = &task_prof_env.prof;
+    uint8_t i;
+
+    for (i = 0; i < prof->msg_nb; i++)
+    {
+        if ((prof->msg[i].id == msgid) && (prof->msg[i].task == type))
+            return &prof->msg[i].item;
+    }
+
+    if (prof->msg_nb == TASK_PROF_MSG_NB)
+    {
+        prof->msg_lost++;
+        return NULL;
+    }
+
+    prof->msg[i].id = msgid;
+    prof->msg[i].task = type;
+    prof->msg_nb++;
+
+    return &prof->msg[i].item;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Call a message handler
+ * @description
+ *  Every handler of a wrapped task points here. The handler given to
+ *  task_desc_register() is looked up like the kernel does: in the table of the
+ *  current state first, then in the default table.
+ ****************************************************************************************
+ */
+static int task_prof_msg_hdl(ke_msg_id_t const msgid, void const *param,
+                             ke_task_id_t const dest_id, ke_task_id_t const src_id)
+{
+    struct task_prof_task *task = task_prof_task_find(KE_TYPE_GET(dest_id));
+    struct task_prof_item *item;
+    ke_msg_func_t func = NULL;
+    ke_state_t state;
+    uint32_t start;
+    int ret;
+
+    if (task == NULL)
+        return KE_MSG_CONSUMED;
+
+    if (task->state_handler != NULL)
+    {
+        state = ke_state_get(dest_id);
+        if (state < task->state_max)
+            func = task_prof_func_find(&task->state_handler[state], msgid);
+    }
+    if (func == NULL)
+        func = task_prof_func_find(task->default_handler, msgid);
+    if (func == NULL)
+        return KE_MSG_CONSUMED;
+
+    task_prof_queue_sample();
+    item = task_prof_msg_item(task->type, msgid);
+
+    start = task_prof_cycle();
+    ret = func(msgid, param, dest_id, src_id);
+    if (item != NULL)
+        task_prof_add(item, start);
+
+    return ret;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Copy a state handler, every message pointing to task_prof_msg_hdl()
+ ****************************************************************************************
+ */
+static void task_prof_state_copy(struct ke_state_handler *copy, struct ke_state_handler const *state)
+{
+    struct ke_msg_handler *table = &task_prof_env.handler_pool[task_prof_env.handler_used];
+    uint16_t i;
+
+    copy->msg_table = (state->msg_table != NULL) ? table : NULL;
+    copy->msg_cnt = state->msg_cnt;
+    if (state->msg_table == NULL)
+        return;
+
+    for (i = 0; i < state->msg_cnt; i++)
+    {
+        table[i].id = state->msg_table[i].id;
+        table[i].func = task_prof_msg_hdl;
+    }
+    task_prof_env.handler_used += state->msg_cnt;
+}
+
+/*
+ * EXPORTED FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @brief Start the cycle counter
+ * @description
+ *  SysTick runs free on the processor clock without interrupt. It must not be used for
+ *  anything else while the profiler is on.
+ ****************************************************************************************
+ */
+void task_prof_init(void)
+{
+    SysTick->CTRL = 0;
+    SysTick->LOAD = TASK_PROF_CYCLE_MASK;
+    SysTick->VAL = 0;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+
+    task_prof_reset();
+}
+
+/**
+ ****************************************************************************************
+ * @brief Clear the profile
+ ****************************************************************************************
+ */
+void task_prof_reset(void)
+{
+    memset(&task_prof_env.prof, 0, sizeof(task_prof_env.prof));
+}
+
+/**
+ ****************************************************************************************
+ * @brief Get the profile
+ * @description
+ *  The profile is only updated by the background, so it is read without lock.
+ ****************************************************************************************
+ */
+struct task_prof const *task_prof_get(void)
+{
+    return &task_prof_env.prof;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Start timing a scheduler pass
+ * @return cycle counter, to give to task_prof_sched_end()
+ ****************************************************************************************
+ */
+uint32_t task_prof_sched_start(void)
+{
+    return task_prof_cycle();
+}
+
+/**
+ ****************************************************************************************
+ * @brief Charge a scheduler pass
+ ****************************************************************************************
+ */
+void task_prof_sched_end(uint32_t start)
+{
+    task_prof_add(&task_prof_env.prof.sched, start);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Start timing the creation of the server databases at boot
+ ****************************************************************************************
+ */
+void task_prof_svc_db_start(void)
+{
+    task_prof_env.svc_db_start = task_prof_cycle();
+    task_prof_env.svc_db_cycles = 0;
+    task_prof_env.svc_db_on = true;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Stop timing the creation of the server databases, when the last one is confirmed
+ ****************************************************************************************
+ */
+void task_prof_svc_db_end(void)
+{
+    if (task_prof_env.svc_db_on)
+    {
+        task_prof_env.svc_db_cycles = (task_prof_env.svc_db_start - task_prof_cycle()) & TASK_PROF_CYCLE_MASK;
+        task_prof_env.svc_db_on = false;
+    }
+}
+
+/**
+ ****************************************************************************************
+ * @brief Get the cycles spent creating the server databases
+ * @return cycles from app_create_server_service_DB() to the last confirmation, 0 when not
+ *  done yet. The value is kept by task_prof_reset().
+ ****************************************************************************************
+ */
+uint32_t task_prof_svc_db_get(void)
+{
+    return task_prof_env.svc_db_cycles;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Register an event callback through its profiling wrapper
+ * @description
+ *  This function replaces ke_evt_callback_set() when the profiler is on. Events the
+ *  application does not own are registered unwrapped.
+ ****************************************************************************************
+ */
+enum KE_EVENT_STATUS task_prof_evt_callback_set(uint8_t event_type, void (*p_callback)(void))
+{
+    enum KE_EVENT_STATUS status;
+
+    if ((event_type >= TASK_PROF_EVT_NB) || (p_callback == NULL))
+        return ((p_ke_evt_callback_set)(_ke_evt_callback_set))(event_type, p_callback);
+
+    status = ((p_ke_evt_callback_set)(_ke_evt_callback_set))(event_type, task_prof_evt_hdl[event_type]);
+    if (status == KE_EVENT_OK)
+        task_prof_env.evt_cb[event_type] = p_callback;
+
+    return status;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Register a task with its message handlers wrapped
+ * @description
+ *  This function replaces task_desc_register() when the profiler is on. The handler
+ *  tables are copied with every handler pointing to task_prof_msg_hdl(). A task which
+ *  does not fit in the pools is registered unwrapped.
+ ****************************************************************************************
+ */
+void task_prof_desc_register(uint8_t task_id, struct ke_task_desc task_desc)
+{
+    struct task_prof_task *task = task_prof_task_find(task_id);
+    uint16_t state_nb, handler_nb;
+    uint16_t i;
+
+    if ((task == NULL) && (task_prof_env.task_nb < TASK_PROF_TASK_NB))
+    {
+        // Room needed in the pools
+        state_nb = 0;
+        handler_nb = 0;
+        if (task_desc.state_handler != NULL)
+        {
+            state_nb += task_desc.state_max;
+            for (i = 0; i < task_desc.state_max; i++)
+                handler_nb += task_desc.state_handler[i].msg_cnt;
+        }
+        if (task_desc.default_handler != NULL)
+        {
+            state_nb++;
+            handler_nb += task_desc.default_handler->msg_cnt;
+        }
+
+        if ((task_prof_env.state_used + state_nb <= TASK_PROF_STATE_NB)
+         && (task_prof_env.handler_used + handler_nb <= TASK_PROF_HANDLER_NB))
+        {
+            task = &task_prof_env.task[task_prof_env.task_nb++];
+            task->type = task_id;
+            task->state_handler = task_desc.state_handler;
+            task->default_handler = task_desc.default_handler;
+            task->state_max = task_desc.state_max;
+            task->state_copy = NULL;
+            task->default_copy = NULL;
+
+            if (task_desc.state_handler != NULL)
+            {
+                task->state_copy = &task_prof_env.state_pool[task_prof_env.state_used];
+                task_prof_env.state_used += task_desc.state_max;
+                for (i = 0; i < task_desc.state_max; i++)
+                    task_prof_state_copy(&task->state_copy[i], &task_desc.state_handler[i]);
+            }
+            if (task_desc.default_handler != NULL)
+            {
+                task->default_copy = &task_prof_env.state_pool[task_prof_env.state_used++];
+                task_prof_state_copy(task->default_copy, task_desc.default_handler);
+            }
+        }
+    }
+
+    // Registered again with the same tables, reuse the copies
+    if ((task != NULL)
+     && (task->state_handler == task_desc.state_handler)
+     && (task->default_handler == task_desc.default_handler))
+    {
+        task_desc.state_handler = task->state_copy;
+        task_desc.default_handler = task->default_copy;
+    }
+
+    ((p_task_desc_register)(_task_desc_register))(task_id, task_desc);
+}
+
+#endif // QN_TASK_PROF
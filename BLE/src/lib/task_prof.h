@@ -0,0 +1,150 @@
+/**
+ ****************************************************************************************
+ *
+ * @file task_prof.h
+ *
+ * @brief Profiler of the kernel event callbacks and task message handlers.
+ *
+ * With CFG_TASK_PROF, ke_evt_callback_set() is routed through this module by lib.h and
+ * task_desc_register() by this header, which app_env.h and prf_types.h include. Every
+ * event callback and every message handler registered from the application sources is
+ * then called through a wrapper which counts the calls and measures their duration in
+ * processor cycles with SysTick. The depth of the kernel message queues is sampled before
+ * each message and every ke_schedule() pass of the main loop is timed as well.
+ *
+ * Callbacks and handlers which stay inside the ROM (link layer, GAP, GATT, SMP) are not
+ * seen, their cost shows in the scheduler passes only.
+ *
+ * Copyright(C) 2015 NXP Semiconductors N.V.
+ * All rights reserved.
+ *
+ * $Rev: $
+ *
+ ****************************************************************************************
+ */
+
+#ifndef _TASK_PROF_H_
+#define _TASK_PROF_H_
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+#include <stdint.h>
+#include "app_config.h"
+
+#if (QN_TASK_PROF)
+#include "ke_task.h"
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// Event callbacks which can be profiled, the application owns events 0 to 23
+#define TASK_PROF_EVT_NB            24
+/// Distinct message handlers which can be profiled, further ones are counted in msg_lost
+#ifndef TASK_PROF_MSG_NB
+#define TASK_PROF_MSG_NB            32
+#endif
+/// Tasks whose handlers are wrapped
+#ifndef TASK_PROF_TASK_NB
+#define TASK_PROF_TASK_NB           8
+#endif
+/// State handlers copied for the wrapped tasks, default handlers included
+#ifndef TASK_PROF_STATE_NB
+#define TASK_PROF_STATE_NB          32
+#endif
+/// Message handler entries copied for the wrapped tasks
+#ifndef TASK_PROF_HANDLER_NB
+#define TASK_PROF_HANDLER_NB        192
+#endif
+/// Longest message queue walked when sampling its depth
+#define TASK_PROF_QUEUE_MAX         255
+
+/// Task of the lost message handlers
+#define TASK_PROF_TASK_NONE         0xFF
+
+/*
+ * TYPE DEFINITIONS
+ ****************************************************************************************
+ */
+
+/// Calls and processor cycles of a handler
+struct task_prof_item
+{
+    /// Number of calls
+    uint32_t    count;
+    /// Longest call
+    uint32_t    max;
+    /// Cycles of all the calls
+    uint32_t    total;
+};
+
+/// Profile of a message handler
+struct task_prof_msg
+{
+    struct task_prof_item   item;
+    /// Message
+    ke_msg_id_t             id;
+    /// Task type of the receiver
+    uint8_t                 task;
+};
+
+/// Depth samples of a kernel message queue
+struct task_prof_queue
+{
+    /// Number of samples
+    uint32_t    count;
+    /// Deepest sample
+    uint32_t    max;
+    /// Sum of the samples
+    uint32_t    total;
+};
+
+/// Handler profile
+struct task_prof
+{
+    /// ke_schedule() passes of the main loop
+    struct task_prof_item   sched;
+    /// Event callbacks, indexed by event
+    struct task_prof_item   evt[TASK_PROF_EVT_NB];
+    /// Message handlers, in the order of their first call
+    struct task_prof_msg    msg[TASK_PROF_MSG_NB];
+    /// Used entries of msg
+    uint8_t                 msg_nb;
+    /// Calls of the handlers which did not fit in msg
+    uint32_t                msg_lost;
+    /// Messages waiting in the sent queue when a message is handled
+    struct task_prof_queue  queue_sent;
+    /// Messages saved by their receiver when a message is handled
+    struct task_prof_queue  queue_saved;
+};
+
+/*
+ * FUNCTION DECLARATIONS
+ ****************************************************************************************
+ */
+
+extern void task_prof_init(void);
+extern void task_prof_reset(void);
+extern struct task_prof const *task_prof_get(void);
+extern uint32_t task_prof_sched_start(void);
+extern void task_prof_sched_end(uint32_t start);
+extern void task_prof_svc_db_start(void);
+extern void task_prof_svc_db_end(void);
+extern uint32_t task_prof_svc_db_get(void);
+extern void task_prof_desc_register(uint8_t task_id, struct ke_task_desc task_desc);
+
+/*
+ * ROM API REDIRECTION
+ ****************************************************************************************
+ */
+
+/// Tasks registered from the sources which include this header are wrapped by the profiler
+#undef task_desc_register
+#define task_desc_register task_prof_desc_register
+
+#endif // QN_TASK_PROF
+
+#endif // _TASK_PROF_H_
@@ -34,6 +34,12 @@
 #if (QN_WORK_MODE == WORK_MODE_SOC)
     #include "app_env.h"
 #endif
+#if (QN_HEAP_STAT)
+    #include "app_sys.h"
+#endif
+#if (QN_TASK_PROF)
+    #include "task_prof.h"
+#endif
 
 #include "usr_design.h"
 #include "system.h"
@@ -120,6 +126,9 @@ static void prf_register(void)
 int main(void)
 {
     int ble_sleep_st, usr_sleep_st;
+#if (QN_TASK_PROF)
+    uint32_t sched_start;
+#endif
 
     // XTAL load cap
     // xadd_c = 1 -> load cap = 10 + xcsel*0.32pf   (xcsel is reg_0x400000a4[17:22], the value of xcsel is stored in the NVDS)
@@ -143,6 +152,11 @@ int main(void)
     // System initialization, user configuration
     SystemInit();
 
+#if (QN_TASK_PROF)
+    // Start the cycle counter before any handler is registered
+    task_prof_init();
+#endif
+
     // Profiles register
 #if (QN_WORK_MODE != WORK_MODE_HCI)
     prf_register();
@@ -155,6 +169,11 @@ int main(void)
     // 2. Controller mode does not support sleep mode.
     // 3. So far client example project does not support sleep mode. It will be implemented later.
 
+#if (QN_HEAP_STAT)
+    // Mark the heap before the stack uses it
+    app_heap_stat_init(ble_heap, BLE_HEAP_SIZE);
+#endif
+
     // Check to go normal work mode or test mode.
     // If the input of test control pin is low level, the program will enter into test mode, otherwise the program will
     // enter into work mode which is defined in the user configuration file.
@@ -193,7 +212,16 @@ int main(void)
 
     while(1)
     {
+#if (QN_TASK_PROF)
+        sched_start = task_prof_sched_start();
+        ke_schedule();
+        task_prof_sched_end(sched_start);
+#else
         ke_schedule();
+#endif
+#if (QN_HEAP_TRACE)
+        app_heap_trace_sched();
+#endif
 
         // Checks for sleep have to be done with interrupt disabled
         GLOBAL_INT_DISABLE_WITHOUT_TUNER();
@@ -218,6 +246,9 @@ int main(void)
         {
             // Obtain the status of ble sleep mode
             ble_sleep_st = ble_sleep(usr_sleep_st);
+#if (QN_SLEEP_STAT)
+            sleep_stat_enter(usr_sleep_st, ble_sleep_st);
+#endif
 
             // Check if the processor clock can be gated
             if(((ble_sleep_st == PM_IDLE) || (usr_sleep_st == PM_IDLE))
@@ -246,6 +277,9 @@ int main(void)
                 enter_sleep(SLEEP_NORMAL,
                             (WAKEUP_BY_OSC_EN | WAKEUP_BY_GPIO),
                             sleep_cb);
+#if (QN_SLEEP_STAT)
+                sleep_stat_wakeup();
+#endif
 
                 // Debug
 //                led_set(3, LED_OFF);
@@ -262,12 +296,21 @@ int main(void)
                 enter_sleep(SLEEP_DEEP,
                             WAKEUP_BY_GPIO,
                             sleep_cb);
+#if (QN_SLEEP_STAT)
+                sleep_stat_wakeup();
+#endif
 
                 // Debug
 //                led_set(2, LED_OFF);
 //                led_set(5, LED_ON);  // led5 is on when enter into active mode
             }
         }
+#if (QN_SLEEP_STAT)
+        else
+        {
+            sleep_stat_enter(PM_ACTIVE, PM_ACTIVE);
+        }
+#endif
 
         // Checks for sleep have to be done with interrupt disabled
         GLOBAL_INT_RESTORE_WITHOUT_TUNER();
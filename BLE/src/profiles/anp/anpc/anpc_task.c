@@ -153,9 +153,9 @@ static int anpc_enable_cmd_handler(ke_msg_id_t const msgid,
             // Force the operation value
             param->operation = ANPC_ENABLE_RD_NEW_ALERT_OP_CODE;
 
-            // Check Supported New Alert Category
+            // Check Supported New Alert Category, one or two bytes
             prf_read_char_send(&(anpc_env->con_info), anpc_env->ans.svc.shdl,
-                               anpc_env->ans.svc.ehdl, anpc_env->ans.chars[ANPC_CHAR_SUP_NEW_ALERT_CAT].val_hdl);
+                               anpc_env->ans.svc.ehdl, anpc_env->ans.chars[ANPC_CHAR_SUP_NEW_ALERT_CAT].val_hdl, 0);
         }
 
         // Keep the operation
@@ -255,9 +255,9 @@ static int anpc_read_cmd_handler(ke_msg_id_t const msgid,
                     anpc_env->operation   = param;
                     msg_status = KE_MSG_NO_FREE;
 
-                    // Send the read request
+                    // Send the read request, both codes read a client configuration
                     prf_read_char_send(&(anpc_env->con_info), anpc_env->ans.svc.shdl,
-                                       anpc_env->ans.svc.ehdl, handle);
+                                       anpc_env->ans.svc.ehdl, handle, PRF_CCC_DESC_LEN);
 
                     // Go to the Busy state
                     ke_state_set(dest_id, ANPC_BUSY);
@@ -645,7 +645,7 @@ static int gatt_cmp_evt_handler(ke_msg_id_t const msgid,
                         ((struct anpc_enable_cmd *)anpc_env->operation)->operation = ANPC_ENABLE_RD_NEW_ALERT_OP_CODE;
                         // Check Supported New Alert Categories
                         prf_read_char_send(&(anpc_env->con_info), anpc_env->ans.svc.shdl,
-                                           anpc_env->ans.svc.ehdl, anpc_env->ans.chars[ANPC_CHAR_SUP_NEW_ALERT_CAT].val_hdl);
+                                           anpc_env->ans.svc.ehdl, anpc_env->ans.chars[ANPC_CHAR_SUP_NEW_ALERT_CAT].val_hdl, 0);
                     }
                 }
                 else
@@ -719,7 +719,7 @@ static int gatt_rd_char_rsp_handler(ke_msg_id_t const msgid,
                     // Check Supported Unread Alert Category
                     prf_read_char_send(&(anpc_env->con_info),
                                        anpc_env->ans.svc.shdl, anpc_env->ans.svc.ehdl,
-                                       anpc_env->ans.chars[ANPC_CHAR_SUP_UNREAD_ALERT_CAT].val_hdl);
+                                       anpc_env->ans.chars[ANPC_CHAR_SUP_UNREAD_ALERT_CAT].val_hdl, 0);
                 }
                 else
                 {
@@ -51,18 +51,14 @@
 
 /**
  ****************************************************************************************
- * @brief Handles reception of the @ref ANPS_CREATE_DB_REQ message.
- * @param[in] msgid Id of the message received.
- * @param[in] param Pointer to the parameters of the message.
- * @param[in] dest_id ID of the receiving task instance.
- * @param[in] src_id ID of the sending task instance.
- * @return If the message was consumed or not.
+ * @brief Create the ANPS attribute database.
+ * Used by the @ref ANPS_CREATE_DB_REQ handler, and directly by the application when
+ * the database is created without kernel messages.
+ * @param[in] param Pointer to the database configuration.
+ * @return Database creation status.
  ****************************************************************************************
  */
-static int anps_create_db_req_handler(ke_msg_id_t const msgid,
-                                      struct anps_create_db_req *param,
-                                      ke_task_id_t const dest_id,
-                                      ke_task_id_t const src_id)
+uint8_t anps_create_db(struct anps_create_db_req *param)
 {
     // Service Configuration Flag - All attributes have to be added in the database
     uint16_t cfg_flag = ANPS_DB_CONFIG_MASK;
@@ -80,7 +76,7 @@ static int anps_create_db_req_handler(ke_msg_id_t const msgid,
         {
             // Add service in the database
             status = atts_svc_create_db(&anps_env.ans_shdl, (uint8_t *)&cfg_flag, ANS_IDX_NB, NULL,
-                                        dest_id, &ans_att_db[0]);
+                                        TASK_ANPS, &ans_att_db[0]);
 
             // Go to Idle State
             if (status == ATT_ERR_NO_ERROR)
@@ -141,6 +137,27 @@ static int anps_create_db_req_handler(ke_msg_id_t const msgid,
         status = PRF_ERR_REQ_DISALLOWED;
     }
 
+    return (status);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Handles reception of the @ref ANPS_CREATE_DB_REQ message.
+ * @param[in] msgid Id of the message received.
+ * @param[in] param Pointer to the parameters of the message.
+ * @param[in] dest_id ID of the receiving task instance.
+ * @param[in] src_id ID of the sending task instance.
+ * @return If the message was consumed or not.
+ ****************************************************************************************
+ */
+static int anps_create_db_req_handler(ke_msg_id_t const msgid,
+                                      struct anps_create_db_req *param,
+                                      ke_task_id_t const dest_id,
+                                      ke_task_id_t const src_id)
+{
+    //Database Creation Status
+    uint8_t status = anps_create_db(param);
+
     // Send response to application
     anps_send_cmp_evt(TASK_ANPS, src_id, GAP_INVALID_CONHDL, ANPS_CREATE_DB_OP_CODE, status);
 
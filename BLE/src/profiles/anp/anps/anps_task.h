@@ -215,6 +215,8 @@ extern const struct ke_state_handler anps_default_handler;
 extern ke_state_t anps_state[ANPS_IDX_MAX];
 
 extern void task_anps_desc_register(void);
+
+extern uint8_t anps_create_db(struct anps_create_db_req *param);
 #endif //(BLE_AN_SERVER)
 
 /// @} ANPSTASK
@@ -57,6 +57,13 @@ const struct prf_char_desc_def basc_bas_char_desc[BAS_DESC_MAX] =
     [BAS_DESC_BATT_LEVEL_PRES_FORMAT]   = {ATT_DESC_CHAR_PRES_FORMAT,  ATT_OPTIONAL, BAS_CHAR_BATT_LEVEL},
 };
 
+/// Lengths of the Battery Service descriptors, read together on a GATT queue
+static const uint8_t basc_bas_desc_len[BAS_DESC_MAX] =
+{
+    [BAS_DESC_BATT_LEVEL_CFG]           = PRF_CCC_DESC_LEN,
+    [BAS_DESC_BATT_LEVEL_PRES_FORMAT]   = 7,
+};
+
 /*
  * GLOBAL FUNCTIONS DEFINITIONS
  ****************************************************************************************
@@ -148,6 +155,8 @@ static int basc_char_rd_req_handler(ke_msg_id_t const msgid,
                                                ke_task_id_t const src_id)
 {
     uint16_t search_hdl = ATT_INVALID_SEARCH_HANDLE;
+    // Length of the value
+    uint8_t len = 0;
     // Get the address of the environment
     struct basc_env_tag *basc_env = PRF_CLIENT_GET_ENV(dest_id, basc);
 
@@ -157,21 +166,24 @@ static int basc_char_rd_req_handler(ke_msg_id_t const msgid,
     {
         //Battery Level Service Descriptor
         if(((param->char_code & BAS_DESC_MASK) == BAS_DESC_MASK) &&
-           ((param->char_code & ~BAS_DESC_MASK) < BAS_DESC_MASK))
+           ((param->char_code & ~BAS_DESC_MASK) < BAS_DESC_MAX))
         {
             search_hdl = basc_env->bas[param->bas_nb].descs[param->char_code & ~BAS_DESC_MASK].desc_hdl;
+            len = basc_bas_desc_len[param->char_code & ~BAS_DESC_MASK];
         }
         //Battery Service Characteristic
         else if (param->char_code < BAS_CHAR_MAX)
         {
             search_hdl = basc_env->bas[param->bas_nb].chars[param->char_code].val_hdl;
+            // Battery Level
+            len = sizeof(uint8_t);
         }
 
         // Check if handle is viable
         if (search_hdl != ATT_INVALID_SEARCH_HANDLE)
         {
             prf_read_char_send(&(basc_env->con_info), basc_env->bas[param->bas_nb].svc.shdl,
-                               basc_env->bas[param->bas_nb].svc.ehdl, search_hdl);
+                               basc_env->bas[param->bas_nb].svc.ehdl, search_hdl, len);
             // Save the service instance number
             basc_env->last_svc_inst_req  = param->bas_nb;
             // Save the attribute read code
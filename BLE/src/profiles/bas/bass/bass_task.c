@@ -45,19 +45,14 @@
 
 /**
  ****************************************************************************************
- * @brief Handles reception of the @ref BASS_CREATE_DB_REQ message.
- * The handler adds BAS into the database using value of the features param.
- * @param[in] msgid Id of the message received (probably unused).
- * @param[in] param Pointer to the parameters of the message.
- * @param[in] dest_id ID of the receiving task instance (probably unused).
- * @param[in] src_id ID of the sending task instance.
- * @return If the message was consumed or not.
+ * @brief Create the BASS attribute database.
+ * Used by the @ref BASS_CREATE_DB_REQ handler, and directly by the application when
+ * the database is created without kernel messages.
+ * @param[in] param Pointer to the database configuration.
+ * @return Database creation status.
  ****************************************************************************************
  */
-static int bass_create_db_req_handler(ke_msg_id_t const msgid,
-                                      struct bass_create_db_req const *param,
-                                      ke_task_id_t const dest_id,
-                                      ke_task_id_t const src_id)
+uint8_t bass_create_db(struct bass_create_db_req const *param)
 {
     // Service content flag
     uint8_t cfg_flag = BAS_CFG_FLAG_MANDATORY_MASK;
@@ -98,7 +93,7 @@ static int bass_create_db_req_handler(ke_msg_id_t const msgid,
 
             //Create BAS in the DB
             status = atts_svc_create_db(&bass_env.shdl[i], (uint8_t *)&cfg_flag, BAS_IDX_NB, NULL,
-                                        dest_id, &bas_att_db[0]);
+                                        TASK_BASS, &bas_att_db[0]);
 
             //Disable the service and set optional features
             if (status == PRF_ERR_OK)
@@ -132,6 +127,28 @@ static int bass_create_db_req_handler(ke_msg_id_t const msgid,
         status = PRF_ERR_INVALID_PARAM;
     }
 
+    return (status);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Handles reception of the @ref BASS_CREATE_DB_REQ message.
+ * The handler adds BAS into the database using value of the features param.
+ * @param[in] msgid Id of the message received (probably unused).
+ * @param[in] param Pointer to the parameters of the message.
+ * @param[in] dest_id ID of the receiving task instance (probably unused).
+ * @param[in] src_id ID of the sending task instance.
+ * @return If the message was consumed or not.
+ ****************************************************************************************
+ */
+static int bass_create_db_req_handler(ke_msg_id_t const msgid,
+                                      struct bass_create_db_req const *param,
+                                      ke_task_id_t const dest_id,
+                                      ke_task_id_t const src_id)
+{
+    //Database Creation Status
+    uint8_t status = bass_create_db(param);
+
     // Send confirmation to application
     struct bass_create_db_cfm * cfm = KE_MSG_ALLOC(BASS_CREATE_DB_CFM, src_id, TASK_BASS,
                                                    bass_create_db_cfm);
@@ -202,6 +202,8 @@ extern ke_state_t bass_state[BASS_IDX_MAX];
 
 extern void task_bass_desc_register(void);
 
+extern uint8_t bass_create_db(struct bass_create_db_req const *param);
+
 #endif // BLE_BATT_SERVER
 
 /// @} BASSTASK
@@ -339,6 +339,8 @@ static int blpc_rd_char_req_handler(ke_msg_id_t const msgid,
     uint16_t search_hdl = 0x0000;
     uint16_t shdl = 0x0000;
     uint16_t ehdl = 0x0000;
+    // Length of the value, 0 if unknown
+    uint8_t len = 0;
     // Get the address of the environment
     struct blpc_env_tag *blpc_env = PRF_CLIENT_GET_ENV(dest_id, blpc);
 
@@ -347,12 +349,17 @@ static int blpc_rd_char_req_handler(ke_msg_id_t const msgid,
         if((param->char_code & BLPC_DESC_MASK) == BLPC_DESC_MASK)
         {
             search_hdl = blpc_env->bps.descs[param->char_code & ~BLPC_DESC_MASK].desc_hdl;
+            len = PRF_CCC_DESC_LEN;
             shdl = blpc_env->bps.svc.shdl;
             ehdl = blpc_env->bps.svc.ehdl;
         }
         else
         {
             search_hdl = blpc_env->bps.chars[param->char_code].val_hdl;
+            if (param->char_code == BLPC_CHAR_BP_FEATURE)
+            {
+                len = sizeof(uint16_t);
+            }
             shdl = blpc_env->bps.svc.shdl;
             ehdl = blpc_env->bps.svc.ehdl;
         }
@@ -360,7 +367,7 @@ static int blpc_rd_char_req_handler(ke_msg_id_t const msgid,
         //check if handle is viable
         if (search_hdl != ATT_INVALID_SEARCH_HANDLE)
         {
-            prf_read_char_send(&(blpc_env->con_info), shdl, ehdl, search_hdl);
+            prf_read_char_send(&(blpc_env->con_info), shdl, ehdl, search_hdl, len);
         }
         else
         {
@@ -44,20 +44,14 @@
 
 /**
  ****************************************************************************************
- * @brief Handles reception of the @ref BLPS_CREATE_DB_REQ message.
- * The handler adds BPS into the database using the database
- * configuration value given in param.
- * @param[in] msgid Id of the message received (probably unused).
- * @param[in] param Pointer to the parameters of the message.
- * @param[in] dest_id ID of the receiving task instance (probably unused).
- * @param[in] src_id ID of the sending task instance.
- * @return If the message was consumed or not.
+ * @brief Create the BLPS attribute database.
+ * Used by the @ref BLPS_CREATE_DB_REQ handler, and directly by the application when
+ * the database is created without kernel messages.
+ * @param[in] param Pointer to the database configuration.
+ * @return Database creation status.
  ****************************************************************************************
  */
-static int blps_create_db_req_handler(ke_msg_id_t const msgid,
-                                      struct blps_create_db_req const *param,
-                                      ke_task_id_t const dest_id,
-                                      ke_task_id_t const src_id)
+uint8_t blps_create_db(struct blps_create_db_req const *param)
 {
     //Service Configuration Flag
     uint16_t cfg_flag = BLPS_MANDATORY_MASK;
@@ -82,7 +76,7 @@ static int blps_create_db_req_handler(ke_msg_id_t const msgid,
 
     //Add Service Into Database
     status = atts_svc_create_db(&blps_env.shdl, (uint8_t *)&cfg_flag, BPS_IDX_NB, NULL,
-                               dest_id, &blps_att_db[0]);
+                               TASK_BLPS, &blps_att_db[0]);
     //Disable BPS
     attsdb_svc_set_permission(blps_env.shdl, PERM(SVC, DISABLE));
 
@@ -94,6 +88,29 @@ static int blps_create_db_req_handler(ke_msg_id_t const msgid,
         ke_state_set(TASK_BLPS, BLPS_IDLE);
     }
 
+    return (status);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Handles reception of the @ref BLPS_CREATE_DB_REQ message.
+ * The handler adds BPS into the database using the database
+ * configuration value given in param.
+ * @param[in] msgid Id of the message received (probably unused).
+ * @param[in] param Pointer to the parameters of the message.
+ * @param[in] dest_id ID of the receiving task instance (probably unused).
+ * @param[in] src_id ID of the sending task instance.
+ * @return If the message was consumed or not.
+ ****************************************************************************************
+ */
+static int blps_create_db_req_handler(ke_msg_id_t const msgid,
+                                      struct blps_create_db_req const *param,
+                                      ke_task_id_t const dest_id,
+                                      ke_task_id_t const src_id)
+{
+    //Database Creation Status
+    uint8_t status = blps_create_db(param);
+
     //Send response to application
     struct blps_create_db_cfm * cfm = KE_MSG_ALLOC(BLPS_CREATE_DB_CFM, src_id,
                                                    TASK_BLPS, blps_create_db_cfm);
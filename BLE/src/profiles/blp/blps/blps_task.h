@@ -207,6 +207,8 @@ extern ke_state_t blps_state[BLPS_IDX_MAX];
 
 extern void task_blps_desc_register(void); 
 
+extern uint8_t blps_create_db(struct blps_create_db_req const *param);
+
 #endif /* #if BLE_BP_SENSOR */
 
 /// @} BLPSTASK
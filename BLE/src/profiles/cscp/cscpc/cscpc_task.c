@@ -161,6 +161,7 @@ static int cscpc_enable_cmd_handler(ke_msg_id_t const msgid,
 
             // Register in GATT for notifications/indications
             prf_register_atthdl2gatt(&cscpc_env->con_info, &cscpc_env->cscs.svc);
+            prf_ntf_register(&cscpc_env->con_info, cscpc_env->cscs.chars, CSCP_CSCS_CHAR_MAX, 0);
 
             // Send a complete event status to the application
             cscpc_send_cmp_evt(cscpc_env, CSCPC_ENABLE_OP_CODE, PRF_ERR_OK);
@@ -205,6 +206,8 @@ static int cscpc_read_cmd_handler(ke_msg_id_t const msgid,
     {
         // Attribute Handle
         uint16_t handle    = ATT_INVALID_SEARCH_HANDLE;
+        // Length of the value
+        uint8_t len        = 0;
         // Status
         uint8_t status     = PRF_ERR_OK;
 
@@ -229,24 +232,28 @@ static int cscpc_read_cmd_handler(ke_msg_id_t const msgid,
                     case (CSCPC_RD_CSC_FEAT):
                     {
                         handle = cscpc_env->cscs.chars[CSCP_CSCS_CSC_FEAT_CHAR].val_hdl;
+                        len    = sizeof(uint16_t);
                     } break;
 
                     // Read Sensor Location
                     case (CSCPC_RD_SENSOR_LOC):
                     {
                         handle = cscpc_env->cscs.chars[CSCP_CSCS_SENSOR_LOC_CHAR].val_hdl;
+                        len    = sizeof(uint8_t);
                     } break;
 
                     // Read CSC Measurement Characteristic Client Char. Cfg. Descriptor Value
                     case (CSCPC_RD_WR_CSC_MEAS_CFG):
                     {
                         handle = cscpc_env->cscs.descs[CSCPC_DESC_CSC_MEAS_CL_CFG].desc_hdl;
+                        len    = PRF_CCC_DESC_LEN;
                     } break;
 
                     // Read Unread Alert Characteristic Client Char. Cfg. Descriptor Value
                     case (CSCPC_RD_WR_SC_CTNL_PT_CFG):
                     {
                         handle = cscpc_env->cscs.descs[CSCPC_DESC_SC_CTNL_PT_CL_CFG].desc_hdl;
+                        len    = PRF_CCC_DESC_LEN;
                     } break;
 
                     default:
@@ -267,7 +274,7 @@ static int cscpc_read_cmd_handler(ke_msg_id_t const msgid,
 
                     // Send the read request
                     prf_read_char_send(&(cscpc_env->con_info), cscpc_env->cscs.svc.shdl,
-                                       cscpc_env->cscs.svc.ehdl, handle);
+                                       cscpc_env->cscs.svc.ehdl, handle, len);
 
                     // Go to the Busy state
                     ke_state_set(dest_id, CSCPC_BUSY);
@@ -804,6 +811,7 @@ static int gatt_cmp_evt_handler(ke_msg_id_t const msgid,
 
                         // Register in GATT for notifications/indications
                         prf_register_atthdl2gatt(&cscpc_env->con_info, &cscpc_env->cscs.svc);
+                        prf_ntf_register(&cscpc_env->con_info, cscpc_env->cscs.chars, CSCP_CSCS_CHAR_MAX, 0);
 
                         // Send the content of the service to the HL
                         struct cscpc_cscs_content_ind *ind = KE_MSG_ALLOC(CSCPC_CSCS_CONTENT_IND,
@@ -996,7 +1004,8 @@ static int gatt_handle_value_ntf_handler(ke_msg_id_t const msgid,
     // Get the address of the environment
     struct cscpc_env_tag *cscpc_env = PRF_CLIENT_GET_ENV(dest_id, cscpc);
 
-    if (cscpc_env != NULL)
+    if ((cscpc_env != NULL)
+     && (prf_ntf_char_get(param->conhdl, param->charhdl, dest_id) == CSCP_CSCS_CSC_MEAS_CHAR))
     {
         // Offset
         uint8_t offset = CSCP_CSC_MEAS_MIN_LEN;
@@ -110,18 +110,14 @@ static const struct atts_desc cscps_att_db[CSCS_IDX_NB] =
 
 /**
  ****************************************************************************************
- * @brief Handles reception of the @ref CSCPS_CREATE_DB_REQ message.
- * @param[in] msgid Id of the message received.
- * @param[in] param Pointer to the parameters of the message.
- * @param[in] dest_id ID of the receiving task instance
- * @param[in] src_id ID of the sending task instance.
- * @return If the message was consumed or not.
+ * @brief Create the CSCPS attribute database.
+ * Used by the @ref CSCPS_CREATE_DB_REQ handler, and directly by the application when
+ * the database is created without kernel messages.
+ * @param[in] param Pointer to the database configuration.
+ * @return Database creation status.
  ****************************************************************************************
  */
-static int cscps_create_db_req_handler(ke_msg_id_t const msgid,
-                                       struct cscps_create_db_req *param,
-                                       ke_task_id_t const dest_id,
-                                       ke_task_id_t const src_id)
+uint8_t cscps_create_db(struct cscps_create_db_req *param)
 {
     // Service Configuration Flag
     uint16_t cfg_flag = CSCPS_MANDATORY_MASK;
@@ -129,7 +125,7 @@ static int cscps_create_db_req_handler(ke_msg_id_t const msgid,
     uint8_t status;
 
     // Check if a Cycling Speed and Cadence service has already been added in the database
-    if (ke_state_get(dest_id) == CSCPS_DISABLED)
+    if (ke_state_get(TASK_CSCPS) == CSCPS_DISABLED)
     {
         /*
          * Check if the Sensor Location characteristic shall be added.
@@ -153,7 +149,7 @@ static int cscps_create_db_req_handler(ke_msg_id_t const msgid,
 
         // Add service in the database
         status = atts_svc_create_db(&cscps_env.shdl, (uint8_t *)&cfg_flag, CSCS_IDX_NB,
-                                    &cscps_env.hdl_offset[0], dest_id, &cscps_att_db[0]);
+                                    &cscps_env.hdl_offset[0], TASK_CSCPS, &cscps_att_db[0]);
 
         // Check if an error has occured
         if (status == ATT_ERR_NO_ERROR)
@@ -195,6 +191,27 @@ static int cscps_create_db_req_handler(ke_msg_id_t const msgid,
         status = PRF_ERR_REQ_DISALLOWED;
     }
 
+    return (status);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Handles reception of the @ref CSCPS_CREATE_DB_REQ message.
+ * @param[in] msgid Id of the message received.
+ * @param[in] param Pointer to the parameters of the message.
+ * @param[in] dest_id ID of the receiving task instance
+ * @param[in] src_id ID of the sending task instance.
+ * @return If the message was consumed or not.
+ ****************************************************************************************
+ */
+static int cscps_create_db_req_handler(ke_msg_id_t const msgid,
+                                       struct cscps_create_db_req *param,
+                                       ke_task_id_t const dest_id,
+                                       ke_task_id_t const src_id)
+{
+    //Database Creation Status
+    uint8_t status = cscps_create_db(param);
+
     // Send complete event message to the application
     cscps_send_cmp_evt(TASK_CSCPS, src_id, GAP_INVALID_CONHDL, CSCPS_CREATE_DB_OP_CODE, status);
 
@@ -277,6 +277,8 @@ extern ke_state_t cscps_state[CSCPS_IDX_MAX];
 
 extern void task_cscps_desc_register(void);
 
+extern uint8_t cscps_create_db(struct cscps_create_db_req *param);
+
 #endif //(BLE_CSC_SENSOR)
 
 /// @} CSCPSTASK
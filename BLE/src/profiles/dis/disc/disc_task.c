@@ -73,6 +73,13 @@ const struct prf_char_def disc_dis_char[DISC_CHAR_MAX] =
                                            ATT_CHAR_PROP_RD},
 };
 
+/// Lengths of the fixed size values, read together on a GATT queue, the strings are 0
+static const uint8_t disc_dis_char_len[DISC_CHAR_MAX] =
+{
+    [DISC_SYSTEM_ID_CHAR]               = 8,
+    [DISC_PNP_ID_CHAR]                  = 7,
+};
+
 /*
  * FUNCTION DEFINITIONS
  ****************************************************************************************
@@ -304,7 +311,7 @@ static int disc_rd_char_req_handler(ke_msg_id_t const msgid,
         if (search_hdl != ATT_INVALID_SEARCH_HANDLE)
         {
             prf_read_char_send(&(disc_env->con_info), disc_env->dis.svc.shdl,
-                               disc_env->dis.svc.ehdl, search_hdl);
+                               disc_env->dis.svc.ehdl, search_hdl, disc_dis_char_len[param->char_code]);
         }
         else
         {
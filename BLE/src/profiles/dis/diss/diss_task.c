@@ -40,10 +40,16 @@
  ****************************************************************************************
  */
 
-static int diss_create_db_req_handler(ke_msg_id_t const msgid,
-                                      struct diss_create_db_req const *param,
-                                      ke_task_id_t const dest_id,
-                                      ke_task_id_t const src_id)
+/**
+ ****************************************************************************************
+ * @brief Create the DISS attribute database.
+ * Used by the @ref DISS_CREATE_DB_REQ handler, and directly by the application when
+ * the database is created without kernel messages.
+ * @param[in] param Pointer to the database configuration.
+ * @return Database creation status.
+ ****************************************************************************************
+ */
+uint8_t diss_create_db(struct diss_create_db_req const *param)
 {
     //Service content flag
     uint32_t cfg_flag;
@@ -57,7 +63,7 @@ static int diss_create_db_req_handler(ke_msg_id_t const msgid,
     cfg_flag = diss_compute_cfg_flag(param->features);
 
     status = atts_svc_create_db(&diss_env.shdl, (uint8_t *)&cfg_flag, DIS_IDX_NB, &diss_env.att_tbl[0],
-                               dest_id, &diss_att_db[0]);
+                               TASK_DISS, &diss_att_db[0]);
 
     if (status == ATT_ERR_NO_ERROR)
     {
@@ -68,6 +74,17 @@ static int diss_create_db_req_handler(ke_msg_id_t const msgid,
         ke_state_set(TASK_DISS, DISS_IDLE);
     }
 
+    return (status);
+}
+
+static int diss_create_db_req_handler(ke_msg_id_t const msgid,
+                                      struct diss_create_db_req const *param,
+                                      ke_task_id_t const dest_id,
+                                      ke_task_id_t const src_id)
+{
+    //Database Creation Status
+    uint8_t status = diss_create_db(param);
+
     //Send response to application
     struct diss_create_db_cfm * cfm = KE_MSG_ALLOC(DISS_CREATE_DB_CFM, src_id, TASK_DISS,
                                                    diss_create_db_cfm);
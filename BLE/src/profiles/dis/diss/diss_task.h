@@ -149,6 +149,8 @@ extern ke_state_t diss_state[DISS_IDX_MAX];
 
 extern void task_diss_desc_register(void);
 
+extern uint8_t diss_create_db(struct diss_create_db_req const *param);
+
 #endif //BLE_DIS_SERVER
 
 /// @} DISSTASK
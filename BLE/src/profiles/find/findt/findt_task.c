@@ -40,20 +40,14 @@
 
 /**
  ****************************************************************************************
- * @brief Handles reception of the @ref FINDT_CREATE_DB_REQ message.
- * The handler adds IAS into the database using the database
- * configuration value given in param.
- * @param[in] msgid Id of the message received (probably unused).
- * @param[in] param Pointer to the parameters of the message.
- * @param[in] dest_id ID of the receiving task instance (probably unused).
- * @param[in] src_id ID of the sending task instance.
- * @return If the message was consumed or not.
+ * @brief Create the FINDT attribute database.
+ * Used by the @ref FINDT_CREATE_DB_REQ handler, and directly by the application when
+ * the database is created without kernel messages.
+ * @param[in] param Pointer to the database configuration.
+ * @return Database creation status.
  ****************************************************************************************
  */
-static int findt_create_db_req_handler(ke_msg_id_t const msgid,
-                                       struct findt_create_db_req const *param,
-                                       ke_task_id_t const dest_id,
-                                       ke_task_id_t const src_id)
+uint8_t findt_create_db(struct findt_create_db_req const *param)
 {
     //Service Configuration Flag
     uint8_t cfg_flag = FINDT_MANDATORY_MASK;
@@ -69,7 +63,7 @@ static int findt_create_db_req_handler(ke_msg_id_t const msgid,
 
     //Add Service Into Database
     status = atts_svc_create_db(&findt_env.shdl, (uint8_t *)&cfg_flag, FINDT_IAS_IDX_NB, NULL,
-                               dest_id, &findt_att_db[0]);
+                               TASK_FINDT, &findt_att_db[0]);
     //Disable IAS
     attsdb_svc_set_permission(findt_env.shdl, PERM(SVC, DISABLE));
 
@@ -80,6 +74,29 @@ static int findt_create_db_req_handler(ke_msg_id_t const msgid,
         ke_state_set(TASK_FINDT, FINDT_IDLE);
     }
 
+    return (status);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Handles reception of the @ref FINDT_CREATE_DB_REQ message.
+ * The handler adds IAS into the database using the database
+ * configuration value given in param.
+ * @param[in] msgid Id of the message received (probably unused).
+ * @param[in] param Pointer to the parameters of the message.
+ * @param[in] dest_id ID of the receiving task instance (probably unused).
+ * @param[in] src_id ID of the sending task instance.
+ * @return If the message was consumed or not.
+ ****************************************************************************************
+ */
+static int findt_create_db_req_handler(ke_msg_id_t const msgid,
+                                       struct findt_create_db_req const *param,
+                                       ke_task_id_t const dest_id,
+                                       ke_task_id_t const src_id)
+{
+    //Database Creation Status
+    uint8_t status = findt_create_db(param);
+
     //Send CFM to application
     struct findt_create_db_cfm * cfm = KE_MSG_ALLOC(FINDT_CREATE_DB_CFM, src_id,
                                                     TASK_FINDT, findt_create_db_cfm);
@@ -143,6 +143,8 @@ extern ke_state_t findt_state[FINDT_IDX_MAX];
 
 extern void task_findt_desc_register(void);
 
+extern uint8_t findt_create_db(struct findt_create_db_req const *param);
+
 #endif //BLE_FINDME_TARGET
 
 /// @} FINDTTASK
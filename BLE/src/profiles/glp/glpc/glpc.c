@@ -68,6 +68,7 @@ void glpc_enable_cfm_send(struct glpc_env_tag *glpc_env, struct prf_con_info *co
 
         // Register GLPC task in gatt for indication/notifications
         prf_register_atthdl2gatt(&glpc_env->con_info, &glpc_env->gls.svc);
+        prf_ntf_register(&glpc_env->con_info, glpc_env->gls.chars, GLPC_CHAR_MAX, 0);
 
         // Go to connected state
         ke_state_set(con_info->prf_id, GLPC_CONNECTED);
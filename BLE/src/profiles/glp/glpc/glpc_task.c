@@ -372,7 +372,7 @@ static int glpc_read_features_req_handler(ke_msg_id_t const msgid,
     {
         // read glucose sensor feature
         prf_read_char_send(&(glpc_env->con_info),  glpc_env->gls.svc.shdl,
-                glpc_env->gls.svc.ehdl,  glpc_env->gls.chars[GLPC_CHAR_FEATURE].val_hdl);
+                glpc_env->gls.svc.ehdl,  glpc_env->gls.chars[GLPC_CHAR_FEATURE].val_hdl, sizeof(uint16_t));
     }
     // send command response with error code
     else
@@ -722,57 +722,55 @@ static int gatt_handle_value_ntf_handler(ke_msg_id_t const msgid,
 {
     // Get the address of the environment
     struct glpc_env_tag *glpc_env = PRF_CLIENT_GET_ENV(dest_id, glpc);
+    // Characteristic of the notification, if the collector is running
+    uint8_t char_code = prf_ntf_char_get(param->conhdl, param->charhdl, dest_id);
 
-    // check if collector running
-    if(param->conhdl == glpc_env->con_info.conhdl)
+    // check if it's a Glucose measurement notification
+    if (char_code == GLPC_CHAR_MEAS)
     {
-        // check if it's a Glucose measurement notification
-        if (glpc_env->gls.chars[GLPC_CHAR_MEAS].val_hdl == param->charhdl)
-        {
-
-            // build a GLPC_MEAS_IND message with glucose measurement value
-            struct glpc_meas_ind * ind = KE_MSG_ALLOC(GLPC_MEAS_IND,
-                                                      glpc_env->con_info.appid, dest_id,
-                                                      glpc_meas_ind);
 
-            // retrieve connection handle
-            ind->conhdl = glpc_env->con_info.conhdl;
+        // build a GLPC_MEAS_IND message with glucose measurement value
+        struct glpc_meas_ind * ind = KE_MSG_ALLOC(GLPC_MEAS_IND,
+                                                  glpc_env->con_info.appid, dest_id,
+                                                  glpc_meas_ind);
 
-            // unpack Glucose measurement.
-            glpc_unpack_meas_value((uint8_t*) param->value, &(ind->meas_val),
-                                   &(ind->seq_num));
+        // retrieve connection handle
+        ind->conhdl = glpc_env->con_info.conhdl;
 
-            if(glpc_env->last_uuid_req == ATT_CHAR_REC_ACCESS_CTRL_PT)
-            {
-                // restart the timer; will destroy the link if it expires
-                ke_timer_set(GLPC_RACP_REQ_TIMEOUT, dest_id, GLPC_RACP_TIMEOUT);
-            }
+        // unpack Glucose measurement.
+        glpc_unpack_meas_value((uint8_t*) param->value, &(ind->meas_val),
+                               &(ind->seq_num));
 
-            ke_msg_send(ind);
-        }
-        // check if it's a Glucose measurement context notification
-        else if(glpc_env->gls.chars[GLPC_CHAR_MEAS_CTX].val_hdl == param->charhdl)
+        if(glpc_env->last_uuid_req == ATT_CHAR_REC_ACCESS_CTRL_PT)
         {
-            // build a GLPC_MEAS_CTX_IND message with glucose measurement context value
-            struct glpc_meas_ctx_ind * ind = KE_MSG_ALLOC(GLPC_MEAS_CTX_IND,
-                                                          glpc_env->con_info.appid, dest_id,
-                                                          glpc_meas_ctx_ind);
+            // restart the timer; will destroy the link if it expires
+            ke_timer_set(GLPC_RACP_REQ_TIMEOUT, dest_id, GLPC_RACP_TIMEOUT);
+        }
 
-            // retrieve connection handle
-            ind->conhdl = glpc_env->con_info.conhdl;
+        ke_msg_send(ind);
+    }
+    // check if it's a Glucose measurement context notification
+    else if (char_code == GLPC_CHAR_MEAS_CTX)
+    {
+        // build a GLPC_MEAS_CTX_IND message with glucose measurement context value
+        struct glpc_meas_ctx_ind * ind = KE_MSG_ALLOC(GLPC_MEAS_CTX_IND,
+                                                      glpc_env->con_info.appid, dest_id,
+                                                      glpc_meas_ctx_ind);
 
-            // unpack Glucose measurement context.
-            glpc_unpack_meas_ctx_value((uint8_t*) param->value, &(ind->ctx), &(ind->seq_num));
+        // retrieve connection handle
+        ind->conhdl = glpc_env->con_info.conhdl;
 
+        // unpack Glucose measurement context.
+        glpc_unpack_meas_ctx_value((uint8_t*) param->value, &(ind->ctx), &(ind->seq_num));
 
-            if(glpc_env->last_uuid_req == ATT_CHAR_REC_ACCESS_CTRL_PT)
-            {
-                // restart the timer; will destroy the link if it expires
-                ke_timer_set(GLPC_RACP_REQ_TIMEOUT, dest_id, GLPC_RACP_TIMEOUT);
-            }
 
-            ke_msg_send(ind);
+        if(glpc_env->last_uuid_req == ATT_CHAR_REC_ACCESS_CTRL_PT)
+        {
+            // restart the timer; will destroy the link if it expires
+            ke_timer_set(GLPC_RACP_REQ_TIMEOUT, dest_id, GLPC_RACP_TIMEOUT);
         }
+
+        ke_msg_send(ind);
     }
 
     return (KE_MSG_CONSUMED);
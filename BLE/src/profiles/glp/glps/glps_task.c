@@ -115,20 +115,14 @@ static const struct atts_desc glps_att_db[GLS_IDX_NB] =
 
 /**
  ****************************************************************************************
- * @brief Handles reception of the @ref GLPS_CREATE_DB_REQ message.
- * The handler adds GLS into the database using the database
- * configuration value given in param.
- * @param[in] msgid Id of the message received (probably unused).
- * @param[in] param Pointer to the parameters of the message.
- * @param[in] dest_id ID of the receiving task instance (probably unused).
- * @param[in] src_id ID of the sending task instance.
- * @return If the message was consumed or not.
+ * @brief Create the GLPS attribute database.
+ * Used by the @ref GLPS_CREATE_DB_REQ handler, and directly by the application when
+ * the database is created without kernel messages.
+ * @param[in] param Pointer to the database configuration.
+ * @return Database creation status.
  ****************************************************************************************
  */
-static int glps_create_db_req_handler(ke_msg_id_t const msgid,
-                                      struct glps_create_db_req const *param,
-                                      ke_task_id_t const dest_id,
-                                      ke_task_id_t const src_id)
+uint8_t glps_create_db(struct glps_create_db_req const *param)
 {
     //Service Configuration Flag
     uint16_t cfg_flag = GLPS_MANDATORY_MASK;
@@ -158,7 +152,7 @@ static int glps_create_db_req_handler(ke_msg_id_t const msgid,
 
     //Add Service Into Database
     status = atts_svc_create_db(&glps_env.shdl, (uint8_t *)&cfg_flag, GLS_IDX_NB, NULL,
-                               dest_id, &glps_att_db[0]);
+                               TASK_GLPS, &glps_att_db[0]);
     //Disable GLS
     attsdb_svc_set_permission(glps_env.shdl, PERM(SVC, DISABLE));
 
@@ -169,6 +163,29 @@ static int glps_create_db_req_handler(ke_msg_id_t const msgid,
         ke_state_set(TASK_GLPS, GLPS_IDLE);
     }
 
+    return (status);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Handles reception of the @ref GLPS_CREATE_DB_REQ message.
+ * The handler adds GLS into the database using the database
+ * configuration value given in param.
+ * @param[in] msgid Id of the message received (probably unused).
+ * @param[in] param Pointer to the parameters of the message.
+ * @param[in] dest_id ID of the receiving task instance (probably unused).
+ * @param[in] src_id ID of the sending task instance.
+ * @return If the message was consumed or not.
+ ****************************************************************************************
+ */
+static int glps_create_db_req_handler(ke_msg_id_t const msgid,
+                                      struct glps_create_db_req const *param,
+                                      ke_task_id_t const dest_id,
+                                      ke_task_id_t const src_id)
+{
+    //Database Creation Status
+    uint8_t status = glps_create_db(param);
+
     //Send response to application
     struct glps_create_db_cfm * cfm = KE_MSG_ALLOC(GLPS_CREATE_DB_CFM, src_id,
                                                    TASK_GLPS, glps_create_db_cfm);
@@ -250,6 +250,8 @@ extern ke_state_t glps_state[GLPS_IDX_MAX];
 
 extern void task_glps_desc_register(void);
 
+extern uint8_t glps_create_db(struct glps_create_db_req const *param);
+
 #endif /* #if BLE_GL_SENSOR */
 
 /// @} GLPSTASK
@@ -70,6 +70,14 @@ const struct prf_char_desc_def hogpbh_hids_char_desc[HOGPBH_DESC_MAX] =
     [HOGPBH_DESC_BOOT_MOUSE_IN_REPORT_CFG] = {ATT_DESC_CLIENT_CHAR_CFG, ATT_OPTIONAL, HOGPBH_CHAR_BOOT_MOUSE_IN_REPORT},
 };
 
+/// Lengths of the HID Service values, read together on a GATT queue, the mouse report is 0
+static const uint8_t hogpbh_hids_char_len[HOGPBH_CHAR_MAX] =
+{
+    [HOGPBH_CHAR_PROTO_MODE]             = 1,
+    [HOGPBH_CHAR_BOOT_KB_IN_REPORT]      = 8,
+    [HOGPBH_CHAR_BOOT_KB_OUT_REPORT]     = 1,
+};
+
 /*
  * GLOBAL FUNCTIONS DEFINITIONS
  ****************************************************************************************
@@ -195,6 +203,8 @@ static int hogpbh_rd_char_req_handler(ke_msg_id_t const msgid,
     uint8_t status = PRF_ERR_OK;
     // Attribute handle
     uint16_t search_hdl = ATT_INVALID_SEARCH_HANDLE;
+    // Length of the value, 0 if unknown
+    uint8_t len = 0;
     // Get the address of the environment
     struct hogpbh_env_tag *hogpbh_env = PRF_CLIENT_GET_ENV(dest_id, hogpbh);
 
@@ -209,18 +219,20 @@ static int hogpbh_rd_char_req_handler(ke_msg_id_t const msgid,
            ((param->char_code & ~HOGPBH_DESC_MASK) < HOGPBH_DESC_MASK))
         {
             search_hdl = hogpbh_env->hids[param->hids_nb].descs[param->char_code & ~HOGPBH_DESC_MASK].desc_hdl;
+            len = PRF_CCC_DESC_LEN;
         }
         // Characteristic
         else if (param->char_code < HOGPBH_CHAR_MAX)
         {
             search_hdl = hogpbh_env->hids[param->hids_nb].chars[param->char_code].val_hdl;
+            len = hogpbh_hids_char_len[param->char_code];
         }
 
         // Check if handle is viable
         if (search_hdl != ATT_INVALID_SEARCH_HANDLE)
         {
             prf_read_char_send(&(hogpbh_env->con_info), hogpbh_env->hids[param->hids_nb].svc.shdl,
-                               hogpbh_env->hids[param->hids_nb].svc.ehdl, search_hdl);
+                               hogpbh_env->hids[param->hids_nb].svc.ehdl, search_hdl, len);
 
             // Save the service instance number
             hogpbh_env->last_svc_inst_req  = param->hids_nb;
@@ -32,6 +32,7 @@
 #if (BLE_HID_DEVICE)
 #include "hogp_common.h"
 #include "prf_types.h"
+#include "prf_utils.h"
 
 /*
  * DEFINES
@@ -192,6 +193,12 @@ struct hogpd_env_tag
 
     /// Number of HIDS added in the database
     uint8_t hids_nb;
+
+    #if (QN_LONG_WRITE)
+    /// Report written with prepared writes
+    struct prf_long_wr report_wr;
+    uint8_t report_wr_value[HOGPD_REPORT_MAX_LEN];
+    #endif
 };
 
 /// Database Creation Service Instance Configuration structure
@@ -58,19 +58,14 @@
 
 /**
  ****************************************************************************************
- * @brief Handles reception of the @ref HOGPD_CREATE_DB_REQ message.
- * The handler adds BAS into the database using value of the features param.
- * @param[in] msgid Id of the message received (probably unused).
- * @param[in] param Pointer to the parameters of the message.
- * @param[in] dest_id ID of the receiving task instance (probably unused).
- * @param[in] src_id ID of the sending task instance.
- * @return If the message was consumed or not.
+ * @brief Create the HOGPD attribute database.
+ * Used by the @ref HOGPD_CREATE_DB_REQ handler, and directly by the application when
+ * the database is created without kernel messages.
+ * @param[in] param Pointer to the database configuration.
+ * @return Database creation status.
  ****************************************************************************************
  */
-static int hogpd_create_db_req_handler(ke_msg_id_t const msgid,
-                                       struct hogpd_create_db_req const *param,
-                                       ke_task_id_t const dest_id,
-                                       ke_task_id_t const src_id)
+uint8_t hogpd_create_db(struct hogpd_create_db_req const *param)
 {
     // Service content flag
     uint64_t cfg_flag = HIDS_CFG_FLAG_MANDATORY_MASK;
@@ -193,7 +188,7 @@ static int hogpd_create_db_req_handler(ke_msg_id_t const msgid,
                 //---------------------------------------------------------------------
                 // Add Service in the Database
                 //---------------------------------------------------------------------
-                status = attsdb_add_service(&hogpd_env.shdl[i], dest_id, nb_att, 0, total_size);
+                status = attsdb_add_service(&hogpd_env.shdl[i], TASK_HOGPD, nb_att, 0, total_size);
 
                 //---------------------------------------------------------------------
                 // Add Attributes
@@ -407,6 +402,28 @@ static int hogpd_create_db_req_handler(ke_msg_id_t const msgid,
         status = PRF_ERR_INVALID_PARAM;
     }
 
+    return (status);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Handles reception of the @ref HOGPD_CREATE_DB_REQ message.
+ * The handler adds BAS into the database using value of the features param.
+ * @param[in] msgid Id of the message received (probably unused).
+ * @param[in] param Pointer to the parameters of the message.
+ * @param[in] dest_id ID of the receiving task instance (probably unused).
+ * @param[in] src_id ID of the sending task instance.
+ * @return If the message was consumed or not.
+ ****************************************************************************************
+ */
+static int hogpd_create_db_req_handler(ke_msg_id_t const msgid,
+                                       struct hogpd_create_db_req const *param,
+                                       ke_task_id_t const dest_id,
+                                       ke_task_id_t const src_id)
+{
+    //Database Creation Status
+    uint8_t status = hogpd_create_db(param);
+
     // Send confirmation to application
     struct hogpd_create_db_cfm * cfm = KE_MSG_ALLOC(HOGPD_CREATE_DB_CFM, src_id, TASK_HOGPD,
                                                     hogpd_create_db_cfm);
@@ -649,6 +666,29 @@ static int hogpd_boot_report_upd_req_handler(ke_msg_id_t const msgid,
     return (KE_MSG_CONSUMED);
 }
 
+/**
+ ****************************************************************************************
+ * @brief Inform the application about a written report value.
+ ****************************************************************************************
+ */
+static void hogpd_report_ind_send(uint8_t hids_nb, uint8_t report_nb, uint8_t const *report,
+                                  atts_size_t report_length)
+{
+    struct hogpd_report_info * ind = KE_MSG_ALLOC_DYN(HOGPD_REPORT_IND,
+                                                      hogpd_env.con_info.appid, TASK_HOGPD,
+                                                      hogpd_report_info,
+                                                      report_length);
+
+    co_write16p(&ind->conhdl, hogpd_env.con_info.conhdl);
+    ind->hids_nb        = hids_nb;
+    ind->report_nb      = report_nb;
+
+    ind->report_length = report_length;
+    memcpy(&ind->report, report, report_length);
+
+    ke_msg_send(ind);
+}
+
 /**
  ****************************************************************************************
  * @brief Handles reception of the @ref GATT_WRITE_CMD_IND message.
@@ -775,6 +815,16 @@ static int gatt_write_cmd_ind_handler(ke_msg_id_t const msgid,
 
                 // Report Characteristic
                 case (HOGPD_REPORT_CHAR):
+                #if (QN_LONG_WRITE)
+                    // The report goes to the database once all its segments are in
+                    status = prf_long_wr_ind(&hogpd_env.report_wr, hogpd_env.report_wr_value, HOGPD_REPORT_MAX_LEN,
+                                             param, &report, &report_length);
+                    if (report != NULL)
+                    {
+                        attsdb_att_set_value(param->handle, report_length, report);
+                        hogpd_report_ind_send(hids_nb, report_nb, report, report_length);
+                    }
+                #else
                     if ((param->length + param->offset) <= HOGPD_REPORT_MAX_LEN)
                     {
                         // First part of the Report value
@@ -795,26 +845,14 @@ static int gatt_write_cmd_ind_handler(ke_msg_id_t const msgid,
                             // Get complete report value and length
                             attsdb_att_get_value(param->handle, &report_length, &report);
 
-                            // Inform APP about the written report value
-                            struct hogpd_report_info * ind = KE_MSG_ALLOC_DYN(HOGPD_REPORT_IND,
-                                                                              hogpd_env.con_info.appid, TASK_HOGPD,
-                                                                              hogpd_report_info,
-                                                                              report_length);
-
-                            co_write16p(&ind->conhdl, hogpd_env.con_info.conhdl);
-                            ind->hids_nb        = hids_nb;
-                            ind->report_nb      = report_nb;
-
-                            ind->report_length = report_length;
-                            memcpy(&ind->report, report, report_length);
-
-                            ke_msg_send(ind);
+                            hogpd_report_ind_send(hids_nb, report_nb, report, report_length);
                         }
                     }
                     else
                     {
                         status = PRF_APP_ERROR;
                     }
+                #endif
                     break;
             }
         }
@@ -269,6 +269,8 @@ extern ke_state_t hogpd_state[HOGPD_IDX_MAX];
 
 extern void task_hogpd_desc_register(void);
 
+extern uint8_t hogpd_create_db(struct hogpd_create_db_req const *param);
+
 #endif /* #if BLE_HID_DEVICE */
 
 /// @} HOGPDTASK
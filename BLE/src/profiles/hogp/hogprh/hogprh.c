@@ -78,6 +78,8 @@ void hogprh_enable_cfm_send(struct hogprh_env_tag *hogprh_env, struct prf_con_in
 
             // Register HOGPRH task in gatt for indication/notifications
             prf_register_atthdl2gatt(&hogprh_env->con_info, &hogprh_env->hids[i].svc);
+            prf_ntf_register(&hogprh_env->con_info, hogprh_env->hids[i].chars, HOGPRH_CHAR_MAX,
+                             i * HOGPRH_CHAR_MAX);
         }
 
         // Go to connected state
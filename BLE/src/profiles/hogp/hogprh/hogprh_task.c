@@ -188,6 +188,8 @@ static int hogprh_rd_char_req_handler(ke_msg_id_t const msgid,
 {
     // Attribute handle
     uint16_t search_hdl = ATT_INVALID_SEARCH_HANDLE;
+    // Length of the value, 0 for the reports and the Report Map
+    uint8_t len = 0;
     // Status
     uint8_t status = PRF_ERR_OK;
     // Get the address of the environment
@@ -204,6 +206,9 @@ static int hogprh_rd_char_req_handler(ke_msg_id_t const msgid,
         // Descriptor
         if((param->read_code & HOGPRH_DESC_MASK) == HOGPRH_DESC_MASK)
         {
+            // Report Reference and External Report Reference hold 2 bytes as a client configuration
+            len = PRF_CCC_DESC_LEN;
+
             // If Descriptor is linked to a Report Characteristic (Report Ref or Client Char. Cfg)
             if ((param->read_code == HOGPRH_RD_HIDS_REPORT_REF) || (param->read_code == HOGPRH_RD_WR_HIDS_REPORT_CFG))
             {
@@ -227,15 +232,29 @@ static int hogprh_rd_char_req_handler(ke_msg_id_t const msgid,
             {
                 // For characteristics, read_code == char_code
                 search_hdl = hogprh_env->hids[param->hids_nb].chars[param->read_code].val_hdl;
+
+                if (param->read_code == HOGPRH_RD_HIDS_HID_INFO)
+                {
+                    len = 4;
+                }
+                else if (param->read_code == HOGPRH_RD_WR_HIDS_PROTOCOL_MODE)
+                {
+                    len = sizeof(uint8_t);
+                }
             }
         }
 
         // Check if handle is viable
         if (search_hdl != ATT_INVALID_SEARCH_HANDLE)
         {
-            // Send Read Request
+            // Send Read Request, the Report Map may need several long reads
+            #if (QN_GATT_QUEUE && QN_LONG_WRITE)
+            if ((param->read_code != HOGPRH_RD_HIDS_REPORT_MAP)
+             || !prf_gattq_read_long(dest_id, hogprh_env->con_info.conhdl, search_hdl,
+                                     HOGPRH_REPORT_MAP_MAX_LEN))
+            #endif
             prf_read_char_send(&(hogprh_env->con_info), hogprh_env->hids[param->hids_nb].svc.shdl,
-                               hogprh_env->hids[param->hids_nb].svc.ehdl, search_hdl);
+                               hogprh_env->hids[param->hids_nb].svc.ehdl, search_hdl, len);
 
             // Save the service instance number
             hogprh_env->last_svc_inst_req             = param->hids_nb;
@@ -1124,55 +1143,45 @@ static int gatt_handle_value_ntf_handler(ke_msg_id_t const msgid,
 {
     // HIDS Instance, Report Instance
     uint8_t hids_nb, report_nb;
-    // Attribute found
-    uint8_t found = PRF_APP_ERROR;
+    // Characteristic code, HOGPRH_CHAR_MAX per HIDS instance
+    uint8_t char_code = prf_ntf_char_get(param->conhdl, param->charhdl, dest_id);
     // Get the address of the environment
     struct hogprh_env_tag *hogprh_env = PRF_CLIENT_GET_ENV(dest_id, hogprh);
 
-    if (param->conhdl == hogprh_env->con_info.conhdl)
+    if ((char_code != PRF_NTF_CHAR_NONE) && ((char_code % HOGPRH_CHAR_MAX) >= HOGPRH_CHAR_REPORT))
     {
-        // HIDS instance is unknown.
-        for (hids_nb = 0; ((hids_nb < hogprh_env->hids_nb) && (found != PRF_ERR_OK)); hids_nb++)
+        hids_nb = char_code / HOGPRH_CHAR_MAX;
+        report_nb = (char_code % HOGPRH_CHAR_MAX) - HOGPRH_CHAR_REPORT;
+
+        // Check if size of the data is lower than [ATT_MTU-3]
+        if (param->size < (attm_get_mtu(gap_get_rec_idx(hogprh_env->con_info.conhdl)) - 3))
         {
-            for (report_nb = 0; ((report_nb < HOGPRH_NB_REPORT_INST_MAX) && (found != PRF_ERR_OK)); report_nb++)
-            {
-                // Report Char.
-                if (param->charhdl == hogprh_env->hids[hids_nb].chars[HOGPRH_CHAR_REPORT + report_nb].val_hdl)
-                {
-                    found = PRF_ERR_OK;
+            struct hogprh_report_ind *ind = KE_MSG_ALLOC_DYN(HOGPRH_REPORT_IND,
+                                                             hogprh_env->con_info.appid, dest_id,
+                                                             hogprh_report_ind,
+                                                             param->size);
 
-                    // Check if size of the data is lower than [ATT_MTU-3]
-                    if (param->size < (attm_get_mtu(gap_get_rec_idx(hogprh_env->con_info.conhdl)) - 3))
-                    {
-                        struct hogprh_report_ind *ind = KE_MSG_ALLOC_DYN(HOGPRH_REPORT_IND,
-                                                                         hogprh_env->con_info.appid, dest_id,
-                                                                         hogprh_report_ind,
-                                                                         param->size);
-
-                        ind->conhdl             = hogprh_env->con_info.conhdl;
-                        ind->hids_nb            = hids_nb;
-                        ind->report_nb          = report_nb;
-                        ind->report_length      = param->size;
-                        ind->ind_type           = HOGPRH_IND_NTF;
-                        memcpy(&ind->report[0], &param->value[0], param->size);
-
-                        ke_msg_send(ind);
-                    }
-                    else
-                    {
-                        // Send a Read Request in order to get the whole report value.
-                        prf_read_char_send(&(hogprh_env->con_info), hogprh_env->hids[hids_nb].svc.shdl,
-                                           hogprh_env->hids[hids_nb].svc.ehdl, param->charhdl);
-
-                        // Save the service instance number
-                        hogprh_env->last_svc_inst_req             = hids_nb;
-                        // Save the report char instance number
-                        hogprh_env->last_report_char_inst_req     = report_nb;
-                        // Save the attribute read code
-                        hogprh_env->last_char_code                = HOGPRH_RD_WR_HIDS_REPORT;
-                    }
-                }
-            }
+            ind->conhdl             = hogprh_env->con_info.conhdl;
+            ind->hids_nb            = hids_nb;
+            ind->report_nb          = report_nb;
+            ind->report_length      = param->size;
+            ind->ind_type           = HOGPRH_IND_NTF;
+            memcpy(&ind->report[0], &param->value[0], param->size);
+
+            ke_msg_send(ind);
+        }
+        else
+        {
+            // Send a Read Request in order to get the whole report value.
+            prf_read_char_send(&(hogprh_env->con_info), hogprh_env->hids[hids_nb].svc.shdl,
+                               hogprh_env->hids[hids_nb].svc.ehdl, param->charhdl, 0);
+
+            // Save the service instance number
+            hogprh_env->last_svc_inst_req             = hids_nb;
+            // Save the report char instance number
+            hogprh_env->last_report_char_inst_req     = report_nb;
+            // Save the attribute read code
+            hogprh_env->last_char_code                = HOGPRH_RD_WR_HIDS_REPORT;
         }
     }
 
@@ -47,7 +47,8 @@
  */
 
 /// maximum number of RR-Interval supported
-#define HRS_MAX_RR_INTERVAL  (4)
+/// (flags + 8-bit Heart Rate + 9 RR-Intervals fill one notification at the default MTU)
+#define HRS_MAX_RR_INTERVAL  (9)
 
 /// Heart Rate Control Point Not Supported error code
 #define HRS_ERR_HR_CNTL_POINT_NOT_SUPPORTED   (0x80)
@@ -135,7 +136,7 @@ struct hrs_hr_meas
 {
     /// Flag
     uint8_t flags;
-    /// RR-Interval numbers (max 4)
+    /// RR-Interval numbers (max HRS_MAX_RR_INTERVAL)
     uint8_t nb_rr_interval;
     /// RR-Intervals
     uint16_t rr_intervals[HRS_MAX_RR_INTERVAL];
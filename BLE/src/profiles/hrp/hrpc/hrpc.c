@@ -66,6 +66,7 @@ void hrpc_enable_cfm_send(struct hrpc_env_tag *hrpc_env, struct prf_con_info *co
 
         //register HRPC task in gatt for indication/notifications
         prf_register_atthdl2gatt(&hrpc_env->con_info, &hrpc_env->hrs.svc);
+        prf_ntf_register(&hrpc_env->con_info, hrpc_env->hrs.chars, HRPC_CHAR_MAX, 0);
 
         // Go to connected state
         ke_state_set(hrpc_env->con_info.prf_id, HRPC_CONNECTED);
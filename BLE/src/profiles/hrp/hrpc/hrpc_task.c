@@ -64,6 +64,12 @@ const struct prf_char_desc_def hrpc_hrs_char_desc[HRPC_DESC_MAX] =
     [HRPC_DESC_HR_MEAS_CLI_CFG] = {ATT_DESC_CLIENT_CHAR_CFG, ATT_MANDATORY, HRPC_CHAR_HR_MEAS},
 };
 
+/// Lengths of the readable values, read together on a GATT queue
+static const uint8_t hrpc_hrs_char_len[HRPC_CHAR_MAX] =
+{
+    [HRPC_CHAR_BODY_SENSOR_LOCATION] = 1,
+};
+
 /*
  * LOCAL FUNCTIONS DEFINITIONS
  ****************************************************************************************
@@ -318,6 +324,8 @@ static int hrpc_rd_char_req_handler(ke_msg_id_t const msgid,
                                         ke_task_id_t const src_id)
 {
     uint16_t search_hdl = ATT_INVALID_SEARCH_HANDLE;
+    // Length of the value, 0 if unknown
+    uint8_t len = 0;
     // Get the address of the environment
     struct hrpc_env_tag *hrpc_env = PRF_CLIENT_GET_ENV(dest_id, hrpc);
 
@@ -327,17 +335,19 @@ static int hrpc_rd_char_req_handler(ke_msg_id_t const msgid,
            ((param->char_code & ~HRPC_DESC_MASK) < HRPC_DESC_MAX))
         {
             search_hdl = hrpc_env->hrs.descs[param->char_code & ~HRPC_DESC_MASK].desc_hdl;
+            len = PRF_CCC_DESC_LEN;
         }
         else if (param->char_code < HRPC_CHAR_MAX)
         {
             search_hdl = hrpc_env->hrs.chars[param->char_code].val_hdl;
+            len = hrpc_hrs_char_len[param->char_code];
         }
 
         //check if handle is viable
         if (search_hdl != ATT_INVALID_SEARCH_HANDLE)
         {
             hrpc_env->last_char_code = param->char_code;
-            prf_read_char_send(&(hrpc_env->con_info), hrpc_env->hrs.svc.shdl, hrpc_env->hrs.svc.ehdl, search_hdl);
+            prf_read_char_send(&(hrpc_env->con_info), hrpc_env->hrs.svc.shdl, hrpc_env->hrs.svc.ehdl, search_hdl, len);
         }
         else
         {
@@ -549,22 +559,19 @@ static int gatt_handle_value_ntf_handler(ke_msg_id_t const msgid,
     // Get the address of the environment
     struct hrpc_env_tag *hrpc_env = PRF_CLIENT_GET_ENV(dest_id, hrpc);
 
-    if(param->conhdl == hrpc_env->con_info.conhdl)
+    if (prf_ntf_char_get(param->conhdl, param->charhdl, dest_id) == HRPC_CHAR_HR_MEAS)
     {
-        if(param->charhdl == hrpc_env->hrs.chars[HRPC_CHAR_HR_MEAS].val_hdl)
-        {
-            //build a HRPC_HR_MEAS_IND message with stable heart rate value code.
-            struct hrpc_meas_ind * ind = KE_MSG_ALLOC(HRPC_HR_MEAS_IND,
-                                                      hrpc_env->con_info.appid, dest_id,
-                                                      hrpc_meas_ind);
-            // retrieve connection handle
-            ind->conhdl = hrpc_env->con_info.conhdl;
+        //build a HRPC_HR_MEAS_IND message with stable heart rate value code.
+        struct hrpc_meas_ind * ind = KE_MSG_ALLOC(HRPC_HR_MEAS_IND,
+                                                  hrpc_env->con_info.appid, dest_id,
+                                                  hrpc_meas_ind);
+        // retrieve connection handle
+        ind->conhdl = hrpc_env->con_info.conhdl;
 
-            // unpack heart rate measurement.
-            hrpc_unpack_meas_value(&(ind->meas_val), (uint8_t*) param->value, param->size);
+        // unpack heart rate measurement.
+        hrpc_unpack_meas_value(&(ind->meas_val), (uint8_t*) param->value, param->size);
 
-            ke_msg_send(ind);
-        }
+        ke_msg_send(ind);
     }
     return (KE_MSG_CONSUMED);
 }
@@ -159,7 +159,8 @@ uint8_t hrps_pack_meas_value(uint8_t *packed_hr, const struct hrs_hr_meas* pmeas
 
     if ((pmeas_val->flags & HRS_FLAG_RR_INTERVAL_PRESENT) == HRS_FLAG_RR_INTERVAL_PRESENT)
     {
-        for(i = 0 ; (i < (pmeas_val->nb_rr_interval)) && (i < (HRS_MAX_RR_INTERVAL)) ; i++)
+        for(i = 0 ; (i < (pmeas_val->nb_rr_interval)) && (i < (HRS_MAX_RR_INTERVAL))
+                    && ((cursor + 2) <= HRPS_HT_MEAS_MAX_LEN) ; i++)
         {
             // RR-Intervals
             co_write16p(packed_hr + cursor, pmeas_val->rr_intervals[i]);
@@ -60,7 +60,8 @@
  ****************************************************************************************
  */
 
-#define HRPS_HT_MEAS_MAX_LEN            (5 + (2 * HRS_MAX_RR_INTERVAL))
+/// Heart Rate Measurement is limited to the payload of one notification
+#define HRPS_HT_MEAS_MAX_LEN            (ATT_DEFAULT_MTU - 3)
 
 #define HRPS_MANDATORY_MASK             (0x0F)
 #define HRPS_BODY_SENSOR_LOC_MASK       (0x30)
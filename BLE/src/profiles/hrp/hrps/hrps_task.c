@@ -44,20 +44,14 @@
 
 /**
  ****************************************************************************************
- * @brief Handles reception of the @ref HRPS_CREATE_DB_REQ message.
- * The handler adds HRS into the database using the database
- * configuration value given in param.
- * @param[in] msgid Id of the message received (probably unused).
- * @param[in] param Pointer to the parameters of the message.
- * @param[in] dest_id ID of the receiving task instance (probably unused).
- * @param[in] src_id ID of the sending task instance.
- * @return If the message was consumed or not.
+ * @brief Create the HRPS attribute database.
+ * Used by the @ref HRPS_CREATE_DB_REQ handler, and directly by the application when
+ * the database is created without kernel messages.
+ * @param[in] param Pointer to the database configuration.
+ * @return Database creation status.
  ****************************************************************************************
  */
-static int hrps_create_db_req_handler(ke_msg_id_t const msgid,
-                                      struct hrps_create_db_req const *param,
-                                      ke_task_id_t const dest_id,
-                                      ke_task_id_t const src_id)
+uint8_t hrps_create_db(struct hrps_create_db_req const *param)
 {
     //Service Configuration Flag
     uint8_t cfg_flag = HRPS_MANDATORY_MASK;
@@ -84,7 +78,7 @@ static int hrps_create_db_req_handler(ke_msg_id_t const msgid,
 
     //Add Service Into Database
     status = atts_svc_create_db(&hrps_env.shdl, (uint8_t *)&cfg_flag, HRS_IDX_NB, NULL,
-                               dest_id, &hrps_att_db[0]);
+                               TASK_HRPS, &hrps_att_db[0]);
     //Disable HRS
     attsdb_svc_set_permission(hrps_env.shdl, PERM(SVC, DISABLE));
 
@@ -95,6 +89,29 @@ static int hrps_create_db_req_handler(ke_msg_id_t const msgid,
         ke_state_set(TASK_HRPS, HRPS_IDLE);
     }
 
+    return (status);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Handles reception of the @ref HRPS_CREATE_DB_REQ message.
+ * The handler adds HRS into the database using the database
+ * configuration value given in param.
+ * @param[in] msgid Id of the message received (probably unused).
+ * @param[in] param Pointer to the parameters of the message.
+ * @param[in] dest_id ID of the receiving task instance (probably unused).
+ * @param[in] src_id ID of the sending task instance.
+ * @return If the message was consumed or not.
+ ****************************************************************************************
+ */
+static int hrps_create_db_req_handler(ke_msg_id_t const msgid,
+                                      struct hrps_create_db_req const *param,
+                                      ke_task_id_t const dest_id,
+                                      ke_task_id_t const src_id)
+{
+    //Database Creation Status
+    uint8_t status = hrps_create_db(param);
+
     //Send response to application
     struct hrps_create_db_cfm * cfm = KE_MSG_ALLOC(HRPS_CREATE_DB_CFM, src_id,
                                                    TASK_HRPS, hrps_create_db_cfm);
@@ -196,6 +196,8 @@ extern ke_state_t hrps_state[HRPS_IDX_MAX];
 
 extern void task_hrps_desc_register(void);
 
+extern uint8_t hrps_create_db(struct hrps_create_db_req const *param);
+
 #endif /* #if BLE_HR_SENSOR */
 
 /// @} HRPSTASK
@@ -65,6 +65,21 @@ const struct prf_char_desc_def htpc_hts_char_desc[HTPC_DESC_HTS_MAX] =
     [HTPC_DESC_HTS_MEAS_INTV_VAL_RGE]   = {ATT_DESC_VALID_RANGE,         ATT_OPTIONAL,    HTPC_CHAR_HTS_MEAS_INTV},
 };
 
+/// Lengths of the readable values and descriptors, read together on a GATT queue
+static const uint8_t htpc_hts_char_len[HTPC_CHAR_HTS_MAX] =
+{
+    [HTPC_CHAR_HTS_TEMP_TYPE]        = 1,
+    [HTPC_CHAR_HTS_MEAS_INTV]        = 2,
+};
+
+static const uint8_t htpc_hts_desc_len[HTPC_DESC_HTS_MAX] =
+{
+    [HTPC_DESC_HTS_TEMP_MEAS_CLI_CFG]   = PRF_CCC_DESC_LEN,
+    [HTPC_DESC_HTS_INTM_MEAS_CLI_CFG]   = PRF_CCC_DESC_LEN,
+    [HTPC_DESC_HTS_MEAS_INTV_CLI_CFG]   = PRF_CCC_DESC_LEN,
+    [HTPC_DESC_HTS_MEAS_INTV_VAL_RGE]   = 4,
+};
+
 /*
  * FUNCTION DEFINITIONS
  ****************************************************************************************
@@ -339,6 +354,8 @@ static int htpc_rd_char_req_handler(ke_msg_id_t const msgid,
 {
     // Attribute handle
     uint16_t search_hdl = ATT_INVALID_SEARCH_HANDLE;
+    // Length of the value, 0 if unknown
+    uint8_t len = 0;
     // Get the address of the environment
     struct htpc_env_tag *htpc_env = PRF_CLIENT_GET_ENV(dest_id, htpc);
 
@@ -349,11 +366,13 @@ static int htpc_rd_char_req_handler(ke_msg_id_t const msgid,
            ((param->char_code & ~HTPC_DESC_HTS_MASK) < HTPC_DESC_HTS_MAX))
         {
             search_hdl = htpc_env->hts.descs[param->char_code & ~HTPC_DESC_HTS_MASK].desc_hdl;
+            len = htpc_hts_desc_len[param->char_code & ~HTPC_DESC_HTS_MASK];
         }
         // Characteristic
         else if (param->char_code < HTPC_CHAR_HTS_MAX)
         {
             search_hdl = htpc_env->hts.chars[param->char_code].val_hdl;
+            len = htpc_hts_char_len[param->char_code];
         }
 
         // Check if handle is viable
@@ -361,7 +380,7 @@ static int htpc_rd_char_req_handler(ke_msg_id_t const msgid,
         {
             htpc_env->last_char_code = param->char_code;
             prf_read_char_send(&(htpc_env->con_info), htpc_env->hts.svc.shdl,
-                               htpc_env->hts.svc.ehdl, search_hdl);
+                               htpc_env->hts.svc.ehdl, search_hdl, len);
         }
         else
         {
@@ -40,10 +40,16 @@
  ****************************************************************************************
  */
 
-static int htpt_create_db_req_handler(ke_msg_id_t const msgid,
-                                      struct htpt_create_db_req const *param,
-                                      ke_task_id_t const dest_id,
-                                      ke_task_id_t const src_id)
+/**
+ ****************************************************************************************
+ * @brief Create the HTPT attribute database.
+ * Used by the @ref HTPT_CREATE_DB_REQ handler, and directly by the application when
+ * the database is created without kernel messages.
+ * @param[in] param Pointer to the database configuration.
+ * @return Database creation status.
+ ****************************************************************************************
+ */
+uint8_t htpt_create_db(struct htpt_create_db_req const *param)
 {
     //Valid Range value
     uint32_t valid_range;
@@ -65,7 +71,7 @@ static int htpt_create_db_req_handler(ke_msg_id_t const msgid,
     cfg_flag = htpt_compute_att_table(param->features);
 
     status = atts_svc_create_db(&htpt_env.shdl, (uint8_t *)&cfg_flag, HTS_IDX_NB, &htpt_env.att_tbl[0],
-                               dest_id, &htpt_att_db[0]);
+                               TASK_HTPT, &htpt_att_db[0]);
 
     //Disable the service and set optional features
     if (status == ATT_ERR_NO_ERROR)
@@ -117,6 +123,17 @@ static int htpt_create_db_req_handler(ke_msg_id_t const msgid,
         ke_state_set(TASK_HTPT, HTPT_IDLE);
     }
 
+    return (status);
+}
+
+static int htpt_create_db_req_handler(ke_msg_id_t const msgid,
+                                      struct htpt_create_db_req const *param,
+                                      ke_task_id_t const dest_id,
+                                      ke_task_id_t const src_id)
+{
+    //Database Creation Status
+    uint8_t status = htpt_create_db(param);
+
     //Send response to application
     struct htpt_create_db_cfm * cfm = KE_MSG_ALLOC(HTPT_CREATE_DB_CFM, src_id, TASK_HTPT,
                                                    htpt_create_db_cfm);
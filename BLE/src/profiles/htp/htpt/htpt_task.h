@@ -240,6 +240,8 @@ extern ke_state_t htpt_state[HTPT_IDX_MAX];
 
 extern void task_htpt_desc_register(void);
 
+extern uint8_t htpt_create_db(struct htpt_create_db_req const *param);
+
 #endif //BLE_H T_THERMOM
 
 /// @} HTPTTASK
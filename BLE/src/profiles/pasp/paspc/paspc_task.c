@@ -151,7 +151,8 @@ static int paspc_enable_cmd_handler(ke_msg_id_t const msgid,
 
             // Send the read request
             prf_read_char_send(&(paspc_env->con_info), paspc_env->pass.svc.shdl,
-                               paspc_env->pass.svc.ehdl, paspc_env->pass.chars[PASPC_CHAR_ALERT_STATUS].val_hdl);
+                               paspc_env->pass.svc.ehdl, paspc_env->pass.chars[PASPC_CHAR_ALERT_STATUS].val_hdl,
+                               sizeof(uint8_t));
         }
 
         // Go to BUSY state
@@ -196,6 +197,8 @@ static int paspc_read_cmd_handler(ke_msg_id_t const msgid,
     {
         // Attribute Handle
         uint16_t handle    = ATT_INVALID_SEARCH_HANDLE;
+        // Length of the value
+        uint8_t len        = 0;
         // Status
         uint8_t status     = PRF_ERR_OK;
 
@@ -218,24 +221,28 @@ static int paspc_read_cmd_handler(ke_msg_id_t const msgid,
                     case (PASPC_RD_ALERT_STATUS):
                     {
                         handle = paspc_idx_env->pass.chars[PASPC_CHAR_ALERT_STATUS].val_hdl;
+                        len    = sizeof(uint8_t);
                     } break;
 
                     // Read Ringer Setting Characteristic Value
                     case (PASPC_RD_RINGER_SETTING):
                     {
                         handle = paspc_idx_env->pass.chars[PASPC_CHAR_RINGER_SETTING].val_hdl;
+                        len    = sizeof(uint8_t);
                     } break;
 
                     // Read Alert Status Characteristic Client Char. Cfg. Descriptor Value
                     case (PASPC_RD_WR_ALERT_STATUS_CFG):
                     {
                         handle = paspc_idx_env->pass.descs[PASPC_DESC_ALERT_STATUS_CL_CFG].desc_hdl;
+                        len    = PRF_CCC_DESC_LEN;
                     } break;
 
                     // Read Ringer Setting Characteristic Client Char. Cfg. Descriptor Value
                     case (PASPC_RD_WR_RINGER_SETTING_CFG):
                     {
                         handle = paspc_idx_env->pass.descs[PASPC_DESC_RINGER_SETTING_CL_CFG].desc_hdl;
+                        len    = PRF_CCC_DESC_LEN;
                     } break;
 
                     default:
@@ -256,7 +263,7 @@ static int paspc_read_cmd_handler(ke_msg_id_t const msgid,
 
                         // Send the read request
                         prf_read_char_send(&(paspc_idx_env->con_info), paspc_idx_env->pass.svc.shdl,
-                                           paspc_idx_env->pass.svc.ehdl, handle);
+                                           paspc_idx_env->pass.svc.ehdl, handle, len);
 
                         // Go to the Busy state
                         ke_state_set(dest_id, PASPC_BUSY);
@@ -647,7 +654,8 @@ static int gatt_cmp_evt_handler(ke_msg_id_t const msgid,
 
                         // Send the read request
                         prf_read_char_send(&(paspc_env->con_info), paspc_env->pass.svc.shdl,
-                                           paspc_env->pass.svc.ehdl, paspc_env->pass.chars[PASPC_CHAR_ALERT_STATUS].val_hdl);
+                                           paspc_env->pass.svc.ehdl, paspc_env->pass.chars[PASPC_CHAR_ALERT_STATUS].val_hdl,
+                                           sizeof(uint8_t));
                     }
                 }
             }
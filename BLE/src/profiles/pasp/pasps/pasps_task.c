@@ -43,18 +43,14 @@
 
 /**
  ****************************************************************************************
- * @brief Handles reception of the @ref PASPS_CREATE_DB_REQ message.
- * @param[in] msgid Id of the message received
- * @param[in] param Pointer to the parameters of the message.
- * @param[in] dest_id ID of the receiving task instance
- * @param[in] src_id ID of the sending task instance.
- * @return If the message was consumed or not.
+ * @brief Create the PASPS attribute database.
+ * Used by the @ref PASPS_CREATE_DB_REQ handler, and directly by the application when
+ * the database is created without kernel messages.
+ * @param[in] param Pointer to the database configuration.
+ * @return Database creation status.
  ****************************************************************************************
  */
-static int pasps_create_db_req_handler(ke_msg_id_t const msgid,
-                                       struct pasps_create_db_req const *param,
-                                       ke_task_id_t const dest_id,
-                                       ke_task_id_t const src_id)
+uint8_t pasps_create_db(struct pasps_create_db_req const *param)
 {
     // Service Configuration Flag - All attributes have to be added in the database
     uint16_t cfg_flag = PASPS_DB_CFG_FLAG;
@@ -72,7 +68,7 @@ static int pasps_create_db_req_handler(ke_msg_id_t const msgid,
         {
             // Add service in the database
             status = atts_svc_create_db(&pasps_env.pass_shdl, (uint8_t *)&cfg_flag, PASS_IDX_NB, NULL,
-                                        dest_id, &pasps_att_db[0]);
+                                        TASK_PASPS, &pasps_att_db[0]);
 
             // Go to Idle State
             if (status == ATT_ERR_NO_ERROR)
@@ -109,6 +105,27 @@ static int pasps_create_db_req_handler(ke_msg_id_t const msgid,
         status = PRF_ERR_REQ_DISALLOWED;
     }
 
+    return (status);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Handles reception of the @ref PASPS_CREATE_DB_REQ message.
+ * @param[in] msgid Id of the message received
+ * @param[in] param Pointer to the parameters of the message.
+ * @param[in] dest_id ID of the receiving task instance
+ * @param[in] src_id ID of the sending task instance.
+ * @return If the message was consumed or not.
+ ****************************************************************************************
+ */
+static int pasps_create_db_req_handler(ke_msg_id_t const msgid,
+                                       struct pasps_create_db_req const *param,
+                                       ke_task_id_t const dest_id,
+                                       ke_task_id_t const src_id)
+{
+    //Database Creation Status
+    uint8_t status = pasps_create_db(param);
+
     // Send response to application
     pasps_send_cmp_evt(TASK_PASPS, src_id, GAP_INVALID_CONHDL, PASPS_CREATE_DB_OP_CODE, status);
 
@@ -204,6 +204,8 @@ extern ke_state_t pasps_state[PASPS_IDX_MAX];
 
 extern void task_pasps_desc_register(void);
 
+extern uint8_t pasps_create_db(struct pasps_create_db_req const *param);
+
 #endif //(BLE_PAS_SERVER)
 
 /// @} PASPSTASK
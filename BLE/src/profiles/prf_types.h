@@ -44,6 +44,8 @@
  */
 #if (BLE_ATTS || BLE_ATTC)
 #include "ke_msg.h"
+#include "task_prof.h"
+#include "app_sys.h"
 /*
  * DEFINES
  ****************************************************************************************
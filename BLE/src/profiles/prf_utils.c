@@ -307,12 +307,774 @@ void prf_unpack_char_pres_fmt(const uint8_t *packed_val, struct prf_char_pres_fm
 
 #if (BLE_ATTC)
 
+/// Notified characteristic
+struct prf_ntf_entry
+{
+    /// Value handle, ATT_INVALID_HANDLE for a free entry
+    uint16_t handle;
+    /// Owning client task, TASK_NONE once it has been removed
+    ke_task_id_t task;
+    /// Characteristic code in the client task
+    uint8_t char_code;
+};
+
+/// Notified characteristics of each connection, open addressing on the value handle
+static struct prf_ntf_entry prf_ntf_table[BLE_CONNECTION_MAX][PRF_NTF_TABLE_SIZE];
+static struct prf_ntf_stat prf_ntf_stat;
+
+static struct prf_ntf_entry *prf_ntf_find(uint16_t conhdl, uint16_t handle)
+{
+    uint8_t idx = gap_get_rec_idx(conhdl);
+    struct prf_ntf_entry *entry = NULL;
+    uint8_t i = 0, slot;
+
+    if (idx < BLE_CONNECTION_MAX)
+    {
+        // The handles of a peer are consecutive, most lookups take one probe
+        while (i < PRF_NTF_TABLE_SIZE)
+        {
+            slot = (handle + i++) & (PRF_NTF_TABLE_SIZE - 1);
+            if (prf_ntf_table[idx][slot].handle == ATT_INVALID_HANDLE)
+                break;
+            if (prf_ntf_table[idx][slot].handle == handle)
+            {
+                entry = &prf_ntf_table[idx][slot];
+                break;
+            }
+        }
+        prf_ntf_stat.lookup++;
+        prf_ntf_stat.probe += i;
+        if (i > prf_ntf_stat.probe_max)
+            prf_ntf_stat.probe_max = i;
+    }
+
+    if ((entry == NULL) || (entry->task == TASK_NONE))
+    {
+        prf_ntf_stat.miss++;
+        entry = NULL;
+    }
+
+    return entry;
+}
+
+void prf_ntf_register(struct prf_con_info const *con_info, struct prf_char_inf const *chars,
+                      uint8_t nb_chars, uint8_t code_base)
+{
+    struct prf_ntf_entry *table = prf_ntf_table[KE_IDX_GET(con_info->prf_id)];
+    struct prf_ntf_entry *entry;
+    uint8_t i, j, slot;
+
+    for (i = 0; i < nb_chars; i++)
+    {
+        if ((chars[i].val_hdl == ATT_INVALID_HANDLE) || !(chars[i].prop & ATT_CHAR_PROP_NTF))
+            continue;
+
+        // Same handle again after a new discovery, a removed entry or a free one
+        entry = NULL;
+        for (j = 0; j < PRF_NTF_TABLE_SIZE; j++)
+        {
+            slot = (chars[i].val_hdl + j) & (PRF_NTF_TABLE_SIZE - 1);
+            if (table[slot].handle == chars[i].val_hdl)
+            {
+                entry = &table[slot];
+                break;
+            }
+            if ((entry == NULL) && (table[slot].task == TASK_NONE))
+                entry = &table[slot];
+            if (table[slot].handle == ATT_INVALID_HANDLE)
+            {
+                if (entry == NULL)
+                    entry = &table[slot];
+                break;
+            }
+        }
+
+        if (entry == NULL)
+        {
+            prf_ntf_stat.full++;
+            continue;
+        }
+        entry->handle = chars[i].val_hdl;
+        entry->task = con_info->prf_id;
+        entry->char_code = code_base + i;
+    }
+}
+
+void prf_ntf_unregister(struct prf_con_info const *con_info)
+{
+    struct prf_ntf_entry *table = prf_ntf_table[KE_IDX_GET(con_info->prf_id)];
+    uint8_t slot;
+
+    // Removed entries keep their handle so that the lookups still probe past them
+    for (slot = 0; slot < PRF_NTF_TABLE_SIZE; slot++)
+    {
+        if ((table[slot].handle != ATT_INVALID_HANDLE) && (table[slot].task == con_info->prf_id))
+            table[slot].task = TASK_NONE;
+    }
+}
+
+uint8_t prf_ntf_char_get(uint16_t conhdl, uint16_t handle, ke_task_id_t task)
+{
+    struct prf_ntf_entry const *entry = prf_ntf_find(conhdl, handle);
+
+    prf_ntf_stat.hop++;
+    if ((entry == NULL) || (entry->task != task))
+        return PRF_NTF_CHAR_NONE;
+
+    prf_ntf_stat.delivered++;
+
+    return entry->char_code;
+}
+
+bool prf_ntf_forward(struct gatt_handle_value_notif const *param)
+{
+    struct prf_ntf_entry const *entry = prf_ntf_find(param->conhdl, param->charhdl);
+
+    prf_ntf_stat.hop++;
+    if (entry == NULL)
+        return false;
+
+    prf_ntf_stat.forward++;
+    ke_msg_forward(param, entry->task, TASK_GATT);
+
+    return true;
+}
+
+struct prf_ntf_stat const *prf_ntf_stat_get(void)
+{
+    return &prf_ntf_stat;
+}
+
+#if (QN_GATT_QUEUE)
+
+/// Queued read or write
+struct prf_gattq_op
+{
+    /// GATT_READ_CHAR_REQ or GATT_WRITE_CHAR_REQ parameters, allocated when queued
+    void *req;
+    /// Task receiving the response
+    ke_task_id_t owner;
+    /// GATT request type
+    uint8_t req_type;
+    /// Length of a read value, 0 if unknown
+    uint8_t len;
+};
+
+#if (QN_LONG_WRITE)
+/// Long read or write of a connection, its operation stays at the head of the queue
+struct prf_gattq_long
+{
+    /// Value handle, ATT_INVALID_HANDLE if none is queued
+    uint16_t handle;
+    uint16_t conhdl;
+    /// Length of the value to write or largest length of the value to read, bytes read
+    /// or written so far
+    uint16_t len;
+    uint16_t done;
+    /// Bytes of the segment in flight
+    uint16_t seg;
+    /// Status given to the owner
+    uint8_t status;
+    bool read;
+    /// A failed write is cancelling the prepared writes of the peer
+    bool cancel;
+    /// Allocated for the operation only: the GATT_READ_CHAR_RESP to the owner, filled in
+    /// place, or the ke_malloc() copy of the value to write
+    void *buf;
+};
+
+#define PRF_GATTQ_LONG_VALUE(lop)   ((lop)->read ? &((struct gatt_read_char_resp *)(lop)->buf)->data.data[0] \
+                                                 : (uint8_t *)(lop)->buf)
+#endif // (QN_LONG_WRITE)
+
+/// GATT client queue environment
+struct prf_gattq_env_tag
+{
+    /// Requests of each connection, a ring from head
+    struct prf_gattq_op op[BLE_CONNECTION_MAX][PRF_GATTQ_SIZE];
+    uint8_t head[BLE_CONNECTION_MAX];
+    uint8_t cnt[BLE_CONNECTION_MAX];
+    /// Connection of the request in flight + 1, 0 if none
+    uint8_t busy;
+    /// Queued requests answered by the request in flight
+    uint8_t batch;
+    /// Connection served first by the next request
+    uint8_t next;
+    #if (QN_LONG_WRITE)
+    struct prf_gattq_long long_op[BLE_CONNECTION_MAX];
+    #endif
+};
+
+static struct prf_gattq_env_tag prf_gattq_env;
+static struct prf_gattq_stat prf_gattq_stat;
+
+#define PRF_GATTQ_OP(idx, i)    (&prf_gattq_env.op[idx][(prf_gattq_env.head[idx] + (i)) % PRF_GATTQ_SIZE])
+
+static void prf_gattq_pop(uint8_t idx, uint8_t nb)
+{
+    prf_gattq_env.head[idx] = (prf_gattq_env.head[idx] + nb) % PRF_GATTQ_SIZE;
+    prf_gattq_env.cnt[idx] -= nb;
+}
+
+#if (QN_LONG_WRITE)
+/// Release the long operation of a connection and its buffer
+static void prf_gattq_long_free(struct prf_gattq_long *lop)
+{
+    if (lop->buf != NULL)
+    {
+        if (lop->read)
+            ke_msg_free(ke_param2msg(lop->buf));
+        else
+            ke_free(lop->buf);
+        lop->buf = NULL;
+    }
+    lop->handle = ATT_INVALID_HANDLE;
+}
+
+/// Request of the next segment of a long read or write
+static void *prf_gattq_long_req(uint8_t idx)
+{
+    struct prf_gattq_long *lop = &prf_gattq_env.long_op[idx];
+    uint16_t conhdl = lop->conhdl;
+    uint16_t pdu = attm_get_mtu(idx) - 5;
+
+    prf_gattq_stat.seg++;
+
+    if (lop->cancel)
+    {
+        struct gatt_execute_write_char_req *req = KE_MSG_ALLOC(GATT_EXECUTE_WRITE_CHAR_REQ,
+                                                               TASK_GATT, PRF_GATTQ_TASK(idx),
+                                                               gatt_execute_write_char_req);
+        req->conhdl     = conhdl;
+        req->exe_wr_ena = 0x00;
+
+        return req;
+    }
+
+    if (lop->read)
+    {
+        struct gatt_read_char_req *req = KE_MSG_ALLOC(GATT_READ_CHAR_REQ, TASK_GATT, PRF_GATTQ_TASK(idx),
+                                                      gatt_read_char_req);
+        req->req_type                   = GATT_READ_LONG_CHAR;
+        req->offset                     = lop->done;
+        req->conhdl                     = conhdl;
+        req->start_hdl                  = 0x0001;
+        req->end_hdl                    = GATT_MAX_ATTR_HDL;
+        req->nb_uuid                    = 0x01;
+        req->uuid[0].value_size         = ATT_UUID_16_LEN;
+        req->uuid[0].expect_resp_size   = ATT_UUID_16_LEN;
+        co_write16p(&req->uuid[0].value[0], lop->handle);
+        lop->seg = ATTM_MAX_LONG_VALUE;
+
+        return req;
+    }
+    else
+    {
+        struct gatt_write_char_req *req;
+
+        // Whole Prepare Write requests, the GATT takes at most ATTM_MAX_LONG_VALUE bytes
+        lop->seg = (pdu < ATTM_MAX_LONG_VALUE) ? (ATTM_MAX_LONG_VALUE / pdu) * pdu : ATTM_MAX_LONG_VALUE;
+        if (lop->seg > lop->len - lop->done)
+            lop->seg = lop->len - lop->done;
+
+        req = KE_MSG_ALLOC_DYN(GATT_WRITE_CHAR_REQ, TASK_GATT, PRF_GATTQ_TASK(idx),
+                               gatt_write_char_req, lop->seg);
+        req->conhdl         = conhdl;
+        req->wr_offset      = lop->done;
+        req->req_type       = GATT_WRITE_LONG_CHAR;
+        req->charhdl        = lop->handle;
+        req->val_len        = lop->seg;
+        // Only the last segment executes the prepared writes
+        req->auto_execute   = (lop->done + lop->seg == lop->len);
+        memcpy(&req->value[0], PRF_GATTQ_LONG_VALUE(lop) + lop->done, lop->seg);
+
+        return req;
+    }
+}
+#endif // (QN_LONG_WRITE)
+
+/**
+ ****************************************************************************************
+ * @brief Send the next request when none is in flight, the connections take turns.
+ ****************************************************************************************
+ */
+static void prf_gattq_send(void)
+{
+    struct gatt_read_char_req *rd;
+    struct prf_gattq_op *op, *more;
+    uint16_t size, mtu;
+    uint8_t n, idx, nb;
+
+    for (n = 0; (n < BLE_CONNECTION_MAX) && (prf_gattq_env.busy == 0); n++)
+    {
+        idx = (prf_gattq_env.next + n) % BLE_CONNECTION_MAX;
+
+        // Write commands have no response, they go out back to back
+        while ((prf_gattq_env.cnt[idx] != 0)
+            && (PRF_GATTQ_OP(idx, 0)->req_type == GATT_WRITE_NO_RESPONSE))
+        {
+            ke_msg_send(PRF_GATTQ_OP(idx, 0)->req);
+            prf_gattq_stat.cmd++;
+            prf_gattq_pop(idx, 1);
+        }
+        if (prf_gattq_env.cnt[idx] == 0)
+            continue;
+
+        op = PRF_GATTQ_OP(idx, 0);
+        nb = 1;
+        #if (QN_LONG_WRITE)
+        if ((op->req_type == GATT_READ_LONG_CHAR) || (op->req_type == GATT_WRITE_LONG_CHAR))
+            op->req = prf_gattq_long_req(idx);
+        #endif
+        if ((op->req_type == GATT_READ_CHAR) && (op->len != 0))
+        {
+            // The reads which follow go in the same Read Multiple while the values fit in
+            // its response, only the last one may be of unknown length
+            rd = (struct gatt_read_char_req *)op->req;
+            mtu = attm_get_mtu(idx);
+            size = op->len;
+            while ((nb < prf_gattq_env.cnt[idx]) && (nb < ATT_NB_MULT_HDLS))
+            {
+                more = PRF_GATTQ_OP(idx, nb);
+                if ((more->req_type != GATT_READ_CHAR) || (size + more->len >= mtu))
+                    break;
+
+                rd->uuid[nb] = ((struct gatt_read_char_req *)more->req)->uuid[0];
+                if (more->len == 0)
+                    rd->uuid[nb].expect_resp_size = mtu - 1 - size;
+                ke_msg_free(ke_param2msg(more->req));
+                more->req = NULL;
+                size += more->len;
+                nb++;
+                if (more->len == 0)
+                    break;
+            }
+
+            if (nb > 1)
+            {
+                rd->req_type = GATT_READ_MULT_LONG_CHAR;
+                rd->nb_uuid = nb;
+                prf_gattq_stat.mult++;
+            }
+        }
+
+        ke_msg_send(op->req);
+        op->req = NULL;
+        prf_gattq_stat.req++;
+        prf_gattq_env.busy = idx + 1;
+        prf_gattq_env.batch = nb;
+        prf_gattq_env.next = idx + 1;
+    }
+}
+
+static struct prf_gattq_op *prf_gattq_push(uint16_t conhdl)
+{
+    uint8_t idx = gap_get_rec_idx(conhdl);
+
+    if ((idx >= BLE_CONNECTION_MAX) || (prf_gattq_env.cnt[idx] == PRF_GATTQ_SIZE))
+    {
+        prf_gattq_stat.full++;
+        return NULL;
+    }
+
+    prf_gattq_stat.op++;
+
+    return PRF_GATTQ_OP(idx, prf_gattq_env.cnt[idx]++);
+}
+
+static void prf_gattq_read_rsp_send(struct prf_gattq_op const *op, uint8_t status,
+                                    uint8_t const *value, uint16_t len)
+{
+    struct gatt_read_char_resp *rsp = KE_MSG_ALLOC_DYN(GATT_READ_CHAR_RESP,
+                                                       op->owner, TASK_GATT,
+                                                       gatt_read_char_resp, len);
+
+    rsp->status         = status;
+    rsp->data.len       = len;
+    rsp->data.each_len  = len;
+    memcpy(&rsp->data.data[0], value, len);
+
+    ke_msg_send(rsp);
+}
+
+static void prf_gattq_write_rsp_send(struct prf_gattq_op const *op, uint8_t status)
+{
+    struct gatt_write_char_resp *rsp = KE_MSG_ALLOC(GATT_WRITE_CHAR_RESP,
+                                                    op->owner, TASK_GATT,
+                                                    gatt_write_char_resp);
+
+    rsp->status = status;
+
+    ke_msg_send(rsp);
+}
+
+/// Drop the requests of a connection, the GATT does not answer after a disconnection
+static void prf_gattq_flush(uint8_t idx)
+{
+    while (prf_gattq_env.cnt[idx] != 0)
+    {
+        if (PRF_GATTQ_OP(idx, 0)->req != NULL)
+            ke_msg_free(ke_param2msg(PRF_GATTQ_OP(idx, 0)->req));
+        prf_gattq_pop(idx, 1);
+    }
+
+    #if (QN_LONG_WRITE)
+    prf_gattq_long_free(&prf_gattq_env.long_op[idx]);
+    #endif
+
+    if (prf_gattq_env.busy == idx + 1)
+    {
+        prf_gattq_env.busy = 0;
+        prf_gattq_send();
+    }
+}
+
+#if (QN_LONG_WRITE)
+/**
+ ****************************************************************************************
+ * @brief Response to a segment of a long read or write, other responses are ignored.
+ ****************************************************************************************
+ */
+static void prf_gattq_long_rsp(uint8_t idx, struct prf_gattq_op *op, ke_msg_id_t const msgid,
+                              void const *param)
+{
+    struct prf_gattq_long *lop = &prf_gattq_env.long_op[idx];
+    bool done = true;
+    uint16_t room;
+
+    if (lop->cancel)
+    {
+        // Whatever the outcome, the peer drops its queue
+        if ((msgid != GATT_CANCEL_WRITE_CHAR_RESP) && (msgid != GATT_CMP_EVT))
+            return;
+    }
+    else if ((msgid == GATT_CMP_EVT) && (((struct gatt_cmp_evt const *)param)->status != ATT_ERR_NO_ERROR))
+    {
+        lop->status = ((struct gatt_cmp_evt const *)param)->status;
+    }
+    else if ((msgid == GATT_READ_CHAR_RESP) && lop->read)
+    {
+        struct gatt_read_char_resp const *rsp = (struct gatt_read_char_resp const *)param;
+
+        room = lop->len - lop->done;
+        if (rsp->status != ATT_ERR_NO_ERROR)
+        {
+            // A value of a whole number of segments ends with an offset past it
+            if ((rsp->status != ATT_ERR_INVALID_OFFSET) || (lop->done == 0))
+                lop->status = rsp->status;
+        }
+        else if (rsp->data.len > room)
+        {
+            memcpy(PRF_GATTQ_LONG_VALUE(lop) + lop->done, &rsp->data.data[0], room);
+            lop->done += room;
+            lop->status = ATT_ERR_INVALID_ATTRIBUTE_VAL_LEN;
+        }
+        else
+        {
+            memcpy(PRF_GATTQ_LONG_VALUE(lop) + lop->done, &rsp->data.data[0], rsp->data.len);
+            lop->done += rsp->data.len;
+            // A full segment may be followed by more
+            done = (rsp->data.len < lop->seg);
+        }
+    }
+    else if ((msgid == GATT_WRITE_CHAR_RESP) && !lop->read)
+    {
+        lop->status = ((struct gatt_write_char_resp const *)param)->status;
+        if (lop->status == ATT_ERR_NO_ERROR)
+        {
+            lop->done += lop->seg;
+            done = (lop->done == lop->len);
+        }
+        else if (lop->done + lop->seg < lop->len)
+        {
+            // The segment did not execute, the peer still holds the segments before it
+            lop->cancel = true;
+            done = false;
+        }
+    }
+    else
+    {
+        return;
+    }
+
+    if (done)
+    {
+        if (lop->read)
+        {
+            struct gatt_read_char_resp *rsp = (struct gatt_read_char_resp *)lop->buf;
+
+            rsp->status         = lop->status;
+            rsp->data.len       = lop->done;
+            rsp->data.each_len  = lop->done;
+            ke_msg_send(rsp);
+            lop->buf = NULL;
+        }
+        else
+        {
+            prf_gattq_write_rsp_send(op, lop->status);
+        }
+
+        prf_gattq_long_free(lop);
+        prf_gattq_pop(idx, 1);
+    }
+
+    prf_gattq_env.busy = 0;
+    prf_gattq_send();
+}
+
+/**
+ ****************************************************************************************
+ * @brief Queue a long read or write, its buffer allocated for length bytes.
+ ****************************************************************************************
+ */
+static struct prf_gattq_long *prf_gattq_long_push(ke_task_id_t owner, uint16_t conhdl, uint16_t handle,
+                                                  uint8_t req_type, uint16_t length)
+{
+    uint8_t idx = gap_get_rec_idx(conhdl);
+    bool read = (req_type == GATT_READ_LONG_CHAR);
+    struct prf_gattq_long *lop;
+    struct prf_gattq_op *op;
+    void *buf;
+
+    if ((idx >= BLE_CONNECTION_MAX) || (prf_gattq_env.long_op[idx].handle != ATT_INVALID_HANDLE)
+     || (prf_gattq_env.cnt[idx] == PRF_GATTQ_SIZE) || (length == 0) || (length > PRF_LONG_VALUE_MAX))
+        return NULL;
+
+    if (read)
+    {
+        buf = KE_MSG_ALLOC_DYN(GATT_READ_CHAR_RESP, owner, TASK_GATT, gatt_read_char_resp, length);
+    }
+    else
+    {
+        buf = ke_malloc(length);
+    }
+    if (buf == NULL)
+        return NULL;
+
+    op = prf_gattq_push(conhdl);
+    op->req         = NULL;
+    op->owner       = owner;
+    op->req_type    = req_type;
+    op->len         = 0;
+
+    lop = &prf_gattq_env.long_op[idx];
+    lop->handle     = handle;
+    lop->conhdl     = conhdl;
+    lop->len        = length;
+    lop->done       = 0;
+    lop->status     = ATT_ERR_NO_ERROR;
+    lop->read       = read;
+    lop->cancel     = false;
+    lop->buf        = buf;
+
+    return lop;
+}
+
+bool prf_gattq_read_long(ke_task_id_t owner, uint16_t conhdl, uint16_t handle, uint16_t max_len)
+{
+    if (prf_gattq_long_push(owner, conhdl, handle, GATT_READ_LONG_CHAR, max_len) == NULL)
+        return false;
+
+    prf_gattq_send();
+
+    return true;
+}
+
+bool prf_gattq_write_long(ke_task_id_t owner, uint16_t conhdl, uint16_t handle,
+                          uint8_t const *value, uint16_t length)
+{
+    struct prf_gattq_long *lop;
+
+    lop = prf_gattq_long_push(owner, conhdl, handle, GATT_WRITE_LONG_CHAR, length);
+    if (lop == NULL)
+        return false;
+
+    memcpy(lop->buf, value, length);
+
+    prf_gattq_send();
+
+    return true;
+}
+#endif // (QN_LONG_WRITE)
+
+bool prf_gattq_read(ke_task_id_t owner, uint16_t conhdl, uint16_t handle, uint8_t len)
+{
+    struct prf_gattq_op *op = prf_gattq_push(conhdl);
+    struct gatt_read_char_req *req;
+
+    if (op == NULL)
+        return false;
+
+    req = KE_MSG_ALLOC(GATT_READ_CHAR_REQ, TASK_GATT, PRF_GATTQ_TASK(gap_get_rec_idx(conhdl)),
+                       gatt_read_char_req);
+    req->req_type                   = GATT_READ_CHAR;
+    req->offset                     = 0x0000;
+    req->conhdl                     = conhdl;
+    req->start_hdl                  = 0x0001;
+    req->end_hdl                    = GATT_MAX_ATTR_HDL;
+    req->nb_uuid                    = 0x01;
+    req->uuid[0].value_size         = ATT_UUID_16_LEN;
+    req->uuid[0].expect_resp_size   = (len != 0) ? len : ATT_UUID_16_LEN;
+    co_write16p(&req->uuid[0].value[0], handle);
+
+    op->req         = req;
+    op->owner       = owner;
+    op->req_type    = GATT_READ_CHAR;
+    op->len         = len;
+
+    prf_gattq_send();
+
+    return true;
+}
+
+bool prf_gattq_write(ke_task_id_t owner, uint16_t conhdl, uint16_t handle,
+                     uint8_t const *value, uint16_t length, uint8_t req_type)
+{
+    struct gatt_write_char_req *req;
+    struct prf_gattq_op *op;
+
+    #if (QN_LONG_WRITE)
+    if (req_type == GATT_WRITE_LONG_CHAR)
+        return prf_gattq_write_long(owner, conhdl, handle, value, length);
+    #endif
+
+    if ((req_type != GATT_WRITE_CHAR) && (req_type != GATT_WRITE_DESC)
+     && (req_type != GATT_WRITE_NO_RESPONSE))
+        return false;
+
+    op = prf_gattq_push(conhdl);
+    if (op == NULL)
+        return false;
+
+    // Nothing waits for a write command, whatever the GATT answers goes to the owner
+    req = KE_MSG_ALLOC_DYN(GATT_WRITE_CHAR_REQ, TASK_GATT,
+                           (req_type == GATT_WRITE_NO_RESPONSE) ? owner : PRF_GATTQ_TASK(gap_get_rec_idx(conhdl)),
+                           gatt_write_char_req, length);
+    req->conhdl         = conhdl;
+    req->wr_offset      = 0x0000;
+    req->req_type       = req_type;
+    req->charhdl        = handle;
+    req->val_len        = length;
+    req->auto_execute   = 1;
+    memcpy(&req->value[0], value, length);
+
+    op->req         = req;
+    op->owner       = owner;
+    op->req_type    = req_type;
+    op->len         = 0;
+
+    prf_gattq_send();
+
+    return true;
+}
+
+bool prf_gattq_rsp(ke_msg_id_t const msgid, void const *param, ke_task_id_t const dest_id)
+{
+    struct prf_gattq_op *op;
+    uint8_t idx, i, status;
+    bool read;
+
+    if ((KE_TYPE_GET(dest_id) != TASK_APP) || (KE_IDX_GET(dest_id) == 0))
+        return false;
+
+    // From here the response is for the queue, it is dropped unless it ends the request in
+    // flight: a late response of a connection whose requests were flushed, or a GATT_CMP_EVT
+    // which follows the response of a read or a write
+    idx = KE_IDX_GET(dest_id) - 1;
+    if (prf_gattq_env.busy != idx + 1)
+        return true;
+
+    op = PRF_GATTQ_OP(idx, 0);
+    read = (op->req_type == GATT_READ_CHAR);
+
+    #if (QN_LONG_WRITE)
+    if ((op->req_type == GATT_READ_LONG_CHAR) || (op->req_type == GATT_WRITE_LONG_CHAR))
+    {
+        prf_gattq_long_rsp(idx, op, msgid, param);
+        return true;
+    }
+    #endif
+
+    switch (msgid)
+    {
+        case GATT_READ_CHAR_RESP:
+        {
+            struct gatt_read_char_resp const *rsp = (struct gatt_read_char_resp const *)param;
+
+            if (!read || (prf_gattq_env.batch != 1))
+                return true;
+
+            prf_gattq_read_rsp_send(op, rsp->status, &rsp->data.data[0],
+                                    (rsp->status == ATT_ERR_NO_ERROR) ? rsp->data.len : 0);
+        } break;
+
+        case GATT_READ_CHAR_MULT_RESP:
+        {
+            struct gatt_read_char_mult_resp const *rsp = (struct gatt_read_char_mult_resp const *)param;
+
+            if (!read || (prf_gattq_env.batch == 1))
+                return true;
+
+            for (i = 0; i < prf_gattq_env.batch; i++)
+            {
+                prf_gattq_read_rsp_send(PRF_GATTQ_OP(idx, i), rsp->status, &rsp->data[i].value[0],
+                                        (rsp->status == ATT_ERR_NO_ERROR) ? rsp->data[i].len : 0);
+            }
+        } break;
+
+        case GATT_WRITE_CHAR_RESP:
+        {
+            if (read)
+                return true;
+
+            prf_gattq_write_rsp_send(op, ((struct gatt_write_char_resp const *)param)->status);
+        } break;
+
+        case GATT_CMP_EVT:
+        {
+            // Only a failure ends a read or a write with this event
+            status = ((struct gatt_cmp_evt const *)param)->status;
+            if (status == ATT_ERR_NO_ERROR)
+                return true;
+
+            for (i = 0; i < prf_gattq_env.batch; i++)
+            {
+                if (read)
+                    prf_gattq_read_rsp_send(PRF_GATTQ_OP(idx, i), status, NULL, 0);
+                else
+                    prf_gattq_write_rsp_send(PRF_GATTQ_OP(idx, i), status);
+            }
+        } break;
+
+        default:
+            return true;
+    }
+
+    prf_gattq_pop(idx, prf_gattq_env.batch);
+    prf_gattq_env.busy = 0;
+    prf_gattq_send();
+
+    return true;
+}
+
+struct prf_gattq_stat const *prf_gattq_stat_get(void)
+{
+    return &prf_gattq_stat;
+}
+
+#endif // (QN_GATT_QUEUE)
+
 void prf_read_char_send(struct prf_con_info* con_info,
-                        uint16_t shdl, uint16_t ehdl, uint16_t valhdl)
+                        uint16_t shdl, uint16_t ehdl, uint16_t valhdl, uint8_t len)
 {
-    struct gatt_read_char_req * req  = KE_MSG_ALLOC(GATT_READ_CHAR_REQ,
-                                                    TASK_GATT, con_info->prf_id,
-                                                    gatt_read_char_req);
+    struct gatt_read_char_req * req;
+
+    #if (QN_GATT_QUEUE)
+    if (prf_gattq_read(con_info->prf_id, con_info->conhdl, valhdl, len))
+        return;
+    #endif // (QN_GATT_QUEUE)
+
+    req = KE_MSG_ALLOC(GATT_READ_CHAR_REQ, TASK_GATT, con_info->prf_id, gatt_read_char_req);
     //request type
     req->req_type                       = GATT_READ_CHAR;
     req->offset                         = 0x0000;
@@ -480,9 +1242,15 @@ void prf_disc_char_desc_send(struct prf_con_info* con_info, struct prf_char_inf
 void prf_gatt_write(struct prf_con_info* con_info,
                     uint16_t handle, uint8_t* value, uint16_t length, uint8_t req_type)
 {
-    struct gatt_write_char_req *wr_char = KE_MSG_ALLOC_DYN(GATT_WRITE_CHAR_REQ,
-                                                           TASK_GATT, con_info->prf_id,
-                                                           gatt_write_char_req, length);
+    struct gatt_write_char_req *wr_char;
+
+    #if (QN_GATT_QUEUE)
+    if (prf_gattq_write(con_info->prf_id, con_info->conhdl, handle, value, length, req_type))
+        return;
+    #endif // (QN_GATT_QUEUE)
+
+    wr_char = KE_MSG_ALLOC_DYN(GATT_WRITE_CHAR_REQ, TASK_GATT, con_info->prf_id,
+                               gatt_write_char_req, length);
 
     // Connection Handle
     wr_char->conhdl         = con_info->conhdl;
@@ -697,6 +1465,7 @@ void prf_client_disable_ind_send(prf_env_struct ***p_envs, ke_msg_id_t msg_id,
                                                           prf_client_disable_ind);
 
         ind->conhdl    = env->con_info.conhdl;
+        prf_ntf_unregister(&env->con_info);
         ind->status    = prf_client_disable(p_envs, KE_IDX_GET(env->con_info.prf_id));
 
         // Send the message
@@ -1040,6 +1809,53 @@ void prf_server_error_ind_send(prf_env_struct *p_env, uint8_t status,
     ke_msg_send(ind);
 }
 
+#if (QN_LONG_WRITE)
+uint8_t prf_long_wr_ind(struct prf_long_wr *wr, uint8_t *buf, uint16_t size,
+                        struct gatt_write_cmd_ind const *param, uint8_t **value, uint16_t *length)
+{
+    uint8_t status;
+
+    *value = NULL;
+    if (param->offset == 0)
+    {
+        wr->handle = param->handle;
+        wr->len = 0;
+        wr->status = ATT_ERR_NO_ERROR;
+    }
+    else if ((wr->status == ATT_ERR_NO_ERROR)
+          && ((param->handle != wr->handle) || (param->offset != wr->len)))
+    {
+        wr->status = ATT_ERR_INVALID_OFFSET;
+    }
+
+    if ((wr->status == ATT_ERR_NO_ERROR)
+     && (param->offset + param->length > size))
+    {
+        wr->status = ATT_ERR_INVALID_ATTRIBUTE_VAL_LEN;
+    }
+
+    if (wr->status == ATT_ERR_NO_ERROR)
+    {
+        memcpy(&buf[param->offset], &param->value[0], param->length);
+        wr->len = param->offset + param->length;
+    }
+
+    status = wr->status;
+    if (param->last)
+    {
+        // Nothing is committed unless every segment was accepted
+        if (status == ATT_ERR_NO_ERROR)
+        {
+            *value = buf;
+            *length = wr->len;
+        }
+        wr->handle = ATT_INVALID_HANDLE;
+    }
+
+    return status;
+}
+#endif // (QN_LONG_WRITE)
+
 #endif //(BLE_ATTS)
 #if (BLE_ATTS || BLE_ATTC)
 
@@ -1072,6 +1888,17 @@ void prf_dispatch_disconnect(uint8_t status, uint8_t reason, uint16_t conhdl, ui
     ke_task_id_t prf_task_id;
     #endif //(BLE_ATTC || BLE_TIP_SERVER || BLE_PAS_SERVER || BLE_AN_SERVER)
 
+    #if (BLE_ATTC)
+    // The handles of the next peer are unknown
+    if (idx < BLE_CONNECTION_MAX)
+    {
+        memset(prf_ntf_table[idx], 0, sizeof(prf_ntf_table[idx]));
+        #if (QN_GATT_QUEUE)
+        prf_gattq_flush(idx);
+        #endif // (QN_GATT_QUEUE)
+    }
+    #endif // (BLE_ATTC)
+
     //All profiles get this event, they must disable clean
     #if (BLE_QPP_CLIENT)
     prf_task_id = KE_BUILD_ID(TASK_QPPC, idx);
@@ -44,6 +44,21 @@
  ****************************************************************************************
  */
 
+/**
+ ****************************************************************************************
+ * @brief Round the variable part of a message up to a 16 bytes size class.
+ *
+ * Streaming messages of slightly different lengths then leave holes in the heap which
+ * the next message of the same class fits exactly, instead of splitting them further.
+ *
+ * @param len           Length of the variable part
+ ****************************************************************************************
+ */
+#define PRF_MSG_LEN_CLASS(len)      (((len) + 15) & ~15)
+
+/// Length of a Client Characteristic Configuration descriptor value
+#define PRF_CCC_DESC_LEN            2
+
 #if (BLE_ATTC || BLE_TIP_SERVER || BLE_AN_SERVER || BLE_PAS_SERVER)
 /**
  ****************************************************************************************
@@ -128,7 +143,78 @@ void prf_pack_char_pres_fmt(uint8_t *packed_val, const struct prf_char_pres_fmt*
 void prf_unpack_char_pres_fmt(const uint8_t *packed_val, struct prf_char_pres_fmt* char_pres_fmt);
 #endif // (BLE_BATT_CLIENT)
 
+#if (QN_LONG_WRITE)
+/// Largest attribute value (ATT), the buffers of the long reads and writes are sized by
+/// their users up to it
+#define PRF_LONG_VALUE_MAX          512
+
+/// Value being written with prepared writes, kept by the server with its buffer
+struct prf_long_wr
+{
+    /// Attribute handle, ATT_INVALID_HANDLE if none
+    uint16_t handle;
+    /// Bytes received in order
+    uint16_t len;
+    /// Status of the segments so far
+    uint8_t status;
+};
+#endif // (QN_LONG_WRITE)
+
 #if (BLE_ATTC)
+/// Notified characteristics of a connection in the notification table, a power of two
+#ifndef PRF_NTF_TABLE_SIZE
+#define PRF_NTF_TABLE_SIZE          32
+#endif
+
+/// Returned by prf_ntf_char_get() for a notification the task does not own
+#define PRF_NTF_CHAR_NONE           0xFF
+
+/// Notification dispatch counters
+struct prf_ntf_stat
+{
+    /// Table lookups, probes of all of them and of the longest one
+    uint32_t lookup;
+    uint32_t probe;
+    uint8_t probe_max;
+    /// Lookups of a handle which is not in the table
+    uint32_t miss;
+    /// Tasks which examined a notification, notifications handled by their owner
+    uint32_t hop;
+    uint32_t delivered;
+    /// Notifications the application forwarded to their client task
+    uint32_t forward;
+    /// Characteristics which did not fit in the table
+    uint32_t full;
+};
+
+#if (QN_GATT_QUEUE)
+/// Requests waiting in the GATT client queue of a connection
+#ifndef PRF_GATTQ_SIZE
+#define PRF_GATTQ_SIZE              12
+#endif
+
+/// Task instance the queued requests of a connection are sent from. The GATT responses
+/// carry no connection handle, the instance tells the queue and the connection apart
+/// from the application requests. Its GATT handlers call prf_gattq_rsp().
+#define PRF_GATTQ_TASK(idx)         KE_BUILD_ID(TASK_APP, 1 + (idx))
+
+/// GATT client queue counters
+struct prf_gattq_stat
+{
+    /// Reads and writes queued
+    uint32_t op;
+    /// ATT requests sent for them, Read Multiple requests among them
+    uint32_t req;
+    uint32_t mult;
+    /// Write commands, sent without waiting
+    uint32_t cmd;
+    /// Reads and writes sent directly because the queue was full
+    uint32_t full;
+    /// Segments of the long reads and writes, see prf_gattq_read_long()
+    uint32_t seg;
+};
+#endif // (QN_GATT_QUEUE)
+
 /**
  ****************************************************************************************
  * @brief Request  peer device to read an attribute
@@ -140,12 +226,14 @@ void prf_unpack_char_pres_fmt(const uint8_t *packed_val, struct prf_char_pres_fm
  * @param ehdl     Search End Handle
  *
  * @param valhdl   Value Handle
+ * @param len      Length of the value, 0 if variable. With CFG_GATT_QUEUE, reads of known
+ *                 length queued together go in one Read Multiple request.
  *
  * @note: if attribute is invalid, nothing is registered
  ****************************************************************************************
  */
 void prf_read_char_send(struct prf_con_info* con_info,
-                        uint16_t shdl, uint16_t ehdl, uint16_t valhdl);
+                        uint16_t shdl, uint16_t ehdl, uint16_t valhdl, uint8_t len);
 
 
 /**
@@ -388,6 +476,161 @@ void prf_search_descs(uint8_t nb_descs,
 void prf_client_disable_ind_send(prf_env_struct ***p_envs, ke_msg_id_t msg_id,
                                  ke_task_id_t task_id, uint8_t state);
 
+/**
+ ****************************************************************************************
+ * @brief Add the notified characteristics of a client to the notification table of its
+ * connection, called once the handles are known (discovery or bond data).
+ *
+ * The table is indexed by value handle, the client finds the characteristic of a
+ * notification with prf_ntf_char_get() instead of comparing every handle it knows, and
+ * a notification the GATT delivered to the application reaches its client with
+ * prf_ntf_forward().
+ *
+ * @param con_info      Connection information of the client task
+ * @param chars         Characteristics of the client
+ * @param nb_chars      Number of characteristics
+ * @param code_base     Code of the first characteristic, the others follow
+ ****************************************************************************************
+ */
+void prf_ntf_register(struct prf_con_info const *con_info, struct prf_char_inf const *chars,
+                      uint8_t nb_chars, uint8_t code_base);
+
+/**
+ ****************************************************************************************
+ * @brief Remove the characteristics of a client task from the notification table.
+ ****************************************************************************************
+ */
+void prf_ntf_unregister(struct prf_con_info const *con_info);
+
+/**
+ ****************************************************************************************
+ * @brief Characteristic of a notification.
+ *
+ * @param conhdl        Connection handle of the notification
+ * @param handle        Value handle of the notification
+ * @param task          Task which received the notification
+ *
+ * @return Characteristic code given to prf_ntf_register(), PRF_NTF_CHAR_NONE if the task
+ *         does not own the handle.
+ ****************************************************************************************
+ */
+uint8_t prf_ntf_char_get(uint16_t conhdl, uint16_t handle, ke_task_id_t task);
+
+/**
+ ****************************************************************************************
+ * @brief Forward a notification received by the application to the client task owning it.
+ *
+ * @return true if the notification was forwarded, the message must not be freed then.
+ ****************************************************************************************
+ */
+bool prf_ntf_forward(struct gatt_handle_value_notif const *param);
+
+/**
+ ****************************************************************************************
+ * @brief Notification dispatch counters.
+ ****************************************************************************************
+ */
+struct prf_ntf_stat const *prf_ntf_stat_get(void);
+
+#if (QN_GATT_QUEUE)
+/**
+ ****************************************************************************************
+ * @brief Queue a characteristic read.
+ *
+ * The queue of each connection is served in order with one ATT request in flight, the
+ * responses carry no connection handle. Consecutive reads of known length are sent as a
+ * single Read Multiple request. The owner receives a GATT_READ_CHAR_RESP for each read,
+ * as if it had sent the request itself.
+ *
+ * prf_read_char_send() and prf_gatt_write() queue their request, a profile which sends
+ * its whole setup sequence at once must tell its responses apart without last_char_code.
+ *
+ * @param owner         Task receiving the response
+ * @param conhdl        Connection handle
+ * @param handle        Value handle
+ * @param len           Length of the value, 0 if unknown
+ *
+ * @return false if the queue of the connection is full
+ ****************************************************************************************
+ */
+bool prf_gattq_read(ke_task_id_t owner, uint16_t conhdl, uint16_t handle, uint8_t len);
+
+/**
+ ****************************************************************************************
+ * @brief Queue a characteristic or descriptor write.
+ *
+ * GATT_WRITE_CHAR and GATT_WRITE_DESC are answered with a GATT_WRITE_CHAR_RESP to the
+ * owner. GATT_WRITE_NO_RESPONSE commands are sent as soon as the requests before them
+ * are answered, several of them back to back.
+ *
+ * @return false if the queue of the connection is full or the request type not queued
+ ****************************************************************************************
+ */
+bool prf_gattq_write(ke_task_id_t owner, uint16_t conhdl, uint16_t handle,
+                     uint8_t const *value, uint16_t length, uint8_t req_type);
+
+#if (QN_LONG_WRITE)
+/**
+ ****************************************************************************************
+ * @brief Queue the read of a value longer than a GATT long read.
+ *
+ * The GATT reads at most ATTM_MAX_LONG_VALUE bytes per long read, the value is read in
+ * as many of them as needed, at increasing offsets, straight into the GATT_READ_CHAR_RESP
+ * of the owner, allocated for max_len bytes when the read starts. The owner receives it
+ * with the whole value, an error status ATT_ERR_INVALID_ATTRIBUTE_VAL_LEN if the value
+ * is longer than max_len.
+ *
+ * @param[in] max_len   Largest length of the value, at most PRF_LONG_VALUE_MAX
+ *
+ * @return false if the queue is full, the heap too, or a long read or write of the
+ *         connection is already queued
+ ****************************************************************************************
+ */
+bool prf_gattq_read_long(ke_task_id_t owner, uint16_t conhdl, uint16_t handle, uint16_t max_len);
+
+/**
+ ****************************************************************************************
+ * @brief Queue the write of a value longer than a GATT long write.
+ *
+ * The value is copied to the heap until the write ends and prepared in segments of whole
+ * (MTU - 5) byte Prepare Write
+ * requests, the last segment executes the queue of the peer, so the value is committed
+ * at once. If a segment fails, the prepared writes are cancelled. The owner receives a
+ * single GATT_WRITE_CHAR_RESP. prf_gattq_write() of a GATT_WRITE_LONG_CHAR comes here.
+ *
+ * @return false if the queue or the heap is full, the value longer than
+ *         PRF_LONG_VALUE_MAX or a long read or write of the connection is already queued
+ ****************************************************************************************
+ */
+bool prf_gattq_write_long(ke_task_id_t owner, uint16_t conhdl, uint16_t handle,
+                          uint8_t const *value, uint16_t length);
+#endif // (QN_LONG_WRITE)
+
+/**
+ ****************************************************************************************
+ * @brief Response of the GATT to PRF_GATTQ_TASK(), hands it over to the owners of the
+ * request in flight and sends the next one.
+ *
+ * Called first by the TASK_APP handlers of GATT_READ_CHAR_RESP,
+ * GATT_READ_CHAR_MULT_RESP, GATT_WRITE_CHAR_RESP, GATT_CANCEL_WRITE_CHAR_RESP and
+ * GATT_CMP_EVT. Only a response of the type the request in flight of that connection
+ * expects ends it, the others are dropped.
+ *
+ * @param[in] dest_id   Task instance the response was sent to
+ *
+ * @return true if the response was sent to the queue, the handler only frees it then.
+ ****************************************************************************************
+ */
+bool prf_gattq_rsp(ke_msg_id_t const msgid, void const *param, ke_task_id_t const dest_id);
+
+/**
+ ****************************************************************************************
+ * @brief GATT client queue counters.
+ ****************************************************************************************
+ */
+struct prf_gattq_stat const *prf_gattq_stat_get(void);
+#endif // (QN_GATT_QUEUE)
+
 #endif //(BLE_ATTC)
 
 #if (BLE_ATTC || BLE_TIP_SERVER || BLE_AN_SERVER || BLE_PAS_SERVER)
@@ -490,6 +733,30 @@ void prf_client_enable_error(prf_env_struct ***p_envs, ke_task_id_t prf_task_id,
 void prf_server_error_ind_send(prf_env_struct *p_env, uint8_t status,
                                ke_msg_id_t ind_msg_id, ke_msg_id_t msg_id);
 
+#if (QN_LONG_WRITE)
+/**
+ ****************************************************************************************
+ * @brief Reassemble a value written with prepared writes.
+ *
+ * The GATT hands the prepared writes over on execution, one GATT_WRITE_CMD_IND per
+ * segment, the last one flagged. They are gathered in the buffer of the server, sized
+ * for the largest value of its attributes, a segment out of order or beyond it fails and
+ * the whole value is dropped. A write which is not long is a single last segment.
+ *
+ * @param[in]  wr       Write in progress, zeroed by the server when it is enabled
+ * @param[in]  buf      Buffer of the value
+ * @param[in]  size     Size of buf, the largest length of the attribute value
+ * @param[in]  param    Write indication
+ * @param[out] value    Complete value, NULL until the last segment has been received
+ * @param[out] length   Length of the complete value
+ *
+ * @return ATT status for the write response
+ ****************************************************************************************
+ */
+uint8_t prf_long_wr_ind(struct prf_long_wr *wr, uint8_t *buf, uint16_t size,
+                        struct gatt_write_cmd_ind const *param, uint8_t **value, uint16_t *length);
+#endif // (QN_LONG_WRITE)
+
 #endif //(BLE_ATTS)
 
 #if (BLE_ATTS || BLE_ATTC)
@@ -152,7 +152,7 @@ static int proxm_rd_alert_lvl_req_handler(ke_msg_id_t const msgid,
             // Send Read Char. request
             prf_read_char_send(&proxm_env->con_info,
                                proxm_env->lls.svc.shdl, proxm_env->lls.svc.ehdl,
-                               proxm_env->lls.charact.val_hdl);
+                               proxm_env->lls.charact.val_hdl, sizeof(uint8_t));
         }
         else
         {
@@ -197,7 +197,7 @@ static int proxm_rd_txpw_lvl_req_handler(ke_msg_id_t const msgid,
             // Send Read Char. request
             prf_read_char_send(&proxm_env->con_info,
                                proxm_env->txps.svc.shdl, proxm_env->txps.svc.ehdl,
-                               proxm_env->txps.charact.val_hdl);
+                               proxm_env->txps.charact.val_hdl, sizeof(int8_t));
         }
         else
         {
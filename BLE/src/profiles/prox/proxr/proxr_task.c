@@ -43,19 +43,14 @@
 
 /**
  ****************************************************************************************
- * @brief Handles reception of the @ref PROXR_CREATE_DB_REQ message.
- * The handler adds LLS and optionally TXPS into the database.
- * @param[in] msgid Id of the message received (probably unused).
- * @param[in] param Pointer to the parameters of the message.
- * @param[in] dest_id ID of the receiving task instance (probably unused).
- * @param[in] src_id ID of the sending task instance.
- * @return If the message was consumed or not.
+ * @brief Create the PROXR attribute database.
+ * Used by the @ref PROXR_CREATE_DB_REQ handler, and directly by the application when
+ * the database is created without kernel messages.
+ * @param[in] param Pointer to the database configuration.
+ * @return Database creation status.
  ****************************************************************************************
  */
-static int proxr_create_db_req_handler(ke_msg_id_t const msgid,
-                                       struct proxr_create_db_req const *param,
-                                       ke_task_id_t const dest_id,
-                                       ke_task_id_t const src_id)
+uint8_t proxr_create_db(struct proxr_create_db_req const *param)
 {
     //Database Creation Status
     uint8_t status;
@@ -69,7 +64,7 @@ static int proxr_create_db_req_handler(ke_msg_id_t const msgid,
 
     //Add Service Into Database
     status = atts_svc_create_db(&proxr_env.lls_shdl, NULL, LLS_IDX_NB, NULL,
-                               dest_id, &proxr_lls_att_db[0]);
+                               TASK_PROXR, &proxr_lls_att_db[0]);
     //Disable LLS
     attsdb_svc_set_permission(proxr_env.lls_shdl, PERM(SVC, DISABLE));
 
@@ -81,13 +76,13 @@ static int proxr_create_db_req_handler(ke_msg_id_t const msgid,
     {
         //Add IAS Into Database
         status = atts_svc_create_db(&proxr_env.ias_shdl, NULL, IAS_IDX_NB, NULL,
-                                   dest_id, &proxr_ias_att_db[0]);
+                                   TASK_PROXR, &proxr_ias_att_db[0]);
         //Disable IAS
         attsdb_svc_set_permission(proxr_env.ias_shdl, PERM(SVC, DISABLE));
 
         //Add TXPS Into Database
         status = atts_svc_create_db(&proxr_env.txps_shdl, NULL, TXPS_IDX_NB, NULL,
-                                   dest_id, &proxr_txps_att_db[0]);
+                                   TASK_PROXR, &proxr_txps_att_db[0]);
         //Disable TXPS
         attsdb_svc_set_permission(proxr_env.txps_shdl, PERM(SVC, DISABLE));
     }
@@ -99,6 +94,28 @@ static int proxr_create_db_req_handler(ke_msg_id_t const msgid,
         ke_state_set(TASK_PROXR, PROXR_IDLE);
     }
 
+    return (status);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Handles reception of the @ref PROXR_CREATE_DB_REQ message.
+ * The handler adds LLS and optionally TXPS into the database.
+ * @param[in] msgid Id of the message received (probably unused).
+ * @param[in] param Pointer to the parameters of the message.
+ * @param[in] dest_id ID of the receiving task instance (probably unused).
+ * @param[in] src_id ID of the sending task instance.
+ * @return If the message was consumed or not.
+ ****************************************************************************************
+ */
+static int proxr_create_db_req_handler(ke_msg_id_t const msgid,
+                                       struct proxr_create_db_req const *param,
+                                       ke_task_id_t const dest_id,
+                                       ke_task_id_t const src_id)
+{
+    //Database Creation Status
+    uint8_t status = proxr_create_db(param);
+
     //Send CFM to application
     struct proxr_create_db_cfm * cfm = KE_MSG_ALLOC(PROXR_CREATE_DB_CFM, src_id,
                                                     TASK_PROXR, proxr_create_db_cfm);
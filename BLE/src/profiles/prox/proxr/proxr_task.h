@@ -174,6 +174,8 @@ extern ke_state_t proxr_state[PROXR_IDX_MAX];
 
 extern void task_proxr_desc_register(void);
 
+extern uint8_t proxr_create_db(struct proxr_create_db_req const *param);
+
 #endif //BLE_PROX_REPORTER
 
 /// @} PROXRTASK
@@ -366,7 +366,9 @@ static int qppc_rd_char_req_handler(ke_msg_id_t const msgid,
         //check if handle is variable
         if (search_hdl != ATT_INVALID_SEARCH_HANDLE)
         {
-            prf_read_char_send(&(qppc_env->con_info), qppc_env->qpps.svc.shdl, qppc_env->qpps.svc.ehdl, search_hdl);
+            // The user description has no fixed length, the others are client configurations
+            prf_read_char_send(&(qppc_env->con_info), qppc_env->qpps.svc.shdl, qppc_env->qpps.svc.ehdl, search_hdl,
+                               (param->char_code == QPPC_QPPS_RX_CHAR_VALUE_USER_DESP) ? 0 : PRF_CCC_DESC_LEN);
         }
         else
         {
@@ -65,18 +65,6 @@
  */
 
 
-/**
- ****************************************************************************************
- * @brief Handles reception of the @ref QPPS_CREATE_DB_REQ message.
- * The handler adds Quintic private service into the database using the database
- * configuration value given in param.
- * @param[in] msgid Id of the message received (probably unused).
- * @param[in] param Pointer to the parameters of the message.
- * @param[in] dest_id ID of the receiving task instance (probably unused).
- * @param[in] src_id ID of the sending task instance.
- * @return If the message was consumed or not.
- ****************************************************************************************
- */
  //warning: initialiing 'uint8_t *' (aka 'unsigned char *') with an expression of type 'char[17] converts between pointers to integer types with different sign
 
 uint8_t *qpp_uuid_list[] = 
@@ -90,10 +78,17 @@ uint8_t *qpp_uuid_list[] =
     (uint8_t *)"\x07\x96\x12\x16\x54\x92\x75\xB5\xA2\x45\xFD\xAB\x39\xC4\x4B\xD4",
 };
 
-static int qpps_create_db_req_handler(ke_msg_id_t const msgid,
-                                      struct qpps_create_db_req const *param,
-                                      ke_task_id_t const dest_id,
-                                      ke_task_id_t const src_id)
+/**
+ ****************************************************************************************
+ * @brief Create the QPPS attribute database.
+ * Used by the @ref QPPS_CREATE_DB_REQ handler, and directly by the application when
+ * the database is created without kernel messages.
+ * @param[in] param Pointer to the database configuration.
+ * @param[in] appid Task which receives the QPPS indications.
+ * @return Database creation status.
+ ****************************************************************************************
+ */
+uint8_t qpps_create_db(struct qpps_create_db_req const *param, ke_task_id_t const appid)
 {
     //Service Configuration Flag
     uint64_t cfg_flag = QPPS_MANDATORY_MASK;
@@ -108,7 +103,7 @@ static int qpps_create_db_req_handler(ke_msg_id_t const msgid,
         tx_char_num = 7;
 
     //Save Application ID
-    qpps_env.appid = src_id;
+    qpps_env.appid = appid;
     qpps_env.ntf_char_num = tx_char_num;
     /*---------------------------------------------------*
      * Quintic private Service Creation
@@ -147,7 +142,7 @@ static int qpps_create_db_req_handler(ke_msg_id_t const msgid,
     }
     //Add Service Into Database
     status = atts_svc_create_db_ext(&qpps_env.shdl, (uint8_t *)&cfg_flag, idx_nb, NULL,
-                               dest_id, (param->tx_char_num <= 1 ? &qpps_att_db[0] : &qpps_db[0]));
+                               TASK_QPPS, (param->tx_char_num <= 1 ? &qpps_att_db[0] : &qpps_db[0]));
 
     if (qpps_db != NULL)
         ke_free(qpps_db);
@@ -164,6 +159,29 @@ static int qpps_create_db_req_handler(ke_msg_id_t const msgid,
         ke_state_set(TASK_QPPS, QPPS_IDLE);
     }
 
+    return (status);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Handles reception of the @ref QPPS_CREATE_DB_REQ message.
+ * The handler adds Quintic private service into the database using the database
+ * configuration value given in param.
+ * @param[in] msgid Id of the message received (probably unused).
+ * @param[in] param Pointer to the parameters of the message.
+ * @param[in] dest_id ID of the receiving task instance (probably unused).
+ * @param[in] src_id ID of the sending task instance.
+ * @return If the message was consumed or not.
+ ****************************************************************************************
+ */
+static int qpps_create_db_req_handler(ke_msg_id_t const msgid,
+                                      struct qpps_create_db_req const *param,
+                                      ke_task_id_t const dest_id,
+                                      ke_task_id_t const src_id)
+{
+    //Database Creation Status
+    uint8_t status = qpps_create_db(param, src_id);
+
     //Send response to application
     struct qpps_create_db_cfm * cfm = KE_MSG_ALLOC(QPPS_CREATE_DB_CFM, qpps_env.appid,
                                                    TASK_QPPS, qpps_create_db_cfm);
@@ -370,7 +388,7 @@ static int gatt_write_cmd_ind_handler(ke_msg_id_t const msgid,
                 struct qpps_data_val_ind * ind = KE_MSG_ALLOC_DYN(QPPS_DAVA_VAL_IND,
                                                                   qpps_env.appid,
                                                                   TASK_QPPS,
-                                                                  qpps_data_val_ind, param->length);
+                                                                  qpps_data_val_ind, PRF_MSG_LEN_CLASS(param->length));
 
                 memcpy(&ind->conhdl, &(qpps_env.conhdl), sizeof(uint16_t));
                 //Send received data to app value
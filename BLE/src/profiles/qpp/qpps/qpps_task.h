@@ -239,6 +239,8 @@ extern ke_state_t qpps_state[QPPS_IDX_MAX];
 
 extern void task_qpps_desc_register(void);
 
+extern uint8_t qpps_create_db(struct qpps_create_db_req const *param, ke_task_id_t const appid);
+
 #endif /* BLE_QPP_SERVER */
 
 /// @} QPPSTASK
@@ -160,6 +160,7 @@ static int rscpc_enable_cmd_handler(ke_msg_id_t const msgid,
 
             // Register in GATT for notifications/indications
             prf_register_atthdl2gatt(&rscpc_env->con_info, &rscpc_env->rscs.svc);
+            prf_ntf_register(&rscpc_env->con_info, rscpc_env->rscs.chars, RSCP_RSCS_CHAR_MAX, 0);
 
             // Send a complete event status to the application
             rscpc_send_cmp_evt(rscpc_env, RSCPC_ENABLE_OP_CODE, PRF_ERR_OK);
@@ -205,6 +206,8 @@ static int rscpc_read_cmd_handler(ke_msg_id_t const msgid,
         uint8_t status     = PRF_ERR_OK;
         // Attribute Handle
         uint16_t handle    = ATT_INVALID_SEARCH_HANDLE;
+        // Length of the value
+        uint8_t len        = 0;
 
         // State is Connected or Busy
         ASSERT_ERR(ke_state_get(dest_id) != RSCPC_IDLE);
@@ -228,24 +231,28 @@ static int rscpc_read_cmd_handler(ke_msg_id_t const msgid,
                     case (RSCPC_RD_RSC_FEAT):
                     {
                         handle = rscpc_env->rscs.chars[RSCP_RSCS_RSC_FEAT_CHAR].val_hdl;
+                        len    = sizeof(uint16_t);
                     } break;
 
                     // Read Sensor Location
                     case (RSCPC_RD_SENSOR_LOC):
                     {
                         handle = rscpc_env->rscs.chars[RSCP_RSCS_SENSOR_LOC_CHAR].val_hdl;
+                        len    = sizeof(uint8_t);
                     } break;
 
                     // Read RSC Measurement Characteristic Client Char. Cfg. Descriptor Value
                     case (RSCPC_RD_WR_RSC_MEAS_CFG):
                     {
                         handle = rscpc_env->rscs.descs[RSCPC_DESC_RSC_MEAS_CL_CFG].desc_hdl;
+                        len    = PRF_CCC_DESC_LEN;
                     } break;
 
                     // Read Unread Alert Characteristic Client Char. Cfg. Descriptor Value
                     case (RSCPC_RD_WR_SC_CTNL_PT_CFG):
                     {
                         handle = rscpc_env->rscs.descs[RSCPC_DESC_SC_CTNL_PT_CL_CFG].desc_hdl;
+                        len    = PRF_CCC_DESC_LEN;
                     } break;
 
                     default:
@@ -266,7 +273,7 @@ static int rscpc_read_cmd_handler(ke_msg_id_t const msgid,
 
                     // Send the read request
                     prf_read_char_send(&(rscpc_env->con_info), rscpc_env->rscs.svc.shdl,
-                                       rscpc_env->rscs.svc.ehdl, handle);
+                                       rscpc_env->rscs.svc.ehdl, handle, len);
 
                     // Go to the Busy state
                     ke_state_set(dest_id, RSCPC_BUSY);
@@ -810,6 +817,7 @@ static int gatt_cmp_evt_handler(ke_msg_id_t const msgid,
 
                         // Register in GATT for notifications/indications
                         prf_register_atthdl2gatt(&rscpc_env->con_info, &rscpc_env->rscs.svc);
+                        prf_ntf_register(&rscpc_env->con_info, rscpc_env->rscs.chars, RSCP_RSCS_CHAR_MAX, 0);
 
                         // Send the content of the service to the HL
                         struct rscpc_rscs_content_ind *ind = KE_MSG_ALLOC(RSCPC_RSCS_CONTENT_IND,
@@ -1002,7 +1010,8 @@ static int gatt_handle_value_ntf_handler(ke_msg_id_t const msgid,
     // Get the address of the environment
     struct rscpc_env_tag *rscpc_env = PRF_CLIENT_GET_ENV(dest_id, rscpc);
 
-    if (rscpc_env != NULL)
+    if ((rscpc_env != NULL)
+     && (prf_ntf_char_get(param->conhdl, param->charhdl, dest_id) == RSCP_RSCS_RSC_MEAS_CHAR))
     {
         // Offset
         uint8_t offset = RSCP_RSC_MEAS_MIN_LEN;
@@ -109,18 +109,14 @@ static const struct atts_desc rscps_att_db[RSCS_IDX_NB] =
 
 /**
  ****************************************************************************************
- * @brief Handles reception of the @ref RSCPS_CREATE_DB_REQ message.
- * @param[in] msgid Id of the message received.
- * @param[in] param Pointer to the parameters of the message.
- * @param[in] dest_id ID of the receiving task instance
- * @param[in] src_id ID of the sending task instance.
- * @return If the message was consumed or not.
+ * @brief Create the RSCPS attribute database.
+ * Used by the @ref RSCPS_CREATE_DB_REQ handler, and directly by the application when
+ * the database is created without kernel messages.
+ * @param[in] param Pointer to the database configuration.
+ * @return Database creation status.
  ****************************************************************************************
  */
-static int rscps_create_db_req_handler(ke_msg_id_t const msgid,
-                                       struct rscps_create_db_req *param,
-                                       ke_task_id_t const dest_id,
-                                       ke_task_id_t const src_id)
+uint8_t rscps_create_db(struct rscps_create_db_req *param)
 {
     // Service Configuration Flag
     uint16_t cfg_flag = RSCPS_MANDATORY_MASK;
@@ -153,7 +149,7 @@ static int rscps_create_db_req_handler(ke_msg_id_t const msgid,
 
         // Add service in the database
         status = atts_svc_create_db(&rscps_env.shdl, (uint8_t *)&cfg_flag, RSCS_IDX_NB,
-                                    &rscps_env.hdl_offset[0], dest_id, &rscps_att_db[0]);
+                                    &rscps_env.hdl_offset[0], TASK_RSCPS, &rscps_att_db[0]);
 
         // Check if an error has occured
         if (status == ATT_ERR_NO_ERROR)
@@ -195,6 +191,27 @@ static int rscps_create_db_req_handler(ke_msg_id_t const msgid,
         status = PRF_ERR_REQ_DISALLOWED;
     }
 
+    return (status);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Handles reception of the @ref RSCPS_CREATE_DB_REQ message.
+ * @param[in] msgid Id of the message received.
+ * @param[in] param Pointer to the parameters of the message.
+ * @param[in] dest_id ID of the receiving task instance
+ * @param[in] src_id ID of the sending task instance.
+ * @return If the message was consumed or not.
+ ****************************************************************************************
+ */
+static int rscps_create_db_req_handler(ke_msg_id_t const msgid,
+                                       struct rscps_create_db_req *param,
+                                       ke_task_id_t const dest_id,
+                                       ke_task_id_t const src_id)
+{
+    //Database Creation Status
+    uint8_t status = rscps_create_db(param);
+
     // Send complete event message to the application
     rscps_send_cmp_evt(TASK_RSCPS, src_id, GAP_INVALID_CONHDL, RSCPS_CREATE_DB_OP_CODE, status);
 
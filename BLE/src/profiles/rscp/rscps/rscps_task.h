@@ -269,6 +269,8 @@ extern ke_state_t rscps_state[RSCPS_IDX_MAX];
 
 extern void task_rscps_desc_register(void);
 
+extern uint8_t rscps_create_db(struct rscps_create_db_req *param);
+
 #endif //(BLE_RSC_SENSOR)
 
 /// @} RSCPSTASK
@@ -241,7 +241,8 @@ static int scppc_scan_refresh_ntf_cfg_rd_req_handler(ke_msg_id_t const msgid,
         prf_read_char_send(&(scppc_env->con_info),
                            scppc_env->scps.svc.shdl,
                            scppc_env->scps.svc.ehdl,
-                           scppc_env->scps.descs[SCPPC_DESC_SCAN_REFRESH_CFG].desc_hdl);
+                           scppc_env->scps.descs[SCPPC_DESC_SCAN_REFRESH_CFG].desc_hdl,
+                           PRF_CCC_DESC_LEN);
     }
     else
     {
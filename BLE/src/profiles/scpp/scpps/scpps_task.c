@@ -45,19 +45,14 @@
 
 /**
  ****************************************************************************************
- * @brief Handles reception of the @ref SCPPS_CREATE_DB_REQ message.
- * The handler adds SCPS into the database using value of the features param.
- * @param[in] msgid Id of the message received (probably unused).
- * @param[in] param Pointer to the parameters of the message.
- * @param[in] dest_id ID of the receiving task instance (probably unused).
- * @param[in] src_id ID of the sending task instance.
- * @return If the message was consumed or not.
+ * @brief Create the SCPPS attribute database.
+ * Used by the @ref SCPPS_CREATE_DB_REQ handler, and directly by the application when
+ * the database is created without kernel messages.
+ * @param[in] param Pointer to the database configuration.
+ * @return Database creation status.
  ****************************************************************************************
  */
-static int scpps_create_db_req_handler(ke_msg_id_t const msgid,
-                                       struct scpps_create_db_req const *param,
-                                       ke_task_id_t const dest_id,
-                                       ke_task_id_t const src_id)
+uint8_t scpps_create_db(struct scpps_create_db_req const *param)
 {
     // Service Configuration Flag
     uint8_t cfg_flag = SCPPS_CFG_FLAG_MANDATORY_MASK;
@@ -80,7 +75,7 @@ static int scpps_create_db_req_handler(ke_msg_id_t const msgid,
 
     // Add Service Into Database
     status = atts_svc_create_db(&scpps_env.shdl, &cfg_flag, SCPS_IDX_NB, NULL,
-                                dest_id, &scpps_att_db[0]);
+                                TASK_SCPPS, &scpps_att_db[0]);
     // Disable SCPPS
     attsdb_svc_set_permission(scpps_env.shdl, PERM(SVC, DISABLE));
 
@@ -92,6 +87,28 @@ static int scpps_create_db_req_handler(ke_msg_id_t const msgid,
         ke_state_set(TASK_SCPPS, SCPPS_IDLE);
     }
 
+    return (status);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Handles reception of the @ref SCPPS_CREATE_DB_REQ message.
+ * The handler adds SCPS into the database using value of the features param.
+ * @param[in] msgid Id of the message received (probably unused).
+ * @param[in] param Pointer to the parameters of the message.
+ * @param[in] dest_id ID of the receiving task instance (probably unused).
+ * @param[in] src_id ID of the sending task instance.
+ * @return If the message was consumed or not.
+ ****************************************************************************************
+ */
+static int scpps_create_db_req_handler(ke_msg_id_t const msgid,
+                                       struct scpps_create_db_req const *param,
+                                       ke_task_id_t const dest_id,
+                                       ke_task_id_t const src_id)
+{
+    //Database Creation Status
+    uint8_t status = scpps_create_db(param);
+
     // Send response to application
     struct scpps_create_db_cfm * cfm = KE_MSG_ALLOC(SCPPS_CREATE_DB_CFM, src_id,
                                                     TASK_SCPPS, scpps_create_db_cfm);
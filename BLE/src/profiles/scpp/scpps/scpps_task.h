@@ -194,6 +194,8 @@ extern ke_state_t scpps_state[SCPPS_IDX_MAX];
 
 extern void task_scpps_desc_register(void);
 
+extern uint8_t scpps_create_db(struct scpps_create_db_req const *param);
+
 #endif // BLE_SP_SERVER
 
 /// @} SCPPSTASK
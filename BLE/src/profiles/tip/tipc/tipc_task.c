@@ -94,6 +94,18 @@ const struct prf_char_def tipc_rtus_char[TIPC_CHAR_RTUS_MAX] =
                                             ATT_CHAR_PROP_RD},
 };
 
+/// Lengths of the Current Time Service values, read together on a GATT queue
+static const uint8_t tipc_cts_char_len[TIPC_CHAR_CTS_MAX] =
+{
+    [TIPC_CHAR_CTS_CURR_TIME]        = 10,
+    [TIPC_CHAR_CTS_LOCAL_TIME_INFO]  = 2,
+    [TIPC_CHAR_CTS_REF_TIME_INFO]    = 4,
+};
+
+/// Lengths of the Next DST Change and Reference Time Update Service values
+#define TIPC_NDCS_TIME_WITH_DST_LEN     8
+#define TIPC_RTUS_TIME_UPD_STATE_LEN    2
+
 
 /*
  * LOCAL FUNCTIONS DEFINITIONS
@@ -191,6 +203,8 @@ static int tipc_rd_char_req_handler(ke_msg_id_t const msgid,
 {
     // Attribute Handle
     uint16_t search_hdl = ATT_INVALID_SEARCH_HANDLE;
+    // Length of the value, 0 if unknown
+    uint8_t len = 0;
     // Service
     struct prf_svc *svc;
 
@@ -205,6 +219,7 @@ static int tipc_rd_char_req_handler(ke_msg_id_t const msgid,
         {
             svc = &tipc_env->ndcs.svc;
             search_hdl = tipc_env->ndcs.chars[param->char_code & ~TIPC_CHAR_NDCS_MASK].val_hdl;
+            len = TIPC_NDCS_TIME_WITH_DST_LEN;
         }
         //Reference Time Update Service Characteristic
         else if (((param->char_code & TIPC_CHAR_RTUS_MASK) == TIPC_CHAR_RTUS_MASK) &&
@@ -212,6 +227,10 @@ static int tipc_rd_char_req_handler(ke_msg_id_t const msgid,
         {
             svc = &tipc_env->rtus.svc;
             search_hdl = tipc_env->rtus.chars[param->char_code & ~TIPC_CHAR_RTUS_MASK].val_hdl;
+            if ((param->char_code & ~TIPC_CHAR_RTUS_MASK) == TIPC_CHAR_RTUS_TIME_UPD_STATE)
+            {
+                len = TIPC_RTUS_TIME_UPD_STATE_LEN;
+            }
         }
         else
         {
@@ -222,11 +241,13 @@ static int tipc_rd_char_req_handler(ke_msg_id_t const msgid,
                 ((param->char_code & ~TIPC_DESC_CTS_MASK) < TIPC_DESC_CTS_MAX))
             {
                 search_hdl = tipc_env->cts.descs[param->char_code & ~TIPC_DESC_CTS_MASK].desc_hdl;
+                len = PRF_CCC_DESC_LEN;
             }
             //Current Time Service Characteristic
             else if (param->char_code < TIPC_CHAR_CTS_MAX)
             {
                 search_hdl = tipc_env->cts.chars[param->char_code].val_hdl;
+                len = tipc_cts_char_len[param->char_code];
             }
         }
 
@@ -234,7 +255,7 @@ static int tipc_rd_char_req_handler(ke_msg_id_t const msgid,
         if (search_hdl != ATT_INVALID_SEARCH_HANDLE)
         {
             tipc_env->last_char_code = param->char_code;
-            prf_read_char_send(&(tipc_env->con_info), svc->shdl, svc->ehdl, search_hdl);
+            prf_read_char_send(&(tipc_env->con_info), svc->shdl, svc->ehdl, search_hdl, len);
         }
         else
         {
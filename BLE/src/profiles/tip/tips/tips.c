@@ -211,6 +211,17 @@ void tips_pack_curr_time_value(uint8_t *p_pckd_time, const struct tip_curr_time*
     *(p_pckd_time + 9) = p_curr_time_val->adjust_reason;
 }
 
+uint8_t tips_curr_time_set(const struct tip_curr_time* p_curr_time_val)
+{
+    // Packed Current Time value
+    uint8_t pckd_time[CTS_CURRENT_TIME_VAL_LEN];
+
+    tips_pack_curr_time_value(&pckd_time[0], p_curr_time_val);
+
+    return attsdb_att_set_value(tips_env.cts_shdl + CTS_IDX_CURRENT_TIME_VAL,
+                                CTS_CURRENT_TIME_VAL_LEN, &pckd_time[0]);
+}
+
 void tips_pack_time_dst_value(uint8_t *p_pckd_time_dst, const struct tip_time_with_dst* p_time_dst_val)
 {
     // Date-Time
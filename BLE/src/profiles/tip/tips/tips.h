@@ -251,6 +251,17 @@ void tips_enable_cfm_send(struct prf_con_info *con_info, uint8_t status);
  */
 void tips_pack_curr_time_value(uint8_t *p_pckd_time,
                                const struct tip_curr_time* p_curr_time_val);
+
+/**
+ ****************************************************************************************
+ * @brief Set the Current Time value read by the clients, without notification
+ *
+ * @param p_curr_time_val Current Time value
+ *
+ * @return Status of the database update
+ ****************************************************************************************
+ */
+uint8_t tips_curr_time_set(const struct tip_curr_time* p_curr_time_val);
 /**
  ****************************************************************************************
  * @brief Pack Time With DST value
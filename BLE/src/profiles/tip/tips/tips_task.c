@@ -42,20 +42,14 @@
 
 /**
  ****************************************************************************************
- * @brief Handles reception of the @ref TIPS_CREATE_DB_REQ message.
- * The handler adds CTS, NDCS and RTUS into the database using the database
- * configuration value given in param.
- * @param[in] msgid Id of the message received (probably unused).
- * @param[in] param Pointer to the parameters of the message.
- * @param[in] dest_id ID of the receiving task instance (probably unused).
- * @param[in] src_id ID of the sending task instance.
- * @return If the message was consumed or not.
+ * @brief Create the TIPS attribute database.
+ * Used by the @ref TIPS_CREATE_DB_REQ handler, and directly by the application when
+ * the database is created without kernel messages.
+ * @param[in] param Pointer to the database configuration.
+ * @return Database creation status.
  ****************************************************************************************
  */
-static int tips_create_db_req_handler(ke_msg_id_t const msgid,
-                                      struct tips_create_db_req const *param,
-                                      ke_task_id_t const dest_id,
-                                      ke_task_id_t const src_id)
+uint8_t tips_create_db(struct tips_create_db_req const *param)
 {
     //Service Configuration Flag - For CTS, Current Time Char. is mandatory
     uint8_t cfg_flag = TIPS_CTS_CURRENT_TIME_MASK;
@@ -80,7 +74,7 @@ static int tips_create_db_req_handler(ke_msg_id_t const msgid,
 
     //Add Service Into Database
     status = atts_svc_create_db(&tips_env.cts_shdl, (uint8_t *)&cfg_flag, CTS_IDX_NB, &tips_env.cts_att_tbl[0],
-                                dest_id, &cts_att_db[0]);
+                                TASK_TIPS, &cts_att_db[0]);
     //Disable CTS
     attsdb_svc_set_permission(tips_env.cts_shdl, PERM(SVC, DISABLE));
 
@@ -92,7 +86,7 @@ static int tips_create_db_req_handler(ke_msg_id_t const msgid,
     if ((status == ATT_ERR_NO_ERROR) && (TIPS_IS_SUPPORTED(TIPS_NDCS_SUP)))
     {
         status = atts_svc_create_db(&tips_env.ndcs_shdl, (uint8_t *)&cfg_flag, NDCS_IDX_NB, &tips_env.ndcs_att_tbl[0],
-                                   dest_id, &ndcs_att_db[0]);
+                                   TASK_TIPS, &ndcs_att_db[0]);
 
         //Disable NDCS
         attsdb_svc_set_permission(tips_env.ndcs_shdl, PERM(SVC, DISABLE));
@@ -104,7 +98,7 @@ static int tips_create_db_req_handler(ke_msg_id_t const msgid,
     if ((status == ATT_ERR_NO_ERROR) && (TIPS_IS_SUPPORTED(TIPS_RTUS_SUP)))
     {
         status = atts_svc_create_db(&tips_env.rtus_shdl, (uint8_t *)&cfg_flag, RTUS_IDX_NB, &tips_env.rtus_att_tbl[0],
-                                   dest_id, &rtus_att_db[0]);
+                                   TASK_TIPS, &rtus_att_db[0]);
 
         //Disable RTUS
         attsdb_svc_set_permission(tips_env.rtus_shdl, PERM(SVC, DISABLE));
@@ -117,6 +111,29 @@ static int tips_create_db_req_handler(ke_msg_id_t const msgid,
         ke_state_set(TASK_TIPS, TIPS_IDLE);
     }
 
+    return (status);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Handles reception of the @ref TIPS_CREATE_DB_REQ message.
+ * The handler adds CTS, NDCS and RTUS into the database using the database
+ * configuration value given in param.
+ * @param[in] msgid Id of the message received (probably unused).
+ * @param[in] param Pointer to the parameters of the message.
+ * @param[in] dest_id ID of the receiving task instance (probably unused).
+ * @param[in] src_id ID of the sending task instance.
+ * @return If the message was consumed or not.
+ ****************************************************************************************
+ */
+static int tips_create_db_req_handler(ke_msg_id_t const msgid,
+                                      struct tips_create_db_req const *param,
+                                      ke_task_id_t const dest_id,
+                                      ke_task_id_t const src_id)
+{
+    //Database Creation Status
+    uint8_t status = tips_create_db(param);
+
     //Send response to application
     struct tips_create_db_cfm * cfm = KE_MSG_ALLOC(TIPS_CREATE_DB_CFM, src_id, TASK_TIPS,
                                                    tips_create_db_cfm);
@@ -248,6 +248,8 @@ extern ke_state_t tips_state[TIPS_IDX_MAX];
 
 extern void task_tips_desc_register(void);
 
+extern uint8_t tips_create_db(struct tips_create_db_req const *param);
+
 #endif //BLE_TIP_SERVER
 
 /// @} TIPSTASK
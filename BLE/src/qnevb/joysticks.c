@@ -12,56 +12,216 @@
  * MACRO DEFINITIONS
  ****************************************************************************************
  */
- #define		KEY_SAMPLE_NUMBER		10
- 
- #define		key_up				0x01
- #define		key_right			0x02
- #define		key_down			0x04
- #define		key_left			0x08
- #define		key_center		0x10
+ #define		KEY_SAMPLE_NUMBER		4
  
  /*
  * LOCAL VARIABLE DEFINITIONS
  ****************************************************************************************
  */
-static  int16_t		adc_key_value[10];
-static	int16_t adc_key_value_avg = 0;
-static	int16_t	key_value0 = 0; 
-static	uint8_t adc_done;
+static  int16_t		adc_key_value[KEY_SAMPLE_NUMBER];
+
+/// Upper ADC code of each key of the resistor ladder, in ascending order
+static const struct
+{
+		int16_t max;
+		uint8_t key;
+} key_table[] =
+{
+		{199,		0},
+		{655,		key_up},
+		{1064,	key_right},
+		{1474,	key_down},
+		{1884,	key_left},
+		{2047,	key_center},
+};
+
+button_env usr_button_env = {0,button_idle};
 
  static void adc_test_cb(void)
 {
-    adc_done = 1;
 		ke_evt_set(1UL << EVENT_ADC_KEY_SAMPLE_CMP_ID);
 }
 
-button_env usr_button_env = {0,button_idle};
+/**
+ ****************************************************************************************
+ * @brief Key of an ADC code, 0 if no key is pressed.
+ *
+ ****************************************************************************************
+ */
+static uint8_t app_key_classify(int16_t adc_value)
+{
+		uint8_t i;
 
+		for (i = 0; i < sizeof(key_table)/sizeof(key_table[0]); i++)
+		{
+				if (adc_value <= key_table[i].max)
+						return key_table[i].key;
+		}
+		return 0;
+}
 
+/**
+ ****************************************************************************************
+ * @brief Post a key event to the application task.
+ *
+ ****************************************************************************************
+ */
+static void app_key_post(uint8_t key, uint8_t evt)
+{
+		struct app_key_ind *ind = KE_MSG_ALLOC(APP_KEY_IND, TASK_APP, TASK_APP, app_key_ind);
+
+		ind->key = key;
+		ind->evt = evt;
+		ke_msg_send(ind);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Run the debounce, long press and repeat state machine on one scan.
+ *
+ * @return true while a key is down and scanning has to go on.
+ ****************************************************************************************
+ */
+static bool app_key_scan_step(uint8_t key)
+{
+		button_env *env = &usr_button_env;
+
+		switch (env->scan_st)
+		{
+			case	KEY_SCAN_IDLE:
+			case	KEY_SCAN_DEBOUNCE:
+					if (key == 0)
+					{
+							env->scan_st = KEY_SCAN_IDLE;
+							break;
+					}
+					if (env->scan_st == KEY_SCAN_IDLE || key != env->key)
+					{
+							env->scan_st = KEY_SCAN_DEBOUNCE;
+							env->key = key;
+							env->cnt = 0;
+					}
+					if (++env->cnt >= KEY_DEBOUNCE_CNT)
+					{
+							env->scan_st = KEY_SCAN_PRESSED;
+							env->cnt = 0;
+							env->joystick_dir = key;
+							app_key_post(key, KEY_EVT_PRESS);
+					}
+					break;
+
+			case	KEY_SCAN_PRESSED:
+			case	KEY_SCAN_LONG:
+					if (key != env->key)
+					{
+							// Released, or slid to another key which is debounced again
+							app_key_post(env->key, KEY_EVT_RELEASE);
+							env->scan_st = KEY_SCAN_IDLE;
+							return app_key_scan_step(key);
+					}
+					env->cnt++;
+					if (env->scan_st == KEY_SCAN_PRESSED && env->cnt >= KEY_LONG_CNT)
+					{
+							env->scan_st = KEY_SCAN_LONG;
+							env->cnt = 0;
+							app_key_post(key, KEY_EVT_LONG);
+					}
+					else if (env->scan_st == KEY_SCAN_LONG && env->cnt >= KEY_REPEAT_CNT)
+					{
+							env->cnt = 0;
+							app_key_post(key, KEY_EVT_REPEAT);
+					}
+					break;
+
+			default:
+					env->scan_st = KEY_SCAN_IDLE;
+					break;
+		}
+
+		return (env->scan_st != KEY_SCAN_IDLE);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Start one non blocking key scan, the ADC callback ends it in background.
+ *
+ * Started by the button GPIO interrupt, then every KEY_SCAN_PERIOD while a key is down.
+ *
+ ****************************************************************************************
+ */
 int app_key_scan_timer_handler(ke_msg_id_t const msgid, void const *param,
                                ke_task_id_t const dest_id, ke_task_id_t const src_id)
 {
-		if (gpio_read_pin(BUTTON1_PIN) == GPIO_LOW)
+		adc_read_configuration read_cfg;
+
+		if (usr_button_env.scan_st == KEY_SCAN_IDLE)
 		{
+				if (gpio_read_pin(BUTTON1_PIN) != GPIO_LOW)
+				{
+						// Bounce only
+						usr_button_env.button_st = button_release;
+						gpio_enable_interrupt(BUTTON1_PIN);
+						return(KE_MSG_CONSUMED);
+				}
+				// The ADC stays on until the key is released
 				adc_init(ADC_SINGLE_WITHOUT_BUF_DRV, ADC_CLK_1000000, ADC_INT_REF, ADC_12BIT);
-				
-				// Read voltage. use interrupt
-				adc_read_configuration read_cfg;
-				read_cfg.trig_src = ADC_TRIG_SOFT;
-				read_cfg.mode = SINGLE_MOD;
-				read_cfg.start_ch = AIN0;
-				read_cfg.end_ch = AIN0;
-				adc_read(&read_cfg,adc_key_value, KEY_SAMPLE_NUMBER, adc_test_cb);
-				while(adc_done == 0);
-		}	
+		}
+
+		read_cfg.trig_src = ADC_TRIG_SOFT;
+		read_cfg.mode = SINGLE_MOD;
+		read_cfg.start_ch = AIN0;
+		read_cfg.end_ch = AIN0;
+		adc_read(&read_cfg, adc_key_value, KEY_SAMPLE_NUMBER, adc_test_cb);
+
 		return(KE_MSG_CONSUMED);
 }
 
-int app_key_process_timer_handler(ke_msg_id_t const msgid, void const *param,
+/**
+ ****************************************************************************************
+ * @brief Classify the samples of a scan and step the key state machine.
+ *
+ ****************************************************************************************
+ */
+void app_event_adc_key_sample_cmp_handler(void)
+{		
+		uint8_t i;
+		int32_t sum = 0;
+		uint8_t key = 0;
+
+		ke_evt_clear(1UL << EVENT_ADC_KEY_SAMPLE_CMP_ID);
+
+		for (i = 0; i < KEY_SAMPLE_NUMBER; i++)
+				sum += adc_key_value[i];
+
+		if (gpio_read_pin(BUTTON1_PIN) == GPIO_LOW)
+				key = app_key_classify(sum / KEY_SAMPLE_NUMBER);
+
+		if (app_key_scan_step(key))
+		{
+				ke_timer_set(APP_KEY_SCAN_TIMER, TASK_APP, KEY_SCAN_PERIOD);
+		}
+		else
+		{
+				adc_clock_off();
+				adc_power_off();
+				usr_button_env.button_st = button_release;
+				gpio_enable_interrupt(BUTTON1_PIN);
+		}
+}
+
+/**
+ ****************************************************************************************
+ * @brief Handles the key events of the joystick.
+ *
+ ****************************************************************************************
+ */
+int app_key_ind_handler(ke_msg_id_t const msgid, struct app_key_ind const *param,
                                ke_task_id_t const dest_id, ke_task_id_t const src_id)
 {
-		ke_evt_clear(1UL << EVENT_ADC_KEY_SAMPLE_CMP_ID);
-		switch(key_value0)
+		if (param->evt != KEY_EVT_PRESS)
+				return(KE_MSG_CONSUMED);
+
+		switch(param->key)
 		{
 			
 			case	key_up:
@@ -99,7 +259,6 @@ int app_key_process_timer_handler(ke_msg_id_t const msgid, void const *param,
 								OLED_ShowString(0,4, "                ");
 								OLED_ShowString(0,4,"    key_up!     ");
 #endif
-								key_value0 = 0;
 								break;
 								
 			case	key_left:
@@ -109,7 +268,6 @@ int app_key_process_timer_handler(ke_msg_id_t const msgid, void const *param,
 								OLED_ShowString(0,4,"    key_left!   ");
 #endif
 								led_set(2,LED_ON);
-								key_value0 = 0;
 						break;
 			case	key_center:
 								QPRINTF("\r\nkey_center!\r\n");
@@ -117,7 +275,6 @@ int app_key_process_timer_handler(ke_msg_id_t const msgid, void const *param,
 								OLED_ShowString(0,4,"                ");
 								OLED_ShowString(0,4,"  key_center!   ");
 #endif
-								key_value0 = 0;
 						break;
 			case	key_right:
 								QPRINTF("\r\nkey_right!\r\n");
@@ -126,7 +283,6 @@ int app_key_process_timer_handler(ke_msg_id_t const msgid, void const *param,
 								OLED_ShowString(0,4,"   key_right!   ");
 #endif
 								led_set(3,LED_ON);
-								key_value0 = 0;
 						break;
 			case	key_down:
 								QPRINTF("\r\nkey_down!\r\n");
@@ -136,7 +292,6 @@ int app_key_process_timer_handler(ke_msg_id_t const msgid, void const *param,
 #endif
 								led_set(2,LED_OFF);
 								led_set(3,LED_OFF);
-								key_value0 = 0;
 						break;
 			default	:	
 								QPRINTF("\r\nkey_up!\r\n");
@@ -144,83 +299,21 @@ int app_key_process_timer_handler(ke_msg_id_t const msgid, void const *param,
 								OLED_ShowString(0,4,"                ");
 								OLED_ShowString(0,4,"    key_up!     ");
 #endif
-								key_value0 = 0;
 					break;
 		}
 #if FB_OLED
+		OLED_Refresh_Gram();
 		ke_timer_set(APP_OLED_CLEAR_KEY_DISPLAY_TIMER,TASK_APP,60);
 #endif
-		usr_button_env.button_st = button_release;
-		gpio_enable_interrupt(BUTTON1_PIN);
     return(KE_MSG_CONSUMED);
 }
 
-void app_event_adc_key_sample_cmp_handler(void)
-{		
-		uint16_t i,sum = 0;
-		ke_evt_clear(1UL << EVENT_ADC_KEY_SAMPLE_CMP_ID);
-		adc_clock_off();
-    adc_power_off();
-		for (i = 0;i<10;i++)
-				{
-						//QPRINTF("array%d:  %d   result:%dmv\r\n",i,adc_key_value[i],ADC_RESULT_mV(adc_key_value[i]));
-						sum +=  adc_key_value[i];
-				}
-		if (key_value0 != 0)
-				key_value0 = 0;
-		adc_key_value_avg = sum / 10;
-		//QPRINTF("key:::%d   %dmv\r\n",adc_key_value_avg,ADC_RESULT_mV(adc_key_value_avg));
-		if( (200 <	adc_key_value_avg)  && (adc_key_value_avg < 655))
-		{
-				key_value0 |= key_up;
-				usr_button_env.joystick_dir = key_up;
-
-		}
-		else
-		{
-				if((656 <	adc_key_value_avg)  && (adc_key_value_avg < 1064))
-				{
-						usr_button_env.joystick_dir = key_right;
-						key_value0 |= key_right;
-				}
-				else
-				{
-						if((1064 <	adc_key_value_avg)  && (adc_key_value_avg < 1474))
-						{
-								usr_button_env.joystick_dir = key_down;
-								key_value0 |= key_down;
-						}
-						else
-						{
-									if((1475 <	adc_key_value_avg)  && (adc_key_value_avg < 1884))
-									{
-											usr_button_env.joystick_dir = key_left;
-											key_value0 |= key_left;
-									}
-									else
-									{
-										if((1885 <	adc_key_value_avg)  && (adc_key_value_avg < 2048))
-										{											
-												usr_button_env.joystick_dir = key_center;
-												key_value0 |= key_center;
-										}
-										else
-										{
-												key_value0 = 0;
-										}
-									}
-						}
-				}
-		}
-		//QPRINTF("key_value0 %d\r\n",key_value0);
-		ke_timer_set(APP_KEY_PROCESS_TIMER,TASK_APP,10);
-}
-
 #if FB_OLED
 int app_oled_clear_key_display_timer_handler(ke_msg_id_t const msgid, void const *param,
                                ke_task_id_t const dest_id, ke_task_id_t const src_id)
 {
 		OLED_ShowString(0,4,"                ");		
+		OLED_Refresh_Gram();
 		return(KE_MSG_CONSUMED);
 }
 #endif
@@ -9,6 +9,21 @@
 #define EVENT_ADC_KEY_SAMPLE_CMP_ID				4
 #define APP_KEY_CHEAK_PRIOD                         10   //100ms԰ѯһ
 
+#define		key_up				0x01
+#define		key_right			0x02
+#define		key_down			0x04
+#define		key_left			0x08
+#define		key_center		0x10
+
+/// Key scan period while a key is down, in 10ms
+#define KEY_SCAN_PERIOD							2
+/// Equal consecutive scans before a key is pressed
+#define KEY_DEBOUNCE_CNT						2
+/// Scans held before KEY_EVT_LONG (1s)
+#define KEY_LONG_CNT								50
+/// Scans between two KEY_EVT_REPEAT once long pressed (200ms)
+#define KEY_REPEAT_CNT							10
+
 enum button_state
 {
 			button_press = 0x00,
@@ -16,17 +31,48 @@ enum button_state
 			button_idle,
 };
 
+/// Key events of APP_KEY_IND
+enum key_evt
+{
+			KEY_EVT_PRESS = 0x00,
+			KEY_EVT_LONG,
+			KEY_EVT_REPEAT,
+			KEY_EVT_RELEASE,
+};
+
+/// Scanner states
+enum key_scan_state
+{
+			KEY_SCAN_IDLE = 0x00,
+			KEY_SCAN_DEBOUNCE,
+			KEY_SCAN_PRESSED,
+			KEY_SCAN_LONG,
+};
+
 typedef struct button_env_tag
 {
 		volatile uint8_t joystick_dir;
 		enum  button_state button_st;
+		/// Scanner state
+		uint8_t scan_st;
+		/// Key being debounced or held
+		uint8_t key;
+		/// Scans spent in the current state
+		uint8_t cnt;
 } button_env;
 
+/// Parameters of APP_KEY_IND
+struct app_key_ind
+{
+		uint8_t key;
+		uint8_t evt;
+};
+
 extern button_env usr_button_env;
 
 extern void app_event_button1_press_handler(void);
 extern void usr_button1_cb(void);
-extern int app_key_process_timer_handler(ke_msg_id_t const msgid, void const *param,
+extern int app_key_ind_handler(ke_msg_id_t const msgid, struct app_key_ind const *param,
                                ke_task_id_t const dest_id, ke_task_id_t const src_id);
 extern int app_key_scan_timer_handler(ke_msg_id_t const msgid, void const *param,
                                ke_task_id_t const dest_id, ke_task_id_t const src_id);
@@ -24,9 +24,73 @@
  * INCLUDE FILES
  ****************************************************************************************
  */
+#include "lib.h"
 #include "gpio.h"
+#include "pwm.h"
 #include "led.h"
 
+/*
+ * MACRO DEFINITIONS
+ ****************************************************************************************
+ */
+
+#if (defined(LED1_PWM_CH) && (CONFIG_ENABLE_DRIVER_PWM0==TRUE))
+#define LED_PWM_EN              1
+/// Leds which can be dimmed
+#define LED_PWM_MATRIX          LED_MATRIX(1)
+/// PWM period count, PWM_PSCAL_DIV gives about 490Hz
+#define LED_PWM_PERIOD          0xff
+#else
+#define LED_PWM_EN              0
+#define LED_PWM_MATRIX          0
+#endif
+
+/// ke_time() is a 23 bits counter of 10ms
+#define LED_TIME_MASK           0x7FFFFF
+
+/*
+ * TYPE DEFINITIONS
+ ****************************************************************************************
+ */
+
+/// Pattern player
+struct led_pattern_chan
+{
+    const struct led_pattern *pat;
+    /// Time the current step ends
+    uint32_t    expire;
+    /// Current step
+    uint8_t     step;
+    /// Sequences played
+    uint8_t     loop;
+    /// Time the pattern runs ahead of its schedule, after steps ended early
+    uint16_t    lead;
+    /// The current step ends at expire
+    bool        timed;
+};
+
+///  LED pattern environment
+struct led_pattern_env_tag
+{
+    struct led_pattern_chan chan[LED_PATTERN_NB];
+    /// Number of led_pattern_process() calls
+    uint32_t    wakeup;
+    /// Brightness of the PWM led
+    uint8_t     level;
+};
+
+/*
+ * LOCAL VARIABLE DEFINITIONS
+ ****************************************************************************************
+ */
+
+static const uint32_t led_pin[LED_NB] = {LED1_PIN, LED2_PIN, LED3_PIN, LED4_PIN, LED5_PIN};
+
+/// Rising half of a breath, roughly perceived linear
+static const uint8_t led_breathe_level[LED_PATTERN_STEP_MAX / 2] = {0x02, 0x08, 0x14, 0x28, 0x48, 0x70, 0xa8, 0xff};
+
+static struct led_pattern_env_tag led_pattern_env;
+
 /*
  * FUNCTION DEFINITIONS
  ****************************************************************************************
@@ -142,6 +206,488 @@ enum led_st led_get(uint32_t idx)
     return (enum led_st)gpio_read_pin(reg);
 }
 
+/**
+ ****************************************************************************************
+ * @brief   Time left before expire
+ * @param[in]    expire     time in 10ms
+ * @param[in]    now        current time in 10ms
+ * @return       time left in 10ms, 0 if expired
+ ****************************************************************************************
+ */
+static uint32_t led_time_left(uint32_t expire, uint32_t now)
+{
+    uint32_t left = (expire - now) & LED_TIME_MASK;
+
+    return (left > (LED_TIME_MASK >> 1)) ? 0 : left;
+}
+
+#if LED_PWM_EN
+/**
+ ****************************************************************************************
+ * @brief   Set the brightness of the PWM led
+ * @param[in]    level      LED_LEVEL_OFF ~ LED_LEVEL_FULL
+ * @description
+ *  Full on and off are driven by GPIO so the chip can sleep, other levels switch the pin
+ *  to PWM which runs without CPU but keeps the chip out of sleep, pwm_enable() takes care
+ *  of the sleep mask.
+ ****************************************************************************************
+ */
+static void led_pwm_set(uint8_t level)
+{
+    bool dim = (level != LED_LEVEL_OFF && level != LED_LEVEL_FULL);
+    bool dimmed = (led_pattern_env.level != LED_LEVEL_OFF && led_pattern_env.level != LED_LEVEL_FULL);
+
+    if (level == led_pattern_env.level)
+        return;
+    led_pattern_env.level = level;
+
+    if (dim)
+    {
+        if (!dimmed)
+        {
+            pwm_init(LED1_PWM_CH);
+        }
+        // led is active low
+        pwm_config(LED1_PWM_CH, PWM_PSCAL_DIV, LED_PWM_PERIOD, LED_PWM_PERIOD - level);
+        if (!dimmed)
+        {
+            pwm_enable(LED1_PWM_CH, MASK_ENABLE);
+            syscon_SetPMCR1WithMask(QN_SYSCON, LED1_PIN_CTRL_MASK, LED1_PWM_PIN_CTRL);
+        }
+    }
+    else if (dimmed)
+    {
+        syscon_SetPMCR1WithMask(QN_SYSCON, LED1_PIN_CTRL_MASK, LED1_GPIO_PIN_CTRL);
+        pwm_enable(LED1_PWM_CH, MASK_DISABLE);
+    }
+}
+#endif
+
+/**
+ ****************************************************************************************
+ * @brief   Output the current step of all patterns
+ * @param[in]    release    leds no longer owned by a pattern, switched off
+ * @description
+ *  All leds are written with one gpio_write_pin_field().
+ ****************************************************************************************
+ */
+static void led_pattern_update(uint8_t release)
+{
+    const struct led_pattern *pat;
+    const struct led_step *st;
+    uint32_t mask = 0, value = 0;
+    uint8_t owned = release, on = 0, level = LED_LEVEL_OFF;
+    int i;
+
+    for (i = 0; i < LED_PATTERN_NB; i++)
+    {
+        pat = led_pattern_env.chan[i].pat;
+        if (pat == NULL)
+            continue;
+
+        st = &pat->step[led_pattern_env.chan[i].step];
+        owned |= pat->matrix;
+        if (st->matrix & pat->matrix & LED_PWM_MATRIX)
+        {
+            on |= st->matrix & pat->matrix & LED_PWM_MATRIX;
+            level = st->level;
+        }
+        if (st->level >= LED_LEVEL_HALF)
+        {
+            on |= st->matrix & pat->matrix;
+        }
+    }
+
+#if LED_PWM_EN
+    if (owned & LED_PWM_MATRIX)
+    {
+        led_pwm_set(level);
+    }
+#endif
+    if (level == LED_LEVEL_OFF)
+    {
+        on &= ~LED_PWM_MATRIX;
+    }
+
+    for (i = 0; i < LED_NB; i++)
+    {
+        if (owned & (1 << i))
+        {
+            mask |= led_pin[i];
+            // led is active low
+            if (!(on & (1 << i)))
+                value |= led_pin[i];
+        }
+    }
+
+    if (mask)
+    {
+        gpio_write_pin_field(mask, value);
+    }
+}
+
+/**
+ ****************************************************************************************
+ * @brief   Load the current step of a pattern player
+ ****************************************************************************************
+ */
+static void led_pattern_load(struct led_pattern_chan *ch, uint32_t base)
+{
+    uint32_t dur = ch->pat->step[ch->step].dur;
+
+    ch->timed = (dur != LED_DUR_INFINITE);
+    if (ch->timed && ch->lead != 0 && (dur >> LED_PATTERN_SLACK_SHIFT) >= ch->lead)
+    {
+        // a long step takes the pattern back to its schedule, short steps keep their length
+        dur += ch->lead;
+        ch->lead = 0;
+    }
+    ch->expire = (base + (dur ? dur : 1)) & LED_TIME_MASK;
+}
+
+/**
+ ****************************************************************************************
+ * @brief   Move a pattern player to its next step
+ ****************************************************************************************
+ */
+static void led_pattern_advance(struct led_pattern_chan *ch)
+{
+    const struct led_pattern *pat = ch->pat;
+
+    if (++ch->step >= pat->nb_step)
+    {
+        ch->step = 0;
+        if (pat->repeat != LED_REPEAT_INFINITE && ++ch->loop >= pat->repeat)
+        {
+            // hold the last step
+            ch->step = pat->nb_step - 1;
+            ch->timed = false;
+            return;
+        }
+    }
+
+    // next step starts when the previous one ended, late wakeups do not drift the pattern
+    led_pattern_load(ch, ch->expire);
+}
+
+/**
+ ****************************************************************************************
+ * @brief   Time a step of a pattern player may end early by
+ * @param[in]    merge      shortest slack
+ * @return       1/2^LED_PATTERN_SLACK_SHIFT of the step duration, merge if longer
+ ****************************************************************************************
+ */
+static uint32_t led_pattern_slack(const struct led_pattern_chan *ch, uint32_t merge)
+{
+    uint32_t slack = ch->pat->step[ch->step].dur >> LED_PATTERN_SLACK_SHIFT;
+
+    return (slack > merge) ? slack : merge;
+}
+
+/**
+ ****************************************************************************************
+ * @brief   Play the steps which end within their slack
+ ****************************************************************************************
+ */
+static void led_pattern_play(uint32_t now, uint32_t merge)
+{
+    struct led_pattern_chan *ch;
+    uint32_t left;
+    int i;
+
+    for (i = 0; i < LED_PATTERN_NB; i++)
+    {
+        ch = &led_pattern_env.chan[i];
+        while (ch->pat != NULL && ch->timed
+               && (left = led_time_left(ch->expire, now)) <= led_pattern_slack(ch, merge))
+        {
+            if (merge == 0)
+            {
+                // the next step starts now, the time gained is given back later
+                ch->lead += left;
+                ch->expire = now;
+            }
+            led_pattern_advance(ch);
+        }
+    }
+
+    led_pattern_update(0);
+}
+
+/**
+ ****************************************************************************************
+ * @brief   Time until the next step of any pattern
+ * @return       delay in 10ms, 0 if no pattern needs a timer
+ ****************************************************************************************
+ */
+static uint16_t led_pattern_next(uint32_t now)
+{
+    uint32_t left, next = LED_DUR_INFINITE;
+    int i;
+
+    for (i = 0; i < LED_PATTERN_NB; i++)
+    {
+        if (led_pattern_env.chan[i].pat != NULL && led_pattern_env.chan[i].timed)
+        {
+            left = led_time_left(led_pattern_env.chan[i].expire, now);
+            if (left < next)
+                next = left;
+        }
+    }
+
+    if (next == LED_DUR_INFINITE)
+        return 0;
+
+    return next ? next : 1;
+}
+
+/**
+ ****************************************************************************************
+ * @brief   Compile a blink pattern
+ * @param[out]   pat        pattern
+ * @param[in]    matrix     leds to blink, bit0~bit4 -> led 1~5
+ * @param[in]    on         on duration in 10ms, 0 keeps the leds off
+ * @param[in]    off        off duration in 10ms, 0 keeps the leds on
+ * @description
+ *  The blink starts with the off period.
+ ****************************************************************************************
+ */
+void led_pattern_blink(struct led_pattern *pat, uint8_t matrix, uint16_t on, uint16_t off)
+{
+    pat->matrix = matrix;
+    pat->repeat = LED_REPEAT_INFINITE;
+    pat->nb_step = 0;
+
+    if (on != 0)
+    {
+        pat->step[pat->nb_step].matrix = (off != 0) ? 0 : matrix;
+        pat->step[pat->nb_step].level = LED_LEVEL_FULL;
+        pat->step[pat->nb_step].dur = (off != 0) ? off : LED_DUR_INFINITE;
+        pat->nb_step++;
+    }
+    if (off != 0)
+    {
+        pat->step[pat->nb_step].matrix = (on != 0) ? matrix : 0;
+        pat->step[pat->nb_step].level = LED_LEVEL_FULL;
+        pat->step[pat->nb_step].dur = (on != 0) ? on : LED_DUR_INFINITE;
+        pat->nb_step++;
+    }
+}
+
+/**
+ ****************************************************************************************
+ * @brief   Compile a breathe pattern
+ * @param[out]   pat        pattern
+ * @param[in]    matrix     leds to breathe, bit0~bit4 -> led 1~5
+ * @param[in]    period     breath period in 10ms
+ * @description
+ *  Leds which cannot be dimmed blink at the breath period instead, which costs two
+ *  wakeups per period rather than one per brightness step.
+ ****************************************************************************************
+ */
+void led_pattern_breathe(struct led_pattern *pat, uint8_t matrix, uint16_t period)
+{
+    uint16_t dur = period / LED_PATTERN_STEP_MAX;
+    int i;
+
+    if ((matrix & ~LED_PWM_MATRIX) || dur == 0)
+    {
+        led_pattern_blink(pat, matrix, period - period / 2, period / 2);
+        return;
+    }
+
+    pat->matrix = matrix;
+    pat->repeat = LED_REPEAT_INFINITE;
+    pat->nb_step = LED_PATTERN_STEP_MAX;
+    for (i = 0; i < LED_PATTERN_STEP_MAX / 2; i++)
+    {
+        pat->step[i].matrix = matrix;
+        pat->step[i].level = led_breathe_level[i];
+        pat->step[i].dur = dur;
+        pat->step[LED_PATTERN_STEP_MAX - 1 - i] = pat->step[i];
+    }
+}
+
+/**
+ ****************************************************************************************
+ * @brief   Compile a sequence pattern
+ * @param[out]   pat        pattern
+ * @param[in]    matrix     leds owned by the sequence, bit0~bit4 -> led 1~5
+ * @param[in]    step       steps, consecutive steps with the same output are merged
+ * @param[in]    nb_step    number of steps
+ * @param[in]    repeat     number of times the sequence is played
+ ****************************************************************************************
+ */
+void led_pattern_sequence(struct led_pattern *pat, uint8_t matrix, const struct led_step *step,
+                          uint8_t nb_step, uint8_t repeat)
+{
+    struct led_step *last;
+    uint32_t dur;
+    int i;
+
+    pat->matrix = matrix;
+    pat->repeat = repeat;
+    pat->nb_step = 0;
+
+    for (i = 0; i < nb_step && pat->nb_step < LED_PATTERN_STEP_MAX; i++)
+    {
+        last = &pat->step[pat->nb_step ? pat->nb_step - 1 : 0];
+        if (pat->nb_step != 0
+            && last->matrix == step[i].matrix && last->level == step[i].level
+            && last->dur != LED_DUR_INFINITE)
+        {
+            // same output, one wakeup less
+            dur = (step[i].dur == LED_DUR_INFINITE) ? LED_DUR_INFINITE : (uint32_t)last->dur + step[i].dur;
+            if (dur <= LED_DUR_INFINITE)
+            {
+                last->dur = dur;
+                continue;
+            }
+        }
+        pat->step[pat->nb_step++] = step[i];
+    }
+}
+
+/**
+ ****************************************************************************************
+ * @brief   Start a pattern
+ * @param[in]    idx        pattern player, 0 ~ LED_PATTERN_NB-1
+ * @param[in]    pat        pattern, must stay valid until the player is stopped
+ * @return       delay in 10ms until led_pattern_process() shall be called, 0 if none
+ * @description
+ *  The pattern replaces the one running on the same player. Leds owned by several
+ *  players are switched on when any of them switches them on.
+ ****************************************************************************************
+ */
+uint16_t led_pattern_start(uint8_t idx, const struct led_pattern *pat)
+{
+    struct led_pattern_chan *ch;
+    uint8_t release = 0;
+    uint32_t now = ke_time();
+
+    if (idx >= LED_PATTERN_NB || pat->nb_step == 0)
+        return led_pattern_next(now);
+
+    ch = &led_pattern_env.chan[idx];
+    if (ch->pat != NULL)
+        release = ch->pat->matrix & ~pat->matrix;
+
+    ch->pat = pat;
+    ch->step = 0;
+    ch->loop = 0;
+    ch->lead = 0;
+    led_pattern_load(ch, now);
+    led_pattern_update(release);
+
+    return led_pattern_next(now);
+}
+
+/**
+ ****************************************************************************************
+ * @brief   Stop a pattern and switch its leds off
+ * @param[in]    idx        pattern player, 0 ~ LED_PATTERN_NB-1
+ * @return       delay in 10ms until led_pattern_process() shall be called, 0 if none
+ ****************************************************************************************
+ */
+uint16_t led_pattern_stop(uint8_t idx)
+{
+    struct led_pattern_chan *ch;
+    uint8_t release;
+
+    if (idx < LED_PATTERN_NB && led_pattern_env.chan[idx].pat != NULL)
+    {
+        ch = &led_pattern_env.chan[idx];
+        release = ch->pat->matrix;
+        ch->pat = NULL;
+        led_pattern_update(release);
+    }
+
+    return led_pattern_next(ke_time());
+}
+
+/**
+ ****************************************************************************************
+ * @brief   Play the patterns
+ * @return       delay in 10ms until led_pattern_process() shall be called, 0 if none
+ * @description
+ *  Called when the delay returned by the previous led_pattern_*() call has elapsed. All
+ *  steps ending within LED_PATTERN_MERGE or their slack, see led_pattern_slack(), are
+ *  handled in this single wakeup.
+ ****************************************************************************************
+ */
+uint16_t led_pattern_process(void)
+{
+    uint32_t now = ke_time();
+
+    led_pattern_env.wakeup++;
+    led_pattern_play(now, LED_PATTERN_MERGE);
+
+    return led_pattern_next(now);
+}
+
+/**
+ ****************************************************************************************
+ * @brief   Check whether a step may end at this wakeup
+ * @return       true if a step ends within its slack
+ * @description
+ *  Called when the chip wakes up for the BLE stack. The steps are then played by
+ *  led_pattern_process_early() rather than from a wakeup of their own.
+ ****************************************************************************************
+ */
+bool led_pattern_due(void)
+{
+    struct led_pattern_chan *ch;
+    uint32_t now = ke_time();
+    int i;
+
+    for (i = 0; i < LED_PATTERN_NB; i++)
+    {
+        ch = &led_pattern_env.chan[i];
+        if (ch->pat != NULL && ch->timed
+            && led_time_left(ch->expire, now) <= led_pattern_slack(ch, 0))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ ****************************************************************************************
+ * @brief   Play the patterns at a wakeup of the BLE stack
+ * @return       delay in 10ms until led_pattern_process() shall be called, 0 if none
+ * @description
+ *  Steps end within their slack only. The following step starts at once and keeps its
+ *  length, the next step long enough to hide it makes up for the time gained. Not
+ *  counted as a wakeup, the timer armed with the previous delay shall be moved to the
+ *  returned one.
+ ****************************************************************************************
+ */
+uint16_t led_pattern_process_early(void)
+{
+    uint32_t now = ke_time();
+
+    led_pattern_play(now, 0);
+
+    return led_pattern_next(now);
+}
+
+/**
+ ****************************************************************************************
+ * @brief   Number of wakeups spent playing patterns
+ * @return       number of led_pattern_process() calls
+ * @description
+ *  Sampled twice a minute apart it gives the LED wakeups per minute, the sleep profiler
+ *  (CFG_SLEEP_STAT) gives the total for comparison. Steps played early by
+ *  led_pattern_process_early() are not counted.
+ ****************************************************************************************
+ */
+uint32_t led_pattern_wakeup_count(void)
+{
+    return led_pattern_env.wakeup;
+}
+
 /// @} LED
 
 
@@ -15,6 +15,12 @@
 #ifndef _LED_H_
 #define _LED_H_
 
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+#include <stdbool.h>
+#include <stdint.h>
 
 /*
  * MACRO DEFINITIONS
@@ -55,6 +61,41 @@
 
 #endif
 
+/// LED1 of FireBLE sits on P2.7 which can be switched to PWM0 for dimming
+#if defined(FireBLE_platform) && !defined(QN_9021_MINIDK)
+#define LED1_PWM_CH             (PWM_CH0)
+#define LED1_PWM_PIN_CTRL       (P27_PWM0_PIN_CTRL)
+#define LED1_GPIO_PIN_CTRL      (P27_GPIO_23_PIN_CTRL)
+#define LED1_PIN_CTRL_MASK      (P27_MASK_PIN_CTRL)
+#endif
+
+/// Bit of led idx(1~5) in a led matrix
+#define LED_MATRIX(idx)         (1 << ((idx) - 1))
+/// Number of leds
+#define LED_NB                  5
+
+/// Number of patterns which can run at the same time
+#define LED_PATTERN_NB          2
+/// Maximum number of steps in a pattern
+#define LED_PATTERN_STEP_MAX    16
+/// Step duration which holds the step forever
+#define LED_DUR_INFINITE        0xffff
+/// Pattern repeat count which loops forever
+#define LED_REPEAT_INFINITE     0xff
+/// Steps ending within this time(10ms) are merged into the current wakeup
+#define LED_PATTERN_MERGE       1
+/// Steps may end 1/2^LED_PATTERN_SLACK_SHIFT of their duration early at a wakeup of the BLE stack
+#define LED_PATTERN_SLACK_SHIFT 3
+
+/// Kernel event which plays the patterns at a wakeup of the BLE stack
+#ifndef EVENT_LED_PATTERN_ID
+#define EVENT_LED_PATTERN_ID    15
+#endif
+/// Led brightness
+#define LED_LEVEL_OFF           0x00
+#define LED_LEVEL_HALF          0x80
+#define LED_LEVEL_FULL          0xff
+
 /*
  * ENUMERATION DEFINITIONS
  ****************************************************************************************
@@ -66,6 +107,35 @@ enum led_st
     LED_OFF = (int)0xffffffff
 };
 
+/*
+ * TYPE DEFINITIONS
+ ****************************************************************************************
+ */
+
+/// LED pattern step
+struct led_step
+{
+    /// Leds switched on in this step, bit0~bit4 -> led 1~5
+    uint8_t     matrix;
+    /// Brightness of the leds switched on, only PWM capable leds can be dimmed
+    uint8_t     level;
+    /// Step duration in 10ms, LED_DUR_INFINITE holds the step
+    uint16_t    dur;
+};
+
+/// LED pattern, a sequence of steps replayed on a group of leds
+struct led_pattern
+{
+    /// Leds owned by the pattern, bit0~bit4 -> led 1~5
+    uint8_t     matrix;
+    /// Number of steps
+    uint8_t     nb_step;
+    /// Number of times the sequence is played, LED_REPEAT_INFINITE loops forever
+    uint8_t     repeat;
+    /// Steps
+    struct led_step step[LED_PATTERN_STEP_MAX];
+};
+
 /*
  * FUNCTION DECLARATIONS
  ****************************************************************************************
@@ -75,4 +145,15 @@ extern void led_matrix(uint32_t matrix);
 extern void led_set(uint32_t idx, enum led_st enable);
 extern enum led_st led_get(uint32_t idx);
 
+extern void led_pattern_blink(struct led_pattern *pat, uint8_t matrix, uint16_t on, uint16_t off);
+extern void led_pattern_breathe(struct led_pattern *pat, uint8_t matrix, uint16_t period);
+extern void led_pattern_sequence(struct led_pattern *pat, uint8_t matrix, const struct led_step *step,
+                                 uint8_t nb_step, uint8_t repeat);
+extern uint16_t led_pattern_start(uint8_t idx, const struct led_pattern *pat);
+extern uint16_t led_pattern_stop(uint8_t idx);
+extern uint16_t led_pattern_process(void);
+extern bool led_pattern_due(void);
+extern uint16_t led_pattern_process_early(void);
+extern uint32_t led_pattern_wakeup_count(void);
+
 #endif
@@ -24,6 +24,7 @@
  ****************************************************************************************
  */
  
+#include	<string.h>
 #include	"oled.h"
 #include  "oledfont.h"
 
@@ -40,40 +41,48 @@
 volatile uint8_t	oled_rx_flag = 0;
 volatile uint8_t	oled_tx_flag = 0;
 
-//Init the OLED
-//static uint8_t 		Init_buffer[] = 
-//{
-//	 0xAE ,//--turn off oled panel
-//	 0x00 ,//---set low column address
-//	 0x10 ,//---set high column address
-//	 0x40 ,//--set start line address  Set Mapping RAM Display Start Line (0x00~0x3F)
-//	 0x81 ,//--set contrast control register
-//	 0xCF , // Set SEG Output Current Brightness
-//	 0xA1 ,//--Set SEG/Column Mapping     0xa0ҷ 0xa1
-//	 0xC8 ,//Set COM/Row Scan Direction   0xc0· 0xc8
-//	 0xA6 ,//--set normal display
-//	 0xA8 ,//--set multiplex ratio(1 to 64)
-//	 0x3f ,//--1/64 duty
-//	 0xD3 ,//-set display offset	Shift Mapping RAM Counter (0x00~0x3F)
-//	 0x00 ,//-not offset
-//	 0xd5 ,//--set display clock divide ratio/oscillator frequency
-//	 0x80 ,//--set divide ratio, Set Clock as 100 Frames/Sec
-//	 0xD9 ,//--set pre-charge period
-//	 0xF1 ,//Set Pre-Charge as 15 Clocks & Discharge as 1 Clock
-//	 0xDA ,//--set com pins hardware configuration
-//	 0x12 ,
-//	 0xDB ,//--set vcomh
-//	 0x40 ,//Set VCOM Deselect Level
-//	 0x20 ,//-Set Page Addressing Mode (0x00/0x01/0x02)
-//	 0x02 ,//
-//	 0x8D ,//--set Charge Pump enable/disable
-//	 0x14 ,//--set(0x10) disable
-//	 0xA4 ,// Disable Entire Display On (0xa4/0xa5)
-//	 0xA6 ,// Disable Inverse Display On (0xa6/a7) 
-//	 0xAF ,//--turn on oled panel
-//	
-//	 0xAF , /*display ON*/ 
-//};
+#if (FB_OLED)
+//Init the SSD1306, sent in one transfer
+static const uint8_t	oled_init_cmd[] = 
+{
+	 0xAE ,//--turn off oled panel
+	 0x00 ,//---set low column address
+	 0x10 ,//---set high column address
+	 0x40 ,//--set start line address  Set Mapping RAM Display Start Line (0x00~0x3F)
+	 0x81 ,//--set contrast control register
+	 0xCF , // Set SEG Output Current Brightness
+	 0xA1 ,//--Set SEG/Column Mapping     0xa0ҷ 0xa1
+	 0xC8 ,//Set COM/Row Scan Direction   0xc0· 0xc8
+	 0xA6 ,//--set normal display
+	 0xA8 ,//--set multiplex ratio(1 to 64)
+	 0x3f ,//--1/64 duty
+	 0xD3 ,//-set display offset	Shift Mapping RAM Counter (0x00~0x3F)
+	 0x00 ,//-not offset
+	 0xd5 ,//--set display clock divide ratio/oscillator frequency
+	 0x80 ,//--set divide ratio, Set Clock as 100 Frames/Sec
+	 0xD9 ,//--set pre-charge period
+	 0xF1 ,//Set Pre-Charge as 15 Clocks & Discharge as 1 Clock
+	 0xDA ,//--set com pins hardware configuration
+	 0x12 ,
+	 0xDB ,//--set vcomh
+	 0x40 ,//Set VCOM Deselect Level
+	 0x20 ,//-Set Page Addressing Mode (0x00/0x01/0x02)
+	 0x02 ,//
+	 0x8D ,//--set Charge Pump enable/disable
+	 0x14 ,//--set(0x10) disable
+	 0xA4 ,// Disable Entire Display On (0xa4/0xa5)
+	 0xA6 ,// Disable Inverse Display On (0xa6/a7) 
+	 0xAF ,//--turn on oled panel
+
+	 0xAF , /*display ON*/ 
+};
+
+/// Frame buffer, a byte is a column of 8 pixels of a page as in the SSD1306 RAM
+static uint8_t oled_gram[OLED_PAGE_NUM][X_WIDTH];
+/// Columns changed since the last refresh, a page is clean when x0 > x1
+static uint8_t oled_dirty_x0[OLED_PAGE_NUM];
+static uint8_t oled_dirty_x1[OLED_PAGE_NUM];
+#endif
 
 /*
  * GLOBAL VARIABLE DECLARATION
@@ -156,12 +165,71 @@ void oled_io_config(void)
 #endif
 }
 
+/**
+ ****************************************************************************************
+ * @brief Add columns x0..x1 of a page to the area sent by the next refresh.
+ *
+ ****************************************************************************************
+ */
+static void oled_mark(uint8_t page, uint8_t x0, uint8_t x1)
+{
+	if (x0 < oled_dirty_x0[page])
+		oled_dirty_x0[page] = x0;
+	if (x1 > oled_dirty_x1[page])
+		oled_dirty_x1[page] = x1;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Copy len columns to a page of the frame buffer, clipped to the screen.
+ *
+ ****************************************************************************************
+ */
+static void oled_put(uint8_t x, uint8_t page, const uint8_t *col, uint8_t len)
+{
+	if (page >= OLED_PAGE_NUM || x >= X_WIDTH || len == 0)
+		return;
+	if (len > X_WIDTH - x)
+		len = X_WIDTH - x;
+
+	memcpy(&oled_gram[page][x], col, len);
+	oled_mark(page, x, x + len - 1);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Send the changed part of the frame buffer, one burst per page.
+ *
+ * Drawing functions only update the frame buffer, call this once the screen is composed.
+ *
+ ****************************************************************************************
+ */
+void OLED_Refresh_Gram(void)
+{
+	uint8_t page, x0;
+
+	for (page = 0; page < OLED_PAGE_NUM; page++)
+	{
+		x0 = oled_dirty_x0[page];
+		if (x0 > oled_dirty_x1[page])
+			continue;
+
+		OLED_Set_Pos(x0, page);
+		OLED_WR_Bytes(&oled_gram[page][x0], oled_dirty_x1[page] - x0 + 1, OLED_DATA);
+
+		oled_dirty_x0[page] = 0xFF;
+		oled_dirty_x1[page] = 0;
+	}
+}
 
 void OLED_Set_Pos(unsigned char x, unsigned char y) 
 { 
-	OLED_WR_Byte(0xb0+y,OLED_CMD);
-	OLED_WR_Byte(((x&0xf0)>>4)|0x10,OLED_CMD);
-	OLED_WR_Byte((x&0x0f)|0x01,OLED_CMD); 
+	uint8_t cmd[3];
+
+	cmd[0] = 0xb0+y;
+	cmd[1] = ((x&0xf0)>>4)|0x10;
+	cmd[2] = x&0x0f;
+	OLED_WR_Bytes(cmd, sizeof(cmd), OLED_CMD);
 }   	  
 //OLEDʾ    
 void OLED_Display_On(void)
@@ -180,14 +248,11 @@ void OLED_Display_Off(void)
 //,,ĻǺɫ!ûһ!!!	  
 void OLED_Clear(void)  
 {  
-	uint8_t i,n;		    
-	for(i=0;i<8;i++)  
-	{  
-		OLED_WR_Byte (0xb0+i,OLED_CMD);    //ҳַ0~7
-		OLED_WR_Byte (0x00,OLED_CMD);      //ʾλáе͵ַ
-		OLED_WR_Byte (0x10,OLED_CMD);      //ʾλáиߵַ   
-		for(n=0;n<128;n++)OLED_WR_Byte(0,OLED_DATA); 
-	} //ʾ
+	uint8_t i;
+
+	memset(oled_gram, 0, sizeof(oled_gram));
+	for(i=0;i<OLED_PAGE_NUM;i++)
+		oled_mark(i, 0, X_WIDTH-1);
 }
 
 #if (FB_OLED && FB_IIC_OLED)
@@ -211,8 +276,9 @@ void IIC_Stop()
 
 	OLED_SCLK_Clr();
 	OLED_SDIN_Clr();
-	OLED_SDIN_Set();
+	// SDA rises while SCL is high
 	OLED_SCLK_Set() ;
+	OLED_SDIN_Set();
 }
 /**********************************************
 // IIC Write byte
@@ -264,42 +330,43 @@ void Write_IIC_Data(unsigned char IIC_Data)
 #endif
 
 
-void OLED_WR_Byte(uint8_t dat,uint8_t cmd)
+/**
+ ****************************************************************************************
+ * @brief Send len command or display data bytes in one transfer.
+ *
+ ****************************************************************************************
+ */
+void OLED_WR_Bytes(const uint8_t *buf, uint16_t len, uint8_t cmd)
 {
 #if	(FB_OLED && FB_IIC_OLED)
-	if(cmd)
-			{
    IIC_Start();
-   Write_IIC_Byte(0x78);			//D/C#=0; R/W#=0
-   Write_IIC_Byte(0x40);			//write data
-   Write_IIC_Byte(dat);
-   IIC_Stop();
-		}
-	else {
-		IIC_Start();
-   Write_IIC_Byte(0x78);            //Slave address,SA0=0
-   Write_IIC_Byte(0x00);			//write command
-   Write_IIC_Byte(dat); 
+   Write_IIC_Byte(0x78);			//Slave address,SA0=0
+   Write_IIC_Byte(cmd ? 0x40 : 0x00);	//Co=0, all the following bytes are data or commands
+   while (len--)
+       Write_IIC_Byte(*buf++);
    IIC_Stop();
-		
-	}
 #endif
 #if	(FB_OLED && FB_SPI_OLED)
-		//uint8_t i;
-	uint8_t buffer[1];
-	buffer[0] = dat;	
 	if(cmd)
 	  OLED_DC_Set();
 	else 
 	  OLED_DC_Clr();		  
 	OLED_CS_Clr();
-	spi_write(QN_SPI1, buffer, 1, oled_write_done);
-	delay(100);
-			 		  
+	oled_tx_flag = 1;
+	spi_write(QN_SPI1, (uint8_t *)buf, len, oled_write_done);
+	// Polling, interrupt or DMA mode, the callback ends the buffer
+	while (oled_tx_flag);
+	// The last byte is still shifted out, keep CS until the bus is idle
+	while (!(spi_spi_GetSR(QN_SPI1) & SPI_MASK_TX_FIFO_EMPT));
+	while (spi_spi_GetSR(QN_SPI1) & SPI_MASK_BUSY);
 	OLED_CS_Set();
 	OLED_DC_Set();  
 #endif
+}
 
+void OLED_WR_Byte(uint8_t dat,uint8_t cmd)
+{
+	OLED_WR_Bytes(&dat, 1, cmd);
 }
 
 //void OLED_WR_Byte(uint8_t dat,uint8_t cmd)
@@ -322,23 +389,16 @@ void OLED_WR_Byte(uint8_t dat,uint8_t cmd)
 
 void OLED_ShowChar(uint8_t x,uint8_t y,uint8_t chr)
 {      	
-	unsigned char c=0,i=0;	
+	unsigned char c=0;	
 		c=chr-' ';//õƫƺֵ			
 		if(x>Max_Column-1){x=0;y=y+2;}
 		if(SIZE ==16)
 			{
-			OLED_Set_Pos(x,y);	
-			for(i=0;i<8;i++)
-			OLED_WR_Byte(F8X16[c*16+i],OLED_DATA);
-			OLED_Set_Pos(x,y+1);
-			for(i=0;i<8;i++)
-			OLED_WR_Byte(F8X16[c*16+i+8],OLED_DATA);
+			oled_put(x,y,&F8X16[c*16],8);
+			oled_put(x,y+1,&F8X16[c*16+8],8);
 			}
 			else {	
-				OLED_Set_Pos(x,y+1);
-				for(i=0;i<6;i++)
-				OLED_WR_Byte(F6x8[c][i],OLED_DATA);
-				
+				oled_put(x,y+1,F6x8[c],6);
 			}
 }
 //m^n
@@ -387,38 +447,57 @@ void OLED_ShowString(uint8_t x,uint8_t y,uint8_t *chr)
 //ʾ
 void OLED_ShowCHinese(uint8_t x,uint8_t y,uint8_t no)
 {      			    
-	uint8_t t,adder=0;
-	OLED_Set_Pos(x,y);	
-    for(t=0;t<16;t++)
-		{
-				OLED_WR_Byte(Hzk[2*no][t],OLED_DATA);
-				adder+=1;
-     }	
-		OLED_Set_Pos(x,y+1);	
-    for(t=0;t<16;t++)
-			{	
-				OLED_WR_Byte(Hzk[2*no+1][t],OLED_DATA);
-				adder+=1;
-      }					
+	oled_put(x,y,(const uint8_t *)Hzk[2*no],16);
+	oled_put(x,y+1,(const uint8_t *)Hzk[2*no+1],16);
 }
 /***********ʾʾBMPͼƬ12864ʼ(x,y),xķΧ0127yΪҳķΧ07*****************/
 void OLED_DrawBMP(unsigned char x0, unsigned char y0,unsigned char x1, unsigned char y1,unsigned char BMP[])
 { 	
- unsigned int j=0;
- unsigned char x,y;
-  
-  if(y1%8==0) y=y1/8;      
-  else y=y1/8+1;
+	unsigned int j=0;
+	unsigned char y;
+
 	for(y=y0;y<y1;y++)
 	{
-		OLED_Set_Pos(x0,y);
-    for(x=x0;x<x1;x++)
-	    {      
-	    	OLED_WR_Byte(BMP[j++],OLED_DATA);	    	
-	    }
+		oled_put(x0,y,&BMP[j],x1-x0);
+		j+=x1-x0;
 	}
 } 
 
+/**
+ ****************************************************************************************
+ * @brief Set (t=1) or clear (t=0) the pixel x,y of the frame buffer.
+ *
+ ****************************************************************************************
+ */
+void OLED_DrawPoint(uint8_t x,uint8_t y,uint8_t t)
+{
+	uint8_t page;
+
+	if (x >= X_WIDTH || y >= Y_WIDTH)
+		return;
+
+	page = y / 8;
+	if (t)
+		oled_gram[page][x] |= 1 << (y % 8);
+	else
+		oled_gram[page][x] &= ~(1 << (y % 8));
+	oled_mark(page, x, x);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Set (dot=1) or clear (dot=0) the pixels of the rectangle x1,y1 - x2,y2.
+ *
+ ****************************************************************************************
+ */
+void OLED_Fill(uint8_t x1,uint8_t y1,uint8_t x2,uint8_t y2,uint8_t dot)
+{
+	uint8_t x, y;
+
+	for (x = x1; x <= x2 && x < X_WIDTH; x++)
+		for (y = y1; y <= y2 && y < Y_WIDTH; y++)
+			OLED_DrawPoint(x, y, dot);
+}
 
 //ʼSSD1306					    
 void OLED_Init(void)
@@ -435,38 +514,12 @@ void OLED_Init(void)
 	delay(100000);
 	OLED_RST_Set(); 
 					  
-	OLED_WR_Byte(0xAE,OLED_CMD);//--turn off oled panel
-	OLED_WR_Byte(0x00,OLED_CMD);//---set low column address
-	OLED_WR_Byte(0x10,OLED_CMD);//---set high column address
-	OLED_WR_Byte(0x40,OLED_CMD);//--set start line address  Set Mapping RAM Display Start Line (0x00~0x3F)
-	OLED_WR_Byte(0x81,OLED_CMD);//--set contrast control register
-	OLED_WR_Byte(0xCF,OLED_CMD); // Set SEG Output Current Brightness
-	OLED_WR_Byte(0xA1,OLED_CMD);//--Set SEG/Column Mapping     0xa0ҷ 0xa1
-	OLED_WR_Byte(0xC8,OLED_CMD);//Set COM/Row Scan Direction   0xc0· 0xc8
-	OLED_WR_Byte(0xA6,OLED_CMD);//--set normal display
-	OLED_WR_Byte(0xA8,OLED_CMD);//--set multiplex ratio(1 to 64)
-	OLED_WR_Byte(0x3f,OLED_CMD);//--1/64 duty
-	OLED_WR_Byte(0xD3,OLED_CMD);//-set display offset	Shift Mapping RAM Counter (0x00~0x3F)
-	OLED_WR_Byte(0x00,OLED_CMD);//-not offset
-	OLED_WR_Byte(0xd5,OLED_CMD);//--set display clock divide ratio/oscillator frequency
-	OLED_WR_Byte(0x80,OLED_CMD);//--set divide ratio, Set Clock as 100 Frames/Sec
-	OLED_WR_Byte(0xD9,OLED_CMD);//--set pre-charge period
-	OLED_WR_Byte(0xF1,OLED_CMD);//Set Pre-Charge as 15 Clocks & Discharge as 1 Clock
-	OLED_WR_Byte(0xDA,OLED_CMD);//--set com pins hardware configuration
-	OLED_WR_Byte(0x12,OLED_CMD);
-	OLED_WR_Byte(0xDB,OLED_CMD);//--set vcomh
-	OLED_WR_Byte(0x40,OLED_CMD);//Set VCOM Deselect Level
-	OLED_WR_Byte(0x20,OLED_CMD);//-Set Page Addressing Mode (0x00/0x01/0x02)
-	OLED_WR_Byte(0x02,OLED_CMD);//
-	OLED_WR_Byte(0x8D,OLED_CMD);//--set Charge Pump enable/disable
-	OLED_WR_Byte(0x14,OLED_CMD);//--set(0x10) disable
-	OLED_WR_Byte(0xA4,OLED_CMD);// Disable Entire Display On (0xa4/0xa5)
-	OLED_WR_Byte(0xA6,OLED_CMD);// Disable Inverse Display On (0xa6/a7) 
-	OLED_WR_Byte(0xAF,OLED_CMD);//--turn on oled panel
-	
-	OLED_WR_Byte(0xAF,OLED_CMD); /*display ON*/ 
+	OLED_WR_Bytes(oled_init_cmd, sizeof(oled_init_cmd), OLED_CMD);
+
+	memset(oled_dirty_x0, 0xFF, sizeof(oled_dirty_x0));
+	memset(oled_dirty_x1, 0, sizeof(oled_dirty_x1));
 	OLED_Clear();
-	OLED_Set_Pos(0,0); 	
+	OLED_Refresh_Gram();
 } 
 
 int app_oled_display_timer_handler(ke_msg_id_t const msgid, void const *param,
@@ -474,6 +527,7 @@ int app_oled_display_timer_handler(ke_msg_id_t const msgid, void const *param,
 {
 
 		OLED_ShowString(0,0,"  Firefly Team  ");
+		OLED_Refresh_Gram();
 		ke_timer_clear(APP_OLED_DISPLAY_TIMER,TASK_APP);
 		return(KE_MSG_CONSUMED);
 }
@@ -56,6 +56,7 @@
 #define	Brightness	0xFF 
 #define X_WIDTH 	128
 #define Y_WIDTH 	64	
+#define OLED_PAGE_NUM	(Y_WIDTH/8)
 
 //-----------------OLED˿ڶ----------------  	
 //#define OLED_CS_Clr() gpio_write_pin(OLED_CS_PIN,GPIO_LOW)//CS
@@ -94,6 +95,8 @@
  */ 
 
 void OLED_WR_Byte(uint8_t dat,uint8_t cmd);	    
+void OLED_WR_Bytes(const uint8_t *buf, uint16_t len, uint8_t cmd);
+void OLED_Refresh_Gram(void);
 void OLED_Display_On(void);
 void OLED_Display_Off(void);	   							   		    
 void OLED_Init(void);
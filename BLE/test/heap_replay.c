@@ -0,0 +1,544 @@
+/**
+ ****************************************************************************************
+ *
+ * @file heap_replay.c
+ *
+ * @brief Offline analyzer of the BLE heap trace log (CFG_HEAP_TRACE_LOG).
+ *
+ * The "heap ..." lines which app_sys.c prints on the debug UART are replayed on a model
+ * of the ROM allocator with the headers of the chip: first fit in address order, a block
+ * taken from the end of a free block which keeps its header, freed blocks merged with
+ * their neighbours. The smallest heap the log fits in is found by bisection, the advice
+ * adds one largest request as app_heap_size_advice() does. Blocks still held at the end
+ * of the log are reported by caller, old ones are leaks.
+ *
+ *   heap_replay [-b base] [-a age] [log]
+ *
+ * base is the part of the heap the stack uses by itself, which the trace does not see:
+ * the peak of EACI_MSG_CMD_HEAP_STAT minus the application peak printed here.
+ *
+ * Copyright(C) 2015 NXP Semiconductors N.V.
+ * All rights reserved.
+ *
+ * $Rev: $
+ *
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "heap_replay.h"
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// No offset, the block did not fit
+#define HEAP_REPLAY_NONE            0xFFFFFFFF
+/// Heap size searched at most
+#define HEAP_REPLAY_SIZE_MAX        0x10000
+
+/*
+ * TYPE DEFINITIONS
+ ****************************************************************************************
+ */
+
+/// Free block of the model
+struct heap_replay_node
+{
+    uint32_t off;
+    uint32_t size;
+};
+
+/// Model of the ROM allocator, offsets from the heap start
+struct heap_replay_heap
+{
+    struct heap_replay_node *node;
+    uint32_t node_nb;
+};
+
+/// Block held during the replay
+struct heap_replay_live
+{
+    unsigned long ptr;
+    uint32_t off;
+    uint32_t total;
+    bool sent;
+    /// Allocation event
+    uint32_t evt;
+};
+
+/// Blocks held during the replay
+struct heap_replay_set
+{
+    struct heap_replay_live *blk;
+    uint32_t nb;
+    uint32_t max;
+};
+
+/*
+ * LOCAL FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+/// Size taken by a request: word aligned, with the header of an allocated block
+static uint32_t heap_replay_total(uint32_t size)
+{
+    return ((size + 3) & ~3UL) + HEAP_REPLAY_USED_HDR;
+}
+
+static uint32_t heap_replay_alloc(struct heap_replay_heap *heap, uint32_t total)
+{
+    for (uint32_t i = 0; i < heap->node_nb; i++)
+    {
+        // The free block keeps its header
+        if (heap->node[i].size >= total + HEAP_REPLAY_FREE_HDR)
+        {
+            heap->node[i].size -= total;
+            return heap->node[i].off + heap->node[i].size;
+        }
+    }
+
+    return HEAP_REPLAY_NONE;
+}
+
+static void heap_replay_release(struct heap_replay_heap *heap, uint32_t off, uint32_t total)
+{
+    struct heap_replay_node *node = heap->node;
+    uint32_t i = 0;
+
+    if (off == HEAP_REPLAY_NONE)
+        return;
+
+    while ((i < heap->node_nb) && (node[i].off < off))
+        i++;
+
+    if ((i > 0) && (node[i - 1].off + node[i - 1].size == off))
+    {
+        i--;
+        node[i].size += total;
+    }
+    else
+    {
+        memmove(&node[i + 1], &node[i], (heap->node_nb - i) * sizeof(*node));
+        node[i].off = off;
+        node[i].size = total;
+        heap->node_nb++;
+    }
+
+    if ((i + 1 < heap->node_nb) && (node[i].off + node[i].size == node[i + 1].off))
+    {
+        node[i].size += node[i + 1].size;
+        memmove(&node[i + 1], &node[i + 2], (heap->node_nb - i - 2) * sizeof(*node));
+        heap->node_nb--;
+    }
+}
+
+static struct heap_replay_live *heap_replay_find(struct heap_replay_set *set, unsigned long ptr)
+{
+    for (uint32_t i = 0; i < set->nb; i++)
+    {
+        if (set->blk[i].ptr == ptr)
+            return &set->blk[i];
+    }
+
+    return NULL;
+}
+
+static void heap_replay_drop(struct heap_replay_set *set, struct heap_replay_live *blk)
+{
+    *blk = set->blk[--set->nb];
+}
+
+static struct heap_replay_live *heap_replay_add(struct heap_replay_set *set)
+{
+    if (set->nb == set->max)
+    {
+        uint32_t max = set->max ? 2 * set->max : 64;
+        struct heap_replay_live *blk = realloc(set->blk, max * sizeof(*blk));
+
+        if (blk == NULL)
+            return NULL;
+        set->blk = blk;
+        set->max = max;
+    }
+
+    return &set->blk[set->nb++];
+}
+
+/// Walk the log, on a heap model when heap is not NULL, and keep the blocks held at the end
+static void heap_replay_walk(struct heap_replay const *rep, struct heap_replay_heap *heap,
+                             struct heap_replay_run *run, struct heap_replay_set *set)
+{
+    uint32_t used = 0;
+
+    for (uint32_t e = 0; e < rep->evt_nb; e++)
+    {
+        struct heap_replay_evt const *evt = &rep->evt[e];
+        struct heap_replay_live *blk;
+        uint32_t total = heap_replay_total(evt->size);
+        uint32_t off = HEAP_REPLAY_NONE;
+
+        switch (evt->op)
+        {
+        case 'a':
+            // The device allocator reused the block, it was freed out of sight
+            if ((evt->ptr != 0) && ((blk = heap_replay_find(set, evt->ptr)) != NULL))
+            {
+                if (heap)
+                    heap_replay_release(heap, blk->off, blk->total);
+                used -= blk->total;
+                heap_replay_drop(set, blk);
+            }
+
+            if (heap)
+            {
+                off = heap_replay_alloc(heap, total);
+                if (off == HEAP_REPLAY_NONE)
+                    run->fail_nb++;
+            }
+            if ((off != HEAP_REPLAY_NONE) || (heap == NULL))
+            {
+                used += total;
+                if (run && (used > run->used_peak))
+                    run->used_peak = used;
+            }
+
+            if (evt->ptr == 0)
+            {
+                // Failed on the device, nothing to free later
+                if (heap)
+                    heap_replay_release(heap, off, total);
+                if ((off != HEAP_REPLAY_NONE) || (heap == NULL))
+                    used -= total;
+            }
+            else if ((blk = heap_replay_add(set)) != NULL)
+            {
+                blk->ptr = evt->ptr;
+                blk->off = off;
+                blk->total = (heap && (off == HEAP_REPLAY_NONE)) ? 0 : total;
+                blk->sent = false;
+                blk->evt = e;
+            }
+            break;
+
+        case 'f':
+            if ((blk = heap_replay_find(set, evt->ptr)) != NULL)
+            {
+                if (heap)
+                    heap_replay_release(heap, blk->off, blk->total);
+                used -= blk->total;
+                heap_replay_drop(set, blk);
+            }
+            break;
+
+        case 's':
+            if ((blk = heap_replay_find(set, evt->ptr)) != NULL)
+                blk->sent = true;
+            break;
+
+        case 'k':
+            for (uint32_t i = 0; i < set->nb; )
+            {
+                if (set->blk[i].sent)
+                {
+                    if (heap)
+                        heap_replay_release(heap, set->blk[i].off, set->blk[i].total);
+                    used -= set->blk[i].total;
+                    heap_replay_drop(set, &set->blk[i]);
+                }
+                else
+                {
+                    i++;
+                }
+            }
+            break;
+
+        default:
+            break;
+        }
+    }
+}
+
+/*
+ * EXPORTED FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+int32_t heap_replay_read(FILE *f, struct heap_replay *rep)
+{
+    struct heap_replay_set set = {NULL, 0, 0};
+    uint32_t max = 0;
+    uint32_t line = 0;
+    uint32_t held = 0;
+    char buf[128];
+
+    memset(rep, 0, sizeof(*rep));
+
+    while (fgets(buf, sizeof(buf), f) != NULL)
+    {
+        struct heap_replay_evt evt;
+        unsigned int id, size;
+        char op;
+
+        line++;
+        memset(&evt, 0, sizeof(evt));
+        if (sscanf(buf, "heap %c", &op) != 1)
+            continue;
+
+        evt.op = op;
+        evt.line = line;
+        evt.tick = rep->tick_nb;
+        if (op == 'a')
+        {
+            if (sscanf(buf, "heap a %x %u %lx %lx", &id, &size, &evt.ptr, &evt.caller) != 4)
+                continue;
+            evt.id = (uint16_t)id;
+            evt.size = (uint16_t)size;
+        }
+        else if ((op == 'f') || (op == 's'))
+        {
+            if (sscanf(buf, "heap %*c %lx", &evt.ptr) != 1)
+                continue;
+        }
+        else if (op != 'k')
+        {
+            continue;
+        }
+
+        if (rep->evt_nb == max)
+        {
+            struct heap_replay_evt *more;
+
+            max = max ? 2 * max : 1024;
+            more = realloc(rep->evt, max * sizeof(*more));
+            if (more == NULL)
+            {
+                free(set.blk);
+                return -1;
+            }
+            rep->evt = more;
+        }
+        rep->evt[rep->evt_nb++] = evt;
+
+        // Counts and application peak, as the trace of the device keeps them
+        switch (op)
+        {
+        case 'a':
+            if (evt.ptr == 0)
+            {
+                rep->fail_nb++;
+                break;
+            }
+            rep->alloc_nb++;
+            if (evt.size > rep->req_max)
+                rep->req_max = evt.size;
+            {
+                struct heap_replay_live *blk = heap_replay_find(&set, evt.ptr);
+
+                if (blk != NULL)
+                {
+                    held -= blk->total;
+                    heap_replay_drop(&set, blk);
+                }
+                if ((blk = heap_replay_add(&set)) == NULL)
+                    return -1;
+                blk->ptr = evt.ptr;
+                blk->total = evt.size;
+                held += evt.size;
+                if (held > rep->app_peak)
+                    rep->app_peak = held;
+            }
+            break;
+        case 'f':
+        case 's':
+            if (op == 'f')
+                rep->free_nb++;
+            else
+                rep->send_nb++;
+            {
+                struct heap_replay_live *blk = heap_replay_find(&set, evt.ptr);
+
+                if (blk == NULL)
+                {
+                    rep->foreign_nb++;
+                    break;
+                }
+                held -= blk->total;
+                heap_replay_drop(&set, blk);
+            }
+            break;
+        default:
+            rep->tick_nb++;
+            break;
+        }
+    }
+
+    free(set.blk);
+
+    return (int32_t)rep->evt_nb;
+}
+
+void heap_replay_run(struct heap_replay const *rep, uint32_t size, uint32_t base,
+                     struct heap_replay_run *run)
+{
+    struct heap_replay_heap heap;
+    struct heap_replay_set set = {NULL, 0, 0};
+
+    memset(run, 0, sizeof(*run));
+
+    // At most one free block per allocated one, plus the first
+    heap.node = malloc((size / (HEAP_REPLAY_USED_HDR + 4) + 2) * sizeof(*heap.node));
+    heap.node_nb = 1;
+    heap.node[0].off = 0;
+    heap.node[0].size = size;
+
+    if ((base != 0) && (heap_replay_alloc(&heap, heap_replay_total(base)) == HEAP_REPLAY_NONE))
+        run->fail_nb++;
+
+    heap_replay_walk(rep, &heap, run, &set);
+    if (base != 0)
+        run->used_peak += heap_replay_total(base);
+
+    free(set.blk);
+    free(heap.node);
+}
+
+uint32_t heap_replay_min_size(struct heap_replay const *rep, uint32_t base)
+{
+    struct heap_replay_run run;
+    uint32_t lo = 0;
+    uint32_t hi = HEAP_REPLAY_SIZE_MAX;
+
+    heap_replay_run(rep, hi, base, &run);
+    if (run.fail_nb)
+        return 0;
+
+    // lo fails, hi fits
+    while (hi - lo > 4)
+    {
+        uint32_t mid = ((lo + hi) / 2) & ~3UL;
+
+        heap_replay_run(rep, mid, base, &run);
+        if (run.fail_nb)
+            lo = mid;
+        else
+            hi = mid;
+    }
+
+    return hi;
+}
+
+uint32_t heap_replay_leaks(struct heap_replay const *rep, uint32_t age,
+                           struct heap_replay_evt const **leak, uint32_t max)
+{
+    struct heap_replay_set set = {NULL, 0, 0};
+    uint32_t nb = 0;
+
+    heap_replay_walk(rep, NULL, NULL, &set);
+
+    for (uint32_t e = 0; e < rep->evt_nb; e++)
+    {
+        struct heap_replay_evt const *evt = &rep->evt[e];
+        struct heap_replay_live *blk;
+
+        if ((evt->op != 'a') || (evt->tick + age > rep->tick_nb))
+            continue;
+        blk = heap_replay_find(&set, evt->ptr);
+        if ((blk != NULL) && (blk->evt == e) && !blk->sent)
+        {
+            if (nb < max)
+                leak[nb] = evt;
+            nb++;
+        }
+    }
+
+    free(set.blk);
+
+    return nb;
+}
+
+void heap_replay_free(struct heap_replay *rep)
+{
+    free(rep->evt);
+    rep->evt = NULL;
+    rep->evt_nb = 0;
+}
+
+#ifndef HEAP_REPLAY_NO_MAIN
+int main(int argc, char *argv[])
+{
+    struct heap_replay rep;
+    struct heap_replay_run run;
+    struct heap_replay_evt const *leak[64];
+    uint32_t base = 0;
+    uint32_t age = 0;
+    uint32_t min, advice, leak_nb;
+    FILE *f = stdin;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "b:a:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'b':
+            base = strtoul(optarg, NULL, 0);
+            break;
+        case 'a':
+            age = strtoul(optarg, NULL, 0);
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-b base] [-a age] [log]\n", argv[0]);
+            return 2;
+        }
+    }
+    if ((optind < argc) && ((f = fopen(argv[optind], "r")) == NULL))
+    {
+        perror(argv[optind]);
+        return 2;
+    }
+
+    if (heap_replay_read(f, &rep) < 0)
+    {
+        fprintf(stderr, "out of memory\n");
+        return 2;
+    }
+
+    printf("events %u: %u allocations, %u failed on the device, %u frees, %u sent, %u runs, %u foreign\n",
+           rep.evt_nb, rep.alloc_nb, rep.fail_nb, rep.free_nb, rep.send_nb, rep.tick_nb, rep.foreign_nb);
+    printf("application peak %u bytes, largest request %u\n", rep.app_peak, rep.req_max);
+
+    min = heap_replay_min_size(&rep, base);
+    if (min == 0)
+    {
+        printf("the log does not fit in %u bytes\n", HEAP_REPLAY_SIZE_MAX);
+    }
+    else
+    {
+        heap_replay_run(&rep, min, base, &run);
+        advice = (min + heap_replay_total(rep.req_max) + HEAP_REPLAY_FREE_HDR + 3) & ~3UL;
+        printf("fits in %u bytes with base %u (peak %u), BLE_HEAP_SIZE advice %u\n",
+               min, base, run.used_peak, advice);
+    }
+
+    leak_nb = heap_replay_leaks(&rep, age, leak, sizeof(leak) / sizeof(leak[0]));
+    printf("held at the end, %u runs old or more: %u\n", age, leak_nb);
+    for (uint32_t i = 0; (i < leak_nb) && (i < sizeof(leak) / sizeof(leak[0])); i++)
+    {
+        printf("  line %u: id %04x size %u block %lx caller %lx\n", leak[i]->line, leak[i]->id,
+               leak[i]->size, leak[i]->ptr, leak[i]->caller);
+    }
+
+    heap_replay_free(&rep);
+    if (f != stdin)
+        fclose(f);
+
+    return 0;
+}
+#endif
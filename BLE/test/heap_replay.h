@@ -0,0 +1,143 @@
+/**
+ ****************************************************************************************
+ *
+ * @file heap_replay.h
+ *
+ * @brief Offline analyzer of the BLE heap trace log (CFG_HEAP_TRACE_LOG).
+ *
+ * Copyright(C) 2015 NXP Semiconductors N.V.
+ * All rights reserved.
+ *
+ * $Rev: $
+ *
+ ****************************************************************************************
+ */
+
+#ifndef HEAP_REPLAY_H_
+#define HEAP_REPLAY_H_
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// Headers of the ROM allocator of the chip: free block and allocated block
+#define HEAP_REPLAY_FREE_HDR        8
+#define HEAP_REPLAY_USED_HDR        4
+
+/*
+ * TYPE DEFINITIONS
+ ****************************************************************************************
+ */
+
+/// Event of the log
+struct heap_replay_evt
+{
+    /// 'a' allocation, 'f' free, 's' sent to the kernel, 'k' end of a scheduler run
+    char op;
+    /// Message identifier, 0xFFFF for ke_malloc()
+    uint16_t id;
+    /// Requested size
+    uint16_t size;
+    /// Block on the device, 0 for an allocation which failed
+    unsigned long ptr;
+    /// Return address of the allocation
+    unsigned long caller;
+    /// Line of the log
+    uint32_t line;
+    /// Scheduler runs logged before the event
+    uint32_t tick;
+};
+
+/// Log and what it tells without a heap model
+struct heap_replay
+{
+    struct heap_replay_evt *evt;
+    uint32_t evt_nb;
+    /// Allocations, the ones which failed on the device, frees and messages sent
+    uint32_t alloc_nb;
+    uint32_t fail_nb;
+    uint32_t free_nb;
+    uint32_t send_nb;
+    /// Scheduler runs
+    uint32_t tick_nb;
+    /// Frees and sends of blocks the application did not allocate, received messages
+    uint32_t foreign_nb;
+    /// Requested bytes held by the application at most, until freed or sent
+    uint32_t app_peak;
+    /// Largest request
+    uint16_t req_max;
+};
+
+/// Replay of the log on a heap of a given size
+struct heap_replay_run
+{
+    /// Allocations which did not fit
+    uint32_t fail_nb;
+    /// Bytes allocated at most, allocator headers included
+    uint32_t used_peak;
+};
+
+/*
+ * FUNCTION DECLARATIONS
+ ****************************************************************************************
+ */
+
+/*
+ ****************************************************************************************
+ * @brief Read a log, the lines which are not heap trace lines are skipped.
+ *
+ * @return Number of events read, -1 when out of memory.
+ ****************************************************************************************
+ */
+int32_t heap_replay_read(FILE *f, struct heap_replay *rep);
+
+/*
+ ****************************************************************************************
+ * @brief Replay the log on a model of the ROM allocator.
+ *
+ * The heap starts with base bytes taken by the stack, which the trace does not see.
+ * A message sent to the kernel is freed at the end of the scheduler run which follows.
+ * An allocation which failed on the device is tried and released at once.
+ ****************************************************************************************
+ */
+void heap_replay_run(struct heap_replay const *rep, uint32_t size, uint32_t base,
+                     struct heap_replay_run *run);
+
+/*
+ ****************************************************************************************
+ * @brief Smallest heap, in words, on which the whole log replays without a failure.
+ ****************************************************************************************
+ */
+uint32_t heap_replay_min_size(struct heap_replay const *rep, uint32_t base);
+
+/*
+ ****************************************************************************************
+ * @brief Blocks neither freed nor sent at the end of the log, allocated age scheduler
+ *        runs or more before it.
+ *
+ * @param[out] leak     Allocation events of the blocks, in log order
+ * @param[in]  max      Size of leak
+ *
+ * @return Number of blocks, may be more than max.
+ ****************************************************************************************
+ */
+uint32_t heap_replay_leaks(struct heap_replay const *rep, uint32_t age,
+                           struct heap_replay_evt const **leak, uint32_t max);
+
+/*
+ ****************************************************************************************
+ * @brief Free the events read by heap_replay_read().
+ ****************************************************************************************
+ */
+void heap_replay_free(struct heap_replay *rep);
+
+#endif // HEAP_REPLAY_H_
@@ -0,0 +1,34 @@
+/**
+ ****************************************************************************************
+ *
+ * @file app_config.h
+ *
+ * @brief Application configuration of the host build of the tests.
+ *
+ * Only the code without hardware access is built: the H4 framing without the UART
+ * transport. The tests built against the application sources (TEST_APP) use the
+ * configuration of the firmware build.
+ *
+ * Copyright(C) 2015 NXP Semiconductors N.V.
+ * All rights reserved.
+ *
+ * $Rev: $
+ *
+ ****************************************************************************************
+ */
+
+#if defined(TEST_APP)
+#include_next "app_config.h"
+#else
+
+#ifndef _APP_CONFIG_H_
+#define _APP_CONFIG_H_
+
+#include "usr_config.h"
+
+#define QN_HCI_H4                       0
+#define QN_HCI_SNOOP                    0
+
+#endif // _APP_CONFIG_H_
+
+#endif // TEST_APP
@@ -0,0 +1,93 @@
+/**
+ ****************************************************************************************
+ *
+ * @file driver_config.h
+ *
+ * @brief Driver configuration of the host build of the tests.
+ *
+ * Only the RTC driver is built, with the epoch clock. Its registers are functions of the
+ * test, which simulates the counter of a 32k clock running off its nominal frequency.
+ * The QNRF driver is only enabled for the declarations of qnrf.h used by lib.h.
+ *
+ * Copyright(C) 2015 NXP Semiconductors N.V.
+ * All rights reserved.
+ *
+ * $Rev: $
+ *
+ ****************************************************************************************
+ */
+
+#ifndef _DRIVER_CONFIG_H_
+#define _DRIVER_CONFIG_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "intc.h"
+
+#ifndef TRUE
+#define TRUE                            1
+#endif
+#ifndef FALSE
+#define FALSE                           0
+#endif
+
+#define CONFIG_ENABLE_DRIVER_QNRF       TRUE
+#define CONFIG_ENABLE_DRIVER_RTC        TRUE
+#define CONFIG_RTC_DEFAULT_IRQHANDLER   TRUE
+#define CONFIG_RTC_ENABLE_INTERRUPT     FALSE
+#define CONFIG_ENABLE_DRIVER_RTC_CAP    FALSE
+#define CONFIG_RTC_CAP_DEFAULT_IRQHANDLER FALSE
+#define CONFIG_RTC_CAP_ENABLE_INTERRUPT FALSE
+#define RTC_CALLBACK_EN                 FALSE
+#define RTC_CAP_CALLBACK_EN             FALSE
+#define RTC_EPOCH_EN                    TRUE
+
+/*
+ * REGISTERS, see QN9020.h and driver_QN9020.h
+ ****************************************************************************************
+ */
+
+#define MASK_ENABLE                     (0xFFFFFFFF)
+#define MASK_DISABLE                    (0x00000000)
+
+#define RTC_MASK_CAL_EN                 0x00000100
+#define RTC_MASK_CAP_EDGE_SEL           0x00000040
+#define RTC_MASK_CAP_IE                 0x00000020
+#define RTC_MASK_CAP_EN                 0x00000010
+#define RTC_MASK_CFG                    0x00000004
+#define RTC_MASK_CORR_EN                0x00000002
+#define RTC_MASK_SEC_IE                 0x00000001
+#define RTC_MASK_CALIB_SYNC_BUSY        0x00001000
+#define RTC_MASK_CORR_SYNC_BUSY         0x00000800
+#define RTC_MASK_SEC_SYNC_BUSY          0x00000400
+#define RTC_MASK_SR_SYNC_BUSY           0x00000200
+#define RTC_MASK_CR_SYNC_BUSY           0x00000100
+#define RTC_MASK_CAP_IF                 0x00000010
+#define RTC_MASK_SEC_IF                 0x00000001
+#define RTC_POS_SEC_CORR                15
+#define RTC_MASK_CNT_VAL                0x00007FFF
+
+#define SYSCON_MASK_GATING_32K_CLK      0x00800000
+#define SYSCON_MASK_32K_RST             0x00000800
+
+typedef struct test_rtc QN_RTC_TypeDef;
+
+#define QN_RTC                          ((QN_RTC_TypeDef *)0)
+#define QN_SYSCON                       0
+
+#define syscon_SetCRSC(syscon, value)
+#define syscon_SetCRSS(syscon, value)
+#define NVIC_EnableIRQ(irq)
+
+extern void rtc_rtc_SetCRWithMask(QN_RTC_TypeDef *RTC, uint32_t mask, uint32_t value);
+extern uint32_t rtc_rtc_GetCR(QN_RTC_TypeDef *RTC);
+extern void rtc_rtc_ClrSR(QN_RTC_TypeDef *RTC, uint32_t value);
+extern uint32_t rtc_rtc_GetSR(QN_RTC_TypeDef *RTC);
+extern void rtc_rtc_SetSecVal(QN_RTC_TypeDef *RTC, uint32_t value);
+extern uint32_t rtc_rtc_GetSecVal(QN_RTC_TypeDef *RTC);
+extern void rtc_rtc_SetCORR(QN_RTC_TypeDef *RTC, uint32_t value);
+extern void rtc_rtc_SetCalVal(QN_RTC_TypeDef *RTC, uint32_t value);
+extern uint32_t rtc_rtc_GetCNT(QN_RTC_TypeDef *RTC);
+
+#endif // _DRIVER_CONFIG_H_
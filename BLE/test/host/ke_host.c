@@ -0,0 +1,457 @@
+/**
+ ****************************************************************************************
+ *
+ * @file ke_host.c
+ *
+ * @brief Kernel of the host build of the tests.
+ *
+ * Messages are queued in the order they are sent and handled one at a time after the
+ * pending events. A message is given to the handler of the current state of its task,
+ * then to the default handler, like in the ROM kernel. Saved messages go back to the
+ * queue when their task changes state. Timers expire on a simulated clock in units of
+ * 10ms which only moves in ke_host_run().
+ *
+ * Copyright(C) 2015 NXP Semiconductors N.V.
+ * All rights reserved.
+ *
+ * $Rev: $
+ *
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ke_host.h"
+#include "ke_msg.h"
+#include "ke_task.h"
+#include "lib.h"
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// Task types which can be registered
+#define KE_HOST_TASK_NB                 64
+/// Timers running at the same time
+#define KE_HOST_TIMER_NB                32
+/// Kernel events
+#define KE_HOST_EVT_NB                  32
+/// Event callbacks called in a row before the scheduler gives up on one which does not clear
+#define KE_HOST_EVT_LOOP_MAX            1000
+
+/// Message queue
+struct ke_host_queue
+{
+    struct ke_msg *first;
+    struct ke_msg *last;
+};
+
+/// Running timer
+struct ke_host_timer
+{
+    /// Expiry time, unit 10ms
+    uint32_t time;
+    ke_msg_id_t id;
+    ke_task_id_t task;
+    bool used;
+};
+
+/*
+ * LOCAL VARIABLE DEFINITIONS
+ ****************************************************************************************
+ */
+
+static struct ke_task_desc ke_host_desc[KE_HOST_TASK_NB];
+static struct ke_host_queue ke_host_sent;
+static struct ke_host_queue ke_host_saved;
+static struct ke_host_timer ke_host_timer[KE_HOST_TIMER_NB];
+static void (*ke_host_evt_cb[KE_HOST_EVT_NB])(void);
+static uint32_t ke_host_evt;
+static uint32_t ke_host_now;
+static uint32_t ke_host_live;
+static uint32_t ke_host_lost;
+
+/*
+ * LOCAL FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+static void ke_host_push_back(struct ke_host_queue *queue, struct ke_msg *msg)
+{
+    msg->hdr.next = NULL;
+    if (queue->last == NULL)
+    {
+        queue->first = msg;
+    }
+    else
+    {
+        queue->last->hdr.next = &msg->hdr;
+    }
+    queue->last = msg;
+}
+
+static void ke_host_push_front(struct ke_host_queue *queue, struct ke_msg *msg)
+{
+    msg->hdr.next = (struct co_list_hdr *)queue->first;
+    queue->first = msg;
+    if (queue->last == NULL)
+    {
+        queue->last = msg;
+    }
+}
+
+static struct ke_msg *ke_host_pop(struct ke_host_queue *queue)
+{
+    struct ke_msg *msg = queue->first;
+
+    if (msg != NULL)
+    {
+        queue->first = (struct ke_msg *)msg->hdr.next;
+        if (queue->first == NULL)
+        {
+            queue->last = NULL;
+        }
+    }
+
+    return msg;
+}
+
+static ke_msg_func_t ke_host_handler_find(struct ke_state_handler const *state, ke_msg_id_t id)
+{
+    if (state != NULL)
+    {
+        for (uint16_t i = 0; i < state->msg_cnt; i++)
+        {
+            if (state->msg_table[i].id == id)
+            {
+                return state->msg_table[i].func;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+static void ke_host_dispatch(struct ke_msg *msg)
+{
+    uint8_t type = KE_TYPE_GET(msg->dest_id);
+    uint8_t idx = KE_IDX_GET(msg->dest_id);
+    struct ke_task_desc const *desc = (type < KE_HOST_TASK_NB) ? &ke_host_desc[type] : NULL;
+    ke_msg_func_t func = NULL;
+    int status;
+
+    if ((desc != NULL) && (desc->state != NULL) && (idx < desc->idx_max))
+    {
+        if ((desc->state_handler != NULL) && (desc->state[idx] < desc->state_max))
+        {
+            func = ke_host_handler_find(&desc->state_handler[desc->state[idx]], msg->id);
+        }
+        if (func == NULL)
+        {
+            func = ke_host_handler_find(desc->default_handler, msg->id);
+        }
+    }
+
+    if (func == NULL)
+    {
+        ke_host_lost++;
+        ke_host_msg_free(msg);
+        return;
+    }
+
+    status = func(msg->id, ke_msg2param(msg), msg->dest_id, msg->src_id);
+    if (status == KE_MSG_CONSUMED)
+    {
+        ke_host_msg_free(msg);
+    }
+    else if (status == KE_MSG_SAVED)
+    {
+        ke_host_push_back(&ke_host_saved, msg);
+    }
+}
+
+static void ke_host_events(void)
+{
+    uint32_t loop = 0;
+
+    while ((ke_host_evt != 0) && (loop++ < KE_HOST_EVT_LOOP_MAX))
+    {
+        uint8_t evt = __builtin_ctz(ke_host_evt);
+
+        if (ke_host_evt_cb[evt] != NULL)
+        {
+            ke_host_evt_cb[evt]();
+        }
+        else
+        {
+            ke_host_evt &= ~(1UL << evt);
+        }
+    }
+}
+
+/*
+ * EXPORTED FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+void *ke_host_msg_alloc(ke_msg_id_t const id, ke_task_id_t const dest_id,
+                        ke_task_id_t const src_id, uint16_t const param_len)
+{
+    struct ke_msg *msg = calloc(1, sizeof(struct ke_msg) + param_len);
+
+    msg->id = id;
+    msg->dest_id = dest_id;
+    msg->src_id = src_id;
+    msg->param_len = param_len;
+    ke_host_live++;
+
+    return ke_msg2param(msg);
+}
+
+void ke_host_msg_send(void const *param_ptr)
+{
+    ke_host_push_back(&ke_host_sent, ke_param2msg(param_ptr));
+}
+
+void ke_host_msg_send_front(void const *param_ptr)
+{
+    ke_host_push_front(&ke_host_sent, ke_param2msg(param_ptr));
+}
+
+void ke_host_msg_send_basic(ke_msg_id_t const id, ke_task_id_t const dest_id, ke_task_id_t const src_id)
+{
+    ke_host_msg_send(ke_host_msg_alloc(id, dest_id, src_id, 0));
+}
+
+void ke_host_msg_forward(void const *param_ptr, ke_task_id_t const dest_id, ke_task_id_t const src_id)
+{
+    struct ke_msg *msg = ke_param2msg(param_ptr);
+
+    msg->dest_id = dest_id;
+    msg->src_id = src_id;
+    ke_host_push_back(&ke_host_sent, msg);
+}
+
+void ke_host_msg_free(struct ke_msg const *msg)
+{
+    ke_host_live--;
+    free((void *)msg);
+}
+
+void *ke_host_malloc(uint32_t size)
+{
+    return malloc(size);
+}
+
+void ke_host_free(void *mem_ptr)
+{
+    free(mem_ptr);
+}
+
+void ke_host_timer_set(ke_msg_id_t const timer_id, ke_task_id_t const task, uint16_t const delay)
+{
+    struct ke_host_timer *free_timer = NULL;
+
+    for (uint8_t i = 0; i < KE_HOST_TIMER_NB; i++)
+    {
+        if (ke_host_timer[i].used && (ke_host_timer[i].id == timer_id) && (ke_host_timer[i].task == task))
+        {
+            free_timer = &ke_host_timer[i];
+            break;
+        }
+        if (!ke_host_timer[i].used && (free_timer == NULL))
+        {
+            free_timer = &ke_host_timer[i];
+        }
+    }
+
+    if (free_timer != NULL)
+    {
+        // A null delay expires on the next tick, like in the ROM
+        free_timer->time = ke_host_now + ((delay != 0) ? delay : 1);
+        free_timer->id = timer_id;
+        free_timer->task = task;
+        free_timer->used = true;
+    }
+}
+
+void ke_host_timer_clear(ke_msg_id_t const timer_id, ke_task_id_t const task)
+{
+    for (uint8_t i = 0; i < KE_HOST_TIMER_NB; i++)
+    {
+        if (ke_host_timer[i].used && (ke_host_timer[i].id == timer_id) && (ke_host_timer[i].task == task))
+        {
+            ke_host_timer[i].used = false;
+        }
+    }
+}
+
+void ke_host_evt_set(uint32_t const event)
+{
+    ke_host_evt |= event;
+}
+
+void ke_host_evt_clear(uint32_t const event)
+{
+    ke_host_evt &= ~event;
+}
+
+enum KE_EVENT_STATUS ke_host_evt_callback_set(uint8_t event_type, void (*p_callback)(void))
+{
+    if (event_type >= KE_HOST_EVT_NB)
+    {
+        return KE_EVENT_CAPA_EXCEEDED;
+    }
+    ke_host_evt_cb[event_type] = p_callback;
+
+    return KE_EVENT_OK;
+}
+
+void ke_host_state_set(ke_task_id_t const id, ke_state_t const state_id)
+{
+    uint8_t type = KE_TYPE_GET(id);
+    struct ke_task_desc const *desc = (type < KE_HOST_TASK_NB) ? &ke_host_desc[type] : NULL;
+    struct ke_msg *msg;
+    struct ke_host_queue saved = ke_host_saved;
+
+    if ((desc == NULL) || (desc->state == NULL) || (KE_IDX_GET(id) >= desc->idx_max))
+    {
+        return;
+    }
+    if (desc->state[KE_IDX_GET(id)] == state_id)
+    {
+        return;
+    }
+    desc->state[KE_IDX_GET(id)] = state_id;
+
+    // Saved messages of the task are handled again in the new state
+    ke_host_saved.first = ke_host_saved.last = NULL;
+    while ((msg = ke_host_pop(&saved)) != NULL)
+    {
+        ke_host_push_back((msg->dest_id == id) ? &ke_host_sent : &ke_host_saved, msg);
+    }
+}
+
+ke_state_t ke_host_state_get(ke_task_id_t const id)
+{
+    uint8_t type = KE_TYPE_GET(id);
+
+    if ((type >= KE_HOST_TASK_NB) || (ke_host_desc[type].state == NULL)
+        || (KE_IDX_GET(id) >= ke_host_desc[type].idx_max))
+    {
+        return 0;
+    }
+
+    return ke_host_desc[type].state[KE_IDX_GET(id)];
+}
+
+void ke_host_task_desc_register(uint8_t task_id, struct ke_task_desc task_desc)
+{
+    if (task_id < KE_HOST_TASK_NB)
+    {
+        ke_host_desc[task_id] = task_desc;
+    }
+}
+
+/**
+ ****************************************************************************************
+ * @brief Drop the messages, timers, events and tasks, and restart the clock.
+ ****************************************************************************************
+ */
+void ke_host_init(void)
+{
+    struct ke_msg *msg;
+
+    while ((msg = ke_host_pop(&ke_host_sent)) != NULL)
+    {
+        ke_host_msg_free(msg);
+    }
+    while ((msg = ke_host_pop(&ke_host_saved)) != NULL)
+    {
+        ke_host_msg_free(msg);
+    }
+    memset(ke_host_desc, 0, sizeof(ke_host_desc));
+    memset(ke_host_timer, 0, sizeof(ke_host_timer));
+    memset(ke_host_evt_cb, 0, sizeof(ke_host_evt_cb));
+    ke_host_evt = 0;
+    ke_host_now = 0;
+    ke_host_live = 0;
+    ke_host_lost = 0;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Handle the pending events and messages without moving the clock.
+ ****************************************************************************************
+ */
+void ke_host_schedule(void)
+{
+    struct ke_msg *msg;
+
+    do
+    {
+        ke_host_events();
+        msg = ke_host_pop(&ke_host_sent);
+        if (msg != NULL)
+        {
+            ke_host_dispatch(msg);
+        }
+    } while ((msg != NULL) || (ke_host_evt != 0));
+}
+
+/**
+ ****************************************************************************************
+ * @brief Move the clock to until, expiring the timers on the way.
+ ****************************************************************************************
+ */
+void ke_host_run(uint32_t until)
+{
+    for (;;)
+    {
+        struct ke_host_timer *next = NULL;
+
+        ke_host_schedule();
+
+        for (uint8_t i = 0; i < KE_HOST_TIMER_NB; i++)
+        {
+            if (ke_host_timer[i].used && ((next == NULL) || ((int32_t)(ke_host_timer[i].time - next->time) < 0)))
+            {
+                next = &ke_host_timer[i];
+            }
+        }
+        if ((next == NULL) || ((int32_t)(next->time - until) > 0))
+        {
+            break;
+        }
+
+        ke_host_now = next->time;
+        next->used = false;
+        ke_host_msg_send_basic(next->id, next->task, next->task);
+    }
+
+    ke_host_now = until;
+}
+
+/// Current time of the simulated clock, unit 10ms
+uint32_t ke_host_time(void)
+{
+    return ke_host_now;
+}
+
+/// Messages allocated and not freed yet
+uint32_t ke_host_msg_live(void)
+{
+    return ke_host_live;
+}
+
+/// Messages dropped because their task has no handler for them
+uint32_t ke_host_msg_lost(void)
+{
+    return ke_host_lost;
+}
@@ -0,0 +1,106 @@
+/**
+ ****************************************************************************************
+ *
+ * @file ke_host.h
+ *
+ * @brief Kernel of the host build of the tests.
+ *
+ * The application and profile sources reach the kernel through the ROM addresses of
+ * fw_func_addr.h. This header takes the real addresses and points the kernel ones to
+ * ke_host.c, which queues the messages, runs the timers on a simulated clock, calls
+ * the event callbacks and dispatches the messages through the task descriptors given
+ * to task_desc_register() like the ROM does. The other ROM functions are not available
+ * on the host, the tests must not call them.
+ *
+ * Copyright(C) 2015 NXP Semiconductors N.V.
+ * All rights reserved.
+ *
+ * $Rev: $
+ *
+ ****************************************************************************************
+ */
+
+#ifndef _KE_HOST_H_
+#define _KE_HOST_H_
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+#include <stdint.h>
+#include "../../src/fw/fw_func_addr.h"
+
+/*
+ * ROM API REDIRECTION
+ ****************************************************************************************
+ */
+
+#undef _ke_msg_alloc
+#define _ke_msg_alloc                   ke_host_msg_alloc
+#undef _ke_msg_send
+#define _ke_msg_send                    ke_host_msg_send
+#undef _ke_msg_send_front
+#define _ke_msg_send_front              ke_host_msg_send_front
+#undef _ke_msg_send_basic
+#define _ke_msg_send_basic              ke_host_msg_send_basic
+#undef _ke_msg_forward
+#define _ke_msg_forward                 ke_host_msg_forward
+#undef _ke_msg_free
+#define _ke_msg_free                    ke_host_msg_free
+#undef _ke_malloc
+#define _ke_malloc                      ke_host_malloc
+#undef _ke_free
+#define _ke_free                        ke_host_free
+#undef _ke_timer_set
+#define _ke_timer_set                   ke_host_timer_set
+#undef _ke_timer_clear
+#define _ke_timer_clear                 ke_host_timer_clear
+#undef _ke_evt_set
+#define _ke_evt_set                     ke_host_evt_set
+#undef _ke_evt_clear
+#define _ke_evt_clear                   ke_host_evt_clear
+#undef _ke_evt_callback_set
+#define _ke_evt_callback_set            ke_host_evt_callback_set
+#undef _ke_state_set
+#define _ke_state_set                   ke_host_state_set
+#undef _ke_state_get
+#define _ke_state_get                   ke_host_state_get
+#undef _task_desc_register
+#define _task_desc_register             ke_host_task_desc_register
+
+/*
+ * FUNCTION DECLARATIONS
+ ****************************************************************************************
+ */
+
+struct ke_msg;
+struct ke_task_desc;
+
+// Kernel functions, see the ROM prototypes in ke_msg.h, ke_mem.h, ke_timer.h, ke_task.h and lib.h
+extern void *ke_host_msg_alloc(uint16_t const id, uint16_t const dest_id,
+                               uint16_t const src_id, uint16_t const param_len);
+extern void ke_host_msg_send(void const *param_ptr);
+extern void ke_host_msg_send_front(void const *param_ptr);
+extern void ke_host_msg_send_basic(uint16_t const id, uint16_t const dest_id, uint16_t const src_id);
+extern void ke_host_msg_forward(void const *param_ptr, uint16_t const dest_id, uint16_t const src_id);
+extern void ke_host_msg_free(struct ke_msg const *msg);
+extern void *ke_host_malloc(uint32_t size);
+extern void ke_host_free(void *mem_ptr);
+extern void ke_host_timer_set(uint16_t const timer_id, uint16_t const task, uint16_t const delay);
+extern void ke_host_timer_clear(uint16_t const timer_id, uint16_t const task);
+extern void ke_host_evt_set(uint32_t const event);
+extern void ke_host_evt_clear(uint32_t const event);
+extern enum KE_EVENT_STATUS ke_host_evt_callback_set(uint8_t event_type, void (*p_callback)(void));
+extern void ke_host_state_set(uint16_t const id, uint16_t const state_id);
+extern uint16_t ke_host_state_get(uint16_t const id);
+extern void ke_host_task_desc_register(uint8_t task_id, struct ke_task_desc task_desc);
+
+// Test control
+extern void ke_host_init(void);
+extern void ke_host_schedule(void);
+extern void ke_host_run(uint32_t until);
+extern uint32_t ke_host_time(void);
+extern uint32_t ke_host_msg_live(void);
+extern uint32_t ke_host_msg_lost(void);
+
+#endif // _KE_HOST_H_
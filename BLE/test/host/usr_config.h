@@ -0,0 +1,48 @@
+/**
+ ****************************************************************************************
+ *
+ * @file usr_config.h
+ *
+ * @brief User configuration of the host build of the tests.
+ *
+ * Nothing is enabled, except for the tests built against the application sources
+ * (TEST_APP): they get a single link peripheral on the kernel of ke_host.h, their
+ * profiles and options are added by their Makefile rule.
+ *
+ * Copyright(C) 2015 NXP Semiconductors N.V.
+ * All rights reserved.
+ *
+ * $Rev: $
+ *
+ ****************************************************************************************
+ */
+
+#ifndef USR_CONFIG_H_
+#define USR_CONFIG_H_
+
+#if defined(TEST_APP)
+
+/// Chip version, QN_9020_B2 is given by the project files of the firmware build
+#define CFG_9020_B2
+#define QN_9020_B2
+
+/// Work mode
+#define CFG_WM_SOC
+
+/// Max connection number
+#define CFG_CON 1
+
+/// GAP role
+#define CFG_PERIPHERAL
+
+/// Local address type
+#define CFG_ADDR_PUBLIC
+
+/// ATT parts
+#define CFG_ATTS
+
+#include "ke_host.h"
+
+#endif
+
+#endif // USR_CONFIG_H_
@@ -0,0 +1,23 @@
+/**
+ ****************************************************************************************
+ *
+ * @file usr_design.h
+ *
+ * @brief User design of the host build of the tests, defined by each test.
+ *
+ * Copyright(C) 2015 NXP Semiconductors N.V.
+ * All rights reserved.
+ *
+ * $Rev: $
+ *
+ ****************************************************************************************
+ */
+
+#ifndef USR_DESIGN_H_
+#define USR_DESIGN_H_
+
+#include "ke_msg.h"
+
+extern void app_task_msg_hdl(ke_msg_id_t const msgid, void const *param);
+
+#endif // USR_DESIGN_H_
@@ -0,0 +1,333 @@
+/**
+ ****************************************************************************************
+ *
+ * @file test_bond.c
+ *
+ * @brief Host test and benchmark of the private address resolution of app_util.c.
+ *
+ * The software ah() is checked against the sample data of the Core specification. For
+ * 1 to 64 bonds, the resolvable private addresses of every bond which distributed an IRK
+ * must resolve to it, the others and the non resolvable addresses must not. The time of
+ * one resolution, of the first one after a bond change (key expansion) and of a cache
+ * hit are measured, with the IRK requests SMPC needs without local resolution.
+ *
+ * Copyright(C) 2015 NXP Semiconductors N.V.
+ * All rights reserved.
+ *
+ * $Rev: $
+ *
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "app_env.h"
+
+bool test_bdaddr_compare(struct bd_addr const *bd_address1, struct bd_addr const *bd_address2);
+
+#undef _co_bt_bdaddr_compare
+#define _co_bt_bdaddr_compare       test_bdaddr_compare
+
+// app_util.c is included for its static AES, which generates the addresses of the test
+#include "../src/app/app_util.c"
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// Resolutions timed per measurement
+#define TEST_LOOP_NB                2000
+/// Every TEST_NO_IRK_MOD-th bond did not distribute an IRK
+#define TEST_NO_IRK_MOD             5
+
+/*
+ * LOCAL VARIABLE DEFINITIONS
+ ****************************************************************************************
+ */
+
+static uint32_t test_fail;
+
+/*
+ * GLOBAL VARIABLE DEFINITIONS
+ ****************************************************************************************
+ */
+
+struct app_env_tag app_env;
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+#define TEST_CHECK(cond, ...)                                                       \
+    do {                                                                            \
+        if (!(cond))                                                                \
+        {                                                                           \
+            if (test_fail < 20)                                                     \
+            {                                                                       \
+                printf("%s:%d: %s: ", __FILE__, __LINE__, #cond);                   \
+                printf(__VA_ARGS__);                                                \
+                printf("\n");                                                       \
+            }                                                                       \
+            test_fail++;                                                            \
+        }                                                                           \
+    } while (0)
+
+static uint32_t test_rand(void)
+{
+    static uint32_t x = 2463534242UL;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+
+    return x;
+}
+
+bool test_bdaddr_compare(struct bd_addr const *bd_address1, struct bd_addr const *bd_address2)
+{
+    return memcmp(bd_address1, bd_address2, sizeof(struct bd_addr)) == 0;
+}
+
+static double test_now_us(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Resolvable private address of an IRK: hash = ah(IRK, prand), both LSB first.
+ ****************************************************************************************
+ */
+static void test_rpa_make(struct smp_key const *irk, uint32_t prand, struct bd_addr *addr)
+{
+    uint8_t rk[APP_AES_RK_LEN];
+    uint8_t s[KEY_LEN];
+
+    // Resolvable private address has 0b01 in the two most significant bits
+    prand = (prand & 0x3FFFFF) | 0x400000;
+
+    app_aes_expand(irk, rk);
+    memset(s, 0, KEY_LEN);
+    s[KEY_LEN - 3] = (uint8_t)(prand >> 16);
+    s[KEY_LEN - 2] = (uint8_t)(prand >> 8);
+    s[KEY_LEN - 1] = (uint8_t)prand;
+    app_aes_encrypt(rk, s);
+
+    addr->addr[0] = s[KEY_LEN - 1];
+    addr->addr[1] = s[KEY_LEN - 2];
+    addr->addr[2] = s[KEY_LEN - 3];
+    addr->addr[3] = (uint8_t)prand;
+    addr->addr[4] = (uint8_t)(prand >> 8);
+    addr->addr[5] = (uint8_t)(prand >> 16);
+}
+
+static void test_irk_rand(struct smp_key *irk)
+{
+    for (uint8_t i = 0; i < KEY_LEN; i++)
+    {
+        irk->key[i] = (uint8_t)test_rand();
+    }
+}
+
+/**
+ ****************************************************************************************
+ * @brief Empty the bonded database, as app_init() does.
+ ****************************************************************************************
+ */
+static void test_bond_clear(void)
+{
+    memset(&app_env, 0, sizeof(app_env));
+    app_env.bonded_info = (struct app_bonded_info *)app_env.bonded_db;
+    app_rpa_reset();
+}
+
+/**
+ ****************************************************************************************
+ * @brief Bond a device, with or without its IRK.
+ ****************************************************************************************
+ */
+static void test_bond_add(struct smp_key const *irk, bool idkey)
+{
+    struct app_bonded_info info;
+
+    memset(&info, 0, sizeof(info));
+    info.sec_prop = 1;
+    info.peer_distribute_keys = SMP_KDIST_ENCKEY | (idkey ? SMP_KDIST_IDKEY : 0);
+    info.addr_type = ADDR_RAND;
+    info.pair_info.irk = *irk;
+    test_rpa_make(irk, test_rand(), &info.peer_addr);
+    TEST_CHECK(app_add_bonded_dev(&info), "bond %u not added", app_env.bonded_count);
+}
+
+/**
+ ****************************************************************************************
+ * @brief ah() sample data of the Core specification (Vol 3, Part H, D.7).
+ ****************************************************************************************
+ */
+static void test_ah_sample(void)
+{
+    // IRK 0xec0234a357c8ad05341010a60a397d9b, prand 0x708194, hash 0x0dfbaa
+    struct smp_key irk = {{0x9b, 0x7d, 0x39, 0x0a, 0xa6, 0x10, 0x10, 0x34,
+                           0x05, 0xad, 0xc8, 0x57, 0xa3, 0x34, 0x02, 0xec}};
+    struct bd_addr addr = {{0xaa, 0xfb, 0x0d, 0x94, 0x81, 0x70}};
+    struct bd_addr made;
+
+    test_rpa_make(&irk, 0x708194, &made);
+    TEST_CHECK(co_bt_bdaddr_compare(&addr, &made), "ah: hash %02x%02x%02x",
+               made.addr[2], made.addr[1], made.addr[0]);
+
+    test_bond_clear();
+    test_bond_add(&irk, true);
+    TEST_CHECK(app_rpa_resolve(&addr) == 0, "ah: sample address not resolved");
+}
+
+/**
+ ****************************************************************************************
+ * @brief Every bond resolves to itself, the others do not resolve.
+ ****************************************************************************************
+ */
+static void test_resolve(uint8_t bond_nb, struct smp_key *irk)
+{
+    struct bd_addr addr;
+    struct smp_key other;
+
+    for (uint8_t i = 0; i < bond_nb; i++)
+    {
+        bool idkey = (i % TEST_NO_IRK_MOD) != (TEST_NO_IRK_MOD - 1);
+        uint8_t idx;
+
+        test_rpa_make(&irk[i], test_rand(), &addr);
+        idx = app_rpa_resolve(&addr);
+        TEST_CHECK(idx == (idkey ? i : GAP_INVALID_CONIDX), "%u bonds: bond %u resolved to %u",
+                   bond_nb, i, idx);
+    }
+
+    test_irk_rand(&other);
+    test_rpa_make(&other, test_rand(), &addr);
+    TEST_CHECK(app_rpa_resolve(&addr) == GAP_INVALID_CONIDX, "%u bonds: unknown IRK resolved", bond_nb);
+
+    // Static random address with the hash of a bond
+    test_rpa_make(&irk[0], test_rand(), &addr);
+    addr.addr[BD_ADDR_LEN - 1] |= 0xC0;
+    TEST_CHECK(app_rpa_resolve(&addr) == GAP_INVALID_CONIDX, "%u bonds: static address resolved", bond_nb);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Resolution time against the number of bonds, the matching IRK last.
+ ****************************************************************************************
+ */
+static void test_bench(void)
+{
+    static const uint8_t bond_nbs[] = {1, 2, 4, 8, 16, 32, 64};
+    struct smp_key irk[APP_MAX_BONDED_DEVICE_NUMBER];
+    struct bd_addr addr[TEST_LOOP_NB];
+    volatile uint8_t idx;
+
+    printf("%6s %12s %12s %12s %14s %10s\n", "bonds", "resolve us", "first us", "hit us",
+           "SMPC IRK reqs", "RAM B");
+
+    for (uint8_t b = 0; b < sizeof(bond_nbs) / sizeof(bond_nbs[0]); b++)
+    {
+        uint8_t bond_nb = bond_nbs[b];
+        uint8_t last = bond_nb - 1;
+        double t, resolve_us, first_us = 0, hit_us;
+
+        if (bond_nb > APP_MAX_BONDED_DEVICE_NUMBER)
+        {
+            break;
+        }
+
+        test_bond_clear();
+        for (uint8_t i = 0; i < bond_nb; i++)
+        {
+            test_irk_rand(&irk[i]);
+            // The timed bond, the last one, always has its IRK
+            test_bond_add(&irk[i], (i == last) || ((i % TEST_NO_IRK_MOD) != (TEST_NO_IRK_MOD - 1)));
+        }
+        for (uint32_t n = 0; n < TEST_LOOP_NB; n++)
+        {
+            test_rpa_make(&irk[last], test_rand(), &addr[n]);
+        }
+
+        // First resolution after a bond change expands the IRKs
+        for (uint32_t n = 0; n < TEST_LOOP_NB / 100; n++)
+        {
+            app_rpa_reset();
+            t = test_now_us();
+            idx = app_rpa_resolve(&addr[n]);
+            first_us += test_now_us() - t;
+        }
+        first_us /= TEST_LOOP_NB / 100;
+
+        // New addresses miss the cache
+        t = test_now_us();
+        for (uint32_t n = 0; n < TEST_LOOP_NB; n++)
+        {
+            idx = app_rpa_resolve(&addr[n]);
+        }
+        resolve_us = (test_now_us() - t) / TEST_LOOP_NB;
+        TEST_CHECK(idx == last, "%u bonds: resolved to %u", bond_nb, idx);
+
+        t = test_now_us();
+        for (uint32_t n = 0; n < TEST_LOOP_NB; n++)
+        {
+            idx = app_rpa_resolve(&addr[TEST_LOOP_NB - 1]);
+        }
+        hit_us = (test_now_us() - t) / TEST_LOOP_NB;
+        TEST_CHECK(idx == last, "%u bonds: cache hit resolved to %u", bond_nb, idx);
+
+        test_resolve(bond_nb, irk);
+
+        // Without local resolution SMPC asks for the IRKs one by one until one matches
+        printf("%6u %12.2f %12.2f %12.3f %14u %10u\n", bond_nb, resolve_us, first_us, hit_us,
+               bond_nb, (unsigned)(bond_nb * (APP_AES_RK_LEN + 1)));
+    }
+}
+
+/**
+ ****************************************************************************************
+ * @brief A new bond drops the expanded keys and the cache, it resolves at once.
+ ****************************************************************************************
+ */
+static void test_bond_change(void)
+{
+    struct smp_key irk[2];
+    struct bd_addr addr;
+
+    test_bond_clear();
+    test_irk_rand(&irk[0]);
+    test_bond_add(&irk[0], true);
+    test_rpa_make(&irk[0], test_rand(), &addr);
+    TEST_CHECK(app_rpa_resolve(&addr) == 0, "change: first bond");
+    TEST_CHECK(app_rpa_env.cache_nb == 1, "change: cache %u", app_rpa_env.cache_nb);
+
+    test_irk_rand(&irk[1]);
+    test_bond_add(&irk[1], true);
+    TEST_CHECK(!app_rpa_env.ready && (app_rpa_env.cache_nb == 0), "change: keys kept");
+    test_rpa_make(&irk[1], test_rand(), &addr);
+    TEST_CHECK(app_rpa_resolve(&addr) == 1, "change: second bond");
+}
+
+int main(void)
+{
+    test_ah_sample();
+    test_bond_change();
+    test_bench();
+
+    printf("bond: %s (%u failures)\n", test_fail ? "FAIL" : "OK", test_fail);
+
+    return test_fail ? 1 : 0;
+}
@@ -0,0 +1,351 @@
+/**
+ ****************************************************************************************
+ *
+ * @file test_conn_policy.c
+ *
+ * @brief Host simulation of the connection parameter policy of app_util.c.
+ *
+ * Traffic traces are played on a slave link of the host kernel, the policy timer
+ * ticking as on the device. A model of the master answers the update requests half a
+ * second later, accepting, rejecting or picking its own parameters. The requests must
+ * come at the tick the policy rules give, respect the holdoffs and the specification
+ * limits, and the radio events the link costs are compared with those of a link kept
+ * on its connection parameters.
+ *
+ * Copyright(C) 2015 NXP Semiconductors N.V.
+ * All rights reserved.
+ *
+ * $Rev: $
+ *
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "app_env.h"
+
+// app_util.c is included for the static state of its connection parameter policy
+#include "../src/app/app_util.c"
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// Simulated time of a run, 90s in 10ms
+#define TEST_RUN                    9000
+/// Period of the traffic of the traces, in 10ms, off the ticks of the policy
+#define TEST_TRAFFIC_PERIOD         10
+#define TEST_TRAFFIC_OFFSET         5
+/// Answer of the master to an update request, in 10ms
+#define TEST_MASTER_DELAY           50
+/// Requests recorded at most
+#define TEST_REQ_MAX                32
+/// Connection parameters of the links at connection, 50ms
+#define TEST_CONN_INTV              0x0028
+/// Connection handle of the link
+#define TEST_CONHDL                 0x0001
+
+/// Messages of the test
+enum
+{
+    TEST_TRAFFIC_TIMER = 0x0c00,
+    TEST_MASTER_TIMER,
+};
+
+/// Phase of a traffic trace
+struct test_phase
+{
+    /// End of the phase, in 10ms
+    uint32_t end;
+    /// Bytes exchanged each traffic period
+    uint16_t len;
+    /// Bulk transfer in progress
+    bool busy;
+};
+
+/// Behaviour of the master
+struct test_master
+{
+    /// Fast requests rejected first
+    uint8_t reject_fast;
+    /// Parameters the master picks for the fast and the slow requests, 0 for those requested
+    uint16_t fast_intv, fast_latency;
+    uint16_t slow_intv, slow_latency;
+};
+
+/// Update request sent by the policy
+struct test_req
+{
+    uint32_t time;
+    struct gap_conn_param_update par;
+};
+
+/*
+ * LOCAL VARIABLE DEFINITIONS
+ ****************************************************************************************
+ */
+
+static uint32_t test_fail;
+
+static ke_state_t test_app_state[1];
+
+/// Run of the simulation
+static struct
+{
+    struct test_phase const *trace;
+    struct test_master const *master;
+    bool busy;
+    /// Requests sent, the last one waits for the master while pending is set
+    struct test_req req[TEST_REQ_MAX];
+    uint8_t req_nb;
+    bool pending;
+    uint8_t rejected;
+    /// Connection parameters of the link and their last change, in 10ms
+    uint16_t intv, latency;
+    uint32_t since;
+    /// Radio events of the link
+    double events;
+} test_run;
+
+/*
+ * GLOBAL VARIABLE DEFINITIONS
+ ****************************************************************************************
+ */
+
+struct app_env_tag app_env;
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+#define TEST_CHECK(cond, ...)                                                       \
+    do {                                                                            \
+        if (!(cond))                                                                \
+        {                                                                           \
+            if (test_fail < 20)                                                     \
+            {                                                                       \
+                printf("%s:%d: %s: ", __FILE__, __LINE__, #cond);                   \
+                printf(__VA_ARGS__);                                                \
+                printf("\n");                                                       \
+            }                                                                       \
+            test_fail++;                                                            \
+        }                                                                           \
+    } while (0)
+
+void app_task_msg_hdl(ke_msg_id_t const msgid, void const *param)
+{
+}
+
+/// Radio events of the link up to now, an event every (1 + latency) intervals of 1.25ms
+static void test_link_account(void)
+{
+    uint32_t now = ke_host_time();
+
+    test_run.events += (double)(now - test_run.since) * 8 / ((uint32_t)test_run.intv * (1 + test_run.latency));
+    test_run.since = now;
+}
+
+/// Update request of the slave, the master answers it later
+void app_gap_param_update_req(uint16_t conhdl, struct gap_conn_param_update *conn_par)
+{
+    TEST_CHECK(conhdl == TEST_CONHDL, "conhdl %u", conhdl);
+    TEST_CHECK(!test_run.pending, "request at %u while one is in progress", ke_host_time());
+    TEST_CHECK(app_check_update_conn_param(conn_par), "request at %u out of the specification", ke_host_time());
+
+    if (test_run.req_nb < TEST_REQ_MAX)
+    {
+        test_run.req[test_run.req_nb].time = ke_host_time();
+        test_run.req[test_run.req_nb++].par = *conn_par;
+    }
+    test_run.pending = true;
+    ke_timer_set(TEST_MASTER_TIMER, TASK_APP, TEST_MASTER_DELAY);
+}
+
+static int test_master_timer_handler(ke_msg_id_t const msgid, void const *param,
+                                     ke_task_id_t const dest_id, ke_task_id_t const src_id)
+{
+    struct test_master const *master = test_run.master;
+    struct gap_conn_param_update const *par = &test_run.req[test_run.req_nb - 1].par;
+    bool fast = (par->latency == 0);
+    uint16_t intv = fast ? master->fast_intv : master->slow_intv;
+    uint16_t latency = fast ? master->fast_latency : master->slow_latency;
+
+    test_run.pending = false;
+    if (fast && (test_run.rejected < master->reject_fast))
+    {
+        test_run.rejected++;
+        app_conn_policy_update_resp(false);
+        return (KE_MSG_CONSUMED);
+    }
+
+    if (intv == 0)
+    {
+        intv = par->intv_max;
+        latency = par->latency;
+    }
+    app_conn_policy_update_resp(true);
+    test_link_account();
+    test_run.intv = intv;
+    test_run.latency = latency;
+    app_conn_policy_param_ind(intv, latency);
+
+    return (KE_MSG_CONSUMED);
+}
+
+/// Traffic of the trace, as the profiles account it
+static int test_traffic_timer_handler(ke_msg_id_t const msgid, void const *param,
+                                      ke_task_id_t const dest_id, ke_task_id_t const src_id)
+{
+    uint32_t now = ke_host_time();
+    struct test_phase const *phase = test_run.trace;
+
+    while ((phase->end != 0) && (phase->end <= now))
+        phase++;
+    if (phase->end == 0)
+        return (KE_MSG_CONSUMED);
+
+    if (phase->busy != test_run.busy)
+    {
+        test_run.busy = phase->busy;
+        app_conn_policy_busy(phase->busy);
+    }
+    if (phase->len)
+        app_conn_policy_traffic(phase->len);
+
+    ke_timer_set(TEST_TRAFFIC_TIMER, TASK_APP, TEST_TRAFFIC_PERIOD);
+
+    return (KE_MSG_CONSUMED);
+}
+
+static const struct ke_msg_handler test_app_default_state[] =
+{
+    {APP_CONN_POLICY_TIMER,     (ke_msg_func_t)app_conn_policy_timer_handler},
+    {TEST_TRAFFIC_TIMER,        (ke_msg_func_t)test_traffic_timer_handler},
+    {TEST_MASTER_TIMER,         (ke_msg_func_t)test_master_timer_handler},
+};
+
+static const struct ke_state_handler test_app_default = KE_STATE_HANDLER(test_app_default_state);
+
+/**
+ ****************************************************************************************
+ * @brief Connection at 0, the trace played until TEST_RUN.
+ *
+ * @param[in] intv      Connection interval at connection, in 1.25ms
+ * @param[in] latency   Slave latency at connection
+ * @param[in] stop      Disconnection time, in 10ms, 0 for none
+ ****************************************************************************************
+ */
+static void test_link(const char *name, struct test_phase const *trace, struct test_master const *master,
+                      uint16_t intv, uint16_t latency, uint32_t stop)
+{
+    struct ke_task_desc app_desc = {NULL, &test_app_default, test_app_state, 1, 1};
+    uint8_t fast = 0;
+    double kept;
+
+    ke_host_init();
+    task_desc_register(TASK_APP, app_desc);
+    memset(&test_run, 0, sizeof(test_run));
+    test_run.trace = trace;
+    test_run.master = master;
+    test_run.intv = intv;
+    test_run.latency = latency;
+
+    app_conn_policy_start(TEST_CONHDL, intv, latency);
+    ke_timer_set(TEST_TRAFFIC_TIMER, TASK_APP, TEST_TRAFFIC_OFFSET);
+    if (stop != 0)
+    {
+        ke_host_run(stop);
+        app_conn_policy_stop(TEST_CONHDL);
+        test_link_account();
+        test_run.intv = 0;
+    }
+    ke_host_run(TEST_RUN);
+    if (test_run.intv != 0)
+        test_link_account();
+
+    for (uint8_t i = 0; i < test_run.req_nb; i++)
+    {
+        if (test_run.req[i].par.latency == 0)
+            fast++;
+    }
+    kept = (double)(stop ? stop : TEST_RUN) * 8 / ((uint32_t)intv * (1 + latency));
+    printf("%-28s %4u %4u %9.0f %9.0f %8.1f\n", name, fast, test_run.req_nb - fast, test_run.events, kept,
+           test_run.events * 100 / (stop ? stop : TEST_RUN));
+}
+
+/// Requests expected, a time in 10ms and 'F' or 'S' for the parameter set
+static void test_expect(const char *name, uint8_t nb, uint32_t const *time, char const *set)
+{
+    TEST_CHECK(test_run.req_nb == nb, "%s: %u requests", name, test_run.req_nb);
+
+    for (uint8_t i = 0; (i < nb) && (i < test_run.req_nb); i++)
+    {
+        char got = (test_run.req[i].par.latency == 0) ? 'F' : 'S';
+
+        TEST_CHECK(test_run.req[i].time == time[i] && got == set[i], "%s: request %u %c at %u, expected %c at %u",
+                   name, i, got, test_run.req[i].time, set[i], time[i]);
+    }
+}
+
+int main(void)
+{
+    // Idle for 20s, a 10s burst, idle again
+    static const struct test_phase burst[] = {{2000, 0}, {3000, 30}, {TEST_RUN + 1, 0}, {0}};
+    // A 40s burst
+    static const struct test_phase long_burst[] = {{2000, 0}, {6000, 30}, {TEST_RUN + 1, 0}, {0}};
+    // An OTA transfer of 30s with nothing accounted, then idle
+    static const struct test_phase ota[] = {{3000, 0, true}, {TEST_RUN + 1, 0}, {0}};
+    // A few bytes every period, under the burst threshold
+    static const struct test_phase light[] = {{TEST_RUN + 1, 1}, {0}};
+    static const struct test_phase idle[] = {{TEST_RUN + 1, 0}, {0}};
+    static const struct test_master accept = {0};
+    static const struct test_master reject = {1};
+    static const struct test_master own = {0, 0x0010, 0, 0x0120, 1};
+    static const struct test_master out = {0, 0, 0, 0x0050, 0};
+
+    printf("%-28s %4s %4s %9s %9s %8s\n", "case", "fast", "slow", "events", "kept", "events/s");
+
+    // Slow after the connection holdoff and the idle ticks, fast at the first tick of the burst
+    test_link("burst", burst, &accept, TEST_CONN_INTV, 0, 0);
+    test_expect("burst", 3, (uint32_t[]){600, 2100, 3600}, "SFS");
+
+    // A rejected request is not sent again before the reject holdoff
+    test_link("burst, fast rejected", long_burst, &reject, TEST_CONN_INTV, 0, 0);
+    test_expect("burst, fast rejected", 4,
+                (uint32_t[]){600, 2100, 2100 + (APP_CONN_POLICY_REJECT_HOLDOFF + 1) * 100, 6600}, "SFFS");
+
+    // Fast parameters at connection are kept while a bulk transfer is in progress
+    test_link("ota", ota, &accept, APP_CONN_POLICY_FAST_INTV_MIN, 0, 0);
+    test_expect("ota", 1, (uint32_t[]){3600}, "S");
+
+    // Light traffic keeps the connection parameters
+    test_link("light", light, &accept, TEST_CONN_INTV, 0, 0);
+    test_expect("light", 0, NULL, "");
+
+    // Parameters of the master in the requested set are followed
+    test_link("burst, master parameters", burst, &own, TEST_CONN_INTV, 0, 0);
+    test_expect("burst, master parameters", 3, (uint32_t[]){600, 2100, 3600}, "SFS");
+
+    // Parameters of the master out of both sets are asked again after the reject holdoff only
+    test_link("idle, master out of set", idle, &out, TEST_CONN_INTV, 0, 0);
+    TEST_CHECK(test_run.req_nb > 1, "%u requests", test_run.req_nb);
+    for (uint8_t i = 1; i < test_run.req_nb; i++)
+        TEST_CHECK(test_run.req[i].time - test_run.req[i - 1].time > APP_CONN_POLICY_REJECT_HOLDOFF * 100,
+                   "requests %u at %u and %u", i, test_run.req[i - 1].time, test_run.req[i].time);
+
+    // Nothing is requested after the disconnection
+    test_link("burst, disconnected", burst, &accept, TEST_CONN_INTV, 0, 2500);
+    test_expect("burst, disconnected", 2, (uint32_t[]){600, 2100}, "SF");
+
+    printf("conn_policy: %s (%u failures)\n", test_fail ? "FAIL" : "OK", test_fail);
+
+    return test_fail ? 1 : 0;
+}
@@ -0,0 +1,507 @@
+/**
+ ****************************************************************************************
+ *
+ * @file test_eaci_codec.c
+ *
+ * @brief Host fuzz test and benchmark of the Easy ACI message codec of eaci_codec.c.
+ *
+ * Every command, event and profile data layout of eaci_schema.h is packed from random
+ * fields and unpacked again, and the lengths around the layout length are checked.
+ * Random layouts with random parameter lengths are compared with a reference model of
+ * the length check and of the address lookup. The rate of packing and of unpacking a
+ * data message is measured.
+ *
+ * Copyright(C) 2015 NXP Semiconductors N.V.
+ * All rights reserved.
+ *
+ * $Rev: $
+ *
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "attm.h"
+#include "eaci_codec.h"
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// Fields passed to the codec, above the longest layout
+#define TEST_FIELD_MAX              20
+/// Random layouts of the fuzz test
+#define TEST_FUZZ_NB                200000
+/// Longest random layout
+#define TEST_FUZZ_LAYOUT_MAX        12
+/// Messages packed and unpacked per measurement
+#define TEST_LOOP_NB                2000000
+/// Message types, which the codec only copies into the header
+#define TEST_MSG_TYPE_EVT           0xED
+#define TEST_MSG_TYPE_DATA_REQ      0xEB
+#define TEST_MSG_TYPE_DATA_IND      0xEC
+
+/*
+ * LOCAL VARIABLE DEFINITIONS
+ ****************************************************************************************
+ */
+
+static uint32_t test_fail;
+
+/// Fields of a message as the test generates them
+static struct
+{
+    uint32_t val[TEST_FIELD_MAX];
+    struct bd_addr addr[TEST_FIELD_MAX];
+    uint8_t var_len;
+    uint8_t var[EACI_PDU_MAX_LEN];
+} test_msg;
+
+/// Fields of a message as the codec unpacks them
+static struct
+{
+    uint8_t b[TEST_FIELD_MAX];
+    uint16_t h[TEST_FIELD_MAX];
+    uint32_t w[TEST_FIELD_MAX];
+    struct bd_addr addr[TEST_FIELD_MAX];
+    uint8_t var_len;
+    uint8_t const *var;
+} test_out;
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+#define TEST_CHECK(cond, ...)                                                       \
+    do {                                                                            \
+        if (!(cond))                                                                \
+        {                                                                           \
+            if (test_fail < 20)                                                     \
+            {                                                                       \
+                printf("%s:%d: %s: ", __FILE__, __LINE__, #cond);                   \
+                printf(__VA_ARGS__);                                                \
+                printf("\n");                                                       \
+            }                                                                       \
+            test_fail++;                                                            \
+        }                                                                           \
+    } while (0)
+
+static uint32_t test_rand(void)
+{
+    static uint32_t x = 2463534242UL;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+
+    return x;
+}
+
+/// Length of the fixed part of a layout, *var set if it ends with a variable field
+static uint16_t test_layout_len(char const *layout, bool *var)
+{
+    uint16_t len = 0;
+
+    *var = false;
+    for (; *layout != '\0'; layout++)
+    {
+        switch (*layout)
+        {
+            case 'B': len += 1; break;
+            case 'H': len += 2; break;
+            case 'W': len += 4; break;
+            case 'A': len += BD_ADDR_LEN; break;
+            case 's': *var = true; break;
+            default: break;
+        }
+    }
+
+    return len;
+}
+
+/// Offset of the first address of a layout, -1 if it has none before a variable field
+static int test_layout_addr_off(char const *layout)
+{
+    int off = 0;
+
+    for (; *layout != '\0'; layout++)
+    {
+        switch (*layout)
+        {
+            case 'B': off += 1; break;
+            case 'H': off += 2; break;
+            case 'W': off += 4; break;
+            case 'A': return off;
+            default: return -1;
+        }
+    }
+
+    return -1;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Random fields for a layout, and the parameters they pack into.
+ *
+ * Every field is passed to the codec as a uintptr_t, which the host ABIs hand to the
+ * va_arg() of an unsigned int, a uint32_t or a pointer alike.
+ ****************************************************************************************
+ */
+static uint16_t test_fields(char const *layout, uint16_t var_max, uintptr_t *arg, uint8_t *param)
+{
+    uint16_t len = 0;
+    uint8_t n = 0;
+
+    for (uint8_t k = 0; layout[k] != '\0'; k++)
+    {
+        uint32_t v = test_rand();
+
+        switch (layout[k])
+        {
+            case 'B':
+                test_msg.val[k] = v & 0xff;
+                param[len++] = (uint8_t)v;
+                arg[n++] = test_msg.val[k];
+                break;
+            case 'H':
+                test_msg.val[k] = v & 0xffff;
+                param[len++] = (uint8_t)v;
+                param[len++] = (uint8_t)(v >> 8);
+                arg[n++] = test_msg.val[k];
+                break;
+            case 'W':
+                test_msg.val[k] = v;
+                for (uint8_t i = 0; i < 4; i++)
+                    param[len++] = (uint8_t)(v >> (8 * i));
+                arg[n++] = test_msg.val[k];
+                break;
+            case 'A':
+                for (uint8_t i = 0; i < BD_ADDR_LEN; i++)
+                    test_msg.addr[k].addr[i] = param[len++] = (uint8_t)test_rand();
+                arg[n++] = (uintptr_t)&test_msg.addr[k];
+                break;
+            case 's':
+                test_msg.var_len = var_max ? (uint8_t)(v % (var_max + 1)) : 0;
+                for (uint16_t i = 0; i < test_msg.var_len; i++)
+                    test_msg.var[i] = param[len++] = (uint8_t)test_rand();
+                arg[n++] = test_msg.var_len;
+                arg[n++] = (uintptr_t)test_msg.var;
+                break;
+            default:
+                break;
+        }
+    }
+
+    return len;
+}
+
+/// Where each field of a layout is unpacked
+static void test_out_args(char const *layout, uintptr_t *arg)
+{
+    uint8_t n = 0;
+
+    for (uint8_t k = 0; layout[k] != '\0'; k++)
+    {
+        switch (layout[k])
+        {
+            case 'B': arg[n++] = (uintptr_t)&test_out.b[k]; break;
+            case 'H': arg[n++] = (uintptr_t)&test_out.h[k]; break;
+            case 'W': arg[n++] = (uintptr_t)&test_out.w[k]; break;
+            case 'A': arg[n++] = (uintptr_t)&test_out.addr[k]; break;
+            case 's':
+                arg[n++] = (uintptr_t)&test_out.var_len;
+                arg[n++] = (uintptr_t)&test_out.var;
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+/// Unpacked fields against the generated ones
+static bool test_out_match(char const *layout)
+{
+    for (uint8_t k = 0; layout[k] != '\0'; k++)
+    {
+        switch (layout[k])
+        {
+            case 'B':
+                if (test_out.b[k] != test_msg.val[k])
+                    return false;
+                break;
+            case 'H':
+                if (test_out.h[k] != test_msg.val[k])
+                    return false;
+                break;
+            case 'W':
+                if (test_out.w[k] != test_msg.val[k])
+                    return false;
+                break;
+            case 'A':
+                if (memcmp(&test_out.addr[k], &test_msg.addr[k], sizeof(struct bd_addr)))
+                    return false;
+                break;
+            case 's':
+                if (test_out.var_len != test_msg.var_len || memcmp(test_out.var, test_msg.var, test_msg.var_len))
+                    return false;
+                break;
+            default:
+                break;
+        }
+    }
+
+    return true;
+}
+
+#define TEST_ARGS(a)    a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7], a[8], a[9], a[10], a[11],     \
+                        a[12], a[13], a[14], a[15], a[16], a[17], a[18], a[19]
+
+/**
+ ****************************************************************************************
+ * @brief Pack and unpack one layout, with a service UUID for a data message.
+ ****************************************************************************************
+ */
+static void test_round_trip(char const *name, char const *layout, bool data, uint16_t uuid)
+{
+    uint8_t pdu[EACI_PDU_MAX_LEN];
+    uint8_t param[EACI_PDU_MAX_LEN];
+    uintptr_t arg[TEST_FIELD_MAX] = {0};
+    uint8_t hdr_len = EACI_PDU_HDR_LEN + (data ? EACI_DATA_UUID_LEN : 0);
+    uint8_t id = (uint8_t)test_rand();
+    bool var;
+    uint16_t fix = test_layout_len(layout, &var);
+    uint16_t len, plen;
+
+    TEST_CHECK(fix <= 0xFF - (hdr_len - EACI_PDU_HDR_LEN), "%s: layout %s too long", name, layout);
+    if (fix > 0xFF - (hdr_len - EACI_PDU_HDR_LEN))
+        return;
+
+    plen = test_fields(layout, 0xFF - (hdr_len - EACI_PDU_HDR_LEN) - fix, arg, param);
+    if (data)
+        len = eaci_data_pack(pdu, TEST_MSG_TYPE_DATA_IND, id, uuid, layout, TEST_ARGS(arg));
+    else
+        len = eaci_pack(pdu, TEST_MSG_TYPE_EVT, id, layout, TEST_ARGS(arg));
+
+    TEST_CHECK(len == hdr_len + plen, "%s: %s packed into %u bytes, not %u", name, layout, len, hdr_len + plen);
+    if (len != hdr_len + plen)
+        return;
+    TEST_CHECK(pdu[1] == id && pdu[2] == len - EACI_PDU_HDR_LEN, "%s: header %02x %02x", name, pdu[1], pdu[2]);
+    TEST_CHECK(!data || (pdu[3] | pdu[4] << 8) == uuid, "%s: UUID %02x%02x", name, pdu[4], pdu[3]);
+    TEST_CHECK(!memcmp(pdu + hdr_len, param, plen), "%s: %s packed wrong", name, layout);
+
+    test_out_args(layout, arg);
+    TEST_CHECK(eaci_unpack(pdu + hdr_len, (uint8_t)plen, layout, TEST_ARGS(arg)) && test_out_match(layout),
+               "%s: %s unpacked wrong", name, layout);
+
+    // The lengths around the layout length
+    TEST_CHECK(eaci_layout_check(layout, (uint8_t)fix), "%s: %s rejects %u", name, layout, fix);
+    TEST_CHECK(fix == 0 || !eaci_layout_check(layout, (uint8_t)(fix - 1)), "%s: %s takes %u", name, layout, fix - 1);
+    TEST_CHECK(fix == 0xFF || eaci_layout_check(layout, (uint8_t)(fix + 1)) == var, "%s: %s and %u", name, layout,
+               fix + 1);
+    TEST_CHECK(fix == 0 || !eaci_unpack(param, (uint8_t)(fix - 1), layout, TEST_ARGS(arg)), "%s: %s unpacks %u",
+               name, layout, fix - 1);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Every layout of the schema.
+ ****************************************************************************************
+ */
+static void test_schema(void)
+{
+    uint32_t req_nb = 0, ind_nb = 0;
+    char name[32];
+
+    for (uint8_t id = 0; id < EACI_MSG_CMD_MAX; id++)
+    {
+        if (eaci_cmd_layout[id] == NULL)
+            continue;
+        snprintf(name, sizeof(name), "command %u", id);
+        test_round_trip(name, eaci_cmd_layout[id], false, 0);
+    }
+
+    for (uint8_t id = 0; id < EACI_MSG_EVT_MAX; id++)
+    {
+        if (eaci_evt_layout[id] == NULL)
+            continue;
+        snprintf(name, sizeof(name), "event %u", id);
+        test_round_trip(name, eaci_evt_layout[id], false, 0);
+    }
+
+    // The profile services are 16 bit UUIDs of the SIG in 0x18xx
+    for (uint32_t uuid = 0; uuid <= 0xFFFF; uuid++)
+    {
+        for (uint16_t id = 0; id <= 0xFF; id++)
+        {
+            char const *req = eaci_data_req_layout((uint16_t)uuid, (uint8_t)id);
+            char const *ind = eaci_data_ind_layout((uint16_t)uuid, (uint8_t)id);
+            bool var;
+
+            TEST_CHECK((req == NULL && ind == NULL) || (uuid & 0xFF00) == 0x1800, "layout under UUID %04x", uuid);
+            // Id 0 is reserved by every profile
+            TEST_CHECK(id != 0 || (req == NULL && ind == NULL), "UUID %04x: layout of id 0", uuid);
+
+            if (req != NULL)
+            {
+                req_nb++;
+                snprintf(name, sizeof(name), "request %04x/%u", uuid, id);
+                TEST_CHECK(test_layout_len(req, &var) <= EACI_DATA_FIX_MAX_LEN || var, "%s: %s", name, req);
+                test_round_trip(name, req, true, (uint16_t)uuid);
+            }
+            if (ind != NULL)
+            {
+                ind_nb++;
+                snprintf(name, sizeof(name), "indication %04x/%u", uuid, id);
+                TEST_CHECK(test_layout_len(ind, &var) <= EACI_DATA_FIX_MAX_LEN || var, "%s: %s", name, ind);
+                test_round_trip(name, ind, true, (uint16_t)uuid);
+            }
+        }
+    }
+
+    // A few messages of the profiles
+    TEST_CHECK(!strcmp(eaci_data_req_layout(ATT_SVC_ALERT_NTF, EACI_MSG_DATA_REQ_ANPC_WR_VAL), "BHA"), "ANPC write");
+    TEST_CHECK(!strcmp(eaci_data_ind_layout(ATT_SVC_BATTERY_SERVICE, EACI_MSG_DATA_IND_BASS_BATT_UPD_CFM), "B"),
+               "BASS update");
+    TEST_CHECK(eaci_data_req_layout(ATT_SVC_ALERT_NTF, EACI_MSG_DATA_REQ_ANPS_NTF_UNREAD_ALERT + 1) == NULL, "ANPS max");
+    TEST_CHECK(eaci_data_ind_layout(ATT_SVC_GENERIC_ACCESS, 1) == NULL, "GAP data");
+    TEST_CHECK(req_nb > 0 && ind_nb > 0, "no data layout");
+
+    printf("schema: %u commands, %u events, %u data requests, %u data indications\n", EACI_MSG_CMD_MAX,
+           EACI_MSG_EVT_MAX, req_nb, ind_nb);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Random layouts and parameter lengths against the reference model.
+ ****************************************************************************************
+ */
+static void test_fuzz(void)
+{
+    static const char field[] = "BHWA";
+    char layout[TEST_FUZZ_LAYOUT_MAX + 2];
+    uint8_t param[0xFF];
+    uintptr_t arg[TEST_FIELD_MAX] = {0};
+
+    for (uint8_t i = 0; i < sizeof(param); i++)
+        param[i] = (uint8_t)test_rand();
+
+    for (uint32_t n = 0; n < TEST_FUZZ_NB; n++)
+    {
+        uint8_t nb = test_rand() % (TEST_FUZZ_LAYOUT_MAX + 1);
+        uint8_t param_len = (uint8_t)test_rand();
+        bool var;
+        uint16_t fix;
+        int off;
+        uint8_t const *addr;
+        bool ok;
+
+        for (uint8_t k = 0; k < nb; k++)
+            layout[k] = field[test_rand() % 4];
+        if (test_rand() & 1)
+            layout[nb++] = 's';
+        layout[nb] = '\0';
+
+        fix = test_layout_len(layout, &var);
+        off = test_layout_addr_off(layout);
+        // Short lengths around the layout length are the interesting ones
+        if (test_rand() & 1)
+            param_len = (uint8_t)(fix + (int)(test_rand() % 5) - 2);
+
+        ok = var ? param_len >= fix : param_len == fix;
+        TEST_CHECK(eaci_layout_check(layout, param_len) == ok, "%s with %u bytes", layout, param_len);
+
+        addr = eaci_layout_addr(layout, param, param_len);
+        if (off < 0 || off + BD_ADDR_LEN > param_len)
+            TEST_CHECK(addr == NULL, "%s with %u bytes: address at %d", layout, param_len, (int)(addr - param));
+        else
+            TEST_CHECK(addr == param + off, "%s with %u bytes: address at %d, not %d", layout, param_len,
+                       addr ? (int)(addr - param) : -1, off);
+
+        test_out_args(layout, arg);
+        TEST_CHECK(eaci_unpack(param, param_len, layout, TEST_ARGS(arg)) == ok, "%s unpacks %u bytes", layout,
+                   param_len);
+
+        if (fix + EACI_DATA_UUID_LEN <= 0xFF)
+            test_round_trip("fuzz", layout, n & 1, 0x1800 | (n & 0xFF));
+    }
+
+    TEST_CHECK(!eaci_layout_check(NULL, 0), "unknown message");
+    TEST_CHECK(eaci_layout_addr(NULL, param, sizeof(param)) == NULL, "address of an unknown message");
+    TEST_CHECK(eaci_data_pack(param, TEST_MSG_TYPE_DATA_REQ, 1, 0x1800, NULL) == 0, "pack of an unknown message");
+
+    printf("fuzz: %u random layouts\n", TEST_FUZZ_NB);
+}
+
+static double test_elapsed_s(struct timespec const *t0)
+{
+    struct timespec t1;
+
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    return (t1.tv_sec - t0->tv_sec) + (t1.tv_nsec - t0->tv_nsec) * 1e-9;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Rate of a data message through the codec, as a handler sends and receives it.
+ ****************************************************************************************
+ */
+static void test_bench(void)
+{
+    uint16_t uuid = ATT_SVC_RUNNING_SPEED_CADENCE;
+    uint8_t id = EACI_MSG_DATA_REQ_RSCPS_NTF_MEAS;
+    char const *layout = eaci_data_req_layout(uuid, id);
+    struct bd_addr addr = {{1, 2, 3, 4, 5, 6}};
+    uint8_t pdu[EACI_PDU_MAX_LEN];
+    volatile uint32_t sink = 0;
+    struct timespec t0;
+    double pack_s, unpack_s;
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (uint32_t n = 0; n < TEST_LOOP_NB; n++)
+        sink += eaci_data_pack(pdu, TEST_MSG_TYPE_DATA_REQ, id, uuid, eaci_data_req_layout(uuid, id),
+                               n & 0xff, 0x80, n & 0xffff, 0x0102, n, &addr);
+    pack_s = test_elapsed_s(&t0);
+    TEST_CHECK(sink == TEST_LOOP_NB * 21u, "%u bytes packed", sink);
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (uint32_t n = 0; n < TEST_LOOP_NB; n++)
+    {
+        uint8_t flags, cadence;
+        uint16_t speed, stride;
+        uint32_t dist;
+
+        pdu[5] = (uint8_t)n;
+        // The dispatcher check and the handler unpack, each after its own layout lookup
+        if (eaci_layout_check(eaci_data_req_layout(uuid, id), pdu[2] - EACI_DATA_UUID_LEN)
+            && eaci_unpack(pdu + 5, pdu[2] - EACI_DATA_UUID_LEN, eaci_data_req_layout(uuid, id),
+                           &flags, &cadence, &speed, &stride, &dist, &addr))
+            sink += flags;
+    }
+    unpack_s = test_elapsed_s(&t0);
+    TEST_CHECK(addr.addr[5] == 6, "address unpacked");
+
+    printf("%-8s %-8s %10s %10s\n", "layout", "", "messages", "msg/s");
+    printf("%-8s %-8s %10u %10.0f\n", layout, "pack", TEST_LOOP_NB, TEST_LOOP_NB / pack_s);
+    printf("%-8s %-8s %10u %10.0f\n", layout, "unpack", TEST_LOOP_NB, TEST_LOOP_NB / unpack_s);
+}
+
+int main(void)
+{
+    test_schema();
+    test_fuzz();
+    test_bench();
+
+    printf("eaci_codec: %s (%u failures)\n", test_fail ? "FAIL" : "OK", test_fail);
+
+    return test_fail ? 1 : 0;
+}
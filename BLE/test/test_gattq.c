@@ -0,0 +1,597 @@
+/**
+ ****************************************************************************************
+ *
+ * @file test_gattq.c
+ *
+ * @brief Host simulation of the GATT client queue of prf_utils.c on a link, from the
+ *        end of the discovery to a client ready to use the peer.
+ *
+ * The profile clients of a collector enable the services of a peer: they write the
+ * client configurations and read the values of known length with the length they pass
+ * to prf_read_char_send(), and read a few strings. The GATT is replaced by a task which
+ * answers one ATT request at a time, a round trip after it, from the attribute table of
+ * the peer. Read Multiple responses are split on the lengths of the request as the GATT
+ * does, so every value must reach its client unchanged and in order, and every write
+ * must reach the peer. The setup is run with the lengths and with all lengths 0, as the
+ * clients passed before, to compare the ATT requests and the time to ready. A
+ * disconnection in the middle of the setup drops the requests left, the next connection
+ * starts on an empty queue.
+ *
+ * Copyright(C) 2015 NXP Semiconductors N.V.
+ * All rights reserved.
+ *
+ * $Rev: $
+ *
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "app_env.h"
+
+uint8_t test_get_rec_idx(uint16_t conhdl);
+uint16_t test_get_mtu(uint8_t idx);
+
+#undef _gap_get_rec_idx
+#define _gap_get_rec_idx            test_get_rec_idx
+#undef _attm_get_mtu
+#define _attm_get_mtu               test_get_mtu
+
+#include "../src/profiles/prf_utils.c"
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// Connection handle of the link
+#define TEST_CONHDL                 0x0001
+/// Connection interval (unit: 10ms)
+#define TEST_CON_INTV               3
+/// An ATT request goes in a connection event, its response comes in the next one
+#define TEST_ATT_RTT                (2 * TEST_CON_INTV)
+/// Timer of the GATT task sending the response
+#define TEST_GATT_RSP_TIMER         (GATT_CMP_EVT + 0x40)
+
+/// Profile clients of the collector, the owners of the requests
+enum
+{
+    TEST_HRPC,
+    TEST_BASC,
+    TEST_DISC,
+    TEST_CSCPC,
+
+    TEST_CLIENT_NB,
+};
+
+/// Attribute of the peer
+struct test_att
+{
+    uint16_t handle;
+    /// Length of the value, given to prf_read_char_send() when fixed by the specification
+    uint8_t len;
+    bool fixed;
+    uint8_t value[ATTM_MAX_VALUE];
+};
+
+/// Read or write of the setup
+struct test_op
+{
+    uint8_t client;
+    uint16_t handle;
+    bool write;
+};
+
+/*
+ * LOCAL VARIABLE DEFINITIONS
+ ****************************************************************************************
+ */
+
+static uint32_t test_fail;
+
+static ke_state_t test_app_state[1 + BLE_CONNECTION_MAX];
+static ke_state_t test_gatt_state[1];
+static ke_state_t test_client_state[TEST_CLIENT_NB];
+
+/// Attribute table of the peer: Heart Rate, Battery, Device Information, Cycling Speed
+static struct test_att test_att[] =
+{
+    {0x000e, 1, true,  {0x01}},
+    {0x0010, 2, true,  {0x00, 0x00}},
+    {0x0020, 1, true,  {0x5a}},
+    {0x0021, 2, true,  {0x00, 0x00}},
+    {0x0022, 7, true,  {0x04, 0x00, 0xad, 0x27, 0x01, 0x00, 0x00}},
+    {0x0030, 18, false, "NXP Semiconductors"},
+    {0x0032, 6, false, "QN9020"},
+    {0x0034, 8, true,  {0x01, 0x02, 0x03, 0xfe, 0xff, 0x04, 0x05, 0x06}},
+    {0x0036, 7, true,  {0x01, 0x1f, 0x00, 0x20, 0x90, 0x00, 0x01}},
+    {0x0040, 2, true,  {0x03, 0x00}},
+    {0x0042, 1, true,  {0x0c}},
+    {0x0044, 2, true,  {0x00, 0x00}},
+};
+
+/// Setup of the clients, in the order they enable
+static const struct test_op test_setup[] =
+{
+    {TEST_HRPC,  0x0010, true},
+    {TEST_HRPC,  0x000e, false},
+    {TEST_BASC,  0x0020, false},
+    {TEST_BASC,  0x0022, false},
+    {TEST_BASC,  0x0021, true},
+    {TEST_DISC,  0x0030, false},
+    {TEST_DISC,  0x0032, false},
+    {TEST_DISC,  0x0034, false},
+    {TEST_DISC,  0x0036, false},
+    {TEST_CSCPC, 0x0040, false},
+    {TEST_CSCPC, 0x0042, false},
+    {TEST_CSCPC, 0x0044, true},
+};
+
+#define TEST_SETUP_NB               (sizeof(test_setup) / sizeof(test_setup[0]))
+
+/// Connection state of the simulation
+static struct
+{
+    bool connected;
+    /// Request the GATT task is answering, NULL if none
+    struct gatt_read_char_req const *rd;
+    struct gatt_write_char_req const *wr;
+    ke_task_id_t rsp_dest;
+    /// ATT requests seen by the peer, Read Multiple among them, a second request in flight
+    uint32_t att_req;
+    uint32_t att_mult;
+    uint32_t overlap;
+    /// Operations of each client answered, in the setup order
+    uint8_t done[TEST_CLIENT_NB];
+    uint8_t done_nb;
+    /// Time the last answer reached its client (unit: 10ms)
+    uint32_t ready;
+} test_link;
+
+/*
+ * GLOBAL VARIABLE DEFINITIONS
+ ****************************************************************************************
+ */
+
+struct app_env_tag app_env;
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+#define TEST_CHECK(cond, ...)                                                       \
+    do {                                                                            \
+        if (!(cond))                                                                \
+        {                                                                           \
+            if (test_fail < 20)                                                     \
+            {                                                                       \
+                printf("%s:%d: %s: ", __FILE__, __LINE__, #cond);                   \
+                printf(__VA_ARGS__);                                                \
+                printf("\n");                                                       \
+            }                                                                       \
+            test_fail++;                                                            \
+        }                                                                           \
+    } while (0)
+
+void app_task_msg_hdl(ke_msg_id_t const msgid, void const *param)
+{
+}
+
+uint8_t test_get_rec_idx(uint16_t conhdl)
+{
+    return (test_link.connected && (conhdl == TEST_CONHDL)) ? 0 : GAP_INVALID_CONIDX;
+}
+
+uint16_t test_get_mtu(uint8_t idx)
+{
+    return ATT_DEFAULT_MTU;
+}
+
+static struct test_att *test_att_find(uint16_t handle)
+{
+    for (uint8_t i = 0; i < sizeof(test_att) / sizeof(test_att[0]); i++)
+    {
+        if (test_att[i].handle == handle)
+        {
+            return &test_att[i];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Next operation of a client in the setup order, NULL when it is done.
+ ****************************************************************************************
+ */
+static struct test_op const *test_client_op(uint8_t client)
+{
+    uint8_t n = 0;
+
+    for (uint8_t i = 0; i < TEST_SETUP_NB; i++)
+    {
+        if ((test_setup[i].client == client) && (n++ == test_link.done[client]))
+        {
+            return &test_setup[i];
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * PEER AND GATT, one ATT request at a time
+ ****************************************************************************************
+ */
+
+static int test_gatt_read_req(ke_msg_id_t const msgid, struct gatt_read_char_req const *param,
+                              ke_task_id_t const dest_id, ke_task_id_t const src_id)
+{
+    if ((test_link.rd != NULL) || (test_link.wr != NULL))
+    {
+        test_link.overlap++;
+        return (KE_MSG_CONSUMED);
+    }
+
+    test_link.rd = param;
+    test_link.rsp_dest = src_id;
+    test_link.att_req++;
+    if (param->req_type == GATT_READ_MULT_LONG_CHAR)
+    {
+        test_link.att_mult++;
+    }
+    ke_timer_set(TEST_GATT_RSP_TIMER, TASK_GATT, TEST_ATT_RTT);
+
+    return (KE_MSG_NO_FREE);
+}
+
+static int test_gatt_write_req(ke_msg_id_t const msgid, struct gatt_write_char_req const *param,
+                               ke_task_id_t const dest_id, ke_task_id_t const src_id)
+{
+    if ((test_link.rd != NULL) || (test_link.wr != NULL))
+    {
+        test_link.overlap++;
+        return (KE_MSG_CONSUMED);
+    }
+
+    test_link.wr = param;
+    test_link.rsp_dest = src_id;
+    test_link.att_req++;
+    ke_timer_set(TEST_GATT_RSP_TIMER, TASK_GATT, TEST_ATT_RTT);
+
+    return (KE_MSG_NO_FREE);
+}
+
+/// Read Multiple response: the values back to back, cut at the MTU, split on the lengths
+static void test_gatt_read_mult_rsp(struct gatt_read_char_req const *rd)
+{
+    struct gatt_read_char_mult_resp *rsp = KE_MSG_ALLOC(GATT_READ_CHAR_MULT_RESP, test_link.rsp_dest,
+                                                        TASK_GATT, gatt_read_char_mult_resp);
+    uint8_t pdu[ATT_DEFAULT_MTU];
+    uint8_t size = 0, pos = 0;
+
+    for (uint8_t i = 0; i < rd->nb_uuid; i++)
+    {
+        struct test_att const *att = test_att_find(co_read16p(&rd->uuid[i].value[0]));
+
+        for (uint8_t j = 0; (att != NULL) && (j < att->len) && (size < ATT_DEFAULT_MTU - 1); j++)
+        {
+            pdu[size++] = att->value[j];
+        }
+    }
+
+    rsp->status = ATT_ERR_NO_ERROR;
+    rsp->val_len = size;
+    for (uint8_t i = 0; i < rd->nb_uuid; i++)
+    {
+        uint8_t len = rd->uuid[i].expect_resp_size;
+
+        if ((i == rd->nb_uuid - 1) || (len > size - pos))
+        {
+            len = size - pos;
+        }
+        rsp->data[i].len = len;
+        memcpy(&rsp->data[i].value[0], &pdu[pos], len);
+        pos += len;
+    }
+
+    ke_msg_send(rsp);
+}
+
+static int test_gatt_rsp_timer(ke_msg_id_t const msgid, void const *param,
+                               ke_task_id_t const dest_id, ke_task_id_t const src_id)
+{
+    struct gatt_cmp_evt *cmp;
+
+    if (test_link.rd != NULL)
+    {
+        struct gatt_read_char_req const *rd = test_link.rd;
+
+        if (rd->req_type == GATT_READ_MULT_LONG_CHAR)
+        {
+            test_gatt_read_mult_rsp(rd);
+        }
+        else
+        {
+            struct test_att const *att = test_att_find(co_read16p(&rd->uuid[0].value[0]));
+            uint8_t len = (att != NULL) ? att->len : 0;
+            struct gatt_read_char_resp *rsp = KE_MSG_ALLOC_DYN(GATT_READ_CHAR_RESP, test_link.rsp_dest,
+                                                               TASK_GATT, gatt_read_char_resp, len);
+
+            rsp->status = (att != NULL) ? ATT_ERR_NO_ERROR : ATT_ERR_INVALID_HANDLE;
+            rsp->data.len = len;
+            rsp->data.each_len = len;
+            memcpy(&rsp->data.data[0], &att->value[0], len);
+            ke_msg_send(rsp);
+        }
+        ke_msg_free(ke_param2msg(rd));
+        test_link.rd = NULL;
+    }
+    else if (test_link.wr != NULL)
+    {
+        struct gatt_write_char_req const *wr = test_link.wr;
+        struct test_att *att = test_att_find(wr->charhdl);
+        struct gatt_write_char_resp *rsp = KE_MSG_ALLOC(GATT_WRITE_CHAR_RESP, test_link.rsp_dest,
+                                                        TASK_GATT, gatt_write_char_resp);
+
+        rsp->status = ATT_ERR_INVALID_HANDLE;
+        if ((att != NULL) && (wr->val_len == att->len))
+        {
+            memcpy(&att->value[0], &wr->value[0], wr->val_len);
+            rsp->status = ATT_ERR_NO_ERROR;
+        }
+        ke_msg_send(rsp);
+        ke_msg_free(ke_param2msg(wr));
+        test_link.wr = NULL;
+    }
+    else
+    {
+        return (KE_MSG_CONSUMED);
+    }
+
+    // The GATT ends each request with its complete event
+    cmp = KE_MSG_ALLOC(GATT_CMP_EVT, test_link.rsp_dest, TASK_GATT, gatt_cmp_evt);
+    cmp->status = ATT_ERR_NO_ERROR;
+    ke_msg_send(cmp);
+
+    return (KE_MSG_CONSUMED);
+}
+
+static const struct ke_msg_handler test_gatt_default_state[] =
+{
+    {GATT_READ_CHAR_REQ,        (ke_msg_func_t)test_gatt_read_req},
+    {GATT_WRITE_CHAR_REQ,       (ke_msg_func_t)test_gatt_write_req},
+    {TEST_GATT_RSP_TIMER,       (ke_msg_func_t)test_gatt_rsp_timer},
+};
+
+static const struct ke_state_handler test_gatt_default = KE_STATE_HANDLER(test_gatt_default_state);
+
+/*
+ * APPLICATION, its GATT handlers hand the responses over to the queue as app_gatt_task.c
+ ****************************************************************************************
+ */
+
+static int test_app_gatt_rsp(ke_msg_id_t const msgid, void const *param,
+                             ke_task_id_t const dest_id, ke_task_id_t const src_id)
+{
+    TEST_CHECK(prf_gattq_rsp(msgid, param, dest_id), "response %04x to the application", msgid);
+
+    return (KE_MSG_CONSUMED);
+}
+
+static const struct ke_msg_handler test_app_default_state[] =
+{
+    {GATT_READ_CHAR_RESP,       (ke_msg_func_t)test_app_gatt_rsp},
+    {GATT_READ_CHAR_MULT_RESP,  (ke_msg_func_t)test_app_gatt_rsp},
+    {GATT_WRITE_CHAR_RESP,      (ke_msg_func_t)test_app_gatt_rsp},
+    {GATT_CMP_EVT,              (ke_msg_func_t)test_app_gatt_rsp},
+};
+
+static const struct ke_state_handler test_app_default = KE_STATE_HANDLER(test_app_default_state);
+
+/*
+ * PROFILE CLIENTS
+ ****************************************************************************************
+ */
+
+/// A response reached a client, it must answer its next operation
+static void test_client_rsp(ke_task_id_t const dest_id, bool write, uint8_t status,
+                            uint8_t const *value, uint16_t len)
+{
+    uint8_t client = KE_TYPE_GET(dest_id) - TASK_PRF1;
+    struct test_op const *op = test_client_op(client);
+    struct test_att const *att;
+
+    TEST_CHECK(test_link.connected, "client %u: response after the disconnection", client);
+    TEST_CHECK(op != NULL, "client %u: response of nothing", client);
+    if (op == NULL)
+    {
+        return;
+    }
+
+    att = test_att_find(op->handle);
+    TEST_CHECK(op->write == write, "client %u handle %04x: %s response", client, op->handle,
+               write ? "write" : "read");
+    TEST_CHECK(status == ATT_ERR_NO_ERROR, "client %u handle %04x: status %02x", client, op->handle, status);
+    if (!write)
+    {
+        TEST_CHECK((len == att->len) && (memcmp(value, &att->value[0], len) == 0),
+                   "client %u handle %04x: value of %u bytes", client, op->handle, len);
+    }
+
+    test_link.done[client]++;
+    test_link.done_nb++;
+    test_link.ready = ke_host_time();
+}
+
+static int test_client_read_rsp(ke_msg_id_t const msgid, struct gatt_read_char_resp const *param,
+                                ke_task_id_t const dest_id, ke_task_id_t const src_id)
+{
+    test_client_rsp(dest_id, false, param->status, &param->data.data[0], param->data.len);
+
+    return (KE_MSG_CONSUMED);
+}
+
+static int test_client_write_rsp(ke_msg_id_t const msgid, struct gatt_write_char_resp const *param,
+                                 ke_task_id_t const dest_id, ke_task_id_t const src_id)
+{
+    test_client_rsp(dest_id, true, param->status, NULL, 0);
+
+    return (KE_MSG_CONSUMED);
+}
+
+static const struct ke_msg_handler test_client_default_state[] =
+{
+    {GATT_READ_CHAR_RESP,       (ke_msg_func_t)test_client_read_rsp},
+    {GATT_WRITE_CHAR_RESP,      (ke_msg_func_t)test_client_write_rsp},
+};
+
+static const struct ke_state_handler test_client_default = KE_STATE_HANDLER(test_client_default_state);
+
+/*
+ * SIMULATION
+ ****************************************************************************************
+ */
+
+static void test_init(void)
+{
+    struct ke_task_desc app_desc = {NULL, &test_app_default, test_app_state, 1, 1 + BLE_CONNECTION_MAX};
+    struct ke_task_desc gatt_desc = {NULL, &test_gatt_default, test_gatt_state, 1, 1};
+
+    ke_host_init();
+    task_desc_register(TASK_APP, app_desc);
+    task_desc_register(TASK_GATT, gatt_desc);
+    for (uint8_t i = 0; i < TEST_CLIENT_NB; i++)
+    {
+        struct ke_task_desc client_desc = {NULL, &test_client_default, &test_client_state[i], 1, 1};
+
+        task_desc_register(TASK_PRF1 + i, client_desc);
+    }
+
+    memset(&prf_gattq_env, 0, sizeof(prf_gattq_env));
+    memset(&prf_gattq_stat, 0, sizeof(prf_gattq_stat));
+}
+
+/**
+ ****************************************************************************************
+ * @brief Connection: the clients enable one after the other once the discovery is over,
+ *        their requests wait in the queue.
+ ****************************************************************************************
+ */
+static void test_connect(bool len_known)
+{
+    memset(&test_link, 0, sizeof(test_link));
+    test_link.connected = true;
+
+    for (uint8_t i = 0; i < TEST_SETUP_NB; i++)
+    {
+        struct test_op const *op = &test_setup[i];
+        struct test_att *att = test_att_find(op->handle);
+        struct prf_con_info con_info;
+
+        con_info.conhdl = TEST_CONHDL;
+        con_info.prf_id = TASK_PRF1 + op->client;
+        con_info.appid  = TASK_APP;
+
+        if (op->write)
+        {
+            // The configuration of the peer is cleared until written
+            memset(&att->value[0], 0, att->len);
+            prf_gatt_write_ntf_ind(&con_info, op->handle, PRF_CLI_START_NTF);
+        }
+        else
+        {
+            prf_read_char_send(&con_info, 0x0001, 0xffff, op->handle,
+                               (len_known && att->fixed) ? att->len : 0);
+        }
+    }
+}
+
+/**
+ ****************************************************************************************
+ * @brief Setup with and without the lengths, every value answered, time to ready.
+ ****************************************************************************************
+ */
+static void test_setup_run(void)
+{
+    uint32_t att_req[2], ready[2];
+
+    printf("%-14s %8s %10s %10s\n", "lengths", "ATT reqs", "Read Mult", "ready ms");
+
+    for (uint8_t known = 0; known < 2; known++)
+    {
+        test_init();
+        test_connect(known);
+        ke_host_run(1000);
+
+        TEST_CHECK(test_link.done_nb == TEST_SETUP_NB, "lengths %u: %u of %u answered", known,
+                   test_link.done_nb, (unsigned)TEST_SETUP_NB);
+        TEST_CHECK(test_link.overlap == 0, "lengths %u: %u requests while one in flight", known,
+                   test_link.overlap);
+        TEST_CHECK(prf_gattq_env.cnt[0] == 0, "lengths %u: %u left in the queue", known, prf_gattq_env.cnt[0]);
+        TEST_CHECK(prf_gattq_stat.full == 0, "lengths %u: queue full", known);
+        for (uint8_t i = 0; i < TEST_SETUP_NB; i++)
+        {
+            if (test_setup[i].write)
+            {
+                TEST_CHECK(co_read16p(&test_att_find(test_setup[i].handle)->value[0]) == PRF_CLI_START_NTF,
+                           "lengths %u: handle %04x not written", known, test_setup[i].handle);
+            }
+        }
+        TEST_CHECK(ke_host_msg_live() == 0, "lengths %u: %u messages left", known, ke_host_msg_live());
+        TEST_CHECK(ke_host_msg_lost() == 0, "lengths %u: %u messages lost", known, ke_host_msg_lost());
+
+        att_req[known] = test_link.att_req;
+        ready[known] = test_link.ready;
+        printf("%-14s %8u %10u %10u\n", known ? "known" : "all 0", test_link.att_req, test_link.att_mult,
+               test_link.ready * 10);
+    }
+
+    TEST_CHECK(att_req[1] < att_req[0], "Read Multiple saved no request: %u, %u", att_req[1], att_req[0]);
+    TEST_CHECK(ready[1] < ready[0], "ready at %u, %u without the lengths", ready[1] * 10, ready[0] * 10);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Disconnection during the setup: nothing more reaches the clients.
+ ****************************************************************************************
+ */
+static void test_disconnect(void)
+{
+    test_init();
+    test_connect(true);
+    ke_host_run(2 * TEST_ATT_RTT + 1);
+    TEST_CHECK((test_link.done_nb != 0) && (test_link.done_nb < TEST_SETUP_NB), "disconnect: %u answered",
+               test_link.done_nb);
+
+    test_link.connected = false;
+    prf_dispatch_disconnect(CO_ERROR_NO_ERROR, CO_ERROR_CON_TIMEOUT, TEST_CONHDL, 0);
+    TEST_CHECK(prf_gattq_env.cnt[0] == 0 && prf_gattq_env.busy == 0, "disconnect: queue not flushed");
+
+    // The response of the request in flight comes late, the queue drops it
+    ke_host_run(ke_host_time() + 2 * TEST_ATT_RTT);
+
+    test_connect(true);
+    ke_host_run(ke_host_time() + 1000);
+    TEST_CHECK(test_link.done_nb == TEST_SETUP_NB, "reconnect: %u of %u answered", test_link.done_nb,
+               (unsigned)TEST_SETUP_NB);
+    TEST_CHECK(test_link.overlap == 0, "reconnect: %u requests while one in flight", test_link.overlap);
+    TEST_CHECK(ke_host_msg_live() == 0, "reconnect: %u messages left", ke_host_msg_live());
+}
+
+int main(void)
+{
+    test_setup_run();
+    test_disconnect();
+
+    printf("gattq: %s (%u failures)\n", test_fail ? "FAIL" : "OK", test_fail);
+
+    return test_fail ? 1 : 0;
+}
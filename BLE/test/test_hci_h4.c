@@ -0,0 +1,294 @@
+/**
+ ****************************************************************************************
+ *
+ * @file test_hci_h4.c
+ *
+ * @brief Host test of the H4 framing of the controller mode (hci_h4_frame_feed).
+ *
+ * The framing is checked on garbage before and between packets, on headers split over
+ * several pieces and on ACL packets whose 16 bits length exceeds 255. A replay of a
+ * command/event/ACL stream in small pieces measures the framing throughput.
+ *
+ * Copyright(C) 2015 NXP Semiconductors N.V.
+ * All rights reserved.
+ *
+ * $Rev: $
+ *
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "hci_h4.h"
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// Packets recorded by a test
+#define TEST_PKT_MAX                64
+/// Largest packet built by a test, ACL header + 16 bits length
+#define TEST_PKT_LEN                (5 + 0x0400)
+/// Stream replayed by the benchmark
+#define TEST_BENCH_LEN              (1 << 20)
+#define TEST_BENCH_PIECE            7
+#define TEST_BENCH_ROUNDS           50
+
+/*
+ * LOCAL VARIABLE DEFINITIONS
+ ****************************************************************************************
+ */
+
+/// Packets delivered by the framing
+static uint8_t test_pkt[TEST_PKT_MAX][HCI_H4_FRAME_MAX];
+static uint16_t test_pkt_len[TEST_PKT_MAX];
+static uint32_t test_pkt_nb;
+
+static uint32_t test_fail;
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+#define TEST_CHECK(cond)                                                            \
+    do {                                                                            \
+        if (!(cond))                                                                \
+        {                                                                           \
+            printf("%s:%d: %s\n", __FILE__, __LINE__, #cond);                       \
+            test_fail++;                                                            \
+        }                                                                           \
+    } while (0)
+
+static void test_record(struct hci_h4_frame *frame)
+{
+    if (test_pkt_nb < TEST_PKT_MAX)
+    {
+        uint16_t len = (frame->len < frame->size) ? frame->len : frame->size;
+
+        memcpy(test_pkt[test_pkt_nb], frame->buf, len);
+        test_pkt_len[test_pkt_nb] = frame->len;
+    }
+    test_pkt_nb++;
+}
+
+static void test_frame_reset(struct hci_h4_frame *frame, uint8_t *buf)
+{
+    hci_h4_frame_init(frame, buf, HCI_H4_FRAME_MAX);
+    test_pkt_nb = 0;
+}
+
+/// Append an H4 packet with a parameter length of len, the parameters are a counter
+static uint32_t test_put(uint8_t *s, uint8_t type, uint16_t len)
+{
+    uint32_t n = 0;
+
+    s[n++] = type;
+    switch (type)
+    {
+    case HCI_H4_CMD:
+        s[n++] = 0x03;
+        s[n++] = 0x0C;
+        s[n++] = (uint8_t)len;
+        break;
+    case HCI_H4_ACL:
+        s[n++] = 0x01;
+        s[n++] = 0x20;
+        s[n++] = (uint8_t)len;
+        s[n++] = (uint8_t)(len >> 8);
+        break;
+    case HCI_H4_SCO:
+        s[n++] = 0x01;
+        s[n++] = 0x00;
+        s[n++] = (uint8_t)len;
+        break;
+    default:
+        s[n++] = 0x0E;
+        s[n++] = (uint8_t)len;
+        break;
+    }
+    for (uint16_t i = 0; i < len; i++)
+        s[n++] = (uint8_t)(i + 0x40);
+
+    return n;
+}
+
+/// Check a recorded packet against the bytes it was built from
+static void test_check_pkt(uint32_t idx, uint8_t const *s, uint32_t len)
+{
+    uint32_t cmp = (len < HCI_H4_FRAME_MAX) ? len : HCI_H4_FRAME_MAX;
+
+    TEST_CHECK(idx < test_pkt_nb);
+    if (idx < test_pkt_nb && idx < TEST_PKT_MAX)
+    {
+        TEST_CHECK(test_pkt_len[idx] == len);
+        TEST_CHECK(memcmp(test_pkt[idx], s, cmp) == 0);
+    }
+}
+
+/**
+ ****************************************************************************************
+ * @brief Bytes which are no packet type are dropped, the next packet is framed.
+ ****************************************************************************************
+ */
+static void test_resync(void)
+{
+    static uint8_t buf[HCI_H4_FRAME_MAX];
+    static const uint8_t garbage[] = {0x00, 0xFF, 0x05, 0x80, 0xEA, 0x00};
+    struct hci_h4_frame frame;
+    uint8_t s[512];
+    uint32_t n = 0, p1, p2, l1, l2;
+
+    memcpy(s, garbage, sizeof(garbage));
+    n += sizeof(garbage);
+    p1 = n;
+    l1 = test_put(s + n, HCI_H4_CMD, 4);
+    n += l1;
+    memcpy(s + n, garbage, sizeof(garbage));
+    n += sizeof(garbage);
+    p2 = n;
+    l2 = test_put(s + n, HCI_H4_EVT, 6);
+    n += l2;
+
+    test_frame_reset(&frame, buf);
+    hci_h4_frame_feed(&frame, s, n, test_record);
+
+    TEST_CHECK(frame.pkt == 2);
+    TEST_CHECK(frame.err == 2 * sizeof(garbage));
+    TEST_CHECK(frame.len == 0);
+    test_check_pkt(0, s + p1, l1);
+    test_check_pkt(1, s + p2, l2);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Every packet type split at every byte, headers included, frames the same.
+ ****************************************************************************************
+ */
+static void test_split(void)
+{
+    static uint8_t buf[HCI_H4_FRAME_MAX];
+    static const uint8_t types[] = {HCI_H4_CMD, HCI_H4_ACL, HCI_H4_SCO, HCI_H4_EVT};
+    struct hci_h4_frame frame;
+    uint8_t s[1024];
+    uint32_t pos[8], len[8];
+    uint32_t n = 0;
+
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        pos[i] = n;
+        len[i] = test_put(s + n, types[i % 4], (i < 4) ? 0 : 3 + i);
+        n += len[i];
+    }
+
+    // Two pieces, cut anywhere
+    for (uint32_t cut = 0; cut <= n; cut++)
+    {
+        test_frame_reset(&frame, buf);
+        hci_h4_frame_feed(&frame, s, cut, test_record);
+        hci_h4_frame_feed(&frame, s + cut, n - cut, test_record);
+
+        TEST_CHECK(frame.pkt == 8 && frame.err == 0);
+        for (uint8_t i = 0; i < 8; i++)
+            test_check_pkt(i, s + pos[i], len[i]);
+    }
+
+    // One byte at a time
+    test_frame_reset(&frame, buf);
+    for (uint32_t i = 0; i < n; i++)
+        hci_h4_frame_feed(&frame, s + i, 1, test_record);
+
+    TEST_CHECK(frame.pkt == 8 && frame.err == 0);
+    for (uint8_t i = 0; i < 8; i++)
+        test_check_pkt(i, s + pos[i], len[i]);
+}
+
+/**
+ ****************************************************************************************
+ * @brief ACL lengths use both bytes: a length with a high byte is not read as its low
+ * byte, a packet longer than the storage is counted in full and truncated.
+ ****************************************************************************************
+ */
+static void test_acl_len(void)
+{
+    static uint8_t buf[HCI_H4_FRAME_MAX];
+    static const uint16_t lens[] = {0x0000, 0x00FB, 0x0100, 0x0104, 0x01FF, 0x0400};
+    struct hci_h4_frame frame;
+    static uint8_t s[2 * TEST_PKT_LEN + 16];
+
+    for (uint8_t i = 0; i < sizeof(lens) / sizeof(lens[0]); i++)
+    {
+        uint32_t l1, l2;
+
+        // The event following the ACL packet is only framed if the ACL length is right
+        l1 = test_put(s, HCI_H4_ACL, lens[i]);
+        l2 = test_put(s + l1, HCI_H4_EVT, 2);
+
+        for (uint32_t cut = 1; cut <= 6; cut++)
+        {
+            test_frame_reset(&frame, buf);
+            hci_h4_frame_feed(&frame, s, cut, test_record);
+            hci_h4_frame_feed(&frame, s + cut, l1 + l2 - cut, test_record);
+
+            TEST_CHECK(frame.pkt == 2 && frame.err == 0);
+            test_check_pkt(0, s, l1);
+            test_check_pkt(1, s + l1, l2);
+        }
+    }
+}
+
+/**
+ ****************************************************************************************
+ * @brief Replay a command/event/ACL stream in small pieces.
+ ****************************************************************************************
+ */
+static void test_bench(void)
+{
+    static uint8_t s[TEST_BENCH_LEN];
+    static uint8_t buf[HCI_H4_FRAME_MAX];
+    struct hci_h4_frame frame;
+    struct timespec t0, t1;
+    uint32_t n = 0, np = 0;
+    double t;
+
+    while (n < sizeof(s) - TEST_PKT_LEN)
+    {
+        static const uint8_t types[] = {HCI_H4_CMD, HCI_H4_EVT, HCI_H4_ACL};
+        static const uint16_t lens[] = {8, 4, 27};
+
+        n += test_put(s + n, types[np % 3], lens[np % 3]);
+        np++;
+    }
+
+    hci_h4_frame_init(&frame, buf, sizeof(buf));
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (uint32_t r = 0; r < TEST_BENCH_ROUNDS; r++)
+    {
+        for (uint32_t i = 0; i < n; i += TEST_BENCH_PIECE)
+            hci_h4_frame_feed(&frame, s + i, (n - i < TEST_BENCH_PIECE) ? n - i : TEST_BENCH_PIECE, NULL);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    t = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+
+    TEST_CHECK(frame.pkt == np * TEST_BENCH_ROUNDS && frame.err == 0);
+    printf("hci_h4 replay: %u packets, %.1f Mpkt/s, %.1f MB/s\n", frame.pkt,
+           frame.pkt / t / 1e6, (double)n * TEST_BENCH_ROUNDS / t / 1e6);
+}
+
+int main(void)
+{
+    test_resync();
+    test_split();
+    test_acl_len();
+    test_bench();
+
+    printf("hci_h4: %s (%u failures)\n", test_fail ? "FAIL" : "OK", test_fail);
+
+    return test_fail != 0;
+}
@@ -0,0 +1,369 @@
+/**
+ ****************************************************************************************
+ *
+ * @file test_heap.c
+ *
+ * @brief Host stress test of the BLE heap statistics of app_sys.c.
+ *
+ * The ROM allocator is modelled on a heap of the test: ke_malloc() takes a block from
+ * the end of the first free block large enough and keeps the free block header, ke_free()
+ * links the block back in address order and merges it with its neighbours. 20000 random
+ * allocations and frees of message sized blocks are run, the statistics walked from the
+ * kernel environment must match a probe of the model at every step and must not write
+ * to the heap.
+ *
+ * Copyright(C) 2015 NXP Semiconductors N.V.
+ * All rights reserved.
+ *
+ * $Rev: $
+ *
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "app_env.h"
+#include "lib.h"
+#include "ke_mem.h"
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// Heap size of the test
+#define TEST_HEAP_SIZE              3072
+/// Random operations of the stress test
+#define TEST_OP_NB                  20000
+/// Blocks allocated at once at most
+#define TEST_LIVE_MAX               64
+
+/*
+ * ROM MODEL, the statistics read the kernel environment of the test
+ ****************************************************************************************
+ */
+
+static struct ke_env_tag test_ke_env;
+
+#undef _ke_env
+#define _ke_env                     (&test_ke_env)
+
+#include "../src/app/app_sys.c"
+
+/*
+ * LOCAL VARIABLE DEFINITIONS
+ ****************************************************************************************
+ */
+
+static uint32_t test_fail;
+
+/// Heap of the model, aligned as the BLE heap of the chip
+static uint32_t test_heap[TEST_HEAP_SIZE / sizeof(uint32_t)];
+
+/// Blocks allocated by the stress test
+static struct
+{
+    void *ptr;
+    uint16_t size;
+} test_live[TEST_LIVE_MAX];
+static uint8_t test_live_nb;
+
+/*
+ * GLOBAL VARIABLE DEFINITIONS
+ ****************************************************************************************
+ */
+
+struct app_env_tag app_env;
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+#define TEST_CHECK(cond, ...)                                                       \
+    do {                                                                            \
+        if (!(cond))                                                                \
+        {                                                                           \
+            if (test_fail < 20)                                                     \
+            {                                                                       \
+                printf("%s:%d: %s: ", __FILE__, __LINE__, #cond);                   \
+                printf(__VA_ARGS__);                                                \
+                printf("\n");                                                       \
+            }                                                                       \
+            test_fail++;                                                            \
+        }                                                                           \
+    } while (0)
+
+static uint32_t test_rand(void)
+{
+    static uint32_t x = 2463534242UL;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+
+    return x;
+}
+
+void app_task_msg_hdl(ke_msg_id_t const msgid, void const *param)
+{
+}
+
+/**
+ ****************************************************************************************
+ * @brief Model of the ROM ke_malloc().
+ ****************************************************************************************
+ */
+static void *test_malloc(uint32_t size)
+{
+    uint32_t total = ((size + 3) & ~3UL) + APP_HEAP_USED_HDR;
+    struct mblock_free *node;
+    uint8_t *used;
+
+    for (node = test_ke_env.mblock_first; node != NULL; node = node->next)
+    {
+        // The free block keeps its header
+        if (node->size >= total + APP_HEAP_FREE_HDR)
+        {
+            node->size -= total;
+            used = (uint8_t *)node + node->size;
+            *(uint32_t *)used = total;
+            return used + APP_HEAP_USED_HDR;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Model of the ROM ke_free().
+ ****************************************************************************************
+ */
+static void test_free(void *ptr)
+{
+    uint8_t *blk = (uint8_t *)ptr - APP_HEAP_USED_HDR;
+    uint32_t size = *(uint32_t *)blk;
+    struct mblock_free *prev = NULL;
+    struct mblock_free *next = test_ke_env.mblock_first;
+    struct mblock_free *node;
+
+    while ((next != NULL) && ((uint8_t *)next < blk))
+    {
+        prev = next;
+        next = next->next;
+    }
+
+    if ((prev != NULL) && ((uint8_t *)prev + prev->size == blk))
+    {
+        prev->size += size;
+        node = prev;
+    }
+    else
+    {
+        node = (struct mblock_free *)blk;
+        node->size = size;
+        node->next = next;
+        if (prev != NULL)
+            prev->next = node;
+        else
+            test_ke_env.mblock_first = node;
+    }
+
+    if ((next != NULL) && ((uint8_t *)node + node->size == (uint8_t *)next))
+    {
+        node->size += next->size;
+        node->next = next->next;
+    }
+}
+
+/**
+ ****************************************************************************************
+ * @brief Boot: pattern fill by app_heap_stat_init(), then the heap given to the ROM.
+ ****************************************************************************************
+ */
+static void test_heap_init(void)
+{
+    struct mblock_free *node = (struct mblock_free *)test_heap;
+
+    app_heap_stat_init((uint8_t *)test_heap, TEST_HEAP_SIZE);
+
+    memset(&test_ke_env, 0, sizeof(test_ke_env));
+    node->next = NULL;
+    node->size = TEST_HEAP_SIZE;
+    test_ke_env.mblock_first = node;
+
+    test_live_nb = 0;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Whether the model can allocate size bytes now, the heap left as it was.
+ ****************************************************************************************
+ */
+static bool test_probe(uint32_t size)
+{
+    static uint32_t heap[TEST_HEAP_SIZE / sizeof(uint32_t)];
+    struct ke_env_tag env = test_ke_env;
+    void *ptr;
+
+    memcpy(heap, test_heap, TEST_HEAP_SIZE);
+    ptr = test_malloc(size);
+    memcpy(test_heap, heap, TEST_HEAP_SIZE);
+    test_ke_env = env;
+
+    return ptr != NULL;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Statistics of the current heap, checked against the model.
+ ****************************************************************************************
+ */
+static void test_stat_check(struct app_heap_stat *stat, uint32_t op)
+{
+    static uint8_t heap[TEST_HEAP_SIZE];
+    struct app_heap_stat again;
+    uint32_t live = 0;
+
+    memcpy(heap, test_heap, TEST_HEAP_SIZE);
+    app_heap_stat_get(stat);
+    TEST_CHECK(memcmp(heap, test_heap, TEST_HEAP_SIZE) == 0, "op %u: heap written", op);
+
+    app_heap_stat_get(&again);
+    TEST_CHECK(memcmp(stat, &again, sizeof(again)) == 0, "op %u: statistics moved", op);
+
+    TEST_CHECK(stat->size == TEST_HEAP_SIZE, "op %u: size %u", op, stat->size);
+    TEST_CHECK(stat->largest <= stat->free, "op %u: largest %u free %u", op, stat->largest, stat->free);
+    TEST_CHECK(stat->frag <= 100, "op %u: frag %u", op, stat->frag);
+    if (stat->largest)
+        TEST_CHECK(test_probe(stat->largest), "op %u: largest %u fails", op, stat->largest);
+    TEST_CHECK(!test_probe(stat->largest + 4), "op %u: %u more than largest %u allocated", op,
+               stat->largest + 4, stat->largest);
+
+    for (uint8_t i = 0; i < test_live_nb; i++)
+    {
+        live += test_live[i].size;
+    }
+    TEST_CHECK(stat->peak >= live, "op %u: peak %u under live %u", op, stat->peak, live);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Random allocations and frees of message sized blocks.
+ ****************************************************************************************
+ */
+static void test_stress(void)
+{
+    struct app_heap_stat stat;
+    uint32_t fail_nb = 0;
+    uint16_t largest_min = TEST_HEAP_SIZE;
+    uint8_t frag_max = 0;
+    uint16_t peak = 0;
+
+    test_heap_init();
+
+    for (uint32_t op = 0; op < TEST_OP_NB; op++)
+    {
+        uint32_t r = test_rand();
+
+        if ((test_live_nb < TEST_LIVE_MAX) && ((r & 0xFF) < 140))
+        {
+            // Mostly notifications and small commands, some long reports
+            uint16_t size = ((r >> 8) % 10 < 7) ? 8 + (r >> 12) % 32
+                          : ((r >> 8) % 10 < 9) ? 40 + (r >> 12) % 80 : 120 + (r >> 12) % 180;
+            void *ptr = test_malloc(size);
+
+            if (ptr == NULL)
+            {
+                fail_nb++;
+            }
+            else
+            {
+                // A message never holds the pattern in this test, a real one may
+                memset(ptr, ((uint8_t)op == APP_HEAP_PATTERN) ? 0 : (uint8_t)op, size);
+                test_live[test_live_nb].ptr = ptr;
+                test_live[test_live_nb].size = size;
+                test_live_nb++;
+            }
+        }
+        else if (test_live_nb)
+        {
+            uint8_t i = (r >> 8) % test_live_nb;
+
+            test_free(test_live[i].ptr);
+            test_live[i] = test_live[--test_live_nb];
+        }
+
+        test_stat_check(&stat, op);
+        TEST_CHECK(stat.peak >= peak, "op %u: peak %u went down from %u", op, stat.peak, peak);
+        peak = stat.peak;
+        if (stat.largest < largest_min)
+            largest_min = stat.largest;
+        if (stat.frag > frag_max)
+            frag_max = stat.frag;
+    }
+
+    while (test_live_nb)
+    {
+        test_free(test_live[--test_live_nb].ptr);
+    }
+    test_stat_check(&stat, TEST_OP_NB);
+    TEST_CHECK((stat.frag == 0) && (stat.largest == stat.free), "empty: frag %u largest %u free %u",
+               stat.frag, stat.largest, stat.free);
+
+    printf("%6s %8s %8s %10s %8s %8s\n", "ops", "failed", "peak", "min large", "max frag", "free");
+    printf("%6u %8u %8u %10u %7u%% %8u\n", TEST_OP_NB, fail_nb, peak, largest_min, frag_max, stat.free);
+}
+
+/**
+ ****************************************************************************************
+ * @brief A broken free list stops the walk instead of running off the heap.
+ ****************************************************************************************
+ */
+static void test_broken_list(void)
+{
+    struct app_heap_stat stat;
+    struct mblock_free *first;
+    void *ptr[3];
+
+    test_heap_init();
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        ptr[i] = test_malloc(32);
+    }
+    test_free(ptr[1]);
+    first = test_ke_env.mblock_first;
+
+    // Loop back to the first block
+    first->next->next = first;
+    app_heap_stat_get(&stat);
+    TEST_CHECK(stat.free < TEST_HEAP_SIZE, "loop: free %u", stat.free);
+
+    // Out of the heap
+    first->next->next = (struct mblock_free *)((uint8_t *)test_heap + TEST_HEAP_SIZE);
+    app_heap_stat_get(&stat);
+    TEST_CHECK(stat.free < TEST_HEAP_SIZE, "outside: free %u", stat.free);
+
+    // Size over the heap end
+    first->next->next = NULL;
+    first->next->size = TEST_HEAP_SIZE;
+    app_heap_stat_get(&stat);
+    TEST_CHECK(stat.free == ((first->size - APP_HEAP_FREE_HDR - APP_HEAP_USED_HDR) & ~3UL),
+               "size: free %u", stat.free);
+}
+
+int main(void)
+{
+    test_stress();
+    test_broken_list();
+
+    printf("heap: %s (%u failures)\n", test_fail ? "FAIL" : "OK", test_fail);
+
+    return test_fail ? 1 : 0;
+}
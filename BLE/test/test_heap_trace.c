@@ -0,0 +1,336 @@
+/**
+ ****************************************************************************************
+ *
+ * @file test_heap_trace.c
+ *
+ * @brief Host test of the BLE heap trace of app_sys.c and of its offline analyzer.
+ *
+ * 20000 random allocations, frees and sends of messages and blocks go through the
+ * tracing wrappers on the kernel of host/ke_host.c, with three leaks planted. The log
+ * the wrappers print is read back by heap_replay.c: its counts must match the trace kept
+ * on the device, the leaks must be the planted blocks, and the log must replay without
+ * a failure on the heap size it advises and fail on a smaller one.
+ *
+ * Copyright(C) 2015 NXP Semiconductors N.V.
+ * All rights reserved.
+ *
+ * $Rev: $
+ *
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "app_env.h"
+#include "lib.h"
+#include "heap_replay.h"
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// Random operations of the test
+#define TEST_OP_NB                  20000
+/// Bytes ke_malloc() gives at most, further requests fail
+#define TEST_MALLOC_BUDGET          600
+/// Blocks held by the application at once at most, the trace follows APP_HEAP_BLK_NB
+#define TEST_HELD_MAX               10
+/// Planted leaks
+#define TEST_LEAK_NB                3
+
+/// Messages of the test
+enum
+{
+    TEST_MSG_NTF = 0x0c00,
+    TEST_MSG_IND,
+    TEST_MSG_CMD = 0x0d05,
+    TEST_MSG_REPORT = 0x1402,
+    TEST_MSG_DATA = 0x2001,
+};
+
+/*
+ * HEAP TRACE, its log is written to a memory stream of the test
+ ****************************************************************************************
+ */
+
+void *test_malloc(uint32_t size);
+void test_free(void *mem_ptr);
+
+#undef _ke_malloc
+#define _ke_malloc                  test_malloc
+#undef _ke_free
+#define _ke_free                    test_free
+
+static FILE *test_log;
+
+#undef QPRINTF
+#define QPRINTF(...)                fprintf(test_log, __VA_ARGS__)
+
+#include "../src/app/app_sys.c"
+
+/*
+ * LOCAL VARIABLE DEFINITIONS
+ ****************************************************************************************
+ */
+
+static uint32_t test_fail;
+
+static ke_state_t test_app_state[1];
+
+/// Bytes given by test_malloc()
+static uint32_t test_malloc_used;
+
+/// Blocks held by the application, a message (id != APP_HEAP_ID_MALLOC) or a ke_malloc() block
+static struct
+{
+    void *ptr;
+    uint16_t id;
+} test_held[TEST_HELD_MAX];
+static uint8_t test_held_nb;
+
+/// Planted leaks
+static void *test_leak[TEST_LEAK_NB];
+
+/*
+ * GLOBAL VARIABLE DEFINITIONS
+ ****************************************************************************************
+ */
+
+struct app_env_tag app_env;
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+#define TEST_CHECK(cond, ...)                                                       \
+    do {                                                                            \
+        if (!(cond))                                                                \
+        {                                                                           \
+            if (test_fail < 20)                                                     \
+            {                                                                       \
+                printf("%s:%d: %s: ", __FILE__, __LINE__, #cond);                   \
+                printf(__VA_ARGS__);                                                \
+                printf("\n");                                                       \
+            }                                                                       \
+            test_fail++;                                                            \
+        }                                                                           \
+    } while (0)
+
+static uint32_t test_rand(void)
+{
+    static uint32_t x = 2463534242UL;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+
+    return x;
+}
+
+void app_task_msg_hdl(ke_msg_id_t const msgid, void const *param)
+{
+}
+
+/// ke_malloc() of a small heap, the size is kept in front of the block
+void *test_malloc(uint32_t size)
+{
+    uint32_t *blk;
+
+    if (test_malloc_used + size > TEST_MALLOC_BUDGET)
+        return NULL;
+
+    blk = malloc(sizeof(uint64_t) + size);
+    blk[0] = size;
+    test_malloc_used += size;
+
+    return (uint8_t *)blk + sizeof(uint64_t);
+}
+
+void test_free(void *mem_ptr)
+{
+    uint32_t *blk = (uint32_t *)((uint8_t *)mem_ptr - sizeof(uint64_t));
+
+    test_malloc_used -= blk[0];
+    free(blk);
+}
+
+/// The application task consumes the messages sent to it
+static int test_app_msg(ke_msg_id_t const msgid, void const *param,
+                        ke_task_id_t const dest_id, ke_task_id_t const src_id)
+{
+    return (KE_MSG_CONSUMED);
+}
+
+static const struct ke_msg_handler test_app_default_state[] =
+{
+    {TEST_MSG_NTF,              (ke_msg_func_t)test_app_msg},
+    {TEST_MSG_IND,              (ke_msg_func_t)test_app_msg},
+    {TEST_MSG_CMD,              (ke_msg_func_t)test_app_msg},
+    {TEST_MSG_REPORT,           (ke_msg_func_t)test_app_msg},
+    {TEST_MSG_DATA,             (ke_msg_func_t)test_app_msg},
+};
+
+static const struct ke_state_handler test_app_default = KE_STATE_HANDLER(test_app_default_state);
+
+/// Profile client environment which is never freed
+static void __attribute__((noinline)) test_plant_leak(uint8_t n)
+{
+    test_leak[n] = ke_malloc(24 + 8 * n);
+}
+
+/// A scheduler run of the main loop
+static void test_schedule(void)
+{
+    ke_host_schedule();
+    app_heap_trace_sched();
+}
+
+/**
+ ****************************************************************************************
+ * @brief Random traffic through the wrappers, the leaks planted along the way.
+ ****************************************************************************************
+ */
+static void test_traffic(void)
+{
+    static const uint16_t ids[] = {TEST_MSG_NTF, TEST_MSG_IND, TEST_MSG_CMD, TEST_MSG_REPORT, TEST_MSG_DATA};
+
+    for (uint32_t op = 0; op < TEST_OP_NB; op++)
+    {
+        uint32_t r = test_rand();
+
+        if ((op % (TEST_OP_NB / TEST_LEAK_NB)) == TEST_OP_NB / (2 * TEST_LEAK_NB))
+            test_plant_leak(op / (TEST_OP_NB / TEST_LEAK_NB));
+
+        if ((test_held_nb < TEST_HELD_MAX) && ((r & 0xFF) < 130))
+        {
+            if ((r >> 8) % 4)
+            {
+                uint16_t id = ids[(r >> 10) % (sizeof(ids) / sizeof(ids[0]))];
+
+                test_held[test_held_nb].ptr = ke_msg_alloc(id, TASK_APP, TASK_APP, 4 + (r >> 16) % 60);
+                test_held[test_held_nb++].id = id;
+            }
+            else
+            {
+                void *ptr = ke_malloc(16 + (r >> 16) % 120);
+
+                if (ptr != NULL)
+                {
+                    test_held[test_held_nb].ptr = ptr;
+                    test_held[test_held_nb++].id = APP_HEAP_ID_MALLOC;
+                }
+            }
+        }
+        else if (test_held_nb)
+        {
+            uint8_t i = (r >> 8) % test_held_nb;
+
+            if (test_held[i].id == APP_HEAP_ID_MALLOC)
+                ke_free(test_held[i].ptr);
+            else if ((r >> 16) % 8)
+                ke_msg_send(test_held[i].ptr);
+            else
+                ke_msg_free(ke_param2msg(test_held[i].ptr));
+            test_held[i] = test_held[--test_held_nb];
+        }
+
+        if ((r >> 24) < 40)
+            test_schedule();
+    }
+
+    // Everything but the leaks goes back
+    while (test_held_nb)
+    {
+        test_held_nb--;
+        if (test_held[test_held_nb].id == APP_HEAP_ID_MALLOC)
+            ke_free(test_held[test_held_nb].ptr);
+        else
+            ke_msg_send(test_held[test_held_nb].ptr);
+    }
+    test_schedule();
+}
+
+/**
+ ****************************************************************************************
+ * @brief The analyzer reads back what the device counted.
+ ****************************************************************************************
+ */
+static void test_replay(FILE *log)
+{
+    struct app_heap_trace const *trace = app_heap_trace_get();
+    struct heap_replay rep;
+    struct heap_replay_run run;
+    struct heap_replay_evt const *leak[TEST_LEAK_NB + 4];
+    uint32_t min, leak_nb;
+
+    TEST_CHECK(heap_replay_read(log, &rep) > 0, "no event read");
+    TEST_CHECK(rep.alloc_nb == trace->alloc_cnt, "allocations %u, device %u", rep.alloc_nb, trace->alloc_cnt);
+    TEST_CHECK(rep.fail_nb == trace->fail_cnt, "failures %u, device %u", rep.fail_nb, trace->fail_cnt);
+    TEST_CHECK(rep.free_nb == trace->free_cnt, "frees %u, device %u", rep.free_nb, trace->free_cnt);
+    TEST_CHECK(rep.app_peak == trace->live_peak, "peak %u, device %u", rep.app_peak, trace->live_peak);
+    TEST_CHECK(rep.req_max == trace->req_max, "largest %u, device %u", rep.req_max, trace->req_max);
+    TEST_CHECK(rep.foreign_nb == 0, "foreign %u", rep.foreign_nb);
+    TEST_CHECK(trace->fail_cnt > 0, "the budget never ran out");
+
+    leak_nb = heap_replay_leaks(&rep, 0, leak, sizeof(leak) / sizeof(leak[0]));
+    TEST_CHECK(leak_nb == TEST_LEAK_NB, "%u leaks", leak_nb);
+    for (uint32_t i = 0; (i < leak_nb) && (i < TEST_LEAK_NB); i++)
+    {
+        TEST_CHECK(leak[i]->ptr == (unsigned long)test_leak[i], "leak %u: block %lx", i, leak[i]->ptr);
+        TEST_CHECK(leak[i]->size == 24 + 8 * i, "leak %u: size %u", i, leak[i]->size);
+        TEST_CHECK(leak[i]->caller == leak[0]->caller, "leak %u: caller %lx", i, leak[i]->caller);
+    }
+    // The last leak is only a few hundred runs old
+    TEST_CHECK(heap_replay_leaks(&rep, rep.tick_nb / 4, leak, sizeof(leak) / sizeof(leak[0])) == TEST_LEAK_NB - 1,
+               "old leaks");
+
+    min = heap_replay_min_size(&rep, 0);
+    TEST_CHECK(min != 0, "log does not fit");
+    heap_replay_run(&rep, min, 0, &run);
+    TEST_CHECK(run.fail_nb == 0, "%u failures at %u", run.fail_nb, min);
+    TEST_CHECK(run.used_peak <= min, "peak %u over %u", run.used_peak, min);
+    heap_replay_run(&rep, min - 4, 0, &run);
+    TEST_CHECK(run.fail_nb != 0, "fits in %u", min - 4);
+    TEST_CHECK(min >= trace->live_peak, "min %u under the application peak %u", min, trace->live_peak);
+
+    // The stack keeps 1000 bytes by itself
+    TEST_CHECK(heap_replay_min_size(&rep, 1000) >= min + 1000, "base not counted");
+
+    printf("%6s %8s %8s %8s %8s %10s %10s\n", "events", "allocs", "failed", "runs", "leaks", "app peak",
+           "min heap");
+    printf("%6u %8u %8u %8u %8u %10u %10u\n", rep.evt_nb, rep.alloc_nb, rep.fail_nb, rep.tick_nb, leak_nb,
+           rep.app_peak, min);
+
+    heap_replay_free(&rep);
+}
+
+int main(void)
+{
+    struct ke_task_desc app_desc = {NULL, &test_app_default, test_app_state, 1, 1};
+    char *buf = NULL;
+    size_t len = 0;
+    FILE *log;
+
+    ke_host_init();
+    task_desc_register(TASK_APP, app_desc);
+    test_log = open_memstream(&buf, &len);
+
+    test_traffic();
+    fclose(test_log);
+
+    log = fmemopen(buf, len, "r");
+    test_replay(log);
+    fclose(log);
+    free(buf);
+
+    printf("heap_trace: %s (%u failures)\n", test_fail ? "FAIL" : "OK", test_fail);
+
+    return test_fail ? 1 : 0;
+}
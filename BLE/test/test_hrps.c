@@ -0,0 +1,476 @@
+/**
+ ****************************************************************************************
+ *
+ * @file test_hrps.c
+ *
+ * @brief Host simulation of the RR-Interval accumulator of the Heart Rate sensor.
+ *
+ * The accumulator of app_hrps.c runs on the host kernel, beats are added at their
+ * simulated time like the sensor ISR does. The profile task is replaced by a task which
+ * packs each measurement with hrps_pack_meas_value() and confirms it one connection
+ * interval later. Every RR-Interval must be notified once and in order within the
+ * latency deadline, notifications must be full unless the deadline expired, and Energy
+ * Expended must come at its cadence. The packets per beat and the radio energy of the
+ * accumulator are compared with one notification per beat.
+ *
+ * Copyright(C) 2015 NXP Semiconductors N.V.
+ * All rights reserved.
+ *
+ * $Rev: $
+ *
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "app_env.h"
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// Beats of a run
+#define TEST_BEAT_MAX               4096
+/// Notifications of a run
+#define TEST_NTF_MAX                4096
+/// Connection interval, delay of the confirmation of a notification (unit: 10ms)
+#define TEST_CON_INTV               3
+/// Timer of the profile task sending the confirmation
+#define TEST_HRPS_CFM_TIMER         (HRPS_MEAS_SEND_CFM + 0x20)
+
+/// Radio energy model: power while the radio is on, fixed time of one notification
+/// (wake-up, ramp-up, acknowledgement) and time per byte at 1Mbps
+#define TEST_RADIO_MW               26.4
+#define TEST_PKT_FIXED_US           530
+#define TEST_BYTE_US                8
+/// Bytes of a notification around the value: preamble, access address, header, CRC,
+/// L2CAP and ATT headers
+#define TEST_PKT_OVERHEAD           17
+
+/// Notification seen on air
+struct test_ntf
+{
+    /// Time of the notification (unit: 10ms)
+    uint32_t time;
+    uint8_t flags;
+    uint16_t heart_rate;
+    uint8_t nb_rr;
+    uint16_t rr[HRS_MAX_RR_INTERVAL];
+    /// Length of the value
+    uint8_t len;
+};
+
+/// One run of the simulation
+struct test_run
+{
+    /// RR-Intervals added and the time they were added
+    uint16_t beat_rr[TEST_BEAT_MAX];
+    uint32_t beat_time[TEST_BEAT_MAX];
+    uint32_t beat_nb;
+    /// Notifications
+    struct test_ntf ntf[TEST_NTF_MAX];
+    uint32_t ntf_nb;
+    /// Confirmation delay of the simulated peer (unit: 10ms)
+    uint16_t cfm_delay;
+};
+
+/*
+ * LOCAL VARIABLE DEFINITIONS
+ ****************************************************************************************
+ */
+
+static uint32_t test_fail;
+static struct test_run test_run;
+
+static ke_state_t test_hrps_state[1];
+static ke_state_t test_app_state[1];
+
+/*
+ * GLOBAL VARIABLE DEFINITIONS
+ ****************************************************************************************
+ */
+
+struct app_env_tag app_env;
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+#define TEST_CHECK(cond, ...)                                                       \
+    do {                                                                            \
+        if (!(cond))                                                                \
+        {                                                                           \
+            if (test_fail < 20)                                                     \
+            {                                                                       \
+                printf("%s:%d: %s: ", __FILE__, __LINE__, #cond);                   \
+                printf(__VA_ARGS__);                                                \
+                printf("\n");                                                       \
+            }                                                                       \
+            test_fail++;                                                            \
+        }                                                                           \
+    } while (0)
+
+static uint32_t test_rand(void)
+{
+    static uint32_t x = 2463534242UL;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+
+    return x;
+}
+
+void app_task_msg_hdl(ke_msg_id_t const msgid, void const *param)
+{
+}
+
+/// Profile task: decode the packed value like a collector and confirm it later
+static int test_hrps_meas_send_req_handler(ke_msg_id_t const msgid,
+                                           struct hrps_meas_send_req const *param,
+                                           ke_task_id_t const dest_id,
+                                           ke_task_id_t const src_id)
+{
+    uint8_t packed[HRPS_HT_MEAS_MAX_LEN];
+    uint8_t len = hrps_pack_meas_value(packed, &param->meas_val);
+    struct test_ntf *ntf = &test_run.ntf[test_run.ntf_nb];
+    uint8_t cursor = 1;
+
+    TEST_CHECK(test_run.ntf_nb < TEST_NTF_MAX, "too many notifications");
+    if (test_run.ntf_nb >= TEST_NTF_MAX)
+    {
+        return (KE_MSG_CONSUMED);
+    }
+    test_run.ntf_nb++;
+
+    ntf->time = ke_host_time();
+    ntf->len = len;
+    ntf->flags = packed[0];
+    if (ntf->flags & HRS_FLAG_HR_16BITS_VALUE)
+    {
+        ntf->heart_rate = co_read16p(&packed[cursor]);
+        cursor += 2;
+    }
+    else
+    {
+        ntf->heart_rate = packed[cursor++];
+    }
+    if (ntf->flags & HRS_FLAG_ENERGY_EXPENDED_PRESENT)
+    {
+        cursor += 2;
+    }
+    ntf->nb_rr = 0;
+    while ((cursor + 2 <= len) && (ntf->nb_rr < HRS_MAX_RR_INTERVAL))
+    {
+        ntf->rr[ntf->nb_rr++] = co_read16p(&packed[cursor]);
+        cursor += 2;
+    }
+
+    ke_timer_set(TEST_HRPS_CFM_TIMER, TASK_HRPS, test_run.cfm_delay);
+
+    return (KE_MSG_CONSUMED);
+}
+
+static int test_hrps_cfm_timer_handler(ke_msg_id_t const msgid, void const *param,
+                                       ke_task_id_t const dest_id, ke_task_id_t const src_id)
+{
+    struct hrps_meas_send_cfm *cfm = KE_MSG_ALLOC(HRPS_MEAS_SEND_CFM, TASK_APP, TASK_HRPS,
+                                                  hrps_meas_send_cfm);
+
+    cfm->conhdl = 0;
+    cfm->status = PRF_ERR_OK;
+    ke_msg_send(cfm);
+
+    return (KE_MSG_CONSUMED);
+}
+
+static const struct ke_msg_handler test_hrps_handler[] =
+{
+    {HRPS_MEAS_SEND_REQ,            (ke_msg_func_t) test_hrps_meas_send_req_handler},
+    {TEST_HRPS_CFM_TIMER,           (ke_msg_func_t) test_hrps_cfm_timer_handler},
+};
+
+static const struct ke_msg_handler test_app_handler[] =
+{
+    {HRPS_MEAS_SEND_CFM,            (ke_msg_func_t) app_hrps_means_send_cfm_handler},
+    {APP_HRPS_RR_TIMER,             (ke_msg_func_t) app_hrps_rr_timer_handler},
+};
+
+static const struct ke_state_handler test_hrps_default = KE_STATE_HANDLER(test_hrps_handler);
+static const struct ke_state_handler test_app_default = KE_STATE_HANDLER(test_app_handler);
+
+/**
+ ****************************************************************************************
+ * @brief Start a connection with notifications enabled.
+ ****************************************************************************************
+ */
+static void test_start(uint8_t features, uint16_t cfm_delay)
+{
+    struct ke_task_desc hrps_desc = {NULL, &test_hrps_default, test_hrps_state, 1, 1};
+    struct ke_task_desc app_desc = {NULL, &test_app_default, test_app_state, 1, 1};
+
+    ke_host_init();
+    task_desc_register(TASK_HRPS, hrps_desc);
+    task_desc_register(TASK_APP, app_desc);
+
+    memset(&test_run, 0, sizeof(test_run));
+    test_run.cfm_delay = cfm_delay;
+
+    memset(app_hrps_env, 0, sizeof(*app_hrps_env));
+    app_hrps_rr_init();
+    app_hrps_env->enabled = true;
+    app_hrps_env->conhdl = 0;
+    app_hrps_env->features = features | HRPS_HR_MEAS_NTF_CFG;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Add beats around the mean RR-Interval with a relative jitter, until the end time.
+ ****************************************************************************************
+ */
+static void test_beats(uint16_t rr_mean, uint16_t jitter_pct, uint32_t end)
+{
+    // beat time in 1/1024s
+    uint64_t t = (uint64_t)ke_host_time() * 1024 / 100;
+
+    for (;;)
+    {
+        int32_t jitter = (jitter_pct != 0)
+                         ? (int32_t)(test_rand() % (2 * rr_mean * jitter_pct / 100 + 1)) - rr_mean * jitter_pct / 100
+                         : 0;
+        uint16_t rr = rr_mean + jitter;
+        uint32_t tick;
+
+        t += rr;
+        tick = (uint32_t)(t * 100 / 1024);
+        if ((tick > end) || (test_run.beat_nb >= TEST_BEAT_MAX))
+        {
+            break;
+        }
+
+        ke_host_run(tick);
+        test_run.beat_rr[test_run.beat_nb] = rr;
+        test_run.beat_time[test_run.beat_nb] = tick;
+        test_run.beat_nb++;
+        app_hrps_rr_interval_add(rr);
+        ke_host_schedule();
+    }
+
+    // Let the deadline flush the last ones
+    ke_host_run(end + APP_HRPS_RR_LATENCY_TO + 4 * test_run.cfm_delay);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Number of RR-Intervals one notification holds with the given flags.
+ ****************************************************************************************
+ */
+static uint8_t test_capacity(uint8_t flags)
+{
+    uint8_t len = ATT_DEFAULT_MTU - 3 - 2;
+
+    len -= (flags & HRS_FLAG_HR_16BITS_VALUE) ? 1 : 0;
+    len -= (flags & HRS_FLAG_ENERGY_EXPENDED_PRESENT) ? 2 : 0;
+
+    return len / 2;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Check the notifications of a run against the beats.
+ ****************************************************************************************
+ */
+static void test_check_run(bool ee_feature, const char *name)
+{
+    uint32_t beat = 0;
+    uint32_t since_ee = APP_HRPS_EE_INTERVAL - 1;
+    uint32_t total = 0;
+
+    for (uint32_t n = 0; n < test_run.ntf_nb; n++)
+    {
+        struct test_ntf const *ntf = &test_run.ntf[n];
+        uint32_t rr_sum = 0;
+        uint32_t oldest = beat;
+
+        TEST_CHECK(ntf->len <= ATT_DEFAULT_MTU - 3, "%s: ntf %u is %u bytes", name, n, ntf->len);
+        TEST_CHECK(ntf->flags & HRS_FLAG_RR_INTERVAL_PRESENT, "%s: ntf %u without RR", name, n);
+        TEST_CHECK(ntf->nb_rr != 0, "%s: ntf %u is empty", name, n);
+
+        for (uint8_t i = 0; i < ntf->nb_rr; i++, beat++)
+        {
+            TEST_CHECK((beat < test_run.beat_nb) && (ntf->rr[i] == test_run.beat_rr[beat]),
+                       "%s: ntf %u rr %u is %u, beat %u", name, n, i, ntf->rr[i], beat);
+            rr_sum += ntf->rr[i];
+        }
+        total += ntf->nb_rr;
+
+        // Full, or sent because the oldest interval reached its deadline
+        if (ntf->nb_rr < test_capacity(ntf->flags))
+        {
+            TEST_CHECK(ntf->time - test_run.beat_time[oldest] >= APP_HRPS_RR_LATENCY_TO,
+                       "%s: ntf %u with %u RR sent after %u", name, n, ntf->nb_rr,
+                       ntf->time - test_run.beat_time[oldest]);
+        }
+        TEST_CHECK(ntf->time - test_run.beat_time[oldest] <= APP_HRPS_RR_LATENCY_TO + 2 * test_run.cfm_delay,
+                   "%s: ntf %u late by %u", name, n, ntf->time - test_run.beat_time[oldest]);
+
+        // Heart rate is the mean of the notified intervals
+        if (rr_sum != 0)
+        {
+            uint32_t bpm = (60UL * 1024 * ntf->nb_rr + rr_sum / 2) / rr_sum;
+
+            TEST_CHECK(ntf->heart_rate == ((bpm > 0xFF && !(ntf->flags & HRS_FLAG_HR_16BITS_VALUE)) ? 0xFF : bpm),
+                       "%s: ntf %u heart rate %u, expected %u", name, n, ntf->heart_rate, bpm);
+        }
+
+        // Energy Expended once every APP_HRPS_EE_INTERVAL notifications
+        since_ee++;
+        if (ee_feature && (since_ee >= APP_HRPS_EE_INTERVAL))
+        {
+            TEST_CHECK(ntf->flags & HRS_FLAG_ENERGY_EXPENDED_PRESENT, "%s: ntf %u without EE", name, n);
+            since_ee = 0;
+        }
+        else
+        {
+            TEST_CHECK(!(ntf->flags & HRS_FLAG_ENERGY_EXPENDED_PRESENT), "%s: ntf %u with EE", name, n);
+        }
+    }
+
+    TEST_CHECK(total == test_run.beat_nb, "%s: %u RR notified of %u", name, total, test_run.beat_nb);
+    TEST_CHECK(app_hrps_env->rr_lost == 0, "%s: %u RR lost", name, app_hrps_env->rr_lost);
+    TEST_CHECK(ke_host_msg_live() == 0, "%s: %u messages left", name, ke_host_msg_live());
+    TEST_CHECK(ke_host_msg_lost() == 0, "%s: %u messages lost", name, ke_host_msg_lost());
+}
+
+/// Radio energy of one notification of len bytes, unit uJ
+static double test_pkt_energy(uint8_t len)
+{
+    return TEST_RADIO_MW * (TEST_PKT_FIXED_US + TEST_BYTE_US * (TEST_PKT_OVERHEAD + len)) / 1000.0;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Packets and energy of the accumulator and of one notification per beat.
+ ****************************************************************************************
+ */
+static void test_energy(void)
+{
+    static const uint16_t bpm[] = {40, 70, 120, 180};
+
+    printf("%5s %8s %10s %10s %10s %10s %8s\n", "bpm", "beats", "pkt/beat", "uJ/beat",
+           "1:1 pkt", "1:1 uJ", "saving");
+    for (uint8_t b = 0; b < sizeof(bpm) / sizeof(bpm[0]); b++)
+    {
+        uint16_t rr = (uint16_t)(60UL * 1024 / bpm[b]);
+        double energy = 0, ref_energy = 0;
+        char name[16];
+
+        snprintf(name, sizeof(name), "%ubpm", bpm[b]);
+        test_start(HRPS_ENGY_EXP_FEAT_SUP, TEST_CON_INTV);
+        test_beats(rr, 5, 10 * 60 * 100);
+        test_check_run(true, name);
+
+        for (uint32_t n = 0; n < test_run.ntf_nb; n++)
+        {
+            energy += test_pkt_energy(test_run.ntf[n].len);
+        }
+        // One notification per beat: flags, 8-bit heart rate, one RR, EE every tenth
+        for (uint32_t n = 0; n < test_run.beat_nb; n++)
+        {
+            ref_energy += test_pkt_energy(4 + (((n % APP_HRPS_EE_INTERVAL) == 0) ? 2 : 0));
+        }
+
+        // The latency deadline of 2s holds at least two beats at these rates
+        TEST_CHECK(test_run.ntf_nb * 2 <= test_run.beat_nb + 1, "%s: %u notifications for %u beats",
+                   name, test_run.ntf_nb, test_run.beat_nb);
+        printf("%5u %8u %10.3f %10.1f %10.3f %10.1f %7.0f%%\n", bpm[b], test_run.beat_nb,
+               (double)test_run.ntf_nb / test_run.beat_nb, energy / test_run.beat_nb,
+               1.0, ref_energy / test_run.beat_nb, 100.0 * (1 - energy / ref_energy));
+    }
+}
+
+/**
+ ****************************************************************************************
+ * @brief Heart rates above 255bpm use the 16-bit format and one RR-Interval less, and
+ * fill the notifications before the deadline.
+ ****************************************************************************************
+ */
+static void test_hr16(void)
+{
+    test_start(HRPS_ENGY_EXP_FEAT_SUP, TEST_CON_INTV);
+    test_beats(200, 0, 60 * 100);
+    test_check_run(true, "hr16");
+
+    for (uint32_t n = 0; n < test_run.ntf_nb; n++)
+    {
+        TEST_CHECK(test_run.ntf[n].flags & HRS_FLAG_HR_16BITS_VALUE, "hr16: ntf %u 8-bit", n);
+    }
+    // The first one carries Energy Expended, the next one is full without it
+    TEST_CHECK((test_run.ntf_nb > 1)
+               && (test_run.ntf[0].nb_rr == test_capacity(HRS_FLAG_HR_16BITS_VALUE | HRS_FLAG_ENERGY_EXPENDED_PRESENT))
+               && (test_run.ntf[1].nb_rr == test_capacity(HRS_FLAG_HR_16BITS_VALUE)),
+               "hr16: first ntfs with %u and %u RR", test_run.ntf[0].nb_rr, test_run.ntf[1].nb_rr);
+}
+
+/**
+ ****************************************************************************************
+ * @brief A peer which does not confirm fills the accumulator, the newest beats are
+ * dropped and counted, the others are still notified in order.
+ ****************************************************************************************
+ */
+static void test_stall(void)
+{
+    uint32_t total = 0;
+
+    test_start(0, 3000);
+    test_beats(878, 0, 60 * 100);
+
+    TEST_CHECK(app_hrps_env->rr_lost != 0, "stall: nothing lost");
+    for (uint32_t n = 0; n < test_run.ntf_nb; n++)
+    {
+        for (uint8_t i = 0; i < test_run.ntf[n].nb_rr; i++)
+        {
+            // intervals are all equal, check the count only
+            TEST_CHECK(test_run.ntf[n].rr[i] == 878, "stall: rr %u", test_run.ntf[n].rr[i]);
+        }
+        total += test_run.ntf[n].nb_rr;
+    }
+    TEST_CHECK(total + app_hrps_env->rr_lost + (uint8_t)(app_hrps_env->rr_wr - app_hrps_env->rr_rd)
+               == test_run.beat_nb,
+               "stall: %u notified %u lost of %u", total, app_hrps_env->rr_lost, test_run.beat_nb);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Nothing is notified while the notifications are disabled.
+ ****************************************************************************************
+ */
+static void test_disabled(void)
+{
+    test_start(0, TEST_CON_INTV);
+    app_hrps_env->features &= ~HRPS_HR_MEAS_NTF_CFG;
+    test_beats(878, 5, 60 * 100);
+
+    TEST_CHECK(test_run.ntf_nb == 0, "disabled: %u notifications", test_run.ntf_nb);
+    TEST_CHECK(app_hrps_env->rr_rd == app_hrps_env->rr_wr, "disabled: RR left");
+    TEST_CHECK(ke_host_msg_live() == 0, "disabled: %u messages left", ke_host_msg_live());
+}
+
+int main(void)
+{
+    test_energy();
+    test_hr16();
+    test_stall();
+    test_disabled();
+
+    printf("hrps: %s (%u failures)\n", test_fail ? "FAIL" : "OK", test_fail);
+
+    return test_fail ? 1 : 0;
+}
@@ -0,0 +1,360 @@
+/**
+ ****************************************************************************************
+ *
+ * @file test_ieee11073.c
+ *
+ * @brief Host test of the IEEE-11073 SFLOAT and FLOAT codec.
+ *
+ * Every SFLOAT is decoded and encoded back, FLOATs are checked on the mantissas around
+ * the special values at every exponent and on random ones. Random values are encoded at
+ * random exponents and checked to be the nearest number, and the pack functions to give
+ * the scalar results. A benchmark measures the per value cost of the conversions.
+ *
+ * Copyright(C) 2015 NXP Semiconductors N.V.
+ * All rights reserved.
+ *
+ * $Rev: $
+ *
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "ieee11073.h"
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// Random values encoded
+#define TEST_RANDOM_NB              2000000
+/// Readings of the pack and benchmark buffers
+#define TEST_BATCH_NB               4096
+#define TEST_BENCH_ROUNDS           2000
+
+/*
+ * LOCAL VARIABLE DEFINITIONS
+ ****************************************************************************************
+ */
+
+static uint32_t test_fail;
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+#define TEST_CHECK(cond, ...)                                                       \
+    do {                                                                            \
+        if (!(cond))                                                                \
+        {                                                                           \
+            if (test_fail < 20)                                                     \
+            {                                                                       \
+                printf("%s:%d: %s: ", __FILE__, __LINE__, #cond);                   \
+                printf(__VA_ARGS__);                                                \
+                printf("\n");                                                       \
+            }                                                                       \
+            test_fail++;                                                            \
+        }                                                                           \
+    } while (0)
+
+static uint32_t test_rand(void)
+{
+    static uint32_t x = 2463534242UL;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+
+    return x;
+}
+
+static void test_sfloat_split(uint16_t raw, int *exp, int *mant)
+{
+    *exp = (int)((raw >> 12) ^ 0x8) - 0x8;
+    *mant = (int)((raw & 0x0FFF) ^ 0x0800) - 0x0800;
+}
+
+static void test_float_split(uint32_t raw, int *exp, int32_t *mant)
+{
+    *exp = (int8_t)(raw >> 24);
+    *mant = (int32_t)((raw & 0x00FFFFFF) ^ 0x00800000) - 0x00800000;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Every SFLOAT: the special values only have a zero exponent, the numbers decode
+ * to their mantissa and encode back to the same SFLOAT, and decode rounded at other
+ * exponents.
+ ****************************************************************************************
+ */
+static void test_sfloat_all(void)
+{
+    uint32_t number = 0, special = 0;
+
+    for (uint32_t raw = 0; raw <= 0xFFFF; raw++)
+    {
+        int e, m;
+        int32_t v;
+        uint8_t kind;
+
+        test_sfloat_split(raw, &e, &m);
+        kind = ieee11073_sfloat_decode(raw, e, &v);
+
+        if (e == 0 && m >= 2046)
+        {
+            TEST_CHECK(kind != IEEE11073_VAL_NUMBER, "%04x", raw);
+            special++;
+            continue;
+        }
+        if (e == 0 && m <= -2046)
+        {
+            TEST_CHECK(kind != IEEE11073_VAL_NUMBER, "%04x", raw);
+            special++;
+            continue;
+        }
+
+        number++;
+        TEST_CHECK(kind == IEEE11073_VAL_NUMBER && v == m, "%04x -> %d", raw, v);
+        TEST_CHECK(ieee11073_sfloat_encode(m, e) == raw, "%04x -> %d -> %04x", raw, m,
+                   ieee11073_sfloat_encode(m, e));
+        // Same value expressed at exponent 0, the encoder finds the exponent back
+        if (e > 0 && e <= 5)
+        {
+            uint16_t back = ieee11073_sfloat_encode(m * (int32_t)pow(10, e), 0);
+            int32_t w;
+
+            TEST_CHECK(ieee11073_sfloat_decode(back, 0, &w) == IEEE11073_VAL_NUMBER
+                       && w == m * (int32_t)pow(10, e), "%04x -> %04x", raw, back);
+        }
+
+        for (int x = -10; x <= 10; x++)
+        {
+            double want = m * pow(10, e - x);
+
+            kind = ieee11073_sfloat_decode(raw, x, &v);
+            if (kind == IEEE11073_VAL_RANGE)
+                TEST_CHECK(fabs(want) > 2147483647.0, "%04x at %d", raw, x);
+            else
+                TEST_CHECK(fabs(v - want) <= 0.5 + 1e-9, "%04x at %d -> %d", raw, x, v);
+        }
+    }
+
+    printf("sfloat: %u numbers, %u special values\n", number, special);
+}
+
+/**
+ ****************************************************************************************
+ * @brief FLOAT mantissas around the special values at every exponent, and random ones.
+ ****************************************************************************************
+ */
+static void test_float_edges(void)
+{
+    static const int32_t edges[] =
+    {
+        0, 1, -1, 8388604, 8388605, 8388606, 8388607, -8388604, -8388605, -8388606, -8388607,
+        -8388608,
+    };
+
+    for (int e = -128; e <= 127; e++)
+    {
+        for (uint32_t i = 0; i < sizeof(edges) / sizeof(edges[0]) + 64; i++)
+        {
+            int32_t m = (i < sizeof(edges) / sizeof(edges[0]))
+                      ? edges[i] : (int32_t)(test_rand() % 16777216) - 8388608;
+            uint32_t raw = ((uint32_t)(uint8_t)e << 24) | ((uint32_t)m & 0x00FFFFFF);
+            uint8_t kind;
+            int32_t v;
+
+            kind = ieee11073_float_decode(raw, e, &v);
+            if (e == 0 && (m >= 8388606 || m <= -8388606))
+            {
+                TEST_CHECK(kind != IEEE11073_VAL_NUMBER, "%08x", raw);
+                continue;
+            }
+            TEST_CHECK(kind == IEEE11073_VAL_NUMBER && v == m, "%08x -> %d", raw, v);
+            TEST_CHECK(ieee11073_float_encode(m, e) == raw, "%08x -> %08x", raw,
+                       ieee11073_float_encode(m, e));
+        }
+    }
+}
+
+/// mant * 10^exp is val * 10^val_exp rounded to a multiple of 10^exp, computed exactly
+static bool test_nearest(int32_t val, int val_exp, int32_t mant, int exp)
+{
+    int64_t p = 1;
+
+    if (exp < val_exp)
+    {
+        // Exponent moved to the mantissa, nothing is rounded
+        for (int i = exp; i < val_exp; i++)
+            p *= 10;
+        return (int64_t)val * p == mant;
+    }
+
+    for (int i = val_exp; i < exp; i++)
+        p *= 10;
+
+    return llabs((int64_t)mant * p - val) * 2 <= p;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Random values at random exponents encode to the nearest number, or to an
+ * infinity when no exponent is large enough.
+ ****************************************************************************************
+ */
+static void test_encode_random(void)
+{
+    for (uint32_t i = 0; i < TEST_RANDOM_NB; i++)
+    {
+        int32_t v = (int32_t)test_rand();
+        int8_t x = (int8_t)(test_rand() % 31) - 15;
+        double want;
+        uint16_t s;
+        uint32_t f;
+        int e;
+        int m;
+        int32_t fm;
+        int32_t back;
+
+        if (i & 1)
+            v >>= test_rand() % 31;
+        want = (double)v * pow(10, x);
+
+        s = ieee11073_sfloat_encode(v, x);
+        test_sfloat_split(s, &e, &m);
+        if (s == IEEE11073_SFLOAT_PINF || s == IEEE11073_SFLOAT_NINF)
+        {
+            TEST_CHECK((s == IEEE11073_SFLOAT_PINF) ? (want >= 2047.5e7) : (want <= -2048.5e7),
+                       "%d e%d -> %04x", v, x, s);
+        }
+        else
+        {
+            TEST_CHECK(ieee11073_sfloat_decode(s, e, &back) == IEEE11073_VAL_NUMBER,
+                       "%d e%d -> %04x", v, x, s);
+            // Below the smallest exponent, the value is rounded at 10^-8
+            TEST_CHECK(test_nearest(v, x, m, e), "%d e%d -> %04x", v, x, s);
+        }
+
+        f = ieee11073_float_encode(v, x);
+        test_float_split(f, &e, &fm);
+        TEST_CHECK(ieee11073_float_decode(f, e, &back) == IEEE11073_VAL_NUMBER,
+                   "%d e%d -> %08x", v, x, f);
+        TEST_CHECK(test_nearest(v, x, fm, e), "%d e%d -> %08x", v, x, f);
+    }
+}
+
+/**
+ ****************************************************************************************
+ * @brief The pack and unpack functions give the scalar results.
+ ****************************************************************************************
+ */
+static void test_batch(void)
+{
+    static int32_t in[TEST_BATCH_NB], out[TEST_BATCH_NB];
+    static uint8_t buf[4 * TEST_BATCH_NB];
+
+    for (uint32_t it = 0; it < 200; it++)
+    {
+        int8_t x = (int8_t)(test_rand() % 40) - 20;
+
+        for (uint32_t i = 0; i < TEST_BATCH_NB; i++)
+            in[i] = (i & 1) ? (int32_t)(test_rand() % 5000) - 2500 : (int32_t)test_rand() >> (test_rand() % 31);
+
+        ieee11073_sfloat_pack(buf, in, x, TEST_BATCH_NB);
+        ieee11073_sfloat_unpack(buf, out, x, TEST_BATCH_NB);
+        for (uint32_t i = 0; i < TEST_BATCH_NB; i++)
+        {
+            uint16_t s = buf[2 * i] | (buf[2 * i + 1] << 8);
+            int32_t v;
+
+            TEST_CHECK(s == ieee11073_sfloat_encode(in[i], x), "%d e%d -> %04x", in[i], x, s);
+            if (ieee11073_sfloat_decode(s, x, &v) == IEEE11073_VAL_NUMBER)
+                TEST_CHECK(out[i] == v, "%04x", s);
+            else
+                TEST_CHECK(out[i] == IEEE11073_VAL_INVALID, "%04x", s);
+        }
+
+        ieee11073_float_pack(buf, in, x, TEST_BATCH_NB);
+        ieee11073_float_unpack(buf, out, x, TEST_BATCH_NB);
+        for (uint32_t i = 0; i < TEST_BATCH_NB; i++)
+        {
+            uint32_t f = buf[4 * i] | (buf[4 * i + 1] << 8) | ((uint32_t)buf[4 * i + 2] << 16)
+                       | ((uint32_t)buf[4 * i + 3] << 24);
+
+            TEST_CHECK(f == ieee11073_float_encode(in[i], x), "%d e%d -> %08x", in[i], x, f);
+            if (abs(in[i]) <= 8388605)
+                TEST_CHECK(out[i] == in[i], "%d e%d -> %d", in[i], x, out[i]);
+        }
+    }
+}
+
+static double test_elapsed_ns(struct timespec const *t0)
+{
+    struct timespec t1;
+
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    return (t1.tv_sec - t0->tv_sec) * 1e9 + (t1.tv_nsec - t0->tv_nsec);
+}
+
+static void test_bench(void)
+{
+    static int32_t val[TEST_BATCH_NB];
+    static uint8_t buf[2 * TEST_BATCH_NB];
+    volatile uint32_t sink = 0;
+    struct timespec t0;
+    double ns;
+
+    for (uint32_t i = 0; i < TEST_BATCH_NB; i++)
+        val[i] = (int32_t)(test_rand() % 4000) - 2000;
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (uint32_t r = 0; r < TEST_BENCH_ROUNDS; r++)
+    {
+        ieee11073_sfloat_pack(buf, val, -1, TEST_BATCH_NB);
+        sink += buf[r % sizeof(buf)];
+    }
+    ns = test_elapsed_ns(&t0) / ((double)TEST_BENCH_ROUNDS * TEST_BATCH_NB);
+    printf("sfloat_pack %.2f ns/value\n", ns);
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (uint32_t r = 0; r < TEST_BENCH_ROUNDS; r++)
+    {
+        for (uint32_t i = 0; i < TEST_BATCH_NB; i++)
+            sink += ieee11073_sfloat_encode(val[i] * 1000, -1);
+    }
+    ns = test_elapsed_ns(&t0) / ((double)TEST_BENCH_ROUNDS * TEST_BATCH_NB);
+    printf("sfloat_encode (rounding) %.2f ns/value\n", ns);
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (uint32_t r = 0; r < TEST_BENCH_ROUNDS; r++)
+    {
+        ieee11073_sfloat_unpack(buf, val, -2, TEST_BATCH_NB);
+        sink += val[r % TEST_BATCH_NB];
+    }
+    ns = test_elapsed_ns(&t0) / ((double)TEST_BENCH_ROUNDS * TEST_BATCH_NB);
+    printf("sfloat_unpack %.2f ns/value\n", ns);
+}
+
+int main(void)
+{
+    test_sfloat_all();
+    test_float_edges();
+    test_encode_random();
+    test_batch();
+    test_bench();
+
+    printf("ieee11073: %s (%u failures)\n", test_fail ? "FAIL" : "OK", test_fail);
+
+    return test_fail != 0;
+}
@@ -0,0 +1,478 @@
+/**
+ ****************************************************************************************
+ *
+ * @file test_joysticks.c
+ *
+ * @brief Host test of the joystick key scanner of joysticks.c on synthetic traces.
+ *
+ * The button line and the resistor ladder of the FireBLE joystick are modelled every
+ * 10ms: presses with contact bounce, glitches, long holds, slides from a key to the
+ * next and noisy ADC samples. The line wakes the scanner on its falling edges as the
+ * GPIO interrupt does. Every press long enough must give one press and one release of
+ * its key, long presses their long and repeat events on time, glitches nothing, and
+ * the ADC must be powered off and the line interrupt enabled once the keys are up.
+ *
+ * Copyright(C) 2015 NXP Semiconductors N.V.
+ * All rights reserved.
+ *
+ * $Rev: $
+ *
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "app_env.h"
+#include "lib.h"
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// Noise of the ADC samples, in codes
+#define TEST_NOISE                  60
+/// Random presses of the last trace
+#define TEST_RANDOM_NB              300
+/// Segments of a trace at most
+#define TEST_SEG_MAX                (2 * TEST_RANDOM_NB + 4)
+/// Key events recorded at most
+#define TEST_EVT_MAX                2048
+
+/*
+ * KEY SCANNER, on the ADC model of the test
+ ****************************************************************************************
+ */
+
+/// The ADC is not part of the host driver configuration, the test is the ADC driver
+enum {ADC_SINGLE_WITHOUT_BUF_DRV, ADC_CLK_1000000, ADC_INT_REF, ADC_12BIT, ADC_TRIG_SOFT, SINGLE_MOD, AIN0};
+
+typedef struct
+{
+    int mode;
+    int trig_src;
+    int start_ch;
+    int end_ch;
+} adc_read_configuration;
+
+void adc_init(int in_mod, int work_clk, int ref_vol, int resolution);
+void adc_read(const adc_read_configuration *S, int16_t *buf, uint32_t samples, void (*callback)(void));
+void adc_clock_off(void);
+void adc_power_off(void);
+
+#include "../src/qnevb/joysticks.c"
+
+/*
+ * TYPE DEFINITIONS
+ ****************************************************************************************
+ */
+
+/// Segment of a trace: from start on, the key held (0 if none) after bounce ticks
+struct test_seg
+{
+    uint32_t start;
+    uint8_t key;
+    uint8_t bounce;
+};
+
+/// Key event received by the application task
+struct test_evt
+{
+    uint32_t time;
+    uint8_t key;
+    uint8_t evt;
+};
+
+/*
+ * LOCAL VARIABLE DEFINITIONS
+ ****************************************************************************************
+ */
+
+static uint32_t test_fail;
+
+static ke_state_t test_app_state[1];
+
+/// ADC codes of the ladder, at the middle of the ranges of key_table
+static const struct
+{
+    uint8_t key;
+    int16_t code;
+} test_code[] =
+{
+    {0,                         100},
+    {key_up,                    427},
+    {key_right,                 860},
+    {key_down,                  1269},
+    {key_left,                  1679},
+    {key_center,                1965},
+};
+
+/// Board model
+static struct
+{
+    /// Button line, high when no key is down, and the ladder
+    bool line;
+    uint8_t key;
+    bool int_en;
+    bool adc_on;
+    uint32_t adc_init_nb;
+    uint32_t scan_nb;
+    uint32_t adc_on_ticks;
+} test_board;
+
+static struct test_evt test_evt[TEST_EVT_MAX];
+static uint32_t test_evt_nb;
+
+static struct test_seg test_trace[TEST_SEG_MAX];
+
+/*
+ * GLOBAL VARIABLE DEFINITIONS
+ ****************************************************************************************
+ */
+
+struct app_env_tag app_env;
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+#define TEST_CHECK(cond, ...)                                                       \
+    do {                                                                            \
+        if (!(cond))                                                                \
+        {                                                                           \
+            if (test_fail < 20)                                                     \
+            {                                                                       \
+                printf("%s:%d: %s: ", __FILE__, __LINE__, #cond);                   \
+                printf(__VA_ARGS__);                                                \
+                printf("\n");                                                       \
+            }                                                                       \
+            test_fail++;                                                            \
+        }                                                                           \
+    } while (0)
+
+static uint32_t test_rand(void)
+{
+    static uint32_t x = 2463534242UL;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+
+    return x;
+}
+
+void app_task_msg_hdl(ke_msg_id_t const msgid, void const *param)
+{
+}
+
+void adc_init(int in_mod, int work_clk, int ref_vol, int resolution)
+{
+    TEST_CHECK(!test_board.adc_on, "ADC initialized twice at %u", ke_host_time());
+    test_board.adc_on = true;
+    test_board.adc_init_nb++;
+}
+
+/// Samples of the ladder, the conversion ends at once
+void adc_read(const adc_read_configuration *S, int16_t *buf, uint32_t samples, void (*callback)(void))
+{
+    int16_t code = test_code[0].code;
+
+    TEST_CHECK(test_board.adc_on, "ADC read while off at %u", ke_host_time());
+    test_board.scan_nb++;
+
+    for (uint8_t i = 0; i < sizeof(test_code) / sizeof(test_code[0]); i++)
+    {
+        if (test_code[i].key == test_board.key)
+            code = test_code[i].code;
+    }
+    while (samples--)
+        *buf++ = code + (int16_t)(test_rand() % (2 * TEST_NOISE + 1)) - TEST_NOISE;
+
+    callback();
+}
+
+void adc_clock_off(void)
+{
+}
+
+void adc_power_off(void)
+{
+    TEST_CHECK(test_board.adc_on, "ADC powered off twice at %u", ke_host_time());
+    test_board.adc_on = false;
+}
+
+enum gpio_level gpio_read_pin(enum gpio_pin pin)
+{
+    return test_board.line ? GPIO_HIGH : GPIO_LOW;
+}
+
+void gpio_enable_interrupt(enum gpio_pin pin)
+{
+    test_board.int_en = true;
+}
+
+/// app_event_button1_press_handler() of prj_firmware, the scan starts 20ms later
+static void test_button1_event(void)
+{
+    ke_timer_set(APP_KEY_SCAN_TIMER, TASK_APP, 2);
+    ke_evt_clear(1UL << EVENT_BUTTON1_PRESS_ID);
+}
+
+static int test_key_ind_handler(ke_msg_id_t const msgid, struct app_key_ind const *param,
+                                ke_task_id_t const dest_id, ke_task_id_t const src_id)
+{
+    if (test_evt_nb < TEST_EVT_MAX)
+    {
+        test_evt[test_evt_nb].time = ke_host_time();
+        test_evt[test_evt_nb].key = param->key;
+        test_evt[test_evt_nb++].evt = param->evt;
+    }
+
+    return (KE_MSG_CONSUMED);
+}
+
+static const struct ke_msg_handler test_app_default_state[] =
+{
+    {APP_KEY_SCAN_TIMER,        (ke_msg_func_t)app_key_scan_timer_handler},
+    {APP_KEY_IND,               (ke_msg_func_t)test_key_ind_handler},
+};
+
+static const struct ke_state_handler test_app_default = KE_STATE_HANDLER(test_app_default_state);
+
+/**
+ ****************************************************************************************
+ * @brief Play a trace of nb segments, the last one lasting until end.
+ *
+ * During the bounce of a segment the line and the ladder toggle every 10ms between
+ * the previous segment and this one.
+ ****************************************************************************************
+ */
+static void test_play(struct test_seg const *seg, uint32_t nb, uint32_t end)
+{
+    struct ke_task_desc app_desc = {NULL, &test_app_default, test_app_state, 1, 1};
+    uint32_t s = 0;
+    uint8_t prev = 0;
+
+    ke_host_init();
+    task_desc_register(TASK_APP, app_desc);
+    ke_evt_callback_set(EVENT_BUTTON1_PRESS_ID, test_button1_event);
+    ke_evt_callback_set(EVENT_ADC_KEY_SAMPLE_CMP_ID, app_event_adc_key_sample_cmp_handler);
+    memset(&usr_button_env, 0, sizeof(usr_button_env));
+    usr_button_env.button_st = button_idle;
+    memset(&test_board, 0, sizeof(test_board));
+    test_board.line = true;
+    test_board.int_en = true;
+    test_evt_nb = 0;
+
+    for (uint32_t t = 1; t <= end; t++)
+    {
+        bool line = test_board.line;
+
+        while ((s < nb) && (seg[s].start <= t))
+        {
+            prev = test_board.key;
+            s++;
+        }
+        if (s != 0)
+        {
+            struct test_seg const *cur = &seg[s - 1];
+            bool bouncing = (t - cur->start < cur->bounce) && ((t - cur->start) & 1);
+
+            test_board.key = bouncing ? prev : cur->key;
+        }
+        test_board.line = (test_board.key == 0);
+
+        // usr_button1_cb() on the falling edge of the line
+        if (line && !test_board.line && test_board.int_en)
+        {
+            usr_button_env.button_st = button_press;
+            ke_evt_set(1UL << EVENT_BUTTON1_PRESS_ID);
+        }
+
+        ke_host_run(t);
+        if (test_board.adc_on)
+            test_board.adc_on_ticks++;
+    }
+
+    TEST_CHECK(!test_board.adc_on, "ADC left on");
+    TEST_CHECK(test_board.int_en, "line interrupt left off");
+    TEST_CHECK(usr_button_env.scan_st == KEY_SCAN_IDLE, "scanner in state %u", usr_button_env.scan_st);
+    TEST_CHECK(ke_host_msg_live() == 0, "%u messages live", ke_host_msg_live());
+}
+
+/// Events expected from a trace, as 'P', 'L', 'R' (repeat) or 'U' (release) and the key
+static void test_expect(const char *name, const char *evts, uint8_t const *keys)
+{
+    static const char evt_char[] = {'P', 'L', 'R', 'U'};
+    uint32_t nb = strlen(evts);
+
+    TEST_CHECK(test_evt_nb == nb, "%s: %u events, %u expected", name, test_evt_nb, nb);
+    for (uint32_t i = 0; (i < nb) && (i < test_evt_nb); i++)
+    {
+        TEST_CHECK(evt_char[test_evt[i].evt] == evts[i] && test_evt[i].key == keys[i],
+                   "%s: event %u is %c %02x, expected %c %02x", name, i, evt_char[test_evt[i].evt],
+                   test_evt[i].key, evts[i], keys[i]);
+    }
+}
+
+/// Latency of the event i after time t, in 10ms
+static uint32_t test_latency(uint32_t i, uint32_t t)
+{
+    return (i < test_evt_nb) ? test_evt[i].time - t : UINT32_MAX;
+}
+
+static void test_report(const char *name, uint32_t press_nb, uint32_t lat_press, uint32_t lat_release)
+{
+    printf("%-18s %6u %6u %6u %6u %8u %5u ms %5u ms\n", name, press_nb, test_evt_nb, test_board.scan_nb,
+           test_board.adc_init_nb, test_board.adc_on_ticks * 10, lat_press * 10, lat_release * 10);
+}
+
+int main(void)
+{
+    static const uint8_t keys[] = {key_up, key_right, key_down, key_left, key_center};
+    uint32_t lat_press = 0, lat_release = 0;
+
+    printf("%-18s %6s %6s %6s %6s %8s %8s %8s\n", "trace", "press", "events", "scans", "adc on", "adc ms",
+           "press", "release");
+
+    // A clean 300ms press of each key
+    for (uint8_t k = 0; k < sizeof(keys); k++)
+    {
+        struct test_seg seg[] = {{10, keys[k], 0}, {40, 0, 0}};
+
+        test_play(seg, 2, 60);
+        test_expect("clean", "PU", (uint8_t[]){keys[k], keys[k]});
+        if (test_latency(0, 10) > lat_press)
+            lat_press = test_latency(0, 10);
+        if (test_latency(1, 40) > lat_release)
+            lat_release = test_latency(1, 40);
+        TEST_CHECK(test_board.adc_init_nb == 1, "ADC powered %u times", test_board.adc_init_nb);
+    }
+    // Debounce timer, then two equal scans
+    TEST_CHECK(lat_press <= 2 + KEY_DEBOUNCE_CNT * KEY_SCAN_PERIOD, "press after %u0ms", lat_press);
+    TEST_CHECK(lat_release <= KEY_SCAN_PERIOD, "release after %u0ms", lat_release);
+    test_report("clean", sizeof(keys), lat_press, lat_release);
+
+    // 50ms of bounce on press and on release
+    {
+        struct test_seg seg[] = {{10, key_left, 5}, {40, 0, 5}};
+
+        test_play(seg, 2, 60);
+        test_expect("bounce", "PU", (uint8_t[]){key_left, key_left});
+        test_report("bounce", 1, test_latency(0, 10), test_latency(1, 40));
+    }
+
+    // A 10ms glitch of the line
+    {
+        struct test_seg seg[] = {{10, key_down, 0}, {11, 0, 0}};
+
+        test_play(seg, 2, 30);
+        test_expect("glitch", "", NULL);
+        test_report("glitch", 0, 0, 0);
+    }
+
+    // A 3s hold: long press after 1s, then a repeat every 200ms
+    {
+        struct test_seg seg[] = {{10, key_center, 2}, {310, 0, 0}};
+        uint32_t press, lng;
+
+        test_play(seg, 2, 330);
+        TEST_CHECK(test_evt_nb >= 4, "hold: %u events", test_evt_nb);
+        press = test_evt[0].time;
+        lng = test_evt[1].time;
+        TEST_CHECK(test_evt[0].evt == KEY_EVT_PRESS && test_evt[1].evt == KEY_EVT_LONG, "hold: no long press");
+        TEST_CHECK(lng - press == KEY_LONG_CNT * KEY_SCAN_PERIOD, "hold: long press after %u0ms", lng - press);
+        for (uint32_t i = 2; i + 1 < test_evt_nb; i++)
+        {
+            TEST_CHECK(test_evt[i].evt == KEY_EVT_REPEAT && test_evt[i].key == key_center, "hold: event %u", i);
+            TEST_CHECK(test_evt[i].time - test_evt[i - 1].time == KEY_REPEAT_CNT * KEY_SCAN_PERIOD,
+                       "hold: repeat %u after %u0ms", i, test_evt[i].time - test_evt[i - 1].time);
+        }
+        // Repeats until the release, which ends the events
+        TEST_CHECK(test_evt_nb - 3 == (310 - lng) / (KEY_REPEAT_CNT * KEY_SCAN_PERIOD), "hold: %u repeats",
+                   test_evt_nb - 3);
+        TEST_CHECK(test_evt[test_evt_nb - 1].evt == KEY_EVT_RELEASE, "hold: no release");
+        test_report("hold 3s", 1, press - 10, test_evt[test_evt_nb - 1].time - 310);
+    }
+
+    // A slide from left to center, the line staying low
+    {
+        struct test_seg seg[] = {{10, key_left, 0}, {40, key_center, 2}, {70, 0, 0}};
+
+        test_play(seg, 3, 90);
+        test_expect("slide", "PUPU", (uint8_t[]){key_left, key_left, key_center, key_center});
+        TEST_CHECK(test_board.adc_init_nb == 1, "slide: ADC powered %u times", test_board.adc_init_nb);
+        test_report("slide", 2, test_latency(0, 10), test_latency(3, 70));
+    }
+
+    // Random presses and gaps of at least 80ms besides their bounce, noisy ladder
+    {
+        uint32_t t = 10, nb = 0, press = 0, release = 0, k = 0;
+        uint32_t long_nb = 0;
+
+        lat_press = lat_release = 0;
+        for (uint32_t i = 0; i < TEST_RANDOM_NB; i++)
+        {
+            uint32_t r = test_rand();
+            uint8_t bounce = r % 5;
+
+            test_trace[nb].start = t;
+            test_trace[nb].key = keys[(r >> 4) % sizeof(keys)];
+            test_trace[nb++].bounce = bounce;
+            t += bounce + 8 + (r >> 8) % 150;
+            bounce = (r >> 16) % 5;
+            test_trace[nb].start = t;
+            test_trace[nb].key = 0;
+            test_trace[nb++].bounce = bounce;
+            t += bounce + 8 + (r >> 24) % 50;
+        }
+        test_play(test_trace, nb, t + 10);
+
+        // Each press gives its press and its release, long presses in between
+        for (uint32_t i = 0; i < test_evt_nb; i++)
+        {
+            struct test_seg const *seg = &test_trace[2 * k];
+
+            if (test_evt[i].evt == KEY_EVT_PRESS)
+            {
+                TEST_CHECK(test_evt[i].key == seg->key, "random: press %u of %02x for %02x", k,
+                           test_evt[i].key, seg->key);
+                if (test_evt[i].time - seg->start > lat_press)
+                    lat_press = test_evt[i].time - seg->start;
+                press++;
+            }
+            else if (test_evt[i].evt == KEY_EVT_RELEASE)
+            {
+                TEST_CHECK(test_evt[i].key == seg->key, "random: release %u", k);
+                if (test_evt[i].time - seg[1].start > lat_release)
+                    lat_release = test_evt[i].time - seg[1].start;
+                release++;
+                k++;
+            }
+            else
+            {
+                if (test_evt[i].evt == KEY_EVT_LONG)
+                    long_nb++;
+                TEST_CHECK(test_evt[i].key == seg->key, "random: long %u", k);
+            }
+        }
+        TEST_CHECK(press == TEST_RANDOM_NB && release == TEST_RANDOM_NB, "random: %u presses, %u releases",
+                   press, release);
+        TEST_CHECK(long_nb > 0, "random: no long press");
+        // Bounce may only start a scan, never a press
+        TEST_CHECK(lat_press <= 4 + 2 + KEY_DEBOUNCE_CNT * KEY_SCAN_PERIOD, "random: press after %u0ms", lat_press);
+        TEST_CHECK(lat_release <= 4 + KEY_SCAN_PERIOD, "random: release after %u0ms", lat_release);
+        test_report("random, noisy", TEST_RANDOM_NB, lat_press, lat_release);
+    }
+
+    printf("joysticks: %s (%u failures)\n", test_fail ? "FAIL" : "OK", test_fail);
+
+    return test_fail ? 1 : 0;
+}
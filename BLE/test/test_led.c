@@ -0,0 +1,315 @@
+/**
+ ****************************************************************************************
+ *
+ * @file test_led.c
+ *
+ * @brief Host measure of the wakeups of the LED pattern engine.
+ *
+ * The engine of led.c plays blink patterns for a simulated minute on the host kernel,
+ * driven as usr_design.c drives it: one kernel timer armed with the delay each call
+ * returns, and led_pattern_due() checked at every wakeup of the BLE stack, modelled by
+ * a timer at the advertising or connection interval. A wakeup of the LED timer which is
+ * not one of the BLE stack costs the chip a wakeup of its own. The flashes must keep
+ * their length, the off periods may only end up to their slack early, and no pattern
+ * may drift.
+ *
+ * Copyright(C) 2015 NXP Semiconductors N.V.
+ * All rights reserved.
+ *
+ * $Rev: $
+ *
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "app_env.h"
+#include "lib.h"
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// Simulated time of a run, a minute in 10ms
+#define TEST_RUN                    6000
+/// Blink of the status led of the projects while advertising, in 10ms
+#define TEST_ON                     2
+#define TEST_OFF                    50
+/// Flashes of a minute
+#define TEST_FLASH_NB               (TEST_RUN / (TEST_ON + TEST_OFF))
+
+/// Messages of the test
+enum
+{
+    TEST_LED_TIMER = 0x0c00,
+    TEST_BLE_TIMER,
+};
+
+/*
+ * LED PATTERN ENGINE, on the GPIO model of the test
+ ****************************************************************************************
+ */
+
+#include "../src/qnevb/led.c"
+
+/*
+ * LOCAL VARIABLE DEFINITIONS
+ ****************************************************************************************
+ */
+
+static uint32_t test_fail;
+
+static ke_state_t test_app_state[1];
+
+/// Output of the leds, active low, and what was seen of it
+static struct
+{
+    uint32_t pin;
+    /// Time the led was switched on or off
+    uint32_t edge[LED_NB];
+    uint32_t flash[LED_NB];
+    /// Shortest and longest on and off periods
+    uint32_t on_min, on_max;
+    uint32_t off_min, off_max;
+} test_led;
+
+/// Run of the harness
+static struct
+{
+    /// Interval of the wakeups of the BLE stack, 0 if none
+    uint32_t ble_intv;
+    /// led_pattern_due() checked at the wakeups of the BLE stack
+    bool early;
+    /// Wakeups of the LED timer, those the BLE stack did not make anyway
+    uint32_t led_wakeup;
+    uint32_t own_wakeup;
+} test_run;
+
+/*
+ * GLOBAL VARIABLE DEFINITIONS
+ ****************************************************************************************
+ */
+
+struct app_env_tag app_env;
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+#define TEST_CHECK(cond, ...)                                                       \
+    do {                                                                            \
+        if (!(cond))                                                                \
+        {                                                                           \
+            if (test_fail < 20)                                                     \
+            {                                                                       \
+                printf("%s:%d: %s: ", __FILE__, __LINE__, #cond);                   \
+                printf(__VA_ARGS__);                                                \
+                printf("\n");                                                       \
+            }                                                                       \
+            test_fail++;                                                            \
+        }                                                                           \
+    } while (0)
+
+void app_task_msg_hdl(ke_msg_id_t const msgid, void const *param)
+{
+}
+
+uint32_t ke_time(void)
+{
+    return ke_host_time();
+}
+
+void gpio_set_direction_field(uint32_t pin_mask, uint32_t direction_value)
+{
+}
+
+void gpio_write_pin_field(uint32_t pin_mask, uint32_t level_value)
+{
+    uint32_t now = ke_host_time();
+    uint32_t pin = (test_led.pin & ~pin_mask) | (level_value & pin_mask);
+
+    for (int i = 0; i < LED_NB; i++)
+    {
+        uint32_t len = now - test_led.edge[i];
+
+        if (((pin ^ test_led.pin) & led_pin[i]) == 0)
+            continue;
+
+        if (pin & led_pin[i])
+        {
+            // Switched off
+            test_led.flash[i]++;
+            if (len < test_led.on_min)
+                test_led.on_min = len;
+            if (len > test_led.on_max)
+                test_led.on_max = len;
+        }
+        else if (test_led.flash[i] != 0)
+        {
+            if (len < test_led.off_min)
+                test_led.off_min = len;
+            if (len > test_led.off_max)
+                test_led.off_max = len;
+        }
+        test_led.edge[i] = now;
+    }
+    test_led.pin = pin;
+}
+
+void gpio_write_pin(enum gpio_pin pin, enum gpio_level level)
+{
+    gpio_write_pin_field(pin, level ? pin : 0);
+}
+
+enum gpio_level gpio_read_pin(enum gpio_pin pin)
+{
+    return (test_led.pin & pin) ? GPIO_HIGH : GPIO_LOW;
+}
+
+/// usr_led1_timer() of the projects
+static void test_led_timer(uint16_t delay)
+{
+    if (delay != 0)
+        ke_timer_set(TEST_LED_TIMER, TASK_APP, delay);
+    else
+        ke_timer_clear(TEST_LED_TIMER, TASK_APP);
+}
+
+static int test_led_timer_handler(ke_msg_id_t const msgid, void const *param,
+                                  ke_task_id_t const dest_id, ke_task_id_t const src_id)
+{
+    uint32_t now = ke_host_time();
+
+    test_run.led_wakeup++;
+    // The BLE stack wakes up at the multiples of its interval
+    if ((test_run.ble_intv == 0) || (now % test_run.ble_intv != 0))
+        test_run.own_wakeup++;
+
+    test_led_timer(led_pattern_process());
+
+    return (KE_MSG_CONSUMED);
+}
+
+/// app_event_led_pattern_handler() of the projects
+static void test_led_event(void)
+{
+    ke_evt_clear(1UL << EVENT_LED_PATTERN_ID);
+    test_led_timer(led_pattern_process_early());
+}
+
+/// Wakeup of the BLE stack, usr_sleep_restore() of the projects
+static int test_ble_timer_handler(ke_msg_id_t const msgid, void const *param,
+                                  ke_task_id_t const dest_id, ke_task_id_t const src_id)
+{
+    ke_timer_set(TEST_BLE_TIMER, TASK_APP, test_run.ble_intv);
+
+    if (test_run.early && led_pattern_due())
+        ke_evt_set(1UL << EVENT_LED_PATTERN_ID);
+
+    return (KE_MSG_CONSUMED);
+}
+
+static const struct ke_msg_handler test_app_default_state[] =
+{
+    {TEST_LED_TIMER,            (ke_msg_func_t)test_led_timer_handler},
+    {TEST_BLE_TIMER,            (ke_msg_func_t)test_ble_timer_handler},
+};
+
+static const struct ke_state_handler test_app_default = KE_STATE_HANDLER(test_app_default_state);
+
+/**
+ ****************************************************************************************
+ * @brief A minute of blinking.
+ *
+ * @param[in] nb        Leds blinking, each on its own pattern player
+ * @param[in] phase     Start of each led after the previous one, in 10ms
+ * @param[in] ble_intv  Interval of the wakeups of the BLE stack, 0 if none
+ * @param[in] early     Steps played early at the wakeups of the BLE stack
+ ****************************************************************************************
+ */
+static void test_blink(const char *name, uint8_t nb, uint32_t phase, uint32_t ble_intv, bool early)
+{
+    static struct led_pattern pat[LED_PATTERN_NB];
+    struct ke_task_desc app_desc = {NULL, &test_app_default, test_app_state, 1, 1};
+    uint32_t flash_min = UINT32_MAX, flash_max = 0, count;
+    uint32_t slack = early ? (TEST_OFF >> LED_PATTERN_SLACK_SHIFT) : 0;
+
+    ke_host_init();
+    task_desc_register(TASK_APP, app_desc);
+    ke_evt_callback_set(EVENT_LED_PATTERN_ID, test_led_event);
+    memset(&led_pattern_env, 0, sizeof(led_pattern_env));
+    memset(&test_led, 0, sizeof(test_led));
+    memset(&test_run, 0, sizeof(test_run));
+    test_led.pin = LED1_PIN | LED2_PIN | LED3_PIN | LED4_PIN | LED5_PIN;
+    test_led.on_min = test_led.off_min = UINT32_MAX;
+    test_run.ble_intv = ble_intv;
+    test_run.early = early;
+
+    if (ble_intv != 0)
+        ke_timer_set(TEST_BLE_TIMER, TASK_APP, ble_intv);
+
+    for (uint8_t i = 0; i < nb; i++)
+    {
+        ke_host_run(i * phase);
+        led_pattern_blink(&pat[i], LED_MATRIX(i + 1), TEST_ON, TEST_OFF);
+        test_led_timer(led_pattern_start(i, &pat[i]));
+    }
+    count = led_pattern_wakeup_count();
+    ke_host_run(TEST_RUN);
+
+    for (uint8_t i = 0; i < nb; i++)
+    {
+        if (test_led.flash[i] < flash_min)
+            flash_min = test_led.flash[i];
+        if (test_led.flash[i] > flash_max)
+            flash_max = test_led.flash[i];
+    }
+
+    TEST_CHECK(led_pattern_wakeup_count() - count == test_run.led_wakeup, "%s: %u counted, %u wakeups", name,
+               led_pattern_wakeup_count() - count, test_run.led_wakeup);
+    TEST_CHECK(test_led.on_min == TEST_ON && test_led.on_max == TEST_ON, "%s: flashes of %u to %u", name,
+               test_led.on_min, test_led.on_max);
+    TEST_CHECK(test_led.off_min >= TEST_OFF - slack && test_led.off_max <= TEST_OFF + slack, "%s: off %u to %u",
+               name, test_led.off_min, test_led.off_max);
+    // Steps played early do not make the pattern drift
+    TEST_CHECK(flash_min >= TEST_FLASH_NB - 2 && flash_max <= TEST_FLASH_NB, "%s: %u to %u flashes", name,
+               flash_min, flash_max);
+
+    printf("%-28s %5u %6u %8u %8u %5u-%-3u\n", name, nb, ble_intv * 10, test_run.led_wakeup, test_run.own_wakeup,
+           test_led.off_min * 10, test_led.off_max * 10);
+}
+
+int main(void)
+{
+    printf("%-28s %5s %6s %8s %8s %9s\n", "case", "leds", "ble ms", "timer", "own", "off ms");
+
+    test_blink("one led", 1, 0, 0, false);
+    TEST_CHECK(test_run.own_wakeup >= 230 && test_run.own_wakeup <= 231, "%u wakeups", test_run.own_wakeup);
+    test_blink("two leds in phase", 2, 0, 0, false);
+    TEST_CHECK(test_run.own_wakeup >= 230 && test_run.own_wakeup <= 231, "%u wakeups", test_run.own_wakeup);
+    test_blink("two leds 100ms apart", 2, 10, 0, false);
+    TEST_CHECK(test_run.own_wakeup >= 460 && test_run.own_wakeup <= 462, "%u wakeups", test_run.own_wakeup);
+
+    // Advertising and connection intervals
+    test_blink("one led, adv", 1, 0, 100, false);
+    test_blink("one led, adv, early", 1, 0, 100, true);
+    test_blink("one led, conn", 1, 0, 10, false);
+    test_blink("one led, conn, early", 1, 0, 10, true);
+    TEST_CHECK(test_run.own_wakeup <= 116, "%u wakeups", test_run.own_wakeup);
+    test_blink("two leds apart, conn, early", 2, 10, 10, true);
+    TEST_CHECK(test_run.own_wakeup <= 232, "%u wakeups", test_run.own_wakeup);
+    test_blink("one led, fast conn", 1, 0, 3, false);
+    test_blink("one led, fast conn, early", 1, 0, 3, true);
+
+    printf("led: %s (%u failures)\n", test_fail ? "FAIL" : "OK", test_fail);
+
+    return test_fail ? 1 : 0;
+}
@@ -0,0 +1,765 @@
+/**
+ ****************************************************************************************
+ *
+ * @file test_long.c
+ *
+ * @brief Host simulation of the long reads and writes of prf_utils.c (CFG_LONG_WRITE) at
+ *        the default MTU, with a benchmark of the ATT PDUs and time they take.
+ *
+ * The GATT is replaced by a task which runs each request of the queue as the ROM does:
+ * a long read reads blobs of (MTU - 1) bytes until a short one or ATTM_MAX_LONG_VALUE
+ * bytes, a long write sends (MTU - 5) byte Prepare Write requests to the queue of the
+ * peer and executes it when asked. The peer hands the executed prepared writes to
+ * prf_long_wr_ind() with the buffer of each attribute, as a server does. The Device Name
+ * read of prj_client, a 512 byte value and a 45 byte HID report are read and written;
+ * the buffers the client side allocates must follow the length of each value and be
+ * released at the end, on an error and on a disconnection.
+ *
+ * Copyright(C) 2015 NXP Semiconductors N.V.
+ * All rights reserved.
+ *
+ * $Rev: $
+ *
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "app_env.h"
+
+uint8_t test_get_rec_idx(uint16_t conhdl);
+uint16_t test_get_mtu(uint8_t idx);
+void *test_malloc(uint32_t size);
+void test_free(void *mem_ptr);
+void *test_msg_alloc(ke_msg_id_t const id, ke_task_id_t const dest_id, ke_task_id_t const src_id,
+                     uint16_t const param_len);
+
+#undef _gap_get_rec_idx
+#define _gap_get_rec_idx            test_get_rec_idx
+#undef _attm_get_mtu
+#define _attm_get_mtu               test_get_mtu
+#undef _ke_malloc
+#define _ke_malloc                  test_malloc
+#undef _ke_free
+#define _ke_free                    test_free
+#undef _ke_msg_alloc
+#define _ke_msg_alloc               test_msg_alloc
+
+#include "../src/profiles/prf_utils.c"
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// Connection handle of the link
+#define TEST_CONHDL                 0x0001
+/// Connection interval (unit: 10ms)
+#define TEST_CON_INTV               3
+/// An ATT request goes in a connection event, its response comes in the next one
+#define TEST_ATT_RTT                (2 * TEST_CON_INTV)
+/// Timer of the GATT task sending the response
+#define TEST_GATT_RSP_TIMER         (GATT_CMP_EVT + 0x40)
+/// Bytes the prepare queue of the peer holds
+#define TEST_PREP_QUEUE             600
+/// Prepare Write requests the queue of the peer holds
+#define TEST_PREP_MAX               40
+/// Largest HID report of hogpd, HOGPD_REPORT_MAX_LEN
+#define TEST_REPORT_MAX_LEN         45
+
+/// Attributes of the peer
+enum
+{
+    TEST_ATT_NAME,
+    TEST_ATT_BIG,
+    TEST_ATT_REPORT,
+
+    TEST_ATT_NB,
+};
+
+/// Attribute of the peer
+struct test_att
+{
+    uint16_t handle;
+    /// Largest length of the value, the buffer of its server
+    uint16_t size;
+    uint16_t len;
+    uint8_t value[PRF_LONG_VALUE_MAX];
+    /// Write in progress and its buffer, as kept by a server
+    struct prf_long_wr wr;
+    uint8_t wr_buf[PRF_LONG_VALUE_MAX];
+};
+
+/// Prepare Write request waiting in the queue of the peer
+struct test_prep
+{
+    uint16_t handle;
+    uint16_t offset;
+    uint16_t len;
+    uint8_t value[ATT_DEFAULT_MTU - 5];
+};
+
+/*
+ * LOCAL VARIABLE DEFINITIONS
+ ****************************************************************************************
+ */
+
+static uint32_t test_fail;
+
+static ke_state_t test_app_state[1 + BLE_CONNECTION_MAX];
+static ke_state_t test_gatt_state[1];
+static ke_state_t test_client_state[1];
+
+static struct test_att test_att[TEST_ATT_NB];
+
+/// Link and peer state of the simulation
+static struct
+{
+    bool connected;
+    /// Response of the request in flight, sent once its PDUs have been exchanged
+    void *rsp;
+    ke_task_id_t rsp_dest;
+    /// ATT PDUs exchanged
+    uint32_t pdu;
+    /// Prepare queue of the peer, its bytes and their limit
+    struct test_prep prep[TEST_PREP_MAX];
+    uint8_t prep_nb;
+    uint16_t prep_bytes;
+    uint16_t prep_room;
+    /// Requests seen while one was in flight
+    uint32_t overlap;
+} test_link;
+
+/// Response received by the client
+static struct
+{
+    bool rcvd;
+    bool write;
+    uint8_t status;
+    uint16_t len;
+    uint8_t value[PRF_LONG_VALUE_MAX];
+    /// Time it came (unit: 10ms)
+    uint32_t time;
+} test_rsp;
+
+/// Heap: ke_malloc() blocks live, bytes of the largest block or read response allocated
+static uint32_t test_malloc_live;
+static uint32_t test_buf_max;
+
+/*
+ * GLOBAL VARIABLE DEFINITIONS
+ ****************************************************************************************
+ */
+
+struct app_env_tag app_env;
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+#define TEST_CHECK(cond, ...)                                                       \
+    do {                                                                            \
+        if (!(cond))                                                                \
+        {                                                                           \
+            if (test_fail < 20)                                                     \
+            {                                                                       \
+                printf("%s:%d: %s: ", __FILE__, __LINE__, #cond);                   \
+                printf(__VA_ARGS__);                                                \
+                printf("\n");                                                       \
+            }                                                                       \
+            test_fail++;                                                            \
+        }                                                                           \
+    } while (0)
+
+void app_task_msg_hdl(ke_msg_id_t const msgid, void const *param)
+{
+}
+
+uint8_t test_get_rec_idx(uint16_t conhdl)
+{
+    return (test_link.connected && (conhdl == TEST_CONHDL)) ? 0 : GAP_INVALID_CONIDX;
+}
+
+uint16_t test_get_mtu(uint8_t idx)
+{
+    return ATT_DEFAULT_MTU;
+}
+
+void *test_malloc(uint32_t size)
+{
+    test_malloc_live++;
+    if (size > test_buf_max)
+        test_buf_max = size;
+
+    return malloc(size);
+}
+
+void test_free(void *mem_ptr)
+{
+    test_malloc_live--;
+    free(mem_ptr);
+}
+
+void *test_msg_alloc(ke_msg_id_t const id, ke_task_id_t const dest_id, ke_task_id_t const src_id,
+                     uint16_t const param_len)
+{
+    // The response of a long read is allocated for the value when the read starts
+    if ((id == GATT_READ_CHAR_RESP) && (src_id == TASK_GATT) && (dest_id == TASK_PRF1)
+     && (param_len > test_buf_max))
+        test_buf_max = param_len;
+
+    return ke_host_msg_alloc(id, dest_id, src_id, param_len);
+}
+
+static uint32_t test_rand(void)
+{
+    static uint32_t x = 2463534242UL;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+
+    return x;
+}
+
+static void test_att_fill(struct test_att *att, uint16_t len)
+{
+    att->len = len;
+    for (uint16_t i = 0; i < len; i++)
+    {
+        att->value[i] = (uint8_t)test_rand();
+    }
+}
+
+static struct test_att *test_att_find(uint16_t handle)
+{
+    for (uint8_t i = 0; i < TEST_ATT_NB; i++)
+    {
+        if (test_att[i].handle == handle)
+        {
+            return &test_att[i];
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * PEER AND GATT, one ATT request at a time
+ ****************************************************************************************
+ */
+
+/// ROM long read at an offset: blobs until a short one or ATTM_MAX_LONG_VALUE bytes
+static void *test_gatt_read_long(struct gatt_read_char_req const *rd, uint32_t *pdu)
+{
+    struct test_att const *att = test_att_find(co_read16p(&rd->uuid[0].value[0]));
+    struct gatt_read_char_resp *rsp;
+    uint16_t len = 0;
+    uint8_t status = ATT_ERR_NO_ERROR;
+
+    if (att == NULL)
+        status = ATT_ERR_INVALID_HANDLE;
+    else if (rd->offset > att->len)
+        status = ATT_ERR_INVALID_OFFSET;
+    else
+        len = (att->len - rd->offset < ATTM_MAX_LONG_VALUE) ? att->len - rd->offset : ATTM_MAX_LONG_VALUE;
+
+    // The last blob is short, or empty, unless the segment is full
+    *pdu = (status != ATT_ERR_NO_ERROR) ? 1
+         : (len == ATTM_MAX_LONG_VALUE) ? (len + ATT_DEFAULT_MTU - 2) / (ATT_DEFAULT_MTU - 1)
+         : len / (ATT_DEFAULT_MTU - 1) + 1;
+
+    rsp = KE_MSG_ALLOC_DYN(GATT_READ_CHAR_RESP, test_link.rsp_dest, TASK_GATT, gatt_read_char_resp, len);
+    rsp->status = status;
+    rsp->data.len = len;
+    rsp->data.each_len = len;
+    if (len != 0)
+        memcpy(&rsp->data.data[0], &att->value[rd->offset], len);
+
+    return rsp;
+}
+
+/// Executed prepared writes go to the server one by one, the last flagged
+static uint8_t test_peer_execute(void)
+{
+    struct gatt_write_cmd_ind ind;
+    uint8_t status = ATT_ERR_NO_ERROR;
+
+    for (uint8_t i = 0; i < test_link.prep_nb; i++)
+    {
+        struct test_prep const *prep = &test_link.prep[i];
+        struct test_att *att = test_att_find(prep->handle);
+        uint8_t *value;
+        uint16_t length;
+
+        ind.conhdl = TEST_CONHDL;
+        ind.handle = prep->handle;
+        ind.length = prep->len;
+        ind.offset = prep->offset;
+        ind.response = 1;
+        ind.last = (i == test_link.prep_nb - 1);
+        memcpy(&ind.value[0], &prep->value[0], prep->len);
+
+        status = prf_long_wr_ind(&att->wr, att->wr_buf, att->size, &ind, &value, &length);
+        if (value != NULL)
+        {
+            memcpy(&att->value[0], value, length);
+            att->len = length;
+        }
+    }
+
+    test_link.prep_nb = 0;
+    test_link.prep_bytes = 0;
+
+    return status;
+}
+
+/// ROM long write: Prepare Write requests, then the Execute Write request if asked
+static void *test_gatt_write_long(struct gatt_write_char_req const *wr, uint32_t *pdu)
+{
+    struct gatt_write_char_resp *rsp = KE_MSG_ALLOC(GATT_WRITE_CHAR_RESP, test_link.rsp_dest, TASK_GATT,
+                                                    gatt_write_char_resp);
+    uint16_t done = 0;
+
+    rsp->status = (test_att_find(wr->charhdl) != NULL) ? ATT_ERR_NO_ERROR : ATT_ERR_INVALID_HANDLE;
+    *pdu = 0;
+    while ((rsp->status == ATT_ERR_NO_ERROR) && (done < wr->val_len))
+    {
+        struct test_prep *prep = &test_link.prep[test_link.prep_nb];
+        uint16_t len = (wr->val_len - done < ATT_DEFAULT_MTU - 5) ? wr->val_len - done : ATT_DEFAULT_MTU - 5;
+
+        (*pdu)++;
+        if ((test_link.prep_nb == TEST_PREP_MAX) || (test_link.prep_bytes + len > test_link.prep_room))
+        {
+            rsp->status = ATT_ERR_PREPARE_QUEUE_FULL;
+            break;
+        }
+
+        prep->handle = wr->charhdl;
+        prep->offset = wr->wr_offset + done;
+        prep->len = len;
+        memcpy(&prep->value[0], &wr->value[done], len);
+        test_link.prep_nb++;
+        test_link.prep_bytes += len;
+        done += len;
+    }
+
+    if ((rsp->status == ATT_ERR_NO_ERROR) && wr->auto_execute)
+    {
+        (*pdu)++;
+        rsp->status = test_peer_execute();
+    }
+
+    return rsp;
+}
+
+/// Request of the queue, run on the peer at once and answered after its PDUs
+static int test_gatt_req(ke_msg_id_t const msgid, void const *param,
+                         ke_task_id_t const dest_id, ke_task_id_t const src_id)
+{
+    uint32_t pdu = 1;
+
+    if (test_link.rsp != NULL)
+    {
+        test_link.overlap++;
+        return (KE_MSG_CONSUMED);
+    }
+
+    test_link.rsp_dest = src_id;
+    if (msgid == GATT_READ_CHAR_REQ)
+    {
+        test_link.rsp = test_gatt_read_long(param, &pdu);
+    }
+    else if (msgid == GATT_WRITE_CHAR_REQ)
+    {
+        test_link.rsp = test_gatt_write_long(param, &pdu);
+    }
+    else
+    {
+        // Execute Write request cancelling the queue of the peer
+        test_link.prep_nb = 0;
+        test_link.prep_bytes = 0;
+        test_link.rsp = ke_msg_alloc(GATT_CANCEL_WRITE_CHAR_RESP, src_id, TASK_GATT, 0);
+    }
+    test_link.pdu += pdu;
+    ke_timer_set(TEST_GATT_RSP_TIMER, TASK_GATT, pdu * TEST_ATT_RTT);
+
+    return (KE_MSG_CONSUMED);
+}
+
+static int test_gatt_rsp_timer(ke_msg_id_t const msgid, void const *param,
+                               ke_task_id_t const dest_id, ke_task_id_t const src_id)
+{
+    struct gatt_cmp_evt *cmp;
+
+    ke_msg_send(test_link.rsp);
+    test_link.rsp = NULL;
+
+    // The GATT ends each request with its complete event
+    cmp = KE_MSG_ALLOC(GATT_CMP_EVT, test_link.rsp_dest, TASK_GATT, gatt_cmp_evt);
+    cmp->status = ATT_ERR_NO_ERROR;
+    ke_msg_send(cmp);
+
+    return (KE_MSG_CONSUMED);
+}
+
+static const struct ke_msg_handler test_gatt_default_state[] =
+{
+    {GATT_READ_CHAR_REQ,            (ke_msg_func_t)test_gatt_req},
+    {GATT_WRITE_CHAR_REQ,           (ke_msg_func_t)test_gatt_req},
+    {GATT_EXECUTE_WRITE_CHAR_REQ,   (ke_msg_func_t)test_gatt_req},
+    {TEST_GATT_RSP_TIMER,           (ke_msg_func_t)test_gatt_rsp_timer},
+};
+
+static const struct ke_state_handler test_gatt_default = KE_STATE_HANDLER(test_gatt_default_state);
+
+/*
+ * APPLICATION AND CLIENT
+ ****************************************************************************************
+ */
+
+static int test_app_gatt_rsp(ke_msg_id_t const msgid, void const *param,
+                             ke_task_id_t const dest_id, ke_task_id_t const src_id)
+{
+    TEST_CHECK(prf_gattq_rsp(msgid, param, dest_id), "response %04x to the application", msgid);
+
+    return (KE_MSG_CONSUMED);
+}
+
+static const struct ke_msg_handler test_app_default_state[] =
+{
+    {GATT_READ_CHAR_RESP,           (ke_msg_func_t)test_app_gatt_rsp},
+    {GATT_WRITE_CHAR_RESP,          (ke_msg_func_t)test_app_gatt_rsp},
+    {GATT_CANCEL_WRITE_CHAR_RESP,   (ke_msg_func_t)test_app_gatt_rsp},
+    {GATT_CMP_EVT,                  (ke_msg_func_t)test_app_gatt_rsp},
+};
+
+static const struct ke_state_handler test_app_default = KE_STATE_HANDLER(test_app_default_state);
+
+static int test_client_read_rsp(ke_msg_id_t const msgid, struct gatt_read_char_resp const *param,
+                                ke_task_id_t const dest_id, ke_task_id_t const src_id)
+{
+    TEST_CHECK(!test_rsp.rcvd, "second response");
+    test_rsp.rcvd = true;
+    test_rsp.write = false;
+    test_rsp.status = param->status;
+    test_rsp.len = param->data.len;
+    memcpy(&test_rsp.value[0], &param->data.data[0], param->data.len);
+    test_rsp.time = ke_host_time();
+
+    return (KE_MSG_CONSUMED);
+}
+
+static int test_client_write_rsp(ke_msg_id_t const msgid, struct gatt_write_char_resp const *param,
+                                 ke_task_id_t const dest_id, ke_task_id_t const src_id)
+{
+    TEST_CHECK(!test_rsp.rcvd, "second response");
+    test_rsp.rcvd = true;
+    test_rsp.write = true;
+    test_rsp.status = param->status;
+    test_rsp.time = ke_host_time();
+
+    return (KE_MSG_CONSUMED);
+}
+
+static const struct ke_msg_handler test_client_default_state[] =
+{
+    {GATT_READ_CHAR_RESP,           (ke_msg_func_t)test_client_read_rsp},
+    {GATT_WRITE_CHAR_RESP,          (ke_msg_func_t)test_client_write_rsp},
+};
+
+static const struct ke_state_handler test_client_default = KE_STATE_HANDLER(test_client_default_state);
+
+/*
+ * SIMULATION
+ ****************************************************************************************
+ */
+
+static void test_init(void)
+{
+    struct ke_task_desc app_desc = {NULL, &test_app_default, test_app_state, 1, 1 + BLE_CONNECTION_MAX};
+    struct ke_task_desc gatt_desc = {NULL, &test_gatt_default, test_gatt_state, 1, 1};
+    struct ke_task_desc client_desc = {NULL, &test_client_default, test_client_state, 1, 1};
+
+    ke_host_init();
+    task_desc_register(TASK_APP, app_desc);
+    task_desc_register(TASK_GATT, gatt_desc);
+    task_desc_register(TASK_PRF1, client_desc);
+
+    memset(&prf_gattq_env, 0, sizeof(prf_gattq_env));
+    memset(&prf_gattq_stat, 0, sizeof(prf_gattq_stat));
+    memset(&test_link, 0, sizeof(test_link));
+    test_link.connected = true;
+    test_link.prep_room = TEST_PREP_QUEUE;
+
+    // Device Name of a peer, a value of the largest length, a HID report
+    memset(test_att, 0, sizeof(test_att));
+    test_att[TEST_ATT_NAME].handle = 0x0003;
+    test_att[TEST_ATT_NAME].size = APP_PEER_NAME_MAX;
+    test_att[TEST_ATT_BIG].handle = 0x0020;
+    test_att[TEST_ATT_BIG].size = PRF_LONG_VALUE_MAX;
+    test_att[TEST_ATT_REPORT].handle = 0x0030;
+    test_att[TEST_ATT_REPORT].size = TEST_REPORT_MAX_LEN;
+}
+
+static void test_start(void)
+{
+    memset(&test_rsp, 0, sizeof(test_rsp));
+    test_buf_max = 0;
+    test_link.pdu = 0;
+}
+
+/// Nothing is left once an operation ended
+static void test_idle_check(char const *name)
+{
+    TEST_CHECK(test_malloc_live == 0, "%s: %u blocks left", name, test_malloc_live);
+    TEST_CHECK(ke_host_msg_live() == 0, "%s: %u messages left", name, ke_host_msg_live());
+    TEST_CHECK(ke_host_msg_lost() == 0, "%s: %u messages lost", name, ke_host_msg_lost());
+    TEST_CHECK(prf_gattq_env.cnt[0] == 0, "%s: %u left in the queue", name, prf_gattq_env.cnt[0]);
+    TEST_CHECK(test_link.overlap == 0, "%s: %u requests while one in flight", name, test_link.overlap);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Read of a value of len bytes with a buffer of max_len bytes.
+ ****************************************************************************************
+ */
+static void test_read(char const *name, uint8_t att_idx, uint16_t len, uint16_t max_len)
+{
+    struct test_att *att = &test_att[att_idx];
+    uint32_t start = ke_host_time();
+    uint16_t expect = (len < max_len) ? len : max_len;
+
+    test_att_fill(att, len);
+    test_start();
+    TEST_CHECK(prf_gattq_read_long(TASK_PRF1, TEST_CONHDL, att->handle, max_len), "%s: not queued", name);
+    ke_host_run(start + 2000);
+
+    TEST_CHECK(test_rsp.rcvd && !test_rsp.write, "%s: no response", name);
+    TEST_CHECK(test_rsp.status == ((len > max_len) ? ATT_ERR_INVALID_ATTRIBUTE_VAL_LEN : ATT_ERR_NO_ERROR),
+               "%s: status %02x", name, test_rsp.status);
+    TEST_CHECK((test_rsp.len == expect) && (memcmp(&test_rsp.value[0], &att->value[0], expect) == 0),
+               "%s: value of %u bytes", name, test_rsp.len);
+    TEST_CHECK(test_buf_max <= sizeof(struct gatt_read_char_resp) + max_len, "%s: %u bytes allocated", name,
+               test_buf_max);
+    test_idle_check(name);
+
+    printf("%-22s %6u %8u %8u %8u %10u\n", name, len, test_link.pdu, prf_gattq_stat.seg,
+           (test_rsp.time - start) * 10, test_buf_max);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Write of a value of len bytes, its status expected.
+ ****************************************************************************************
+ */
+static void test_write(char const *name, uint8_t att_idx, uint16_t len, uint8_t status)
+{
+    struct test_att *att = &test_att[att_idx];
+    uint8_t value[PRF_LONG_VALUE_MAX], old[PRF_LONG_VALUE_MAX];
+    uint16_t old_len = att->len;
+    uint32_t start = ke_host_time();
+
+    memcpy(old, att->value, sizeof(old));
+    for (uint16_t i = 0; i < len; i++)
+    {
+        value[i] = (uint8_t)test_rand();
+    }
+    test_start();
+    prf_gattq_stat.seg = 0;
+    TEST_CHECK(prf_gattq_write_long(TASK_PRF1, TEST_CONHDL, att->handle, value, len), "%s: not queued", name);
+    ke_host_run(start + 2000);
+
+    TEST_CHECK(test_rsp.rcvd && test_rsp.write, "%s: no response", name);
+    TEST_CHECK(test_rsp.status == status, "%s: status %02x", name, test_rsp.status);
+    if (status == ATT_ERR_NO_ERROR)
+    {
+        TEST_CHECK((att->len == len) && (memcmp(&att->value[0], value, len) == 0), "%s: value not written",
+                   name);
+    }
+    else
+    {
+        // All or nothing
+        TEST_CHECK((att->len == old_len) && (memcmp(&att->value[0], old, old_len) == 0), "%s: value changed",
+                   name);
+    }
+    TEST_CHECK(test_link.prep_nb == 0, "%s: %u writes prepared on the peer", name, test_link.prep_nb);
+    TEST_CHECK(test_buf_max == len, "%s: %u bytes allocated", name, test_buf_max);
+    test_idle_check(name);
+
+    printf("%-22s %6u %8u %8u %8u %10u\n", name, len, test_link.pdu, prf_gattq_stat.seg,
+           (test_rsp.time - start) * 10, test_buf_max);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Reads and writes at MTU 23, PDUs, segments, time and heap taken.
+ ****************************************************************************************
+ */
+static void test_bench(void)
+{
+    test_init();
+
+    printf("MTU %u, %u ms per ATT exchange\n", ATT_DEFAULT_MTU, TEST_ATT_RTT * 10);
+    printf("%-22s %6s %8s %8s %8s %10s\n", "", "bytes", "PDUs", "segments", "ms", "heap B");
+
+    prf_gattq_stat.seg = 0;
+    test_read("read device name", TEST_ATT_NAME, 100, APP_PEER_NAME_MAX);
+    prf_gattq_stat.seg = 0;
+    test_read("read device name max", TEST_ATT_NAME, APP_PEER_NAME_MAX, APP_PEER_NAME_MAX);
+    prf_gattq_stat.seg = 0;
+    test_read("read 512", TEST_ATT_BIG, PRF_LONG_VALUE_MAX, PRF_LONG_VALUE_MAX);
+    prf_gattq_stat.seg = 0;
+    test_read("read 510 of 4 segments", TEST_ATT_BIG, 3 * ATTM_MAX_LONG_VALUE, PRF_LONG_VALUE_MAX);
+    test_write("write 512", TEST_ATT_BIG, PRF_LONG_VALUE_MAX, ATT_ERR_NO_ERROR);
+    test_write("write report 45", TEST_ATT_REPORT, TEST_REPORT_MAX_LEN, ATT_ERR_NO_ERROR);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Errors: the value is dropped and the buffers are released.
+ ****************************************************************************************
+ */
+static void test_errors(void)
+{
+    test_init();
+
+    // A name longer than the buffer is cut and reported
+    prf_gattq_stat.seg = 0;
+    test_read("read name 300 in 248", TEST_ATT_NAME, 300, APP_PEER_NAME_MAX);
+
+    // The server refuses a report longer than its own buffer
+    test_write("write report 60", TEST_ATT_REPORT, 60, ATT_ERR_INVALID_ATTRIBUTE_VAL_LEN);
+
+    // The queue of the peer is full in the third segment, the first ones are cancelled
+    test_link.prep_room = 400;
+    test_write("write 512, queue 400", TEST_ATT_BIG, PRF_LONG_VALUE_MAX, ATT_ERR_PREPARE_QUEUE_FULL);
+    test_link.prep_room = TEST_PREP_QUEUE;
+
+    // Nothing is queued beyond the largest value or without a connection
+    TEST_CHECK(!prf_gattq_read_long(TASK_PRF1, TEST_CONHDL, 0x0020, PRF_LONG_VALUE_MAX + 1), "read over 512");
+    TEST_CHECK(!prf_gattq_write_long(TASK_PRF1, TEST_CONHDL, 0x0020, test_att[0].value, PRF_LONG_VALUE_MAX + 1),
+               "write over 512");
+    TEST_CHECK(!prf_gattq_read_long(TASK_PRF1, TEST_CONHDL + 1, 0x0020, 10), "read without a connection");
+    test_idle_check("refused");
+}
+
+/**
+ ****************************************************************************************
+ * @brief Disconnection in the middle of a long read and of a long write.
+ ****************************************************************************************
+ */
+static void test_disconnect(void)
+{
+    uint8_t value[PRF_LONG_VALUE_MAX] = {0};
+
+    for (uint8_t write = 0; write < 2; write++)
+    {
+        test_init();
+        test_att_fill(&test_att[TEST_ATT_BIG], PRF_LONG_VALUE_MAX);
+        test_start();
+        if (write)
+            TEST_CHECK(prf_gattq_write_long(TASK_PRF1, TEST_CONHDL, 0x0020, value, PRF_LONG_VALUE_MAX), "write");
+        else
+            TEST_CHECK(prf_gattq_read_long(TASK_PRF1, TEST_CONHDL, 0x0020, PRF_LONG_VALUE_MAX), "read");
+
+        // First segment answered, the second one in flight
+        ke_host_run(ke_host_time() + 10 * TEST_ATT_RTT);
+        TEST_CHECK((prf_gattq_stat.seg == 2) && (test_link.rsp != NULL), "disconnect %u: %u segments", write,
+                   prf_gattq_stat.seg);
+
+        // Its response comes late, the queue drops it
+        test_link.connected = false;
+        prf_dispatch_disconnect(CO_ERROR_NO_ERROR, CO_ERROR_CON_TIMEOUT, TEST_CONHDL, 0);
+        ke_host_run(ke_host_time() + 1000);
+
+        TEST_CHECK(!test_rsp.rcvd, "disconnect %u: response after the disconnection", write);
+        TEST_CHECK(test_malloc_live == 0, "disconnect %u: %u blocks left", write, test_malloc_live);
+        TEST_CHECK(ke_host_msg_live() == 0, "disconnect %u: %u messages left", write, ke_host_msg_live());
+        TEST_CHECK(prf_gattq_env.long_op[0].handle == ATT_INVALID_HANDLE, "disconnect %u: long operation kept",
+                   write);
+    }
+}
+
+/**
+ ****************************************************************************************
+ * @brief Server side: fragments out of order or beyond the buffer drop the whole value.
+ ****************************************************************************************
+ */
+static void test_server(void)
+{
+    struct prf_long_wr wr = {0};
+    struct gatt_write_cmd_ind ind = {0};
+    uint8_t buf[TEST_REPORT_MAX_LEN];
+    uint8_t *value;
+    uint16_t length;
+    uint8_t status;
+
+    ind.conhdl = TEST_CONHDL;
+    ind.handle = 0x0030;
+    ind.length = 18;
+    memset(&ind.value[0], 0x5a, ind.length);
+
+    // In order, 18 + 18 + 9 bytes
+    status = prf_long_wr_ind(&wr, buf, sizeof(buf), &ind, &value, &length);
+    TEST_CHECK((status == ATT_ERR_NO_ERROR) && (value == NULL), "first: %02x", status);
+    ind.offset = 18;
+    prf_long_wr_ind(&wr, buf, sizeof(buf), &ind, &value, &length);
+    ind.offset = 36;
+    ind.length = 9;
+    ind.last = true;
+    status = prf_long_wr_ind(&wr, buf, sizeof(buf), &ind, &value, &length);
+    TEST_CHECK((status == ATT_ERR_NO_ERROR) && (value == buf) && (length == 45), "last: %02x %u", status, length);
+
+    // A gap
+    ind.offset = 0;
+    ind.length = 18;
+    ind.last = false;
+    prf_long_wr_ind(&wr, buf, sizeof(buf), &ind, &value, &length);
+    ind.offset = 20;
+    ind.last = true;
+    status = prf_long_wr_ind(&wr, buf, sizeof(buf), &ind, &value, &length);
+    TEST_CHECK((status == ATT_ERR_INVALID_OFFSET) && (value == NULL), "gap: %02x", status);
+
+    // Another attribute in the middle
+    ind.offset = 0;
+    ind.last = false;
+    prf_long_wr_ind(&wr, buf, sizeof(buf), &ind, &value, &length);
+    ind.offset = 18;
+    ind.handle = 0x0031;
+    ind.last = true;
+    status = prf_long_wr_ind(&wr, buf, sizeof(buf), &ind, &value, &length);
+    TEST_CHECK((status == ATT_ERR_INVALID_OFFSET) && (value == NULL), "handle: %02x", status);
+
+    // One byte beyond the buffer
+    ind.handle = 0x0030;
+    ind.offset = 0;
+    ind.length = 18;
+    ind.last = false;
+    prf_long_wr_ind(&wr, buf, sizeof(buf), &ind, &value, &length);
+    ind.offset = 18;
+    prf_long_wr_ind(&wr, buf, sizeof(buf), &ind, &value, &length);
+    ind.offset = 36;
+    ind.length = 10;
+    ind.last = true;
+    status = prf_long_wr_ind(&wr, buf, sizeof(buf), &ind, &value, &length);
+    TEST_CHECK((status == ATT_ERR_INVALID_ATTRIBUTE_VAL_LEN) && (value == NULL), "overflow: %02x", status);
+}
+
+int main(void)
+{
+    test_bench();
+    test_errors();
+    test_disconnect();
+    test_server();
+
+    printf("long: %s (%u failures)\n", test_fail ? "FAIL" : "OK", test_fail);
+
+    return test_fail ? 1 : 0;
+}
@@ -0,0 +1,357 @@
+/**
+ ****************************************************************************************
+ *
+ * @file test_oled.c
+ *
+ * @brief Host benchmark of the OLED frame buffer of oled.c on a mock of its bus.
+ *
+ * The driver is built for the SPI bus (CFG_SPI_OLED) or for the bit-banged I2C bus
+ * (CFG_IIC_OLED). The mock decodes what reaches the bus into a model of the SSD1306:
+ * the transactions and bytes of the screens the demo draws are counted and compared
+ * with the single byte transfers the driver made before the frame buffer, and after
+ * each refresh the RAM of the panel must be the frame buffer.
+ *
+ * Copyright(C) 2015 NXP Semiconductors N.V.
+ * All rights reserved.
+ *
+ * $Rev: $
+ *
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "app_env.h"
+#include "lib.h"
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// Slave address and control bytes of the SSD1306 on I2C, Co=0
+#define TEST_I2C_ADDR               0x78
+#define TEST_I2C_CMD                0x00
+#define TEST_I2C_DATA               0x40
+
+/// Counter updates of the benchmark
+#define TEST_COUNT_NB               100
+
+/*
+ * OLED DRIVER, on the bus model of the test
+ ****************************************************************************************
+ */
+
+#if (FB_SPI_OLED)
+/// SPI1 is not part of the host driver configuration, the test is the SPI driver
+typedef struct test_spi QN_SPI_TypeDef;
+
+#define QN_SPI1                     ((QN_SPI_TypeDef *)0)
+#define SPI_MASK_BUSY               0x01000000
+#define SPI_MASK_TX_FIFO_EMPT       0x00000008
+
+uint32_t spi_spi_GetSR(QN_SPI_TypeDef *SPI);
+void spi_write(QN_SPI_TypeDef *SPI, uint8_t *bufptr, int32_t size, void (*tx_callback)(void));
+#endif
+
+#define syscon_SetPMCR0WithMask(syscon, mask, value)
+#define delay(dly)
+
+#include "../src/qnevb/oled.c"
+
+/*
+ * LOCAL VARIABLE DEFINITIONS
+ ****************************************************************************************
+ */
+
+static uint32_t test_fail;
+
+/// SSD1306 model, in page addressing mode
+static struct
+{
+    uint8_t ram[OLED_PAGE_NUM][X_WIDTH];
+    uint8_t page;
+    uint8_t col;
+    /// Argument bytes the last command still takes
+    uint8_t arg;
+    bool on;
+    bool pump;
+    uint8_t last_cmd;
+} test_panel;
+
+/// Bus traffic
+static struct
+{
+    uint32_t xfer;
+    uint32_t bytes;
+} test_bus;
+
+/// Pins driven by the driver
+static uint32_t test_pin;
+
+#if (FB_IIC_OLED)
+/// I2C decoder
+static struct
+{
+    bool active;
+    uint8_t bit_nb;
+    uint8_t byte;
+    uint32_t idx;
+    bool data;
+} test_i2c;
+#endif
+
+/*
+ * GLOBAL VARIABLE DEFINITIONS
+ ****************************************************************************************
+ */
+
+struct app_env_tag app_env;
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+#define TEST_CHECK(cond, ...)                                                       \
+    do {                                                                            \
+        if (!(cond))                                                                \
+        {                                                                           \
+            if (test_fail < 20)                                                     \
+            {                                                                       \
+                printf("%s:%d: %s: ", __FILE__, __LINE__, #cond);                   \
+                printf(__VA_ARGS__);                                                \
+                printf("\n");                                                       \
+            }                                                                       \
+            test_fail++;                                                            \
+        }                                                                           \
+    } while (0)
+
+void app_task_msg_hdl(ke_msg_id_t const msgid, void const *param)
+{
+}
+
+/// Command byte received by the panel
+static void test_panel_cmd(uint8_t cmd)
+{
+    if (test_panel.arg)
+    {
+        test_panel.arg--;
+        if (test_panel.last_cmd == 0x8D)
+            test_panel.pump = (cmd == 0x14);
+        return;
+    }
+
+    test_panel.last_cmd = cmd;
+    if ((cmd & 0xF8) == 0xB0)
+        test_panel.page = cmd & 0x07;
+    else if (cmd <= 0x0F)
+        test_panel.col = (test_panel.col & 0xF0) | cmd;
+    else if (cmd <= 0x1F)
+        test_panel.col = (test_panel.col & 0x0F) | ((cmd & 0x0F) << 4);
+    else if (cmd == 0xAE || cmd == 0xAF)
+        test_panel.on = (cmd == 0xAF);
+    else if (cmd == 0x20 || cmd == 0x81 || cmd == 0x8D || cmd == 0xA8 || cmd == 0xD3 || cmd == 0xD5
+             || cmd == 0xD9 || cmd == 0xDA || cmd == 0xDB)
+        test_panel.arg = 1;
+}
+
+/// Display data byte received by the panel, the column wraps in page addressing mode
+static void test_panel_data(uint8_t data)
+{
+    test_panel.ram[test_panel.page][test_panel.col] = data;
+    test_panel.col = (test_panel.col + 1) % X_WIDTH;
+}
+
+#if (FB_SPI_OLED)
+uint32_t spi_spi_GetSR(QN_SPI_TypeDef *SPI)
+{
+    // The mock sends at once
+    return SPI_MASK_TX_FIFO_EMPT;
+}
+
+void spi_write(QN_SPI_TypeDef *SPI, uint8_t *bufptr, int32_t size, void (*tx_callback)(void))
+{
+    bool data = (test_pin & OLED_RS_PIN) != 0;
+
+    TEST_CHECK(!(test_pin & OLED_CS_PIN), "transfer without chip select");
+    test_bus.xfer++;
+    test_bus.bytes += size;
+    while (size--)
+    {
+        if (data)
+            test_panel_data(*bufptr++);
+        else
+            test_panel_cmd(*bufptr++);
+    }
+    tx_callback();
+}
+#endif
+
+#if (FB_IIC_OLED)
+/// Byte of an I2C transaction: the address, the control byte, then the stream
+static void test_i2c_byte(uint8_t byte)
+{
+    test_bus.bytes++;
+    if (test_i2c.idx == 0)
+        TEST_CHECK(byte == TEST_I2C_ADDR, "address %02x", byte);
+    else if (test_i2c.idx == 1)
+    {
+        TEST_CHECK(byte == TEST_I2C_CMD || byte == TEST_I2C_DATA, "control byte %02x", byte);
+        test_i2c.data = (byte == TEST_I2C_DATA);
+    }
+    else if (test_i2c.data)
+        test_panel_data(byte);
+    else
+        test_panel_cmd(byte);
+    test_i2c.idx++;
+}
+
+/// SDA changing while SCL is high is a start or a stop, SDA is sampled on the rise of SCL
+static void test_i2c_pins(uint32_t old, uint32_t pin)
+{
+    bool scl = pin & OLED_SCLK_PIN;
+    bool sda = pin & OLED_SDIN_PIN;
+
+    if (scl && (old & OLED_SCLK_PIN) && (sda != ((old & OLED_SDIN_PIN) != 0)))
+    {
+        if (!sda)
+        {
+            TEST_CHECK(!test_i2c.active, "repeated start");
+            test_bus.xfer++;
+            test_i2c.active = true;
+            test_i2c.idx = 0;
+            test_i2c.bit_nb = 0;
+        }
+        else
+        {
+            // SCL rises once, SDA low, before the stop
+            TEST_CHECK(test_i2c.active && test_i2c.bit_nb <= 1, "stop in a byte");
+            test_i2c.active = false;
+        }
+    }
+    else if (scl && !(old & OLED_SCLK_PIN) && test_i2c.active)
+    {
+        // The ninth clock is the acknowledge of the slave
+        if (++test_i2c.bit_nb == 9)
+        {
+            test_i2c.bit_nb = 0;
+            test_i2c_byte(test_i2c.byte);
+        }
+        else
+            test_i2c.byte = (test_i2c.byte << 1) | sda;
+    }
+}
+#endif
+
+void gpio_set_direction(enum gpio_pin pin, enum gpio_direction direction)
+{
+}
+
+void gpio_write_pin(enum gpio_pin pin, enum gpio_level level)
+{
+    uint32_t old = test_pin;
+
+    test_pin = level ? (test_pin | pin) : (test_pin & ~pin);
+#if (FB_IIC_OLED)
+    test_i2c_pins(old, test_pin);
+#else
+    (void)old;
+#endif
+}
+
+/// Bus traffic of a screen, its frame buffer must be on the panel
+static void test_screen(const char *name, uint32_t legacy)
+{
+#if (FB_IIC_OLED)
+    // A transfer of a byte was a transaction of the address, the control byte and the byte
+    uint32_t legacy_bytes = legacy * 3;
+#else
+    uint32_t legacy_bytes = legacy;
+#endif
+
+    TEST_CHECK(memcmp(test_panel.ram, oled_gram, sizeof(oled_gram)) == 0, "%s: panel differs", name);
+#if (FB_IIC_OLED)
+    TEST_CHECK(!test_i2c.active, "%s: no stop", name);
+#endif
+    for (uint8_t page = 0; page < OLED_PAGE_NUM; page++)
+        TEST_CHECK(oled_dirty_x0[page] > oled_dirty_x1[page], "%s: page %u still dirty", name, page);
+
+    if (legacy)
+        printf("%-18s %6u %7u %8u %8u %8.1f\n", name, test_bus.xfer, test_bus.bytes, legacy, legacy_bytes,
+               (double)legacy_bytes / test_bus.bytes);
+    else
+        printf("%-18s %6u %7u %8s %8s %8s\n", name, test_bus.xfer, test_bus.bytes, "-", "-", "-");
+    memset(&test_bus, 0, sizeof(test_bus));
+}
+
+int main(void)
+{
+    // A 8x16 character was two positions of 3 commands and 16 data bytes, a byte per transfer
+    const uint32_t legacy_char = 2 * 3 + 16;
+    // The page positions and the columns of the screen
+    const uint32_t legacy_clear = OLED_PAGE_NUM * (3 + X_WIDTH);
+    uint8_t col[16];
+
+    printf("%-18s %6s %7s %8s %8s %8s\n", FB_SPI_OLED ? "spi" : "i2c", "xfers", "bytes", "legacy", "bytes",
+           "gain");
+
+    test_pin = OLED_CS_PIN | OLED_SCLK_PIN | OLED_SDIN_PIN;
+    OLED_Init();
+    TEST_CHECK(test_panel.on && test_panel.pump, "panel not on");
+    test_screen("init", sizeof(oled_init_cmd) + legacy_clear);
+
+    OLED_ShowString(0, 0, (uint8_t *)"  Firefly Team  ");
+    OLED_Refresh_Gram();
+    TEST_CHECK(test_bus.xfer == 4, "title: %u transfers", test_bus.xfer);
+    test_screen("title", 16 * legacy_char);
+
+    // joysticks.c blanks the line before writing the key, one update now
+    OLED_ShowString(0, 4, (uint8_t *)"                ");
+    OLED_ShowString(0, 4, (uint8_t *)"    key_up!     ");
+    OLED_Refresh_Gram();
+    TEST_CHECK(test_bus.xfer == 4, "key: %u transfers", test_bus.xfer);
+    test_screen("key", 2 * 16 * legacy_char);
+
+    OLED_ShowString(0, 4, (uint8_t *)"                ");
+    OLED_Refresh_Gram();
+    test_screen("key cleared", 16 * legacy_char);
+
+    for (uint32_t n = 0; n < TEST_COUNT_NB; n++)
+    {
+        OLED_ShowNum(0, 6, n * 7, 5, 16);
+        OLED_Refresh_Gram();
+    }
+    test_screen("counter x100", TEST_COUNT_NB * 5 * legacy_char);
+
+    OLED_DrawPoint(100, 20, 1);
+    OLED_Refresh_Gram();
+    TEST_CHECK(oled_gram[2][100] & (1 << 4), "pixel not set");
+    test_screen("pixel", 0);
+
+    OLED_Fill(10, 10, 29, 49, 1);
+    OLED_Fill(15, 15, 24, 44, 0);
+    OLED_Refresh_Gram();
+    test_screen("frame", 0);
+
+    for (uint8_t i = 0; i < sizeof(col); i++)
+        col[i] = 0x81 + i;
+    OLED_DrawBMP(120, 7, 136, 8, col);
+    OLED_Refresh_Gram();
+    TEST_CHECK(oled_gram[7][127] == 0x88, "bitmap not clipped");
+    test_screen("clipped bitmap", 0);
+
+    OLED_Refresh_Gram();
+    TEST_CHECK(test_bus.xfer == 0, "%u transfers without a change", test_bus.xfer);
+    test_screen("unchanged", 0);
+
+    printf("oled %s: %s (%u failures)\n", FB_SPI_OLED ? "spi" : "i2c", test_fail ? "FAIL" : "OK", test_fail);
+
+    return test_fail ? 1 : 0;
+}
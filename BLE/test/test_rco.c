@@ -0,0 +1,492 @@
+/**
+ ****************************************************************************************
+ *
+ * @file test_rco.c
+ *
+ * @brief Host simulation of the 32k RCO calibration service.
+ *
+ * The calibration of app_sys.c runs on the host kernel. The ADC, the temperature sensor
+ * and the Timer1 capture are replaced by a model of an RCO whose error follows the
+ * temperature, measured with the quantization noise of a 128 cycle capture. The filter
+ * must follow the error closer than one capture, lengthen the period while the
+ * temperature holds and fall back to the fast period on a temperature step or a ramp.
+ * The passes must be put off while another user holds the ADC and must not hang when
+ * a user takes the ADC during a conversion. The passes and the error are compared with
+ * a capture every second without filter.
+ *
+ * Copyright(C) 2015 NXP Semiconductors N.V.
+ * All rights reserved.
+ *
+ * $Rev: $
+ *
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "app_env.h"
+#include "lib.h"
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// RCO error at 25 degree C and its temperature coefficient, in 2^-20 units
+#define TEST_RCO_ERR_25             300
+#define TEST_RCO_ERR_PER_C          40
+/// Capture noise, one 16MHz tick over 128 32k cycles is about 17 units
+#define TEST_RCO_NOISE              20
+/// Slope of the temperature sensor, ADC codes per degree C
+#define TEST_TEMP_CODE_PER_C        3.8
+
+/// Temperature profile of a run
+enum test_temp
+{
+    TEST_TEMP_STABLE,
+    TEST_TEMP_STEP,
+    TEST_TEMP_RAMP,
+};
+
+/*
+ * DRIVER DECLARATIONS, left out by the host driver configuration
+ ****************************************************************************************
+ */
+
+#define PM_MASK_TIMER1_ACTIVE_BIT   (0x00001000)
+
+#define FAC_CAL_TEMP                (25)
+#define TEMPERATURE_X10(adc_data)   ((int16_t)(((((adc_data) - TEMP_OFFSET) / 3.8) + FAC_CAL_TEMP) * 10))
+
+enum ADC_IN_MOD {ADC_DIFF_WITH_BUF_DRV};
+enum ADC_WORK_CLK {ADC_CLK_1000000};
+enum ADC_REF {ADC_INT_REF};
+enum ADC_RESOLUTION {ADC_12BIT};
+enum ADC_TRIG_SRC {ADC_TRIG_SOFT};
+enum ADC_WORK_MOD {CONTINUE_MOD};
+enum ADC_CH {TEMP};
+
+typedef struct
+{
+    enum ADC_TRIG_SRC trig_src;
+    enum ADC_WORK_MOD mode;
+    enum ADC_CH start_ch;
+    enum ADC_CH end_ch;
+} adc_read_configuration;
+
+struct timer_env_tag
+{
+    uint32_t count;
+};
+
+struct timer_env_tag timer1_env;
+int16_t TEMP_OFFSET = -200;
+
+static void dev_prevent_sleep(uint32_t dev_bf);
+static void dev_allow_sleep(uint32_t dev_bf);
+static bool adc_busy(void);
+static void adc_clock_off(void);
+static void adc_power_off(void);
+void adc_init(enum ADC_IN_MOD in_mod, enum ADC_WORK_CLK work_clk, enum ADC_REF ref_vol, enum ADC_RESOLUTION resolution);
+void adc_read(const adc_read_configuration *S, int16_t *buf, uint32_t samples, void (*callback)(void));
+void temp_sensor_enable(uint32_t able);
+void clock_32k_correction_start(uint32_t ncycle, void (*callback)(void));
+void clock_32k_correction_stop(void);
+int32_t clock_32k_correction_ppm(uint32_t count, uint32_t ncycle);
+void test_set_32k_ppm(int32_t ppm);
+
+#undef _set_32k_ppm
+#define _set_32k_ppm                test_set_32k_ppm
+
+#include "../src/app/app_sys.c"
+
+/*
+ * LOCAL VARIABLE DEFINITIONS
+ ****************************************************************************************
+ */
+
+static uint32_t test_fail;
+
+static ke_state_t test_app_state[1];
+
+/// Hardware model
+static struct
+{
+    /// Temperature profile and its start
+    enum test_temp profile;
+    uint32_t t0;
+    /// ADC clock on, conversions taken by another user
+    bool adc_on;
+    bool adc_steal;
+    /// Timer1 capture running, sleep prevented
+    bool capture;
+    uint32_t sleep_block;
+    /// Error given to the stack
+    int32_t ppm;
+    /// Passes done
+    uint32_t pass_nb;
+} test_hw;
+
+/*
+ * GLOBAL VARIABLE DEFINITIONS
+ ****************************************************************************************
+ */
+
+struct app_env_tag app_env;
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+#define TEST_CHECK(cond, ...)                                                       \
+    do {                                                                            \
+        if (!(cond))                                                                \
+        {                                                                           \
+            if (test_fail < 20)                                                     \
+            {                                                                       \
+                printf("%s:%d: %s: ", __FILE__, __LINE__, #cond);                   \
+                printf(__VA_ARGS__);                                                \
+                printf("\n");                                                       \
+            }                                                                       \
+            test_fail++;                                                            \
+        }                                                                           \
+    } while (0)
+
+static uint32_t test_rand(void)
+{
+    static uint32_t x = 2463534242UL;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+
+    return x;
+}
+
+void app_task_msg_hdl(ke_msg_id_t const msgid, void const *param)
+{
+}
+
+/// Temperature of the profile, in degree C
+static double test_temp_get(void)
+{
+    double min = (ke_host_time() - test_hw.t0) / 6000.0;
+
+    switch (test_hw.profile)
+    {
+    case TEST_TEMP_STEP:
+        // Out of the pocket onto a radiator after 20 minutes
+        return (min < 20) ? 25 : 45;
+    case TEST_TEMP_RAMP:
+        // Warms up by 1 degree a minute for 20 minutes
+        return 25 + ((min < 10) ? 0 : (min < 30) ? (min - 10) : 20);
+    default:
+        return 25;
+    }
+}
+
+/// Error of the RCO at the current temperature
+static int32_t test_rco_err(void)
+{
+    return TEST_RCO_ERR_25 + (int32_t)lround(TEST_RCO_ERR_PER_C * (test_temp_get() - 25));
+}
+
+static void dev_prevent_sleep(uint32_t dev_bf)
+{
+    test_hw.sleep_block |= dev_bf;
+}
+
+static void dev_allow_sleep(uint32_t dev_bf)
+{
+    test_hw.sleep_block &= ~dev_bf;
+}
+
+static bool adc_busy(void)
+{
+    return test_hw.adc_on;
+}
+
+static void adc_clock_off(void)
+{
+    test_hw.adc_on = false;
+}
+
+static void adc_power_off(void)
+{
+}
+
+void adc_init(enum ADC_IN_MOD in_mod, enum ADC_WORK_CLK work_clk, enum ADC_REF ref_vol, enum ADC_RESOLUTION resolution)
+{
+    TEST_CHECK(!test_hw.adc_on, "adc taken from its user");
+    test_hw.adc_on = true;
+}
+
+/// Convert the temperature at once, or lose the conversion to a user starting the ADC
+void adc_read(const adc_read_configuration *S, int16_t *buf, uint32_t samples, void (*callback)(void))
+{
+    double code = TEMP_OFFSET + (test_temp_get() - FAC_CAL_TEMP) * TEST_TEMP_CODE_PER_C;
+
+    if (test_hw.adc_steal)
+    {
+        return;
+    }
+    for (uint32_t i = 0; i < samples; i++)
+    {
+        buf[i] = (int16_t)lround(code + (int32_t)(test_rand() % 3) - 1);
+    }
+    callback();
+}
+
+void temp_sensor_enable(uint32_t able)
+{
+}
+
+void clock_32k_correction_start(uint32_t ncycle, void (*callback)(void))
+{
+    TEST_CHECK(test_hw.sleep_block & PM_MASK_TIMER1_ACTIVE_BIT, "capture while sleeping");
+    TEST_CHECK(!test_hw.adc_on || test_hw.adc_steal, "capture with the ADC on");
+    test_hw.capture = true;
+    callback();
+}
+
+void clock_32k_correction_stop(void)
+{
+    test_hw.capture = false;
+}
+
+/// Capture of the error with its quantization noise
+int32_t clock_32k_correction_ppm(uint32_t count, uint32_t ncycle)
+{
+    TEST_CHECK(ncycle == APP_RCO_CAL_CYCLES, "capture of %u cycles", ncycle);
+    test_hw.pass_nb++;
+
+    return test_rco_err() + (int32_t)(test_rand() % (2 * TEST_RCO_NOISE + 1)) - TEST_RCO_NOISE;
+}
+
+void test_set_32k_ppm(int32_t ppm)
+{
+    test_hw.ppm = ppm;
+}
+
+void rtc_calibration(uint8_t dir, uint16_t ppm)
+{
+}
+
+uint32_t rtc_rtc_GetSR(QN_RTC_TypeDef *RTC)
+{
+    return 0;
+}
+
+/// Calibration timer of the application task, see app_task.c
+static int test_rco_cal_timer_handler(ke_msg_id_t const msgid, void const *param,
+                                      ke_task_id_t const dest_id, ke_task_id_t const src_id)
+{
+    app_rco_cal_start();
+
+    return (KE_MSG_CONSUMED);
+}
+
+static const struct ke_msg_handler test_app_handler[] =
+{
+    {APP_SYS_RCO_CAL_TIMER,         (ke_msg_func_t) test_rco_cal_timer_handler},
+};
+
+static const struct ke_state_handler test_app_default = KE_STATE_HANDLER(test_app_handler);
+
+/**
+ ****************************************************************************************
+ * @brief Start the service with a temperature profile, the first pass after 1s like
+ * app_gap_task.c.
+ ****************************************************************************************
+ */
+static void test_start(enum test_temp profile)
+{
+    struct ke_task_desc app_desc = {NULL, &test_app_default, test_app_state, 1, 1};
+
+    ke_host_init();
+    task_desc_register(TASK_APP, app_desc);
+
+    memset(&test_hw, 0, sizeof(test_hw));
+    test_hw.profile = profile;
+    test_hw.t0 = ke_host_time();
+
+    app_rco_cal_init();
+    ke_timer_set(APP_SYS_RCO_CAL_TIMER, TASK_APP, 100);
+}
+
+/// Error of the calibration and of the RCO sampled every second
+struct test_track
+{
+    double sq_sum;
+    int32_t max;
+    uint32_t nb;
+};
+
+static void test_track_add(struct test_track *track, int32_t err)
+{
+    track->sq_sum += (double)err * err;
+    track->max = (abs(err) > track->max) ? abs(err) : track->max;
+    track->nb++;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Run an hour of a profile, the error given to the stack is sampled every second.
+ * The reference captures every second and gives the raw error.
+ ****************************************************************************************
+ */
+static void test_profile(enum test_temp profile, char const *name, int32_t max_err)
+{
+    struct test_track track = {0};
+    struct test_track ref = {0};
+    uint32_t end;
+
+    test_start(profile);
+    end = ke_host_time() + 60 * 60 * 100;
+    ke_host_run(ke_host_time() + 100);
+
+    while (ke_host_time() < end)
+    {
+        int32_t err = test_rco_err();
+        int32_t ref_raw = err + (int32_t)(test_rand() % (2 * TEST_RCO_NOISE + 1)) - TEST_RCO_NOISE;
+
+        ke_host_run(ke_host_time() + 100);
+        // The stack keeps the value until the next pass, a change is seen from the next one
+        test_track_add(&track, test_hw.ppm - test_rco_err());
+        test_track_add(&ref, ref_raw - err);
+
+        TEST_CHECK(test_hw.sleep_block == 0, "%s: sleep prevented between passes", name);
+        TEST_CHECK(!test_hw.capture && !test_hw.adc_on, "%s: hardware left on", name);
+    }
+
+    TEST_CHECK(track.max <= max_err, "%s: error up to %d", name, track.max);
+    TEST_CHECK(app_rco_cal_env.stat.count == test_hw.pass_nb, "%s: %u passes %u filtered",
+               name, test_hw.pass_nb, app_rco_cal_env.stat.count);
+    TEST_CHECK(ke_host_msg_lost() == 0, "%s: %u messages lost", name, ke_host_msg_lost());
+
+    printf("%-8s %10u %10.1f %8d %10u %10.1f %8d %8ds\n", name, test_hw.pass_nb,
+           sqrt(track.sq_sum / track.nb), track.max, ref.nb, sqrt(ref.sq_sum / ref.nb), ref.max,
+           app_rco_cal_env.stat.period / 100);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Stable temperature: the filter averages the noise out and the period grows to
+ * its maximum.
+ ****************************************************************************************
+ */
+static void test_stable(void)
+{
+    test_profile(TEST_TEMP_STABLE, "stable", TEST_RCO_NOISE);
+
+    TEST_CHECK(app_rco_cal_env.stat.period == APP_RCO_CAL_PERIOD_MAX, "stable: period %u",
+               app_rco_cal_env.stat.period);
+    // Less than one pass a minute once settled
+    TEST_CHECK(test_hw.pass_nb < 120, "stable: %u passes", test_hw.pass_nb);
+    TEST_CHECK(abs(app_rco_cal_env.stat.ppm - TEST_RCO_ERR_25) <= TEST_RCO_NOISE / 2,
+               "stable: filtered %d", app_rco_cal_env.stat.ppm);
+}
+
+/**
+ ****************************************************************************************
+ * @brief A temperature step restarts the filter at the fast period: the error is only
+ * large until the first pass after the step.
+ ****************************************************************************************
+ */
+static void test_step(void)
+{
+    test_profile(TEST_TEMP_STEP, "step", 20 * TEST_RCO_ERR_PER_C + TEST_RCO_NOISE);
+
+    TEST_CHECK(abs(app_rco_cal_env.stat.ppm - test_rco_err()) <= TEST_RCO_NOISE,
+               "step: filtered %d for %d", app_rco_cal_env.stat.ppm, test_rco_err());
+    TEST_CHECK(app_rco_cal_env.stat.temp_x10 >= 430, "step: temperature %d", app_rco_cal_env.stat.temp_x10);
+}
+
+/**
+ ****************************************************************************************
+ * @brief A slow ramp stays under the temperature step, the drift brings the period back
+ * to its minimum and the filter follows within a few captures.
+ ****************************************************************************************
+ */
+static void test_ramp(void)
+{
+    test_profile(TEST_TEMP_RAMP, "ramp", 2 * TEST_RCO_ERR_PER_C);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Another user holds the ADC: the passes wait for it and never take it.
+ ****************************************************************************************
+ */
+static void test_adc_busy(void)
+{
+    uint16_t count;
+
+    test_start(TEST_TEMP_STABLE);
+    ke_host_run(ke_host_time() + 150);
+    TEST_CHECK(app_rco_cal_env.stat.count == 1, "busy: %u passes", app_rco_cal_env.stat.count);
+
+    // held across the next pass
+    test_hw.adc_on = true;
+    count = app_rco_cal_env.stat.count;
+    ke_host_run(ke_host_time() + 10 * 100);
+    TEST_CHECK(app_rco_cal_env.stat.count == count, "busy: pass with the ADC held");
+    TEST_CHECK(app_rco_cal_env.stat.busy_cnt != 0, "busy: no pass put off");
+    TEST_CHECK(app_rco_cal_env.step == APP_RCO_CAL_IDLE, "busy: step %u", app_rco_cal_env.step);
+
+    // released, the pass comes within the retry delay
+    test_hw.adc_on = false;
+    ke_host_run(ke_host_time() + APP_RCO_CAL_RETRY);
+    TEST_CHECK(app_rco_cal_env.stat.count == count + 1, "busy: no pass after release");
+}
+
+/**
+ ****************************************************************************************
+ * @brief A user starts the ADC during a conversion: the pass times out and the next one
+ * runs once the user is done.
+ ****************************************************************************************
+ */
+static void test_adc_steal(void)
+{
+    uint16_t count;
+
+    test_start(TEST_TEMP_STABLE);
+    ke_host_run(ke_host_time() + 200);
+    count = app_rco_cal_env.stat.count;
+
+    test_hw.adc_steal = true;
+    ke_host_run(ke_host_time() + 10 * 100);
+    // timed out, then put off while the user holds the ADC
+    TEST_CHECK(app_rco_cal_env.step == APP_RCO_CAL_IDLE, "steal: step %u", app_rco_cal_env.step);
+    TEST_CHECK(app_rco_cal_env.stat.busy_cnt != 0, "steal: no pass put off");
+    TEST_CHECK(app_rco_cal_env.stat.count == count, "steal: pass without conversion");
+
+    // the user is done with the ADC
+    test_hw.adc_steal = false;
+    test_hw.adc_on = false;
+    ke_host_run(ke_host_time() + 2 * APP_RCO_CAL_RETRY);
+    TEST_CHECK(app_rco_cal_env.stat.count == count + 1, "steal: no pass after the timeout");
+    TEST_CHECK(app_rco_cal_env.step == APP_RCO_CAL_IDLE, "steal: step %u", app_rco_cal_env.step);
+}
+
+int main(void)
+{
+    printf("%-8s %10s %10s %8s %10s %10s %8s %9s\n", "profile", "passes", "rms", "max",
+           "1s passes", "1s rms", "1s max", "period");
+    test_stable();
+    test_step();
+    test_ramp();
+    test_adc_busy();
+    test_adc_steal();
+
+    printf("rco: %s (%u failures)\n", test_fail ? "FAIL" : "OK", test_fail);
+
+    return test_fail ? 1 : 0;
+}
@@ -0,0 +1,284 @@
+/**
+ ****************************************************************************************
+ *
+ * @file test_ring.c
+ *
+ * @brief Host stress test of the single producer, single consumer ring of ring.h.
+ *
+ * A producer thread and a consumer thread, standing for the interrupt handler and the
+ * background, pass numbered frames of random lengths through rings small enough to
+ * wrap and fill all the time, both with the copying calls and with the pointers a
+ * driver uses. Every frame must come out whole, in order and with its bytes, and the
+ * free running indices wrap many times during a run. The byte rate of the ring is
+ * measured on the largest ring.
+ *
+ * Copyright(C) 2015 NXP Semiconductors N.V.
+ * All rights reserved.
+ *
+ * $Rev: $
+ *
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "ring.h"
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// Frames passed per run
+#define TEST_FRAME_NB               400000
+/// Frame: length, sequence number on two bytes, payload
+#define TEST_FRAME_HDR_LEN          3
+#define TEST_FRAME_PAYL_MAX         60
+
+/*
+ * LOCAL VARIABLE DEFINITIONS
+ ****************************************************************************************
+ */
+
+static uint32_t test_fail;
+
+/// Run shared by the two threads
+static struct
+{
+    struct ring ring;
+    /// Producer fills frames behind ring_fill_ptr(), consumer reads them from ring_peek_ptr()
+    bool zero_copy;
+    /// Times a side found the ring full or empty
+    uint32_t full, empty;
+} test_run;
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+#define TEST_CHECK(cond, ...)                                                       \
+    do {                                                                            \
+        if (!(cond))                                                                \
+        {                                                                           \
+            if (test_fail < 20)                                                     \
+            {                                                                       \
+                printf("%s:%d: %s: ", __FILE__, __LINE__, #cond);                   \
+                printf(__VA_ARGS__);                                                \
+                printf("\n");                                                       \
+            }                                                                       \
+            test_fail++;                                                            \
+        }                                                                           \
+    } while (0)
+
+/// Byte i of the payload of frame seq
+static uint8_t test_byte(uint32_t seq, uint8_t i)
+{
+    return (uint8_t)(seq * 31 + i * 7);
+}
+
+/// Payload length of frame seq, the producer and the consumer agree on it
+static uint8_t test_len(uint32_t seq)
+{
+    uint32_t x = seq * 2654435761UL;
+
+    return (uint8_t)((x >> 16) % (TEST_FRAME_PAYL_MAX + 1));
+}
+
+/// Copy into the ring by the pointer of a driver, in two pieces when it wraps
+static void test_fill_ptr(struct ring *r, uint16_t off, uint8_t const *data, uint16_t len)
+{
+    while (len)
+    {
+        uint16_t room;
+        uint8_t *dst = ring_fill_ptr(r, off, &room);
+
+        if (room > len)
+            room = len;
+        for (uint16_t i = 0; i < room; i++)
+            dst[i] = data[i];
+        off += room;
+        data += room;
+        len -= room;
+    }
+}
+
+/// Interrupt handler side
+static void *test_producer(void *arg)
+{
+    struct ring *r = &test_run.ring;
+    uint8_t frame[TEST_FRAME_HDR_LEN + TEST_FRAME_PAYL_MAX];
+
+    for (uint32_t seq = 0; seq < TEST_FRAME_NB; seq++)
+    {
+        uint8_t len = test_len(seq);
+
+        frame[0] = len;
+        frame[1] = (uint8_t)seq;
+        frame[2] = (uint8_t)(seq >> 8);
+        for (uint8_t i = 0; i < len; i++)
+            frame[TEST_FRAME_HDR_LEN + i] = test_byte(seq, i);
+
+        while (ring_space(r) < TEST_FRAME_HDR_LEN + len)
+        {
+            test_run.full++;
+            sched_yield();
+        }
+
+        if (test_run.zero_copy)
+        {
+            // Payload first, as the EACI controller receives it, the header last
+            test_fill_ptr(r, TEST_FRAME_HDR_LEN, frame + TEST_FRAME_HDR_LEN, len);
+            ring_fill(r, 0, frame, TEST_FRAME_HDR_LEN);
+            ring_commit(r, TEST_FRAME_HDR_LEN + len);
+        }
+        else if (!ring_write(r, frame, TEST_FRAME_HDR_LEN + len))
+        {
+            TEST_CHECK(0, "frame %u does not fit", seq);
+        }
+    }
+
+    return NULL;
+}
+
+/// Background side
+static void *test_consumer(void *arg)
+{
+    struct ring *r = &test_run.ring;
+    uint8_t frame[TEST_FRAME_HDR_LEN + TEST_FRAME_PAYL_MAX];
+
+    for (uint32_t seq = 0; seq < TEST_FRAME_NB; seq++)
+    {
+        uint8_t len;
+
+        while (!ring_peek(r, 0, frame, TEST_FRAME_HDR_LEN))
+        {
+            test_run.empty++;
+            sched_yield();
+        }
+        len = frame[0];
+        // The whole frame is published at once
+        TEST_CHECK(ring_count(r) >= TEST_FRAME_HDR_LEN + len, "frame %u: %u of %u bytes", seq, ring_count(r),
+                   TEST_FRAME_HDR_LEN + len);
+        TEST_CHECK(len == test_len(seq) && (frame[1] | frame[2] << 8) == (uint16_t)seq,
+                   "frame %u: length %u, number %u", seq, len, frame[1] | frame[2] << 8);
+        if (len != test_len(seq))
+            break;
+
+        if (test_run.zero_copy)
+        {
+            uint8_t i = 0;
+
+            ring_skip(r, TEST_FRAME_HDR_LEN);
+            // As a driver transmits, in two pieces when it wraps
+            while (i < len)
+            {
+                uint16_t n;
+                uint8_t const *src = ring_peek_ptr(r, &n);
+
+                if (n > len - i)
+                    n = len - i;
+                for (uint16_t k = 0; k < n; k++)
+                    frame[TEST_FRAME_HDR_LEN + i + k] = src[k];
+                ring_skip(r, n);
+                i += n;
+            }
+        }
+        else if (!ring_read(r, frame, TEST_FRAME_HDR_LEN + len))
+        {
+            TEST_CHECK(0, "frame %u not ready", seq);
+        }
+
+        for (uint8_t i = 0; i < len; i++)
+        {
+            if (frame[TEST_FRAME_HDR_LEN + i] != test_byte(seq, i))
+            {
+                TEST_CHECK(0, "frame %u: byte %u is %02x", seq, i, frame[TEST_FRAME_HDR_LEN + i]);
+                break;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+static double test_elapsed_s(struct timespec const *t0)
+{
+    struct timespec t1;
+
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    return (t1.tv_sec - t0->tv_sec) + (t1.tv_nsec - t0->tv_nsec) * 1e-9;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Frames through a ring of size bytes, the producer and the consumer in threads.
+ ****************************************************************************************
+ */
+static void test_stress(uint16_t size, bool zero_copy)
+{
+    static uint8_t buf[4096];
+    pthread_t prod, cons;
+    struct timespec t0;
+    uint64_t bytes = 0;
+    double s;
+
+    for (uint32_t seq = 0; seq < TEST_FRAME_NB; seq++)
+        bytes += TEST_FRAME_HDR_LEN + test_len(seq);
+
+    ring_init(&test_run.ring, buf, size);
+    test_run.zero_copy = zero_copy;
+    test_run.full = test_run.empty = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    pthread_create(&cons, NULL, test_consumer, NULL);
+    pthread_create(&prod, NULL, test_producer, NULL);
+    pthread_join(prod, NULL);
+    pthread_join(cons, NULL);
+    s = test_elapsed_s(&t0);
+
+    TEST_CHECK(ring_count(&test_run.ring) == 0, "%u bytes left", ring_count(&test_run.ring));
+    TEST_CHECK(test_run.ring.head == (uint16_t)bytes, "head %u", test_run.ring.head);
+
+    printf("%5u %-9s %8u %9.1f %8u %8u %8.1f\n", size, zero_copy ? "pointer" : "copy", TEST_FRAME_NB,
+           bytes / 1048576.0, (uint32_t)(bytes >> 16), test_run.full + test_run.empty, bytes / s / 1048576.0);
+}
+
+int main(void)
+{
+    uint8_t buf[8];
+    struct ring r;
+
+    // Full and empty rings, a frame which does not fit is not written
+    ring_init(&r, buf, sizeof(buf));
+    TEST_CHECK(ring_space(&r) == 8 && ring_count(&r) == 0, "empty ring");
+    TEST_CHECK(!ring_write(&r, (uint8_t const *)"123456789", 9), "9 bytes in 8");
+    TEST_CHECK(ring_write(&r, (uint8_t const *)"12345678", 8) && ring_space(&r) == 0, "full ring");
+    TEST_CHECK(!ring_write(&r, (uint8_t const *)"9", 1), "byte in a full ring");
+    TEST_CHECK(!ring_peek(&r, 4, buf, 5), "peek past the end");
+    TEST_CHECK(ring_read(&r, buf, 8) && ring_count(&r) == 0, "ring not emptied");
+    TEST_CHECK(!ring_read(&r, buf, 1), "read of an empty ring");
+
+    printf("%5s %-9s %8s %9s %8s %8s %8s\n", "size", "access", "frames", "MiB", "wraps", "waits", "MiB/s");
+
+    // Rings barely larger than a frame wrap at almost every frame
+    test_stress(64, false);
+    test_stress(64, true);
+    test_stress(128, true);
+    test_stress(512, false);
+    test_stress(512, true);
+    test_stress(4096, false);
+
+    printf("ring: %s (%u failures)\n", test_fail ? "FAIL" : "OK", test_fail);
+
+    return test_fail ? 1 : 0;
+}
@@ -0,0 +1,479 @@
+/**
+ ****************************************************************************************
+ *
+ * @file test_rtc.c
+ *
+ * @brief Host test of the epoch clock of the RTC driver (rtc_epoch_*).
+ *
+ * The date conversions are checked against the C library on every day from 2000 to
+ * 2135, and on every date field the validation may reject. The drift correction runs on
+ * a simulated RTC counter whose 32k clock is off by a few tens of ppm, and is checked to
+ * converge to that error whatever the interval between the reference times. A benchmark
+ * measures the cost of the conversions.
+ *
+ * Copyright(C) 2015 NXP Semiconductors N.V.
+ * All rights reserved.
+ *
+ * $Rev: $
+ *
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "rtc.h"
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// Unix time of 2000-01-01 00:00:00
+#define TEST_UNIX_2000              946684800LL
+/// Conversions of the benchmark
+#define TEST_BENCH_NB               (1 << 22)
+
+/*
+ * LOCAL VARIABLE DEFINITIONS
+ ****************************************************************************************
+ */
+
+///Simulated RTC
+struct test_rtc
+{
+    /// True time since the second counter was cleared, ns
+    uint64_t now_ns;
+    /// Error of the 32k clock, ppb, > 0 when the RTC is fast
+    int32_t err_ppb;
+    uint32_t cr;
+    uint32_t sr;
+};
+
+static struct test_rtc test_rtc;
+
+static uint32_t test_fail;
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+#define TEST_CHECK(cond, ...)                                                       \
+    do {                                                                            \
+        if (!(cond))                                                                \
+        {                                                                           \
+            if (test_fail < 20)                                                     \
+            {                                                                       \
+                printf("%s:%d: %s: ", __FILE__, __LINE__, #cond);                   \
+                printf(__VA_ARGS__);                                                \
+                printf("\n");                                                       \
+            }                                                                       \
+            test_fail++;                                                            \
+        }                                                                           \
+    } while (0)
+
+static uint32_t test_rand(void)
+{
+    static uint32_t x = 2463534242UL;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+
+    return x;
+}
+
+/// 32k clock counts of the simulated RTC
+static uint64_t test_rtc_cnt(void)
+{
+    return (uint64_t)((long double)test_rtc.now_ns * RTC_CNT_PER_SEC
+                      * (1e9L + test_rtc.err_ppb) / 1e18L);
+}
+
+// Registers of the RTC driver, see host/driver_config.h
+void rtc_rtc_SetCRWithMask(QN_RTC_TypeDef *RTC, uint32_t mask, uint32_t value)
+{
+    test_rtc.cr = (test_rtc.cr & ~mask) | (value & mask);
+}
+
+uint32_t rtc_rtc_GetCR(QN_RTC_TypeDef *RTC)
+{
+    return test_rtc.cr;
+}
+
+void rtc_rtc_ClrSR(QN_RTC_TypeDef *RTC, uint32_t value)
+{
+    test_rtc.sr &= ~value;
+}
+
+uint32_t rtc_rtc_GetSR(QN_RTC_TypeDef *RTC)
+{
+    return test_rtc.sr;
+}
+
+void rtc_rtc_SetSecVal(QN_RTC_TypeDef *RTC, uint32_t value)
+{
+    TEST_CHECK(value == 0, "only the epoch clock is simulated");
+    test_rtc.now_ns = 0;
+}
+
+uint32_t rtc_rtc_GetSecVal(QN_RTC_TypeDef *RTC)
+{
+    return (uint32_t)(test_rtc_cnt() / RTC_CNT_PER_SEC);
+}
+
+void rtc_rtc_SetCORR(QN_RTC_TypeDef *RTC, uint32_t value)
+{
+}
+
+void rtc_rtc_SetCalVal(QN_RTC_TypeDef *RTC, uint32_t value)
+{
+}
+
+uint32_t rtc_rtc_GetCNT(QN_RTC_TypeDef *RTC)
+{
+    return (uint32_t)(test_rtc_cnt() % RTC_CNT_PER_SEC);
+}
+
+/// Run the simulated RTC for ns, with its second interrupt
+static void test_rtc_run(uint64_t ns)
+{
+    uint64_t end = test_rtc.now_ns + ns;
+
+    while (test_rtc.now_ns < end)
+    {
+        uint32_t sec = rtc_rtc_GetSecVal(QN_RTC);
+
+        test_rtc.now_ns += 1000000;
+        if (rtc_rtc_GetSecVal(QN_RTC) != sec && (test_rtc.cr & RTC_MASK_SEC_IE))
+        {
+            test_rtc.sr |= RTC_MASK_SEC_IF;
+            RTC_IRQHandler();
+        }
+    }
+}
+
+/**
+ ****************************************************************************************
+ * @brief Every day of the epoch clock, at a random time, is the date of gmtime() and
+ * converts back to its second.
+ ****************************************************************************************
+ */
+static void test_date_days(void)
+{
+    struct rtc_epoch_date date;
+    uint32_t days = 0;
+
+    for (;; days++)
+    {
+        uint32_t sec = days * SECONDINDAY + test_rand() % SECONDINDAY;
+        time_t t = (time_t)(TEST_UNIX_2000 + sec);
+        struct tm tm;
+        uint32_t back = 0;
+
+        gmtime_r(&t, &tm);
+        if (tm.tm_year + 1900 > RTC_EPOCH_YEAR_MAX)
+            break;
+
+        rtc_epoch_to_date(sec, &date);
+        TEST_CHECK(date.year == tm.tm_year + 1900 && date.month == tm.tm_mon + 1
+                   && date.day == tm.tm_mday, "%u: %u-%u-%u", sec, date.year, date.month, date.day);
+        TEST_CHECK(date.hour == tm.tm_hour && date.minute == tm.tm_min && date.second == tm.tm_sec,
+                   "%u: %u:%u:%u", sec, date.hour, date.minute, date.second);
+        TEST_CHECK(date.week == ((tm.tm_wday == 0) ? 7 : tm.tm_wday), "%u: week %u", sec, date.week);
+        TEST_CHECK(rtc_epoch_from_date(&date, &back) && back == sec, "%u: back %u", sec, back);
+    }
+
+    // Up to 2135-12-31, with the second counter not wrapped
+    TEST_CHECK(days == 49673, "%u days", days);
+    rtc_epoch_to_date(days * SECONDINDAY - 1, &date);
+    TEST_CHECK(date.year == 2135 && date.month == 12 && date.day == 31 && date.second == 59,
+               "last %u-%u-%u", date.year, date.month, date.day);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Dates are accepted exactly when the C library keeps them as they are.
+ ****************************************************************************************
+ */
+static void test_date_check(void)
+{
+    static const uint16_t years[] = {1999, 2000, 2001, 2004, 2100, 2104, 2135, 2136};
+    struct rtc_epoch_date date = {0};
+    uint32_t sec;
+
+    for (uint8_t y = 0; y < sizeof(years) / sizeof(years[0]); y++)
+    {
+        for (uint8_t m = 0; m <= 13; m++)
+        {
+            for (uint8_t d = 0; d <= 32; d++)
+            {
+                struct tm tm = {0};
+                time_t t;
+                bool valid;
+
+                tm.tm_year = years[y] - 1900;
+                tm.tm_mon = m - 1;
+                tm.tm_mday = d;
+                tm.tm_hour = 23;
+                tm.tm_min = 59;
+                tm.tm_sec = 59;
+                t = timegm(&tm);
+                valid = (years[y] >= RTC_EPOCH_YEAR) && (years[y] <= RTC_EPOCH_YEAR_MAX)
+                        && (tm.tm_mon == m - 1) && (tm.tm_mday == d);
+
+                date.year = years[y];
+                date.month = m;
+                date.day = d;
+                date.hour = 23;
+                date.minute = 59;
+                date.second = 59;
+                TEST_CHECK(rtc_epoch_from_date(&date, &sec) == valid, "%u-%u-%u", years[y], m, d);
+                if (valid)
+                    TEST_CHECK(sec == t - TEST_UNIX_2000, "%u-%u-%u: %u", years[y], m, d, sec);
+            }
+        }
+    }
+
+    date.year = 2016;
+    date.month = 2;
+    date.day = 29;
+    date.hour = 24;
+    date.minute = 0;
+    date.second = 0;
+    TEST_CHECK(!rtc_epoch_from_date(&date, &sec), "hour 24");
+    date.hour = 0;
+    date.minute = 60;
+    TEST_CHECK(!rtc_epoch_from_date(&date, &sec), "minute 60");
+    date.minute = 0;
+    date.second = 60;
+    TEST_CHECK(!rtc_epoch_from_date(&date, &sec), "second 60");
+}
+
+/// Epoch clock - true time, 1/256 s
+static int64_t test_epoch_err(uint64_t start_256)
+{
+    uint8_t frac;
+    uint32_t sec = rtc_epoch_get(&frac);
+
+    return (((int64_t)sec << 8) + frac) - (int64_t)(start_256 + test_rtc.now_ns * 256 / 1000000000);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Reference times every interval seconds on an RTC off by err_ppb.
+ *
+ * The correction must converge to the error within what the 1/256 s resolution of the
+ * references allows over the interval, and the clock must then stay that close between
+ * the references.
+ ****************************************************************************************
+ */
+static void test_drift_run(int32_t err_ppb, uint32_t interval)
+{
+    // Drift correction for the error: elapsed * (1 + drift) == true time
+    double expect = (1e9 / (1e9 + err_ppb) - 1) * 1e9;
+    // One 1/256 s over the interval, and the 32k count truncated at both ends
+    double tol = 3 * 1e9 / (256.0 * interval);
+    uint64_t start = ((uint64_t)(test_rand() % 400000000) << 8) + (test_rand() & 0xFF);
+    struct rtc_epoch_stat const *stat = rtc_epoch_stat_get();
+    int32_t first_err = 0;
+    int64_t max_err = 0;
+    uint64_t now;
+    uint32_t ref;
+
+    memset(&test_rtc, 0, sizeof(test_rtc));
+    test_rtc.err_ppb = err_ppb;
+    rtc_epoch_init();
+    rtc_epoch_set((uint32_t)(start >> 8), (uint8_t)start);
+
+    for (ref = 1; ref <= 40; ref++)
+    {
+        // Half way, the clock runs on the correction alone
+        test_rtc.now_ns += (uint64_t)interval * 500000000;
+        if (ref > 20)
+        {
+            int64_t err = llabs(test_epoch_err(start));
+
+            if (err > max_err)
+                max_err = err;
+        }
+        test_rtc.now_ns += (uint64_t)interval * 500000000;
+
+        now = start + test_rtc.now_ns * 256 / 1000000000;
+        rtc_epoch_ref((uint32_t)(now >> 8), (uint8_t)now);
+        if (ref == 1)
+            first_err = stat->ref_err;
+    }
+
+    TEST_CHECK(stat->ref_nb == 40 && stat->drift_nb == 39, "%u refs, %u drifts", stat->ref_nb,
+               stat->drift_nb);
+    TEST_CHECK(stat->drift_ppb > expect - tol && stat->drift_ppb < expect + tol,
+               "error %d ppb every %u s: drift %d ppb", err_ppb, interval, stat->drift_ppb);
+    TEST_CHECK(abs(stat->ref_err) <= abs(first_err) && abs(stat->ref_err) <= 2 + tol * interval * 256 / 1e9,
+               "error %d ppb every %u s: ref_err %d, first %d", err_ppb, interval, stat->ref_err, first_err);
+    TEST_CHECK(max_err <= 2 + tol * interval * 256 / 2e9, "error %d ppb every %u s: %lld/256 s off",
+               err_ppb, interval, (long long)max_err);
+}
+
+/**
+ ****************************************************************************************
+ * @brief The drift converges to the clock error, slow or fast, and references which can
+ * not measure it leave it as it is.
+ ****************************************************************************************
+ */
+static void test_drift(void)
+{
+    static const int32_t errs[] = {-37500, 37500, -150000, 20};
+    static const uint32_t intervals[] = {RTC_EPOCH_REF_MIN + 1, 3600, 6 * 3600, 24 * 3600};
+    struct rtc_epoch_stat const *stat = rtc_epoch_stat_get();
+    int32_t drift;
+
+    for (uint8_t e = 0; e < sizeof(errs) / sizeof(errs[0]); e++)
+    {
+        for (uint8_t i = 0; i < sizeof(intervals) / sizeof(intervals[0]); i++)
+            test_drift_run(errs[e], intervals[i]);
+    }
+
+    // Too close to the previous reference, after a clock set, or beyond the correction
+    memset(&test_rtc, 0, sizeof(test_rtc));
+    test_rtc.err_ppb = -37500;
+    rtc_epoch_init();
+    rtc_epoch_set(1000, 0);
+    test_rtc.now_ns = 3600ULL * 1000000000;
+    rtc_epoch_ref(4600, 0);
+    test_rtc.now_ns += (RTC_EPOCH_REF_MIN - 1) * 1000000000ULL;
+    rtc_epoch_ref(4600 + RTC_EPOCH_REF_MIN - 1, 0);
+    TEST_CHECK(stat->drift_nb == 0 && stat->drift_ppb == 0, "short interval: %d ppb", stat->drift_ppb);
+
+    test_rtc.now_ns += 3600ULL * 1000000000;
+    rtc_epoch_set(1000, 0);
+    test_rtc.now_ns += 3600ULL * 1000000000;
+    rtc_epoch_ref(4600, 0);
+    TEST_CHECK(stat->drift_nb == 0 && stat->drift_ppb == 0, "after set: %d ppb", stat->drift_ppb);
+
+    test_rtc.now_ns += 3600ULL * 1000000000;
+    rtc_epoch_ref(8200, 0);
+    drift = stat->drift_ppb;
+    TEST_CHECK(stat->drift_nb == 1 && drift > 36000 && drift < 39000, "first estimate: %d ppb", drift);
+
+    // A minute in an hour is far beyond RTC_EPOCH_DRIFT_MAX
+    test_rtc.now_ns += 3600ULL * 1000000000;
+    rtc_epoch_ref(8200 + 3600 + 60, 0);
+    TEST_CHECK(stat->drift_nb == 1 && stat->drift_ppb == drift, "beyond the correction: %d ppb",
+               stat->drift_ppb);
+}
+
+static uint32_t test_alarm_nb;
+static uint64_t test_alarm_at;
+
+static void test_alarm_cb(void)
+{
+    uint8_t frac;
+    uint32_t sec = rtc_epoch_get(&frac);
+
+    test_alarm_nb++;
+    test_alarm_at = ((uint64_t)sec << 8) + frac;
+}
+
+/**
+ ****************************************************************************************
+ * @brief The alarm is raised once, by the first second interrupt at or after its time on
+ * the corrected clock, and the interrupt stops after it.
+ ****************************************************************************************
+ */
+static void test_alarm(void)
+{
+    static const uint32_t delays[] = {0, 1, 2, 59, 3600, 10 * 3600};
+    uint32_t now;
+
+    memset(&test_rtc, 0, sizeof(test_rtc));
+    test_rtc.err_ppb = -150000;
+    rtc_epoch_init();
+    rtc_epoch_set(500000000, 0x80);
+    for (uint8_t ref = 1; ref <= 10; ref++)
+    {
+        test_rtc.now_ns += 3600ULL * 1000000000;
+        rtc_epoch_ref(500000000 + ref * 3600, 0x80);
+    }
+
+    for (uint8_t i = 0; i < sizeof(delays) / sizeof(delays[0]); i++)
+    {
+        test_alarm_nb = 0;
+        now = rtc_epoch_get(NULL);
+        rtc_epoch_alarm_set(now + delays[i], test_alarm_cb);
+        TEST_CHECK(test_rtc.cr & RTC_MASK_SEC_IE, "alarm in %u s: interrupt off", delays[i]);
+
+        test_rtc_run((delays[i] + 3) * 1000000000ULL);
+        TEST_CHECK(test_alarm_nb == 1, "alarm in %u s: raised %u times", delays[i], test_alarm_nb);
+        // The interrupt of the second at the alarm time, 1/256 s of rounding
+        TEST_CHECK(test_alarm_at + 1 >= ((uint64_t)(now + delays[i]) << 8)
+                   && test_alarm_at < ((uint64_t)(now + delays[i] + 1) << 8) + 1,
+                   "alarm in %u s: raised at %u + %u/256", delays[i], (uint32_t)(test_alarm_at >> 8),
+                   (uint8_t)test_alarm_at);
+        TEST_CHECK(!(test_rtc.cr & RTC_MASK_SEC_IE), "alarm in %u s: interrupt left on", delays[i]);
+    }
+
+    now = rtc_epoch_get(NULL);
+    rtc_epoch_alarm_set(now + 5, test_alarm_cb);
+    rtc_epoch_alarm_clear();
+    test_alarm_nb = 0;
+    test_rtc_run(8000000000ULL);
+    TEST_CHECK(test_alarm_nb == 0 && !(test_rtc.cr & RTC_MASK_SEC_IE), "cleared alarm raised");
+}
+
+static double test_elapsed_ns(struct timespec const *t0)
+{
+    struct timespec t1;
+
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    return (t1.tv_sec - t0->tv_sec) * 1e9 + (t1.tv_nsec - t0->tv_nsec);
+}
+
+static void test_bench(void)
+{
+    struct rtc_epoch_date date;
+    volatile uint32_t sink = 0;
+    struct timespec t0;
+    uint32_t sec;
+    double ns;
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (uint32_t i = 0; i < TEST_BENCH_NB; i++)
+    {
+        rtc_epoch_to_date(i * 1021, &date);
+        sink += date.day;
+    }
+    ns = test_elapsed_ns(&t0) / TEST_BENCH_NB;
+    printf("rtc_epoch_to_date %.2f ns/date\n", ns);
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (uint32_t i = 0; i < TEST_BENCH_NB; i++)
+    {
+        date.year = RTC_EPOCH_YEAR + i % 136;
+        date.month = 1 + i % 12;
+        date.day = 1 + i % 28;
+        rtc_epoch_from_date(&date, &sec);
+        sink += sec;
+    }
+    ns = test_elapsed_ns(&t0) / TEST_BENCH_NB;
+    printf("rtc_epoch_from_date %.2f ns/date\n", ns);
+}
+
+int main(void)
+{
+    test_date_days();
+    test_date_check();
+    test_drift();
+    test_alarm();
+    test_bench();
+
+    printf("rtc: %s (%u failures)\n", test_fail ? "FAIL" : "OK", test_fail);
+
+    return test_fail != 0;
+}